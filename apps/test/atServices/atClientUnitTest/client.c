@@ -86,6 +86,15 @@ static void RxNewData
                 LE_ASSERT(write(fd, "\r\n359377060033064\r\n\r\nOK\r\n", 25) == 25);
                 return;
             }
+            else if (strcmp(buffer, "AT+URC\r") == 0)
+            {
+                LE_INFO("Received AT command: %s", buffer);
+                // Send the response of AT command, followed by unsolicited responses
+                const char* responsePtr = "\r\nOK\r\n\r\n+CREG: 1\r\n\r\n+CMT: \"+33612345678\"\r\n"
+                                          "Hello\r\n\r\nRING\r\n\r\n+CREG: 5\r\n";
+                LE_ASSERT(write(fd, responsePtr, strlen(responsePtr)) == (ssize_t)strlen(responsePtr));
+                return;
+            }
         }
     }
 }
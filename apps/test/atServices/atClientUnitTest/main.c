@@ -120,6 +120,120 @@ void Testle_atClientSendFalseTest
                                                           "OK|ERROR|+CME ERROR", 1));
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of expected unsolicited response notifications
+ */
+//--------------------------------------------------------------------------------------------------
+#define UNSOL_NOTIF_COUNT 8
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Received unsolicited response notifications, prefixed by the handler index
+ */
+//--------------------------------------------------------------------------------------------------
+static char UnsolNotif[UNSOL_NOTIF_COUNT][LE_ATDEFS_UNSOLICITED_MAX_BYTES];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of received unsolicited response notifications
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t UnsolNotifCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Semaphore posted on each unsolicited response notification
+ */
+//--------------------------------------------------------------------------------------------------
+static le_sem_Ref_t UnsolSemRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited response handler
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnsolicitedHandler
+(
+    const char* unsolicitedRsp,
+    void* contextPtr
+)
+{
+    LE_INFO("Unsolicited %d: %s", (int)(intptr_t)contextPtr, unsolicitedRsp);
+
+    if (UnsolNotifCount < UNSOL_NOTIF_COUNT)
+    {
+        snprintf(UnsolNotif[UnsolNotifCount], sizeof(UnsolNotif[0]), "%d:%s",
+                 (int)(intptr_t)contextPtr, unsolicitedRsp);
+    }
+    UnsolNotifCount++;
+
+    le_sem_Post(UnsolSemRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the atClient unsolicited responses, with overlapping and multi-line patterns.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_atClientUnsolicited
+(
+    le_atClient_DeviceRef_t devRef
+)
+{
+    static const char* patterns[] = {"+CREG:", "+C", "+CMT:", "RING", "+CREG: 5", "+CGREG:"};
+    static const uint32_t lineCounts[] = {1, 1, 2, 1, 1, 1};
+    static const char* expected[UNSOL_NOTIF_COUNT] =
+    {
+        "0:+CREG: 1",
+        "1:+CREG: 1",
+        "1:+CMT: \"+33612345678\"",
+        "2:+CMT: \"+33612345678\"\r\nHello",
+        "3:RING",
+        "0:+CREG: 5",
+        "1:+CREG: 5",
+        "4:+CREG: 5",
+    };
+    le_atClient_UnsolicitedResponseHandlerRef_t handlerRefs[NUM_ARRAY_MEMBERS(patterns)];
+    le_atClient_CmdRef_t cmdRef;
+    le_clk_Time_t timeToWait = {CLIENT_TIMEOUT, 0};
+    uint32_t i;
+
+    UnsolSemRef = le_sem_Create("UnsolSem", 0);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(patterns); i++)
+    {
+        handlerRefs[i] = le_atClient_AddUnsolicitedResponseHandler(patterns[i], devRef,
+                                                                   UnsolicitedHandler,
+                                                                   (void*)(intptr_t)i,
+                                                                   lineCounts[i]);
+        LE_ASSERT(handlerRefs[i] != NULL);
+    }
+
+    // The last pattern is never received
+    le_atClient_RemoveUnsolicitedResponseHandler(handlerRefs[5]);
+
+    LE_ASSERT(le_atClient_SetCommandAndSend(&cmdRef, devRef, "AT+URC", "", "OK|ERROR",
+                                            LE_ATDEFS_COMMAND_DEFAULT_TIMEOUT) == LE_OK);
+    LE_ASSERT_OK(le_atClient_Delete(cmdRef));
+
+    for (i = 0; i < UNSOL_NOTIF_COUNT; i++)
+    {
+        LE_ASSERT_OK(le_sem_WaitWithTimeOut(UnsolSemRef, timeToWait));
+    }
+
+    LE_ASSERT(UnsolNotifCount == UNSOL_NOTIF_COUNT);
+    for (i = 0; i < UNSOL_NOTIF_COUNT; i++)
+    {
+        LE_ASSERT(strcmp(UnsolNotif[i], expected[i]) == 0);
+    }
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(patterns) - 1; i++)
+    {
+        le_atClient_RemoveUnsolicitedResponseHandler(handlerRefs[i]);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Client thread function
@@ -193,6 +307,8 @@ static void* AtClient
               == LE_NOT_FOUND);
     LE_ASSERT(le_atClient_Delete(cmdRef) == LE_OK);
 
+    Testle_atClientUnsolicited(devRef);
+
     // Try to stop the device
     LE_ASSERT_OK(le_atClient_Stop(devRef));
     LE_ASSERT(le_atClient_Stop(devRef) == LE_FAULT);
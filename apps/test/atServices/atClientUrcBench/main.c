@@ -0,0 +1,295 @@
+/**
+ * This module implements a benchmark of the AT client unsolicited response parsing.
+ *
+ * A modem trace is fed through a socket to an AT client device on which the unsolicited responses
+ * usually subscribed by the modem services are registered, then the parsing throughput is
+ * measured. The default trace is a representative sequence of unsolicited responses of a busy
+ * modem port: network registration, signal quality, incoming calls and messages, some of them not
+ * subscribed and one spread over two lines. A recorded trace can be given instead.
+ *
+ * Usage: atClientUrcBench [repeatCount] [traceFile]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of times the trace is sent.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_REPEAT_COUNT    2000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a trace file.
+ */
+//--------------------------------------------------------------------------------------------------
+#define TRACE_MAX_BYTES         (1024 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timeout waiting for the trace to be parsed, in seconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PARSING_TIMEOUT         60
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited response ending the trace.
+ */
+//--------------------------------------------------------------------------------------------------
+#define END_PATTERN             "+BENCHEND"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subscribed unsolicited responses.
+ */
+//--------------------------------------------------------------------------------------------------
+static const struct
+{
+    const char* patternPtr;     ///< Pattern to match
+    uint32_t    lineCount;      ///< Number of lines of the unsolicited response
+}
+Subscriptions[] =
+{
+    {"+CREG:", 1},      {"+CGREG:", 1},     {"+CEREG:", 1},     {"+C5GREG:", 1},
+    {"+CSQ:", 1},       {"+CESQ:", 1},      {"RING", 1},        {"+CRING:", 1},
+    {"+CLIP:", 1},      {"+CCWA:", 1},      {"+CMTI:", 1},      {"+CMT:", 2},
+    {"+CBM:", 2},       {"+CDS:", 2},       {"+CDSI:", 1},      {"+CUSD:", 1},
+    {"+CIEV:", 1},      {"+CTZV:", 1},      {"+CTZE:", 1},      {"+CTZDST:", 1},
+    {"+CGEV:", 1},      {"+CME ERROR:", 1}, {"+CMS ERROR:", 1}, {"NO CARRIER", 1},
+    {"BUSY", 1},        {"NO ANSWER", 1},   {"+WIND:", 1},      {"+KCELL:", 1},
+    {"^SYSINFO:", 1},   {"^MODE:", 1},      {"^RSSI:", 1},      {"^BOOT:", 1},
+    {"+QIND:", 1},      {"+QIURC:", 1},     {"+QUSIM:", 1},     {"+CPIN:", 1},
+    {"+STKPCI:", 1},    {"+CUSATP:", 1},    {"+CGNSINF:", 1},   {"+CPMS:", 1},
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default trace.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char DefaultTrace[] =
+    "\r\n+CREG: 1,\"1A2B\",\"0001C3D4\",7\r\n"
+    "\r\n+CGREG: 1,\"1A2B\",\"0001C3D4\",7,\"01\"\r\n"
+    "\r\n+CEREG: 1,\"1A2B\",\"0001C3D4\",7\r\n"
+    "\r\n+CSQ: 23,99\r\n"
+    "\r\n+CESQ: 99,99,255,255,22,56\r\n"
+    "\r\n^RSSI:23\r\n"
+    "\r\n+CIEV: 2,4\r\n"
+    "\r\n^MODE:5,4\r\n"
+    "\r\n+QIND: \"csq\",23,99\r\n"
+    "\r\n+CGEV: ME PDN ACT 1\r\n"
+    "\r\nRING\r\n"
+    "\r\n+CLIP: \"+33612345678\",145,,,,0\r\n"
+    "\r\nNO CARRIER\r\n"
+    "\r\n+CMTI: \"SM\",3\r\n"
+    "\r\n+CMT: \"+33612345678\",,\"20/01/01,12:00:00+04\"\r\nHello from the benchmark\r\n"
+    "\r\n+CTZV: \"20/01/01,12:00:00\",+04\r\n"
+    "\r\n+QIURC: \"recv\",0,120\r\n"
+    "\r\n+ECSQ: 23,99,-89\r\n"
+    "\r\n+CUSD: 0,\"Balance 10.00\",15\r\n";
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of unsolicited response notifications.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t NotifCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Semaphore posted when the end of the trace is parsed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_sem_Ref_t EndSemRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited response handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnsolicitedHandler
+(
+    const char* unsolicitedRsp,
+    void* contextPtr
+)
+{
+    NotifCount++;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * End of trace handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndHandler
+(
+    const char* unsolicitedRsp,
+    void* contextPtr
+)
+{
+    le_sem_Post(EndSemRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load a trace file.
+ *
+ * @return the trace size, 0 on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t LoadTrace
+(
+    const char* pathPtr,    ///< [IN] Trace file path
+    char*       tracePtr    ///< [OUT] Trace buffer, TRACE_MAX_BYTES long
+)
+{
+    size_t size = 0;
+    ssize_t count;
+    int fd = open(pathPtr, O_RDONLY);
+
+    if (fd == -1)
+    {
+        LE_ERROR("Cannot open %s: %m", pathPtr);
+        return 0;
+    }
+
+    while ((size < TRACE_MAX_BYTES) &&
+           ((count = read(fd, tracePtr + size, TRACE_MAX_BYTES - size)) > 0))
+    {
+        size += count;
+    }
+
+    close(fd);
+
+    return size;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Count the lines of a trace.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t CountLines
+(
+    const char* tracePtr,   ///< [IN] Trace
+    size_t      size        ///< [IN] Trace size
+)
+{
+    uint32_t count = 0;
+    size_t i;
+
+    for (i = 2; i < size; i++)
+    {
+        // Count the non empty lines
+        if ((tracePtr[i - 1] == '\r') && (tracePtr[i] == '\n') && (tracePtr[i - 2] != '\n'))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a buffer to the modem side of the socket.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteAll
+(
+    int         fd,         ///< [IN] Socket
+    const char* bufferPtr,  ///< [IN] Data
+    size_t      size        ///< [IN] Data size
+)
+{
+    while (size > 0)
+    {
+        ssize_t count = write(fd, bufferPtr, size);
+
+        LE_ASSERT(count > 0);
+        bufferPtr += count;
+        size -= count;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    static char traceFile[TRACE_MAX_BYTES];
+    const char* tracePtr = DefaultTrace;
+    size_t traceSize = sizeof(DefaultTrace) - 1;
+    uint32_t repeatCount = DEFAULT_REPEAT_COUNT;
+    le_clk_Time_t timeToWait = {PARSING_TIMEOUT, 0};
+    le_atClient_DeviceRef_t devRef;
+    le_clk_Time_t startTime;
+    le_clk_Time_t duration;
+    uint64_t usec;
+    uint32_t lineCount;
+    int fds[2];
+    uint32_t i;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        repeatCount = strtoul(le_arg_GetArg(0), NULL, 0);
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        traceSize = LoadTrace(le_arg_GetArg(1), traceFile);
+        tracePtr = traceFile;
+    }
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_ASSERT(traceSize > 0, "Load the trace");
+
+    lineCount = CountLines(tracePtr, traceSize) * repeatCount;
+    LE_TEST_INFO("AT client unsolicited responses benchmark: %"PRIuS" subscriptions, "
+                 "%"PRIu32" lines", NUM_ARRAY_MEMBERS(Subscriptions), lineCount);
+
+    LE_TEST_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0, "Create the modem socket");
+
+    devRef = le_atClient_Start(fds[0]);
+    LE_TEST_ASSERT(devRef != NULL, "Start the AT client");
+
+    EndSemRef = le_sem_Create("BenchEndSem", 0);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(Subscriptions); i++)
+    {
+        LE_ASSERT(le_atClient_AddUnsolicitedResponseHandler(Subscriptions[i].patternPtr, devRef,
+                                                            UnsolicitedHandler, NULL,
+                                                            Subscriptions[i].lineCount) != NULL);
+    }
+    LE_ASSERT(le_atClient_AddUnsolicitedResponseHandler(END_PATTERN, devRef, EndHandler, NULL, 1)
+              != NULL);
+
+    startTime = le_clk_GetRelativeTime();
+
+    for (i = 0; i < repeatCount; i++)
+    {
+        WriteAll(fds[1], tracePtr, traceSize);
+    }
+    WriteAll(fds[1], "\r\n" END_PATTERN "\r\n", sizeof("\r\n" END_PATTERN "\r\n") - 1);
+
+    LE_TEST_OK(le_sem_WaitWithTimeOut(EndSemRef, timeToWait) == LE_OK, "Parse the trace");
+
+    duration = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    usec = (uint64_t)duration.sec * 1000000 + duration.usec;
+
+    LE_TEST_INFO("%"PRIu32" lines, %"PRIu32" notifications in %"PRIu64" us", lineCount,
+                 NotifCount, usec);
+    LE_TEST_INFO("%.2f us/line, %.0f lines/s", lineCount ? (double)usec / lineCount : 0.0,
+                 usec ? (double)lineCount * 1000000 / usec : 0.0);
+
+    LE_TEST_OK(le_atClient_Stop(devRef) == LE_OK, "Stop the AT client");
+    close(fds[1]);
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,301 @@
+/**
+ * This module implements a benchmark of the PCM signal processing kernels of the audio service.
+ *
+ * Each kernel processes several seconds of audio, then the CPU time needed per second of audio is
+ * reported. The DTMF generation is compared with the per-sample sin() computation it replaces, and
+ * the outputs of the kernels are checked against reference computations.
+ *
+ * Usage: pcmDspBench [seconds]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "pcmDsp.h"
+#include <math.h>
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default duration of audio processed by each kernel, in seconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_SECONDS     60
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sample rate, in Hertz.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SAMPLE_RATE         16000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * DTMF peak amplitude of each tone, as played by le_media.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DTMF_AMPLITUDE      (32767 * 40 / 100.0)
+
+#if !defined (PI)
+#define PI 3.14159265358979323846264338327
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sample buffers, of one second each.
+ */
+//--------------------------------------------------------------------------------------------------
+static int16_t Samples[SAMPLE_RATE];
+static int16_t OtherSamples[SAMPLE_RATE];
+static int16_t ResampledSamples[3 * SAMPLE_RATE + 1];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measure start CPU time.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct timespec StartTime;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a measure.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartMeasure
+(
+    void
+)
+{
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &StartTime);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop a measure and print the CPU time per second of audio.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopMeasure
+(
+    const char* namePtr,    ///< [IN] Measured kernel
+    uint32_t seconds        ///< [IN] Seconds of audio processed
+)
+{
+    struct timespec now;
+    uint64_t usec;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    usec = ((uint64_t)(now.tv_sec - StartTime.tv_sec) * 1000000000 +
+            now.tv_nsec - StartTime.tv_nsec) / 1000;
+
+    LE_TEST_INFO("%-28s %4"PRIu32" s of audio %10"PRIu64" us %9.1f us/s", namePtr, seconds, usec,
+                 seconds ? (double)usec / seconds : 0.0);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generate one second of DTMF the way le_media did before the oscillators, as reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GenerateSinDtmf
+(
+    int16_t* samplesPtr,    ///< [OUT] Samples
+    uint32_t freq1,         ///< [IN] Low frequency
+    uint32_t freq2,         ///< [IN] High frequency
+    uint32_t startIdx       ///< [IN] Index of the first sample
+)
+{
+    double d1 = 1.0 * freq1 / SAMPLE_RATE;
+    double d2 = 1.0 * freq2 / SAMPLE_RATE;
+    uint32_t i;
+
+    for (i = 0; i < SAMPLE_RATE; i++)
+    {
+        int32_t s1 = (int16_t)(DTMF_AMPLITUDE * sin(2 * PI * d1 * (startIdx + i)));
+        int32_t s2 = (int16_t)(DTMF_AMPLITUDE * sin(2 * PI * d2 * (startIdx + i)));
+        int32_t tot = s1 + s2;
+
+        samplesPtr[i] = (tot > INT16_MAX) ? INT16_MAX : ((tot < INT16_MIN) ? INT16_MIN : tot);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generate one second of DTMF with the oscillators, as le_media does.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GenerateOscDtmf
+(
+    int16_t* samplesPtr,    ///< [OUT] Samples
+    uint32_t freq1,         ///< [IN] Low frequency
+    uint32_t freq2,         ///< [IN] High frequency
+    uint32_t startIdx       ///< [IN] Index of the first sample
+)
+{
+    pcmDsp_Osc_t oscillators[2];
+
+    pcmDsp_InitOsc(&oscillators[0], freq1, SAMPLE_RATE, DTMF_AMPLITUDE, startIdx);
+    pcmDsp_InitOsc(&oscillators[1], freq2, SAMPLE_RATE, DTMF_AMPLITUDE, startIdx);
+    pcmDsp_GenerateTones(oscillators, NUM_ARRAY_MEMBERS(oscillators), samplesPtr, SAMPLE_RATE);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the oscillators against the sin() reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckDtmf
+(
+    void
+)
+{
+    int32_t maxError = 0;
+    uint32_t i;
+
+    // Second second of the '#' DTMF, to check the restart of the oscillators
+    GenerateSinDtmf(Samples, 941, 1477, SAMPLE_RATE);
+    GenerateOscDtmf(OtherSamples, 941, 1477, SAMPLE_RATE);
+
+    for (i = 0; i < SAMPLE_RATE; i++)
+    {
+        int32_t error = abs(Samples[i] - OtherSamples[i]);
+
+        maxError = (error > maxError) ? error : maxError;
+    }
+
+    // The reference truncates each tone separately
+    LE_TEST_OK(maxError <= 2, "DTMF matches the sin() reference (max error %"PRId32")", maxError);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the saturating mix and the gain.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckMixAndGain
+(
+    void
+)
+{
+    int16_t a[] = {100, 30000, -30000, 5, -5, 32767, -32768, 0, 1, 2, 3, 20000, -20000};
+    int16_t b[] = {-50, 10000, -10000, 5, -5, 1, -1, 0, 1, 2, 3, 20000, 10000};
+    int16_t mixed[] = {50, 32767, -32768, 10, -10, 32767, -32768, 0, 2, 4, 6, 32767, -10000};
+    int16_t g[] = {100, 32767, -32768, 3, -3, 16384};
+    int16_t gained[] = {150, 32767, -32768, 5, -4, 24576};
+
+    pcmDsp_Mix(a, b, NUM_ARRAY_MEMBERS(a));
+    LE_TEST_OK(memcmp(a, mixed, sizeof(a)) == 0, "Saturating mix");
+
+    pcmDsp_ApplyGain(g, NUM_ARRAY_MEMBERS(g), PCMDSP_GAIN_UNITY * 3 / 2);
+    LE_TEST_OK(memcmp(g, gained, sizeof(g)) == 0, "Gain");
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the sample rate conversion of a ramp, fed by blocks.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckResample
+(
+    void
+)
+{
+    pcmDsp_Resampler_t resampler;
+    int16_t ramp[100];
+    int16_t out[400];
+    size_t outCount = 0;
+    bool isOk = true;
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(ramp); i++)
+    {
+        ramp[i] = i * 64;
+    }
+
+    // 8 kHz to 32 kHz: each input sample is followed by three interpolated ones
+    pcmDsp_InitResampler(&resampler, 8000, 32000);
+    for (i = 0; i < NUM_ARRAY_MEMBERS(ramp); i += 10)
+    {
+        LE_ASSERT(outCount + pcmDsp_GetResampledMax(&resampler, 10) <= NUM_ARRAY_MEMBERS(out));
+        outCount += pcmDsp_Resample(&resampler, ramp + i, 10, out + outCount);
+    }
+
+    for (i = 0; i < outCount; i++)
+    {
+        isOk = isOk && (out[i] == (int16_t)(i * 16));
+    }
+
+    LE_TEST_OK(isOk && (outCount == 396), "Resample by blocks (%"PRIuS" samples)", outCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    uint32_t seconds = DEFAULT_SECONDS;
+    pcmDsp_Resampler_t resampler;
+    uint32_t i;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        seconds = strtoul(le_arg_GetArg(0), NULL, 0);
+    }
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("PCM DSP benchmark: %"PRIu32" s of audio at %d Hz", seconds, SAMPLE_RATE);
+
+    CheckDtmf();
+    CheckMixAndGain();
+    CheckResample();
+
+    StartMeasure();
+    for (i = 0; i < seconds; i++)
+    {
+        GenerateSinDtmf(Samples, 697, 1209, i * SAMPLE_RATE);
+    }
+    StopMeasure("DTMF with sin()", seconds);
+
+    StartMeasure();
+    for (i = 0; i < seconds; i++)
+    {
+        GenerateOscDtmf(Samples, 697, 1209, i * SAMPLE_RATE);
+    }
+    StopMeasure("DTMF with oscillators", seconds);
+
+    memcpy(OtherSamples, Samples, sizeof(Samples));
+
+    StartMeasure();
+    for (i = 0; i < seconds; i++)
+    {
+        pcmDsp_Mix(Samples, OtherSamples, SAMPLE_RATE);
+    }
+    StopMeasure("Saturating mix", seconds);
+
+    StartMeasure();
+    for (i = 0; i < seconds; i++)
+    {
+        pcmDsp_ApplyGain(Samples, SAMPLE_RATE, PCMDSP_GAIN_UNITY / 2 + i % 2);
+    }
+    StopMeasure("Gain", seconds);
+
+    pcmDsp_InitResampler(&resampler, SAMPLE_RATE, 48000);
+    StartMeasure();
+    for (i = 0; i < seconds; i++)
+    {
+        LE_ASSERT(pcmDsp_GetResampledMax(&resampler, SAMPLE_RATE) <=
+                  NUM_ARRAY_MEMBERS(ResampledSamples));
+        pcmDsp_Resample(&resampler, Samples, SAMPLE_RATE, ResampledSamples);
+    }
+    StopMeasure("Resample 16 kHz to 48 kHz", seconds);
+
+    pcmDsp_InitResampler(&resampler, SAMPLE_RATE, 8000);
+    StartMeasure();
+    for (i = 0; i < seconds; i++)
+    {
+        pcmDsp_Resample(&resampler, Samples, SAMPLE_RATE, ResampledSamples);
+    }
+    StopMeasure("Resample 16 kHz to 8 kHz", seconds);
+
+    LE_TEST_EXIT;
+}
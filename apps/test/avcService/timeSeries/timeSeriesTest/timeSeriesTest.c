@@ -0,0 +1,395 @@
+/**
+ * This program tests the time series storage of the AirVantage connector, and reports how many
+ * samples are stored per KB and the CPU cost of recording and pushing a sample.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+
+#include "timeSeries.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of samples used by the round trip tests.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_SAMPLES 64
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time stamp of the first sample (ms since epoch).
+ */
+//--------------------------------------------------------------------------------------------------
+#define BASE_TIMESTAMP 1577836800000ULL
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffer receiving the CBOR streams.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t CborBuffer[TIME_SERIES_MAX_CBOR_NUMBYTES];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time stamp of a simulated 10 Hz sensor sample, with some jitter.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t SampleTime
+(
+    uint32_t i
+)
+{
+    return BASE_TIMESTAMP + (i * 100) + (i % 3);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of a simulated temperature sensor, with a 0.01 resolution.
+ */
+//--------------------------------------------------------------------------------------------------
+static double SampleFloat
+(
+    uint32_t i
+)
+{
+    return round((20.0 + 2.0 * sin(i / 50.0)) * 100.0) / 100.0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of a simulated integer sensor.
+ */
+//--------------------------------------------------------------------------------------------------
+static int32_t SampleInt
+(
+    uint32_t i
+)
+{
+    return 1000 + (int32_t)(i % 20) - 10;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the header of a time series CBOR stream and check it.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeHeader
+(
+    uint8_t** bufPtrPtr,
+    const char* headerIdPtr,
+    double factor,
+    double timeStampFactor
+)
+{
+    char str[64];
+    size_t count;
+    double value;
+
+    if ((**bufPtrPtr) != 0xA3)
+    {
+        return false;
+    }
+    (*bufPtrPtr)++;
+
+    return le_cbor_DecodeString(bufPtrPtr, str, sizeof(str)) && (strcmp(str, "h") == 0) &&
+           le_cbor_DecodeArrayHeader(bufPtrPtr, &count) && (count == 1) &&
+           le_cbor_DecodeString(bufPtrPtr, str, sizeof(str)) && (strcmp(str, headerIdPtr) == 0) &&
+           le_cbor_DecodeString(bufPtrPtr, str, sizeof(str)) && (strcmp(str, "f") == 0) &&
+           le_cbor_DecodeArrayHeader(bufPtrPtr, &count) && (count == 2) &&
+           le_cbor_DecodeDouble(bufPtrPtr, &value) && (value == timeStampFactor) &&
+           le_cbor_DecodeDouble(bufPtrPtr, &value) && (value == factor) &&
+           le_cbor_DecodeString(bufPtrPtr, str, sizeof(str)) && (strcmp(str, "s") == 0) &&
+           le_cbor_DecodeIndefArrayHeader(bufPtrPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the time stamp of a sample and check it is the expected delta.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DecodeTimeStamp
+(
+    uint8_t** bufPtrPtr,
+    uint32_t i
+)
+{
+    int64_t value = 0;
+    uint64_t expected = (i == 0) ? SampleTime(0) : SampleTime(i) - SampleTime(i - 1);
+
+    return le_cbor_DecodeInteger(bufPtrPtr, &value) && ((uint64_t)value == expected);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Integer samples are decoded as the same deltas the legacy encoder produced.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestIntRoundTrip
+(
+    void
+)
+{
+    timeSeries_Ref_t seriesRef = timeSeries_Create(TIME_SERIES_TYPE_INT, "/0/1", 1, 1);
+    size_t size = sizeof(CborBuffer);
+    uint8_t* bufPtr = CborBuffer;
+    uint32_t i;
+    bool ok = true;
+
+    for (i = 0; i < NUM_SAMPLES; i++)
+    {
+        ok = ok && (timeSeries_AddInt(seriesRef, SampleTime(i), SampleInt(i)) == LE_OK);
+    }
+    LE_TEST_OK(ok, "Recorded %d integer samples", NUM_SAMPLES);
+    LE_TEST_OK(timeSeries_GetCount(seriesRef) == NUM_SAMPLES, "Integer sample count");
+
+    LE_TEST_OK(timeSeries_EncodeCbor(seriesRef, CborBuffer, &size) == LE_OK, "Encode integers");
+    LE_TEST_OK(size == timeSeries_GetCborSize(seriesRef), "Integer CBOR size is exact");
+
+    ok = DecodeHeader(&bufPtr, "/0/1", 1, 1);
+    LE_TEST_OK(ok, "Integer CBOR header");
+
+    for (i = 0; ok && (i < NUM_SAMPLES); i++)
+    {
+        int64_t value = 0;
+        int64_t expected = (i == 0) ? SampleInt(0) : SampleInt(i) - SampleInt(i - 1);
+
+        ok = DecodeTimeStamp(&bufPtr, i) &&
+             le_cbor_DecodeInteger(&bufPtr, &value) && (value == expected);
+    }
+    LE_TEST_OK(ok && (*bufPtr == 0xFF) && ((size_t)(bufPtr + 1 - CborBuffer) == size),
+               "Integer samples decoded");
+
+    timeSeries_Delete(seriesRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Float samples are decoded as doubles with a factor of 1, and as integers otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestFloatRoundTrip
+(
+    double factor
+)
+{
+    timeSeries_Ref_t seriesRef = timeSeries_Create(TIME_SERIES_TYPE_FLOAT, "/0/2", factor, 1);
+    size_t size = sizeof(CborBuffer);
+    uint8_t* bufPtr = CborBuffer;
+    uint32_t i;
+    bool ok = true;
+
+    for (i = 0; i < NUM_SAMPLES; i++)
+    {
+        ok = ok && (timeSeries_AddFloat(seriesRef, SampleTime(i), SampleFloat(i)) == LE_OK);
+    }
+    LE_TEST_OK(ok, "Recorded %d float samples, factor %g", NUM_SAMPLES, factor);
+
+    LE_TEST_OK(timeSeries_EncodeCbor(seriesRef, CborBuffer, &size) == LE_OK, "Encode floats");
+    LE_TEST_OK(size == timeSeries_GetCborSize(seriesRef), "Float CBOR size is exact");
+
+    ok = DecodeHeader(&bufPtr, "/0/2", factor, 1);
+    LE_TEST_OK(ok, "Float CBOR header");
+
+    for (i = 0; ok && (i < NUM_SAMPLES); i++)
+    {
+        double expected = ((i == 0) ? SampleFloat(0) : SampleFloat(i) - SampleFloat(i - 1)) *
+                          factor;
+
+        ok = DecodeTimeStamp(&bufPtr, i);
+        if (factor == 1)
+        {
+            double value;
+            ok = ok && le_cbor_DecodeDouble(&bufPtr, &value) && (value == expected);
+        }
+        else
+        {
+            int64_t value = 0;
+            ok = ok && le_cbor_DecodeInteger(&bufPtr, &value) && (value == (int64_t)expected);
+        }
+    }
+    LE_TEST_OK(ok && (*bufPtr == 0xFF), "Float samples decoded");
+
+    timeSeries_Delete(seriesRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Boolean and string samples are decoded unchanged.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestBoolStringRoundTrip
+(
+    void
+)
+{
+    static const char* strings[] = { "idle", "idle", "moving", "", "idle" };
+    timeSeries_Ref_t boolRef = timeSeries_Create(TIME_SERIES_TYPE_BOOL, "/0/3", 1, 1);
+    timeSeries_Ref_t strRef = timeSeries_Create(TIME_SERIES_TYPE_STRING, "/0/4", 1, 1);
+    size_t size;
+    uint8_t* bufPtr;
+    uint32_t i;
+    bool ok = true;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(strings); i++)
+    {
+        ok = ok && (timeSeries_AddBool(boolRef, SampleTime(i), (i % 2) == 0) == LE_OK);
+        ok = ok && (timeSeries_AddString(strRef, SampleTime(i), strings[i]) == LE_OK);
+    }
+    LE_TEST_OK(ok, "Recorded boolean and string samples");
+    LE_TEST_OK(timeSeries_AddInt(boolRef, SampleTime(i), 1) == LE_FAULT, "Type mismatch rejected");
+
+    size = sizeof(CborBuffer);
+    bufPtr = CborBuffer;
+    ok = (timeSeries_EncodeCbor(boolRef, CborBuffer, &size) == LE_OK) &&
+         DecodeHeader(&bufPtr, "/0/3", 1, 1);
+    for (i = 0; ok && (i < NUM_ARRAY_MEMBERS(strings)); i++)
+    {
+        bool value;
+        ok = DecodeTimeStamp(&bufPtr, i) && le_cbor_DecodeBool(&bufPtr, &value) &&
+             (value == ((i % 2) == 0));
+    }
+    LE_TEST_OK(ok && (*bufPtr == 0xFF), "Boolean samples decoded");
+
+    size = sizeof(CborBuffer);
+    bufPtr = CborBuffer;
+    ok = (timeSeries_EncodeCbor(strRef, CborBuffer, &size) == LE_OK) &&
+         (size == timeSeries_GetCborSize(strRef)) &&
+         DecodeHeader(&bufPtr, "/0/4", 1, 1);
+    for (i = 0; ok && (i < NUM_ARRAY_MEMBERS(strings)); i++)
+    {
+        char value[TIME_SERIES_STRING_NUMBYTES];
+        ok = DecodeTimeStamp(&bufPtr, i) && le_cbor_DecodeString(&bufPtr, value, sizeof(value)) &&
+             (strcmp(value, strings[i]) == 0);
+    }
+    LE_TEST_OK(ok && (*bufPtr == 0xFF), "String samples decoded");
+
+    timeSeries_Delete(boolRef);
+    timeSeries_Delete(strRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A full time series reports LE_NO_MEMORY, then LE_OVERFLOW, and is reusable after a reset.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestFull
+(
+    void
+)
+{
+    timeSeries_Ref_t seriesRef = timeSeries_Create(TIME_SERIES_TYPE_STRING, "/0/5", 1, 1);
+    char value[TIME_SERIES_STRING_NUMBYTES];
+    le_result_t result = LE_OK;
+    uint32_t i = 0;
+
+    while (result == LE_OK)
+    {
+        snprintf(value, sizeof(value), "%0200" PRIu32, i);
+        result = timeSeries_AddString(seriesRef, SampleTime(i), value);
+        i++;
+    }
+    LE_TEST_OK(result == LE_NO_MEMORY, "Full series reports LE_NO_MEMORY after %" PRIu32
+               " samples", i);
+    LE_TEST_OK(timeSeries_GetCborSize(seriesRef) <= TIME_SERIES_MAX_CBOR_NUMBYTES,
+               "CBOR stream fits in a push buffer");
+
+    while (result != LE_OVERFLOW)
+    {
+        result = timeSeries_AddString(seriesRef, SampleTime(i), "x");
+        i++;
+    }
+    LE_TEST_OK(timeSeries_GetCborSize(seriesRef) <= TIME_SERIES_MAX_CBOR_NUMBYTES,
+               "Overflowing sample not added");
+
+    timeSeries_Reset(seriesRef);
+    LE_TEST_OK(timeSeries_GetCount(seriesRef) == 0, "Series empty after reset");
+    LE_TEST_OK(timeSeries_AddString(seriesRef, SampleTime(0), "x") == LE_OK, "Series reusable");
+
+    timeSeries_Delete(seriesRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record a simulated sensor until the series is full, and report the storage density and CPU cost.
+ * The legacy encoder kept the CBOR stream itself in a 1024 bytes buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Benchmark
+(
+    timeSeries_DataType_t type,
+    const char* namePtr
+)
+{
+    timeSeries_Ref_t seriesRef = timeSeries_Create(type, "/0/6", 1, 1);
+    le_clk_Time_t start, addTime, encodeTime;
+    size_t size = sizeof(CborBuffer);
+    le_result_t result = LE_OK;
+    uint32_t count = 0;
+
+    start = le_clk_GetRelativeTime();
+    while (result == LE_OK)
+    {
+        if (type == TIME_SERIES_TYPE_FLOAT)
+        {
+            result = timeSeries_AddFloat(seriesRef, SampleTime(count), SampleFloat(count));
+        }
+        else
+        {
+            result = timeSeries_AddInt(seriesRef, SampleTime(count), SampleInt(count));
+        }
+        count++;
+    }
+    addTime = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    start = le_clk_GetRelativeTime();
+    LE_TEST_OK(timeSeries_EncodeCbor(seriesRef, CborBuffer, &size) == LE_OK,
+               "Encode %s benchmark series", namePtr);
+    encodeTime = le_clk_Sub(le_clk_GetRelativeTime(), start);
+
+    size_t storage = timeSeries_GetStorageSize(seriesRef);
+    double addUsec = (addTime.sec * 1000000.0 + addTime.usec) / count;
+    double encodeUsec = (encodeTime.sec * 1000000.0 + encodeTime.usec) / count;
+
+    LE_TEST_INFO("%s: %" PRIu32 " samples, %" PRIuS " bytes stored, %" PRIuS " bytes of CBOR",
+                 namePtr, count, storage, size);
+    LE_TEST_INFO("%s: %.1f samples/KB stored (legacy CBOR buffer: %.1f samples/KB)",
+                 namePtr, count * 1024.0 / storage, count * 1024.0 / size);
+    LE_TEST_INFO("%s: %.3f us/sample to record, %.3f us/sample to push",
+                 namePtr, addUsec, encodeUsec);
+
+    LE_TEST_OK(storage < size, "%s storage is smaller than its CBOR stream", namePtr);
+
+    timeSeries_Delete(seriesRef);
+}
+
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    timeSeries_Init();
+
+    TestIntRoundTrip();
+    TestFloatRoundTrip(1);
+    TestFloatRoundTrip(100);
+    TestBoolStringRoundTrip();
+    TestFull();
+    Benchmark(TIME_SERIES_TYPE_INT, "int");
+    Benchmark(TIME_SERIES_TYPE_FLOAT, "float");
+
+    LE_TEST_EXIT;
+}
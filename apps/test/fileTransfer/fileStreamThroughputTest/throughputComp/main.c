@@ -0,0 +1,258 @@
+/**
+ * Throughput test of the fileStream download path.
+ *
+ * Streams a file of pattern data to the file stream service, first through a pipe (spliced
+ * straight to the storage file) and then through a socket (spliced through an intermediate pipe),
+ * and reports the throughput of each download.  The stored files are checked, then deleted.
+ *
+ * @verbatim
+ * $ app start fileStreamThroughputTest
+ * $ app runProc fileStreamThroughputTest --exe=throughputTest -- --size=<MB>
+ * @endverbatim
+ *
+ * The file stream service limits the size of the files it writes (maxFileBytes in
+ * fileStreamService.adef), so the size must stay below that limit.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+#include <sys/socket.h>
+
+#define DEFAULT_SIZE_MB         64
+#define MAX_SIZE_MB             1024
+#define WRITE_CHUNK_BYTES       (64*1024)
+#define BUSY_POLL_MS            10
+#define BUSY_TIMEOUT_MS         (10*60*1000)
+#define TEST_TOPIC              "throughput"
+
+static int SizeMb = DEFAULT_SIZE_MB;
+
+/*
+ * Pattern byte stored at an offset of the file.  It changes every byte and every 256 bytes, so a
+ * lost, duplicated or reordered chunk is caught.
+ */
+static inline uint8_t PatternByte
+(
+    uint64_t offset
+)
+{
+    return (uint8_t)(offset ^ (offset >> 8));
+}
+
+static inline uint64_t GetNowUs
+(
+    void
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    return (uint64_t)now.sec * 1000000 + now.usec;
+}
+
+/*
+ * Write the pattern to the write end of the stream, then close it.
+ */
+static void* WriterThread
+(
+    void* contextPtr
+)
+{
+    int fd = (int)(intptr_t)contextPtr;
+    uint64_t total = (uint64_t)SizeMb * 1024 * 1024;
+    uint64_t offset = 0;
+    uint8_t buffer[WRITE_CHUNK_BYTES];
+
+    while (offset < total)
+    {
+        size_t len = (total - offset < sizeof(buffer)) ? (size_t)(total - offset) : sizeof(buffer);
+        size_t i;
+        ssize_t count;
+
+        for (i = 0; i < len; i++)
+        {
+            buffer[i] = PatternByte(offset + i);
+        }
+
+        for (i = 0; i < len; i += count)
+        {
+            count = write(fd, buffer + i, len - i);
+            if (count < 0)
+            {
+                if (EINTR == errno)
+                {
+                    count = 0;
+                    continue;
+                }
+                LE_ERROR("Failed to write the stream: %m");
+                close(fd);
+                return NULL;
+            }
+        }
+        offset += len;
+    }
+
+    close(fd);
+    return NULL;
+}
+
+/*
+ * Check that the stored file holds the pattern.
+ */
+static bool CheckStoredFile
+(
+    const char* namePtr,
+    uint64_t size
+)
+{
+    char path[LE_FILESTREAMSERVER_FILE_PATH_MAX_BYTES + LE_FILESTREAMSERVER_FILE_NAME_MAX_BYTES];
+    uint8_t buffer[WRITE_CHUNK_BYTES];
+    uint64_t offset = 0;
+    bool isOk = true;
+    size_t len;
+    int fd;
+
+    LE_ASSERT_OK(le_fileStreamServer_GetPathStorage(path, sizeof(path)));
+    len = strlen(path);
+    snprintf(path + len, sizeof(path) - len, "/%s", namePtr);
+
+    fd = open(path, O_RDONLY);
+    if (-1 == fd)
+    {
+        LE_ERROR("Failed to open %s: %m", path);
+        return false;
+    }
+
+    while (isOk)
+    {
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        ssize_t i;
+
+        if (count <= 0)
+        {
+            isOk = (0 == count);
+            break;
+        }
+
+        for (i = 0; i < count; i++)
+        {
+            if (buffer[i] != PatternByte(offset + i))
+            {
+                LE_ERROR("Unexpected byte at offset %"PRIu64, offset + i);
+                isOk = false;
+                break;
+            }
+        }
+        offset += count;
+    }
+
+    close(fd);
+    return isOk && (offset == size);
+}
+
+/*
+ * Download a file through a pair of connected file descriptors, and check it.
+ */
+static void StreamFile
+(
+    const char* namePtr,
+    bool useSocket
+)
+{
+    le_fileStreamClient_StreamMgmt_t streamMgmtObj;
+    uint64_t size = (uint64_t)SizeMb * 1024 * 1024;
+    le_thread_Ref_t writerRef;
+    uint16_t instanceId;
+    uint64_t startUs;
+    uint64_t elapsedUs;
+    int waitedMs = 0;
+    int fds[2];
+
+    LE_TEST_INFO("-------- %s: %d MB through a %s --------",
+                 namePtr, SizeMb, useSocket ? "socket" : "pipe");
+
+    memset(&streamMgmtObj, 0, sizeof(streamMgmtObj));
+    le_utf8_Copy(streamMgmtObj.pkgName, namePtr, sizeof(streamMgmtObj.pkgName), NULL);
+    le_utf8_Copy(streamMgmtObj.pkgTopic, TEST_TOPIC, sizeof(streamMgmtObj.pkgTopic), NULL);
+    streamMgmtObj.direction = LE_FILESTREAMCLIENT_DIRECTION_DOWNLOAD;
+    streamMgmtObj.origin = LE_FILESTREAMCLIENT_ORIGIN_SERVER;
+    streamMgmtObj.pkgSize = size;
+    streamMgmtObj.instanceId = LE_FILESTREAMSERVER_INSTANCE_ID_DOWNLOAD;
+
+    LE_ASSERT_OK(le_fileStreamClient_SetStreamMgmtObject(&streamMgmtObj));
+    le_fileStreamServer_DownloadStatus(LE_FILESTREAMCLIENT_DOWNLOAD_IDLE, size, 0);
+    LE_ASSERT_OK(le_fileStreamServer_InitStream());
+
+    if (useSocket)
+    {
+        LE_ASSERT(0 == socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    }
+    else
+    {
+        LE_ASSERT(0 == pipe(fds));
+    }
+
+    writerRef = le_thread_Create("StreamWriter", WriterThread, (void*)(intptr_t)fds[1]);
+    le_thread_SetJoinable(writerRef);
+
+    startUs = GetNowUs();
+    le_thread_Start(writerRef);
+
+    // The read end is closed by the messaging system once it has been sent.
+    LE_TEST_OK(LE_OK == le_fileStreamServer_Download(fds[0]), "download started");
+
+    while (le_fileStreamServer_IsBusy() && (waitedMs < BUSY_TIMEOUT_MS))
+    {
+        usleep(BUSY_POLL_MS * 1000);
+        waitedMs += BUSY_POLL_MS;
+    }
+    elapsedUs = GetNowUs() - startUs;
+    LE_ASSERT_OK(le_thread_Join(writerRef, NULL));
+
+    LE_TEST_OK(!le_fileStreamServer_IsBusy(), "download finished");
+    LE_TEST_INFO("%s: %"PRIu64" bytes in %"PRIu64" ms, %.1f MB/s",
+                 namePtr, size, elapsedUs / 1000,
+                 (elapsedUs ? size / (double)elapsedUs : 0.0));
+
+    le_fileStreamServer_DownloadStatus(LE_FILESTREAMCLIENT_DOWNLOAD_COMPLETED, 0, 100);
+
+    LE_TEST_OK(LE_OK == le_fileStreamServer_IsFilePresent(namePtr, "", &instanceId),
+               "file stored");
+
+    char name[LE_FILESTREAMSERVER_FILE_NAME_MAX_BYTES];
+    char topic[LE_FILESTREAMSERVER_FILE_TOPIC_MAX_BYTES];
+    char hash[LE_FILESTREAMSERVER_HASH_MAX_BYTES];
+    uint64_t storedSize = 0;
+    uint8_t origin;
+
+    LE_TEST_OK((LE_OK == le_fileStreamServer_GetFileInfoByInstance(instanceId,
+                                                                    name, sizeof(name),
+                                                                    topic, sizeof(topic),
+                                                                    hash, sizeof(hash),
+                                                                    &storedSize, &origin))
+               && (0 == strcmp(name, namePtr)) && (storedSize == size),
+               "file info (size %"PRIu64")", storedSize);
+    LE_TEST_OK(CheckStoredFile(namePtr, size), "stored file content");
+    LE_TEST_OK(LE_OK == le_fileStreamServer_Delete(namePtr), "file deleted");
+}
+
+COMPONENT_INIT
+{
+    le_arg_SetIntVar(&SizeMb, NULL, "size");
+    le_arg_Scan();
+
+    if ((SizeMb <= 0) || (SizeMb > MAX_SIZE_MB))
+    {
+        LE_WARN("Size must be between 1 and %d MB; using %d MB.", MAX_SIZE_MB, DEFAULT_SIZE_MB);
+        SizeMb = DEFAULT_SIZE_MB;
+    }
+
+    LE_TEST_PLAN(12);
+
+    StreamFile("throughputPipe.bin", false);
+    StreamFile("throughputSocket.bin", true);
+
+    LE_TEST_EXIT;
+}
@@ -1,7 +1,10 @@
 #include "legato.h"
+#include "atomFile.h"
 #include "file.h"
 #include "fileDescriptor.h"
 
+#include <sys/wait.h>
+
 
 const char* TestFileList[][3] =
         {
@@ -1139,6 +1142,275 @@ void TestAccessMode
 }
 
 
+// Counts the strings in a file, after letting the atomic file API recover it from any interrupted
+// append or transaction.
+static int CountAfterRecovery
+(
+    const char* filePath
+)
+{
+    int fd = le_atomFile_Open(filePath, LE_FLOCK_READ);
+    LE_ASSERT(fd > 0);
+    int count = CountStringfd(fd);
+    le_atomFile_Close(fd);
+
+    return count;
+}
+
+
+// Replaces the contents of a file with a number of strings.
+static void WriteFile
+(
+    const char* filePath,
+    int count
+)
+{
+    int fd = le_atomFile_Create(filePath, LE_FLOCK_WRITE, LE_FLOCK_REPLACE_IF_EXIST, S_IRWXU);
+    LE_ASSERT(fd > 0);
+    WriteString(fd, count);
+    LE_ASSERT(le_atomFile_Close(fd) == LE_OK);
+}
+
+
+#if LE_CONFIG_ATOM_FILE_CRASH_POINTS
+// Runs a function in a child process that crashes at the given crash point, and waits for the
+// child to die.  With ATOMFILE_CRASH_NONE, the child dies when the function returns, without
+// closing anything.
+//
+// This is a crash of the process, not a power loss: whatever the child wrote, synced or not, is
+// still in the page cache when the files are recovered.  It checks that the recovery is right for
+// the state the files are left in at each step, not that this state is durable.
+static void RunUntilCrash
+(
+    atomFile_CrashPoint_t crashPoint,
+    void (*func)(const char* path1Ptr, const char* path2Ptr),
+    const char* path1Ptr,
+    const char* path2Ptr
+)
+{
+    pid_t childPID = fork();
+    LE_ASSERT(childPID >= 0);
+
+    if (childPID == 0)
+    {
+        atomFile_SetCrashPoint(crashPoint);
+        func(path1Ptr, path2Ptr);
+        _exit(crashPoint == ATOMFILE_CRASH_NONE ? EXIT_SUCCESS : EXIT_FAILURE + 1);
+    }
+
+    int status;
+    LE_ASSERT(waitpid(childPID, &status, 0) == childPID);
+    LE_ASSERT(WIFEXITED(status));
+    LE_ASSERT(WEXITSTATUS(status) ==
+              (crashPoint == ATOMFILE_CRASH_NONE ? EXIT_SUCCESS : EXIT_FAILURE));
+}
+#endif
+
+
+static void AppendFive
+(
+    const char* filePath,
+    const char* unusedPtr
+)
+{
+    int fd = le_atomFile_OpenAppend(filePath);
+    LE_ASSERT(fd > 0);
+    WriteString(fd, 5);
+    le_atomFile_Close(fd);
+}
+
+
+#if LE_CONFIG_ATOM_FILE_CRASH_POINTS
+static void AppendFiveWithoutClosing
+(
+    const char* filePath,
+    const char* unusedPtr
+)
+{
+    int fd = le_atomFile_OpenAppend(filePath);
+    LE_ASSERT(fd > 0);
+    WriteString(fd, 5);
+}
+#endif
+
+
+static void TestAppend
+(
+    const char* filePath
+)
+{
+    WriteFile(filePath, 10);
+
+    // Commit and cancel.
+    int fd = le_atomFile_OpenAppend(filePath);
+    LE_ASSERT(fd > 0);
+    LE_ASSERT((fcntl(fd, F_GETFL) & (O_ACCMODE|O_APPEND)) == (O_RDWR|O_APPEND));
+    LE_ASSERT(le_atomFile_TryOpenAppend(filePath) == LE_WOULD_BLOCK);
+    LE_ASSERT(le_atomFile_TryOpen(filePath, LE_FLOCK_READ) == LE_WOULD_BLOCK);
+    WriteString(fd, 5);
+    LE_ASSERT(le_atomFile_Close(fd) == LE_OK);
+    IfNumStringWritten(15, filePath);
+
+    fd = le_atomFile_OpenAppend(filePath);
+    LE_ASSERT(fd > 0);
+    WriteString(fd, 5);
+    le_atomFile_Cancel(fd);
+    IfNumStringWritten(15, filePath);
+
+#if LE_CONFIG_ATOM_FILE_CRASH_POINTS
+    // Crash at each step: the append is always rolled back.
+    RunUntilCrash(ATOMFILE_CRASH_NONE, AppendFiveWithoutClosing, filePath, NULL);
+    LE_ASSERT(CountAfterRecovery(filePath) == 15);
+
+    RunUntilCrash(ATOMFILE_CRASH_APPEND_RECORD_WRITTEN, AppendFive, filePath, NULL);
+    LE_ASSERT(CountAfterRecovery(filePath) == 15);
+
+    RunUntilCrash(ATOMFILE_CRASH_APPEND_FILE_SYNCED, AppendFive, filePath, NULL);
+    LE_ASSERT(CountAfterRecovery(filePath) == 15);
+#endif
+
+    // The file can still be appended to after recovery.
+    AppendFive(filePath, NULL);
+    IfNumStringWritten(20, filePath);
+
+    LE_ASSERT(le_atomFile_Delete(filePath) == LE_OK);
+    LE_ASSERT(le_atomFile_OpenAppend(filePath) == LE_NOT_FOUND);
+}
+
+
+// Replaces the contents of the two files, in a transaction, with 30 and 40 strings.
+static void CommitTransaction
+(
+    const char* path1Ptr,
+    const char* path2Ptr
+)
+{
+    le_atomFile_TransactionRef_t txnRef = le_atomFile_CreateTransaction();
+
+    int fd = le_atomFile_Create(path1Ptr, LE_FLOCK_WRITE, LE_FLOCK_REPLACE_IF_EXIST, S_IRWXU);
+    LE_ASSERT(fd > 0);
+    WriteString(fd, 30);
+    LE_ASSERT(le_atomFile_AddToTransaction(txnRef, fd) == LE_OK);
+
+    FILE* file = le_atomFile_CreateStream(path2Ptr, LE_FLOCK_WRITE, LE_FLOCK_REPLACE_IF_EXIST,
+                                          S_IRWXU, NULL);
+    LE_ASSERT(file != NULL);
+    WriteStringStream(file, 40);
+    LE_ASSERT(le_atomFile_AddStreamToTransaction(txnRef, file) == LE_OK);
+
+    LE_ASSERT(le_atomFile_CommitTransaction(txnRef) == LE_OK);
+}
+
+
+static void CheckTransactionFiles
+(
+    const char* path1Ptr,
+    int count1,
+    const char* path2Ptr,
+    int count2
+)
+{
+    char path[PATH_MAX];
+    struct stat lockStatus;
+
+    // Recovering the first file also recovers the second one.
+    LE_ASSERT(CountAfterRecovery(path1Ptr) == count1);
+
+    snprintf(path, sizeof(path), "%s.jnl~~", path1Ptr);
+    LE_ASSERT(!file_Exists(path));
+    snprintf(path, sizeof(path), "%s.jnl~~", path2Ptr);
+    LE_ASSERT(!file_Exists(path));
+
+    LE_ASSERT(CountAfterRecovery(path2Ptr) == count2);
+
+    // No mark is left in the lock files.
+    snprintf(path, sizeof(path), "%s.lock~~XXXXXX", path1Ptr);
+    LE_ASSERT((stat(path, &lockStatus) == 0) && (lockStatus.st_size <= 1));
+    snprintf(path, sizeof(path), "%s.lock~~XXXXXX", path2Ptr);
+    LE_ASSERT((stat(path, &lockStatus) == 0) && (lockStatus.st_size <= 1));
+}
+
+
+static void TestTransaction
+(
+    const char* path1Ptr,
+    const char* path2Ptr
+)
+{
+    WriteFile(path1Ptr, 10);
+    WriteFile(path2Ptr, 20);
+
+    // Cancel, then commit.
+    le_atomFile_TransactionRef_t txnRef = le_atomFile_CreateTransaction();
+    int fd1 = le_atomFile_Open(path1Ptr, LE_FLOCK_APPEND);
+    int fd2 = le_atomFile_Open(path2Ptr, LE_FLOCK_APPEND);
+    LE_ASSERT((fd1 > 0) && (fd2 > 0));
+    LE_ASSERT(le_atomFile_AddToTransaction(txnRef, fd1) == LE_OK);
+    LE_ASSERT(le_atomFile_AddToTransaction(txnRef, fd2) == LE_OK);
+    WriteString(fd1, 1);
+    WriteString(fd2, 1);
+    le_atomFile_CancelTransaction(txnRef);
+    IfNumStringWritten(10, path1Ptr);
+    IfNumStringWritten(20, path2Ptr);
+
+    CommitTransaction(path1Ptr, path2Ptr);
+    IfNumStringWritten(30, path1Ptr);
+    IfNumStringWritten(40, path2Ptr);
+    CheckTransactionFiles(path1Ptr, 30, path2Ptr, 40);
+
+#if LE_CONFIG_ATOM_FILE_CRASH_POINTS
+    char path[PATH_MAX];
+
+    // Crash at each step: the files are either both old or both new.
+    static const struct
+    {
+        atomFile_CrashPoint_t crashPoint;
+        bool isCommitted;
+    }
+    steps[] =
+    {
+        { ATOMFILE_CRASH_TXN_FILES_SYNCED,       false },
+        { ATOMFILE_CRASH_TXN_JOURNAL_WRITTEN,    true },
+        { ATOMFILE_CRASH_TXN_DIR_SYNCED,         true },
+        { ATOMFILE_CRASH_TXN_FIRST_FILE_RENAMED, true },
+        { ATOMFILE_CRASH_TXN_JOURNAL_DELETED,    true },
+    };
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(steps); i++)
+    {
+        LE_INFO("Transaction crash point %d", steps[i].crashPoint);
+
+        WriteFile(path1Ptr, 10);
+        WriteFile(path2Ptr, 20);
+        RunUntilCrash(steps[i].crashPoint, CommitTransaction, path1Ptr, path2Ptr);
+
+        if (steps[i].isCommitted)
+        {
+            CheckTransactionFiles(path1Ptr, 30, path2Ptr, 40);
+        }
+        else
+        {
+            CheckTransactionFiles(path1Ptr, 10, path2Ptr, 20);
+        }
+    }
+
+    // Power loss before the directory sync, in which the second temp file's directory entry is
+    // lost.  A crash of the process keeps the entry, so its loss is simulated by hand: the
+    // transaction must be rolled back.
+    WriteFile(path1Ptr, 10);
+    WriteFile(path2Ptr, 20);
+    RunUntilCrash(ATOMFILE_CRASH_TXN_JOURNAL_WRITTEN, CommitTransaction, path1Ptr, path2Ptr);
+    snprintf(path, sizeof(path), "%s.bak~~XXXXXX", path2Ptr);
+    LE_ASSERT(unlink(path) == 0);
+    CheckTransactionFiles(path1Ptr, 10, path2Ptr, 20);
+#endif
+
+    LE_ASSERT(le_atomFile_Delete(path1Ptr) == LE_OK);
+    LE_ASSERT(le_atomFile_Delete(path2Ptr) == LE_OK);
+}
+
+
 COMPONENT_INIT
 {
 
@@ -1169,6 +1441,15 @@ COMPONENT_INIT
         TestMultiProcessAccess(TestFileList[i][2]);
         LE_INFO("======== Multi process test done ========");
 
+        LE_INFO("======== Starting append test for file: %s ========", TestFileList[i][1]);
+        TestAppend(TestFileList[i][1]);
+        LE_INFO("======== Append test done ========");
+
+        LE_INFO("======== Starting transaction test for files: %s, %s ========",
+                TestFileList[i][1], TestFileList[i][2]);
+        TestTransaction(TestFileList[i][1], TestFileList[i][2]);
+        LE_INFO("======== Transaction test done ========");
+
         int j = 0;
         for (j = 0; j < 3; j++)
         {
@@ -804,6 +804,31 @@ static void BinaryTest
     LE_TEST(len == sizeof(writeBuf));
     LE_TEST((memcmp(writeBuf, readBuf, len) == 0));
 
+    // binary data is reported as a string, and only stored as its own node type with format 2
+    iterRefRead = le_cfg_CreateReadTxn(pathBuffer);
+    LE_TEST(le_cfg_GetNodeType(iterRefRead, "") == LE_CFG_TYPE_STRING);
+    LE_TEST(le_cfg_IsBinary(iterRefRead, "") == (LE_CONFIG_CFGTREE_FORMAT_VERSION >= 2));
+    le_cfg_CancelTxn(iterRefRead);
+
+    // values written as base64 strings, the way binary data used to be stored, can still be read
+    iterRefWrite = le_cfg_CreateWriteTxn(pathBuffer);
+    le_cfg_SetString(iterRefWrite, "", "AAECAw==");
+    le_cfg_CommitTxn(iterRefWrite);
+
+    len = sizeof(readBuf);
+    iterRefRead = le_cfg_CreateReadTxn(pathBuffer);
+    result = le_cfg_GetBinary(iterRefRead, "", readBuf, &len, &defaultVal, sizeof(defaultVal));
+    le_cfg_CancelTxn(iterRefRead);
+
+    LE_TEST(result == LE_OK);
+    LE_TEST(len == 4);
+    LE_TEST((memcmp(writeBuf, readBuf, len) == 0));
+
+    // write the maximum size again for the overflow check
+    iterRefWrite = le_cfg_CreateWriteTxn(pathBuffer);
+    le_cfg_SetBinary(iterRefWrite, "", writeBuf, sizeof(writeBuf));
+    le_cfg_CommitTxn(iterRefWrite);
+
     // attempt to read the binary data with insufficient buffer size
     memset(readBuf, 0, sizeof(readBuf));
     len = sizeof(readBuf) - 1;
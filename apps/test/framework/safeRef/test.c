@@ -1,6 +1,117 @@
 
 #include "legato.h"
 
+// Number of references created and deleted by the churn test.
+#define CHURN_COUNT     100000
+
+// Number of references kept alive during the churn test.
+#define CHURN_LIVE      4000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that deleted references are rejected once their entries are reused, and that a map grows
+ * past its nominal maximum.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestReuseAndOverflow
+(
+    void
+)
+{
+    static void* refs[1000];
+    le_ref_MapRef_t mapRef = le_ref_CreateMap("Map 2", 4);
+    le_ref_IterRef_t iterRef;
+    size_t count = 0;
+    size_t i;
+
+    LE_INFO("Checking stale references in map %p.", mapRef);
+
+    void* staleRef = le_ref_CreateRef(mapRef, (void*)0x2001);
+    le_ref_DeleteRef(mapRef, staleRef);
+
+    // Reuse every entry, including the one of the stale reference
+    for (i = 0; i < 4; i++)
+    {
+        refs[i] = le_ref_CreateRef(mapRef, (void*)(0x3000 + i));
+        LE_ASSERT(refs[i] != staleRef);
+    }
+    LE_ASSERT(le_ref_Lookup(mapRef, staleRef) == NULL);
+    LE_INFO("Deleting a stale reference (expect ERROR)");
+    le_ref_DeleteRef(mapRef, staleRef);
+    for (i = 0; i < 4; i++)
+    {
+        LE_ASSERT(le_ref_Lookup(mapRef, refs[i]) == (void*)(0x3000 + i));
+    }
+
+    LE_INFO("Growing map %p past its maximum (expect WARNINGs).", mapRef);
+
+    for (i = 4; i < NUM_ARRAY_MEMBERS(refs); i++)
+    {
+        refs[i] = le_ref_CreateRef(mapRef, (void*)(0x3000 + i));
+    }
+    for (i = 0; i < NUM_ARRAY_MEMBERS(refs); i += 2)
+    {
+        le_ref_DeleteRef(mapRef, refs[i]);
+    }
+    for (i = 0; i < NUM_ARRAY_MEMBERS(refs); i++)
+    {
+        LE_ASSERT(le_ref_Lookup(mapRef, refs[i]) == ((i % 2) ? (void*)(0x3000 + i) : NULL));
+    }
+
+    iterRef = le_ref_GetIterator(mapRef);
+    while (le_ref_NextNode(iterRef) == LE_OK)
+    {
+        i = (uintptr_t)le_ref_GetValue(iterRef) - 0x3000;
+        LE_ASSERT(i < NUM_ARRAY_MEMBERS(refs) && (i % 2) && le_ref_GetSafeRef(iterRef) == refs[i]);
+        count++;
+    }
+    LE_ASSERT(count == NUM_ARRAY_MEMBERS(refs) / 2);
+    LE_INFO("  Iterated over %" PRIuS " references.", count);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create and delete many references, keeping a large number of them alive, and measure the time
+ * taken by each operation.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestChurn
+(
+    void
+)
+{
+    static void* refs[CHURN_LIVE];
+    le_ref_MapRef_t mapRef = le_ref_CreateMap("Churn", CHURN_LIVE);
+    le_clk_Time_t startTime;
+    le_clk_Time_t duration;
+    size_t i;
+
+    LE_INFO("Churning %d references in map %p.", CHURN_COUNT, mapRef);
+
+    for (i = 0; i < CHURN_LIVE; i++)
+    {
+        refs[i] = le_ref_CreateRef(mapRef, (void*)(0x1000 + 4 * i));
+    }
+
+    startTime = le_clk_GetRelativeTime();
+
+    // Replace the oldest reference by a new one, then check both
+    for (i = CHURN_LIVE; i < CHURN_LIVE + CHURN_COUNT; i++)
+    {
+        void* oldRef = refs[i % CHURN_LIVE];
+
+        LE_ASSERT(le_ref_Lookup(mapRef, oldRef) == (void*)(0x1000 + 4 * (i - CHURN_LIVE)));
+        le_ref_DeleteRef(mapRef, oldRef);
+        refs[i % CHURN_LIVE] = le_ref_CreateRef(mapRef, (void*)(0x1000 + 4 * i));
+        LE_ASSERT(le_ref_Lookup(mapRef, oldRef) == NULL);
+        LE_ASSERT(le_ref_Lookup(mapRef, refs[i % CHURN_LIVE]) == (void*)(0x1000 + 4 * i));
+    }
+
+    duration = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    LE_INFO("  %d create/delete cycles with %d live references in %ld.%06ld s.",
+            CHURN_COUNT, CHURN_LIVE, (long)duration.sec, (long)duration.usec);
+}
+
 COMPONENT_INIT
 {
     LE_INFO("======== BEGIN SAFE REFERENCES TEST ========");
@@ -64,6 +175,8 @@ COMPONENT_INIT
     LE_ASSERT(le_ref_Lookup(mapRef1, &mapRef1) == NULL);
     LE_INFO("Looking up a pointer value failed, as expected");
 
+    TestReuseAndOverflow();
+    TestChurn();
 
     LE_INFO("======== SAFE REFERENCES TEST COMPLETE (PASSED) ========");
     exit(EXIT_SUCCESS);
@@ -10,6 +10,13 @@
   * $ app runProc flashApiTest --exe=flashApiTest -- help
   * @endverbatim
   *
+  * The stream-dump and stream-flash actions may be tried on a MTD simulated by nandsim, e.g.:
+  * @verbatim
+  * $ modprobe nandsim first_id_byte=0x20 second_id_byte=0xaa third_id_byte=0x00 fourth_id_byte=0x15
+  * $ app runProc flashApiTest --exe=flashApiTest -- stream-flash "NAND simulator" /tmp/image.bin
+  * $ app runProc flashApiTest --exe=flashApiTest -- stream-dump "NAND simulator" /tmp/dump.bin
+  * @endverbatim
+  *
   * Copyright (C) Sierra Wireless Inc.
   *
   */
@@ -58,6 +65,8 @@ static le_result_t FlashApiTest_CreateUbi(char **args);
 static le_result_t FlashApiTest_CreateUbiVol(char **args);
 static le_result_t FlashApiTest_DeleteUbiVol(char **args);
 static le_result_t FlashApiTest_CopyUbi(char **args);
+static le_result_t FlashApiTest_StreamDump(char **args);
+static le_result_t FlashApiTest_StreamFlash(char **args);
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -101,6 +110,12 @@ static FlashApiTest_t FlashApiTest[] =
     { "ubi-copy",       3, FlashApiTest_CopyUbi,
       "ubi-copy sourceName volumeName destinationName: copy the UBI volume from"
            " source to the destination",                                        },
+    { "stream-dump",    2, FlashApiTest_StreamDump,
+      "stream-dump paritionName fileName: dump a whole partition into the given"
+           " file through a stream",                                            },
+    { "stream-flash",   2, FlashApiTest_StreamFlash,
+      "stream-flash paritionName fileName: flash the file into the given"
+           " partition through a stream",                                       },
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -1377,6 +1392,201 @@ static le_result_t FlashApiTest_CopyUbi
 }
 //! [UbiCopy]
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Context of the stream in progress
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static struct
+{
+    le_flash_PartitionRef_t partRef;        ///< Partition reference
+    bool                    isWrite;        ///< True if the file is written to the partition
+    int                     streamFd;       ///< File descriptor of the stream
+    int                     fileFd;         ///< File descriptor of the file
+    le_fdMonitor_Ref_t      fdMonitor;      ///< Monitor of the stream
+}
+Stream;
+
+//! [StreamDump]
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy data between the stream and the file, until the end of one of them.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamCopy
+(
+    void
+)
+{
+    static uint8_t data[LE_FLASH_MAX_READ_SIZE];
+    ssize_t readSize;
+    ssize_t writeSize;
+    ssize_t offset;
+
+    readSize = read(Stream.isWrite ? Stream.fileFd : Stream.streamFd, data, sizeof(data));
+    for (offset = 0; offset < readSize; offset += writeSize)
+    {
+        writeSize = write(Stream.isWrite ? Stream.streamFd : Stream.fileFd,
+                          data + offset, readSize - offset);
+        if (-1 == writeSize)
+        {
+            LE_ERROR("Write failed: %m");
+            readSize = -1;
+            break;
+        }
+    }
+
+    // Once the end is reached, closing the stream ends a write stream.
+    if (readSize <= 0)
+    {
+        le_fdMonitor_Delete(Stream.fdMonitor);
+        Stream.fdMonitor = NULL;
+        close(Stream.streamFd);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler for the events of the stream.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamFdHandler
+(
+    int   fd,
+    short events
+)
+{
+    StreamCopy();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler for the end of the stream: close the partition and exit with the result.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamEndHandler
+(
+    le_flash_PartitionRef_t partRef,
+    le_result_t result,
+    uint32_t size,
+    void* contextPtr
+)
+{
+    LE_INFO("Stream of partition ref %p ended: %u bytes, res %d", partRef, size, result);
+
+    // The data of a read stream may still be pending in the stream when the end is reported.
+    while ((!Stream.isWrite) && (Stream.fdMonitor))
+    {
+        StreamCopy();
+    }
+    if (Stream.fdMonitor)
+    {
+        le_fdMonitor_Delete(Stream.fdMonitor);
+        close(Stream.streamFd);
+    }
+    close(Stream.fileFd);
+
+    le_flash_Close(partRef);
+    le_flash_ReleaseAccess();
+    exit(LE_OK == result ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start streaming a whole MTD partition to a file, or a file to a whole MTD partition.
+ *
+ * @return LE_IN_PROGRESS if the stream is started: the result is reported by the exit status.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StartStream
+(
+    const char* partNameStr,
+    const char* fileNameStr,
+    bool isWrite
+)
+{
+    le_result_t res;
+
+    Stream.isWrite = isWrite;
+    Stream.fileFd = open(fileNameStr, isWrite ? O_RDONLY : (O_WRONLY | O_TRUNC | O_CREAT), 0644);
+    if (-1 == Stream.fileFd)
+    {
+        LE_ERROR("Failed to open '%s': %m", fileNameStr);
+        return LE_FAULT;
+    }
+
+    res = le_flash_OpenMtd(partNameStr, isWrite ? LE_FLASH_WRITE_ONLY : LE_FLASH_READ_ONLY,
+                           &Stream.partRef);
+    LE_INFO("partition \"%s\" open ref %p, res %d", partNameStr, Stream.partRef, res);
+    if (LE_OK != res)
+    {
+        close(Stream.fileFd);
+        return res;
+    }
+
+    if (NULL == le_flash_AddStreamEndHandler(Stream.partRef, StreamEndHandler, NULL))
+    {
+        close(Stream.fileFd);
+        le_flash_Close(Stream.partRef);
+        return LE_FAULT;
+    }
+
+    // The whole partition, from the first block. Data are read from the flash as the stream is
+    // read, and written to the flash as the stream is written, block by block.
+    if (isWrite)
+    {
+        res = le_flash_OpenWriteStream(Stream.partRef, 0, 0, &Stream.streamFd);
+    }
+    else
+    {
+        res = le_flash_OpenReadStream(Stream.partRef, 0, 0, &Stream.streamFd);
+    }
+    LE_INFO("partition \"%s\" open stream fd %d, res %d", partNameStr, Stream.streamFd, res);
+    if (LE_OK != res)
+    {
+        close(Stream.fileFd);
+        le_flash_Close(Stream.partRef);
+        return res;
+    }
+
+    Stream.fdMonitor = le_fdMonitor_Create("flashStream", Stream.streamFd, StreamFdHandler,
+                                           isWrite ? POLLOUT : POLLIN);
+    return LE_IN_PROGRESS;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dump a whole MTD partition into a file through a stream
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FlashApiTest_StreamDump
+(
+    char **args
+)
+{
+    return StartStream(args[0], args[1], false);
+}
+//! [StreamDump]
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flash a file into a MTD partition through a stream
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FlashApiTest_StreamFlash
+(
+    char **args
+)
+{
+    return StartStream(args[0], args[1], true);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Main thread.
@@ -1410,6 +1620,11 @@ COMPONENT_INIT
                if (LE_OK == res)
                {
                    res = FlashApiTest[idx].flashApi((char **)args);
+                   if (LE_IN_PROGRESS == res)
+                   {
+                       // Completion reported by an event
+                       return;
+                   }
                }
                else
                {
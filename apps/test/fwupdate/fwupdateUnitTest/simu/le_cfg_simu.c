@@ -104,8 +104,11 @@ typedef enum
     LE_CFG_TYPE_STEM,
         ///< Non-leaf node, this node is the parent of other nodes.
 
-    LE_CFG_TYPE_DOESNT_EXIST
+    LE_CFG_TYPE_DOESNT_EXIST,
         ///< Node doesn't exist.
+
+    LE_CFG_TYPE_BINARY
+        ///< Array of bytes.
 }
 le_cfg_nodeType_t;
 
@@ -0,0 +1,305 @@
+/**
+ * This module implements a test of the GPIO character device access of the GPIO service.
+ *
+ * The test drives the first lines of a GPIO chip, which must not be wired to anything: the kernel
+ * gpio-sim module provides such a chip, e.g. with configfs:
+ *
+ *    mkdir /sys/kernel/config/gpio-sim/test /sys/kernel/config/gpio-sim/test/bank0
+ *    echo 8 > /sys/kernel/config/gpio-sim/test/bank0/num_lines
+ *    echo 1 > /sys/kernel/config/gpio-sim/test/live
+ *
+ * When the chip is a gpio-sim chip, the edge events are also tested by pulling an input line up and
+ * down through its sim_gpio attributes. The time needed to toggle an output is reported.
+ *
+ * Usage: gpioChardevTest <chip device> [toggleCount]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "gpioChardev.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of toggles of the timing measure.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_TOGGLE_COUNT    10000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timeout waiting for an edge event, in milliseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define EVENT_TIMEOUT_MS        1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pull a line of a gpio-sim chip up or down.
+ *
+ * @return true on success, false if the chip is not a gpio-sim chip
+ */
+//--------------------------------------------------------------------------------------------------
+static bool PullSimLine
+(
+    const char* chipPathPtr,    ///< [IN] Chip device
+    uint32_t    offset,         ///< [IN] Line offset
+    bool        isUp            ///< [IN] Pull up, otherwise down
+)
+{
+    char path[PATH_MAX];
+    const char* valuePtr = isUp ? "pull-up" : "pull-down";
+    bool isOk;
+    int fd;
+
+    snprintf(path, sizeof(path), "/sys/bus/gpio/devices/%s/sim_gpio%"PRIu32"/pull",
+             le_path_GetBasenamePtr(chipPathPtr, "/"), offset);
+
+    fd = open(path, O_WRONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    isOk = (write(fd, valuePtr, strlen(valuePtr)) == (ssize_t)strlen(valuePtr));
+    close(fd);
+
+    return isOk;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Wait for the next edge event of a request.
+ *
+ * @return LE_OK if an event is read, LE_TIMEOUT or LE_FAULT otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WaitEvent
+(
+    int       fd,               ///< [IN] Request file descriptor
+    uint32_t* offsetPtr,        ///< [OUT] Line offset
+    bool*     isRisingPtr       ///< [OUT] Rising edge
+)
+{
+    struct pollfd pollFd = { .fd = fd, .events = POLLIN };
+    int ret = poll(&pollFd, 1, EVENT_TIMEOUT_MS);
+
+    if (ret == 0)
+    {
+        return LE_TIMEOUT;
+    }
+    if (ret == -1)
+    {
+        return LE_FAULT;
+    }
+
+    return gpioChardev_ReadEvent(fd, offsetPtr, isRisingPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the lines requested one by one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestSingleLine
+(
+    void
+)
+{
+    uint32_t offset = 0;
+    uint32_t flags = GPIOCHARDEV_OUTPUT;
+    uint32_t lineFlags = 0;
+    uint64_t values = 0;
+    int otherFd;
+    int fd;
+
+    LE_TEST_ASSERT(gpioChardev_Request(&offset, &flags, 1, 1, "gpioChardevTest", &fd) == LE_OK,
+                   "Request line 0 as an output");
+
+    LE_TEST_OK((gpioChardev_GetValues(fd, 1, &values) == LE_OK) && (values == 1),
+               "Initial value of the output");
+    LE_TEST_OK(gpioChardev_SetValues(fd, 1, 0) == LE_OK, "Deactivate the output");
+    LE_TEST_OK((gpioChardev_GetValues(fd, 1, &values) == LE_OK) && (values == 0),
+               "Read the output back");
+
+    LE_TEST_OK(gpioChardev_GetLineFlags(offset, &lineFlags) == LE_OK &&
+               (lineFlags & GPIOCHARDEV_OUTPUT) && !(lineFlags & GPIOCHARDEV_ACTIVE_LOW),
+               "Line info of an active-high output");
+
+    flags = GPIOCHARDEV_OUTPUT | GPIOCHARDEV_ACTIVE_LOW;
+    LE_TEST_OK(gpioChardev_SetConfig(fd, &flags, 1, 1) == LE_OK, "Reconfigure as active-low");
+    LE_TEST_OK(gpioChardev_GetLineFlags(offset, &lineFlags) == LE_OK &&
+               (lineFlags & GPIOCHARDEV_ACTIVE_LOW), "Line info of an active-low output");
+    LE_TEST_OK((gpioChardev_GetValues(fd, 1, &values) == LE_OK) && (values == 1),
+               "Active-low output read as active");
+
+    flags = 0;
+    LE_TEST_OK(gpioChardev_Request(&offset, &flags, 1, 0, "gpioChardevTest", &otherFd) == LE_BUSY,
+               "A line cannot be requested twice");
+
+    gpioChardev_Release(fd);
+
+    // Without direction flag, the output keeps its direction
+    LE_TEST_ASSERT(gpioChardev_Request(&offset, &flags, 1, 0, "gpioChardevTest", &fd) == LE_OK,
+                   "Request line 0 as it is");
+    LE_TEST_OK(gpioChardev_GetLineFlags(offset, &lineFlags) == LE_OK &&
+               (lineFlags & GPIOCHARDEV_OUTPUT), "Line kept as an output");
+    gpioChardev_Release(fd);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test a request of several lines, with different configurations.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestGroup
+(
+    void
+)
+{
+    uint32_t offsets[] = { 1, 2, 3, 4 };
+    uint32_t flags[] = { GPIOCHARDEV_OUTPUT, GPIOCHARDEV_OUTPUT | GPIOCHARDEV_ACTIVE_LOW,
+                         GPIOCHARDEV_OUTPUT, GPIOCHARDEV_INPUT | GPIOCHARDEV_PULL_DOWN };
+    uint32_t lineFlags = 0;
+    uint64_t values = 0;
+    int fd;
+
+    LE_TEST_ASSERT(gpioChardev_Request(offsets, flags, NUM_ARRAY_MEMBERS(offsets), 0x5,
+                                       "gpioChardevTest", &fd) == LE_OK,
+                   "Request 4 lines with 3 configurations");
+
+    LE_TEST_OK((gpioChardev_GetValues(fd, 0x7, &values) == LE_OK) && (values == 0x5),
+               "Initial values of the outputs");
+    LE_TEST_OK(gpioChardev_GetLineFlags(2, &lineFlags) == LE_OK &&
+               (lineFlags & GPIOCHARDEV_ACTIVE_LOW), "Configuration of the second line");
+    LE_TEST_OK(gpioChardev_GetLineFlags(4, &lineFlags) == LE_OK &&
+               (lineFlags & GPIOCHARDEV_INPUT), "Configuration of the fourth line");
+
+    LE_TEST_OK(gpioChardev_SetValues(fd, 0x3, 0x2) == LE_OK, "Write 2 outputs at once");
+    LE_TEST_OK((gpioChardev_GetValues(fd, 0x7, &values) == LE_OK) && (values == 0x6),
+               "Read the outputs back");
+
+    gpioChardev_Release(fd);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test the edge events of an input of a gpio-sim chip.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestEvents
+(
+    const char* chipPathPtr     ///< [IN] Chip device
+)
+{
+    uint32_t offset = 5;
+    uint32_t flags = GPIOCHARDEV_INPUT | GPIOCHARDEV_EDGE_BOTH;
+    uint32_t eventOffset = 0;
+    bool isRising = false;
+    bool isSim = PullSimLine(chipPathPtr, offset, false);
+    int fd = -1;
+
+    LE_TEST_BEGIN_SKIP(!isSim, 5);
+
+    LE_TEST_ASSERT(gpioChardev_Request(&offset, &flags, 1, 0, "gpioChardevTest", &fd) == LE_OK,
+                   "Request line 5 as an input with edge detection");
+
+    LE_TEST_OK(gpioChardev_ReadEvent(fd, &eventOffset, &isRising) == LE_WOULD_BLOCK,
+               "No event pending");
+
+    PullSimLine(chipPathPtr, offset, true);
+    LE_TEST_OK((WaitEvent(fd, &eventOffset, &isRising) == LE_OK) && (eventOffset == offset) &&
+               isRising, "Rising edge reported");
+
+    PullSimLine(chipPathPtr, offset, false);
+    LE_TEST_OK((WaitEvent(fd, &eventOffset, &isRising) == LE_OK) && (eventOffset == offset) &&
+               !isRising, "Falling edge reported");
+
+    flags = GPIOCHARDEV_INPUT;
+    LE_TEST_OK(gpioChardev_SetConfig(fd, &flags, 1, 0) == LE_OK, "Disable edge detection");
+    PullSimLine(chipPathPtr, offset, true);
+    LE_TEST_OK(WaitEvent(fd, &eventOffset, &isRising) == LE_TIMEOUT, "No more edge reported");
+
+    gpioChardev_Release(fd);
+
+    LE_TEST_END_SKIP();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measure the time needed to toggle an output.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MeasureToggle
+(
+    uint32_t toggleCount        ///< [IN] Number of toggles
+)
+{
+    uint32_t offset = 0;
+    uint32_t flags = GPIOCHARDEV_OUTPUT;
+    le_clk_Time_t startTime;
+    le_clk_Time_t duration;
+    uint64_t usec;
+    bool isOk = true;
+    uint32_t i;
+    int fd;
+
+    LE_TEST_ASSERT(gpioChardev_Request(&offset, &flags, 1, 0, "gpioChardevTest", &fd) == LE_OK,
+                   "Request line 0 for the measure");
+
+    startTime = le_clk_GetRelativeTime();
+    for (i = 0; i < toggleCount; i++)
+    {
+        isOk = isOk && (gpioChardev_SetValues(fd, 1, i & 1) == LE_OK);
+    }
+    duration = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+    usec = (uint64_t)duration.sec * 1000000 + duration.usec;
+
+    LE_TEST_OK(isOk, "Toggle the output");
+    LE_TEST_INFO("%"PRIu32" toggles in %"PRIu64" us, %.2f us/toggle", toggleCount, usec,
+                 toggleCount ? (double)usec / toggleCount : 0.0);
+
+    gpioChardev_Release(fd);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the test.
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    uint32_t toggleCount = DEFAULT_TOGGLE_COUNT;
+    const char* chipPathPtr = NULL;
+    le_result_t result;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        chipPathPtr = le_arg_GetArg(0);
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        toggleCount = strtoul(le_arg_GetArg(1), NULL, 0);
+    }
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    result = (chipPathPtr != NULL) ? gpioChardev_Open(chipPathPtr) : LE_NOT_FOUND;
+    if ((result == LE_NOT_FOUND) || (result == LE_UNSUPPORTED))
+    {
+        LE_TEST_INFO("No GPIO chip to test (%s), skipping", LE_RESULT_TXT(result));
+        LE_TEST_EXIT;
+    }
+
+    LE_TEST_ASSERT(result == LE_OK, "Open %s", chipPathPtr);
+    LE_TEST_ASSERT(gpioChardev_GetLineCount() >= 6, "Chip has at least 6 lines");
+
+    TestSingleLine();
+    TestGroup();
+    TestEvents(chipPathPtr);
+    MeasureToggle(toggleCount);
+
+    gpioChardev_Close();
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,714 @@
+/**
+ * @file httpLoopbackTest.c
+ *
+ * This module implements a test of the HTTP client library against a minimal HTTP server running in
+ * a thread of the test, on the loopback interface. It checks that:
+ *  - connections are kept open between requests and reused by later sessions (keep-alive),
+ *  - response bodies with a length or in chunks are received entirely,
+ *  - request bodies built by the body construct and body send callbacks are sent entirely, with or
+ *    without chunked transfer encoding,
+ *  - a new connection is opened when the server closes the connection.
+ *
+ * Usage:
+ *   - app runProc httpLoopbackTest httpLoopbackTest
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "le_httpClientLib.h"
+
+#include <arpa/inet.h>
+
+//--------------------------------------------------------------------------------------------------
+// Symbol and Enum definitions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Loopback address of the server
+ */
+//--------------------------------------------------------------------------------------------------
+#define SERVER_ADDR           "127.0.0.1"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reception timeout in milliseconds
+ */
+//--------------------------------------------------------------------------------------------------
+#define RX_TIMEOUT_MS         5000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a request header and body received by the server
+ */
+//--------------------------------------------------------------------------------------------------
+#define SERVER_HEADER_SIZE    2048
+#define SERVER_BODY_SIZE      65536
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the chunks of the chunked responses sent by the server
+ */
+//--------------------------------------------------------------------------------------------------
+#define SERVER_CHUNK_SIZE     1000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the request bodies sent by the test
+ */
+//--------------------------------------------------------------------------------------------------
+#define CONSTRUCT_BODY_SIZE   5000
+#define SEND_BODY_SIZE        20000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the first chunk of the body send callback, small enough to be gathered with the header.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SEND_FIRST_CHUNK_SIZE 100
+
+//--------------------------------------------------------------------------------------------------
+// Internal variables
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Listening socket and port of the server
+ */
+//--------------------------------------------------------------------------------------------------
+static int ListenFd = -1;
+static uint16_t ServerPort;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of connections accepted by the server
+ */
+//--------------------------------------------------------------------------------------------------
+static int ConnectionCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffers of the server
+ */
+//--------------------------------------------------------------------------------------------------
+static char ServerHeader[SERVER_HEADER_SIZE];
+static char ServerBody[SERVER_BODY_SIZE];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Response of the current request: status code, body length and whether the body matches the
+ * expected pattern.
+ */
+//--------------------------------------------------------------------------------------------------
+static int StatusCode;
+static size_t BodyLength;
+static bool IsBodyValid;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request body: Content-Length header field value (0 for none), and length already provided to the
+ * library.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t ContentLength;
+static size_t BodyOffset;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Data of the body send callback
+ */
+//--------------------------------------------------------------------------------------------------
+static char SendBody[SEND_BODY_SIZE];
+
+//--------------------------------------------------------------------------------------------------
+// Functions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Byte of the pattern used for all the bodies, at a given offset.
+ */
+//--------------------------------------------------------------------------------------------------
+static char Pattern
+(
+    size_t offset       ///< [IN] Offset in the body
+)
+{
+    return 'a' + (offset % 26);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read from a connection of the server until a given length is read.
+ *
+ * @return true on success, false if the connection is closed
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ServerRead
+(
+    int     fd,         ///< [IN] Connection
+    char*   bufPtr,     ///< [OUT] Buffer
+    size_t  length      ///< [IN] Length to read
+)
+{
+    while (length)
+    {
+        ssize_t count = recv(fd, bufPtr, length, 0);
+        if (count <= 0)
+        {
+            return false;
+        }
+        bufPtr += count;
+        length -= count;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a line (up to and including CRLF) from a connection of the server.
+ *
+ * @return Length of the line without CRLF, or -1 if the connection is closed or the line too long
+ */
+//--------------------------------------------------------------------------------------------------
+static int ServerReadLine
+(
+    int     fd,         ///< [IN] Connection
+    char*   bufPtr,     ///< [OUT] Buffer
+    size_t  size        ///< [IN] Buffer size
+)
+{
+    size_t length = 0;
+
+    while (length < size - 1)
+    {
+        if (!ServerRead(fd, bufPtr + length, 1))
+        {
+            return -1;
+        }
+        length++;
+
+        if ((length >= 2) && (bufPtr[length - 2] == '\r') && (bufPtr[length - 1] == '\n'))
+        {
+            length -= 2;
+            bufPtr[length] = '\0';
+            return length;
+        }
+    }
+
+    return -1;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write to a connection of the server.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ServerWrite
+(
+    int         fd,         ///< [IN] Connection
+    const char* bufPtr,     ///< [IN] Data
+    size_t      length      ///< [IN] Data length
+)
+{
+    while (length)
+    {
+        ssize_t count = send(fd, bufPtr, length, MSG_NOSIGNAL);
+        if (count <= 0)
+        {
+            return;
+        }
+        bufPtr += count;
+        length -= count;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive a request and send its response.  Supported requests:
+ *  - GET /length/<n>   Response body of n bytes, with a Content-Length
+ *  - GET /chunked/<n>  Response body of n bytes, in chunks
+ *  - GET /close        Response body of 3 bytes, then the server closes the connection
+ *  - POST /echo        Response body identical to the request body
+ * HEAD requests get the header of the GET response only.
+ *
+ * @return true if the connection stays open, false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ServeRequest
+(
+    int fd              ///< [IN] Connection
+)
+{
+    char method[16] = {0};
+    char path[256] = {0};
+    char line[SERVER_HEADER_SIZE];
+    size_t contentLength = 0;
+    size_t bodyLength = 0;
+    bool isChunked = false;
+    bool isClosing = false;
+    bool isHead;
+    const char* bodyPtr = ServerBody;
+    size_t length;
+    size_t i;
+    int lineLen;
+
+    // Request line and header fields
+    if (ServerReadLine(fd, ServerHeader, sizeof(ServerHeader)) <= 0)
+    {
+        return false;
+    }
+    if (sscanf(ServerHeader, "%15s %255s", method, path) != 2)
+    {
+        return false;
+    }
+    while ((lineLen = ServerReadLine(fd, line, sizeof(line))) > 0)
+    {
+        if (0 == strncasecmp(line, "content-length:", strlen("content-length:")))
+        {
+            contentLength = strtoul(line + strlen("content-length:"), NULL, 10);
+        }
+        else if (0 == strcasecmp(line, "transfer-encoding: chunked"))
+        {
+            isChunked = true;
+        }
+    }
+    if (lineLen < 0)
+    {
+        return false;
+    }
+
+    // Request body
+    if (isChunked)
+    {
+        do
+        {
+            if (ServerReadLine(fd, line, sizeof(line)) <= 0)
+            {
+                return false;
+            }
+            length = strtoul(line, NULL, 16);
+            if (bodyLength + length > sizeof(ServerBody))
+            {
+                return false;
+            }
+            if ((!ServerRead(fd, ServerBody + bodyLength, length)) ||
+                (ServerReadLine(fd, line, sizeof(line)) != 0))
+            {
+                return false;
+            }
+            bodyLength += length;
+        }
+        while (length);
+    }
+    else if (contentLength)
+    {
+        if ((contentLength > sizeof(ServerBody)) ||
+            (!ServerRead(fd, ServerBody, contentLength)))
+        {
+            return false;
+        }
+        bodyLength = contentLength;
+    }
+
+    // Response
+    isHead = (0 == strcmp(method, "HEAD"));
+    if (0 == strcmp(path, "/echo"))
+    {
+        isChunked = false;
+    }
+    else if (0 == strncmp(path, "/length/", strlen("/length/")))
+    {
+        isChunked = false;
+        bodyLength = strtoul(path + strlen("/length/"), NULL, 10);
+        bodyPtr = NULL;
+    }
+    else if (0 == strncmp(path, "/chunked/", strlen("/chunked/")))
+    {
+        isChunked = true;
+        bodyLength = strtoul(path + strlen("/chunked/"), NULL, 10);
+        bodyPtr = NULL;
+    }
+    else if (0 == strcmp(path, "/close"))
+    {
+        isChunked = false;
+        isClosing = true;
+        bodyLength = 3;
+        bodyPtr = NULL;
+    }
+    else
+    {
+        length = snprintf(line, sizeof(line), "HTTP/1.1 404 Not Found\r\n"
+                                              "Content-Length: 0\r\n\r\n");
+        ServerWrite(fd, line, length);
+        return true;
+    }
+
+    if ((!bodyPtr) && (bodyLength <= sizeof(ServerBody)))
+    {
+        for (i = 0; i < bodyLength; i++)
+        {
+            ServerBody[i] = Pattern(i);
+        }
+        bodyPtr = ServerBody;
+    }
+
+    if (isChunked)
+    {
+        length = snprintf(line, sizeof(line), "HTTP/1.1 200 OK\r\n"
+                                              "Transfer-Encoding: chunked\r\n\r\n");
+        ServerWrite(fd, line, length);
+        if (isHead)
+        {
+            return true;
+        }
+
+        for (i = 0; i < bodyLength; i += length)
+        {
+            char header[16];
+
+            length = ((bodyLength - i) < SERVER_CHUNK_SIZE) ? (bodyLength - i) : SERVER_CHUNK_SIZE;
+            ServerWrite(fd, header, snprintf(header, sizeof(header), "%zx\r\n", length));
+            ServerWrite(fd, bodyPtr + i, length);
+            ServerWrite(fd, "\r\n", 2);
+        }
+        ServerWrite(fd, "0\r\n\r\n", 5);
+    }
+    else
+    {
+        length = snprintf(line, sizeof(line), "HTTP/1.1 200 OK\r\n"
+                                              "Content-Length: %zu\r\n"
+                                              "%s\r\n",
+                                              bodyLength,
+                                              isClosing ? "Connection: close\r\n" : "");
+        ServerWrite(fd, line, length);
+        if (!isHead)
+        {
+            ServerWrite(fd, bodyPtr, bodyLength);
+        }
+    }
+
+    return !isClosing;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Server thread: serve the requests of the accepted connections, one connection at a time.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* ServerThread
+(
+    void* contextPtr    ///< [IN] Unused
+)
+{
+    while (1)
+    {
+        int fd = accept(ListenFd, NULL, NULL);
+        if (fd == -1)
+        {
+            continue;
+        }
+
+        LE_ATOMIC_ADD_FETCH(&ConnectionCount, 1, LE_ATOMIC_ORDER_RELAXED);
+
+        while (ServeRequest(fd))
+        {
+        }
+
+        close(fd);
+    }
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the server on an ephemeral port of the loopback interface.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartServer
+(
+    void
+)
+{
+    struct sockaddr_in addr;
+    socklen_t addrLen = sizeof(addr);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    ListenFd = socket(AF_INET, SOCK_STREAM, 0);
+    LE_TEST_ASSERT(ListenFd != -1, "Create server socket");
+    LE_TEST_ASSERT((bind(ListenFd, (struct sockaddr*)&addr, sizeof(addr)) == 0) &&
+                   (listen(ListenFd, 4) == 0) &&
+                   (getsockname(ListenFd, (struct sockaddr*)&addr, &addrLen) == 0),
+                   "Listen on the loopback interface");
+    ServerPort = ntohs(addr.sin_port);
+
+    le_thread_Start(le_thread_Create("httpServer", ServerThread, NULL));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of connections accepted by the server.
+ */
+//--------------------------------------------------------------------------------------------------
+static int GetConnectionCount
+(
+    void
+)
+{
+    return LE_ATOMIC_ADD_FETCH(&ConnectionCount, 0, LE_ATOMIC_ORDER_RELAXED);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Callback to handle HTTP body response: check it against the pattern.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BodyResponseCb
+(
+    le_httpClient_Ref_t ref,        ///< [IN] HTTP session context reference
+    const char*         dataPtr,    ///< [IN] Received data pointer
+    int                 size        ///< [IN] Received data size
+)
+{
+    int i;
+
+    for (i = 0; i < size; i++)
+    {
+        if (dataPtr[i] != Pattern(BodyLength + i))
+        {
+            IsBodyValid = false;
+        }
+    }
+    BodyLength += size;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Callback to handle HTTP status code
+ */
+//--------------------------------------------------------------------------------------------------
+static void StatusCodeCb
+(
+    le_httpClient_Ref_t ref,        ///< [IN] HTTP session context reference
+    int                 code        ///< [IN] HTTP status code
+)
+{
+    StatusCode = code;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Callback to add the Content-Length header field, if any.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ResourceUpdateCb
+(
+    le_httpClient_Ref_t ref,           ///< [IN] HTTP session context reference
+    char*               keyPtr,        ///< [OUT] Key field pointer
+    int*                keyLenPtr,     ///< [INOUT] Key field size
+    char*               valuePtr,      ///< [OUT] Key value pointer
+    int*                valueLenPtr    ///< [INOUT] Key value size
+)
+{
+    if (!ContentLength)
+    {
+        *keyLenPtr = 0;
+        *valueLenPtr = 0;
+        return LE_TERMINATED;
+    }
+
+    *keyLenPtr = snprintf(keyPtr, *keyLenPtr, "Content-Length");
+    *valueLenPtr = snprintf(valuePtr, *valueLenPtr, "%zu", ContentLength);
+    return LE_TERMINATED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Callback to build a body of CONSTRUCT_BODY_SIZE bytes in the library buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t BodyConstructCb
+(
+    le_httpClient_Ref_t ref,        ///< [IN] HTTP session context reference
+    char*               dataPtr,    ///< [OUT] Data pointer
+    int*                sizePtr     ///< [INOUT] Data pointer size
+)
+{
+    int i;
+
+    // Odd-sized chunks, smaller than the buffer
+    if (*sizePtr > 777)
+    {
+        *sizePtr = 777;
+    }
+    if (*sizePtr > (CONSTRUCT_BODY_SIZE - BodyOffset))
+    {
+        *sizePtr = CONSTRUCT_BODY_SIZE - BodyOffset;
+    }
+
+    for (i = 0; i < *sizePtr; i++)
+    {
+        dataPtr[i] = Pattern(BodyOffset + i);
+    }
+    BodyOffset += *sizePtr;
+
+    return (BodyOffset < CONSTRUCT_BODY_SIZE) ? LE_OK : LE_TERMINATED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Callback to provide a body of SEND_BODY_SIZE bytes from the test buffer: a small chunk, then the
+ *  rest at once.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t BodySendCb
+(
+    le_httpClient_Ref_t ref,        ///< [IN] HTTP session context reference
+    const char**        dataPtrPtr, ///< [OUT] Data pointer
+    size_t*             sizePtr     ///< [OUT] Data size
+)
+{
+    *dataPtrPtr = SendBody + BodyOffset;
+    *sizePtr = BodyOffset ? (SEND_BODY_SIZE - BodyOffset) : SEND_FIRST_CHUNK_SIZE;
+    BodyOffset += *sizePtr;
+
+    return (BodyOffset < SEND_BODY_SIZE) ? LE_OK : LE_TERMINATED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create and start a session to the server.
+ *
+ * @return Session reference
+ */
+//--------------------------------------------------------------------------------------------------
+static le_httpClient_Ref_t StartSession
+(
+    void
+)
+{
+    le_httpClient_Ref_t ref = le_httpClient_CreateOnSrcAddr(SERVER_ADDR, ServerPort, SERVER_ADDR);
+
+    LE_TEST_ASSERT(ref != NULL, "Create a session");
+    LE_TEST_ASSERT((le_httpClient_SetTimeout(ref, RX_TIMEOUT_MS) == LE_OK) &&
+                   (le_httpClient_SetBodyResponseCallback(ref, BodyResponseCb) == LE_OK) &&
+                   (le_httpClient_SetStatusCodeCallback(ref, StatusCodeCb) == LE_OK) &&
+                   (le_httpClient_SetResourceUpdateCallback(ref, ResourceUpdateCb) == LE_OK),
+                   "Configure the session");
+    LE_TEST_ASSERT(le_httpClient_Start(ref) == LE_OK, "Start the session");
+
+    return ref;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send a request and check that the response body matches the pattern.
+ *
+ * @return true if the request succeeded with the expected response body
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendRequest
+(
+    le_httpClient_Ref_t ref,            ///< [IN] Session
+    le_httpCommand_t    command,        ///< [IN] Command
+    char*               uriPtr,         ///< [IN] URI
+    size_t              bodyLength      ///< [IN] Expected response body length
+)
+{
+    le_result_t result;
+
+    StatusCode = 0;
+    BodyLength = 0;
+    IsBodyValid = true;
+    BodyOffset = 0;
+
+    result = le_httpClient_SendRequest(ref, command, uriPtr);
+    if ((result != LE_OK) || (StatusCode != 200) || (BodyLength != bodyLength) || (!IsBodyValid))
+    {
+        LE_TEST_INFO("%s: result %s, status %d, body length %zu, %s", uriPtr, LE_RESULT_TXT(result),
+                     StatusCode, BodyLength, IsBodyValid ? "valid" : "invalid");
+        return false;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Component main function
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    le_httpClient_Ref_t ref;
+    int i;
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    for (i = 0; i < SEND_BODY_SIZE; i++)
+    {
+        SendBody[i] = Pattern(i);
+    }
+
+    StartServer();
+
+    // Responses
+    ref = StartSession();
+    LE_TEST_OK(SendRequest(ref, HTTP_GET, "/length/10000", 10000), "Body with a length");
+    LE_TEST_OK(SendRequest(ref, HTTP_GET, "/chunked/10000", 10000), "Chunked body");
+    LE_TEST_OK(SendRequest(ref, HTTP_GET, "/chunked/0", 0), "Empty chunked body");
+    LE_TEST_OK(SendRequest(ref, HTTP_HEAD, "/length/10000", 0), "HEAD request");
+    LE_TEST_OK(GetConnectionCount() == 1, "Requests sent on the same connection");
+
+    // Request bodies
+    LE_TEST_OK(le_httpClient_SetBodyConstructCallback(ref, BodyConstructCb) == LE_OK,
+               "Set the body construct callback");
+    ContentLength = CONSTRUCT_BODY_SIZE;
+    LE_TEST_OK(SendRequest(ref, HTTP_POST, "/echo", CONSTRUCT_BODY_SIZE),
+               "Built body with a length");
+    ContentLength = 0;
+    LE_TEST_OK(le_httpClient_SetChunkedTransfer(ref, true) == LE_OK, "Enable chunked transfer");
+    LE_TEST_OK(SendRequest(ref, HTTP_POST, "/echo", CONSTRUCT_BODY_SIZE), "Built chunked body");
+
+    LE_TEST_OK(le_httpClient_SetBodySendCallback(ref, BodySendCb) == LE_OK,
+               "Set the body send callback");
+    LE_TEST_OK(SendRequest(ref, HTTP_PUT, "/echo", SEND_BODY_SIZE), "Sent chunked body");
+    LE_TEST_OK(le_httpClient_SetChunkedTransfer(ref, false) == LE_OK, "Disable chunked transfer");
+    ContentLength = SEND_BODY_SIZE;
+    LE_TEST_OK(SendRequest(ref, HTTP_PUT, "/echo", SEND_BODY_SIZE), "Sent body with a length");
+    ContentLength = 0;
+    le_httpClient_SetBodySendCallback(ref, NULL);
+    le_httpClient_SetBodyConstructCallback(ref, NULL);
+    LE_TEST_OK(GetConnectionCount() == 1, "Requests sent on the same connection");
+
+    // Connection closed by the server
+    LE_TEST_OK(SendRequest(ref, HTTP_GET, "/close", 3), "Response closing the connection");
+    LE_TEST_OK(SendRequest(ref, HTTP_GET, "/length/100", 100), "Request after the server closed");
+    LE_TEST_OK(GetConnectionCount() == 2, "New connection opened");
+
+    // Idle connection reused by the next session
+    LE_TEST_OK(le_httpClient_Delete(ref) == LE_OK, "Delete the session without stopping it");
+    ref = StartSession();
+    LE_TEST_OK(SendRequest(ref, HTTP_GET, "/length/100", 100), "Request of a new session");
+    LE_TEST_OK(GetConnectionCount() == 2, "Connection of the previous session reused");
+
+    // Stopped session: its connection is closed
+    LE_TEST_OK((le_httpClient_Stop(ref) == LE_OK) && (le_httpClient_Delete(ref) == LE_OK),
+               "Stop and delete the session");
+    ref = StartSession();
+    LE_TEST_OK(SendRequest(ref, HTTP_GET, "/length/100", 100), "Request of a new session");
+    LE_TEST_OK(GetConnectionCount() == 3, "New connection opened");
+    le_httpClient_Stop(ref);
+    le_httpClient_Delete(ref);
+
+    LE_TEST_EXIT;
+}
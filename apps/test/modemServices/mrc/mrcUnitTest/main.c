@@ -1126,6 +1126,411 @@ static void Testle_mrc_PciScanAsync
     le_sem_Delete(ThreadSemaphore);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * MRC network scan data
+ * Check that the networks returned in a single call match the ones of the Scan Information list.
+ * APIs tested:
+ * - le_mrc_PerformCellularNetworkScanData()
+ * - le_mrc_GetCellularNetworkScanData()
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_mrc_ScanData
+(
+    void
+)
+{
+    le_mrc_ScanData_t               networks[LE_MRC_SCAN_DATA_MAX];
+    size_t                          networksSize = NUM_ARRAY_MEMBERS(networks);
+    le_mrc_ScanInformationListRef_t scanInfoListRef;
+    le_mrc_ScanInformationRef_t     scanInfoRef;
+    char                            mccStr[LE_MRC_MCC_BYTES];
+    char                            mncStr[LE_MRC_MNC_BYTES];
+    size_t                          i = 0;
+
+    // Test NULL cases
+    LE_ASSERT(LE_FAULT == le_mrc_PerformCellularNetworkScanData(LE_MRC_BITMASK_RAT_ALL,
+                                                                NULL,
+                                                                &networksSize));
+
+    scanInfoListRef = le_mrc_PerformCellularNetworkScan(LE_MRC_BITMASK_RAT_ALL);
+    if (NULL == scanInfoListRef)
+    {
+        LE_ASSERT(LE_FAULT == le_mrc_PerformCellularNetworkScanData(LE_MRC_BITMASK_RAT_ALL,
+                                                                    networks,
+                                                                    &networksSize));
+        LE_ASSERT(0 == networksSize);
+        return;
+    }
+
+    LE_ASSERT_OK(le_mrc_GetCellularNetworkScanData(scanInfoListRef, networks, &networksSize));
+
+    scanInfoRef = le_mrc_GetFirstCellularNetworkScan(scanInfoListRef);
+    while (NULL != scanInfoRef)
+    {
+        LE_ASSERT(i < networksSize);
+        LE_ASSERT_OK(le_mrc_GetCellularNetworkMccMnc(scanInfoRef, mccStr, sizeof(mccStr),
+                                                     mncStr, sizeof(mncStr)));
+        LE_ASSERT(0 == strcmp(mccStr, networks[i].mcc));
+        LE_ASSERT(0 == strcmp(mncStr, networks[i].mnc));
+        LE_ASSERT(le_mrc_GetCellularNetworkRat(scanInfoRef) == networks[i].rat);
+        LE_ASSERT(le_mrc_IsCellularNetworkInUse(scanInfoRef) == networks[i].isInUse);
+        LE_ASSERT(le_mrc_IsCellularNetworkAvailable(scanInfoRef) == networks[i].isAvailable);
+        LE_ASSERT(le_mrc_IsCellularNetworkHome(scanInfoRef) == networks[i].isHome);
+        LE_ASSERT(le_mrc_IsCellularNetworkForbidden(scanInfoRef) == networks[i].isForbidden);
+        LE_INFO("Network %s-%s '%s' rat %d", networks[i].mcc, networks[i].mnc,
+                networks[i].name, networks[i].rat);
+
+        i++;
+        scanInfoRef = le_mrc_GetNextCellularNetworkScan(scanInfoListRef);
+    }
+    LE_ASSERT(i == networksSize);
+
+    if (networksSize > 1)
+    {
+        size_t size = 1;
+
+        LE_ASSERT(LE_OVERFLOW == le_mrc_GetCellularNetworkScanData(scanInfoListRef,
+                                                                   networks,
+                                                                   &size));
+        LE_ASSERT(1 == size);
+    }
+
+    le_mrc_DeleteCellularNetworkScan(scanInfoListRef);
+
+    networksSize = NUM_ARRAY_MEMBERS(networks);
+    LE_ASSERT_OK(le_mrc_PerformCellularNetworkScanData(LE_MRC_BITMASK_RAT_ALL,
+                                                       networks,
+                                                       &networksSize));
+    LE_ASSERT(i == networksSize);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Neighboring Cells change handler
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestNeighborCellsChangeHandler
+(
+    const le_mrc_NeighborCellData_t* addedPtr,      ///< [IN] Cells newly detected
+    size_t                           addedSize,     ///< [IN] Number of cells newly detected
+    const le_mrc_NeighborCellData_t* changedPtr,    ///< [IN] Cells whose levels changed
+    size_t                           changedSize,   ///< [IN] Number of cells whose levels changed
+    const le_mrc_NeighborCellData_t* removedPtr,    ///< [IN] Cells no longer detected
+    size_t                           removedSize,   ///< [IN] Number of cells no longer detected
+    void*                            contextPtr     ///< [IN] Handler context
+)
+{
+    LE_INFO("Neighboring cells: %" PRIuS " added, %" PRIuS " changed, %" PRIuS " removed",
+            addedSize, changedSize, removedSize);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * MRC Neighboring Cells data
+ * Check that the cells returned in a single call match the ones of the Neighboring Cells
+ * information.
+ * APIs tested:
+ * - le_mrc_GetNeighborCellsData()
+ * - le_mrc_AddNeighborCellsChangeHandler()
+ * - le_mrc_RemoveNeighborCellsChangeHandler()
+ * - le_mrc_SetNeighborCellsChangeMonitoring()
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_mrc_NeighborCellsData
+(
+    void
+)
+{
+    le_mrc_NeighborCellData_t              cells[LE_MRC_NEIGHBOR_CELLS_MAX];
+    size_t                                 cellsSize = NUM_ARRAY_MEMBERS(cells);
+    le_mrc_NeighborCellsRef_t              ngbrRef;
+    le_mrc_CellInfoRef_t                   cellRef;
+    le_mrc_NeighborCellsChangeHandlerRef_t handlerRef;
+    le_result_t                            result;
+    size_t                                 i = 0;
+
+    // Test NULL cases
+    LE_ASSERT(LE_FAULT == le_mrc_GetNeighborCellsData(NULL, &cellsSize));
+    LE_ASSERT(!le_mrc_AddNeighborCellsChangeHandler(NULL, NULL));
+
+    ngbrRef = le_mrc_GetNeighborCellsInfo();
+    result = le_mrc_GetNeighborCellsData(cells, &cellsSize);
+    if (NULL == ngbrRef)
+    {
+        LE_ASSERT(0 == cellsSize);
+        LE_ASSERT((LE_OK == result) || (LE_FAULT == result));
+    }
+    else
+    {
+        LE_ASSERT((LE_OK == result) || (LE_OVERFLOW == result));
+
+        cellRef = le_mrc_GetFirstNeighborCellInfo(ngbrRef);
+        while ((NULL != cellRef) && (i < cellsSize))
+        {
+            LE_ASSERT(le_mrc_GetNeighborCellId(cellRef) == cells[i].id);
+            LE_ASSERT(le_mrc_GetNeighborCellLocAreaCode(cellRef) == cells[i].lac);
+            LE_ASSERT(le_mrc_GetNeighborCellRxLevel(cellRef) == cells[i].rxLevel);
+            LE_ASSERT(le_mrc_GetNeighborCellRat(cellRef) == cells[i].rat);
+
+            i++;
+            cellRef = le_mrc_GetNextNeighborCellInfo(ngbrRef);
+        }
+        LE_ASSERT(i == cellsSize);
+
+        le_mrc_DeleteNeighborCellsInfo(ngbrRef);
+    }
+
+    LE_ASSERT(LE_BAD_PARAMETER == le_mrc_SetNeighborCellsChangeMonitoring(0, 3));
+    LE_ASSERT_OK(le_mrc_SetNeighborCellsChangeMonitoring(1, 0));
+
+    handlerRef = le_mrc_AddNeighborCellsChangeHandler(TestNeighborCellsChangeHandler, NULL);
+    LE_ASSERT(handlerRef);
+    le_mrc_RemoveNeighborCellsChangeHandler(handlerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether two neighboring cells are the same cell, whatever their levels.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsSameCell
+(
+    const le_mrc_NeighborCellData_t* cell1Ptr,  ///< [IN] First cell
+    const le_mrc_NeighborCellData_t* cell2Ptr   ///< [IN] Second cell
+)
+{
+    return ((cell1Ptr->rat == cell2Ptr->rat) &&
+            (cell1Ptr->id == cell2Ptr->id) &&
+            (cell1Ptr->lac == cell2Ptr->lac) &&
+            (cell1Ptr->earfcn == cell2Ptr->earfcn) &&
+            (cell1Ptr->physCellId == cell2Ptr->physCellId) &&
+            (cell1Ptr->scramblingCode == cell2Ptr->scramblingCode) &&
+            (cell1Ptr->bsic == cell2Ptr->bsic));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find a cell in a list of neighboring cells.
+ *
+ * @return The index of the cell, or the number of cells if it is not in the list.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t FindCell
+(
+    const le_mrc_NeighborCellData_t* cellsPtr,  ///< [IN] Cells
+    size_t                           count,     ///< [IN] Number of cells
+    const le_mrc_NeighborCellData_t* cellPtr    ///< [IN] Cell to find
+)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (IsSameCell(&cellsPtr[i], cellPtr))
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply a Neighboring Cells change report to the list of cells kept by a client, as a change
+ * handler does.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ApplyNeighborCellsChange
+(
+    le_mrc_NeighborCellData_t*   clientCellsPtr,    ///< [IN/OUT] Cells known by the client
+    size_t*                      clientCountPtr,    ///< [IN/OUT] Number of cells known
+    const NeighborCellsChange_t* changePtr          ///< [IN] Change report
+)
+{
+    size_t i;
+    size_t j;
+
+    for (i = 0; i < changePtr->removedCount; i++)
+    {
+        j = FindCell(clientCellsPtr, *clientCountPtr, &changePtr->removed[i]);
+        LE_ASSERT(j < *clientCountPtr);
+        clientCellsPtr[j] = clientCellsPtr[--(*clientCountPtr)];
+    }
+
+    for (i = 0; i < changePtr->changedCount; i++)
+    {
+        j = FindCell(clientCellsPtr, *clientCountPtr, &changePtr->changed[i]);
+        LE_ASSERT(j < *clientCountPtr);
+        clientCellsPtr[j] = changePtr->changed[i];
+    }
+
+    for (i = 0; i < changePtr->addedCount; i++)
+    {
+        LE_ASSERT(FindCell(clientCellsPtr, *clientCountPtr, &changePtr->added[i]) ==
+                  *clientCountPtr);
+        LE_ASSERT(*clientCountPtr < LE_MRC_NEIGHBOR_CELLS_MAX);
+        clientCellsPtr[(*clientCountPtr)++] = changePtr->added[i];
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the change report for the current cells, apply it to the client cells and check that
+ * the client then knows the current cells, with the levels last reported.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckNeighborCellsChange
+(
+    le_mrc_NeighborCellData_t*       reportedPtr,       ///< [IN/OUT] Cells last reported
+    size_t*                          reportedCountPtr,  ///< [IN/OUT] Number of cells reported
+    le_mrc_NeighborCellData_t*       clientCellsPtr,    ///< [IN/OUT] Cells known by the client
+    size_t*                          clientCountPtr,    ///< [IN/OUT] Number of cells known
+    const le_mrc_NeighborCellData_t* cellsPtr,          ///< [IN] Current cells
+    size_t                           cellsCount,        ///< [IN] Number of current cells
+    int32_t                          delta,             ///< [IN] Signal strength delta
+    NeighborCellsChange_t*           changePtr          ///< [OUT] Change report
+)
+{
+    size_t i;
+    size_t j;
+
+    le_mrc_ComputeNeighborCellsChange(reportedPtr, reportedCountPtr, cellsPtr, cellsCount, delta,
+                                      changePtr);
+    ApplyNeighborCellsChange(clientCellsPtr, clientCountPtr, changePtr);
+
+    LE_ASSERT(cellsCount == *reportedCountPtr);
+    LE_ASSERT(cellsCount == *clientCountPtr);
+    for (i = 0; i < cellsCount; i++)
+    {
+        LE_ASSERT(IsSameCell(&reportedPtr[i], &cellsPtr[i]));
+        j = FindCell(clientCellsPtr, *clientCountPtr, &cellsPtr[i]);
+        LE_ASSERT(j < *clientCountPtr);
+        LE_ASSERT(0 == memcmp(&clientCellsPtr[j], &reportedPtr[i], sizeof(reportedPtr[i])));
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * MRC Neighboring Cells change computation
+ * Check the cells reported as added, changed or removed from one sample to the next: first sample,
+ * levels drifting up to the delta, levels at the limits of their range, cells all removed and
+ * cells reported again once the last reported cells are reset.
+ * APIs tested:
+ * - le_mrc_ComputeNeighborCellsChange()
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_mrc_NeighborCellsChange
+(
+    void
+)
+{
+    static NeighborCellsChange_t change;
+    le_mrc_NeighborCellData_t    reported[LE_MRC_NEIGHBOR_CELLS_MAX];
+    le_mrc_NeighborCellData_t    clientCells[LE_MRC_NEIGHBOR_CELLS_MAX];
+    le_mrc_NeighborCellData_t    cells[3];
+    size_t                       reportedCount = 0;
+    size_t                       clientCount = 0;
+    size_t                       i;
+
+    memset(cells, 0, sizeof(cells));
+    for (i = 0; i < NUM_ARRAY_MEMBERS(cells); i++)
+    {
+        cells[i].rat = LE_MRC_RAT_LTE;
+        cells[i].id = 100 + i;
+        cells[i].lac = 0xABCD;
+        cells[i].earfcn = 6300;
+        cells[i].physCellId = 10 + i;
+        cells[i].rxLevel = -80;
+        cells[i].lteIntraRsrq = -100;
+        cells[i].lteIntraRsrp = -900;
+    }
+
+    // First sample: all the cells are added.
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 3, &change);
+    LE_ASSERT((3 == change.addedCount) && (0 == change.changedCount) &&
+              (0 == change.removedCount));
+
+    // Same sample: nothing to report.
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 3, &change);
+    LE_ASSERT((0 == change.addedCount) && (0 == change.changedCount) &&
+              (0 == change.removedCount));
+
+    // Slow drift: reported once it reaches the delta from the level last reported.
+    cells[0].rxLevel = -82;
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 3, &change);
+    LE_ASSERT(0 == change.changedCount);
+    LE_ASSERT(-80 == reported[0].rxLevel);
+    cells[0].rxLevel = -83;
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 3, &change);
+    LE_ASSERT((1 == change.changedCount) && (-83 == change.changed[0].rxLevel));
+
+    // Levels with 1 decimal place use 10 times the delta.
+    cells[1].lteIntraRsrq = -129;
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 3, &change);
+    LE_ASSERT(0 == change.changedCount);
+    cells[1].lteIntraRsrq = -130;
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 3, &change);
+    LE_ASSERT((1 == change.changedCount) && (-130 == change.changed[0].lteIntraRsrq));
+
+    // Levels at the limits of their range: the difference must not wrap around.
+    cells[2].rxLevel = INT32_MAX;
+    cells[2].lteInterRsrp = INT32_MIN;
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 3, &change);
+    LE_ASSERT(1 == change.changedCount);
+    cells[2].rxLevel = INT32_MIN;
+    cells[2].lteInterRsrp = INT32_MAX;
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 3, &change);
+    LE_ASSERT((1 == change.changedCount) && (INT32_MIN == change.changed[0].rxLevel));
+    cells[2].lteInterRsrp = INT32_MAX - (10 * UINT16_MAX - 1);
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, UINT16_MAX, &change);
+    LE_ASSERT(0 == change.changedCount);
+    cells[2].lteInterRsrp = INT32_MAX - 10 * UINT16_MAX;
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, UINT16_MAX, &change);
+    LE_ASSERT(1 == change.changedCount);
+
+    // Any change is reported with a delta of 0.
+    cells[0].rxLevel++;
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 0, &change);
+    LE_ASSERT((1 == change.changedCount) && IsSameCell(&change.changed[0], &cells[0]));
+
+    // A cell on another channel is another cell.
+    cells[1].earfcn++;
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 3, &change);
+    LE_ASSERT((1 == change.addedCount) && (0 == change.changedCount) &&
+              (1 == change.removedCount));
+
+    // All the cells lost, then detected again.
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 0, 3, &change);
+    LE_ASSERT((0 == change.addedCount) && (3 == change.removedCount));
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 3, 3, &change);
+    LE_ASSERT((3 == change.addedCount) && (0 == change.removedCount));
+
+    // Last reported cells reset, as when the last handler is removed: a new client gets all the
+    // cells as added.
+    reportedCount = 0;
+    clientCount = 0;
+    CheckNeighborCellsChange(reported, &reportedCount, clientCells, &clientCount,
+                             cells, 2, 3, &change);
+    LE_ASSERT((2 == change.addedCount) && (0 == change.changedCount) &&
+              (0 == change.removedCount));
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Thread used to run SIM unit tests
@@ -1171,6 +1576,12 @@ static void* TestThread
     Testle_mrc_PciScan();
     LE_INFO("======== MRC PCI scan async Test ========");
     Testle_mrc_PciScanAsync();
+    LE_INFO("======== MRC Network scan data Test ========");
+    Testle_mrc_ScanData();
+    LE_INFO("======== MRC Neighboring cells data Test ========");
+    Testle_mrc_NeighborCellsData();
+    LE_INFO("======== MRC Neighboring cells change Test ========");
+    Testle_mrc_NeighborCellsChange();
 
     LE_INFO("======== UnitTest of MRC API ends with SUCCESS ========");
 
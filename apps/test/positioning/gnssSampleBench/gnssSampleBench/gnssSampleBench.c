@@ -0,0 +1,507 @@
+/**
+ * This module implements a benchmark of the cost of getting the position data on each fix.
+ *
+ * Several subscribers, each one in its own thread with its own session to the positioning service,
+ * receive the position fixes at 10 Hz. The position data are retrieved on each fix:
+ *  - with the individual position sample getters,
+ *  - with a single le_gnss_GetSampleData() request,
+ *  - directly from the notification of a position data handler.
+ *
+ * For each method, the benchmark reports per fix the number of requests sent by each subscriber,
+ * the time spent by a subscriber to get the data, and the CPU time used by this process and by the
+ * positioning service.
+ *
+ * Usage:
+ * @verbatim
+   app runProc gnssSampleBench --exe=gnssSampleBench -- [<number of fixes>]
+   @endverbatim
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of subscribers.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SUBSCRIBER_NUM          10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Acquisition rate in milliseconds (10 Hz).
+ */
+//--------------------------------------------------------------------------------------------------
+#define ACQUISITION_RATE_MS     100
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of fixes measured for each method.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_FIX_NUM         100
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Name of the positioning service process.
+ */
+//--------------------------------------------------------------------------------------------------
+#define POS_DAEMON_NAME         "posDaemon"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Methods used to get the position data.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    METHOD_GETTERS,         ///< Position handler and individual position sample getters.
+    METHOD_SAMPLE_DATA,     ///< Position handler and le_gnss_GetSampleData().
+    METHOD_PUSH,            ///< Position data handler.
+    METHOD_NUM
+}
+Method_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Methods names.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* MethodNames[METHOD_NUM] =
+{
+    "getters",
+    "sample data",
+    "push"
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subscriber context.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_thread_Ref_t                  threadRef;         ///< Subscriber thread.
+    le_gnss_PositionHandlerRef_t     positionRef;       ///< Position handler.
+    le_gnss_PositionDataHandlerRef_t positionDataRef;   ///< Position data handler.
+    uint32_t                         fixCount;          ///< Number of fixes received.
+    uint32_t                         requestCount;      ///< Number of requests sent.
+    uint64_t                         elapsedUs;         ///< Time spent getting the data.
+}
+Subscriber_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subscribers.
+ */
+//--------------------------------------------------------------------------------------------------
+static Subscriber_t Subscribers[SUBSCRIBER_NUM];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Semaphore used to synchronize the subscribers with the main thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_sem_Ref_t SyncSem;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Method in use and number of fixes to measure.
+ */
+//--------------------------------------------------------------------------------------------------
+static Method_t CurrentMethod;
+static uint32_t FixNum = DEFAULT_FIX_NUM;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the elapsed time in microseconds since a given time.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetElapsedUs
+(
+    le_clk_Time_t startTime
+)
+{
+    le_clk_Time_t diff = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return ((uint64_t)diff.sec * 1000000) + diff.usec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the CPU time used by this process, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetOwnCpuUs
+(
+    void
+)
+{
+    struct timespec ts;
+
+    LE_ASSERT(0 == clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts));
+    return ((uint64_t)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the CPU time used by the positioning service, in microseconds.
+ *
+ * @return The CPU time, or 0 if the positioning service process is not found.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetPosDaemonCpuUs
+(
+    void
+)
+{
+    DIR* dirPtr = opendir("/proc");
+    struct dirent* entryPtr;
+    uint64_t cpuUs = 0;
+
+    if (NULL == dirPtr)
+    {
+        return 0;
+    }
+
+    while ((NULL != (entryPtr = readdir(dirPtr))) && (0 == cpuUs))
+    {
+        char path[PATH_MAX];
+        char stat[512];
+        char* commEndPtr;
+        unsigned long utime;
+        unsigned long stime;
+        FILE* filePtr;
+
+        if (!isdigit((unsigned char)entryPtr->d_name[0]))
+        {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "/proc/%s/stat", entryPtr->d_name);
+        filePtr = fopen(path, "r");
+        if (NULL == filePtr)
+        {
+            continue;
+        }
+        if (NULL == fgets(stat, sizeof(stat), filePtr))
+        {
+            fclose(filePtr);
+            continue;
+        }
+        fclose(filePtr);
+
+        // Format is "pid (comm) state ppid ...", utime and stime being the 14th and 15th fields.
+        commEndPtr = strrchr(stat, ')');
+        if ((NULL == commEndPtr) || (NULL == strstr(stat, "(" POS_DAEMON_NAME ")")))
+        {
+            continue;
+        }
+        if (2 == sscanf(commEndPtr + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu",
+                        &utime, &stime))
+        {
+            cpuUs = ((uint64_t)(utime + stime) * 1000000) / sysconf(_SC_CLK_TCK);
+        }
+    }
+
+    closedir(dirPtr);
+    return cpuUs;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position handler getting the data with the individual position sample getters.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GettersPositionHandler
+(
+    le_gnss_SampleRef_t positionSampleRef,
+    void* contextPtr
+)
+{
+    Subscriber_t* subscriberPtr = contextPtr;
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    le_gnss_FixState_t state;
+    int32_t latitude, longitude, hAccuracy, altitude, vAccuracy, altitudeOnWgs84;
+    uint16_t year, month, day, hours, minutes, seconds, milliseconds, dop;
+    uint64_t epochTime;
+    uint32_t gpsWeek, gpsTimeOfWeek, timeAccuracy, hSpeed, hSpeedAccuracy;
+    uint32_t direction, directionAccuracy;
+    int32_t vSpeed, vSpeedAccuracy, magneticDeviation;
+    uint8_t satsInView, satsTracking, satsUsed;
+
+    le_gnss_GetPositionState(positionSampleRef, &state);
+    le_gnss_GetLocation(positionSampleRef, &latitude, &longitude, &hAccuracy);
+    le_gnss_GetAltitude(positionSampleRef, &altitude, &vAccuracy);
+    le_gnss_GetAltitudeOnWgs84(positionSampleRef, &altitudeOnWgs84);
+    le_gnss_GetDate(positionSampleRef, &year, &month, &day);
+    le_gnss_GetTime(positionSampleRef, &hours, &minutes, &seconds, &milliseconds);
+    le_gnss_GetEpochTime(positionSampleRef, &epochTime);
+    le_gnss_GetGpsTime(positionSampleRef, &gpsWeek, &gpsTimeOfWeek);
+    le_gnss_GetTimeAccuracy(positionSampleRef, &timeAccuracy);
+    le_gnss_GetHorizontalSpeed(positionSampleRef, &hSpeed, &hSpeedAccuracy);
+    le_gnss_GetVerticalSpeed(positionSampleRef, &vSpeed, &vSpeedAccuracy);
+    le_gnss_GetDirection(positionSampleRef, &direction, &directionAccuracy);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_PDOP, &dop);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_HDOP, &dop);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_VDOP, &dop);
+    le_gnss_GetMagneticDeviation(positionSampleRef, &magneticDeviation);
+    le_gnss_GetSatellitesStatus(positionSampleRef, &satsInView, &satsTracking, &satsUsed);
+    le_gnss_ReleaseSampleRef(positionSampleRef);
+
+    subscriberPtr->elapsedUs += GetElapsedUs(startTime);
+    subscriberPtr->requestCount += 18;
+    subscriberPtr->fixCount++;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position handler getting the data with a single request.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SampleDataPositionHandler
+(
+    le_gnss_SampleRef_t positionSampleRef,
+    void* contextPtr
+)
+{
+    Subscriber_t* subscriberPtr = contextPtr;
+    le_clk_Time_t startTime = le_clk_GetRelativeTime();
+    le_gnss_SampleData_t data;
+
+    LE_ASSERT_OK(le_gnss_GetSampleData(positionSampleRef, &data));
+    le_gnss_ReleaseSampleRef(positionSampleRef);
+
+    subscriberPtr->elapsedUs += GetElapsedUs(startTime);
+    subscriberPtr->requestCount += 2;
+    subscriberPtr->fixCount++;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position data handler, the data come with the notification.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PushPositionDataHandler
+(
+    const le_gnss_SampleData_t* dataPtr,
+    void* contextPtr
+)
+{
+    Subscriber_t* subscriberPtr = contextPtr;
+
+    LE_ASSERT(NULL != dataPtr);
+    subscriberPtr->fixCount++;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Register the handler of the current method in a subscriber thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddHandler
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    Subscriber_t* subscriberPtr = param1Ptr;
+
+    subscriberPtr->fixCount = 0;
+    subscriberPtr->requestCount = 0;
+    subscriberPtr->elapsedUs = 0;
+
+    switch (CurrentMethod)
+    {
+        case METHOD_GETTERS:
+            subscriberPtr->positionRef = le_gnss_AddPositionHandler(GettersPositionHandler,
+                                                                    subscriberPtr);
+            break;
+        case METHOD_SAMPLE_DATA:
+            subscriberPtr->positionRef = le_gnss_AddPositionHandler(SampleDataPositionHandler,
+                                                                    subscriberPtr);
+            break;
+        default:
+            subscriberPtr->positionDataRef =
+                            le_gnss_AddPositionDataHandler(PushPositionDataHandler, subscriberPtr);
+            break;
+    }
+    le_sem_Post(SyncSem);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove the handler of a subscriber thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveHandler
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    Subscriber_t* subscriberPtr = param1Ptr;
+
+    if (subscriberPtr->positionRef)
+    {
+        le_gnss_RemovePositionHandler(subscriberPtr->positionRef);
+        subscriberPtr->positionRef = NULL;
+    }
+    if (subscriberPtr->positionDataRef)
+    {
+        le_gnss_RemovePositionDataHandler(subscriberPtr->positionDataRef);
+        subscriberPtr->positionDataRef = NULL;
+    }
+    le_sem_Post(SyncSem);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subscriber thread, with its own session to the positioning service.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* SubscriberThread
+(
+    void* contextPtr
+)
+{
+    le_gnss_ConnectService();
+    le_sem_Post(SyncSem);
+    le_event_RunLoop();
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the subscribers' handlers on each of their threads and wait for them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RunOnSubscribers
+(
+    le_event_DeferredFunc_t func
+)
+{
+    int i;
+
+    for (i = 0; i < SUBSCRIBER_NUM; i++)
+    {
+        le_event_QueueFunctionToThread(Subscribers[i].threadRef, func, &Subscribers[i], NULL);
+    }
+    for (i = 0; i < SUBSCRIBER_NUM; i++)
+    {
+        le_sem_Wait(SyncSem);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Measure the cost of a method.
+ */
+//--------------------------------------------------------------------------------------------------
+static void MeasureMethod
+(
+    Method_t method
+)
+{
+    uint64_t ownCpuUs;
+    uint64_t posDaemonCpuUs;
+    uint64_t elapsedUs = 0;
+    uint32_t requestCount = 0;
+    uint32_t fixCount;
+    int i;
+
+    CurrentMethod = method;
+    RunOnSubscribers(AddHandler);
+
+    ownCpuUs = GetOwnCpuUs();
+    posDaemonCpuUs = GetPosDaemonCpuUs();
+
+    // Wait for the expected number of fixes on the first subscriber.
+    while (Subscribers[0].fixCount < FixNum)
+    {
+        le_thread_Sleep(1);
+    }
+
+    ownCpuUs = GetOwnCpuUs() - ownCpuUs;
+    posDaemonCpuUs = GetPosDaemonCpuUs() - posDaemonCpuUs;
+    fixCount = Subscribers[0].fixCount;
+
+    RunOnSubscribers(RemoveHandler);
+
+    for (i = 0; i < SUBSCRIBER_NUM; i++)
+    {
+        elapsedUs += Subscribers[i].elapsedUs;
+        requestCount += Subscribers[i].requestCount;
+    }
+
+    LE_TEST_INFO("%-12s: %u subscribers, %"PRIu32" fixes", MethodNames[method], SUBSCRIBER_NUM,
+                 fixCount);
+    LE_TEST_INFO("%-12s: %"PRIu32" requests/fix/subscriber, %"PRIu64" us/fix/subscriber",
+                 MethodNames[method], requestCount / (SUBSCRIBER_NUM * fixCount),
+                 elapsedUs / (SUBSCRIBER_NUM * fixCount));
+    LE_TEST_INFO("%-12s: CPU per fix: client %"PRIu64" us, positioning service %"PRIu64" us",
+                 MethodNames[method], ownCpuUs / fixCount, posDaemonCpuUs / fixCount);
+    LE_TEST_OK(fixCount >= FixNum, "%s: fixes received by all subscribers", MethodNames[method]);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main thread of the benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* BenchThread
+(
+    void* contextPtr
+)
+{
+    char name[32];
+    Method_t method;
+    le_result_t result;
+    int i;
+
+    le_gnss_ConnectService();
+
+    SyncSem = le_sem_Create("SyncSem", 0);
+    for (i = 0; i < SUBSCRIBER_NUM; i++)
+    {
+        snprintf(name, sizeof(name), "Subscriber%d", i);
+        Subscribers[i].threadRef = le_thread_Create(name, SubscriberThread, NULL);
+        le_thread_Start(Subscribers[i].threadRef);
+        le_sem_Wait(SyncSem);
+    }
+
+    result = le_gnss_SetAcquisitionRate(ACQUISITION_RATE_MS);
+    LE_TEST_OK((LE_OK == result) || (LE_NOT_PERMITTED == result), "Set acquisition rate");
+    result = le_gnss_Start();
+    LE_TEST_OK((LE_OK == result) || (LE_DUPLICATE == result), "Start GNSS");
+
+    for (method = METHOD_GETTERS; method < METHOD_NUM; method++)
+    {
+        MeasureMethod(method);
+    }
+
+    le_gnss_Stop();
+
+    LE_TEST_EXIT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Component initialization.
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+
+    if (le_arg_NumArgs() > 0)
+    {
+        FixNum = (uint32_t)atoi(le_arg_GetArg(0));
+        LE_TEST_ASSERT(FixNum > 0, "Number of fixes");
+    }
+
+    // Blocking calls are used to synchronize the subscribers, run the benchmark in its own thread.
+    le_thread_Start(le_thread_Create("BenchThread", BenchThread, NULL));
+}
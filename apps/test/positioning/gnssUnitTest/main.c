@@ -91,6 +91,23 @@ static le_gnss_SampleRef_t GnssPositionSampleRef;
 //--------------------------------------------------------------------------------------------------
 static le_gnss_PositionHandlerRef_t GnssPositionHandlerRef = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position handler keeping its position sample, and position sample kept.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_PositionHandlerRef_t HoldingPositionHandlerRef = NULL;
+static le_gnss_SampleRef_t          HeldPositionSampleRef = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position data handler's reference.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_PositionDataHandlerRef_t GnssPositionDataHandlerRef = NULL;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Thread and semaphore reference.
@@ -438,6 +455,146 @@ static void Testle_gnss_SetDataResolution
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that two position sample snapshots are identical.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckSampleData
+(
+    const le_gnss_SampleData_t* data1Ptr,
+    const le_gnss_SampleData_t* data2Ptr
+)
+{
+    LE_ASSERT(data1Ptr->fixState == data2Ptr->fixState);
+    LE_ASSERT(data1Ptr->latitude == data2Ptr->latitude);
+    LE_ASSERT(data1Ptr->longitude == data2Ptr->longitude);
+    LE_ASSERT(data1Ptr->hAccuracy == data2Ptr->hAccuracy);
+    LE_ASSERT(data1Ptr->horUncEllipseSemiMajor == data2Ptr->horUncEllipseSemiMajor);
+    LE_ASSERT(data1Ptr->horUncEllipseSemiMinor == data2Ptr->horUncEllipseSemiMinor);
+    LE_ASSERT(data1Ptr->horConfidence == data2Ptr->horConfidence);
+    LE_ASSERT(data1Ptr->altitude == data2Ptr->altitude);
+    LE_ASSERT(data1Ptr->altitudeOnWgs84 == data2Ptr->altitudeOnWgs84);
+    LE_ASSERT(data1Ptr->vAccuracy == data2Ptr->vAccuracy);
+    LE_ASSERT(data1Ptr->hSpeed == data2Ptr->hSpeed);
+    LE_ASSERT(data1Ptr->hSpeedAccuracy == data2Ptr->hSpeedAccuracy);
+    LE_ASSERT(data1Ptr->vSpeed == data2Ptr->vSpeed);
+    LE_ASSERT(data1Ptr->vSpeedAccuracy == data2Ptr->vSpeedAccuracy);
+    LE_ASSERT(data1Ptr->direction == data2Ptr->direction);
+    LE_ASSERT(data1Ptr->directionAccuracy == data2Ptr->directionAccuracy);
+    LE_ASSERT(data1Ptr->dateValid == data2Ptr->dateValid);
+    LE_ASSERT(data1Ptr->year == data2Ptr->year);
+    LE_ASSERT(data1Ptr->month == data2Ptr->month);
+    LE_ASSERT(data1Ptr->day == data2Ptr->day);
+    LE_ASSERT(data1Ptr->timeValid == data2Ptr->timeValid);
+    LE_ASSERT(data1Ptr->hours == data2Ptr->hours);
+    LE_ASSERT(data1Ptr->minutes == data2Ptr->minutes);
+    LE_ASSERT(data1Ptr->seconds == data2Ptr->seconds);
+    LE_ASSERT(data1Ptr->milliseconds == data2Ptr->milliseconds);
+    LE_ASSERT(data1Ptr->epochTime == data2Ptr->epochTime);
+    LE_ASSERT(data1Ptr->gpsTimeValid == data2Ptr->gpsTimeValid);
+    LE_ASSERT(data1Ptr->gpsWeek == data2Ptr->gpsWeek);
+    LE_ASSERT(data1Ptr->gpsTimeOfWeek == data2Ptr->gpsTimeOfWeek);
+    LE_ASSERT(data1Ptr->timeAccuracy == data2Ptr->timeAccuracy);
+    LE_ASSERT(data1Ptr->leapSeconds == data2Ptr->leapSeconds);
+    LE_ASSERT(data1Ptr->pdop == data2Ptr->pdop);
+    LE_ASSERT(data1Ptr->hdop == data2Ptr->hdop);
+    LE_ASSERT(data1Ptr->vdop == data2Ptr->vdop);
+    LE_ASSERT(data1Ptr->gdop == data2Ptr->gdop);
+    LE_ASSERT(data1Ptr->tdop == data2Ptr->tdop);
+    LE_ASSERT(data1Ptr->magneticDeviation == data2Ptr->magneticDeviation);
+    LE_ASSERT(data1Ptr->satsInViewCount == data2Ptr->satsInViewCount);
+    LE_ASSERT(data1Ptr->satsTrackingCount == data2Ptr->satsTrackingCount);
+    LE_ASSERT(data1Ptr->satsUsedCount == data2Ptr->satsUsedCount);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: API testing for le_gnss_GetSampleData(), checked against the individual position sample
+ * getters.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_gnss_GetSampleData
+(
+    le_gnss_SampleRef_t positionSampleRef
+)
+{
+    le_gnss_SampleData_t data;
+    le_gnss_FixState_t state;
+    int32_t latitude;
+    int32_t longitude;
+    int32_t hAccuracy;
+    int32_t altitude;
+    int32_t vAccuracy;
+    uint16_t year;
+    uint16_t month;
+    uint16_t day;
+    uint16_t hours;
+    uint16_t minutes;
+    uint16_t seconds;
+    uint16_t milliseconds;
+    uint32_t hSpeed;
+    uint32_t hSpeedAccuracy;
+    int32_t vSpeed;
+    int32_t vSpeedAccuracy;
+    uint16_t dop;
+    uint8_t satsInViewCount;
+    uint8_t satsTrackingCount;
+    uint8_t satsUsedCount;
+
+    // Set gnss client number.
+    le_gnss_SetClientSimu(CLIENT1);
+
+    // Pass invalid sample reference
+    LE_ASSERT(LE_FAULT == le_gnss_GetSampleData(GnssPositionSampleRef, &data));
+    LE_ASSERT(LE_FAULT == le_gnss_GetSampleData(positionSampleRef, NULL));
+    LE_ASSERT(LE_FAULT == le_gnss_GetLastSampleData(NULL));
+
+    LE_ASSERT_OK(le_gnss_GetSampleData(positionSampleRef, &data));
+
+    LE_ASSERT_OK(le_gnss_GetPositionState(positionSampleRef, &state));
+    LE_ASSERT(data.fixState == state);
+
+    le_gnss_GetLocation(positionSampleRef, &latitude, &longitude, &hAccuracy);
+    LE_ASSERT(data.latitude == latitude);
+    LE_ASSERT(data.longitude == longitude);
+    LE_ASSERT(data.hAccuracy == hAccuracy);
+
+    le_gnss_GetAltitude(positionSampleRef, &altitude, &vAccuracy);
+    LE_ASSERT(data.altitude == altitude);
+    LE_ASSERT(data.vAccuracy == vAccuracy);
+
+    LE_ASSERT(data.dateValid == (LE_OK == le_gnss_GetDate(positionSampleRef,
+                                                           &year, &month, &day)));
+    LE_ASSERT((data.year == year) && (data.month == month) && (data.day == day));
+
+    LE_ASSERT(data.timeValid == (LE_OK == le_gnss_GetTime(positionSampleRef, &hours, &minutes,
+                                                           &seconds, &milliseconds)));
+    LE_ASSERT((data.hours == hours) && (data.minutes == minutes));
+    LE_ASSERT((data.seconds == seconds) && (data.milliseconds == milliseconds));
+
+    le_gnss_GetHorizontalSpeed(positionSampleRef, &hSpeed, &hSpeedAccuracy);
+    LE_ASSERT(data.hSpeed == hSpeed);
+    LE_ASSERT(data.hSpeedAccuracy == hSpeedAccuracy);
+
+    le_gnss_GetVerticalSpeed(positionSampleRef, &vSpeed, &vSpeedAccuracy);
+    LE_ASSERT(data.vSpeed == vSpeed);
+    LE_ASSERT(data.vSpeedAccuracy == vSpeedAccuracy);
+
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_PDOP, &dop);
+    LE_ASSERT(data.pdop == dop);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_HDOP, &dop);
+    LE_ASSERT(data.hdop == dop);
+    le_gnss_GetDilutionOfPrecision(positionSampleRef, LE_GNSS_VDOP, &dop);
+    LE_ASSERT(data.vdop == dop);
+
+    le_gnss_GetSatellitesStatus(positionSampleRef, &satsInViewCount, &satsTrackingCount,
+                                &satsUsedCount);
+    LE_ASSERT(data.satsInViewCount == satsInViewCount);
+    LE_ASSERT(data.satsTrackingCount == satsTrackingCount);
+    LE_ASSERT(data.satsUsedCount == satsUsedCount);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Handler function for Position Notifications.
@@ -659,6 +816,9 @@ static void GnssPositionHandlerFunction
                                         &satElevNumElements);
     LE_ASSERT((LE_OK == result) || (LE_OUT_OF_RANGE == result));
 
+    LE_INFO("======== GNSS GetSampleData ========");
+    Testle_gnss_GetSampleData(positionSampleRef);
+
     LE_INFO("======== GNSS SetGetDOPResolution ========");
     Testle_gnss_SetGetDOPResolution(positionSampleRef);
 
@@ -751,6 +911,138 @@ static void Testset_gnss_PositionData
     SynchTest();
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler function for Position Notifications, keeping the position sample.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void HoldingPositionHandlerFunction
+(
+    le_gnss_SampleRef_t positionSampleRef,
+    void* contextPtr
+)
+{
+    LE_ASSERT(positionSampleRef != NULL);
+    HeldPositionSampleRef = positionSampleRef;
+    le_sem_Post(ThreadSemaphore);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler function for Position Data Notifications.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void GnssPositionDataHandlerFunction
+(
+    const le_gnss_SampleData_t* dataPtr,
+    void* contextPtr
+)
+{
+    le_gnss_SampleData_t lastData;
+
+    LE_ASSERT(dataPtr != NULL);
+
+    // The data sent with the notification are the ones of the last position sample, in the
+    // resolutions of the client which registered the handler
+    le_gnss_SetClientSimu(CLIENT1);
+    LE_ASSERT_OK(le_gnss_GetLastSampleData(&lastData));
+    CheckSampleData(dataPtr, &lastData);
+
+    le_sem_Post(ThreadSemaphore);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: this function adds the position data handler and a second position handler
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddPositionDataHandlers
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    LOCK
+    le_gnss_SetClientSimu(CLIENT1);
+    HoldingPositionHandlerRef = le_gnss_AddPositionHandler(HoldingPositionHandlerFunction, NULL);
+    LE_ASSERT(NULL != HoldingPositionHandlerRef);
+    GnssPositionDataHandlerRef = le_gnss_AddPositionDataHandler(GnssPositionDataHandlerFunction,
+                                                                NULL);
+    LE_ASSERT(NULL != GnssPositionDataHandlerRef);
+    UNLOCK
+    // Semaphore is used to synchronize the task execution with the core test
+    le_sem_Post(ThreadSemaphore);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: this function removes the position data handler and the second position handler
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemovePositionDataHandlers
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    LOCK
+    le_gnss_RemovePositionHandler(HoldingPositionHandlerRef);
+    HoldingPositionHandlerRef = NULL;
+    le_gnss_RemovePositionDataHandler(GnssPositionDataHandlerRef);
+    GnssPositionDataHandlerRef = NULL;
+    UNLOCK
+    // Semaphore is used to synchronize the task execution with the core test
+    le_sem_Post(ThreadSemaphore);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Test: Position data handler and position sample shared by several position handlers
+ *
+ * API tested:
+ * - le_gnss_AddPositionDataHandler
+ * - le_gnss_RemovePositionDataHandler
+ * - le_gnss_GetLastSampleData
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void Testle_gnss_PositionDataHandler
+(
+    void
+)
+{
+    le_gnss_SampleData_t heldData;
+    le_gnss_SampleData_t lastData;
+
+    le_event_QueueFunctionToThread(AppThreadRef, AddPositionDataHandlers, NULL, NULL);
+    SynchTest();
+
+    pa_gnssSimu_ReportEvent();
+    // Wait for the position handler, the holding position handler and the position data handler
+    SynchTest();
+    SynchTest();
+    SynchTest();
+
+    // The sample kept by the holding handler is still valid after the other position handler
+    // released its own reference on it
+    LE_ASSERT(NULL != HeldPositionSampleRef);
+    le_gnss_SetClientSimu(CLIENT1);
+    LE_ASSERT_OK(le_gnss_GetSampleData(HeldPositionSampleRef, &heldData));
+    LE_ASSERT_OK(le_gnss_GetLastSampleData(&lastData));
+    CheckSampleData(&heldData, &lastData);
+
+    le_gnss_ReleaseSampleRef(HeldPositionSampleRef);
+    LE_ASSERT(LE_FAULT == le_gnss_GetSampleData(HeldPositionSampleRef, &heldData));
+    HeldPositionSampleRef = NULL;
+
+    le_event_QueueFunctionToThread(AppThreadRef, RemovePositionDataHandlers, NULL, NULL);
+    SynchTest();
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Test: this function handles the remove position handler
@@ -1262,6 +1554,9 @@ COMPONENT_INIT
     LE_INFO("======== GNSS Position Fill the position data ========");
     Testset_gnss_PositionData();
 
+    LE_INFO("======== GNSS Position Data Handler Test ========");
+    Testle_gnss_PositionDataHandler();
+
     LE_INFO("======== GNSS Device State Test ========");
     Testle_gnss_GetState();
 
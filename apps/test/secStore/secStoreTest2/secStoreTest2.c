@@ -403,9 +403,92 @@ static void Test10
                  TV_TO_MS(tv2) - TV_TO_MS(tv1));
 }
 
+// Write entries in a batch write, read and delete some of them inside the batch, go over the
+// limit inside the batch, then end the batch and verify what was stored.
+static void Test11
+(
+    void
+)
+{
+    static uint8_t bigBuffer[8000];
+    uint8_t inBuffer[100] = {0};
+    uint8_t outBuffer[100] = {0};
+    size_t outBufferSize;
+    le_result_t result;
+    int numWrites = 50;
+    int i;
+    char entry[32] = {0};
+    struct timeval tv0, tv1, tv2;
+
+    LE_TEST_INFO("Test11");
+
+    for (i = 0; i < sizeof(inBuffer); i++)
+    {
+        inBuffer[i] = (i * 7) % 256;
+    }
+
+    result = le_secStore_StartBatchWrite();
+    LE_TEST_OK(result == LE_OK, "Start the batch write: [%s]", LE_RESULT_TXT(result));
+
+    gettimeofday(&tv0, NULL);
+    for (i = 0; i < numWrites; i++)
+    {
+        sprintf(entry, "batch%d", i);
+        result = le_secStore_Write(entry, inBuffer, sizeof(inBuffer));
+        if (result != LE_OK)
+        {
+            LE_TEST_FATAL("Error writing data in the batch: %s", LE_RESULT_TXT(result));
+        }
+    }
+    gettimeofday(&tv1, NULL);
+
+    outBufferSize = sizeof(outBuffer);
+    result = le_secStore_Read("batch0", outBuffer, &outBufferSize);
+    LE_TEST_OK((result == LE_OK) && (outBufferSize == sizeof(inBuffer)) &&
+               (memcmp(outBuffer, inBuffer, sizeof(inBuffer)) == 0),
+               "Read an entry written in the batch: [%s]", LE_RESULT_TXT(result));
+
+    result = le_secStore_Delete("batch1");
+    LE_TEST_OK(result == LE_OK, "Delete an entry in the batch: [%s]", LE_RESULT_TXT(result));
+
+    outBufferSize = sizeof(outBuffer);
+    result = le_secStore_Read("batch1", outBuffer, &outBufferSize);
+    LE_TEST_OK(result == LE_NOT_FOUND, "Read an entry deleted in the batch: [%s]",
+               LE_RESULT_TXT(result));
+
+    result = le_secStore_Write("big", bigBuffer, sizeof(bigBuffer));
+    LE_TEST_OK(result == LE_NO_MEMORY, "Write over the limit in the batch: [%s]",
+               LE_RESULT_TXT(result));
+
+    result = le_secStore_EndBatchWrite();
+    gettimeofday(&tv2, NULL);
+    LE_TEST_OK(result == LE_OK, "End the batch write: [%s]", LE_RESULT_TXT(result));
+
+    LE_TEST_INFO("Time to write %d entries (%zu bytes) in a batch: %lu ms, commit: %lu ms",
+                 numWrites, sizeof(inBuffer),
+                 TV_TO_MS(tv1) - TV_TO_MS(tv0), TV_TO_MS(tv2) - TV_TO_MS(tv1));
+
+    outBufferSize = sizeof(outBuffer);
+    sprintf(entry, "batch%d", numWrites - 1);
+    result = le_secStore_Read(entry, outBuffer, &outBufferSize);
+    LE_TEST_OK((result == LE_OK) && (outBufferSize == sizeof(inBuffer)) &&
+               (memcmp(outBuffer, inBuffer, sizeof(inBuffer)) == 0),
+               "Read an entry stored by the batch: [%s]", LE_RESULT_TXT(result));
+
+    outBufferSize = sizeof(outBuffer);
+    result = le_secStore_Read("batch1", outBuffer, &outBufferSize);
+    LE_TEST_OK(result == LE_NOT_FOUND, "Entry deleted by the batch is not stored: [%s]",
+               LE_RESULT_TXT(result));
+
+    result = le_secStore_Delete("*");
+    LE_TEST_OK(result == LE_OK, "Delete the app contents: [%s]", LE_RESULT_TXT(result));
+
+    LE_TEST_INFO("End of Test11");
+}
+
 COMPONENT_INIT
 {
-    LE_TEST_PLAN(23);
+    LE_TEST_PLAN(32);
 
     LE_TEST_INFO("=== SecStoreTest2 BEGIN ===");
 
@@ -422,6 +505,7 @@ COMPONENT_INIT
 #endif
     Test9();
     Test10();
+    Test11();
     LE_TEST_INFO("=== SecStoreTest2 END ===");
 
     LE_TEST_EXIT;
@@ -75,6 +75,10 @@ static void Testle_smsInbox_Open
     MyMbx1Ref = le_smsInbox1_Open();
     LE_INFO("SmsInbox Open msg reference pointer is [%p]", MyMbx1Ref);
     LE_ASSERT(MyMbx1Ref != NULL);
+
+    // The legacy message box files are imported to the message store, then removed
+    LE_ASSERT(access("/tmp/smsInbox/cfg/le_smsInbox1.json", F_OK) != 0);
+    LE_ASSERT(access("/tmp/smsInbox/msg/0000002d.json", F_OK) != 0);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -449,7 +453,7 @@ static void Simulate_smsInbox_cfgFileInit
 )
 {
     LE_INFO("Init Sms InBox cfg files");
-    char cfgCpCommand[512] = "cp -rf ";
+    char cfgCpCommand[512] = "mkdir -p" SIMU_CONF_PATH " && cp -rf ";
     LE_ASSERT_OK(le_utf8_Append(cfgCpCommand, smsCfgFilePath, sizeof(cfgCpCommand), NULL));
     strncat(cfgCpCommand, SIMU_CONF_PATH, MAX_SIMU_PATH_LEN);
     system(cfgCpCommand);
@@ -466,7 +470,7 @@ static void Simulate_smsInbox_msgFileInit
 )
 {
     LE_INFO("Init Sms InBox msg files");
-    char msgCpCommand[512]= "cp -rf ";
+    char msgCpCommand[512]= "mkdir -p" SIMU_MSG_PATH " && cp -rf ";
     LE_ASSERT_OK(le_utf8_Append(msgCpCommand, smsMsgFilePath, sizeof(msgCpCommand), NULL));
     strncat(msgCpCommand, SIMU_MSG_PATH, MAX_SIMU_PATH_LEN);
     system(msgCpCommand);
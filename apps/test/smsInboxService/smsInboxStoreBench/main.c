@@ -0,0 +1,309 @@
+/**
+ * This module implements a benchmark of the SMS Inbox message store.
+ *
+ * The store is filled with a large number of messages (10000 by default), spread over two message
+ * boxes, then the latency of the main operations of the SMS Inbox service is measured:
+ *  - insertion of a received message,
+ *  - browsing of a message box, reading each message,
+ *  - update of the read/unread state,
+ *  - loading of the store at startup,
+ *  - deletion of the messages, including the compactions it triggers.
+ *
+ * The recovery of a damaged store file is checked as well.
+ *
+ * Usage: smsInboxStoreBench [messageCount] [storePath]
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+#include "smsStore.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default number of messages.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_MSG_COUNT   10000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages of the recovery test.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECOVERY_MSG_COUNT  10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default store file path.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_STORE_PATH  "/tmp/smsInboxStoreBench.bin"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message box names.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* MboxNames[] = {"benchInbox1", "benchInbox2"};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark start time.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_clk_Time_t StartTime;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a measure.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartMeasure
+(
+    void
+)
+{
+    StartTime = le_clk_GetRelativeTime();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop a measure and print the total and per operation latencies.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopMeasure
+(
+    const char* namePtr,    ///< [IN] Measured operation
+    uint32_t count          ///< [IN] Number of operations
+)
+{
+    le_clk_Time_t duration = le_clk_Sub(le_clk_GetRelativeTime(), StartTime);
+    uint64_t usec = (uint64_t)duration.sec * 1000000 + duration.usec;
+
+    LE_TEST_INFO("%-24s %8"PRIu32" ops %10"PRIu64" us %8.2f us/op", namePtr, count, usec,
+                 count ? (double)usec / count : 0.0);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill a text message.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FillMsg
+(
+    smsStore_Msg_t* msgPtr,     ///< [OUT] Message
+    uint32_t index              ///< [IN] Message index
+)
+{
+    memset(msgPtr, 0, sizeof(*msgPtr));
+
+    msgPtr->format = LE_SMS_FORMAT_TEXT;
+    snprintf(msgPtr->imsi, sizeof(msgPtr->imsi), "208011234567890");
+    snprintf(msgPtr->senderTel, sizeof(msgPtr->senderTel), "+3361234%04"PRIu32, index % 10000);
+    snprintf(msgPtr->timestamp, sizeof(msgPtr->timestamp), "20/01/01,12:%02"PRIu32":%02"PRIu32"+04",
+             (index / 60) % 60, index % 60);
+    msgPtr->dataLen = snprintf((char*) msgPtr->data, sizeof(msgPtr->data),
+                               "Benchmark message %"PRIu32": the quick brown fox jumps over the "
+                               "lazy dog", index);
+    msgPtr->msgLen = msgPtr->dataLen;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Browse a message box, reading every message.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t BrowseMbox
+(
+    uint8_t mboxIdx     ///< [IN] Message box
+)
+{
+    smsStore_Cursor_t cursor = {0};
+    smsStore_Msg_t msg;
+    uint32_t count = 0;
+    uint32_t msgId;
+
+    for (msgId = smsStore_GetFirst(&cursor, mboxIdx); msgId; msgId = smsStore_GetNext(&cursor))
+    {
+        LE_ASSERT_OK(smsStore_Get(msgId, &msg));
+        LE_ASSERT(LE_SMS_FORMAT_TEXT == msg.format);
+        count++;
+    }
+
+    smsStore_CloseCursor(&cursor);
+
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flip the bits of a byte of a file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DamageFile
+(
+    const char* pathPtr,        ///< [IN] File path
+    off_t offset                ///< [IN] Offset of the byte, from the end of the file if negative
+)
+{
+    int fd = open(pathPtr, O_RDWR);
+    uint8_t byte;
+
+    LE_ASSERT(fd >= 0);
+    if (offset < 0)
+    {
+        offset += lseek(fd, 0, SEEK_END);
+    }
+    LE_ASSERT(pread(fd, &byte, 1, offset) == 1);
+    byte = ~byte;
+    LE_ASSERT(pwrite(fd, &byte, 1, offset) == 1);
+    close(fd);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a damaged store file is kept aside, and that its valid messages are recovered.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestRecovery
+(
+    const char* storePathPtr    ///< [IN] Store file path
+)
+{
+    char badPath[PATH_MAX];
+    smsStore_Msg_t msg;
+    uint32_t msgId;
+    uint32_t i;
+
+    LE_ASSERT(snprintf(badPath, sizeof(badPath), "%s.bad", storePathPtr) < (int)sizeof(badPath));
+    unlink(storePathPtr);
+    unlink(badPath);
+
+    LE_TEST_ASSERT(smsStore_Init(storePathPtr, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)) == LE_OK,
+                   "Create the recovery store");
+    for (i = 0; i < RECOVERY_MSG_COUNT; i++)
+    {
+        FillMsg(&msg, i);
+        LE_ASSERT_OK(smsStore_Add(&msg, 0x1, &msgId));
+    }
+    smsStore_Close();
+
+    // A damaged record in the middle of the file only loses that message
+    DamageFile(storePathPtr, -(off_t)(RECOVERY_MSG_COUNT / 2) * 100);
+    LE_TEST_ASSERT(smsStore_Init(storePathPtr, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)) == LE_OK,
+                   "Load a damaged store");
+    LE_TEST_OK(smsStore_GetCount(0) == RECOVERY_MSG_COUNT - 1, "Following messages recovered");
+    LE_TEST_OK(access(badPath, F_OK) == 0, "Damaged store kept aside");
+    smsStore_Close();
+    unlink(badPath);
+
+    LE_TEST_ASSERT(smsStore_Init(storePathPtr, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)) == LE_OK,
+                   "Reload the repaired store");
+    LE_TEST_OK(smsStore_GetCount(0) == RECOVERY_MSG_COUNT - 1, "Repaired store kept");
+    LE_TEST_OK(access(badPath, F_OK) != 0, "Repaired store is valid");
+    smsStore_Close();
+
+    // A store without a valid header record is started again, the previous file kept aside
+    DamageFile(storePathPtr, sizeof(uint32_t));
+    LE_TEST_ASSERT(smsStore_Init(storePathPtr, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)) == LE_OK,
+                   "Load a store with a damaged header");
+    LE_TEST_OK(smsStore_GetCount(0) == 0, "New store started");
+    LE_TEST_OK(access(badPath, F_OK) == 0, "Invalid store kept aside");
+    smsStore_Close();
+
+    unlink(storePathPtr);
+    unlink(badPath);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+COMPONENT_INIT
+{
+    uint32_t msgCount = DEFAULT_MSG_COUNT;
+    const char* storePathPtr = DEFAULT_STORE_PATH;
+    smsStore_Cursor_t cursor = {0};
+    smsStore_Msg_t msg;
+    uint32_t msgId;
+    uint32_t i;
+
+    if (le_arg_NumArgs() >= 1)
+    {
+        msgCount = strtoul(le_arg_GetArg(0), NULL, 0);
+    }
+    if (le_arg_NumArgs() >= 2)
+    {
+        storePathPtr = le_arg_GetArg(1);
+    }
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    LE_TEST_INFO("SMS Inbox store benchmark: %"PRIu32" messages in %s", msgCount, storePathPtr);
+
+    unlink(storePathPtr);
+    LE_TEST_ASSERT(smsStore_Init(storePathPtr, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)) == LE_OK,
+                   "Create the store");
+
+    // Every message is received in both message boxes, as for the SMS Inbox service
+    StartMeasure();
+    for (i = 0; i < msgCount; i++)
+    {
+        FillMsg(&msg, i);
+        LE_ASSERT_OK(smsStore_Add(&msg, 0x3, &msgId));
+    }
+    StopMeasure("Insert", msgCount);
+    LE_TEST_OK(smsStore_GetCount(0) == msgCount, "Message box filled");
+
+    StartMeasure();
+    LE_TEST_OK(BrowseMbox(0) == msgCount, "Browse all the messages");
+    StopMeasure("Browse and read", msgCount);
+
+    StartMeasure();
+    for (msgId = smsStore_GetFirst(&cursor, 0); msgId; msgId = smsStore_GetNext(&cursor))
+    {
+        LE_ASSERT_OK(smsStore_SetUnread(msgId, 0, false));
+    }
+    StopMeasure("Mark read", msgCount);
+    smsStore_CloseCursor(&cursor);
+
+    smsStore_Close();
+    StartMeasure();
+    LE_TEST_ASSERT(smsStore_Init(storePathPtr, MboxNames, NUM_ARRAY_MEMBERS(MboxNames)) == LE_OK,
+                   "Reload the store");
+    StopMeasure("Load", msgCount);
+
+    msgId = smsStore_GetFirst(&cursor, 1);
+    smsStore_CloseCursor(&cursor);
+    LE_TEST_OK(msgId && !smsStore_IsUnread(msgId, 0) && smsStore_IsUnread(msgId, 1),
+               "Read state restored");
+
+    // Deleting the messages from both message boxes triggers the compaction of the store
+    StartMeasure();
+    for (msgId = smsStore_GetFirst(&cursor, 0); msgId; msgId = smsStore_GetNext(&cursor))
+    {
+        LE_ASSERT_OK(smsStore_RemoveFromMbox(msgId, 0));
+    }
+    StopMeasure("Delete from first mbox", msgCount);
+    smsStore_CloseCursor(&cursor);
+
+    StartMeasure();
+    LE_TEST_OK(smsStore_Compact() == LE_OK, "Compact the store");
+    StopMeasure("Compact", smsStore_GetCount(1));
+
+    StartMeasure();
+    while ((msgId = smsStore_GetOldest(1)) != 0)
+    {
+        LE_ASSERT_OK(smsStore_RemoveFromMbox(msgId, 1));
+    }
+    StopMeasure("Delete from second mbox", msgCount);
+    LE_TEST_OK(smsStore_GetCount(0) == 0 && smsStore_GetCount(1) == 0, "Store emptied");
+
+    smsStore_Close();
+
+    TestRecovery(storePathPtr);
+
+    LE_TEST_EXIT;
+}
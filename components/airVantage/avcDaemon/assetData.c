@@ -20,18 +20,14 @@
 
 #include "limit.h"
 #include "assetData.h"
+#include "timeSeries.h"
 #include "le_print.h"
 
 // For htonl
 #include <arpa/inet.h>
 
-#if FEATURE_TIMESERIES
-#   error "This time series implementation is obsolete"
-#endif
-
-#if FEATURE_TIMESERIES
+#if LE_CONFIG_AVC_FEATURE_TIMESERIES
 
-#include "cbor.h"
 #include "zlib.h"
 
 #endif
@@ -64,30 +60,10 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Maximum number of bytes for CBOR encoded time series data
+ * Maximum number of bytes for CBOR encoded time series data, before and after compression
  */
 //--------------------------------------------------------------------------------------------------
-#define MAX_CBOR_BUFFER_NUMBYTES 1024
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Checks the return value from the tinyCBOR encoder and returns from function if an error is found.
- */
-//--------------------------------------------------------------------------------------------------
-#if FEATURE_TIMESERIES
-
-#define \
-    RETURN_IF_CBOR_ERROR( err ) \
-    ({ \
-        if (err != CborNoError) \
-        { \
-            LE_ERROR("CBOR encoding error %s", cbor_error_string(err)); \
-            return LE_FAULT; \
-        } \
-    })
-
-#endif
+#define MAX_CBOR_BUFFER_NUMBYTES TIME_SERIES_MAX_CBOR_NUMBYTES
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -157,38 +133,6 @@ typedef struct le_avdata_AssetInstance
 InstanceData_t;
 
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Data contained in time series
- */
-//--------------------------------------------------------------------------------------------------
-typedef struct
-{
-    uint8_t* bufferPtr;             ///< Buffer for accumulating history data.
-    size_t bufferSize;              ///< Buffer size of history data.
-
-#if FEATURE_TIMESERIES
-    double timeStampFactor;         ///< Factor of time stamp.
-    uint64_t prevTimeStamp;         ///< Time stamp of last data capture, used for delta encoding.
-
-    double factor;                  ///< Factor of data.
-    union
-    {
-        int prevIntValue;           ///< Value of of last data capture - used for delta encoding.
-        double prevFloatValue;      ///< Value of last data capture - used for delta encoding.
-    };
-
-    uint32_t numElements;           ///< Number of elements in cbor encoded stream.
-
-    CborEncoder streamRef;          ///< CBOR encoded stream reference.
-    CborEncoder mapRef;             ///< CBOR encoded map reference.
-    CborEncoder sampleRef;          ///< CBOR encoded sample data reference.
-#endif
-}
-TimeSeriesData_t;
-
-
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Data contained in a single field of an asset instance
@@ -212,7 +156,7 @@ typedef struct
         char* strValuePtr;
     };
 
-    TimeSeriesData_t* timeSeriesPtr;
+    timeSeries_Ref_t timeSeriesRef;     ///< History data, if time series is enabled
 
     le_dls_Link_t link;          ///< For adding to the field list
 }
@@ -335,20 +279,14 @@ static le_hashmap_Ref_t AssetMapByName = NULL;
 static le_timer_Ref_t RegUpdateTimerRef;
 
 
+#if LE_CONFIG_AVC_FEATURE_TIMESERIES
 //--------------------------------------------------------------------------------------------------
 /**
- * Time series data memory pool.  Initialized in assetData_Init().
- */
-//--------------------------------------------------------------------------------------------------
-static le_mem_PoolRef_t TimeSeriesDataPoolRef = NULL;
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * CBOR buffer memory pool.  Initialized in assetData_Init().
+ * CBOR buffer memory pool, used when time series are pushed.  Initialized in assetData_Init().
  */
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t CborBufferPoolRef = NULL;
+#endif
 
 
 //--------------------------------------------------------------------------------------------------
@@ -564,7 +502,7 @@ static void InitDefaultFieldData
     fieldDataPtr->isObserve = false;
     fieldDataPtr->readCallBackOpRef = NULL;
 
-    fieldDataPtr->timeSeriesPtr = NULL;
+    fieldDataPtr->timeSeriesRef = NULL;
 
     switch ( fieldDataPtr->type )
     {
@@ -1311,15 +1249,12 @@ static le_result_t StartTimeSeries
     double timeStampFactor                      ///< [IN] Multiplication factor used for delta encoding of time stamp
 )
 {
-#if FEATURE_TIMESERIES
+#if LE_CONFIG_AVC_FEATURE_TIMESERIES
 
     le_result_t result;
     FieldData_t* fieldDataPtr;
-    uint8_t* timeSeriesBufferPtr;
     char headerId[64];
-    CborError err;
-    CborEncoder headerArray;
-    CborEncoder factorArray;
+    timeSeries_DataType_t type;
 
     result = GetFieldFromInstance(instanceRef, fieldId, &fieldDataPtr);
     if ( result != LE_OK )
@@ -1329,92 +1264,49 @@ static le_result_t StartTimeSeries
     }
 
     // Is time series enabled on this field.
-    if (fieldDataPtr->timeSeriesPtr != NULL)
+    if (fieldDataPtr->timeSeriesRef != NULL)
     {
         LE_ERROR("Time series already enabled on this field.");
         return LE_BUSY;
     }
 
-    FormatString(headerId,
-                 sizeof(headerId),
-                 "/%i/%i",
-                 instanceRef->instanceId,
-                 fieldId);
-
-    fieldDataPtr->timeSeriesPtr = le_mem_ForceAlloc(TimeSeriesDataPoolRef);
-
-    memset(fieldDataPtr->timeSeriesPtr, 0, sizeof(TimeSeriesData_t));
-
-    timeSeriesBufferPtr = le_mem_ForceAlloc(CborBufferPoolRef);
-    fieldDataPtr->timeSeriesPtr->bufferPtr = timeSeriesBufferPtr;
-
-    fieldDataPtr->timeSeriesPtr->bufferSize = MAX_CBOR_BUFFER_NUMBYTES;
-
-    // Initialize CBOR stream.
-    cbor_encoder_init(&fieldDataPtr->timeSeriesPtr->streamRef,
-                      timeSeriesBufferPtr,
-                      MAX_CBOR_BUFFER_NUMBYTES,
-                      0);
-
-    err = cbor_encoder_create_map(&fieldDataPtr->timeSeriesPtr->streamRef,
-                                  &fieldDataPtr->timeSeriesPtr->mapRef,
-                                  NUM_TIME_SERIES_MAPS);
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Create a map and add the header in to the map.
-    err = cbor_encode_text_stringz(&fieldDataPtr->timeSeriesPtr->mapRef, "h");
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Create an array for the header.
-    err = cbor_encoder_create_array(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                    &headerArray,
-                                    1);
-    RETURN_IF_CBOR_ERROR(err);
-
-    err = cbor_encode_text_string(&headerArray, headerId, strlen(headerId));
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Close the heade map i.e done with entering in to header array.
-    // e.g. "h" : [/1000/0]  --> map for header.
-    cbor_encoder_close_container(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                 &headerArray);
-
-    // Create a map for factor.
-    // e.g. "f" : [1]  --> map for factor.
-    err = cbor_encode_text_stringz(&fieldDataPtr->timeSeriesPtr->mapRef, "f");
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Create an array of factors (time stamp factor, data factor)
-    err = cbor_encoder_create_array(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                    &factorArray,
-                                    2);
-    RETURN_IF_CBOR_ERROR(err);
+    switch ( fieldDataPtr->type )
+    {
+        case DATA_TYPE_INT:
+            type = TIME_SERIES_TYPE_INT;
+            break;
 
-    // Add factor for time stamp.
-    err = cbor_encode_double(&factorArray, timeStampFactor);
-    RETURN_IF_CBOR_ERROR(err);
+        case DATA_TYPE_BOOL:
+            type = TIME_SERIES_TYPE_BOOL;
+            break;
 
-    // Add factor for sample.
-    err = cbor_encode_double(&factorArray, factor);
-    RETURN_IF_CBOR_ERROR(err);
+        case DATA_TYPE_STRING:
+            type = TIME_SERIES_TYPE_STRING;
+            break;
 
-    // Close the map i.e done with entering in to factor array.
-    cbor_encoder_close_container(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                 &factorArray);
+        case DATA_TYPE_FLOAT:
+            type = TIME_SERIES_TYPE_FLOAT;
+            break;
 
-    // Create an array for samples. The sample array will have time stamp and data pair.
-    err = cbor_encode_text_stringz(&fieldDataPtr->timeSeriesPtr->mapRef, "s");
-    RETURN_IF_CBOR_ERROR(err);
+        default:
+            LE_ERROR("Time series not supported on field %d.", fieldId);
+            return LE_FAULT;
+    }
 
-    err = cbor_encoder_create_array(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                    &fieldDataPtr->timeSeriesPtr->sampleRef,
-                                    CborIndefiniteLength);
-    RETURN_IF_CBOR_ERROR(err);
+    // e.g. "h" : [/1000/0]  --> header of the time series.
+    result = FormatString(headerId,
+                          sizeof(headerId),
+                          "/%i/%i",
+                          instanceRef->instanceId,
+                          fieldId);
+    if ( result != LE_OK )
+    {
+        return LE_FAULT;
+    }
 
-    fieldDataPtr->timeSeriesPtr->factor = factor;
-    fieldDataPtr->timeSeriesPtr->timeStampFactor = timeStampFactor;
+    fieldDataPtr->timeSeriesRef = timeSeries_Create(type, headerId, factor, timeStampFactor);
 
-    return result;
+    return LE_OK;
 
 #else
     LE_ERROR("Time series not supported.");
@@ -1439,7 +1331,7 @@ static le_result_t StopTimeSeries
     int fieldId                                 ///< [IN] Field to be time series'd
 )
 {
-#if FEATURE_TIMESERIES
+#if LE_CONFIG_AVC_FEATURE_TIMESERIES
 
     le_result_t result;
     FieldData_t* fieldDataPtr;
@@ -1450,16 +1342,14 @@ static le_result_t StopTimeSeries
         return result;
     }
 
-    if (fieldDataPtr->timeSeriesPtr == NULL)
+    if (fieldDataPtr->timeSeriesRef == NULL)
     {
         LE_ERROR("Time series not enabled on this field.");
         return LE_CLOSED;
     }
 
-    le_mem_Release(fieldDataPtr->timeSeriesPtr->bufferPtr);
-    le_mem_Release(fieldDataPtr->timeSeriesPtr);
-
-    fieldDataPtr->timeSeriesPtr = NULL;
+    timeSeries_Delete(fieldDataPtr->timeSeriesRef);
+    fieldDataPtr->timeSeriesRef = NULL;
 
     return LE_OK;
 
@@ -1472,7 +1362,7 @@ static le_result_t StopTimeSeries
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Compress the accumulated CBOR encoded time series data and send it to server.
+ * Encode the accumulated time series data in CBOR, compress it and send it to server.
  *
  * @return:
  *      - LE_OK on success
@@ -1490,19 +1380,17 @@ static le_result_t PushTimeSeries
 )
 {
 
-#if FEATURE_TIMESERIES
+#if LE_CONFIG_AVC_FEATURE_TIMESERIES
 
     le_result_t result;
     FieldData_t* fieldDataPtr;
-    uint32_t cborStreamSize;
-    unsigned char compressedBuf[MAX_CBOR_BUFFER_NUMBYTES];
+    uint8_t* cborBufferPtr;
+    uint8_t* compressedBufferPtr;
+    size_t cborStreamSize = MAX_CBOR_BUFFER_NUMBYTES;
     unsigned long int compressBufLength;
     z_stream defstream;
+    int zResult;
     pa_avc_LWM2MOperationDataRef_t opRef;
-    CborError err;
-
-    double dataFactor;
-    double timeStampFactor;
 
     result = GetFieldFromInstance(instanceRef, fieldId, &fieldDataPtr);
     if ( result != LE_OK )
@@ -1510,7 +1398,7 @@ static le_result_t PushTimeSeries
         return result;
     }
 
-    if (fieldDataPtr->timeSeriesPtr == NULL)
+    if (fieldDataPtr->timeSeriesRef == NULL)
     {
         // Time series not enabled on this field.
         LE_ERROR("Time series not enabled on this field.");
@@ -1524,47 +1412,46 @@ static le_result_t PushTimeSeries
         return LE_UNAVAILABLE;
     }
 
-    // Remember the factors used.
-    dataFactor = fieldDataPtr->timeSeriesPtr->factor;
-    timeStampFactor = fieldDataPtr->timeSeriesPtr->timeStampFactor;
-
-    // Close the map i.e done with entering in to sample array.
-    err = cbor_encoder_close_container_checked(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                               &fieldDataPtr->timeSeriesPtr->sampleRef);
-
-    RETURN_IF_CBOR_ERROR(err);
+    // Decode the history data in to a CBOR stream.
+    cborBufferPtr = le_mem_ForceAlloc(CborBufferPoolRef);
 
-    // Close the stream.
-    err = cbor_encoder_close_container_checked(&fieldDataPtr->timeSeriesPtr->streamRef,
-                                               &fieldDataPtr->timeSeriesPtr->mapRef);
-    RETURN_IF_CBOR_ERROR(err);
-
-    // Dump CBOR encoded data.
-    cborStreamSize = cbor_encoder_get_buffer_size(&fieldDataPtr->timeSeriesPtr->mapRef,
-                                                  fieldDataPtr->timeSeriesPtr->bufferPtr);
+    result = timeSeries_EncodeCbor(fieldDataPtr->timeSeriesRef, cborBufferPtr, &cborStreamSize);
+    if (result != LE_OK)
+    {
+        le_mem_Release(cborBufferPtr);
+        return LE_FAULT;
+    }
 
-    //LE_DEBUG("cborStreamSize = %d", cborStreamSize);
-    //LE_DUMP(fieldDataPtr->timeSeriesPtr->bufferPtr, cborStreamSize);
+    LE_DEBUG("cborStreamSize = %"PRIuS, cborStreamSize);
 
     // Compress the cbor encoded data
-    // ToDo: In place compression
+    compressedBufferPtr = le_mem_ForceAlloc(CborBufferPoolRef);
+
     defstream.zalloc = Z_NULL;
     defstream.zfree = Z_NULL;
     defstream.opaque = Z_NULL;
 
-    defstream.avail_in = cborStreamSize;
-    defstream.next_in = (Bytef *)fieldDataPtr->timeSeriesPtr->bufferPtr;
-    defstream.avail_out = (uInt)sizeof(compressedBuf);
-    defstream.next_out = (Bytef *)compressedBuf;
+    defstream.avail_in = (uInt)cborStreamSize;
+    defstream.next_in = (Bytef *)cborBufferPtr;
+    defstream.avail_out = (uInt)MAX_CBOR_BUFFER_NUMBYTES;
+    defstream.next_out = (Bytef *)compressedBufferPtr;
 
     deflateInit(&defstream, Z_BEST_COMPRESSION);
-    deflate(&defstream, Z_FINISH);
+    zResult = deflate(&defstream, Z_FINISH);
     deflateEnd(&defstream);
 
     compressBufLength = defstream.total_out;
 
-    //LE_DEBUG("Compressed size is: %lu\n", compressBufLength);
-    //LE_DUMP(compressedBuf, compressBufLength);
+    le_mem_Release(cborBufferPtr);
+
+    if (zResult != Z_STREAM_END)
+    {
+        LE_ERROR("Failed to compress time series on field %d (%d).", fieldId, zResult);
+        le_mem_Release(compressedBufferPtr);
+        return LE_FAULT;
+    }
+
+    LE_DEBUG("Compressed size is: %lu", compressBufLength);
 
     // Send the delta encoded + CBOR encoded + Zipped data to the server.
     opRef = pa_avc_CreateOpData(instanceRef->assetDataPtr->appName,
@@ -1576,18 +1463,18 @@ static le_result_t PushTimeSeries
                                 fieldDataPtr->token,
                                 fieldDataPtr->tokenLength);
 
-    pa_avc_NotifyChange(opRef, compressedBuf, compressBufLength);
+    pa_avc_NotifyChange(opRef, compressedBufferPtr, compressBufLength);
 
-    // Stop time series.
-    result = StopTimeSeries(instanceRef, fieldId);
+    le_mem_Release(compressedBufferPtr);
 
-    // Restart time series if asked.
-    if (result == LE_OK && isRestartTimeSeries)
+    // Restart time series if asked, keeping the factors; stop it otherwise.
+    if (isRestartTimeSeries)
     {
-        result = StartTimeSeries(instanceRef, fieldId, dataFactor, timeStampFactor);
+        timeSeries_Reset(fieldDataPtr->timeSeriesRef);
+        return LE_OK;
     }
 
-    return result;
+    return StopTimeSeries(instanceRef, fieldId);
 
 #else
     LE_ERROR("Time series not supported.");
@@ -1614,7 +1501,7 @@ le_result_t GetTimeSeriesStatus
     int* numDataPointsPtr                       ///< [OUT] Number of data points recorded so far
 )
 {
-#if FEATURE_TIMESERIES
+#if LE_CONFIG_AVC_FEATURE_TIMESERIES
 
     le_result_t result;
     FieldData_t* fieldDataPtr;
@@ -1625,7 +1512,7 @@ le_result_t GetTimeSeriesStatus
         return result;
     }
 
-    if (fieldDataPtr->timeSeriesPtr == NULL)
+    if (fieldDataPtr->timeSeriesRef == NULL)
     {
         // Time series not enabled on this field.
         LE_DEBUG("Time series not enabled on this field.");
@@ -1636,7 +1523,7 @@ le_result_t GetTimeSeriesStatus
     else
     {
         *isTimeSeriesPtr = true;
-        *numDataPointsPtr = fieldDataPtr->timeSeriesPtr->numElements;
+        *numDataPointsPtr = timeSeries_GetCount(fieldDataPtr->timeSeriesRef);
     }
 
     return LE_OK;
@@ -1650,7 +1537,7 @@ le_result_t GetTimeSeriesStatus
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add the sampled data in to the CBOR sample array.
+ * Add the sampled data in to the time series history.
  *
  * @return:
  *      - LE_OK on success
@@ -1666,29 +1553,10 @@ static le_result_t TimeSeriesAddEntry
 )
 {
 
-#if FEATURE_TIMESERIES
+#if LE_CONFIG_AVC_FEATURE_TIMESERIES
 
-    CborError err;
-    uint64_t timeStamp;
-    int intDelta;
-    double floatDelta;
-    size_t currentSize;
     struct timeval tv;
 
-    // Reserve CBOR_RESERVED_BYTES bytes for closing the container.
-    // The stream has to be flushed it starts getting in to the reserved area.
-    currentSize = cbor_encoder_get_buffer_size(&fieldDataPtr->timeSeriesPtr->sampleRef,
-                                               fieldDataPtr->timeSeriesPtr->bufferPtr);
-
-
-    if (currentSize > (fieldDataPtr->timeSeriesPtr->bufferSize - CBOR_RESERVED_BYTES))
-    {
-        LE_WARN("Time series buffer overflow on field %d.", fieldDataPtr->fieldId);
-        LE_DEBUG("currentSize = %"PRIdS".", currentSize);
-
-        return LE_OVERFLOW;
-    }
-
     // Get current system time if utc milli seconds is not provided.
     // The time stamp is expected in UTC milli seconds by the server.
     if (utcMilliSec == 0)
@@ -1697,104 +1565,35 @@ static le_result_t TimeSeriesAddEntry
         utcMilliSec = (uint64_t)(tv.tv_sec) * 1000 + (uint64_t)(tv.tv_usec) / 1000;
     }
 
-    // For the first entry write the absolute value, for all other entries calculate delta.
-    if (fieldDataPtr->timeSeriesPtr->numElements == 0)
-    {
-        timeStamp = utcMilliSec * fieldDataPtr->timeSeriesPtr->timeStampFactor;
-    }
-    else
-    {
-        timeStamp = (utcMilliSec - fieldDataPtr->timeSeriesPtr->prevTimeStamp) *
-                    fieldDataPtr->timeSeriesPtr->timeStampFactor;
-    }
-
-    // Add time stamp to sample array.
-    err = cbor_encode_int(&fieldDataPtr->timeSeriesPtr->sampleRef, timeStamp);
-    RETURN_IF_CBOR_ERROR(err);
-
-    fieldDataPtr->timeSeriesPtr->prevTimeStamp = utcMilliSec;
-
-    // Add the data to sample array.
+    // Add the data to the time series columns.
     switch ( fieldDataPtr->type )
     {
         case DATA_TYPE_INT:
-            if (fieldDataPtr->timeSeriesPtr->numElements == 0)
-            {
-                intDelta = fieldDataPtr->intValue * fieldDataPtr->timeSeriesPtr->factor;
-            }
-            else
-            {
-                intDelta = (fieldDataPtr->intValue - fieldDataPtr->timeSeriesPtr->prevIntValue) *
-                            fieldDataPtr->timeSeriesPtr->factor;
-            }
-
-            //LE_DEBUG("intDelta = %d", intDelta);
-
-            err = cbor_encode_int(&fieldDataPtr->timeSeriesPtr->sampleRef, intDelta);
-
-            fieldDataPtr->timeSeriesPtr->prevIntValue = fieldDataPtr->intValue;
-            break;
+            return timeSeries_AddInt(fieldDataPtr->timeSeriesRef,
+                                     utcMilliSec,
+                                     fieldDataPtr->intValue);
 
         case DATA_TYPE_BOOL:
-            err = cbor_encode_boolean(&fieldDataPtr->timeSeriesPtr->sampleRef, fieldDataPtr->boolValue);
-            break;
+            return timeSeries_AddBool(fieldDataPtr->timeSeriesRef,
+                                      utcMilliSec,
+                                      fieldDataPtr->boolValue);
 
         case DATA_TYPE_STRING:
-            err = cbor_encode_text_string(&fieldDataPtr->timeSeriesPtr->sampleRef,
-                                          fieldDataPtr->strValuePtr,
-                                          strlen(fieldDataPtr->strValuePtr));
-            break;
+            return timeSeries_AddString(fieldDataPtr->timeSeriesRef,
+                                        utcMilliSec,
+                                        fieldDataPtr->strValuePtr);
 
         case DATA_TYPE_FLOAT:
-            // ToDO: float doesn't benefit from use of factor - investigate.
-            if (fieldDataPtr->timeSeriesPtr->numElements == 0)
-            {
-                floatDelta = fieldDataPtr->floatValue * fieldDataPtr->timeSeriesPtr->factor;
-            }
-            else
-            {
-                floatDelta = (fieldDataPtr->floatValue - fieldDataPtr->timeSeriesPtr->prevFloatValue);
-                floatDelta = floatDelta * fieldDataPtr->timeSeriesPtr->factor;
-            }
-
-            if ((uint64_t)fieldDataPtr->timeSeriesPtr->factor == 1)
-            {
-                err = cbor_encode_double(&fieldDataPtr->timeSeriesPtr->sampleRef, floatDelta);
-            }
-            else
-            {
-                LE_DEBUG("Float data encoded as integer.");
-                err = cbor_encode_int(&fieldDataPtr->timeSeriesPtr->sampleRef, (int64_t)floatDelta);
-            }
-
-            fieldDataPtr->timeSeriesPtr->prevFloatValue = fieldDataPtr->floatValue;
-            break;
+            return timeSeries_AddFloat(fieldDataPtr->timeSeriesRef,
+                                       utcMilliSec,
+                                       fieldDataPtr->floatValue);
 
         case DATA_TYPE_NONE:
-            LE_ERROR("Failed to add an entry in CBOR stream.");
             break;
     }
 
-    RETURN_IF_CBOR_ERROR(err);
-
-    fieldDataPtr->timeSeriesPtr->numElements++;
-
-
-    // Reserve CBOR_RESERVED_BYTES bytes for closing the container.
-    // The stream has to be flushed it starts getting in to the reserved area.
-    currentSize = cbor_encoder_get_buffer_size(&fieldDataPtr->timeSeriesPtr->sampleRef,
-                                               fieldDataPtr->timeSeriesPtr->bufferPtr);
-
-    if (currentSize > (fieldDataPtr->timeSeriesPtr->bufferSize - CBOR_RESERVED_BYTES))
-    {
-        LE_WARN("Time series buffer full; flush and restart time series on field %d.",
-                 fieldDataPtr->fieldId);
-        LE_DEBUG("currentSize = %"PRIdS".", currentSize);
-
-        return LE_NO_MEMORY;
-    }
-
-    return LE_OK;
+    LE_ERROR("Failed to add an entry in time series.");
+    return LE_FAULT;
 
 #else
     LE_ERROR("Time series not supported.");
@@ -2204,7 +2003,7 @@ static le_result_t SetInt
 
     // If time series is enabled add the data to time series history and get out. If time series is
     // not enabled send the observe notification right away.
-    if (fieldDataPtr->timeSeriesPtr != NULL)
+    if (fieldDataPtr->timeSeriesRef != NULL)
     {
         return TimeSeriesAddEntry(fieldDataPtr, utcMilliSec);
     }
@@ -2318,7 +2117,7 @@ static le_result_t SetFloat
 
     // If time series is enabled add the data to time series history and get out. If time series is
     // not enabled send the observe notification right away.
-    if (fieldDataPtr->timeSeriesPtr != NULL)
+    if (fieldDataPtr->timeSeriesRef != NULL)
     {
         return TimeSeriesAddEntry(fieldDataPtr, utcMilliSec);
     }
@@ -2473,7 +2272,7 @@ static le_result_t SetBool
 
     // If time series is enabled add the data to time series history and get out. If time series is
     // not enabled send the observe notification right away.
-    if (fieldDataPtr->timeSeriesPtr != NULL)
+    if (fieldDataPtr->timeSeriesRef != NULL)
     {
         return TimeSeriesAddEntry(fieldDataPtr, utcMilliSec);
     }
@@ -2631,7 +2430,7 @@ static le_result_t SetString
 
     // If time series is enabled add the data to time series history and get out. If time series is
     // not enabled send the observe notification right away.
-    if (fieldDataPtr->timeSeriesPtr != NULL)
+    if (fieldDataPtr->timeSeriesRef != NULL)
     {
         return TimeSeriesAddEntry(fieldDataPtr, utcMilliSec);
     }
@@ -3196,11 +2995,10 @@ void assetData_DeleteInstance
         }
 
         // Release Time Series resources.
-        if (fieldDataPtr->timeSeriesPtr != NULL)
+        if (fieldDataPtr->timeSeriesRef != NULL)
         {
             LE_DEBUG("Releasing time series resources of %s", fieldDataPtr->name);
-            le_mem_Release(fieldDataPtr->timeSeriesPtr->bufferPtr);
-            le_mem_Release(fieldDataPtr->timeSeriesPtr);
+            timeSeries_Delete(fieldDataPtr->timeSeriesRef);
         }
 
         // Release the field.
@@ -4536,9 +4334,11 @@ le_result_t assetData_Init
     ActionHandlerDataPoolRef = le_mem_CreatePool("Action handler data pool",
                                                  sizeof(ActionHandlerData_t));
 
-    // Memory pool for time series data.
-    TimeSeriesDataPoolRef = le_mem_CreatePool("TimeSeries data pool", sizeof(TimeSeriesData_t));
+#if LE_CONFIG_AVC_FEATURE_TIMESERIES
+    // Memory pools for time series data.
+    timeSeries_Init();
     CborBufferPoolRef = le_mem_CreatePool("CBOR buffer pool", MAX_CBOR_BUFFER_NUMBYTES);
+#endif
 
     StringValuePoolRef = le_mem_CreatePool("String value pool", STRING_VALUE_NUMBYTES);
     AddressStringPoolRef = le_mem_CreatePool("Address pool", 100);
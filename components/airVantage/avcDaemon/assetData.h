@@ -37,23 +37,6 @@
 #define ASSET_DATA_LEGATO_OBJ_NAME "legato"
 
 
-//--------------------------------------------------------------------------------------------------
-/**
- *  Number of maps (called objects in JSON) in the CBOR encoded data (header, factor & sample).
- */
-//--------------------------------------------------------------------------------------------------
-#define NUM_TIME_SERIES_MAPS 3
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- *  Number of bytes reserved in the CBOR stream. After all the samples are added to CBOR stream few
- *  more bytes are needed to close the sample array and the stream.
- */
-//--------------------------------------------------------------------------------------------------
-#define CBOR_RESERVED_BYTES 32
-
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Actions that can happen on field or asset
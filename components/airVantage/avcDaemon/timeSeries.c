@@ -0,0 +1,1346 @@
+/**
+ * @file timeSeries.c
+ *
+ * Implementation of the columnar time series storage used by the Asset Data component.
+ *
+ * Each time series holds two columns, one for the timestamps and one for the values.  A column is
+ * a bit stream spread over a list of fixed size chunks taken from a pool shared by all the series.
+ * The pool is never expanded past TIME_SERIES_MAX_CHUNKS, so that the memory used by history data
+ * stays bounded no matter how many fields are recording.
+ *
+ * Integers (timestamps and integer values) are stored as delta-of-delta values, zig-zag encoded
+ * and written in one of the following buckets:
+ *
+ *  | Prefix  | Payload  | Range of the zig-zag encoded value |
+ *  |---------|----------|------------------------------------|
+ *  | 0       | 0 bit    | 0                                  |
+ *  | 10      | 7 bits   | < 2^7                              |
+ *  | 110     | 9 bits   | < 2^9                              |
+ *  | 1110    | 12 bits  | < 2^12                             |
+ *  | 11110   | 32 bits  | < 2^32                             |
+ *  | 11111   | 64 bits  | any                                |
+ *
+ * Floats are XOR'ed with the previous value.  An identical value takes a single '0' bit; otherwise
+ * '10' is followed by the meaningful bits if they fit in the previous leading/trailing zero window,
+ * or '11' is followed by 6 bits of leading zeros, 6 bits of meaningful length minus one and the
+ * meaningful bits.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#include "legato.h"
+#include "timeSeries.h"
+
+
+//--------------------------------------------------------------------------------------------------
+// Definitions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bits in a storage chunk.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHUNK_NUMBITS (TIME_SERIES_CHUNK_NUMBYTES * 8)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes for the resource path put in the CBOR header.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HEADER_ID_NUMBYTES 64
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bits used to store one timestamp or one integer value.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_INT_NUMBITS (5 + 64)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bits used to store one float value.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_FLOAT_NUMBITS (2 + 6 + 6 + 64)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bits used to store one string value.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_STRING_NUMBITS (1 + 8 + ((TIME_SERIES_STRING_NUMBYTES - 1) * 8))
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Number of maps (called objects in JSON) in the CBOR encoded data (header, factor & sample).
+ */
+//--------------------------------------------------------------------------------------------------
+#define NUM_TIME_SERIES_MAPS 3
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * CBOR header of a definite length map.  le_cbor does not provide an encoder for it.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CBOR_MAP_HEADER(numPairs) (0xA0 | (numPairs))
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes of a CBOR encoded integer.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CBOR_MAX_INT_NUMBYTES 9
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Storage chunk of a column.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_Link_t link;                             ///< For adding to the column chunk list
+    uint8_t data[TIME_SERIES_CHUNK_NUMBYTES];       ///< Bit stream
+}
+Chunk_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bit stream stored in a list of chunks.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sls_List_t chunkList;        ///< Chunks holding the bit stream, in order
+    Chunk_t* writeChunkPtr;         ///< Chunk currently being written
+    size_t numChunks;               ///< Number of chunks in chunkList
+    size_t numBits;                 ///< Number of bits written
+}
+Column_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reader of a column.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const Column_t* columnPtr;      ///< Column being read
+    le_sls_Link_t* linkPtr;         ///< Link of the chunk currently being read
+    size_t pos;                     ///< Position of the next bit to read
+}
+ColumnReader_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delta encoding state.  It is kept by the series while samples are added, and rebuilt in the
+ * same way when samples are decoded.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t count;                 ///< Number of samples seen so far
+    uint64_t prevTimeStamp;         ///< Time stamp of the last sample
+    int64_t prevTimeStampDelta;     ///< Difference between the last two time stamps
+    union
+    {
+        struct
+        {
+            int32_t prevInt;        ///< Last integer value
+            int64_t prevIntDelta;   ///< Difference between the last two integer values
+        };
+        struct
+        {
+            uint64_t prevFloatBits; ///< Last float value, as bits
+            uint8_t leadingZeros;   ///< Leading zeros of the current XOR window
+            uint8_t trailingZeros;  ///< Trailing zeros of the current XOR window
+            bool hasXorWindow;      ///< Whether the XOR window has been set
+        };
+    };
+}
+DeltaState_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of a sample.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef union
+{
+    int32_t intValue;
+    double floatValue;
+    bool boolValue;
+    const char* strValuePtr;
+}
+Value_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time series.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct timeSeries_Series
+{
+    timeSeries_DataType_t type;                     ///< Type of the values
+    char headerId[HEADER_ID_NUMBYTES];              ///< Resource path put in the header
+    double factor;                                  ///< Factor of data
+    double timeStampFactor;                         ///< Factor of time stamp
+    size_t cborSize;                                ///< Size of the CBOR encoded stream
+    Column_t timeStampColumn;                       ///< Time stamps
+    Column_t valueColumn;                           ///< Values
+    DeltaState_t state;                             ///< Encoding state
+    char prevString[TIME_SERIES_STRING_NUMBYTES];   ///< Last string value
+}
+Series_t;
+
+
+//--------------------------------------------------------------------------------------------------
+// Local Data
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Time series memory pool.  Initialized in timeSeries_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t SeriesPoolRef = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Storage chunk memory pool, bounded to TIME_SERIES_MAX_CHUNKS.  Initialized in timeSeries_Init().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ChunkPoolRef = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+// Column bit streams
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make sure a column has room for at least numBits more bits.
+ *
+ * @return
+ *      - true if the room is available
+ *      - false if the chunk pool is exhausted
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReserveBits
+(
+    Column_t* columnPtr,
+    size_t numBits
+)
+{
+    while ((columnPtr->numChunks * CHUNK_NUMBITS) < (columnPtr->numBits + numBits))
+    {
+        Chunk_t* chunkPtr = le_mem_TryAlloc(ChunkPoolRef);
+
+        if (chunkPtr == NULL)
+        {
+            return false;
+        }
+
+        memset(chunkPtr->data, 0, sizeof(chunkPtr->data));
+        chunkPtr->link = LE_SLS_LINK_INIT;
+        le_sls_Queue(&columnPtr->chunkList, &chunkPtr->link);
+        columnPtr->numChunks++;
+
+        if (columnPtr->writeChunkPtr == NULL)
+        {
+            columnPtr->writeChunkPtr = chunkPtr;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Give all the chunks of a column back to the pool.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClearColumn
+(
+    Column_t* columnPtr
+)
+{
+    le_sls_Link_t* linkPtr;
+
+    while ((linkPtr = le_sls_Pop(&columnPtr->chunkList)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, Chunk_t, link));
+    }
+
+    columnPtr->chunkList = LE_SLS_LIST_INIT;
+    columnPtr->writeChunkPtr = NULL;
+    columnPtr->numChunks = 0;
+    columnPtr->numBits = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append the numBits least significant bits of value to a column, most significant bit first.
+ * Room must have been reserved with ReserveBits().
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteBits
+(
+    Column_t* columnPtr,
+    uint64_t value,
+    uint32_t numBits
+)
+{
+    while (numBits > 0)
+    {
+        size_t bitPos = columnPtr->numBits % CHUNK_NUMBITS;
+
+        if ((bitPos == 0) && (columnPtr->numBits != 0))
+        {
+            le_sls_Link_t* nextLinkPtr = le_sls_PeekNext(&columnPtr->chunkList,
+                                                         &columnPtr->writeChunkPtr->link);
+            LE_ASSERT(nextLinkPtr != NULL);
+            columnPtr->writeChunkPtr = CONTAINER_OF(nextLinkPtr, Chunk_t, link);
+        }
+
+        uint32_t freeBits = 8 - (bitPos % 8);
+        uint32_t takeBits = (numBits < freeBits) ? numBits : freeBits;
+        uint8_t bits = (uint8_t)((value >> (numBits - takeBits)) & ((1u << takeBits) - 1));
+
+        columnPtr->writeChunkPtr->data[bitPos / 8] |= (uint8_t)(bits << (freeBits - takeBits));
+        columnPtr->numBits += takeBits;
+        numBits -= takeBits;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start reading a column from its first bit.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartReader
+(
+    ColumnReader_t* readerPtr,
+    const Column_t* columnPtr
+)
+{
+    readerPtr->columnPtr = columnPtr;
+    readerPtr->linkPtr = le_sls_Peek(&columnPtr->chunkList);
+    readerPtr->pos = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the next numBits bits of a column.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ReadBits
+(
+    ColumnReader_t* readerPtr,
+    uint32_t numBits
+)
+{
+    uint64_t value = 0;
+
+    LE_ASSERT((readerPtr->pos + numBits) <= readerPtr->columnPtr->numBits);
+
+    while (numBits > 0)
+    {
+        size_t bitPos = readerPtr->pos % CHUNK_NUMBITS;
+
+        if ((bitPos == 0) && (readerPtr->pos != 0))
+        {
+            readerPtr->linkPtr = le_sls_PeekNext(&readerPtr->columnPtr->chunkList,
+                                                 readerPtr->linkPtr);
+        }
+
+        const Chunk_t* chunkPtr = CONTAINER_OF(readerPtr->linkPtr, Chunk_t, link);
+        uint32_t availBits = 8 - (bitPos % 8);
+        uint32_t takeBits = (numBits < availBits) ? numBits : availBits;
+        uint8_t bits = (chunkPtr->data[bitPos / 8] >> (availBits - takeBits)) &
+                       ((1u << takeBits) - 1);
+
+        value = (value << takeBits) | bits;
+        readerPtr->pos += takeBits;
+        numBits -= takeBits;
+    }
+
+    return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Integer and float codecs
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a signed integer in the smallest bucket that fits its zig-zag encoding.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteVarInt
+(
+    Column_t* columnPtr,
+    int64_t value
+)
+{
+    uint64_t zigZag = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+
+    if (zigZag == 0)
+    {
+        WriteBits(columnPtr, 0x0, 1);
+    }
+    else if (zigZag < (1ULL << 7))
+    {
+        WriteBits(columnPtr, 0x2, 2);
+        WriteBits(columnPtr, zigZag, 7);
+    }
+    else if (zigZag < (1ULL << 9))
+    {
+        WriteBits(columnPtr, 0x6, 3);
+        WriteBits(columnPtr, zigZag, 9);
+    }
+    else if (zigZag < (1ULL << 12))
+    {
+        WriteBits(columnPtr, 0xE, 4);
+        WriteBits(columnPtr, zigZag, 12);
+    }
+    else if (zigZag < (1ULL << 32))
+    {
+        WriteBits(columnPtr, 0x1E, 5);
+        WriteBits(columnPtr, zigZag, 32);
+    }
+    else
+    {
+        WriteBits(columnPtr, 0x1F, 5);
+        WriteBits(columnPtr, zigZag, 64);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a signed integer written by WriteVarInt().
+ */
+//--------------------------------------------------------------------------------------------------
+static int64_t ReadVarInt
+(
+    ColumnReader_t* readerPtr
+)
+{
+    static const uint32_t payloadBits[] = { 0, 7, 9, 12, 32 };
+    uint32_t numOnes = 0;
+    uint64_t zigZag;
+
+    // Count the leading ones of the prefix, which is terminated by a zero except for the last
+    // bucket.
+    while ((numOnes < NUM_ARRAY_MEMBERS(payloadBits)) && (ReadBits(readerPtr, 1) == 1))
+    {
+        numOnes++;
+    }
+
+    if (numOnes < NUM_ARRAY_MEMBERS(payloadBits))
+    {
+        zigZag = (payloadBits[numOnes] != 0) ? ReadBits(readerPtr, payloadBits[numOnes]) : 0;
+    }
+    else
+    {
+        zigZag = ReadBits(readerPtr, 64);
+    }
+
+    return (int64_t)(zigZag >> 1) ^ -(int64_t)(zigZag & 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a float value XOR'ed with the previous one, and update the XOR window.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteXorFloat
+(
+    Column_t* columnPtr,
+    DeltaState_t* statePtr,
+    uint64_t bits
+)
+{
+    uint64_t xorBits = bits ^ statePtr->prevFloatBits;
+
+    if (xorBits == 0)
+    {
+        WriteBits(columnPtr, 0x0, 1);
+        return;
+    }
+
+    uint8_t leadingZeros = (uint8_t)__builtin_clzll(xorBits);
+    uint8_t trailingZeros = (uint8_t)__builtin_ctzll(xorBits);
+
+    if ((statePtr->hasXorWindow) &&
+        (leadingZeros >= statePtr->leadingZeros) &&
+        (trailingZeros >= statePtr->trailingZeros))
+    {
+        // Meaningful bits fit in the previous window.
+        uint32_t meaningfulBits = 64 - statePtr->leadingZeros - statePtr->trailingZeros;
+
+        WriteBits(columnPtr, 0x2, 2);
+        WriteBits(columnPtr, xorBits >> statePtr->trailingZeros, meaningfulBits);
+    }
+    else
+    {
+        uint32_t meaningfulBits = 64 - leadingZeros - trailingZeros;
+
+        WriteBits(columnPtr, 0x3, 2);
+        WriteBits(columnPtr, leadingZeros, 6);
+        WriteBits(columnPtr, meaningfulBits - 1, 6);
+        WriteBits(columnPtr, xorBits >> trailingZeros, meaningfulBits);
+
+        statePtr->leadingZeros = leadingZeros;
+        statePtr->trailingZeros = trailingZeros;
+        statePtr->hasXorWindow = true;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a float value written by WriteXorFloat(), and update the XOR window.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ReadXorFloat
+(
+    ColumnReader_t* readerPtr,
+    DeltaState_t* statePtr
+)
+{
+    if (ReadBits(readerPtr, 1) == 0)
+    {
+        return statePtr->prevFloatBits;
+    }
+
+    if (ReadBits(readerPtr, 1) == 1)
+    {
+        statePtr->leadingZeros = (uint8_t)ReadBits(readerPtr, 6);
+        statePtr->trailingZeros = (uint8_t)(64 - statePtr->leadingZeros -
+                                            (ReadBits(readerPtr, 6) + 1));
+        statePtr->hasXorWindow = true;
+    }
+
+    uint32_t meaningfulBits = 64 - statePtr->leadingZeros - statePtr->trailingZeros;
+    uint64_t xorBits = ReadBits(readerPtr, meaningfulBits) << statePtr->trailingZeros;
+
+    return statePtr->prevFloatBits ^ xorBits;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// CBOR mapping
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes of a CBOR encoded integer.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t CborIntSize
+(
+    int64_t value
+)
+{
+    uint64_t magnitude = (value < 0) ? (uint64_t)(-1 - value) : (uint64_t)value;
+
+    if (magnitude < 24)
+    {
+        return 1;
+    }
+    else if (magnitude <= UINT8_MAX)
+    {
+        return 2;
+    }
+    else if (magnitude <= UINT16_MAX)
+    {
+        return 3;
+    }
+    else if (magnitude <= UINT32_MAX)
+    {
+        return 5;
+    }
+
+    return 9;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes of the CBOR stream of an empty time series.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t CborEmptySize
+(
+    const Series_t* seriesPtr
+)
+{
+    size_t headerIdLen = strlen(seriesPtr->headerId);
+
+    return 1 +                                                  // map header
+           2 + 1 + CborIntSize(headerIdLen) + headerIdLen +     // "h" : [ headerId ]
+           2 + 1 + (2 * LE_CBOR_DOUBLE_MAX_SIZE) +              // "f" : [ tsFactor, factor ]
+           2 + LE_CBOR_INDEF_ARRAY_HEADER_MAX_SIZE +            // "s" : [_
+           LE_CBOR_INDEF_END_MAX_SIZE;                          // ]
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of the time stamp put in the CBOR stream for a sample.
+ */
+//--------------------------------------------------------------------------------------------------
+static int64_t CborTimeStamp
+(
+    const Series_t* seriesPtr,
+    const DeltaState_t* statePtr,   ///< State before the sample
+    uint64_t utcMilliSec
+)
+{
+    // For the first entry write the absolute value, for all other entries the delta.
+    if (statePtr->count == 0)
+    {
+        return (int64_t)(uint64_t)(utcMilliSec * seriesPtr->timeStampFactor);
+    }
+
+    return (int64_t)(uint64_t)((utcMilliSec - statePtr->prevTimeStamp) *
+                               seriesPtr->timeStampFactor);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of an integer sample put in the CBOR stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static int64_t CborIntValue
+(
+    const Series_t* seriesPtr,
+    const DeltaState_t* statePtr,   ///< State before the sample
+    int32_t value
+)
+{
+    if (statePtr->count == 0)
+    {
+        return (int)(value * seriesPtr->factor);
+    }
+
+    return (int)(((int64_t)value - statePtr->prevInt) * seriesPtr->factor);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delta of a float sample put in the CBOR stream.  It is encoded as a double when the factor is 1,
+ * and as an integer otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static double CborFloatValue
+(
+    const Series_t* seriesPtr,
+    const DeltaState_t* statePtr,   ///< State before the sample
+    double value
+)
+{
+    double prevValue;
+
+    if (statePtr->count == 0)
+    {
+        return value * seriesPtr->factor;
+    }
+
+    memcpy(&prevValue, &statePtr->prevFloatBits, sizeof(prevValue));
+    return (value - prevValue) * seriesPtr->factor;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Whether floats are encoded as doubles in the CBOR stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline bool IsCborDouble
+(
+    const Series_t* seriesPtr
+)
+{
+    return ((uint64_t)seriesPtr->factor == 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes of the CBOR encoded value of a sample.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t CborValueSize
+(
+    const Series_t* seriesPtr,
+    const DeltaState_t* statePtr,   ///< State before the sample
+    const Value_t* valuePtr,
+    size_t strLen                   ///< String length, for string samples
+)
+{
+    switch (seriesPtr->type)
+    {
+        case TIME_SERIES_TYPE_INT:
+            return CborIntSize(CborIntValue(seriesPtr, statePtr, valuePtr->intValue));
+
+        case TIME_SERIES_TYPE_BOOL:
+            return LE_CBOR_BOOL_MAX_SIZE;
+
+        case TIME_SERIES_TYPE_STRING:
+            return CborIntSize(strLen) + strLen;
+
+        case TIME_SERIES_TYPE_FLOAT:
+            if (IsCborDouble(seriesPtr))
+            {
+                return LE_CBOR_DOUBLE_MAX_SIZE;
+            }
+            return CborIntSize((int64_t)CborFloatValue(seriesPtr, statePtr,
+                                                       valuePtr->floatValue));
+    }
+
+    return 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Largest number of CBOR bytes a sample of the given type can take.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t CborMaxSampleSize
+(
+    timeSeries_DataType_t type
+)
+{
+    size_t valueSize = CBOR_MAX_INT_NUMBYTES;
+
+    if (type == TIME_SERIES_TYPE_STRING)
+    {
+        valueSize = CborIntSize(TIME_SERIES_STRING_NUMBYTES - 1) + TIME_SERIES_STRING_NUMBYTES - 1;
+    }
+
+    return CBOR_MAX_INT_NUMBYTES + valueSize;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Largest number of bits a value of the given type can take in the value column.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t MaxValueBits
+(
+    timeSeries_DataType_t type
+)
+{
+    switch (type)
+    {
+        case TIME_SERIES_TYPE_INT:
+            return MAX_INT_NUMBITS;
+        case TIME_SERIES_TYPE_BOOL:
+            return 1;
+        case TIME_SERIES_TYPE_STRING:
+            return MAX_STRING_NUMBITS;
+        case TIME_SERIES_TYPE_FLOAT:
+            return MAX_FLOAT_NUMBITS;
+    }
+
+    return 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Samples
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a sample to the columns of a time series.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the time series is full.
+ *      - LE_NO_MEMORY if the sample was added but there may be no space for the next one.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AddSample
+(
+    Series_t* seriesPtr,
+    uint64_t utcMilliSec,
+    const Value_t* valuePtr
+)
+{
+    DeltaState_t* statePtr = &seriesPtr->state;
+    size_t strLen = 0;
+
+    if (seriesPtr->type == TIME_SERIES_TYPE_STRING)
+    {
+        strLen = strnlen(valuePtr->strValuePtr, TIME_SERIES_STRING_NUMBYTES - 1);
+    }
+
+    size_t cborBytes = CborIntSize(CborTimeStamp(seriesPtr, statePtr, utcMilliSec)) +
+                       CborValueSize(seriesPtr, statePtr, valuePtr, strLen);
+
+    if ((seriesPtr->cborSize + cborBytes) > TIME_SERIES_MAX_CBOR_NUMBYTES)
+    {
+        LE_WARN("Time series buffer overflow on %s.", seriesPtr->headerId);
+        return LE_OVERFLOW;
+    }
+
+    if ( (!ReserveBits(&seriesPtr->timeStampColumn, MAX_INT_NUMBITS)) ||
+         (!ReserveBits(&seriesPtr->valueColumn, MaxValueBits(seriesPtr->type))) )
+    {
+        LE_WARN("Time series storage exhausted on %s.", seriesPtr->headerId);
+        return LE_OVERFLOW;
+    }
+
+    // Time stamp column.
+    if (statePtr->count == 0)
+    {
+        WriteBits(&seriesPtr->timeStampColumn, utcMilliSec, 64);
+        statePtr->prevTimeStampDelta = 0;
+    }
+    else
+    {
+        int64_t delta = (int64_t)(utcMilliSec - statePtr->prevTimeStamp);
+
+        WriteVarInt(&seriesPtr->timeStampColumn, delta - statePtr->prevTimeStampDelta);
+        statePtr->prevTimeStampDelta = delta;
+    }
+    statePtr->prevTimeStamp = utcMilliSec;
+
+    // Value column.
+    switch (seriesPtr->type)
+    {
+        case TIME_SERIES_TYPE_INT:
+            if (statePtr->count == 0)
+            {
+                WriteBits(&seriesPtr->valueColumn, (uint32_t)valuePtr->intValue, 32);
+                statePtr->prevIntDelta = 0;
+            }
+            else
+            {
+                int64_t delta = (int64_t)valuePtr->intValue - statePtr->prevInt;
+
+                WriteVarInt(&seriesPtr->valueColumn, delta - statePtr->prevIntDelta);
+                statePtr->prevIntDelta = delta;
+            }
+            statePtr->prevInt = valuePtr->intValue;
+            break;
+
+        case TIME_SERIES_TYPE_BOOL:
+            WriteBits(&seriesPtr->valueColumn, valuePtr->boolValue ? 1 : 0, 1);
+            break;
+
+        case TIME_SERIES_TYPE_STRING:
+            if ( (statePtr->count != 0) &&
+                 (strncmp(seriesPtr->prevString, valuePtr->strValuePtr, strLen) == 0) &&
+                 (seriesPtr->prevString[strLen] == '\0') )
+            {
+                WriteBits(&seriesPtr->valueColumn, 0x0, 1);
+            }
+            else
+            {
+                size_t i;
+
+                WriteBits(&seriesPtr->valueColumn, 0x1, 1);
+                WriteBits(&seriesPtr->valueColumn, strLen, 8);
+                for (i = 0; i < strLen; i++)
+                {
+                    WriteBits(&seriesPtr->valueColumn, (uint8_t)valuePtr->strValuePtr[i], 8);
+                }
+
+                memcpy(seriesPtr->prevString, valuePtr->strValuePtr, strLen);
+                seriesPtr->prevString[strLen] = '\0';
+            }
+            break;
+
+        case TIME_SERIES_TYPE_FLOAT:
+        {
+            uint64_t bits;
+
+            memcpy(&bits, &valuePtr->floatValue, sizeof(bits));
+            if (statePtr->count == 0)
+            {
+                WriteBits(&seriesPtr->valueColumn, bits, 64);
+            }
+            else
+            {
+                WriteXorFloat(&seriesPtr->valueColumn, statePtr, bits);
+            }
+            statePtr->prevFloatBits = bits;
+            break;
+        }
+    }
+
+    statePtr->count++;
+    seriesPtr->cborSize += cborBytes;
+
+    // Check that the next sample will fit.
+    if ( ((seriesPtr->cborSize + CborMaxSampleSize(seriesPtr->type)) >
+          TIME_SERIES_MAX_CBOR_NUMBYTES) ||
+         (!ReserveBits(&seriesPtr->timeStampColumn, MAX_INT_NUMBITS)) ||
+         (!ReserveBits(&seriesPtr->valueColumn, MaxValueBits(seriesPtr->type))) )
+    {
+        LE_WARN("Time series buffer full; flush and restart time series on %s.",
+                seriesPtr->headerId);
+        return LE_NO_MEMORY;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up a time series and check the type of its values.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AddTypedSample
+(
+    timeSeries_Ref_t seriesRef,
+    timeSeries_DataType_t type,
+    uint64_t utcMilliSec,
+    const Value_t* valuePtr
+)
+{
+    LE_ASSERT(seriesRef != NULL);
+
+    if (seriesRef->type != type)
+    {
+        LE_ERROR("Time series on %s does not record type %d.", seriesRef->headerId, type);
+        return LE_FAULT;
+    }
+
+    return AddSample(seriesRef, utcMilliSec, valuePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Public functions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a new, empty time series.
+ *
+ * @return
+ *      - Reference to the time series.
+ */
+//--------------------------------------------------------------------------------------------------
+timeSeries_Ref_t timeSeries_Create
+(
+    timeSeries_DataType_t type,     ///< [IN] Type of the recorded values
+    const char* headerIdPtr,        ///< [IN] Resource path put in the header, e.g. "/0/1"
+    double factor,                  ///< [IN] Multiplication factor used for delta encoding
+    double timeStampFactor          ///< [IN] Multiplication factor used for the time stamps
+)
+{
+    Series_t* seriesPtr = le_mem_ForceAlloc(SeriesPoolRef);
+
+    memset(seriesPtr, 0, sizeof(Series_t));
+
+    seriesPtr->type = type;
+    LE_ASSERT(le_utf8_Copy(seriesPtr->headerId, headerIdPtr, sizeof(seriesPtr->headerId), NULL)
+              == LE_OK);
+    seriesPtr->factor = factor;
+    seriesPtr->timeStampFactor = timeStampFactor;
+    seriesPtr->timeStampColumn.chunkList = LE_SLS_LIST_INIT;
+    seriesPtr->valueColumn.chunkList = LE_SLS_LIST_INIT;
+    seriesPtr->cborSize = CborEmptySize(seriesPtr);
+
+    return seriesPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a time series and give its storage chunks back to the pool.
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_Delete
+(
+    timeSeries_Ref_t seriesRef      ///< [IN] Time series
+)
+{
+    LE_ASSERT(seriesRef != NULL);
+
+    ClearColumn(&seriesRef->timeStampColumn);
+    ClearColumn(&seriesRef->valueColumn);
+
+    le_mem_Release(seriesRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discard all the samples of a time series, keeping its header and factors.
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_Reset
+(
+    timeSeries_Ref_t seriesRef      ///< [IN] Time series
+)
+{
+    LE_ASSERT(seriesRef != NULL);
+
+    ClearColumn(&seriesRef->timeStampColumn);
+    ClearColumn(&seriesRef->valueColumn);
+
+    memset(&seriesRef->state, 0, sizeof(seriesRef->state));
+    seriesRef->prevString[0] = '\0';
+    seriesRef->cborSize = CborEmptySize(seriesRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an integer sample to a time series.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the time series is full.
+ *      - LE_NO_MEMORY if the sample was added but there may be no space for the next one.
+ *      - LE_FAULT if the time series does not record integers.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddInt
+(
+    timeSeries_Ref_t seriesRef,     ///< [IN] Time series
+    uint64_t utcMilliSec,           ///< [IN] Time stamp in milliseconds since epoch
+    int32_t value                   ///< [IN] Value
+)
+{
+    Value_t sampleValue = { .intValue = value };
+
+    return AddTypedSample(seriesRef, TIME_SERIES_TYPE_INT, utcMilliSec, &sampleValue);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a float sample to a time series.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the time series is full.
+ *      - LE_NO_MEMORY if the sample was added but there may be no space for the next one.
+ *      - LE_FAULT if the time series does not record floats.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddFloat
+(
+    timeSeries_Ref_t seriesRef,     ///< [IN] Time series
+    uint64_t utcMilliSec,           ///< [IN] Time stamp in milliseconds since epoch
+    double value                    ///< [IN] Value
+)
+{
+    Value_t sampleValue = { .floatValue = value };
+
+    return AddTypedSample(seriesRef, TIME_SERIES_TYPE_FLOAT, utcMilliSec, &sampleValue);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a boolean sample to a time series.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the time series is full.
+ *      - LE_NO_MEMORY if the sample was added but there may be no space for the next one.
+ *      - LE_FAULT if the time series does not record booleans.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddBool
+(
+    timeSeries_Ref_t seriesRef,     ///< [IN] Time series
+    uint64_t utcMilliSec,           ///< [IN] Time stamp in milliseconds since epoch
+    bool value                      ///< [IN] Value
+)
+{
+    Value_t sampleValue = { .boolValue = value };
+
+    return AddTypedSample(seriesRef, TIME_SERIES_TYPE_BOOL, utcMilliSec, &sampleValue);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a string sample to a time series.  Strings longer than TIME_SERIES_STRING_NUMBYTES - 1 bytes
+ * are truncated.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the time series is full.
+ *      - LE_NO_MEMORY if the sample was added but there may be no space for the next one.
+ *      - LE_FAULT if the time series does not record strings.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddString
+(
+    timeSeries_Ref_t seriesRef,     ///< [IN] Time series
+    uint64_t utcMilliSec,           ///< [IN] Time stamp in milliseconds since epoch
+    const char* valuePtr            ///< [IN] Value
+)
+{
+    Value_t sampleValue = { .strValuePtr = valuePtr };
+
+    return AddTypedSample(seriesRef, TIME_SERIES_TYPE_STRING, utcMilliSec, &sampleValue);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of samples recorded in a time series.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t timeSeries_GetCount
+(
+    timeSeries_Ref_t seriesRef      ///< [IN] Time series
+)
+{
+    LE_ASSERT(seriesRef != NULL);
+
+    return seriesRef->state.count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes actually used by the compressed samples of a time series.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t timeSeries_GetStorageSize
+(
+    timeSeries_Ref_t seriesRef      ///< [IN] Time series
+)
+{
+    LE_ASSERT(seriesRef != NULL);
+
+    return ((seriesRef->timeStampColumn.numBits + 7) / 8) +
+           ((seriesRef->valueColumn.numBits + 7) / 8);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the exact number of bytes of the CBOR stream timeSeries_EncodeCbor() would generate.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t timeSeries_GetCborSize
+(
+    timeSeries_Ref_t seriesRef      ///< [IN] Time series
+)
+{
+    LE_ASSERT(seriesRef != NULL);
+
+    return seriesRef->cborSize;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the samples of a time series and write them to a buffer as a CBOR stream in the format
+ * expected by the AirVantage server.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the buffer is too small
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_EncodeCbor
+(
+    timeSeries_Ref_t seriesRef,     ///< [IN] Time series
+    uint8_t* bufferPtr,             ///< [OUT] Buffer receiving the CBOR stream
+    size_t* bufferSizePtr           ///< [IN/OUT] Buffer size as input, stream size as output
+)
+{
+    const Series_t* seriesPtr = seriesRef;
+    ColumnReader_t timeStampReader;
+    ColumnReader_t valueReader;
+    DeltaState_t state;
+    char strValue[TIME_SERIES_STRING_NUMBYTES] = "";
+    uint8_t* writePtr = bufferPtr;
+    size_t bufLen;
+    uint32_t i;
+    bool ok;
+
+    LE_ASSERT(seriesPtr != NULL);
+    LE_ASSERT(bufferSizePtr != NULL);
+
+    if (*bufferSizePtr < seriesPtr->cborSize)
+    {
+        return LE_OVERFLOW;
+    }
+    bufLen = *bufferSizePtr;
+
+    // e.g. { "h" : ["/1000/0"], "f" : [1, 1], "s" : [_ ts, value, ts, value, ... ] }
+    *writePtr++ = CBOR_MAP_HEADER(NUM_TIME_SERIES_MAPS);
+    bufLen--;
+
+    ok = le_cbor_EncodeString(&writePtr, &bufLen, "h", 2) &&
+         le_cbor_EncodeArrayHeader(&writePtr, &bufLen, 1) &&
+         le_cbor_EncodeString(&writePtr, &bufLen, seriesPtr->headerId, HEADER_ID_NUMBYTES) &&
+         le_cbor_EncodeString(&writePtr, &bufLen, "f", 2) &&
+         le_cbor_EncodeArrayHeader(&writePtr, &bufLen, 2) &&
+         le_cbor_EncodeDouble(&writePtr, &bufLen, seriesPtr->timeStampFactor) &&
+         le_cbor_EncodeDouble(&writePtr, &bufLen, seriesPtr->factor) &&
+         le_cbor_EncodeString(&writePtr, &bufLen, "s", 2) &&
+         le_cbor_EncodeIndefArrayHeader(&writePtr, &bufLen);
+
+    memset(&state, 0, sizeof(state));
+    StartReader(&timeStampReader, &seriesPtr->timeStampColumn);
+    StartReader(&valueReader, &seriesPtr->valueColumn);
+
+    for (i = 0; ok && (i < seriesPtr->state.count); i++)
+    {
+        uint64_t utcMilliSec;
+
+        if (state.count == 0)
+        {
+            utcMilliSec = ReadBits(&timeStampReader, 64);
+        }
+        else
+        {
+            state.prevTimeStampDelta += ReadVarInt(&timeStampReader);
+            utcMilliSec = state.prevTimeStamp + (uint64_t)state.prevTimeStampDelta;
+        }
+
+        ok = le_cbor_EncodeInteger(&writePtr, &bufLen,
+                                   CborTimeStamp(seriesPtr, &state, utcMilliSec));
+        state.prevTimeStamp = utcMilliSec;
+
+        switch (seriesPtr->type)
+        {
+            case TIME_SERIES_TYPE_INT:
+            {
+                int32_t value;
+
+                if (state.count == 0)
+                {
+                    value = (int32_t)(uint32_t)ReadBits(&valueReader, 32);
+                }
+                else
+                {
+                    state.prevIntDelta += ReadVarInt(&valueReader);
+                    value = (int32_t)(state.prevInt + state.prevIntDelta);
+                }
+
+                ok = ok && le_cbor_EncodeInteger(&writePtr, &bufLen,
+                                                 CborIntValue(seriesPtr, &state, value));
+                state.prevInt = value;
+                break;
+            }
+
+            case TIME_SERIES_TYPE_BOOL:
+                ok = ok && le_cbor_EncodeBool(&writePtr, &bufLen, ReadBits(&valueReader, 1) == 1);
+                break;
+
+            case TIME_SERIES_TYPE_STRING:
+                if (ReadBits(&valueReader, 1) == 1)
+                {
+                    size_t strLen = (size_t)ReadBits(&valueReader, 8);
+                    size_t j;
+
+                    for (j = 0; j < strLen; j++)
+                    {
+                        strValue[j] = (char)ReadBits(&valueReader, 8);
+                    }
+                    strValue[strLen] = '\0';
+                }
+                ok = ok && le_cbor_EncodeString(&writePtr, &bufLen, strValue, sizeof(strValue));
+                break;
+
+            case TIME_SERIES_TYPE_FLOAT:
+            {
+                uint64_t bits;
+                double value;
+
+                if (state.count == 0)
+                {
+                    bits = ReadBits(&valueReader, 64);
+                }
+                else
+                {
+                    bits = ReadXorFloat(&valueReader, &state);
+                }
+                memcpy(&value, &bits, sizeof(value));
+
+                double delta = CborFloatValue(seriesPtr, &state, value);
+                if (IsCborDouble(seriesPtr))
+                {
+                    ok = ok && le_cbor_EncodeDouble(&writePtr, &bufLen, delta);
+                }
+                else
+                {
+                    ok = ok && le_cbor_EncodeInteger(&writePtr, &bufLen, (int64_t)delta);
+                }
+                state.prevFloatBits = bits;
+                break;
+            }
+        }
+
+        state.count++;
+    }
+
+    ok = ok && le_cbor_EncodeEndOfIndefArray(&writePtr, &bufLen);
+
+    if (!ok)
+    {
+        LE_ERROR("CBOR encoding error on %s.", seriesPtr->headerId);
+        return LE_FAULT;
+    }
+
+    *bufferSizePtr = writePtr - bufferPtr;
+    LE_ASSERT(*bufferSizePtr == seriesPtr->cborSize);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Init this sub-component
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_Init
+(
+    void
+)
+{
+    SeriesPoolRef = le_mem_CreatePool("TimeSeries pool", sizeof(Series_t));
+
+    // The chunk pool is allocated once and never grows, see ReserveBits().
+    ChunkPoolRef = le_mem_CreatePool("TimeSeries chunk pool", sizeof(Chunk_t));
+    le_mem_ExpandPool(ChunkPoolRef, TIME_SERIES_MAX_CHUNKS);
+}
@@ -0,0 +1,267 @@
+/**
+ * @file timeSeries.h
+ *
+ * Time Series Storage
+ *
+ * This interface provides a compact, columnar store for the history data accumulated on an asset
+ * data field while time series is enabled.  Each series keeps a timestamp column and a value
+ * column, both held as bit streams in fixed size chunks taken from a bounded memory pool:
+ *
+ *  - timestamps are stored as delta-of-delta values using variable length bit buckets,
+ *  - integer values are stored as delta-of-delta values using the same buckets,
+ *  - float values are XOR'ed with the previous value and only the meaningful bits are stored,
+ *  - boolean values take a single bit,
+ *  - string values take a single bit when unchanged, or a length byte followed by the string.
+ *
+ * The samples are only converted to the CBOR format expected by the AirVantage server
+ * (@c {"h":[...], "f":[...], "s":[...]}) when the series is pushed, see timeSeries_EncodeCbor().
+ * The size of that CBOR stream is tracked as samples are added so that it is guaranteed to fit in
+ * a push buffer of TIME_SERIES_MAX_CBOR_NUMBYTES bytes.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ *
+ */
+
+#ifndef LEGATO_TIME_SERIES_INCLUDE_GUARD
+#define LEGATO_TIME_SERIES_INCLUDE_GUARD
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes of the CBOR stream generated from a single time series.
+ */
+//--------------------------------------------------------------------------------------------------
+#define TIME_SERIES_MAX_CBOR_NUMBYTES 1024
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes in a single storage chunk of a time series column.
+ */
+//--------------------------------------------------------------------------------------------------
+#define TIME_SERIES_CHUNK_NUMBYTES 256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of storage chunks shared by all the time series.  This bounds the total amount of
+ * memory used for history data, i.e. TIME_SERIES_MAX_CHUNKS * TIME_SERIES_CHUNK_NUMBYTES.
+ */
+//--------------------------------------------------------------------------------------------------
+#define TIME_SERIES_MAX_CHUNKS 256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes for a string sample, including the terminating NUL.
+ */
+//--------------------------------------------------------------------------------------------------
+#define TIME_SERIES_STRING_NUMBYTES 256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Type of the values stored in a time series.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    TIME_SERIES_TYPE_INT,
+    TIME_SERIES_TYPE_BOOL,
+    TIME_SERIES_TYPE_STRING,
+    TIME_SERIES_TYPE_FLOAT
+}
+timeSeries_DataType_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a time series.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct timeSeries_Series* timeSeries_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a new, empty time series.
+ *
+ * @return
+ *      - Reference to the time series.
+ */
+//--------------------------------------------------------------------------------------------------
+timeSeries_Ref_t timeSeries_Create
+(
+    timeSeries_DataType_t type,     ///< [IN] Type of the recorded values
+    const char* headerIdPtr,        ///< [IN] Resource path put in the header, e.g. "/0/1"
+    double factor,                  ///< [IN] Multiplication factor used for delta encoding
+    double timeStampFactor          ///< [IN] Multiplication factor used for the time stamps
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a time series and give its storage chunks back to the pool.
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_Delete
+(
+    timeSeries_Ref_t seriesRef      ///< [IN] Time series
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discard all the samples of a time series, keeping its header and factors.
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_Reset
+(
+    timeSeries_Ref_t seriesRef      ///< [IN] Time series
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add an integer sample to a time series.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the time series is full.
+ *      - LE_NO_MEMORY if the sample was added but there may be no space for the next one.
+ *      - LE_FAULT if the time series does not record integers.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddInt
+(
+    timeSeries_Ref_t seriesRef,     ///< [IN] Time series
+    uint64_t utcMilliSec,           ///< [IN] Time stamp in milliseconds since epoch
+    int32_t value                   ///< [IN] Value
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a float sample to a time series.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the time series is full.
+ *      - LE_NO_MEMORY if the sample was added but there may be no space for the next one.
+ *      - LE_FAULT if the time series does not record floats.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddFloat
+(
+    timeSeries_Ref_t seriesRef,     ///< [IN] Time series
+    uint64_t utcMilliSec,           ///< [IN] Time stamp in milliseconds since epoch
+    double value                    ///< [IN] Value
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a boolean sample to a time series.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the time series is full.
+ *      - LE_NO_MEMORY if the sample was added but there may be no space for the next one.
+ *      - LE_FAULT if the time series does not record booleans.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddBool
+(
+    timeSeries_Ref_t seriesRef,     ///< [IN] Time series
+    uint64_t utcMilliSec,           ///< [IN] Time stamp in milliseconds since epoch
+    bool value                      ///< [IN] Value
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a string sample to a time series.  Strings longer than TIME_SERIES_STRING_NUMBYTES - 1 bytes
+ * are truncated.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the sample was NOT added as the time series is full.
+ *      - LE_NO_MEMORY if the sample was added but there may be no space for the next one.
+ *      - LE_FAULT if the time series does not record strings.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_AddString
+(
+    timeSeries_Ref_t seriesRef,     ///< [IN] Time series
+    uint64_t utcMilliSec,           ///< [IN] Time stamp in milliseconds since epoch
+    const char* valuePtr            ///< [IN] Value
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of samples recorded in a time series.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t timeSeries_GetCount
+(
+    timeSeries_Ref_t seriesRef      ///< [IN] Time series
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of bytes actually used by the compressed samples of a time series.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t timeSeries_GetStorageSize
+(
+    timeSeries_Ref_t seriesRef      ///< [IN] Time series
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the exact number of bytes of the CBOR stream timeSeries_EncodeCbor() would generate.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t timeSeries_GetCborSize
+(
+    timeSeries_Ref_t seriesRef      ///< [IN] Time series
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode the samples of a time series and write them to a buffer as a CBOR stream in the format
+ * expected by the AirVantage server.
+ *
+ * @return:
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the buffer is too small
+ *      - LE_FAULT on any other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t timeSeries_EncodeCbor
+(
+    timeSeries_Ref_t seriesRef,     ///< [IN] Time series
+    uint8_t* bufferPtr,             ///< [OUT] Buffer receiving the CBOR stream
+    size_t* bufferSizePtr           ///< [IN/OUT] Buffer size as input, stream size as output
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Init this sub-component
+ */
+//--------------------------------------------------------------------------------------------------
+void timeSeries_Init
+(
+    void
+);
+
+#endif // LEGATO_TIME_SERIES_INCLUDE_GUARD
@@ -107,6 +107,13 @@
 //--------------------------------------------------------------------------------------------------
 #define UNSOLICITED_POOL_SIZE 10
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited pattern trie nodes pool size
+ */
+//--------------------------------------------------------------------------------------------------
+#define UNSOL_NODE_POOL_SIZE  64
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Rx Buffer length
@@ -203,6 +210,7 @@ ClientState_t;
 typedef struct
 {
     char            line[LE_ATDEFS_RESPONSE_MAX_BYTES]; ///< string value
+    size_t          len;                                ///< string length
     le_dls_Link_t   link;                               ///< link for list
 }
 RspString_t;
@@ -219,6 +227,7 @@ typedef struct RxData
     int32_t  idx;                            ///< index of parsing the buffer
     size_t   endBuffer;                      ///< index where the read was finished (idx<endbuffer)
     int32_t  idxLastCrLf;                    ///< index where the last CRLF has been found
+    size_t   lineSize;                       ///< size of the line ending at the current CRLF
 }
 RxData_t;
 
@@ -250,22 +259,50 @@ RxParser_t;
  *
  */
 //--------------------------------------------------------------------------------------------------
-typedef struct
+typedef struct Unsolicited
 {
     le_atClient_UnsolicitedResponseHandlerFunc_t handlerPtr;    ///< Unsolicited handler
     void*         contextPtr;                                   ///< User context
     char          unsolRsp[LE_ATDEFS_UNSOLICITED_MAX_BYTES];    ///< pattern to match
+    size_t        unsolRspLen;                                  ///< pattern length
     char          unsolBuffer[LE_ATDEFS_UNSOLICITED_MAX_BYTES]; ///< Unsolicited buffer
+    size_t        unsolBufferLen;                               ///< Unsolicited buffer length
     uint32_t      lineCount;                                    ///< Unsolicited lines number
     uint32_t      lineCounter;                                  ///< Received line counter
     bool          inProgress;                                   ///< Reception in progress
     le_atClient_UnsolicitedResponseHandlerRef_t ref;            ///< Unsolicited reference
     DeviceContextPtr_t interfacePtr;                            ///< device context
     le_dls_Link_t link;                                         ///< link in Unsolicited List
+    le_dls_Link_t progressLink;                                 ///< link in reception in
+                                                                ///< progress list
+    uint32_t      order;                                        ///< rank in Unsolicited List
+    struct Unsolicited* nextMatchPtr;                           ///< next subscription with the
+                                                                ///< same pattern
+    struct Unsolicited* nextCandidatePtr;                       ///< next subscription to process
+                                                                ///< for the current line
+    bool          isCandidate;                                  ///< to process for current line
     le_msg_SessionRef_t sessionRef;                             ///< client session reference
 }
 Unsolicited_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsolicited pattern trie node.
+ *
+ * The patterns of the unsolicited responses subscribed on a device are compiled into a trie, so
+ * that a received line is compared to all of them in a single pass over its first characters. The
+ * children of a node are sorted by character.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct UnsolNode
+{
+    struct UnsolNode* childPtr;         ///< First child node
+    struct UnsolNode* siblingPtr;       ///< Next sibling node
+    Unsolicited_t*    unsolPtr;         ///< First subscription whose pattern ends on this node
+    char              character;        ///< Character leading to this node
+}
+UnsolNode_t;
+
 
 
 //--------------------------------------------------------------------------------------------------
@@ -283,6 +320,9 @@ typedef struct DeviceContext
     le_timer_Ref_t  timerRef;           ///< command timer
     le_dls_List_t   atCommandList;      ///< List of command waiting for execution
     le_dls_List_t   unsolicitedList;    ///< unsolicited command list
+    le_dls_List_t   unsolInProgressList;///< unsolicited responses being received
+    UnsolNode_t*    unsolTriePtr;       ///< compiled patterns of unsolicitedList
+    bool            isUnsolTrieStale;   ///< unsolicitedList changed since the trie was compiled
     le_sem_Ref_t    waitingSemaphore;   ///< semaphore used for synchronization
     le_atClient_DeviceRef_t ref;        ///< reference of the device context
     le_msg_SessionRef_t sessionRef;     ///< client session reference
@@ -347,6 +387,13 @@ static le_mem_PoolRef_t  RspStringPool;
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t  UnsolicitedPool;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for unsolicited pattern trie nodes
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t  UnsolNodePool;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Map for AT commands
@@ -381,71 +428,266 @@ static void UpdateTransitionManager(ClientStatePtr_t  parserStatePtr,
 static void SendLine(RxParserPtr_t charParserPtr);
 static void SendData(RxParserPtr_t charParserPtr);
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function releases an unsolicited pattern trie.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseUnsolTrie
+(
+    UnsolNode_t* nodePtr        ///< [IN] Root of the (sub-)trie to release
+)
+{
+    while (nodePtr != NULL)
+    {
+        UnsolNode_t* siblingPtr = nodePtr->siblingPtr;
+
+        ReleaseUnsolTrie(nodePtr->childPtr);
+        le_mem_Release(nodePtr);
+        nodePtr = siblingPtr;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function allocates an unsolicited pattern trie node.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static UnsolNode_t* NewUnsolNode
+(
+    char character      ///< [IN] Character leading to the node
+)
+{
+    UnsolNode_t* nodePtr = le_mem_ForceAlloc(UnsolNodePool);
+
+    memset(nodePtr, 0, sizeof(UnsolNode_t));
+    nodePtr->character = character;
+
+    return nodePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function looks for the child of a trie node reached with a given character.
+ *
+ * @return the child node, NULL if the character does not continue any pattern
+ */
+//--------------------------------------------------------------------------------------------------
+static inline UnsolNode_t* GetUnsolNodeChild
+(
+    const UnsolNode_t* nodePtr,     ///< [IN] Parent node
+    char               character    ///< [IN] Next character
+)
+{
+    UnsolNode_t* childPtr = nodePtr->childPtr;
+
+    while ((childPtr != NULL) && ((unsigned char) childPtr->character < (unsigned char) character))
+    {
+        childPtr = childPtr->siblingPtr;
+    }
+
+    if ((childPtr != NULL) && (childPtr->character == character))
+    {
+        return childPtr;
+    }
+
+    return NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function compiles the patterns of the subscribed unsolicited responses of a device into a
+ * trie. It must be called by the device thread.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void BuildUnsolTrie
+(
+    DeviceContext_t* interfacePtr       ///< [IN] Device context
+)
+{
+    le_dls_Link_t* linkPtr;
+    uint32_t order = 0;
+
+    ReleaseUnsolTrie(interfacePtr->unsolTriePtr);
+    interfacePtr->unsolTriePtr = NewUnsolNode('\0');
+    interfacePtr->isUnsolTrieStale = false;
+
+    for (linkPtr = le_dls_Peek(&interfacePtr->unsolicitedList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&interfacePtr->unsolicitedList, linkPtr))
+    {
+        Unsolicited_t* unsolPtr = CONTAINER_OF(linkPtr, Unsolicited_t, link);
+        UnsolNode_t* nodePtr = interfacePtr->unsolTriePtr;
+        Unsolicited_t** tailPtrPtr;
+        size_t i;
+
+        for (i = 0; i < unsolPtr->unsolRspLen; i++)
+        {
+            char character = unsolPtr->unsolRsp[i];
+            UnsolNode_t** childPtrPtr = &nodePtr->childPtr;
+
+            // Keep the children sorted by character
+            while ((*childPtrPtr != NULL) &&
+                   ((unsigned char) (*childPtrPtr)->character < (unsigned char) character))
+            {
+                childPtrPtr = &(*childPtrPtr)->siblingPtr;
+            }
+
+            if ((*childPtrPtr == NULL) || ((*childPtrPtr)->character != character))
+            {
+                UnsolNode_t* newNodePtr = NewUnsolNode(character);
+
+                newNodePtr->siblingPtr = *childPtrPtr;
+                *childPtrPtr = newNodePtr;
+            }
+
+            nodePtr = *childPtrPtr;
+        }
+
+        // Subscriptions with the same pattern are kept in subscription order
+        tailPtrPtr = &nodePtr->unsolPtr;
+        while (*tailPtrPtr != NULL)
+        {
+            tailPtrPtr = &(*tailPtrPtr)->nextMatchPtr;
+        }
+        *tailPtrPtr = unsolPtr;
+
+        unsolPtr->nextMatchPtr = NULL;
+        unsolPtr->order = order++;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function inserts a subscription in the list of subscriptions to process for a line, sorted
+ * by subscription order.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddUnsolCandidate
+(
+    Unsolicited_t** candidatePtrPtr,    ///< [IN/OUT] First subscription to process
+    Unsolicited_t*  unsolPtr            ///< [IN] Subscription to process
+)
+{
+    if (unsolPtr->isCandidate)
+    {
+        return;
+    }
+
+    while ((*candidatePtrPtr != NULL) && ((*candidatePtrPtr)->order < unsolPtr->order))
+    {
+        candidatePtrPtr = &(*candidatePtrPtr)->nextCandidatePtr;
+    }
+
+    unsolPtr->nextCandidatePtr = *candidatePtrPtr;
+    unsolPtr->isCandidate = true;
+    *candidatePtrPtr = unsolPtr;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function is used to check if the received data matches with a subscribed unsolicited
  * response.
  *
+ * The line is matched against the compiled patterns of the device, rebuilt first if the
+ * subscriptions changed. The matching subscriptions and those which are waiting for more lines are
+ * then processed in subscription order.
+ *
  */
 //--------------------------------------------------------------------------------------------------
 static void CheckUnsolicited
 (
-    char* unsolRspPtr,
-    size_t stringSize,
-    le_dls_List_t *unsolListPtr
+    DeviceContext_t* interfacePtr,      ///< [IN] Device context
+    const char*      unsolRspPtr,       ///< [IN] Received line
+    size_t           stringSize         ///< [IN] Received line size
 )
 {
-    LE_DEBUG("Start checking unsolicited");
+    Unsolicited_t* candidatePtr = NULL;
+    le_dls_Link_t* linkPtr;
+    UnsolNode_t* nodePtr;
+    size_t i;
 
-    le_dls_Link_t* linkPtr = le_dls_Peek(unsolListPtr);
+    if ((interfacePtr->unsolTriePtr == NULL) || (interfacePtr->isUnsolTrieStale))
+    {
+        BuildUnsolTrie(interfacePtr);
+    }
 
-    /* Browse all the queue while the string is not found */
-    while (linkPtr != NULL)
+    // Collect the subscriptions whose pattern is a prefix of the line
+    nodePtr = interfacePtr->unsolTriePtr;
+    for (i = 0; ; i++)
     {
-        Unsolicited_t *unsolPtr = CONTAINER_OF(linkPtr,
-                                               Unsolicited_t,
-                                                link);
+        Unsolicited_t* unsolPtr;
 
-        if ((strncmp(unsolPtr->unsolRsp,unsolRspPtr,strlen(unsolPtr->unsolRsp)) == 0) ||
-            (unsolPtr->inProgress))
+        for (unsolPtr = nodePtr->unsolPtr; unsolPtr != NULL; unsolPtr = unsolPtr->nextMatchPtr)
         {
-            LE_DEBUG("unsol found");
-            uint32_t len =
-                (stringSize < LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer)) ?
-                stringSize :
-                LE_ATDEFS_UNSOLICITED_MAX_LEN-strlen(unsolPtr->unsolBuffer);
+            AddUnsolCandidate(&candidatePtr, unsolPtr);
+        }
+
+        if ((i == stringSize) ||
+            ((nodePtr = GetUnsolNodeChild(nodePtr, unsolRspPtr[i])) == NULL))
+        {
+            break;
+        }
+    }
 
-            strncpy(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer), unsolRspPtr, len);
+    for (linkPtr = le_dls_Peek(&interfacePtr->unsolInProgressList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&interfacePtr->unsolInProgressList, linkPtr))
+    {
+        AddUnsolCandidate(&candidatePtr, CONTAINER_OF(linkPtr, Unsolicited_t, progressLink));
+    }
+
+    while (candidatePtr != NULL)
+    {
+        Unsolicited_t* unsolPtr = candidatePtr;
+        size_t len = LE_ATDEFS_UNSOLICITED_MAX_LEN - unsolPtr->unsolBufferLen;
 
+        candidatePtr = unsolPtr->nextCandidatePtr;
+        unsolPtr->nextCandidatePtr = NULL;
+        unsolPtr->isCandidate = false;
+
+        LE_DEBUG("unsol found");
+
+        if (stringSize < len)
+        {
+            len = stringSize;
+        }
+        memcpy(unsolPtr->unsolBuffer + unsolPtr->unsolBufferLen, unsolRspPtr, len);
+        unsolPtr->unsolBufferLen += len;
+        unsolPtr->unsolBuffer[unsolPtr->unsolBufferLen] = '\0';
+
+        if (!unsolPtr->inProgress)
+        {
             unsolPtr->inProgress = true;
+            le_dls_Queue(&interfacePtr->unsolInProgressList, &unsolPtr->progressLink);
         }
 
-        if (unsolPtr->inProgress)
+        if ( (unsolPtr->lineCount - unsolPtr->lineCounter) == 1 )
+        {
+            le_dls_Remove(&interfacePtr->unsolInProgressList, &unsolPtr->progressLink);
+            unsolPtr->lineCounter = 0;
+            unsolPtr->inProgress = false;
+
+            unsolPtr->handlerPtr(unsolPtr->unsolBuffer, unsolPtr->contextPtr);
+
+            unsolPtr->unsolBuffer[0] = '\0';
+            unsolPtr->unsolBufferLen = 0;
+        }
+        else
         {
-            if ( (unsolPtr->lineCount - unsolPtr->lineCounter) == 1 )
+            if (LE_ATDEFS_UNSOLICITED_MAX_BYTES - unsolPtr->unsolBufferLen > sizeof("\r\n"))
             {
-                unsolPtr->handlerPtr(unsolPtr->unsolBuffer, unsolPtr->contextPtr );
-                memset(unsolPtr->unsolBuffer,0,LE_ATDEFS_UNSOLICITED_MAX_BYTES);
-                unsolPtr->lineCounter = 0;
-                unsolPtr->inProgress = false;
+                memcpy(unsolPtr->unsolBuffer + unsolPtr->unsolBufferLen, "\r\n", sizeof("\r\n"));
+                unsolPtr->unsolBufferLen += sizeof("\r\n") - 1;
             }
-            else
-            {
-                if (LE_ATDEFS_UNSOLICITED_MAX_BYTES - strlen(unsolPtr->unsolBuffer) > sizeof("\r\n"))
-                {
-                    snprintf(unsolPtr->unsolBuffer+strlen(unsolPtr->unsolBuffer),
-                             sizeof("\r\n") + 1,    // +1 for Null terminator
-                             "\r\n" );
-                }
 
-                unsolPtr->lineCounter++;
-            }
+            unsolPtr->lineCounter++;
         }
-
-        linkPtr = le_dls_PeekNext(unsolListPtr, linkPtr);
     }
-
-    LE_DEBUG("Stop checking unsolicited");
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -641,7 +883,7 @@ static void RxNewData
         interfacePtr->rxParser.rxData.endBuffer += size;
 
         /* Call the parser */
-        LE_DEBUG("Parsing received data: %s", interfacePtr->rxParser.rxData.buffer);
+        LE_DEBUG("Parsing %zd received bytes", size);
         ParseRxBuffer(&interfacePtr->rxParser);
         ResetRxBuffer(&interfacePtr->rxParser);
     }
@@ -676,6 +918,9 @@ static void DestroyDeviceThread
         le_mem_Release(unsolPtr);
     }
 
+    ReleaseUnsolTrie(interfacePtr->unsolTriePtr);
+    interfacePtr->unsolTriePtr = NULL;
+
     while ((linkPtr=le_dls_Pop(&interfacePtr->atCommandList)) != NULL)
     {
         AtCmd_t* atCmdPtr = CONTAINER_OF(linkPtr, AtCmd_t, link);
@@ -861,11 +1106,12 @@ static bool CheckResponse
     }
 
     le_dls_Link_t* linkPtr = le_dls_Peek(responseListPtr);
+    size_t cmdNameLen = strlen(cmdNamePtr);
 
-    LE_DEBUG("Command: %s, size: %"PRIuS, cmdNamePtr, strlen(cmdNamePtr));
-    LE_DEBUG("Received response: %s, size: %"PRIuS, receivedRspPtr, lineSize);
+    LE_DEBUG("Command: %s, size: %"PRIuS, cmdNamePtr, cmdNameLen);
+    LE_DEBUG("Received response size: %"PRIuS, lineSize);
 
-    if (strncmp(cmdNamePtr, receivedRspPtr, strlen(cmdNamePtr)) == 0)
+    if (strncmp(cmdNamePtr, receivedRspPtr, cmdNameLen) == 0)
     {
         LE_DEBUG("Found command echo in response");
         return false;
@@ -877,25 +1123,24 @@ static bool CheckResponse
         RspString_t* currStringPtr = CONTAINER_OF(linkPtr,
                                                   RspString_t,
                                                   link);
-        LE_DEBUG("Item: %s, size: %"PRIuS, currStringPtr->line, strlen(currStringPtr->line));
-
-        if ((strlen(currStringPtr->line) == 0) ||
-           ((lineSize >= strlen(currStringPtr->line)) &&
-           (strncmp(currStringPtr->line, receivedRspPtr, strlen(currStringPtr->line)) == 0)))
+        if ((currStringPtr->len == 0) ||
+           ((lineSize >= currStringPtr->len) &&
+           (memcmp(currStringPtr->line, receivedRspPtr, currStringPtr->len) == 0)))
         {
             LE_DEBUG("Rsp matched, size: %zu", lineSize);
 
             RspString_t* newStringPtr = le_mem_ForceAlloc(RspStringPool);
             memset(newStringPtr, 0, sizeof(RspString_t));
 
-            if(lineSize>LE_ATDEFS_RESPONSE_MAX_BYTES)
+            if(lineSize>=LE_ATDEFS_RESPONSE_MAX_BYTES)
             {
                 LE_ERROR("String too long");
                 le_mem_Release(newStringPtr);
                 return false;
             }
 
-            strncpy(newStringPtr->line, receivedRspPtr, lineSize);
+            memcpy(newStringPtr->line, receivedRspPtr, lineSize);
+            newStringPtr->len = lineSize;
             newStringPtr->link = LE_DLS_LINK_INIT;
             le_dls_Queue(resultListPtr, &(newStringPtr->link));
             return true;
@@ -956,11 +1201,7 @@ static void SendingState
         {
             RxData_t* parserPtr = &interfacePtr->rxParser.rxData;
 
-            //~CheckUnsolicited(smRef,
-                             //~smRef->curContext.atLine,
-                             //~strlen(smRef->curContext.atLine));
-            int32_t newCRLF = parserPtr->idx-2;
-            size_t lineSize = newCRLF - parserPtr->idxLastCrLf;
+            size_t lineSize = parserPtr->lineSize;
 
             if (CheckResponse((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]), lineSize,
                               &(cmdPtr->expectResponseList), &(cmdPtr->responseList),
@@ -1047,12 +1288,9 @@ static void WaitingState
         {
             RxData_t* parserPtr = &interfacePtr->rxParser.rxData;
 
-            int32_t newCRLF = parserPtr->idx-2;
-            size_t lineSize = newCRLF - parserPtr->idxLastCrLf;
-
-            CheckUnsolicited((char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]),
-                              lineSize,
-                              &interfacePtr->unsolicitedList);
+            CheckUnsolicited(interfacePtr,
+                             (char*)&(parserPtr->buffer[parserPtr->idxLastCrLf]),
+                             parserPtr->lineSize);
             break;
         }
         default:
@@ -1175,6 +1413,9 @@ static void SendLine
 {
     ClientStatePtr_t clientStatePtr = &rxParserPtr->interfacePtr->clientState;
 
+    // The line starts after the previous CRLF and ends before the current one
+    rxParserPtr->rxData.lineSize = rxParserPtr->rxData.idx - 2 - rxParserPtr->rxData.idxLastCrLf;
+
     (clientStatePtr->curState)(clientStatePtr,EVENT_PROCESSLINE);
 
     rxParserPtr->rxData.idxLastCrLf = rxParserPtr->rxData.idx;
@@ -1294,6 +1535,14 @@ static void UnsolicitedPoolDestructor
         le_dls_Remove(listPtr, linkPtr);
     }
 
+    if (unsolicitedPtr->inProgress)
+    {
+        le_dls_Remove(&unsolicitedPtr->interfacePtr->unsolInProgressList,
+                      &unsolicitedPtr->progressLink);
+    }
+
+    unsolicitedPtr->interfacePtr->isUnsolTrieStale = true;
+
     // Delete the reference for unsolicited structure pointer.
     le_ref_DeleteRef(UnsolRefMap, unsolicitedPtr->ref);
 }
@@ -1533,7 +1782,8 @@ le_result_t le_atClient_SetIntermediateResponse
             RspString_t* newStringPtr = le_mem_ForceAlloc(RspStringPool);
             memset(newStringPtr, 0, sizeof(RspString_t));
 
-            le_utf8_Copy(newStringPtr->line, interPtr, LE_ATDEFS_RESPONSE_MAX_BYTES, NULL);
+            le_utf8_Copy(newStringPtr->line, interPtr, LE_ATDEFS_RESPONSE_MAX_BYTES,
+                         &newStringPtr->len);
 
             newStringPtr->link = LE_DLS_LINK_INIT;
 
@@ -1604,7 +1854,8 @@ le_result_t le_atClient_SetFinalResponse
             RspString_t* newStringPtr = le_mem_ForceAlloc(RspStringPool);
             memset(newStringPtr,0,sizeof(RspString_t));
 
-            le_utf8_Copy(newStringPtr->line,respPtr,LE_ATDEFS_RESPONSE_MAX_BYTES, NULL);
+            le_utf8_Copy(newStringPtr->line,respPtr,LE_ATDEFS_RESPONSE_MAX_BYTES,
+                         &newStringPtr->len);
 
             newStringPtr->link = LE_DLS_LINK_INIT;
 
@@ -2044,7 +2295,8 @@ le_atClient_UnsolicitedResponseHandlerRef_t le_atClient_AddUnsolicitedResponseHa
     Unsolicited_t* unsolicitedPtr = le_mem_ForceAlloc(UnsolicitedPool);
 
     memset(unsolicitedPtr, 0 ,sizeof(Unsolicited_t));
-    le_utf8_Copy(unsolicitedPtr->unsolRsp, unsolRsp, LE_ATDEFS_UNSOLICITED_MAX_BYTES, NULL);
+    le_utf8_Copy(unsolicitedPtr->unsolRsp, unsolRsp, LE_ATDEFS_UNSOLICITED_MAX_BYTES,
+                 &unsolicitedPtr->unsolRspLen);
     unsolicitedPtr->lineCount    = lineCount;
     unsolicitedPtr->handlerPtr = handlerPtr;
     unsolicitedPtr->contextPtr = contextPtr;
@@ -2052,10 +2304,14 @@ le_atClient_UnsolicitedResponseHandlerRef_t le_atClient_AddUnsolicitedResponseHa
     unsolicitedPtr->ref = le_ref_CreateRef(UnsolRefMap, unsolicitedPtr);
     unsolicitedPtr->interfacePtr = interfacePtr;
     unsolicitedPtr->link = LE_DLS_LINK_INIT;
+    unsolicitedPtr->progressLink = LE_DLS_LINK_INIT;
     unsolicitedPtr->sessionRef = le_atClient_GetClientSessionRef();
 
     le_dls_Queue(&interfacePtr->unsolicitedList, &unsolicitedPtr->link);
 
+    // The patterns are compiled again by the device thread when the next line is received
+    interfacePtr->isUnsolTrieStale = true;
+
     return unsolicitedPtr->ref;
 }
 
@@ -2248,6 +2504,9 @@ COMPONENT_INIT
     UnsolicitedPool = le_mem_CreatePool("AtUnsolicitedPool",sizeof(Unsolicited_t));
     le_mem_ExpandPool(UnsolicitedPool,UNSOLICITED_POOL_SIZE);
     le_mem_SetDestructor(UnsolicitedPool,UnsolicitedPoolDestructor);
+
+    UnsolNodePool = le_mem_CreatePool("AtUnsolNodePool",sizeof(UnsolNode_t));
+    le_mem_ExpandPool(UnsolNodePool,UNSOL_NODE_POOL_SIZE);
     UnsolRefMap = le_ref_CreateMap("UnsolRefMap", UNSOLICITED_POOL_SIZE);
 
     // Add a handler to the close session service
@@ -15,7 +15,7 @@
 #include "pa_audio.h"
 #include "pa_amr.h"
 #include "pa_pcm.h"
-#include <math.h>
+#include "pcmDsp.h"
 
 //--------------------------------------------------------------------------------------------------
 // Symbol and Enum definitions.
@@ -35,9 +35,6 @@
 //--------------------------------------------------------------------------------------------------
 #define SAMPLE_SCALE    (32767)
 #define DTMF_AMPLITUDE  (40)
-#if !defined (PI)
-#define PI 3.14159265358979323846264338327
-#endif
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -168,125 +165,6 @@ static le_mem_PoolRef_t PcmThreadContextPool;
 //--------------------------------------------------------------------------------------------------
 static le_pm_WakeupSourceRef_t MediaWakeLock;
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Reads a specified number of bytes from the provided file descriptor into the provided buffer.
- * This function will block until the specified number of bytes is read or an EOF is reached.
- *
- * @return
- *      Number of bytes read.
- *      LE_FAULT if there is an error.
- */
-//--------------------------------------------------------------------------------------------------
-static ssize_t ReadFd
-(
-    int fd,                               ///<[IN] File to read.
-    void* bufPtr,                         ///<[OUT] Buffer to store the read bytes in.
-    size_t bufSize                        ///<[IN] Size of the buffer.
-)
-{
-    LE_FATAL_IF(bufPtr == NULL, "Supplied NULL string pointer");
-    LE_FATAL_IF(fd < 0, "Supplied invalid file descriptor");
-
-    int bytesRd = 0, tempBufSize = 0, rdReq = bufSize;
-    char *tempStr;
-
-    // Requested zero bytes to read, return immediately
-    if (bufSize == 0)
-    {
-        return tempBufSize;
-    }
-
-    do
-    {
-        tempStr = (char *)(bufPtr);
-        tempStr = tempStr + tempBufSize;
-
-        bytesRd = read(fd, tempStr, rdReq);
-
-        if ((bytesRd < 0) && (errno != EINTR) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
-        {
-            LE_ERROR("Error while reading file, errno: %d (%m)", errno);
-            return bytesRd;
-        }
-        else
-        {
-            //Reached End of file, so return what it reads upto EOF
-            if (bytesRd == 0)
-            {
-                return tempBufSize;
-            }
-
-            tempBufSize += bytesRd;
-
-            if (tempBufSize < bufSize)
-            {
-                rdReq = bufSize - tempBufSize;
-            }
-        }
-    }
-    while (tempBufSize < bufSize);
-
-    return tempBufSize;
-}
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Writes a specified number of bytes from the provided buffer to the provided file descriptor.
- * This function will block until the specified number of bytes is written.
- *
- * @return
- *      Number of bytes written.
- *      LE_FAULT if there is an error.
- */
-//--------------------------------------------------------------------------------------------------
-static ssize_t WriteFd
-(
-    int fd,                               ///<[IN] File to write.
-    void* bufPtr,                         ///<[IN] Buffer which will be written to file.
-    size_t bufSize                        ///<[IN] Size of the buffer.
-)
-{
-    LE_FATAL_IF(bufPtr == NULL, "Supplied NULL String Pointer");
-    LE_FATAL_IF(fd < 0, "Supplied invalid file descriptor");
-
-    int bytesWr = 0, tempBufSize = 0, wrReq = bufSize;
-    char *tempStr;
-
-    // Requested zero bytes to write, returns immediately
-    if (bufSize == 0)
-    {
-        return tempBufSize;
-    }
-
-    do
-    {
-        tempStr = (char *)(bufPtr);
-        tempStr = tempStr + tempBufSize;
-
-        bytesWr= write(fd, tempStr, wrReq);
-
-        if ((bytesWr < 0) && (errno != EINTR))
-        {
-            LE_ERROR("Error while writing file, errno: %d (%m)", errno);
-            return bytesWr;
-        }
-        else
-        {
-            tempBufSize += bytesWr;
-
-            if(tempBufSize < bufSize)
-            {
-                wrReq = bufSize - tempBufSize;
-            }
-        }
-    }
-    while (tempBufSize < bufSize);
-
-    return tempBufSize;
-}
-
 //--------------------------------------------------------------------------------------------------
 /**
  *  Return the low frequency component of a DTMF character.
@@ -381,34 +259,6 @@ static inline uint32_t Digit2HighFreq
     }
 }
 
-//--------------------------------------------------------------------------------------------------
-/**
- *  Add two 16-bit values.
- *
- */
-//--------------------------------------------------------------------------------------------------
-static inline int16_t SaturateAdd16
-(
-    int32_t a,
-    int32_t b
-)
-{
-    int32_t tot=a+b;
-
-    if (tot > 32767)
-    {
-        return 32767;
-    }
-    else if (tot < -32768)
-    {
-        return -32768;
-    }
-    else
-    {
-        return (tot & 0xFFFF);
-    }
-}
-
 //--------------------------------------------------------------------------------------------------
 /**
  *  Play Tone function. This function split into samples of 1s. To play a DTMF or a PAUSE for a
@@ -423,18 +273,12 @@ static le_result_t PlayTone
     uint32_t*                      bufferLenPtr  ///< [OUT] Length of the buffer
 )
 {
-    double   d1, d2;
-    uint32_t i;
-
     DtmfParams_t*  dtmfParamsPtr = (DtmfParams_t*) mediaCtxPtr->codecParams;
     // Max samples on the whole duration
     uint32_t samplesCount;
     // Sample count until the next second
     uint32_t sampleOneSecond = dtmfParamsPtr->sampleRate + dtmfParamsPtr->currentSampleCount;
-    uint32_t freq1;
-    uint32_t freq2;
-    int32_t  amp1;
-    int32_t  amp2;
+    pcmDsp_Osc_t oscillators[2];
     int16_t* dataPtr = (int16_t*) bufferOutPtr;
     // Length of the current sample: max 1 second, i.e, sampleRate
     uint32_t sampleLength;
@@ -488,28 +332,28 @@ static le_result_t PlayTone
                  dtmfParamsPtr->dtmf[dtmfParamsPtr->currentDtmf],
                  sampleOneSecond, dtmfParamsPtr->currentSampleCount, sampleLength);
 
-        freq1 = Digit2LowFreq(dtmfParamsPtr->dtmf[dtmfParamsPtr->currentDtmf]);
-        freq2 = Digit2HighFreq(dtmfParamsPtr->dtmf[dtmfParamsPtr->currentDtmf]);
-        amp1 = DTMF_AMPLITUDE;
-        amp2 = DTMF_AMPLITUDE;
+        // The oscillators restart from the current sample count, so that the DTMF is continuous
+        // across the calls
+        pcmDsp_InitOsc(&oscillators[0],
+                       Digit2LowFreq(dtmfParamsPtr->dtmf[dtmfParamsPtr->currentDtmf]),
+                       dtmfParamsPtr->sampleRate,
+                       SAMPLE_SCALE * DTMF_AMPLITUDE / 100.0,
+                       dtmfParamsPtr->currentSampleCount);
+        pcmDsp_InitOsc(&oscillators[1],
+                       Digit2HighFreq(dtmfParamsPtr->dtmf[dtmfParamsPtr->currentDtmf]),
+                       dtmfParamsPtr->sampleRate,
+                       SAMPLE_SCALE * DTMF_AMPLITUDE / 100.0,
+                       dtmfParamsPtr->currentSampleCount);
+
+        // Play max sampleRate (1s) of DTMF and continue at next call
+        pcmDsp_GenerateTones(oscillators, NUM_ARRAY_MEMBERS(oscillators), dataPtr, sampleLength);
 
-        d1 = 1.0f * freq1 / dtmfParamsPtr->sampleRate;
-        d2 = 1.0f * freq2 / dtmfParamsPtr->sampleRate;
-
-        for (i = dtmfParamsPtr->currentSampleCount;
-             // Play max sampleRate (1s) of DTMF and continue at next call
-             (i < sampleOneSecond) && (i < samplesCount);
-             i++)
+        // Save the current sample count. If the whole DTMF is played, reset to 0
+        dtmfParamsPtr->currentSampleCount += sampleLength;
+        if (dtmfParamsPtr->currentSampleCount == samplesCount)
         {
-            int16_t s1, s2;
-
-            s1 = (int16_t)(SAMPLE_SCALE * amp1 / 100.0f * sin(2 * PI * d1 * i));
-            s2 = (int16_t)(SAMPLE_SCALE * amp2 / 100.0f * sin(2 * PI * d2 * i));
-            *(dataPtr++) = SaturateAdd16(s1, s2);
+            dtmfParamsPtr->currentSampleCount = 0;
         }
-
-        // Save the current sample count. If the whole DTMF is played, reset to 0
-        dtmfParamsPtr->currentSampleCount = (i == samplesCount ? 0 : i);
         if (0 == dtmfParamsPtr->currentSampleCount)
         {
             // Update the index of DTMF if the current sample count is reset to 0
@@ -559,7 +403,7 @@ static le_result_t SetWavHeader
     hdr.dataId = ID_DATA;
     hdr.dataSize = 0;
     hdr.riffSize = hdr.dataSize + 44 - 8;
-    if (WriteFd(fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+    if (pcmDsp_WriteFd(fd, &hdr, sizeof(hdr)) != sizeof(hdr))
     {
         LE_ERROR("Cannot write wave header");
         return LE_FAULT;
@@ -586,7 +430,7 @@ static le_result_t MediaReadFd
     uint32_t*                      readLenPtr    ///< [OUT] Length of the read data
 )
 {
-    ssize_t size = ReadFd(mediaCtxPtr->fd_in, bufferOutPtr, mediaCtxPtr->bufferSize);
+    ssize_t size = pcmDsp_ReadFd(mediaCtxPtr->fd_in, bufferOutPtr, mediaCtxPtr->bufferSize);
 
     if (size < 0)
     {
@@ -612,7 +456,7 @@ static le_result_t MediaWriteFd
     uint32_t                       bufferLen        ///< [IN] Buffer length
 )
 {
-    if (WriteFd(mediaCtxPtr->fd_out, bufferInPtr, bufferLen) < 0)
+    if (pcmDsp_WriteFd(mediaCtxPtr->fd_out, bufferInPtr, bufferLen) < 0)
     {
         return LE_FAULT;
     }
@@ -643,7 +487,7 @@ static le_result_t AmrWriteFd
                             outputBuf,
                             &outputBufLen) == LE_OK)
     {
-        int32_t writeLen = WriteFd( mediaCtxPtr->fd_out, outputBuf, outputBufLen );
+        int32_t writeLen = pcmDsp_WriteFd( mediaCtxPtr->fd_out, outputBuf, outputBufLen );
 
         if (writeLen != outputBufLen)
         {
@@ -680,7 +524,7 @@ static le_result_t WavWriteFd
     // header
     pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &oldstate);
 
-    int32_t len = WriteFd(mediaCtxPtr->fd_out, bufferInPtr, bufferLen);
+    int32_t len = pcmDsp_WriteFd(mediaCtxPtr->fd_out, bufferInPtr, bufferLen);
 
     if (len != bufferLen)
     {
@@ -693,7 +537,7 @@ static le_result_t WavWriteFd
 
     lseek(mediaCtxPtr->fd_out, ((uint8_t*)&hdr.dataSize - (uint8_t*)&hdr), SEEK_SET);
 
-    len = WriteFd(mediaCtxPtr->fd_out,
+    len = pcmDsp_WriteFd(mediaCtxPtr->fd_out,
                 &wavParamPtr->recordingSize,
                 sizeof(wavParamPtr->recordingSize));
 
@@ -708,7 +552,7 @@ static le_result_t WavWriteFd
 
     uint32_t riffSize = wavParamPtr->recordingSize + 44 - 8;
 
-    len = WriteFd(mediaCtxPtr->fd_out, &riffSize, sizeof(riffSize));
+    len = pcmDsp_WriteFd(mediaCtxPtr->fd_out, &riffSize, sizeof(riffSize));
 
     if (len != sizeof(riffSize))
     {
@@ -760,7 +604,7 @@ static le_result_t InitPlayWavFile
         return LE_FAULT;
     }
 
-    mediaCtxPtr->bufferSize = PIPE_BUF/4;
+    mediaCtxPtr->bufferSize = PCMDSP_IO_BLOCK_BYTES;
 
     return LE_OK;
 }
@@ -1007,7 +851,7 @@ static le_result_t PlayWavFile
 {
     WavHeader_t      hdr;
 
-    if (ReadFd(streamPtr->fd, &hdr, sizeof(hdr)) != sizeof(hdr))
+    if (pcmDsp_ReadFd(streamPtr->fd, &hdr, sizeof(hdr)) != sizeof(hdr))
     {
         LE_WARN("WAV detection: cannot read header");
         return LE_FAULT;
@@ -1312,7 +1156,7 @@ static le_result_t PlayCaptControl
 
                 while (len > 0)
                 {
-                    len = ReadFd(pcmContextPtr->fd, data, sizeof(data));
+                    len = pcmDsp_ReadFd(pcmContextPtr->fd, data, sizeof(data));
                 }
 
                 if (fcntl(pcmContextPtr->fd, F_SETFL, mask) == -1)
@@ -1535,7 +1379,7 @@ static le_result_t SetCaptureFrames
 
     if ( !pcmContextPtr->pause )
     {
-        if (WriteFd(pcmContextPtr->fd, bufferPtr, *bufsizePtr) < 0)
+        if (pcmDsp_WriteFd(pcmContextPtr->fd, bufferPtr, *bufsizePtr) < 0)
         {
             LE_ERROR("Cannot write on pipe");
             return LE_FAULT;
@@ -0,0 +1,402 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file pcmDsp.c
+ *
+ * This file contains the PCM signal processing kernels used by the media playback and capture.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "pcmDsp.h"
+#include <math.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// Symbol and Enum definitions.
+//--------------------------------------------------------------------------------------------------
+
+#if !defined (PI)
+#define PI 3.14159265358979323846264338327
+#endif
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum gain, so that the product of a sample and the gain fits in 32 bits.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GAIN_MAX        UINT16_MAX
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of fractional bits of the gains.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GAIN_SHIFT      12
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of fractional bits of the sample rate converter positions.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RESAMPLER_SHIFT 16
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Saturate a value to 16 bits.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static inline int16_t Saturate16
+(
+    int32_t value
+)
+{
+    if (value > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    else if (value < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+
+    return value;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a sine oscillator, so that the next generated sample is
+ * amplitude.sin(2.pi.freq.startIdx / sampleRate).
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmDsp_InitOsc
+(
+    pcmDsp_Osc_t* oscPtr,       ///< [OUT] Oscillator
+    uint32_t      freq,         ///< [IN] Frequency in Hertz
+    uint32_t      sampleRate,   ///< [IN] Sample frequency in Hertz
+    double        amplitude,    ///< [IN] Peak amplitude
+    uint32_t      startIdx      ///< [IN] Index of the next sample
+)
+{
+    double w = 2 * PI * freq / sampleRate;
+    // Reduce the phase of the start sample to one period to keep the initial state accurate
+    double phase = 2 * PI * (((uint64_t)freq * startIdx) % sampleRate) / sampleRate;
+
+    oscPtr->coef = 2 * cos(w);
+    oscPtr->y1 = amplitude * sin(phase - w);
+    oscPtr->y2 = amplitude * sin(phase - 2 * w);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generate the sum of the outputs of some oscillators, saturated to 16 bits.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmDsp_GenerateTones
+(
+    pcmDsp_Osc_t* oscPtr,       ///< [IN/OUT] Oscillators
+    size_t        oscCount,     ///< [IN] Number of oscillators
+    int16_t*      samplesPtr,   ///< [OUT] Samples
+    size_t        count         ///< [IN] Number of samples to generate
+)
+{
+    size_t i, j;
+
+    if (0 == oscCount)
+    {
+        memset(samplesPtr, 0, count * sizeof(int16_t));
+        return;
+    }
+
+    // The dual tones are interleaved, their recurrences being independent
+    if (2 == oscCount)
+    {
+        double c1 = oscPtr[0].coef, y11 = oscPtr[0].y1, y12 = oscPtr[0].y2;
+        double c2 = oscPtr[1].coef, y21 = oscPtr[1].y1, y22 = oscPtr[1].y2;
+
+        for (i = 0; i < count; i++)
+        {
+            double s1 = c1 * y11 - y12;
+            double s2 = c2 * y21 - y22;
+
+            y12 = y11;
+            y11 = s1;
+            y22 = y21;
+            y21 = s2;
+
+            samplesPtr[i] = Saturate16((int32_t)(s1 + s2));
+        }
+
+        oscPtr[0].y1 = y11;
+        oscPtr[0].y2 = y12;
+        oscPtr[1].y1 = y21;
+        oscPtr[1].y2 = y22;
+        return;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        double sum = 0;
+
+        for (j = 0; j < oscCount; j++)
+        {
+            double s = oscPtr[j].coef * oscPtr[j].y1 - oscPtr[j].y2;
+
+            oscPtr[j].y2 = oscPtr[j].y1;
+            oscPtr[j].y1 = s;
+            sum += s;
+        }
+
+        samplesPtr[i] = Saturate16((int32_t)sum);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mix some samples into a buffer, with saturation.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmDsp_Mix
+(
+    int16_t*       dstPtr,      ///< [IN/OUT] Samples to mix into
+    const int16_t* srcPtr,      ///< [IN] Samples to add
+    size_t         count        ///< [IN] Number of samples
+)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)(dstPtr + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(srcPtr + i));
+
+        _mm_storeu_si128((__m128i*)(dstPtr + i), _mm_adds_epi16(a, b));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 8 <= count; i += 8)
+    {
+        vst1q_s16(dstPtr + i, vqaddq_s16(vld1q_s16(dstPtr + i), vld1q_s16(srcPtr + i)));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        dstPtr[i] = Saturate16((int32_t)dstPtr[i] + srcPtr[i]);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply a gain to some samples, with saturation.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmDsp_ApplyGain
+(
+    int16_t* samplesPtr,        ///< [IN/OUT] Samples
+    size_t   count,             ///< [IN] Number of samples
+    uint32_t gain               ///< [IN] Gain, PCMDSP_GAIN_UNITY being the unity gain
+)
+{
+    int32_t g = (gain > GAIN_MAX) ? GAIN_MAX : (int32_t)gain;
+    size_t i;
+
+    if (PCMDSP_GAIN_UNITY == gain)
+    {
+        return;
+    }
+
+    // Written without branches so that it can be vectorized by the compiler
+    for (i = 0; i < count; i++)
+    {
+        int32_t value = (samplesPtr[i] * g + (PCMDSP_GAIN_UNITY / 2)) >> GAIN_SHIFT;
+
+        value = (value > INT16_MAX) ? INT16_MAX : value;
+        value = (value < INT16_MIN) ? INT16_MIN : value;
+        samplesPtr[i] = value;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a sample rate converter.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmDsp_InitResampler
+(
+    pcmDsp_Resampler_t* resamplerPtr,   ///< [OUT] Sample rate converter
+    uint32_t            inRate,         ///< [IN] Input sample frequency in Hertz
+    uint32_t            outRate         ///< [IN] Output sample frequency in Hertz
+)
+{
+    LE_ASSERT(inRate && outRate);
+
+    resamplerPtr->step = ((uint64_t)inRate << RESAMPLER_SHIFT) / outRate;
+    // The first output sample is the first input sample
+    resamplerPtr->phase = 1 << RESAMPLER_SHIFT;
+    resamplerPtr->prevSample = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of samples produced by the conversion of a block.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t pcmDsp_GetResampledMax
+(
+    const pcmDsp_Resampler_t* resamplerPtr, ///< [IN] Sample rate converter
+    size_t                    inCount       ///< [IN] Number of input samples
+)
+{
+    uint64_t end = (uint64_t)inCount << RESAMPLER_SHIFT;
+
+    if (end <= resamplerPtr->phase)
+    {
+        return 0;
+    }
+
+    return (end - resamplerPtr->phase + resamplerPtr->step - 1) / resamplerPtr->step;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a block of samples. The whole block is consumed, the output buffer must be able to hold
+ * pcmDsp_GetResampledMax() samples.
+ *
+ * @return Number of output samples
+ */
+//--------------------------------------------------------------------------------------------------
+size_t pcmDsp_Resample
+(
+    pcmDsp_Resampler_t* resamplerPtr,   ///< [IN/OUT] Sample rate converter
+    const int16_t*      inPtr,          ///< [IN] Input samples
+    size_t              inCount,        ///< [IN] Number of input samples
+    int16_t*            outPtr          ///< [OUT] Output samples
+)
+{
+    uint64_t end = (uint64_t)inCount << RESAMPLER_SHIFT;
+    uint64_t pos = resamplerPtr->phase;
+    size_t outCount = 0;
+
+    if (0 == inCount)
+    {
+        return 0;
+    }
+
+    // Position 0 is the last sample of the previous block, position n the input sample n-1
+    while (pos < end)
+    {
+        size_t idx = pos >> RESAMPLER_SHIFT;
+        int32_t frac = (pos & ((1 << RESAMPLER_SHIFT) - 1)) >> 1;
+        int32_t a = idx ? inPtr[idx - 1] : resamplerPtr->prevSample;
+        int32_t b = inPtr[idx];
+
+        outPtr[outCount++] = a + (((b - a) * frac) >> (RESAMPLER_SHIFT - 1));
+        pos += resamplerPtr->step;
+    }
+
+    resamplerPtr->prevSample = inPtr[inCount - 1];
+    resamplerPtr->phase = pos - end;
+
+    return outCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a block from a file descriptor. This function blocks until the whole block is read, the
+ * end of file is reached or, for a non-blocking file descriptor, no more data is available.
+ *
+ * @return
+ *      - Number of bytes read
+ *      - -1 on error
+ */
+//--------------------------------------------------------------------------------------------------
+ssize_t pcmDsp_ReadFd
+(
+    int    fd,                  ///< [IN] File descriptor
+    void*  bufPtr,              ///< [OUT] Buffer
+    size_t bufSize              ///< [IN] Number of bytes to read
+)
+{
+    size_t readSize = 0;
+
+    LE_FATAL_IF(bufPtr == NULL, "Supplied NULL string pointer");
+    LE_FATAL_IF(fd < 0, "Supplied invalid file descriptor");
+
+    while (readSize < bufSize)
+    {
+        ssize_t count = read(fd, (uint8_t*)bufPtr + readSize, bufSize - readSize);
+
+        if (count > 0)
+        {
+            readSize += count;
+        }
+        else if (0 == count)
+        {
+            // End of file, return what was read
+            break;
+        }
+        else if (EINTR == errno)
+        {
+            continue;
+        }
+        else if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+        {
+            // No more data on a non-blocking file descriptor
+            break;
+        }
+        else
+        {
+            LE_ERROR("Error while reading file, errno: %d (%m)", errno);
+            return -1;
+        }
+    }
+
+    return readSize;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a block to a file descriptor. This function blocks until the whole block is written.
+ *
+ * @return
+ *      - Number of bytes written
+ *      - -1 on error
+ */
+//--------------------------------------------------------------------------------------------------
+ssize_t pcmDsp_WriteFd
+(
+    int         fd,             ///< [IN] File descriptor
+    const void* bufPtr,         ///< [IN] Buffer
+    size_t      bufSize         ///< [IN] Number of bytes to write
+)
+{
+    size_t writtenSize = 0;
+
+    LE_FATAL_IF(bufPtr == NULL, "Supplied NULL String Pointer");
+    LE_FATAL_IF(fd < 0, "Supplied invalid file descriptor");
+
+    while (writtenSize < bufSize)
+    {
+        ssize_t count = write(fd, (const uint8_t*)bufPtr + writtenSize, bufSize - writtenSize);
+
+        if (count >= 0)
+        {
+            writtenSize += count;
+        }
+        else if (EINTR != errno)
+        {
+            LE_ERROR("Error while writing file, errno: %d (%m)", errno);
+            return -1;
+        }
+    }
+
+    return writtenSize;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file pcmDsp.h
+ *
+ * PCM signal processing kernels used by the media playback and capture.
+ *
+ * The samples are signed 16-bit mono samples. The module provides:
+ *  - a recursive sine oscillator, generating tones without calling sin() on every sample,
+ *  - a saturating mix, using the SIMD saturating additions when available,
+ *  - a fixed-point gain,
+ *  - a linear interpolation sample rate converter, which can be fed by successive blocks,
+ *  - blocking reads and writes of whole blocks on file descriptors.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_PCMDSP_INCLUDE_GUARD
+#define LEGATO_PCMDSP_INCLUDE_GUARD
+
+#include "legato.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Block size used to stream PCM samples through a file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PCMDSP_IO_BLOCK_BYTES   (2 * PIPE_BUF)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unity gain, gains are fixed-point values with 12 fractional bits.
+ */
+//--------------------------------------------------------------------------------------------------
+#define PCMDSP_GAIN_UNITY       (1 << 12)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sine oscillator.
+ *
+ * The samples are computed with the recurrence y[n] = 2.cos(w).y[n-1] - y[n-2]. The state is kept
+ * in double precision so that the oscillator does not drift noticeably over several seconds.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    double coef;        ///< 2.cos(w)
+    double y1;          ///< Previous sample
+    double y2;          ///< Sample before the previous one
+}
+pcmDsp_Osc_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Linear interpolation sample rate converter.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t step;          ///< Input samples per output sample, 16 fractional bits
+    uint32_t phase;         ///< Position of the next output sample, relative to prevSample
+    int16_t  prevSample;    ///< Last input sample of the previous block
+}
+pcmDsp_Resampler_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a sine oscillator, so that the next generated sample is
+ * amplitude.sin(2.pi.freq.startIdx / sampleRate).
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmDsp_InitOsc
+(
+    pcmDsp_Osc_t* oscPtr,       ///< [OUT] Oscillator
+    uint32_t      freq,         ///< [IN] Frequency in Hertz
+    uint32_t      sampleRate,   ///< [IN] Sample frequency in Hertz
+    double        amplitude,    ///< [IN] Peak amplitude
+    uint32_t      startIdx      ///< [IN] Index of the next sample
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Generate the sum of the outputs of some oscillators, saturated to 16 bits.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmDsp_GenerateTones
+(
+    pcmDsp_Osc_t* oscPtr,       ///< [IN/OUT] Oscillators
+    size_t        oscCount,     ///< [IN] Number of oscillators
+    int16_t*      samplesPtr,   ///< [OUT] Samples
+    size_t        count         ///< [IN] Number of samples to generate
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mix some samples into a buffer, with saturation.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmDsp_Mix
+(
+    int16_t*       dstPtr,      ///< [IN/OUT] Samples to mix into
+    const int16_t* srcPtr,      ///< [IN] Samples to add
+    size_t         count        ///< [IN] Number of samples
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply a gain to some samples, with saturation.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmDsp_ApplyGain
+(
+    int16_t* samplesPtr,        ///< [IN/OUT] Samples
+    size_t   count,             ///< [IN] Number of samples
+    uint32_t gain               ///< [IN] Gain, PCMDSP_GAIN_UNITY being the unity gain
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize a sample rate converter.
+ */
+//--------------------------------------------------------------------------------------------------
+void pcmDsp_InitResampler
+(
+    pcmDsp_Resampler_t* resamplerPtr,   ///< [OUT] Sample rate converter
+    uint32_t            inRate,         ///< [IN] Input sample frequency in Hertz
+    uint32_t            outRate         ///< [IN] Output sample frequency in Hertz
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum number of samples produced by the conversion of a block.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t pcmDsp_GetResampledMax
+(
+    const pcmDsp_Resampler_t* resamplerPtr, ///< [IN] Sample rate converter
+    size_t                    inCount       ///< [IN] Number of input samples
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a block of samples. The whole block is consumed, the output buffer must be able to hold
+ * pcmDsp_GetResampledMax() samples.
+ *
+ * @return Number of output samples
+ */
+//--------------------------------------------------------------------------------------------------
+size_t pcmDsp_Resample
+(
+    pcmDsp_Resampler_t* resamplerPtr,   ///< [IN/OUT] Sample rate converter
+    const int16_t*      inPtr,          ///< [IN] Input samples
+    size_t              inCount,        ///< [IN] Number of input samples
+    int16_t*            outPtr          ///< [OUT] Output samples
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a block from a file descriptor. This function blocks until the whole block is read, the
+ * end of file is reached or, for a non-blocking file descriptor, no more data is available.
+ *
+ * @return
+ *      - Number of bytes read
+ *      - -1 on error
+ */
+//--------------------------------------------------------------------------------------------------
+ssize_t pcmDsp_ReadFd
+(
+    int    fd,                  ///< [IN] File descriptor
+    void*  bufPtr,              ///< [OUT] Buffer
+    size_t bufSize              ///< [IN] Number of bytes to read
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a block to a file descriptor. This function blocks until the whole block is written.
+ *
+ * @return
+ *      - Number of bytes written
+ *      - -1 on error
+ */
+//--------------------------------------------------------------------------------------------------
+ssize_t pcmDsp_WriteFd
+(
+    int         fd,             ///< [IN] File descriptor
+    const void* bufPtr,         ///< [IN] Buffer
+    size_t      bufSize         ///< [IN] Number of bytes to write
+);
+
+#endif // LEGATO_PCMDSP_INCLUDE_GUARD
@@ -176,6 +176,25 @@ le_cfg_nodeType_t le_cfg_GetNodeType
     return LE_CFG_TYPE_STRING;
 }
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check if the node that the iterator is currently pointing at holds a binary value.
+ *
+ *  \b Responds \b With:
+ *
+ *  True if the node is a binary node, false if not.
+ */
+// -------------------------------------------------------------------------------------------------
+bool le_cfg_IsBinary
+(
+    le_cfg_IteratorRef_t externalRef, ///< [IN] Iterator object to use to read from the tree.
+    const char *pathPtr               ///< [IN] Absolute or relative path to read from.
+)
+{
+    NOT_SUPPORTED(WARN);
+    return false;
+}
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Get the name of the node that the iterator is currently pointing at.
@@ -5,6 +5,14 @@
  *
  * This PA stores the downloaded file content to local storage file system (flash).
  *
+ * The downloaded bytes are spliced from the download fd to the stored file, without being copied
+ * through user space, and the space of the file is reserved before the download starts.  If the
+ * storage file system does not support splice(2), the bytes are copied through le_fs.
+ *
+ * The details of the stored files and of the file being downloaded are kept in memory, in two file
+ * lists.  Each change of a list is appended to a journal, and the lists are written back to their
+ * JSON snapshots (file_list.json and file_download.json) when the journal is full and at startup.
+ *
  * Copyright (C) Sierra Wireless Inc.
  *
  */
@@ -58,6 +66,10 @@ typedef struct
 {
     int             readFd;                                             ///< File download fd
     le_fs_FileRef_t fileRef;                                            ///< File storage reference
+    int             storageFd;                                          ///< Stored file fd for
+                                                                        ///< splice(2), or -1
+    int             pipeFds[2];                                         ///< Pipe between readFd
+                                                                        ///< and storageFd, or -1
     char            topic[LE_FILESTREAMCLIENT_FILE_TOPIC_MAX_BYTES];    ///< File class
     size_t          bytesReceived;                                      ///< Received bytes
 }
@@ -66,6 +78,7 @@ StreamContext_t;
 
 #define MAX_STREAM_OBJECT           20
 #define READ_CHUNK_BYTES            4096
+#define SPLICE_CHUNK_BYTES          (128*1024)
 #define DEFAULT_TIMEOUT_MS          900000
 #define MAX_EVENTS                  10
 #define ROOT_PATH_STORAGE           "/data/le_fs"
@@ -115,10 +128,43 @@ StreamContext_t;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Define value for an empty file list (JSON format)
+ * Define value for the journal of the changes of the file lists since their snapshots (one JSON
+ * record per line)
+ */
+//--------------------------------------------------------------------------------------------------
+#define FILESTREAM_FILE_INDEX_JOURNAL               FILESTREAM_LEFS_DIR "/" "file_index.jnl"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Suffix of the temporary file a snapshot is written to before replacing the previous one
+ */
+//--------------------------------------------------------------------------------------------------
+#define SNAPSHOT_TEMP_SUFFIX                        ".tmp"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of journal records after which the file lists are written back to their snapshots
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_JOURNAL_RECORDS                         64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Define values for the FILESTREAM_FILE_INDEX_JOURNAL records
+ */
+//--------------------------------------------------------------------------------------------------
+#define JOURNAL_FIELD_OP                            "op"
+#define JOURNAL_FIELD_FILE                          "file"
+#define JOURNAL_OP_ADD                              "add"       ///< File added to the stored files
+#define JOURNAL_OP_DELETE                           "del"       ///< File deleted from stored files
+#define JOURNAL_OP_DOWNLOAD                         "download"  ///< New download file list
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the download state of a file (\0 included)
  */
 //--------------------------------------------------------------------------------------------------
-#define DEFAULT_FILE_LIST                           "{\"" JSON_FILE_FIELD_FILES "\":[]}"
+#define FILE_STATE_MAX_BYTES                        16
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -163,6 +209,65 @@ static le_hashmap_Ref_t StreamObjTable;
 //--------------------------------------------------------------------------------------------------
 static bool IsFileInstanceUsed[LE_FILESTREAMSERVER_FILE_MAX_NUMBER];
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Entry of a file list
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t   link;                                               ///< Link in the file list
+    uint16_t        instanceId;                                         ///< File instance
+    char            name[LE_FILESTREAMCLIENT_FILE_NAME_MAX_BYTES];      ///< File name
+    char            topic[LE_FILESTREAMCLIENT_FILE_TOPIC_MAX_BYTES];    ///< File class
+    char            hash[LE_FILESTREAMCLIENT_HASH_MAX_BYTES];           ///< File hash
+    char            state[FILE_STATE_MAX_BYTES];                        ///< Download state
+    uint64_t        size;                                               ///< File size
+    uint8_t         direction;                                          ///< File direction
+    uint8_t         origin;                                             ///< File origin
+}
+FileEntry_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File list
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char*     snapshotPathPtr;        ///< Snapshot of the list
+    le_dls_List_t   entries;                ///< Entries of the list (FileEntry_t)
+}
+FileList_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * List of the stored files
+ */
+//--------------------------------------------------------------------------------------------------
+static FileList_t StoredFiles = { FILESTREAM_FILE_LIST, LE_DLS_LIST_INIT };
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * List of the file being downloaded
+ */
+//--------------------------------------------------------------------------------------------------
+static FileList_t DownloadFiles = { FILESTREAM_FILE_DOWNLOAD, LE_DLS_LIST_INIT };
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory Pool for file list entries
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t FileEntryPoolRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of records in the journal
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t JournalRecordCount;
+
 
 //==================================================================================================
 //                                       Local Functions
@@ -272,53 +377,6 @@ static le_result_t WriteFs
     return LE_OK;
 }
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Create empty json file
- */
-//--------------------------------------------------------------------------------------------------
-static void CreateDefaultJsonFile
-(
-    const char* jsonFileNamePtr     ///< [IN] File name
-)
-{
-    if (!jsonFileNamePtr)
-    {
-        return;
-    }
-
-    // Check the presence of the file list
-    if (false  == le_fs_Exists(jsonFileNamePtr))
-    {
-        // Create default file
-        char buffer[20] = {0};
-        le_fs_FileRef_t fileRef;
-        le_result_t result;
-
-        snprintf(buffer, 20, DEFAULT_FILE_LIST);
-
-        result = le_fs_Open(jsonFileNamePtr, LE_FS_WRONLY | LE_FS_CREAT | LE_FS_TRUNC, &fileRef);
-        if (LE_OK != result)
-        {
-            LE_ERROR("failed to open %s: %s", jsonFileNamePtr, LE_RESULT_TXT(result));
-        }
-        else
-        {
-            result = le_fs_Write(fileRef, (uint8_t*)buffer, strlen(buffer));
-            if (LE_OK != result)
-            {
-                LE_ERROR("failed to write %s: %s", jsonFileNamePtr, LE_RESULT_TXT(result));
-            }
-
-            result = le_fs_Close(fileRef);
-            if (LE_OK != result)
-            {
-                LE_ERROR("failed to close %s: %s", jsonFileNamePtr, LE_RESULT_TXT(result));
-            }
-        }
-    }
-}
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Delete file using Legato le_fs API
@@ -354,431 +412,889 @@ static le_result_t DeleteFs
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read file details from a JSON file
+ * Allocate a file list entry and fill it from a JSON file object
  *
  * @return
- *  - LE_OK             The function succeeded
- *  - LE_BAD_PARAMETER  Incorrect parameter provided
- *  - LE_FAULT          The function failed
- *  - LE_NOT_FOUND      The file is not present
+ *  - Pointer to the new entry
+ *  - NULL if the JSON object is not a file object
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t FileInfoFromJsonFileRead
+static FileEntry_t* EntryFromJson
 (
-    const char* jsonFileNamePtr,            ///< [IN] File name of the file info need to be read
-    uint16_t    instanceId,                 ///< [IN] File instance
-    char*       fileNamePtr,                ///< [OUT] File name buffer
-    size_t      fileNameNumElements,        ///< [IN]  File name buffer size (\0 included)
-    char*       fileTopicPtr,               ///< [OUT] File topic buffer
-    size_t      fileTopicNumElements,       ///< [IN]  File topic buffer size (\0 included)
-    char*       fileHashPtr,                ///< [OUT] File hash buffer
-    size_t      fileHashNumElements,        ///< [IN]  File hash buffer size (\0 included)
-    uint64_t*   fileSizePtr,                ///< [OUT]  File size
-    uint8_t*    fileOriginPtr               ///< [OUT] File origin
+    json_t* fileObjectPtr           ///< [IN] JSON file object
 )
 {
-    char* bufferPtr = NULL;
-    int instance = 0;
-    size_t bufferSize = 0;
-    int i = 0;
-    bool doesFileExist = false;
-    size_t length;
-
-    json_error_t error;
-    json_t* filePtr;
-    json_t* root;
-
-    if ((!jsonFileNamePtr))
-    {
-        return LE_BAD_PARAMETER;
-    }
+    FileEntry_t* entryPtr;
+    json_t* jsonFieldPtr;
 
-    if ((LE_FILESTREAMSERVER_FILE_MAX_NUMBER < instanceId)
-     && (FILE_INSTANCE_ID_DOWNLOADING != instanceId))
+    if (!json_is_object(fileObjectPtr))
     {
-        return LE_BAD_PARAMETER;
+        return NULL;
     }
 
-    if (LE_OK != le_fs_GetSize(jsonFileNamePtr, &bufferSize))
-    {
-        LE_DEBUG("Error to get file %s size", jsonFileNamePtr);
-        return LE_FAULT;
-    }
+    entryPtr = le_mem_ForceAlloc(FileEntryPoolRef);
+    memset(entryPtr, 0, sizeof(FileEntry_t));
+    entryPtr->link = LE_DLS_LINK_INIT;
 
-    bufferPtr = calloc(bufferSize + 1, sizeof(char));
+    jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_INSTANCE);
+    entryPtr->instanceId = jsonFieldPtr ? (uint16_t)json_integer_value(jsonFieldPtr) : 0;
 
-    if (LE_OK != ReadFs(jsonFileNamePtr, (uint8_t*)bufferPtr, &bufferSize))
+    jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_NAME);
+    if (json_is_string(jsonFieldPtr))
     {
-        LE_DEBUG("Error to read file %s", jsonFileNamePtr);
-        return LE_FAULT;
+        le_utf8_Copy(entryPtr->name, json_string_value(jsonFieldPtr), sizeof(entryPtr->name), NULL);
     }
 
-    /* Parse the file (JSON) */
-    root = json_loads(bufferPtr, 0, &error);
-    free(bufferPtr);
-
-    if (!root)
+    jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_CLASS);
+    if (json_is_string(jsonFieldPtr))
     {
-        LE_ERROR("Error: on loading json: %s\n", error.text);
-        return LE_FAULT;
+        le_utf8_Copy(entryPtr->topic,
+                     json_string_value(jsonFieldPtr),
+                     sizeof(entryPtr->topic),
+                     NULL);
     }
 
-    filePtr = json_object_get(root, JSON_FILE_FIELD_FILES);
-    if (!filePtr)
+    jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_HASH);
+    if (json_is_string(jsonFieldPtr))
     {
-        LE_ERROR("Error to find files array");
-        json_decref(root);
-        return LE_FAULT;
+        le_utf8_Copy(entryPtr->hash, json_string_value(jsonFieldPtr), sizeof(entryPtr->hash), NULL);
     }
 
-    if(!json_is_array(filePtr))
+    jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_STATE);
+    if (json_is_string(jsonFieldPtr))
     {
-        LE_ERROR("Files is not an array");
-        json_decref(root);
-        return LE_FAULT;
+        le_utf8_Copy(entryPtr->state,
+                     json_string_value(jsonFieldPtr),
+                     sizeof(entryPtr->state),
+                     NULL);
     }
 
-    length = json_array_size(filePtr);
-    LE_DEBUG("length %zd", length);
+    jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_SIZE);
+    entryPtr->size = jsonFieldPtr ? (uint64_t)json_integer_value(jsonFieldPtr) : 0;
 
-    // Check if the filename is not already present
-    for (i = 0; i < length; i++)
-    {
-        json_t* fileObjectPtr = json_array_get(filePtr, i);
-        json_t* jsonFieldPtr;
+    jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_DIRECTION);
+    entryPtr->direction = jsonFieldPtr ? (uint8_t)json_integer_value(jsonFieldPtr) : 0;
 
-        jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_INSTANCE);
-        if(jsonFieldPtr)
-        {
-            instance = json_integer_value(jsonFieldPtr);
-        }
+    jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_ORIGIN);
+    entryPtr->origin = jsonFieldPtr ? (uint8_t)json_integer_value(jsonFieldPtr) : 0;
 
-        if (instanceId == instance)
-        {
-            const char* tempPtr;
+    return entryPtr;
+}
 
-            doesFileExist = true;
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the JSON file object of a file list entry
+ *
+ * @return New JSON object (to be released with json_decref())
+ */
+//--------------------------------------------------------------------------------------------------
+static json_t* EntryToJson
+(
+    const FileEntry_t* entryPtr     ///< [IN] File list entry
+)
+{
+    json_t* objPtr = json_object();
 
-            jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_NAME);
-            if (jsonFieldPtr && fileNamePtr)
-            {
-                tempPtr = (char*)json_string_value(jsonFieldPtr);
-                LE_DEBUG("file name: %s", tempPtr);
-                if(fileNameNumElements >= strlen(tempPtr))
-                {
-                    snprintf(fileNamePtr, fileNameNumElements, "%s", tempPtr);
-                }
-            }
+    LE_ASSERT(objPtr);
 
-            jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_CLASS);
-            if (jsonFieldPtr && fileTopicPtr)
-            {
-                tempPtr = (char*)json_string_value(jsonFieldPtr);
-                LE_DEBUG("file class: %s", tempPtr);
-                if(fileTopicNumElements >= strlen(tempPtr))
-                {
-                    snprintf(fileTopicPtr, fileTopicNumElements, "%s", tempPtr);
-                }
-            }
+    json_object_set_new(objPtr, JSON_FILE_FIELD_NAME, json_string(entryPtr->name));
+    json_object_set_new(objPtr, JSON_FILE_FIELD_SIZE, json_integer(entryPtr->size));
+    json_object_set_new(objPtr, JSON_FILE_FIELD_STATE, json_string(entryPtr->state));
+    json_object_set_new(objPtr, JSON_FILE_FIELD_CLASS, json_string(entryPtr->topic));
+    json_object_set_new(objPtr, JSON_FILE_FIELD_HASH, json_string(entryPtr->hash));
+    json_object_set_new(objPtr, JSON_FILE_FIELD_DIRECTION, json_integer(entryPtr->direction));
+    json_object_set_new(objPtr, JSON_FILE_FIELD_ORIGIN, json_integer(entryPtr->origin));
+    json_object_set_new(objPtr, JSON_FILE_FIELD_INSTANCE, json_integer(entryPtr->instanceId));
 
-            jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_HASH);
-            if (jsonFieldPtr && fileHashPtr)
-            {
-                tempPtr = (char*)json_string_value(jsonFieldPtr);
-                LE_DEBUG("file hash: %s", tempPtr);
-                if(fileHashNumElements >= strlen(tempPtr))
-                {
-                    snprintf(fileHashPtr, fileHashNumElements, "%s", tempPtr);
-                }
-            }
+    return objPtr;
+}
 
-            jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_SIZE);
-            if (jsonFieldPtr && fileSizePtr)
-            {
-                *fileSizePtr = json_integer_value(jsonFieldPtr);
-                LE_DEBUG("file size: %"PRIu64, *fileSizePtr);
-            }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the JSON array of the files of a list
+ *
+ * @return New JSON array (to be released with json_decref())
+ */
+//--------------------------------------------------------------------------------------------------
+static json_t* ListToJson
+(
+    FileList_t* listPtr             ///< [IN] File list
+)
+{
+    json_t* filesPtr = json_array();
+    le_dls_Link_t* linkPtr;
 
-            jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_ORIGIN);
-            if (jsonFieldPtr && fileOriginPtr)
-            {
-                *fileOriginPtr = json_integer_value(jsonFieldPtr);
-                LE_DEBUG("file origin: %d", *fileOriginPtr);
-            }
-            break;
-        }
+    LE_ASSERT(filesPtr);
+
+    for (linkPtr = le_dls_Peek(&listPtr->entries);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&listPtr->entries, linkPtr))
+    {
+        json_array_append_new(filesPtr, EntryToJson(CONTAINER_OF(linkPtr, FileEntry_t, link)));
     }
 
-    json_decref(root);
-    if (false == doesFileExist)
+    return filesPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove an entry from a file list and release it
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveEntry
+(
+    FileList_t*     listPtr,        ///< [IN] File list
+    FileEntry_t*    entryPtr        ///< [IN] Entry to remove
+)
+{
+    le_dls_Remove(&listPtr->entries, &entryPtr->link);
+    le_mem_Release(entryPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove all the entries of a file list
+ */
+//--------------------------------------------------------------------------------------------------
+static void ClearList
+(
+    FileList_t* listPtr             ///< [IN] File list
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    while ((linkPtr = le_dls_Pop(&listPtr->entries)) != NULL)
     {
-        return LE_NOT_FOUND;
+        le_mem_Release(CONTAINER_OF(linkPtr, FileEntry_t, link));
     }
+}
 
-    return LE_OK;
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append the files of a JSON array to a file list
+ */
+//--------------------------------------------------------------------------------------------------
+static void AppendJsonFiles
+(
+    FileList_t* listPtr,            ///< [IN] File list
+    json_t*     filesPtr            ///< [IN] JSON array of file objects
+)
+{
+    size_t i;
+
+    for (i = 0; i < json_array_size(filesPtr); i++)
+    {
+        FileEntry_t* entryPtr = EntryFromJson(json_array_get(filesPtr, i));
 
+        if (entryPtr)
+        {
+            le_dls_Queue(&listPtr->entries, &entryPtr->link);
+        }
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Return all file instances of one JSON file
+ * Find the entry of a file instance in a file list
  *
  * @return
- *  - LE_OK             The function succeeded
- *  - LE_BAD_PARAMETER  Incorrect parameter provided
- *  - LE_FAULT          The function failed
- *  - LE_NOT_FOUND      The file is not present
+ *  - Pointer to the first entry with this instance Id
+ *  - NULL if there is none
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ListFileInstanceFromJsonFile
+static FileEntry_t* FindEntryByInstance
 (
-    const char* jsonFileNamePtr,    ///< [IN] File name in which the file info need to be deleted
-    uint16_t*   instanceListPtr,    ///< [OUT] File instance number list buffer
-    uint32_t*   instanceNbPtr       ///< [OUT] File instance number
+    FileList_t* listPtr,            ///< [IN] File list
+    uint16_t    instanceId          ///< [IN] File instance
 )
 {
-    char* bufferPtr = NULL;
-    size_t bufferSize = 0;
-    uint32_t step = 0;
-    int i = 0;
-    size_t length;
-    json_error_t error;
-    json_t* filePtr;
-    json_t* root;
+    le_dls_Link_t* linkPtr;
 
-    if ((!jsonFileNamePtr)
-     || (!instanceListPtr)
-     || (!instanceNbPtr))
+    for (linkPtr = le_dls_Peek(&listPtr->entries);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&listPtr->entries, linkPtr))
     {
-        return LE_BAD_PARAMETER;
+        FileEntry_t* entryPtr = CONTAINER_OF(linkPtr, FileEntry_t, link);
+
+        if (entryPtr->instanceId == instanceId)
+        {
+            return entryPtr;
+        }
     }
 
-    *instanceNbPtr = 0;
+    return NULL;
+}
 
-    LE_DEBUG("ListFileInstanceFromJsonFile file %s", jsonFileNamePtr);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a JSON file
+ *
+ * @return
+ *  - JSON root (to be released with json_decref())
+ *  - NULL if the file is absent or can't be parsed
+ */
+//--------------------------------------------------------------------------------------------------
+static json_t* LoadJsonFile
+(
+    const char* pathPtr             ///< [IN] File path
+)
+{
+    char* bufferPtr = NULL;
+    size_t bufferSize = 0;
+    json_error_t error;
+    json_t* root;
 
-    if (LE_OK != le_fs_GetSize(jsonFileNamePtr, &bufferSize))
+    if (LE_OK != le_fs_GetSize(pathPtr, &bufferSize))
     {
-        LE_DEBUG("Error to get file %s size", jsonFileNamePtr);
-        return LE_FAULT;
+        LE_DEBUG("Error to get file %s size", pathPtr);
+        return NULL;
     }
 
     bufferPtr = calloc(bufferSize + 1, sizeof(char));
+    LE_ASSERT(bufferPtr);
 
-    if (LE_OK != ReadFs(jsonFileNamePtr, (uint8_t*)bufferPtr, &bufferSize))
+    if (LE_OK != ReadFs(pathPtr, (uint8_t*)bufferPtr, &bufferSize))
     {
-        LE_DEBUG("Error to read file %s", jsonFileNamePtr);
+        LE_DEBUG("Error to read file %s", pathPtr);
         free(bufferPtr);
-        return LE_FAULT;
+        return NULL;
     }
 
-    /* Parse the file (JSON) */
     root = json_loads(bufferPtr, 0, &error);
     free(bufferPtr);
 
-    filePtr = json_object_get(root, JSON_FILE_FIELD_FILES);
-    if (!filePtr)
+    if (!root)
     {
-        LE_ERROR("Error to find files array");
-        return LE_FAULT;
+        LE_ERROR("Error: on loading %s: %s", pathPtr, error.text);
     }
 
-    if(!json_is_array(filePtr))
-    {
-        LE_ERROR("Files is not an array");
-        json_decref(root);
-        return LE_FAULT;
-    }
+    return root;
+}
 
-    length = json_array_size(filePtr);
-    LE_DEBUG("length %d", length);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load a file list from its snapshot
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadSnapshot
+(
+    FileList_t* listPtr             ///< [IN] File list
+)
+{
+    json_t* root = LoadJsonFile(listPtr->snapshotPathPtr);
+    json_t* filesPtr;
 
-    // Check if the filename is not already present
-    for (i = 0; i < length; i++)
+    if (!root)
+    {
+        return;
+    }
+
+    filesPtr = json_object_get(root, JSON_FILE_FIELD_FILES);
+    if (json_is_array(filesPtr))
+    {
+        AppendJsonFiles(listPtr, filesPtr);
+    }
+    else
     {
-        json_t* fileObjectPtr = json_array_get(filePtr, i);
+        LE_ERROR("No files array in %s", listPtr->snapshotPathPtr);
+    }
 
-        if(!fileObjectPtr)
+    json_decref(root);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the snapshot of a file list.  The snapshot is written to a temporary file which then
+ * replaces the previous snapshot, so that a power loss leaves either snapshot in place.
+ *
+ * @return
+ *  - LE_OK             The function succeeded
+ *  - LE_FAULT          The function failed
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteSnapshot
+(
+    FileList_t* listPtr             ///< [IN] File list
+)
+{
+    char tempPath[PATH_MAX];
+    json_t* root = json_object();
+    char* dumpPtr;
+    le_result_t result;
+
+    LE_ASSERT(root);
+    json_object_set_new(root, JSON_FILE_FIELD_FILES, ListToJson(listPtr));
+    dumpPtr = json_dumps(root, JSON_COMPACT);
+    json_decref(root);
+    LE_ASSERT(dumpPtr);
+
+    snprintf(tempPath, sizeof(tempPath), "%s%s", listPtr->snapshotPathPtr, SNAPSHOT_TEMP_SUFFIX);
+
+    result = WriteFs(tempPath, (uint8_t*)dumpPtr, strlen(dumpPtr));
+    free(dumpPtr);
+
+    if (LE_OK == result)
+    {
+        result = le_fs_Move(tempPath, listPtr->snapshotPathPtr);
+    }
+
+    if (LE_OK != result)
+    {
+        LE_ERROR("Failed to write %s: %s", listPtr->snapshotPathPtr, LE_RESULT_TXT(result));
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write both file lists to their snapshots and empty the journal.  The journal is only deleted
+ * once both snapshots are written; replaying it over the new snapshots gives the same lists.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CompactFileIndex
+(
+    void
+)
+{
+    LE_DEBUG("Compacting the file index (%"PRIuS" journal records)", JournalRecordCount);
+
+    if ((LE_OK != WriteSnapshot(&StoredFiles)) || (LE_OK != WriteSnapshot(&DownloadFiles)))
+    {
+        return;
+    }
+
+    if (le_fs_Exists(FILESTREAM_FILE_INDEX_JOURNAL))
+    {
+        DeleteFs(FILESTREAM_FILE_INDEX_JOURNAL);
+    }
+    JournalRecordCount = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a record to the file index journal, and compact the index when the journal is full.
+ * The record is released.
+ *
+ * @return
+ *  - LE_OK             The function succeeded
+ *  - LE_FAULT          The function failed
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AppendJournalRecord
+(
+    json_t* recordPtr               ///< [IN] Journal record
+)
+{
+    le_fs_FileRef_t fileRef;
+    char* dumpPtr = json_dumps(recordPtr, JSON_COMPACT);
+    le_result_t result;
+
+    json_decref(recordPtr);
+    LE_ASSERT(dumpPtr);
+
+    LE_DEBUG("Journal record: %s", dumpPtr);
+
+    result = le_fs_Open(FILESTREAM_FILE_INDEX_JOURNAL,
+                        LE_FS_WRONLY | LE_FS_CREAT | LE_FS_APPEND,
+                        &fileRef);
+    if (LE_OK == result)
+    {
+        // One record per line: a record cut by a power loss is the last line, and is ignored.
+        size_t length = strlen(dumpPtr);
+        dumpPtr[length] = '\n';
+        result = le_fs_Write(fileRef, (uint8_t*)dumpPtr, length + 1);
+        if (LE_OK != le_fs_Close(fileRef))
         {
-            break;
+            result = LE_FAULT;
         }
+    }
+    free(dumpPtr);
 
-        json_t* jsonInstance = json_object_get(fileObjectPtr, JSON_FILE_FIELD_INSTANCE);
-        instanceListPtr[step] = json_integer_value(jsonInstance);
-        step++;
-        (*instanceNbPtr)++;
+    if (LE_OK != result)
+    {
+        LE_ERROR("Failed to write %s: %s", FILESTREAM_FILE_INDEX_JOURNAL, LE_RESULT_TXT(result));
+        return LE_FAULT;
+    }
 
+    if (++JournalRecordCount >= MAX_JOURNAL_RECORDS)
+    {
+        CompactFileIndex();
     }
-    json_decref(root);
+
     return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add one file in the JSON file list
+ * Record that a file was added to the stored file list
  *
  * @return
  *  - LE_OK             The function succeeded
- *  - LE_BAD_PARAMETER  Incorrect parameter provided
  *  - LE_FAULT          The function failed
- *  - LE_DUPLICATE      The file already exists
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t FileInfoFromJsonFileAdd
+static le_result_t JournalStoredFileAdded
 (
-    const char* jsonFileNamePtr,    ///< [IN] File name in which the file info need to be added
-    char*       fileNamePtr,        ///< [IN] File name
-    char*       statePtr,           ///< [IN] File state
-    char*       classPtr,           ///< [IN] File class
-    char*       hashPtr,            ///< [IN] File hash
-    uint64_t    fileSize,           ///< [IN] File size
-    uint8_t     direction,          ///< [IN] File direction (0: download)
-    uint8_t     origin,             ///< [IN] File origin (0: server)
-    uint16_t    instanceId          ///< [IN] Instance Id
+    const FileEntry_t* entryPtr     ///< [IN] New entry
 )
 {
-    char* bufferPtr = NULL;
-    size_t bufferSize = 0;
-    bool isFileAlreadyExists = false;
-    bool isFileAdded = false;
-    int i = 0;
-    size_t length;
-    json_error_t error;
-    json_t* filePtr;
-    json_t* root;
+    json_t* recordPtr = json_object();
 
-    if ((!jsonFileNamePtr) || (!fileNamePtr) || (!statePtr) || (!classPtr) || (!hashPtr))
+    LE_ASSERT(recordPtr);
+    json_object_set_new(recordPtr, JOURNAL_FIELD_OP, json_string(JOURNAL_OP_ADD));
+    json_object_set_new(recordPtr, JOURNAL_FIELD_FILE, EntryToJson(entryPtr));
+
+    return AppendJournalRecord(recordPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record that a file was removed from the stored file list
+ *
+ * @return
+ *  - LE_OK             The function succeeded
+ *  - LE_FAULT          The function failed
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t JournalStoredFileDeleted
+(
+    uint16_t instanceId             ///< [IN] File instance
+)
+{
+    json_t* recordPtr = json_object();
+
+    LE_ASSERT(recordPtr);
+    json_object_set_new(recordPtr, JOURNAL_FIELD_OP, json_string(JOURNAL_OP_DELETE));
+    json_object_set_new(recordPtr, JSON_FILE_FIELD_INSTANCE, json_integer(instanceId));
+
+    return AppendJournalRecord(recordPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the new content of the download file list.  This list holds the file being transferred,
+ * so the whole list is recorded.
+ *
+ * @return
+ *  - LE_OK             The function succeeded
+ *  - LE_FAULT          The function failed
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t JournalDownloadFiles
+(
+    void
+)
+{
+    json_t* recordPtr = json_object();
+
+    LE_ASSERT(recordPtr);
+    json_object_set_new(recordPtr, JOURNAL_FIELD_OP, json_string(JOURNAL_OP_DOWNLOAD));
+    json_object_set_new(recordPtr, JSON_FILE_FIELD_FILES, ListToJson(&DownloadFiles));
+
+    return AppendJournalRecord(recordPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply a journal record to the file lists
+ *
+ * @return
+ *  - LE_OK             The record was applied
+ *  - LE_FAULT          The record is not valid
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ApplyJournalRecord
+(
+    json_t* recordPtr               ///< [IN] Journal record
+)
+{
+    const char* opPtr = json_string_value(json_object_get(recordPtr, JOURNAL_FIELD_OP));
+
+    if (!opPtr)
     {
-        return LE_BAD_PARAMETER;
+        return LE_FAULT;
     }
 
-    if ((strlen(statePtr) == (strlen(FILE_DOWNLOAD_NO_SIZE)))
-     && (!strncmp(statePtr, FILE_DOWNLOAD_NO_SIZE, strlen(statePtr))))
+    if (0 == strcmp(opPtr, JOURNAL_OP_ADD))
     {
-        LE_INFO("New file transfer. File %s, class %s", fileNamePtr, classPtr);
+        FileEntry_t* entryPtr = EntryFromJson(json_object_get(recordPtr, JOURNAL_FIELD_FILE));
+        FileEntry_t* oldEntryPtr;
+
+        if (!entryPtr)
+        {
+            return LE_FAULT;
+        }
+
+        oldEntryPtr = FindEntryByInstance(&StoredFiles, entryPtr->instanceId);
+        if (oldEntryPtr)
+        {
+            RemoveEntry(&StoredFiles, oldEntryPtr);
+        }
+        le_dls_Queue(&StoredFiles.entries, &entryPtr->link);
     }
+    else if (0 == strcmp(opPtr, JOURNAL_OP_DELETE))
+    {
+        json_t* jsonInstancePtr = json_object_get(recordPtr, JSON_FILE_FIELD_INSTANCE);
+        FileEntry_t* entryPtr;
 
-    LE_DEBUG("Add one file in %s", jsonFileNamePtr);
-    LE_DEBUG("File name: %s", fileNamePtr);
-    LE_DEBUG("File state: %s", statePtr);
-    LE_DEBUG("File class: %s", classPtr);
-    LE_DEBUG("File hash: %s", hashPtr);
-    LE_DEBUG("File direction: %d", direction);
-    LE_DEBUG("File origin: %d", origin);
+        if (!json_is_integer(jsonInstancePtr))
+        {
+            return LE_FAULT;
+        }
 
-    if (LE_OK != le_fs_GetSize(jsonFileNamePtr, &bufferSize))
+        entryPtr = FindEntryByInstance(&StoredFiles, (uint16_t)json_integer_value(jsonInstancePtr));
+        if (entryPtr)
+        {
+            RemoveEntry(&StoredFiles, entryPtr);
+        }
+    }
+    else if (0 == strcmp(opPtr, JOURNAL_OP_DOWNLOAD))
+    {
+        json_t* filesPtr = json_object_get(recordPtr, JSON_FILE_FIELD_FILES);
+
+        if (!json_is_array(filesPtr))
+        {
+            return LE_FAULT;
+        }
+
+        ClearList(&DownloadFiles);
+        AppendJsonFiles(&DownloadFiles, filesPtr);
+    }
+    else
     {
-        LE_DEBUG("Error to get file %s size", jsonFileNamePtr);
         return LE_FAULT;
     }
 
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay the file index journal over the snapshots
+ *
+ * @return Number of records replayed
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t ReplayJournal
+(
+    void
+)
+{
+    char* bufferPtr = NULL;
+    char* linePtr;
+    size_t bufferSize = 0;
+    size_t count = 0;
+
+    if (LE_OK != le_fs_GetSize(FILESTREAM_FILE_INDEX_JOURNAL, &bufferSize))
+    {
+        return 0;
+    }
+
     bufferPtr = calloc(bufferSize + 1, sizeof(char));
+    LE_ASSERT(bufferPtr);
 
-    if (LE_OK != ReadFs(jsonFileNamePtr, (uint8_t*)bufferPtr, &bufferSize))
+    if (LE_OK != ReadFs(FILESTREAM_FILE_INDEX_JOURNAL, (uint8_t*)bufferPtr, &bufferSize))
     {
         free(bufferPtr);
-        return LE_FAULT;
+        return 0;
+    }
+
+    for (linePtr = bufferPtr; *linePtr != '\0'; )
+    {
+        char* endPtr = strchr(linePtr, '\n');
+        json_error_t error;
+        json_t* recordPtr;
+
+        if (!endPtr)
+        {
+            LE_WARN("Ignoring incomplete record at the end of %s", FILESTREAM_FILE_INDEX_JOURNAL);
+            break;
+        }
+        *endPtr = '\0';
+
+        recordPtr = json_loads(linePtr, 0, &error);
+        if ((!recordPtr) || (LE_OK != ApplyJournalRecord(recordPtr)))
+        {
+            LE_ERROR("Invalid record in %s, ignoring the rest of it",
+                     FILESTREAM_FILE_INDEX_JOURNAL);
+            json_decref(recordPtr);
+            break;
+        }
+        json_decref(recordPtr);
+
+        count++;
+        linePtr = endPtr + 1;
     }
 
-    /* Parse the file (JSON) */
-    root = json_loads(bufferPtr, 0, &error);
     free(bufferPtr);
 
-    filePtr = json_object_get(root, JSON_FILE_FIELD_FILES);
-    if (!filePtr)
+    LE_DEBUG("%"PRIuS" records replayed from %s", count, FILESTREAM_FILE_INDEX_JOURNAL);
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the file index: the snapshots of the file lists, updated by the journal
+ */
+//--------------------------------------------------------------------------------------------------
+static void LoadFileIndex
+(
+    void
+)
+{
+    FileEntryPoolRef = le_mem_CreatePool("File entry pool", sizeof(FileEntry_t));
+    le_mem_ExpandPool(FileEntryPoolRef, LE_FILESTREAMSERVER_FILE_MAX_NUMBER + 1);
+
+    LoadSnapshot(&StoredFiles);
+    LoadSnapshot(&DownloadFiles);
+
+    // Fold the journal into new snapshots, which also creates the snapshots if they are missing.
+    // A journal that could not be fully replayed is dropped as well: its remaining records can't
+    // be trusted.
+    if ((ReplayJournal() > 0)
+     || le_fs_Exists(FILESTREAM_FILE_INDEX_JOURNAL)
+     || (!le_fs_Exists(FILESTREAM_FILE_LIST))
+     || (!le_fs_Exists(FILESTREAM_FILE_DOWNLOAD)))
     {
-        LE_ERROR("Error to find files array");
-        return LE_FAULT;
+        CompactFileIndex();
     }
+}
 
-    if(!json_is_array(filePtr))
+//--------------------------------------------------------------------------------------------------
+/**
+ * Delete a file stored in the file system
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteStoredFile
+(
+    const char* fileNamePtr         ///< [IN] File name
+)
+{
+    le_result_t result;
+    size_t len = LE_FILESTREAMCLIENT_FILE_NAME_MAX_BYTES
+                 + strlen(FILESTREAM_LEFS_DIR)
+                 + strlen(FILESTREAM_STORAGE_LEFS_DIR) + 10;
+    char namePtr[len];
+
+    snprintf(namePtr,
+             len,
+             "%s%s/%s",
+             FILESTREAM_LEFS_DIR,
+             FILESTREAM_STORAGE_LEFS_DIR,
+             fileNamePtr);
+
+    result = le_fs_Delete(namePtr);
+    if (LE_OK != result)
     {
-        LE_ERROR("Files is not an array");
-        json_decref(root);
-        return LE_FAULT;
+        LE_DEBUG("File %s was NOT deleted: %s", fileNamePtr, LE_RESULT_TXT(result));
+    }
+    else
+    {
+        LE_ERROR("File %s was deleted", fileNamePtr);
     }
+}
 
-    length = json_array_size(filePtr);
-    // Check if the filename is not already present
-    for (i = 0; i < length; i++)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read file details from a file list
+ *
+ * @return
+ *  - LE_OK             The function succeeded
+ *  - LE_BAD_PARAMETER  Incorrect parameter provided
+ *  - LE_NOT_FOUND      The file is not present
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FileListRead
+(
+    FileList_t* listPtr,                    ///< [IN] File list
+    uint16_t    instanceId,                 ///< [IN] File instance
+    char*       fileNamePtr,                ///< [OUT] File name buffer
+    size_t      fileNameNumElements,        ///< [IN]  File name buffer size (\0 included)
+    char*       fileTopicPtr,               ///< [OUT] File topic buffer
+    size_t      fileTopicNumElements,       ///< [IN]  File topic buffer size (\0 included)
+    char*       fileHashPtr,                ///< [OUT] File hash buffer
+    size_t      fileHashNumElements,        ///< [IN]  File hash buffer size (\0 included)
+    uint64_t*   fileSizePtr,                ///< [OUT]  File size
+    uint8_t*    fileOriginPtr               ///< [OUT] File origin
+)
+{
+    FileEntry_t* entryPtr;
+
+    if ((LE_FILESTREAMSERVER_FILE_MAX_NUMBER < instanceId)
+     && (FILE_INSTANCE_ID_DOWNLOADING != instanceId))
     {
-        json_t* fileObjectPtr = json_array_get(filePtr, i);
+        return LE_BAD_PARAMETER;
+    }
 
-        json_t* jsonName = json_object_get(fileObjectPtr, JSON_FILE_FIELD_NAME);
-        const char *name = json_string_value(jsonName);
+    entryPtr = FindEntryByInstance(listPtr, instanceId);
+    if (!entryPtr)
+    {
+        return LE_NOT_FOUND;
+    }
 
-        if(name)
-        {
-            LE_DEBUG("file name: %s", name);
+    LE_DEBUG("file name: %s", entryPtr->name);
+    if (fileNamePtr && (fileNameNumElements >= strlen(entryPtr->name)))
+    {
+        snprintf(fileNamePtr, fileNameNumElements, "%s", entryPtr->name);
+    }
 
-            if (!strncmp(name, fileNamePtr, strlen(fileNamePtr)))
-            {
-                // Same file name, check the hash
-                json_t* jsonHash = json_object_get(fileObjectPtr, "hash");
-                const char *hash = json_string_value(jsonHash);
-                LE_DEBUG("file hash: %s", hash);
+    LE_DEBUG("file class: %s", entryPtr->topic);
+    if (fileTopicPtr && (fileTopicNumElements >= strlen(entryPtr->topic)))
+    {
+        snprintf(fileTopicPtr, fileTopicNumElements, "%s", entryPtr->topic);
+    }
 
-                if ((!strncmp(hash, hashPtr, strlen(hashPtr)))
-                 && (strncmp(jsonFileNamePtr, FILESTREAM_FILE_DOWNLOAD, strlen(jsonFileNamePtr))))
-                {
-                    LE_DEBUG("File already exists in the list");
-                    isFileAlreadyExists = true;
-                }
-                if ((!strlen(hash))
-                 && (!strncmp(jsonFileNamePtr, FILESTREAM_FILE_DOWNLOAD, strlen(jsonFileNamePtr))))
-                {
-                    LE_DEBUG("File already exists in the list");
-                    isFileAlreadyExists = true;
-                }
-            }
-        }
+    LE_DEBUG("file hash: %s", entryPtr->hash);
+    if (fileHashPtr && (fileHashNumElements >= strlen(entryPtr->hash)))
+    {
+        snprintf(fileHashPtr, fileHashNumElements, "%s", entryPtr->hash);
     }
 
-    if (!isFileAlreadyExists)
+    if (fileSizePtr)
     {
-        json_t* newFile = json_object();
-        if(newFile)
-        {
-            json_object_set_new(newFile, JSON_FILE_FIELD_NAME,           json_string(fileNamePtr));
-            json_object_set_new(newFile, JSON_FILE_FIELD_SIZE,           json_integer(fileSize));
-            json_object_set_new(newFile, JSON_FILE_FIELD_STATE,          json_string(statePtr));
-            json_object_set_new(newFile, JSON_FILE_FIELD_CLASS,          json_string(classPtr));
-            json_object_set_new(newFile, JSON_FILE_FIELD_HASH,           json_string(hashPtr));
-            json_object_set_new(newFile, JSON_FILE_FIELD_DIRECTION,      json_integer(direction));
-            json_object_set_new(newFile, JSON_FILE_FIELD_ORIGIN,         json_integer(origin));
-            json_object_set_new(newFile, JSON_FILE_FIELD_INSTANCE,       json_integer(instanceId));
-
-            json_array_append_new(filePtr, newFile);
-            isFileAdded = true;
-        }
+        *fileSizePtr = entryPtr->size;
+        LE_DEBUG("file size: %"PRIu64, *fileSizePtr);
+    }
+
+    if (fileOriginPtr)
+    {
+        *fileOriginPtr = entryPtr->origin;
+        LE_DEBUG("file origin: %d", *fileOriginPtr);
     }
 
-    LE_DEBUG("%s", json_dumps(root, JSON_COMPACT));
+    return LE_OK;
+}
 
-    if (isFileAdded)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Return all file instances of a file list
+ *
+ * @return
+ *  - LE_OK             The function succeeded
+ *  - LE_BAD_PARAMETER  Incorrect parameter provided
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FileListGetInstances
+(
+    FileList_t* listPtr,            ///< [IN] File list
+    uint16_t*   instanceListPtr,    ///< [OUT] File instance number list buffer
+    uint32_t*   instanceNbPtr       ///< [OUT] File instance number
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    if ((!instanceListPtr) || (!instanceNbPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    *instanceNbPtr = 0;
+
+    for (linkPtr = le_dls_Peek(&listPtr->entries);
+         (linkPtr != NULL) && (*instanceNbPtr < LE_FILESTREAMSERVER_FILE_MAX_NUMBER);
+         linkPtr = le_dls_PeekNext(&listPtr->entries, linkPtr))
+    {
+        instanceListPtr[(*instanceNbPtr)++] = CONTAINER_OF(linkPtr, FileEntry_t, link)->instanceId;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add one file in a file list
+ *
+ * @return
+ *  - LE_OK             The function succeeded
+ *  - LE_BAD_PARAMETER  Incorrect parameter provided
+ *  - LE_FAULT          The function failed
+ *  - LE_DUPLICATE      The file already exists
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FileListAdd
+(
+    FileList_t* listPtr,            ///< [IN] File list
+    const char* fileNamePtr,        ///< [IN] File name
+    const char* statePtr,           ///< [IN] File state
+    const char* classPtr,           ///< [IN] File class
+    const char* hashPtr,            ///< [IN] File hash
+    uint64_t    fileSize,           ///< [IN] File size
+    uint8_t     direction,          ///< [IN] File direction (0: download)
+    uint8_t     origin,             ///< [IN] File origin (0: server)
+    uint16_t    instanceId          ///< [IN] Instance Id
+)
+{
+    FileEntry_t* entryPtr;
+    le_dls_Link_t* linkPtr;
+
+    if ((!fileNamePtr) || (!statePtr) || (!classPtr) || (!hashPtr))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if ((strlen(statePtr) == (strlen(FILE_DOWNLOAD_NO_SIZE)))
+     && (!strncmp(statePtr, FILE_DOWNLOAD_NO_SIZE, strlen(statePtr))))
+    {
+        LE_INFO("New file transfer. File %s, class %s", fileNamePtr, classPtr);
+    }
+
+    LE_DEBUG("Add one file in %s", listPtr->snapshotPathPtr);
+    LE_DEBUG("File name: %s", fileNamePtr);
+    LE_DEBUG("File state: %s", statePtr);
+    LE_DEBUG("File class: %s", classPtr);
+    LE_DEBUG("File hash: %s", hashPtr);
+    LE_DEBUG("File direction: %d", direction);
+    LE_DEBUG("File origin: %d", origin);
+
+    // Check if the filename is not already present
+    for (linkPtr = le_dls_Peek(&listPtr->entries);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&listPtr->entries, linkPtr))
     {
-        if (LE_OK != WriteFs(jsonFileNamePtr,
-                             (uint8_t*)json_dumps(root, JSON_COMPACT),
-                             strlen(json_dumps(root, JSON_COMPACT))))
+        entryPtr = CONTAINER_OF(linkPtr, FileEntry_t, link);
+
+        if (!strncmp(entryPtr->name, fileNamePtr, strlen(fileNamePtr)))
         {
-            json_decref(root);
-            return LE_FAULT;
+            // Same file name, check the hash
+            if ((!strncmp(entryPtr->hash, hashPtr, strlen(hashPtr)))
+             && (listPtr != &DownloadFiles))
+            {
+                LE_DEBUG("File already exists in the list");
+                return LE_DUPLICATE;
+            }
+            if ((!strlen(entryPtr->hash)) && (listPtr == &DownloadFiles))
+            {
+                LE_DEBUG("File already exists in the list");
+                return LE_DUPLICATE;
+            }
         }
     }
 
-    json_decref(root);
+    entryPtr = le_mem_ForceAlloc(FileEntryPoolRef);
+    memset(entryPtr, 0, sizeof(FileEntry_t));
+    entryPtr->link = LE_DLS_LINK_INIT;
+    entryPtr->instanceId = instanceId;
+    le_utf8_Copy(entryPtr->name, fileNamePtr, sizeof(entryPtr->name), NULL);
+    le_utf8_Copy(entryPtr->topic, classPtr, sizeof(entryPtr->topic), NULL);
+    le_utf8_Copy(entryPtr->hash, hashPtr, sizeof(entryPtr->hash), NULL);
+    le_utf8_Copy(entryPtr->state, statePtr, sizeof(entryPtr->state), NULL);
+    entryPtr->size = fileSize;
+    entryPtr->direction = direction;
+    entryPtr->origin = origin;
+    le_dls_Queue(&listPtr->entries, &entryPtr->link);
 
-    if(isFileAlreadyExists)
+    if (listPtr == &DownloadFiles)
     {
-        return LE_DUPLICATE;
+        return JournalDownloadFiles();
     }
-
-    return LE_OK;
+    return JournalStoredFileAdded(entryPtr);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Update some file details in the JSON file list
+ * Update some details of the file being transferred
  *
  * @return
  *  - LE_OK             The function succeeded
@@ -786,414 +1302,172 @@ static le_result_t FileInfoFromJsonFileAdd
  *  - LE_FAULT          The function failed
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t FileInfoFromJsonFileUpdate
+static le_result_t DownloadListUpdate
 (
-    const char* jsonFileNamePtr,    ///< [IN] File name in which the file info need to be added
-    char*       fileNamePtr,        ///< [IN] File name
-    char*       statePtr,           ///< [IN] File state
+    const char* fileNamePtr,        ///< [IN] File name
+    const char* statePtr,           ///< [IN] File state
     int32_t     bytesLeft,          ///< [IN] Number of bytes left to be downloaded
     uint16_t    instanceId          ///< [IN] File instance Id (if not UINT16_MAX)
 )
 {
-    char* bufferPtr = NULL;
-    size_t bufferSize = 0;
-    int i = 0;
     bool isFileAlreadyExists = false;
-    size_t length;
-    json_error_t error;
-    json_t* filePtr;
-    json_t* root;
+    le_dls_Link_t* linkPtr;
 
-    if ((!jsonFileNamePtr) || (!fileNamePtr) || (!statePtr))
+    if ((!fileNamePtr) || (!statePtr))
     {
         return LE_BAD_PARAMETER;
     }
 
-    if (LE_OK != le_fs_GetSize(jsonFileNamePtr, &bufferSize))
-    {
-        LE_DEBUG("Error to get file %s size", jsonFileNamePtr);
-        return LE_FAULT;
-    }
-
     if ((strlen(statePtr) == (strlen(FILE_DOWNLOAD_PENDING)))
      && (!strncmp(statePtr, FILE_DOWNLOAD_PENDING, strlen(statePtr))))
     {
         LE_INFO("Pending transfer. File %s, bytes to be downloaded %d", fileNamePtr, bytesLeft);
     }
 
-    bufferPtr = calloc(bufferSize + 1, sizeof(char));
-
-    if (LE_OK != ReadFs(jsonFileNamePtr, (uint8_t*)bufferPtr, &bufferSize))
-    {
-        free(bufferPtr);
-        return LE_FAULT;
-    }
-
-    /* Parse the file (JSON) */
-    root = json_loads(bufferPtr, 0, &error);
-    free(bufferPtr);
-
-    filePtr = json_object_get(root, JSON_FILE_FIELD_FILES);
-    if (!filePtr)
-    {
-        LE_ERROR("Error to find files array");
-        return LE_FAULT;
-    }
-
-    if(!json_is_array(filePtr))
-    {
-        LE_ERROR("Files is not an array");
-        json_decref(root);
-        return LE_FAULT;
-    }
-
-    length = json_array_size(filePtr);
-    // Check if the filename is not already present
-    for (i = 0; i < length; i++)
+    for (linkPtr = le_dls_Peek(&DownloadFiles.entries);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&DownloadFiles.entries, linkPtr))
     {
-        json_t* fileObjectPtr = json_array_get(filePtr, i);
+        FileEntry_t* entryPtr = CONTAINER_OF(linkPtr, FileEntry_t, link);
 
-        json_t* tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_NAME);
-        const char *name = json_string_value(tempPtr);
-        LE_DEBUG("file name: %s", name);
-
-        if (!strncmp(name, fileNamePtr, strlen(fileNamePtr)))
+        if (strncmp(entryPtr->name, fileNamePtr, strlen(fileNamePtr)))
         {
-            LE_DEBUG("File already exists in the list");
-            isFileAlreadyExists = true;
+            LE_DEBUG("File name are different: %s - %s", entryPtr->name, fileNamePtr);
+            continue;
+        }
 
-            LE_DEBUG("Update download file json");
+        LE_DEBUG("Update download file %s", entryPtr->name);
+        isFileAlreadyExists = true;
 
-            // Only update the size if state = FILE_DOWNLOAD_PENDING
-            if (!strncmp(statePtr, FILE_DOWNLOAD_PENDING, strlen(FILE_DOWNLOAD_PENDING)))
-            {
-                tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_SIZE);
-                int size = 0;
-                if (tempPtr)
-                {
-                    size = json_integer_value(tempPtr);
-                }
-                if (!size)
-                {
-                    json_object_set_new(fileObjectPtr, JSON_FILE_FIELD_SIZE, json_integer(bytesLeft));
-                }
-            }
+        // Only update the size if state = FILE_DOWNLOAD_PENDING
+        if ((!strncmp(statePtr, FILE_DOWNLOAD_PENDING, strlen(FILE_DOWNLOAD_PENDING)))
+         && (0 == entryPtr->size))
+        {
+            entryPtr->size = bytesLeft;
+        }
 
-            json_object_set_new(fileObjectPtr, JSON_FILE_FIELD_STATE, json_string(statePtr));
+        le_utf8_Copy(entryPtr->state, statePtr, sizeof(entryPtr->state), NULL);
 
-            if (instanceId != FILE_INSTANCE_ID_DOWNLOADING)
-            {
-                json_object_set_new(fileObjectPtr,
-                                    JSON_FILE_FIELD_INSTANCE,
-                                    json_integer(instanceId));
-            }
-        }
-        else
+        if (instanceId != FILE_INSTANCE_ID_DOWNLOADING)
         {
-            LE_DEBUG("File name are different: %s - %s", name, fileNamePtr);
+            entryPtr->instanceId = instanceId;
         }
     }
 
-    LE_DEBUG("%s", json_dumps(root, JSON_COMPACT));
-
     if (isFileAlreadyExists)
     {
-        if (LE_OK != WriteFs(jsonFileNamePtr, (uint8_t*)json_dumps(root, JSON_COMPACT), strlen(json_dumps(root, JSON_COMPACT))))
-        {
-            json_decref(root);
-            return LE_FAULT;
-        }
+        return JournalDownloadFiles();
     }
 
-    json_decref(root);
     return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Update some file details in the JSON file list
+ * Check if a file is present in a file list
  *
  * @return
- *  - LE_OK             The function succeeded
+ *  - LE_OK             The file is present
  *  - LE_BAD_PARAMETER  Incorrect parameter provided
- *  - LE_FAULT          The function failed
  *  - LE_NOT_FOUND      The file is not present.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t FileInfoFromJsonFileCheckFileName
+static le_result_t FileListCheckFileName
 (
-    const char* jsonFileNamePtr,    ///< [IN] File name in which the file info need to be added
+    FileList_t* listPtr,            ///< [IN] File list
     const char* fileNamePtr,        ///< [IN] File name
     const char* fileHashPtr,        ///< [IN] File hash
-    uint16_t*   instanceIdPtr       ///< [IN] Instance Id if the file was found
+    uint16_t*   instanceIdPtr       ///< [OUT] Instance Id if the file was found
 )
 {
-    char* bufferPtr = NULL;
-    size_t bufferSize = 0;
-    int i = 0;
-    size_t length;
-    json_error_t error;
-    json_t* filePtr;
-    json_t* root;
+    le_dls_Link_t* linkPtr;
 
-    if ((!jsonFileNamePtr) || (!fileNamePtr))
+    if (!fileNamePtr)
     {
         return LE_BAD_PARAMETER;
     }
 
-    if (LE_OK != le_fs_GetSize(jsonFileNamePtr, &bufferSize))
-    {
-        LE_DEBUG("Error to get file %s size", jsonFileNamePtr);
-        return LE_FAULT;
-    }
-
-    bufferPtr = calloc(bufferSize + 1, sizeof(char));
-
-    if (LE_OK != ReadFs(jsonFileNamePtr, (uint8_t*)bufferPtr, &bufferSize))
-    {
-        free(bufferPtr);
-        return LE_FAULT;
-    }
-
-    /* Parse the file (JSON) */
-    root = json_loads(bufferPtr, 0, &error);
-    free(bufferPtr);
-
-    filePtr = json_object_get(root, JSON_FILE_FIELD_FILES);
-    if (!filePtr)
-    {
-        LE_ERROR("Error to find files array");
-        return LE_FAULT;
-    }
-
-    if(!json_is_array(filePtr))
+    for (linkPtr = le_dls_Peek(&listPtr->entries);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&listPtr->entries, linkPtr))
     {
-        LE_ERROR("Files is not an array");
-        json_decref(root);
-        return LE_FAULT;
-    }
+        FileEntry_t* entryPtr = CONTAINER_OF(linkPtr, FileEntry_t, link);
 
-    length = json_array_size(filePtr);
-    // Check if the filename is not already present
-    for (i = 0; i < length; i++)
-    {
-        bool isNameFound = false;
-        bool isHashFound = false;
-        const char* field;
-        json_t* fileObjectPtr = json_array_get(filePtr, i);
+        if (0 != strcmp(entryPtr->name, fileNamePtr))
+        {
+            continue;
+        }
 
-        json_t* tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_NAME);
-        if (tempPtr)
+        if (fileHashPtr && strlen(fileHashPtr)
+         && strncmp(entryPtr->hash, fileHashPtr, strlen(fileHashPtr)))
         {
-            field = json_string_value(tempPtr);
-            if ((field)
-             && (strlen(field) == strlen(fileNamePtr))
-             && (!strncmp(field, fileNamePtr, strlen(fileNamePtr)))
-             )
-            {
-                LE_DEBUG("File with same name already exists");
-                isNameFound = true;
-            }
+            continue;
         }
 
-        if (fileHashPtr && strlen(fileHashPtr))
+        if (fileHashPtr)
         {
-            tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_HASH);
-            if (tempPtr)
-            {
-                field = json_string_value(tempPtr);
-                if (field && (!strncmp(field, fileHashPtr, strlen(fileHashPtr))))
-                {
-                    LE_DEBUG("File with same hash already exists");
-                    isHashFound = true;
-                }
-            }
+            LE_DEBUG("File with same name and same hash already exists");
         }
         else
         {
-            isHashFound = true;
+            LE_DEBUG("File with same name (hash not checked) already exists");
         }
 
-        if (isNameFound && isHashFound)
+        if (instanceIdPtr)
         {
-            if (fileHashPtr)
-            {
-                LE_DEBUG("File with same name and same hash already exists");
-            }
-            else
-            {
-                LE_DEBUG("File with same name (hash not checked) already exists");
-            }
-            if (instanceIdPtr)
-            {
-                json_t* jsonInstancePtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_INSTANCE);
-                if (jsonInstancePtr)
-                {
-                    int instance = json_integer_value(jsonInstancePtr);
-                    *instanceIdPtr = (uint16_t)instance;
-                }
-            }
-            json_decref(root);
-            return LE_OK;
+            *instanceIdPtr = entryPtr->instanceId;
         }
+        return LE_OK;
     }
 
-    json_decref(root);
     return LE_NOT_FOUND;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Update some file details in the JSON file list
+ * Delete a file, and its entry in a file list
  *
  * @return
  *  - LE_OK             The function succeeded
- *  - LE_BAD_PARAMETER  Incorrect parameter provided
  *  - LE_FAULT          The function failed
  *  - LE_NOT_FOUND      The file is not present
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t FileInfoFromJsonFileDelete
+static le_result_t FileListDelete
 (
-    const char* jsonFileNamePtr,    ///< [IN] File name in which the file info need to be deleted
+    FileList_t* listPtr,            ///< [IN] File list
     uint16_t    Id                  ///< [IN] File instance
 )
 {
-    char* bufferPtr = NULL;
-    size_t bufferSize = 0;
-    bool isInstanceFound = false;
-    json_error_t error;
-    json_t* filePtr;
-    json_t* root;
-    int i = 0;
-    size_t length;
-
-    if (!jsonFileNamePtr)
-    {
-        return LE_BAD_PARAMETER;
-    }
-
-    if (LE_OK != le_fs_GetSize(jsonFileNamePtr, &bufferSize))
-    {
-        LE_DEBUG("Error to get file %s size", jsonFileNamePtr);
-        return LE_FAULT;
-    }
-
-    bufferPtr = calloc(bufferSize + 1, sizeof(char));
-
-    if (LE_OK != ReadFs(jsonFileNamePtr, (uint8_t*)bufferPtr, &bufferSize))
-    {
-        free(bufferPtr);
-        return LE_FAULT;
-    }
-
-    /* Parse the file (JSON) */
-    root = json_loads(bufferPtr, 0, &error);
-    free(bufferPtr);
+    FileEntry_t* entryPtr = FindEntryByInstance(listPtr, Id);
 
-    if (!root)
-    {
-        LE_ERROR("Error to parse the file list");
-        return LE_FAULT;
-    }
-
-    filePtr = json_object_get(root, JSON_FILE_FIELD_FILES);
-    if (!filePtr)
+    if (!entryPtr)
     {
-        LE_ERROR("Error to find files array");
-        json_decref(root);
-        return LE_FAULT;
+        return LE_NOT_FOUND;
     }
 
-    if(!json_is_array(filePtr))
-    {
-        LE_ERROR("Files is not an array");
-        json_decref(root);
-        return LE_FAULT;
-    }
+    DeleteStoredFile(entryPtr->name);
 
-    length = json_array_size(filePtr);
-    for (i = 0; i < length; i++)
+    // Indicate that the instance Id is available
+    if (Id < LE_FILESTREAMSERVER_FILE_MAX_NUMBER)
     {
-        json_t* fileObjectPtrPtr = json_array_get(filePtr, i);
-        json_t* jsonInstancePtr = json_object_get(fileObjectPtrPtr, JSON_FILE_FIELD_INSTANCE);
-        if (jsonInstancePtr)
-        {
-            int instance = json_integer_value(jsonInstancePtr);
-            if(instance == Id)
-            {
-                // Delete
-                isInstanceFound = true;
-
-                json_t* jsonFileName = json_object_get(fileObjectPtrPtr, JSON_FILE_FIELD_NAME);
-                const char* name = (char*)json_string_value(jsonFileName);
-                if(!name)
-                {
-                    LE_ERROR("File name is NULL");
-                }
-                else
-                {
-                    le_result_t result;
-                    size_t len = LE_FILESTREAMCLIENT_FILE_NAME_MAX_BYTES
-                                 + strlen(FILESTREAM_LEFS_DIR)
-                                 + strlen(FILESTREAM_STORAGE_LEFS_DIR) + 10;
-                    char namePtr[len];
-
-                    snprintf(namePtr,
-                             len,
-                             "%s%s/%s",
-                             FILESTREAM_LEFS_DIR,
-                             FILESTREAM_STORAGE_LEFS_DIR,
-                             name);
-
-                    result = le_fs_Delete(namePtr);
-                    if (LE_OK != result)
-                    {
-                        LE_DEBUG("File %s was NOT deleted: %s", name, LE_RESULT_TXT(result));
-                    }
-                    else
-                    {
-                        LE_ERROR("File %s was deleted", name);
-                    }
-
-                    // Indicate that the instance Id is available
-                    if (instance < LE_FILESTREAMSERVER_FILE_MAX_NUMBER)
-                    {
-                        IsFileInstanceUsed[instance] = false;
-                    }
-
-                    json_array_remove(filePtr, i);
-                    break;
-                }
-            }
-        }
+        IsFileInstanceUsed[Id] = false;
     }
 
-    LE_DEBUG("%s", json_dumps(root, JSON_COMPACT));
-
-    if (!isInstanceFound)
-    {
-        json_decref(root);
-        return LE_NOT_FOUND;
-    }
+    RemoveEntry(listPtr, entryPtr);
 
-    if (LE_OK != WriteFs(jsonFileNamePtr,
-                         (uint8_t*)json_dumps(root, JSON_COMPACT),
-                         strlen(json_dumps(root, JSON_COMPACT))))
+    if (listPtr == &DownloadFiles)
     {
-        json_decref(root);
-        return LE_FAULT;
+        return JournalDownloadFiles();
     }
-
-    json_decref(root);
-    return LE_OK;
+    return JournalStoredFileDeleted(Id);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Copy the file from FILESTREAM_FILE_DOWNLOAD to FILESTREAM_FILE_LIST
- * The FILESTREAM_FILE_LIST file only includes successfully downloaded files = available files
+ * Move the file from the download list to the stored file list
+ * The stored file list only includes successfully downloaded files = available files
  */
 //--------------------------------------------------------------------------------------------------
 static void MoveDownloadedFileToFileList
@@ -1201,143 +1475,31 @@ static void MoveDownloadedFileToFileList
     void
 )
 {
-    char* bufferPtr = NULL;
-    size_t bufferSize = 0;
-    int i = 0;
-    json_error_t error;
-    json_t* filePtr;
-    json_t* root;
-
-    const char *namePtr = "";
-    const char *statePtr = "";
-    const char *classPtr = "";
-    const char *hashPtr = "";
-    int size = 0;
-    int direction = 0;
-    int origin = 0;
-    int instance = 0;
-    json_t* tempPtr;
-
-    LE_DEBUG("Copy the downloaded file from %s to %s",
-             FILESTREAM_FILE_DOWNLOAD, FILESTREAM_FILE_LIST);
-
-    if (LE_OK != le_fs_GetSize(FILESTREAM_FILE_DOWNLOAD, &bufferSize))
-    {
-        LE_DEBUG("Error to get file %s size", FILESTREAM_FILE_DOWNLOAD);
-        return;
-    }
-
-    bufferPtr = calloc(bufferSize + 1, sizeof(char));
-
-    if (LE_OK != ReadFs(FILESTREAM_FILE_DOWNLOAD, (uint8_t*)bufferPtr, &bufferSize))
-    {
-        LE_DEBUG("Can not read %s", FILESTREAM_FILE_DOWNLOAD);
-        free(bufferPtr);
-        return;
-    }
-
-    /* Parse the file (JSON) */
-    root = json_loads(bufferPtr, 0, &error);
-    free(bufferPtr);
-
-    if (!root)
-    {
-        LE_ERROR("Error to parse the file list");
-        return;
-    }
-
-    filePtr = json_object_get(root, JSON_FILE_FIELD_FILES);
-    if (!filePtr)
-    {
-        LE_ERROR("Error to find files array");
-        json_decref(root);
-        return;
-    }
-
-    if(!json_is_array(filePtr))
-    {
-        LE_ERROR("Files is not an array");
-        json_decref(root);
-        return;
-    }
-
-    json_t* fileObjectPtr = json_array_get(filePtr, i);
-    if (NULL == fileObjectPtr)
-    {
-        LE_DEBUG("JSON error: not an array");
-    }
-
-    tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_NAME);
-    if (tempPtr)
-    {
-        namePtr = json_string_value(tempPtr);
-        LE_DEBUG("file name: %s", namePtr);
-    }
-
-    tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_SIZE);
-    if (tempPtr)
-    {
-        size = json_integer_value(tempPtr);
-        LE_DEBUG("file size: %d", size);
-    }
-
-    tempPtr= json_object_get(fileObjectPtr, JSON_FILE_FIELD_STATE);
-    if (tempPtr)
-    {
-        statePtr = json_string_value(tempPtr);
-        LE_DEBUG("file state: %s", statePtr);
-    }
-
-    tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_CLASS);
-    if (tempPtr)
-    {
-        classPtr = json_string_value(tempPtr);
-        LE_DEBUG("file class: %s", classPtr);
-    }
-
-    tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_HASH);
-    if (tempPtr)
-    {
-        hashPtr = json_string_value(tempPtr);
-        LE_DEBUG("file hash: %s", hashPtr);
-    }
-
-    tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_DIRECTION);
-    if (tempPtr)
-    {
-        int direction = json_integer_value(tempPtr);
-        LE_DEBUG("file direction: %d", direction);
-    }
-
-    tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_ORIGIN);
-    if (tempPtr)
-    {
-        origin = json_integer_value(tempPtr);
-        LE_DEBUG("file origin: %d", origin);
-    }
+    le_dls_Link_t* linkPtr = le_dls_Peek(&DownloadFiles.entries);
+    FileEntry_t* entryPtr;
 
-    tempPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_INSTANCE);
-    if (tempPtr)
+    if (!linkPtr)
     {
-        instance = json_integer_value(tempPtr);
-        LE_DEBUG("file origin: %d", origin);
+        LE_ERROR("No file in the download list");
+        return;
     }
+    entryPtr = CONTAINER_OF(linkPtr, FileEntry_t, link);
+
+    LE_DEBUG("Move the downloaded file %s to the file list", entryPtr->name);
 
-    if (LE_OK == FileInfoFromJsonFileAdd(FILESTREAM_FILE_LIST,
-                                         (char*)namePtr,
-                                         (char*)statePtr,
-                                         (char*)classPtr,
-                                         (char*)hashPtr,
-                                         size,
-                                         direction,
-                                         origin,
-                                         instance))
+    if (LE_OK == FileListAdd(&StoredFiles,
+                             entryPtr->name,
+                             entryPtr->state,
+                             entryPtr->topic,
+                             entryPtr->hash,
+                             entryPtr->size,
+                             entryPtr->direction,
+                             entryPtr->origin,
+                             entryPtr->instanceId))
     {
-        DeleteFs(FILESTREAM_FILE_DOWNLOAD);
-        CreateDefaultJsonFile(FILESTREAM_FILE_DOWNLOAD);
+        ClearList(&DownloadFiles);
+        JournalDownloadFiles();
     }
-
-    json_decref(root);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1361,8 +1523,8 @@ static void InitializeFileInstances
         IsFileInstanceUsed[loop] = false;
     }
 
-    // Read the FILESTREAM_FILE_LIST file in order to check which instance Ids are already used
-    ListFileInstanceFromJsonFile(FILESTREAM_FILE_LIST, fileInstanceList, &instanceNb);
+    // Check which instance Ids are already used by the stored files
+    FileListGetInstances(&StoredFiles, fileInstanceList, &instanceNb);
 
     for (loop = 0; loop < instanceNb; loop++)
     {
@@ -1545,6 +1707,309 @@ readRemainingBytes:
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move bytes between two file descriptors with splice(2), retrying if interrupted by a signal.
+ * One of the file descriptors must be a pipe.
+ *
+ * @return Number of bytes moved, 0 at end of file, or -1 on error (errno is set)
+ */
+//--------------------------------------------------------------------------------------------------
+static ssize_t SpliceFd
+(
+    int     inFd,                   ///< [IN] File descriptor to read
+    int     outFd,                  ///< [IN] File descriptor to write
+    size_t  len                     ///< [IN] Maximum number of bytes to move
+)
+{
+    ssize_t count;
+
+    do
+    {
+        count = splice(inFd, NULL, outFd, NULL, len, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    }
+    while ((-1 == count) && (EINTR == errno));
+
+    return count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the bytes waiting in the intermediate pipe to the storage file.  If the storage file system
+ * does not support splice(2), the bytes are copied to the storage file through le_fs instead.
+ *
+ * @return
+ *  - LE_OK             All the bytes were spliced
+ *  - LE_UNSUPPORTED    All the bytes were stored, but splice(2) is not supported by the storage
+ *  - LE_FAULT          The function failed
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MovePipeToStorage
+(
+    StreamContext_t*    streamCtxtPtr,  ///< [IN] Stream context
+    size_t              pending         ///< [IN] Number of bytes in the intermediate pipe
+)
+{
+    uint8_t buffer[READ_CHUNK_BYTES];
+    bool isSpliceSupported = true;
+
+    while (pending > 0)
+    {
+        ssize_t count;
+
+        if (isSpliceSupported)
+        {
+            count = SpliceFd(streamCtxtPtr->pipeFds[0], streamCtxtPtr->storageFd, pending);
+            if ((-1 == count) && (EINVAL == errno))
+            {
+                isSpliceSupported = false;
+                continue;
+            }
+            if (count > 0)
+            {
+                streamCtxtPtr->bytesReceived += count;
+            }
+        }
+        else
+        {
+            do
+            {
+                count = read(streamCtxtPtr->pipeFds[0],
+                             buffer,
+                             (pending < sizeof(buffer)) ? pending : sizeof(buffer));
+            }
+            while ((-1 == count) && (EINTR == errno));
+
+            if ((count > 0) && (LE_OK != WriteBytesToFd(streamCtxtPtr->fileRef, buffer, count)))
+            {
+                return LE_FAULT;
+            }
+        }
+
+        if (count <= 0)
+        {
+            LE_ERROR("Failed to store the received bytes: %m");
+            return LE_FAULT;
+        }
+        pending -= count;
+    }
+
+    return isSpliceSupported ? LE_OK : LE_UNSUPPORTED;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Splice the downloaded bytes from the read fd to the storage file, without copying them through
+ * user space.  A pipe is spliced straight to the storage file; other file descriptors go through
+ * the intermediate pipe of the stream.  This function should be called only when data is
+ * available on the read fd (example: EPOLLIN event triggered), and reads it until it would block.
+ *
+ * @return
+ *  - LE_OK if the available bytes are stored.
+ *  - LE_TERMINATED write end of update pipe is closed.
+ *  - LE_UNSUPPORTED if splice(2) is not supported by the read fd or the storage file system: the
+ *    bytes already read are stored, and the remaining bytes must be copied with CopyBytesToFd().
+ *  - LE_FAULT if there is an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SpliceBytesToFd
+(
+    StreamContext_t*    streamCtxtPtr,  ///< [IN] Stream context
+    ssize_t*            bytesCopied     ///< [OUT] Number of bytes stored on success
+)
+{
+    bool isPipe = (-1 == streamCtxtPtr->pipeFds[1]);
+
+    *bytesCopied = 0;
+
+    while (true)
+    {
+        ssize_t count = SpliceFd(streamCtxtPtr->readFd,
+                                 isPipe ? streamCtxtPtr->storageFd : streamCtxtPtr->pipeFds[1],
+                                 SPLICE_CHUNK_BYTES);
+
+        if (0 == count)
+        {
+            LE_INFO("Update pipe closed, finished storing; %zd bytes stored",
+                    streamCtxtPtr->bytesReceived);
+            return LE_TERMINATED;
+        }
+        else if (count > 0)
+        {
+            if (isPipe)
+            {
+                streamCtxtPtr->bytesReceived += count;
+            }
+            else
+            {
+                le_result_t result = MovePipeToStorage(streamCtxtPtr, count);
+                if (LE_OK != result)
+                {
+                    return result;
+                }
+            }
+            *bytesCopied += count;
+        }
+        else if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+        {
+            LE_DEBUG("No more data, wait for fd event: %d", streamCtxtPtr->readFd);
+            return LE_OK;
+        }
+        else if ((EINVAL == errno) || (ENOSYS == errno))
+        {
+            return LE_UNSUPPORTED;
+        }
+        else
+        {
+            LE_ERROR("Error while splicing fd: %d. %m", streamCtxtPtr->readFd);
+            return LE_FAULT;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the storage file of a download for splice(2), and reserve the space of the package.
+ *
+ * The file is opened without O_APPEND, which splice(2) does not support, and positioned at its
+ * end so that a resumed download is appended.  The space is reserved with fallocate(2) without
+ * changing the file size, which remains the resume position.  File systems that can't reserve
+ * space (like UBIFS) are written without reservation.
+ *
+ * @return
+ *  - LE_OK             The function succeeded
+ *  - LE_OUT_OF_RANGE   The storage is too small for the package
+ *  - LE_FAULT          The file can't be opened
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t OpenStorageFd
+(
+    const le_fileStreamClient_StreamMgmt_t* streamMgmtObj,  ///< [IN] Stream management object
+    int*                                    fdPtr           ///< [OUT] Storage file descriptor
+)
+{
+    char path[PATH_MAX];
+    struct stat st;
+    size_t len;
+    int fd;
+
+    if (LE_OK != pa_fileStream_GetPathStorage(path, sizeof(path)))
+    {
+        return LE_FAULT;
+    }
+    len = strlen(path);
+    if (snprintf(path + len, sizeof(path) - len, "/%s", streamMgmtObj->pkgName)
+        >= (int)(sizeof(path) - len))
+    {
+        return LE_FAULT;
+    }
+
+    fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (-1 == fd)
+    {
+        LE_DEBUG("Failed to open %s: %m", path);
+        return LE_FAULT;
+    }
+
+    if ((-1 == fstat(fd, &st)) || (-1 == lseek(fd, 0, SEEK_END)))
+    {
+        LE_ERROR("Failed to seek %s: %m", path);
+        close(fd);
+        return LE_FAULT;
+    }
+
+    if ((streamMgmtObj->pkgSize > (uint64_t)st.st_size)
+     && (-1 == fallocate(fd,
+                         FALLOC_FL_KEEP_SIZE,
+                         st.st_size,
+                         streamMgmtObj->pkgSize - st.st_size)))
+    {
+        if (ENOSPC == errno)
+        {
+            LE_ERROR("Not enough space for %s (%"PRIu64" bytes)",
+                     streamMgmtObj->pkgName, streamMgmtObj->pkgSize);
+            close(fd);
+            return LE_OUT_OF_RANGE;
+        }
+        LE_DEBUG("Space not reserved for %s: %m", path);
+    }
+
+    *fdPtr = fd;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prepare the stream context for splice(2): create the intermediate pipe if the read fd is not a
+ * pipe.  If the pipe can't be created, the storage fd is closed and the stream is copied instead.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrepareSplice
+(
+    StreamContext_t* streamCtxtPtr      ///< [IN] Stream context
+)
+{
+    struct stat st;
+
+    if ((-1 != fstat(streamCtxtPtr->readFd, &st)) && S_ISFIFO(st.st_mode))
+    {
+        return;
+    }
+
+    if (-1 == pipe2(streamCtxtPtr->pipeFds, O_CLOEXEC))
+    {
+        LE_WARN("Failed to create pipe, copying the stream: %m");
+        close(streamCtxtPtr->storageFd);
+        streamCtxtPtr->storageFd = -1;
+        streamCtxtPtr->pipeFds[0] = -1;
+        streamCtxtPtr->pipeFds[1] = -1;
+        return;
+    }
+
+    // A pipe holding a whole chunk lets each chunk be moved with one splice(2) on each side.
+    fcntl(streamCtxtPtr->pipeFds[1], F_SETPIPE_SZ, SPLICE_CHUNK_BYTES);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the file descriptors used for splice(2).  The data spliced to the storage file are
+ * flushed, and the space reserved beyond them is released.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CloseSpliceFds
+(
+    StreamContext_t* streamCtxtPtr      ///< [IN] Stream context
+)
+{
+    if (-1 != streamCtxtPtr->storageFd)
+    {
+        struct stat st;
+
+        if (-1 == fdatasync(streamCtxtPtr->storageFd))
+        {
+            LE_ERROR("Failed to sync the stored file: %m");
+        }
+
+        // Truncating to the current size frees the blocks reserved beyond it.
+        if ((-1 != fstat(streamCtxtPtr->storageFd, &st))
+         && (-1 == ftruncate(streamCtxtPtr->storageFd, st.st_size)))
+        {
+            LE_DEBUG("Failed to release the reserved space: %m");
+        }
+
+        close(streamCtxtPtr->storageFd);
+        streamCtxtPtr->storageFd = -1;
+    }
+
+    if (-1 != streamCtxtPtr->pipeFds[0])
+    {
+        close(streamCtxtPtr->pipeFds[0]);
+        close(streamCtxtPtr->pipeFds[1]);
+        streamCtxtPtr->pipeFds[0] = -1;
+        streamCtxtPtr->pipeFds[1] = -1;
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Wait for event on fd
@@ -1796,6 +2261,8 @@ static void CleanUp
         close(streamCtxtPtr->readFd);
     }
 
+    CloseSpliceFds(streamCtxtPtr);
+
     if (streamCtxtPtr->fileRef)
     {
         le_fs_Close(streamCtxtPtr->fileRef);
@@ -1854,6 +2321,11 @@ static le_result_t ProcessStream
             return LE_FAULT;
         }
 
+        if (-1 != StreamCtxtPtr->storageFd)
+        {
+            PrepareSplice(StreamCtxtPtr);
+        }
+
         // Still some data in the pipe. Finish reading it.
         while (true)
         {
@@ -1872,10 +2344,24 @@ static le_result_t ProcessStream
             }
 
             ssize_t bytesCopied = 0;
-            result = CopyBytesToFd(//StreamCtxtPtr->writeFd,
-                                   StreamCtxtPtr->fileRef,
-                                   StreamCtxtPtr->readFd,
-                                   &bytesCopied);
+            if (-1 != StreamCtxtPtr->storageFd)
+            {
+                result = SpliceBytesToFd(StreamCtxtPtr, &bytesCopied);
+                if (LE_UNSUPPORTED == result)
+                {
+                    LE_INFO("splice(2) not supported, copying the stream to the file");
+                    CloseSpliceFds(StreamCtxtPtr);
+                    result = CopyBytesToFd(StreamCtxtPtr->fileRef,
+                                           StreamCtxtPtr->readFd,
+                                           &bytesCopied);
+                }
+            }
+            else
+            {
+                result = CopyBytesToFd(StreamCtxtPtr->fileRef,
+                                       StreamCtxtPtr->readFd,
+                                       &bytesCopied);
+            }
 
             if (LE_TERMINATED == result)
             {
@@ -2011,29 +2497,29 @@ LE_SHARED le_result_t pa_fileStream_GetFileInfoByInstance
     }
 
     // Search in the download file
-    result = FileInfoFromJsonFileRead(FILESTREAM_FILE_DOWNLOAD,
-                                      instanceId,
-                                      fileNamePtr,
-                                      fileNameNumElements,
-                                      fileTopicPtr,
-                                      fileTopicNumElements,
-                                      fileHashPtr,
-                                      fileHashNumElements,
-                                      fileSizePtr,
-                                      fileOriginPtr);
+    result = FileListRead(&DownloadFiles,
+                          instanceId,
+                          fileNamePtr,
+                          fileNameNumElements,
+                          fileTopicPtr,
+                          fileTopicNumElements,
+                          fileHashPtr,
+                          fileHashNumElements,
+                          fileSizePtr,
+                          fileOriginPtr);
     if (LE_OK != result)
     {
         // Search in the file list
-        result = FileInfoFromJsonFileRead(FILESTREAM_FILE_LIST,
-                                          instanceId,
-                                          fileNamePtr,
-                                          fileNameNumElements,
-                                          fileTopicPtr,
-                                          fileTopicNumElements,
-                                          fileHashPtr,
-                                          fileHashNumElements,
-                                          fileSizePtr,
-                                          fileOriginPtr);
+        result = FileListRead(&StoredFiles,
+                              instanceId,
+                              fileNamePtr,
+                              fileNameNumElements,
+                              fileTopicPtr,
+                              fileTopicNumElements,
+                              fileHashPtr,
+                              fileHashNumElements,
+                              fileSizePtr,
+                              fileOriginPtr);
     }
     return result;
 }
@@ -2196,6 +2682,16 @@ LE_SHARED le_result_t pa_fileStream_Download
     // Set the stream context
     StreamContext.readFd = readFd;
     StreamContext.fileRef = fileRef;
+    StreamContext.storageFd = -1;
+    StreamContext.pipeFds[0] = -1;
+    StreamContext.pipeFds[1] = -1;
+
+    // Without a storage fd, the stream is copied through le_fs.
+    if (LE_OUT_OF_RANGE == OpenStorageFd(streamMgmtObj, &StreamContext.storageFd))
+    {
+        le_fs_Close(fileRef);
+        return LE_FAULT;
+    }
     strncpy(StreamContext.topic,
             streamMgmtObj->pkgTopic,
             LE_FILESTREAMCLIENT_FILE_TOPIC_MAX_BYTES);
@@ -2237,28 +2733,27 @@ LE_SHARED void pa_fileStream_DownloadStatus
          // Get the stream management object
         instanceId = FILE_INSTANCE_ID_DOWNLOADING;
         fileStreamClient_GetStreamMgmtObject(instanceId, (le_fileStreamClient_StreamMgmt_t*)&streamMgmtObj);
-        result = FileInfoFromJsonFileAdd(FILESTREAM_FILE_DOWNLOAD,
-                                         streamMgmtObj.pkgName,
-                                         FILE_DOWNLOAD_NO_SIZE,
-                                         streamMgmtObj.pkgTopic,
-                                         streamMgmtObj.hash,
-                                         streamMgmtObj.pkgSize,
-                                         streamMgmtObj.direction,
-                                         streamMgmtObj.origin,
-                                         streamMgmtObj.instanceId);
+        result = FileListAdd(&DownloadFiles,
+                             streamMgmtObj.pkgName,
+                             FILE_DOWNLOAD_NO_SIZE,
+                             streamMgmtObj.pkgTopic,
+                             streamMgmtObj.hash,
+                             streamMgmtObj.pkgSize,
+                             streamMgmtObj.direction,
+                             streamMgmtObj.origin,
+                             streamMgmtObj.instanceId);
         if (LE_DUPLICATE == result)
         {
-            DeleteFs(FILESTREAM_FILE_DOWNLOAD);
-            CreateDefaultJsonFile(FILESTREAM_FILE_DOWNLOAD);
-            result = FileInfoFromJsonFileAdd(FILESTREAM_FILE_DOWNLOAD,
-                                         streamMgmtObj.pkgName,
-                                         FILE_DOWNLOAD_NO_SIZE,
-                                         streamMgmtObj.pkgTopic,
-                                         streamMgmtObj.hash,
-                                         streamMgmtObj.pkgSize,
-                                         streamMgmtObj.direction,
-                                         streamMgmtObj.origin,
-                                         streamMgmtObj.instanceId);
+            ClearList(&DownloadFiles);
+            result = FileListAdd(&DownloadFiles,
+                                 streamMgmtObj.pkgName,
+                                 FILE_DOWNLOAD_NO_SIZE,
+                                 streamMgmtObj.pkgTopic,
+                                 streamMgmtObj.hash,
+                                 streamMgmtObj.pkgSize,
+                                 streamMgmtObj.direction,
+                                 streamMgmtObj.origin,
+                                 streamMgmtObj.instanceId);
         }
         return;
     }
@@ -2293,20 +2788,18 @@ LE_SHARED void pa_fileStream_DownloadStatus
 
         case LE_FILESTREAMCLIENT_DOWNLOAD_PENDING:
         {
-            FileInfoFromJsonFileUpdate(FILESTREAM_FILE_DOWNLOAD,
-                                       streamMgmtObj.pkgName,
-                                       FILE_DOWNLOAD_PENDING,
-                                       bytesLeft,
-                                       FILE_INSTANCE_ID_DOWNLOADING);
+            DownloadListUpdate(streamMgmtObj.pkgName,
+                               FILE_DOWNLOAD_PENDING,
+                               bytesLeft,
+                               FILE_INSTANCE_ID_DOWNLOADING);
         }
         break;
 
         case LE_FILESTREAMCLIENT_DOWNLOAD_IN_PROGRESS:
-            FileInfoFromJsonFileUpdate(FILESTREAM_FILE_DOWNLOAD,
-                                       streamMgmtObj.pkgName,
-                                       FILE_DOWNLOAD_ON_GOING,
-                                       0,
-                                       FILE_INSTANCE_ID_DOWNLOADING);
+            DownloadListUpdate(streamMgmtObj.pkgName,
+                               FILE_DOWNLOAD_ON_GOING,
+                               0,
+                               FILE_INSTANCE_ID_DOWNLOADING);
             break;
 
         case LE_FILESTREAMCLIENT_DOWNLOAD_COMPLETED:
@@ -2323,19 +2816,18 @@ LE_SHARED void pa_fileStream_DownloadStatus
                 LE_DEBUG("Set new file instance Id: %d", newInstanceId);
                 IsFileInstanceUsed[newInstanceId] = true;
             }
-            FileInfoFromJsonFileUpdate(FILESTREAM_FILE_DOWNLOAD,
-                                       streamMgmtObj.pkgName,
-                                       FILE_DOWNLOAD_SUCCESS,
-                                       0,
-                                       newInstanceId);
-            // Copy the file from FILESTREAM_FILE_DOWNLOAD to FILESTREAM_FILE_LIST
+            DownloadListUpdate(streamMgmtObj.pkgName,
+                               FILE_DOWNLOAD_SUCCESS,
+                               0,
+                               newInstanceId);
+            // Move the file from the download list to the stored file list
             MoveDownloadedFileToFileList();
         }
         break;
 
         case LE_FILESTREAMCLIENT_DOWNLOAD_FAILED:
-            // The download failed, so the FILESTREAM_FILE_DOWNLOAD file can be reset
-            FileInfoFromJsonFileDelete(FILESTREAM_FILE_DOWNLOAD, FILE_INSTANCE_ID_DOWNLOADING);
+            // The download failed, so the download file list can be reset
+            FileListDelete(&DownloadFiles, FILE_INSTANCE_ID_DOWNLOADING);
 
             break;
 
@@ -2438,11 +2930,11 @@ LE_SHARED le_result_t pa_fileStream_DeleteFileByInstance
     }
 
     // Search in the download file
-    result = FileInfoFromJsonFileDelete(FILESTREAM_FILE_DOWNLOAD, instanceId);
-    if (LE_OK != result)
+    result = FileListDelete(&DownloadFiles, instanceId);
+    if (LE_NOT_FOUND == result)
     {
         // Search in the file list
-        result = FileInfoFromJsonFileDelete(FILESTREAM_FILE_LIST, instanceId);
+        result = FileListDelete(&StoredFiles, instanceId);
     }
     return result;
 }
@@ -2462,133 +2954,48 @@ LE_SHARED le_result_t pa_fileStream_Delete
     const char* fileNamePtr      ///< [IN] File name
 )
 {
-    char* bufferPtr = NULL;
-    size_t bufferSize = 0;
     bool isInstanceFound = false;
-    int i = 0;
-    int length;
-    json_error_t error;
-    json_t* filePtr;
-    json_t* root;
+    le_dls_Link_t* linkPtr;
 
     if (!fileNamePtr)
     {
         return LE_BAD_PARAMETER;
     }
 
-    if (LE_OK != le_fs_GetSize(FILESTREAM_FILE_LIST, &bufferSize))
-    {
-        LE_DEBUG("Error to get file %s size", FILESTREAM_FILE_LIST);
-        return LE_FAULT;
-    }
-
-    bufferPtr = calloc(bufferSize + 1, sizeof(char));
-
-    if (LE_OK != ReadFs(FILESTREAM_FILE_LIST, (uint8_t*)bufferPtr, &bufferSize))
-    {
-        free(bufferPtr);
-        return LE_FAULT;
-    }
-
-    /* Parse the file (JSON) */
-    root = json_loads(bufferPtr, 0, &error);
-    free(bufferPtr);
-
-    if (!root)
+    linkPtr = le_dls_Peek(&StoredFiles.entries);
+    while (linkPtr != NULL)
     {
-        LE_ERROR("Error to parse the file list");
-        return LE_FAULT;
-    }
+        FileEntry_t* entryPtr = CONTAINER_OF(linkPtr, FileEntry_t, link);
+        uint16_t instanceId = entryPtr->instanceId;
 
-    filePtr = json_object_get(root, JSON_FILE_FIELD_FILES);
-    if (!filePtr)
-    {
-        LE_ERROR("Error to find files array");
-        json_decref(root);
-        return LE_FAULT;
-    }
+        linkPtr = le_dls_PeekNext(&StoredFiles.entries, linkPtr);
 
-    if(!json_is_array(filePtr))
-    {
-        LE_ERROR("Files is not an array");
-        json_decref(root);
-        return LE_FAULT;
-    }
+        if (0 != strcmp(fileNamePtr, entryPtr->name))
+        {
+            continue;
+        }
 
-    length = json_array_size(filePtr);
-    for (i=(length-1); i>=0; i--)
-    {
-        json_t* fileObjectPtr = json_array_get(filePtr, i);
-        json_t* jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_NAME);
-        const char* name = (char*)json_string_value(jsonFieldPtr);
+        isInstanceFound = true;
+        DeleteStoredFile(fileNamePtr);
 
-        if(!name)
+        // Indicate that the instance Id is available
+        if (instanceId < LE_FILESTREAMSERVER_FILE_MAX_NUMBER)
         {
-            LE_ERROR("File name is NULL");
+            IsFileInstanceUsed[instanceId] = false;
         }
-        else
-        {
-            size_t size = strlen(fileNamePtr) > strlen(name) ? strlen(fileNamePtr) : strlen(name);
-            if(!strncmp(fileNamePtr, name, size))
-            {
-                le_result_t result;
-                int instanceId = 0;
-                size_t len = LE_FILESTREAMCLIENT_FILE_NAME_MAX_BYTES
-                            + strlen(FILESTREAM_LEFS_DIR)
-                            + strlen(FILESTREAM_STORAGE_LEFS_DIR)
-                            + 10;
-                char namePtr[len];
-
-                // Delete
-                isInstanceFound = true;
-
-                snprintf(namePtr,
-                         len,
-                         "%s%s/%s",
-                         FILESTREAM_LEFS_DIR,
-                         FILESTREAM_STORAGE_LEFS_DIR,
-                         fileNamePtr);
-                result =  le_fs_Delete(namePtr);
-                if (LE_OK != result)
-                {
-                    LE_DEBUG("File %s was NOT deleted: %s", name, LE_RESULT_TXT(result));
-                }
-                else
-                {
-                    LE_ERROR("File %s was deleted", name);
-                }
-
-                jsonFieldPtr = json_object_get(fileObjectPtr, JSON_FILE_FIELD_INSTANCE);
-                if(jsonFieldPtr)
-                {
-                    instanceId = json_integer_value(jsonFieldPtr);
-                    // Indicate that the instance Id is available
-                    if (instanceId < LE_FILESTREAMSERVER_FILE_MAX_NUMBER)
-                    {
-                        IsFileInstanceUsed[instanceId] = false;
-                    }
-                }
 
-                json_array_remove(filePtr, i);
-            }
+        RemoveEntry(&StoredFiles, entryPtr);
+        if (LE_OK != JournalStoredFileDeleted(instanceId))
+        {
+            return LE_FAULT;
         }
     }
 
-    LE_DEBUG("%s", json_dumps(root, JSON_COMPACT));
-
     if (!isInstanceFound)
     {
-        json_decref(root);
         return LE_BAD_PARAMETER;
     }
 
-    if (LE_OK != WriteFs(FILESTREAM_FILE_LIST, (uint8_t*)json_dumps(root, JSON_COMPACT), strlen(json_dumps(root, JSON_COMPACT))))
-    {
-        json_decref(root);
-        return LE_FAULT;
-    }
-
-    json_decref(root);
     return LE_OK;
 }
 
@@ -2647,10 +3054,10 @@ LE_SHARED le_result_t pa_fileStream_GetFileInstanceList
         return LE_BAD_PARAMETER;
     }
 
-    // Only get the instance ID list from FILESTREAM_FILE_LIST file.
-    // FILESTREAM_FILE_DOWNLOAD includes only one file which is downloading which instance ID
+    // Only get the instance ID list from the stored file list.
+    // The download file list includes only one file which is downloading which instance ID
     // is DOWNLOADING_FILE_INSTANCE_ID
-    ListFileInstanceFromJsonFile(FILESTREAM_FILE_LIST, fileInstancePtr, &instanceNb);
+    FileListGetInstances(&StoredFiles, fileInstancePtr, &instanceNb);
     step += instanceNb;
     *fileInstancedNumElementsPtr = (size_t)step;
     return LE_OK;
@@ -2730,18 +3137,12 @@ LE_SHARED le_result_t pa_fileStream_IsFilePresent
         return LE_BAD_PARAMETER;
     }
 
-    result = FileInfoFromJsonFileCheckFileName(FILESTREAM_FILE_DOWNLOAD,
-                                               fileNamePtr,
-                                               fileHashPtr,
-                                               instanceIdPtr);
+    result = FileListCheckFileName(&DownloadFiles, fileNamePtr, fileHashPtr, instanceIdPtr);
     LE_DEBUG("Check file name %s in %s return %d (%s)",
              fileNamePtr, FILESTREAM_FILE_DOWNLOAD, result, LE_RESULT_TXT(result));
     if (LE_OK != result)
     {
-        result = FileInfoFromJsonFileCheckFileName(FILESTREAM_FILE_LIST,
-                                                   fileNamePtr,
-                                                   fileHashPtr,
-                                                   instanceIdPtr);
+        result = FileListCheckFileName(&StoredFiles, fileNamePtr, fileHashPtr, instanceIdPtr);
         LE_DEBUG("Check file name %s in %s return %d (%s)",
                  fileNamePtr, FILESTREAM_FILE_LIST, result, LE_RESULT_TXT(result));
     }
@@ -2917,10 +3318,7 @@ LE_SHARED le_result_t pa_fileStream_StartStream
         return LE_BAD_PARAMETER;
     }
 
-    result = FileInfoFromJsonFileCheckFileName(FILESTREAM_FILE_LIST,
-                                               fileNamePtr,
-                                               NULL,
-                                               NULL);
+    result = FileListCheckFileName(&StoredFiles, fileNamePtr, NULL, NULL);
     LE_DEBUG("Check file name %s in %s return %d (%s)",
              fileNamePtr, FILESTREAM_FILE_LIST, result, LE_RESULT_TXT(result));
 
@@ -3042,9 +3440,7 @@ LE_SHARED void pa_fileStream_Init
 
     LE_ASSERT(StreamObjPoolRef);
 
-    CreateDefaultJsonFile(FILESTREAM_FILE_LIST);
-    CreateDefaultJsonFile(FILESTREAM_FILE_DOWNLOAD);
-
+    LoadFileIndex();
     InitializeFileInstances();
 
     StreamObjTable = le_hashmap_Create("Stream object Table",
@@ -37,6 +37,26 @@ typedef struct
 }
 Request_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stream of data between a client file descriptor and a range of blocks of a partition.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int                     fd;            ///< Service end of the socket pair
+    le_fdMonitor_Ref_t      fdMonitor;     ///< Monitor of the socket, NULL if no stream
+    bool                    isWrite;       ///< True if the data are written to the flash
+    uint32_t                blockIndex;    ///< Next logical block index to be read or written
+    uint32_t                blockEnd;      ///< Logical block index after the end of the range
+    size_t                  blockSize;     ///< Size of data read or written by block
+    uint8_t*                bufPtr;        ///< Block buffer
+    size_t                  bufLen;        ///< Length of data in the block buffer
+    size_t                  bufOffset;     ///< Length of data already sent from the block buffer
+    uint32_t                size;          ///< Number of bytes read from or written to the flash
+}
+Stream_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Internal partition information and descriptor to access the Flash MTD or UBI.
@@ -64,6 +84,13 @@ typedef struct
     le_dualsys_System_t     systemMask;    ///< System owning the partion, (modem, lk or linux)
     pa_flash_Info_t*        mtdInfo;       ///< Global MTD information
     pa_flash_EccStats_t     statsAtOpen;   ///< ECC stats and bad block at open time
+    Stream_t                stream;        ///< Stream in progress, if any
+    le_flash_StreamEndHandlerFunc_t streamEndHandler;
+                                           ///< Handler called at the end of the streams
+    void*                   streamEndContextPtr;
+                                           ///< Context of the stream end handler
+    le_flash_StreamEndHandlerRef_t streamEndHandlerRef;
+                                           ///< Reference of the stream end handler
 }
 Partition_t;
 
@@ -81,6 +108,20 @@ static le_mem_PoolRef_t PartitionPool = NULL;
 //--------------------------------------------------------------------------------------------------
 static le_ref_MapRef_t PartitionRefMap = NULL;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pool for allocating the block buffers of the streams.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t StreamBufferPool = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A map of safe references to the partitions having a stream end handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_ref_MapRef_t StreamHandlerRefMap = NULL;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Memory pool for allocating request count by client.
@@ -326,6 +367,35 @@ static le_result_t ParseUbiVolumeNameAndGetVolId
     return -1 != partPtr->ubiVolume ? LE_OK : LE_NOT_FOUND;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a stream is in progress on a MTD, through any of the partitions open on it.
+ *
+ * @return
+ *      - true             If a stream is in progress
+ *      - false            Otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsStreamInProgress
+(
+    int mtdNum    ///< [IN] MTD number
+)
+{
+    le_ref_IterRef_t iter = le_ref_GetIterator(PartitionRefMap);
+    Partition_t* partPtr;
+
+    while (LE_OK == le_ref_NextNode(iter))
+    {
+        partPtr = (Partition_t *)le_ref_GetValue(iter);
+        if ((partPtr) && (mtdNum == partPtr->mtdNum) && (NULL != partPtr->stream.fdMonitor))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Open the MTD device and fill the Partition_t structure with all parameters for all functions.
@@ -362,6 +432,13 @@ static le_result_t Open
         goto err;
     }
 
+    // Creating the UBI rewrites the whole partition
+    if ((isUbiToCreate) && (IsStreamInProgress(partPtr->mtdNum)))
+    {
+        res = LE_BUSY;
+        goto err;
+    }
+
     partPtr->isRead = mode & (PA_FLASH_OPENMODE_READONLY | PA_FLASH_OPENMODE_READWRITE);
     partPtr->isWrite = mode & (PA_FLASH_OPENMODE_WRITEONLY | PA_FLASH_OPENMODE_READWRITE);
     mode |= PA_FLASH_OPENMODE_MARKBAD;
@@ -435,7 +512,319 @@ err:
     le_mem_Release(partPtr);
     *partitionRef = NULL;
     return ((LE_NOT_FOUND != res) && (LE_BAD_PARAMETER != res) &&
-            (LE_DUPLICATE != res) ? LE_FAULT : res);
+            (LE_DUPLICATE != res) && (LE_BUSY != res) ? LE_FAULT : res);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read data from a logical block of a partition or of its UBI volume.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_FAULT         On error
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadBlock
+(
+    Partition_t* partPtr,       ///< [IN] Partition descriptor
+    uint32_t     blockIndex,    ///< [IN] Logical block index to be read.
+    uint8_t*     dataPtr,       ///< [OUT] Data buffer to copy the read data.
+    size_t*      dataSizePtr    ///< [INOUT] Data size to be read/data size really read
+)
+{
+    le_result_t res;
+    size_t readSize;
+
+    if (partPtr->isUbi)
+    {
+        readSize = partPtr->mtdInfo->eraseSize - (2 * partPtr->mtdInfo->writeSize);
+        if (*dataSizePtr < readSize)
+        {
+            readSize = *dataSizePtr;
+        }
+        res = pa_flash_ReadUbiAtBlock(partPtr->desc, blockIndex, dataPtr, &readSize);
+        if (LE_OK != res)
+        {
+            LE_ERROR("Ubi Volume %u Partition \"%s\" MTD%d: Read failed at blockIndex %u,"
+                     " dataSize %"PRIuS": %d",
+                     partPtr->ubiVolume,
+                     partPtr->partitionName,
+                     partPtr->mtdNum,
+                     (unsigned int) blockIndex,
+                     readSize, res);
+            res = LE_FAULT;
+        }
+        *dataSizePtr = readSize;
+    }
+    else
+    {
+        res = pa_flash_ReadAtBlock( partPtr->desc, blockIndex, dataPtr, *dataSizePtr);
+        if (LE_OK != res)
+        {
+            LE_ERROR("Partition \"%s\" MTD%d: Read failed at blockIndex %u, dataSize %"PRIuS": %d",
+                     partPtr->partitionName,
+                     partPtr->mtdNum,
+                     (unsigned int) blockIndex,
+                     *dataSizePtr, res);
+            res = LE_FAULT;
+        }
+    }
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Erase and write data to a logical block of a partition or of its UBI volume.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_FAULT         On error
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteBlock
+(
+    Partition_t*   partPtr,         ///< [IN] Partition descriptor
+    uint32_t       blockIndex,      ///< [IN] Logical block index to be written.
+    const uint8_t* dataPtr,         ///< [IN] Data buffer to be written.
+    size_t         dataSize         ///< [IN] Data size to be written
+)
+{
+    le_result_t res;
+
+    if (partPtr->isUbi)
+    {
+        LE_INFO("MTD%d BlockIndex %u WriteDataSize %zu", partPtr->mtdNum, blockIndex, dataSize);
+        res = pa_flash_WriteUbiAtBlock(partPtr->desc, blockIndex,
+                                       (uint8_t*)dataPtr, dataSize, true);
+        if (LE_OK != res)
+        {
+            LE_ERROR("Ubi Volume %u Partition \"%s\" MTD%d: Write failed at blockIndex %u,"
+                     " dataSize %"PRIuS": %d",
+                     partPtr->ubiVolume,
+                     partPtr->partitionName,
+                     partPtr->mtdNum,
+                     (unsigned int) blockIndex,
+                     dataSize,
+                     res);
+            res = LE_FAULT;
+        }
+    }
+    else
+    {
+        res = pa_flash_EraseBlock( partPtr->desc, blockIndex );
+        if (LE_OK != res)
+        {
+            LE_ERROR("Partition \"%s\" MTD%d: Erase failed at blockIndex %u",
+                     partPtr->partitionName, partPtr->mtdNum, blockIndex);
+            return LE_FAULT;
+        }
+        res = pa_flash_WriteAtBlock( partPtr->desc, blockIndex, (uint8_t*)dataPtr, dataSize);
+        if (LE_OK != res)
+        {
+            LE_ERROR("Partition \"%s\" MTD%d: Write failed at blockIndex %u, dataSize %"PRIuS": %d",
+                     partPtr->partitionName,
+                     partPtr->mtdNum,
+                     (unsigned int) blockIndex,
+                     dataSize,
+                     res);
+            res = LE_FAULT;
+        }
+    }
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop the stream in progress on a partition: close the service end of the socket pair and
+ * release the block buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StopStream
+(
+    Partition_t* partPtr    ///< [IN] Partition descriptor
+)
+{
+    Stream_t* streamPtr = &partPtr->stream;
+
+    le_fdMonitor_Delete(streamPtr->fdMonitor);
+    close(streamPtr->fd);
+    le_mem_Release(streamPtr->bufPtr);
+    memset(streamPtr, 0, sizeof(Stream_t));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * End the stream in progress on a partition and report its result to the stream end handler.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndStream
+(
+    Partition_t* partPtr,   ///< [IN] Partition descriptor
+    le_result_t  result     ///< [IN] Result of the stream
+)
+{
+    uint32_t size = partPtr->stream.size;
+
+    LE_INFO("Partition \"%s\" MTD%d: %s stream ended at block %u, %u bytes: %s",
+            partPtr->partitionName, partPtr->mtdNum, partPtr->stream.isWrite ? "Write" : "Read",
+            partPtr->stream.blockIndex, size, LE_RESULT_TXT(result));
+
+    StopStream(partPtr);
+
+    if (NULL != partPtr->streamEndHandler)
+    {
+        partPtr->streamEndHandler(partPtr->ref, result, size, partPtr->streamEndContextPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move a read stream forward: read the next block once the previous one is entirely sent, and
+ * send as much of its data as the socket accepts. Only one block is read at a time, so that the
+ * other requests are not delayed by a long stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessReadStream
+(
+    Partition_t* partPtr,   ///< [IN] Partition descriptor
+    short        events     ///< [IN] Events reported on the socket
+)
+{
+    Stream_t* streamPtr = &partPtr->stream;
+    le_result_t res;
+    ssize_t count;
+
+    if (events & (POLLERR | POLLHUP))
+    {
+        EndStream(partPtr, LE_CLOSED);
+        return;
+    }
+
+    if (streamPtr->bufOffset == streamPtr->bufLen)
+    {
+        if (streamPtr->blockIndex == streamPtr->blockEnd)
+        {
+            EndStream(partPtr, LE_OK);
+            return;
+        }
+
+        streamPtr->bufLen = streamPtr->blockSize;
+        res = ReadBlock(partPtr, streamPtr->blockIndex, streamPtr->bufPtr, &streamPtr->bufLen);
+        if (LE_OK != res)
+        {
+            EndStream(partPtr, res);
+            return;
+        }
+        streamPtr->bufOffset = 0;
+        streamPtr->blockIndex++;
+        streamPtr->size += streamPtr->bufLen;
+    }
+
+    count = send(streamPtr->fd, streamPtr->bufPtr + streamPtr->bufOffset,
+                 streamPtr->bufLen - streamPtr->bufOffset, MSG_NOSIGNAL);
+    if (-1 == count)
+    {
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno))
+        {
+            return;
+        }
+        LE_ERROR("Partition \"%s\" MTD%d: Send to stream failed: %m",
+                 partPtr->partitionName, partPtr->mtdNum);
+        EndStream(partPtr, (EPIPE == errno) ? LE_CLOSED : LE_FAULT);
+        return;
+    }
+    streamPtr->bufOffset += count;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move a write stream forward: gather the data received from the socket into the block buffer,
+ * and write it to the flash once full or at the end of file.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ProcessWriteStream
+(
+    Partition_t* partPtr,   ///< [IN] Partition descriptor
+    short        events     ///< [IN] Events reported on the socket
+)
+{
+    Stream_t* streamPtr = &partPtr->stream;
+    le_result_t res;
+    ssize_t count;
+
+    if (events & POLLERR)
+    {
+        EndStream(partPtr, LE_FAULT);
+        return;
+    }
+
+    // Data which remain to be read after a hang-up are read before the end of file.
+    count = recv(streamPtr->fd, streamPtr->bufPtr + streamPtr->bufLen,
+                 streamPtr->blockSize - streamPtr->bufLen, 0);
+    if (-1 == count)
+    {
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno))
+        {
+            return;
+        }
+        LE_ERROR("Partition \"%s\" MTD%d: Receive from stream failed: %m",
+                 partPtr->partitionName, partPtr->mtdNum);
+        EndStream(partPtr, LE_FAULT);
+        return;
+    }
+
+    if ((count > 0) && (streamPtr->blockIndex == streamPtr->blockEnd))
+    {
+        LE_ERROR("Partition \"%s\" MTD%d: Data beyond block %u",
+                 partPtr->partitionName, partPtr->mtdNum, streamPtr->blockEnd);
+        EndStream(partPtr, LE_OVERFLOW);
+        return;
+    }
+    streamPtr->bufLen += count;
+
+    // Write a full block, or the last one at the end of file
+    if ((streamPtr->bufLen == streamPtr->blockSize) || ((0 == count) && (streamPtr->bufLen)))
+    {
+        res = WriteBlock(partPtr, streamPtr->blockIndex, streamPtr->bufPtr, streamPtr->bufLen);
+        if (LE_OK != res)
+        {
+            EndStream(partPtr, res);
+            return;
+        }
+        streamPtr->blockIndex++;
+        streamPtr->size += streamPtr->bufLen;
+        streamPtr->bufLen = 0;
+    }
+
+    if (0 == count)
+    {
+        EndStream(partPtr, LE_OK);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handler for the events of the socket of a stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StreamFdHandler
+(
+    int   fd,       ///< [IN] Service end of the socket pair
+    short events    ///< [IN] Events reported on the socket
+)
+{
+    Partition_t* partPtr = le_fdMonitor_GetContextPtr();
+
+    if (partPtr->stream.isWrite)
+    {
+        ProcessWriteStream(partPtr, events);
+    }
+    else
+    {
+        ProcessReadStream(partPtr, events);
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -499,6 +888,13 @@ static le_result_t Close
 {
     le_result_t res;
 
+    if (NULL != partPtr->stream.fdMonitor)
+    {
+        LE_WARN("Aborting stream on partition \"%s\" MTD%d at block %u",
+                partPtr->partitionName, partPtr->mtdNum, partPtr->stream.blockIndex);
+        StopStream(partPtr);
+    }
+
     if ((partPtr->isUbi) && (-1 != partPtr->ubiVolume))
     {
         // The UBI volume is open. Force it to be closed.
@@ -509,6 +905,10 @@ static le_result_t Close
     res = pa_flash_Close(partPtr->desc);
     if (LE_OK == res)
     {
+        if (NULL != partPtr->streamEndHandlerRef)
+        {
+            le_ref_DeleteRef(StreamHandlerRefMap, partPtr->streamEndHandlerRef);
+        }
         le_ref_DeleteRef(PartitionRefMap, partPtr->ref);
         le_mem_Release(partPtr);
     }
@@ -560,6 +960,121 @@ static Partition_t* GetPartitionFromRef
     return partPtr;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a stream between a range of blocks of a partition and a socket pair, the client end of
+ * which is returned.
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is already in progress on this partition
+ *      - LE_FAULT         On other error
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t OpenStream
+(
+    le_flash_PartitionRef_t partitionRef,   ///< [IN] Partition reference to be used.
+    bool                    isWrite,        ///< [IN] True to write the data to the flash
+    uint32_t                blockIndex,     ///< [IN] First logical block index of the range.
+    uint32_t                blockCount,     ///< [IN] Number of blocks of the range, 0 for all.
+    int*                    fdPtr           ///< [OUT] Client end of the socket pair.
+)
+{
+    Partition_t *partPtr = GetPartitionFromRef(partitionRef);
+    Stream_t* streamPtr;
+    uint32_t blockEnd;
+    size_t blockSize;
+    int fds[2];
+    int flags;
+
+    if ((NULL == partPtr) || (NULL == fdPtr) ||
+        ((isWrite) && (!partPtr->isWrite)) || ((!isWrite) && (!partPtr->isRead)) ||
+        ((partPtr->isUbi) && (-1 == partPtr->ubiVolume)))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    if (NULL != partPtr->stream.fdMonitor)
+    {
+        LE_ERROR("Partition \"%s\" MTD%d: A stream is already in progress",
+                 partPtr->partitionName, partPtr->mtdNum);
+        return LE_BUSY;
+    }
+
+    if (partPtr->isUbi)
+    {
+        uint32_t freeBlock, allocatedBlock, volumeSize;
+
+        blockSize = partPtr->mtdInfo->eraseSize - (2 * partPtr->mtdInfo->writeSize);
+        if (isWrite)
+        {
+            // The volume is extended as needed
+            blockEnd = UINT32_MAX;
+        }
+        else if (LE_OK != pa_flash_GetUbiInfo(partPtr->desc,
+                                              &freeBlock, &allocatedBlock, &volumeSize))
+        {
+            return LE_FAULT;
+        }
+        else
+        {
+            blockEnd = allocatedBlock;
+        }
+    }
+    else
+    {
+        blockSize = partPtr->mtdInfo->eraseSize;
+        blockEnd = partPtr->mtdInfo->nbLeb;
+    }
+
+    if ((blockIndex > blockEnd) || (blockSize > LE_FLASH_MAX_READ_SIZE))
+    {
+        return LE_BAD_PARAMETER;
+    }
+    if ((blockCount) && (blockCount < (blockEnd - blockIndex)))
+    {
+        blockEnd = blockIndex + blockCount;
+    }
+
+    // A socket pair rather than a pipe, to get an error instead of a SIGPIPE if the client closes
+    // its end of a read stream.
+    if (-1 == socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds))
+    {
+        LE_ERROR("Failed to create stream socket pair: %m");
+        return LE_FAULT;
+    }
+    flags = fcntl(fds[0], F_GETFL);
+    if ((-1 == flags) || (-1 == fcntl(fds[0], F_SETFL, flags | O_NONBLOCK)))
+    {
+        LE_ERROR("Failed to set stream socket non-blocking: %m");
+        close(fds[0]);
+        close(fds[1]);
+        return LE_FAULT;
+    }
+
+    streamPtr = &partPtr->stream;
+    memset(streamPtr, 0, sizeof(Stream_t));
+    streamPtr->fd = fds[0];
+    streamPtr->isWrite = isWrite;
+    streamPtr->blockIndex = blockIndex;
+    streamPtr->blockEnd = blockEnd;
+    streamPtr->blockSize = blockSize;
+    streamPtr->bufPtr = le_mem_ForceAlloc(StreamBufferPool);
+    streamPtr->fdMonitor = le_fdMonitor_Create("FlashStream", fds[0], StreamFdHandler,
+                                               isWrite ? POLLIN : POLLOUT);
+    le_fdMonitor_SetContextPtr(streamPtr->fdMonitor, partPtr);
+
+    LE_INFO("Partition \"%s\" MTD%d: %s stream from block %u to %u, block size %"PRIuS,
+            partPtr->partitionName, partPtr->mtdNum, isWrite ? "Write" : "Read",
+            blockIndex, blockEnd, blockSize);
+
+    // The client end is closed once sent to the client
+    *fdPtr = fds[1];
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * A handler for client disconnects which frees all resources associated with the client.
@@ -633,6 +1148,8 @@ static void PartitionInit
     {
         PartitionPool = le_mem_CreatePool("Flash Partition Pool", sizeof(Partition_t));
         PartitionRefMap = le_ref_CreateMap("Flash Partition Ref Map", MAX_PARTITION_REF);
+        StreamBufferPool = le_mem_CreatePool("Flash Stream Buffer Pool", LE_FLASH_MAX_READ_SIZE);
+        StreamHandlerRefMap = le_ref_CreateMap("Flash Stream Handler Ref Map", MAX_PARTITION_REF);
 
         // Register a handler to be notified when clients disconnect
         le_msg_AddServiceCloseHandler(le_flash_GetServiceRef(), CloseClientPartitions, NULL);
@@ -949,6 +1466,7 @@ le_result_t le_flash_OpenUbi
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is in progress on this partition
  *      - LE_FAULT         On failure
  *
  */
@@ -967,6 +1485,11 @@ le_result_t le_flash_OpenUbiVolume
     {
         return LE_BAD_PARAMETER;
     }
+
+    if (NULL != partPtr->stream.fdMonitor)
+    {
+        return LE_BUSY;
+    }
     LE_INFO("Opening UBI volume '%s' partition \"%s\" MTD%d",
             volumeName, partPtr->partitionName, partPtr->mtdNum);
 
@@ -997,6 +1520,7 @@ le_result_t le_flash_OpenUbiVolume
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is in progress on this partition
  *      - LE_FAULT         On failure
  *
  */
@@ -1013,6 +1537,11 @@ le_result_t le_flash_CloseUbiVolume
         return LE_BAD_PARAMETER;
     }
 
+    if (NULL != partPtr->stream.fdMonitor)
+    {
+        return LE_BUSY;
+    }
+
     LE_INFO("Closing UBI volume %d partition \"%s\" MTD%d",
             partPtr->ubiVolume, partPtr->partitionName, partPtr->mtdNum);
 
@@ -1053,6 +1582,7 @@ le_result_t le_flash_Close
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is in progress on this partition
  *      - LE_FAULT         On other error
  */
 //--------------------------------------------------------------------------------------------------
@@ -1070,6 +1600,11 @@ le_result_t le_flash_EraseBlock
         return LE_BAD_PARAMETER;
     }
 
+    if (NULL != partPtr->stream.fdMonitor)
+    {
+        return LE_BUSY;
+    }
+
     LE_INFO("Erasing block %u in partition \"%s\" MTD%d",
             blockIndex, partPtr->partitionName, partPtr->mtdNum);
 
@@ -1095,6 +1630,7 @@ le_result_t le_flash_EraseBlock
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
  *      - LE_NOT_PERMITTED If the partition is an UBI and no UBI volume has been open
+ *      - LE_BUSY          If a stream is in progress on this partition
  *      - LE_FAULT         On other error
  */
 //--------------------------------------------------------------------------------------------------
@@ -1107,53 +1643,23 @@ le_result_t le_flash_Read
 )
 {
     Partition_t *partPtr = GetPartitionFromRef(partitionRef);
-    le_result_t res;
-    size_t readSize;
 
     if ((NULL == partPtr) || !(partPtr->isRead) || (NULL == readData) || (NULL == readDataSizePtr))
     {
         return LE_BAD_PARAMETER;
     }
 
-    if (partPtr->isUbi)
+    if ((partPtr->isUbi) && (-1 == partPtr->ubiVolume))
     {
-        if (-1 == partPtr->ubiVolume)
-        {
-            return LE_BAD_PARAMETER;
-        }
-        readSize = partPtr->mtdInfo->eraseSize - (2 * partPtr->mtdInfo->writeSize);
-        if (*readDataSizePtr < readSize)
-        {
-            readSize = *readDataSizePtr;
-        }
-        res = pa_flash_ReadUbiAtBlock(partPtr->desc, blockIndex, readData, &readSize);
-        if (LE_OK != res)
-        {
-            LE_ERROR("Ubi Volume %u Partition \"%s\" MTD%d: Read failed at blockIndex %u,"
-                     " dataSize %"PRIuS": %d",
-                     partPtr->ubiVolume,
-                     partPtr->partitionName,
-                     partPtr->mtdNum,
-                     (unsigned int) blockIndex,
-                     readSize, res);
-            res = LE_FAULT;
-        }
-        *readDataSizePtr = readSize;
+        return LE_BAD_PARAMETER;
     }
-    else
+
+    if (NULL != partPtr->stream.fdMonitor)
     {
-        res = pa_flash_ReadAtBlock( partPtr->desc, blockIndex, readData, *readDataSizePtr);
-        if (LE_OK != res)
-        {
-            LE_ERROR("Partition \"%s\" MTD%d: Read failed at blockIndex %u, dataSize %"PRIuS": %d",
-                     partPtr->partitionName,
-                     partPtr->mtdNum,
-                     (unsigned int) blockIndex,
-                     *readDataSizePtr, res);
-            res = LE_FAULT;
-        }
+        return LE_BUSY;
     }
-    return res;
+
+    return ReadBlock(partPtr, blockIndex, readData, readDataSizePtr);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1177,6 +1683,7 @@ le_result_t le_flash_Read
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is in progress on this partition
  *      - LE_FAULT         On other error
  */
 //--------------------------------------------------------------------------------------------------
@@ -1189,57 +1696,144 @@ le_result_t le_flash_Write
 )
 {
     Partition_t *partPtr = GetPartitionFromRef(partitionRef);
-    le_result_t res;
 
     if ((NULL == partPtr) || !(partPtr->isWrite) || (NULL == writeData))
     {
         return LE_BAD_PARAMETER;
     }
 
-    if (partPtr->isUbi)
+    if ((partPtr->isUbi) && (-1 == partPtr->ubiVolume))
     {
-        if (-1 == partPtr->ubiVolume)
-        {
-            return LE_BAD_PARAMETER;
-        }
-        LE_INFO("MTD%d BlockIndex %u WriteDataSize %zu", partPtr->mtdNum, blockIndex, writeDataSize);
-        res = pa_flash_WriteUbiAtBlock(partPtr->desc, blockIndex,
-                                       (uint8_t*)writeData, writeDataSize, true);
-        if (LE_OK != res)
-        {
-            LE_ERROR("Ubi Volume %u Partition \"%s\" MTD%d: Write failed at blockIndex %u,"
-                     " dataSize %"PRIuS": %d",
-                     partPtr->ubiVolume,
-                     partPtr->partitionName,
-                     partPtr->mtdNum,
-                     (unsigned int) blockIndex,
-                     writeDataSize,
-                     res);
-            res = LE_FAULT;
-        }
+        return LE_BAD_PARAMETER;
     }
-    else
+
+    if (NULL != partPtr->stream.fdMonitor)
     {
-        res = pa_flash_EraseBlock( partPtr->desc, blockIndex );
-        if (LE_OK != res)
-        {
-            LE_ERROR("Partition \"%s\" MTD%d: Erase failed at blockIndex %u",
-                     partPtr->partitionName, partPtr->mtdNum, blockIndex);
-            return LE_FAULT;
-        }
-        res = pa_flash_WriteAtBlock( partPtr->desc, blockIndex, (uint8_t*)writeData, writeDataSize);
-        if (LE_OK != res)
-        {
-            LE_ERROR("Partition \"%s\" MTD%d: Write failed at blockIndex %u, dataSize %"PRIuS": %d",
-                     partPtr->partitionName,
-                     partPtr->mtdNum,
-                     (unsigned int) blockIndex,
-                     writeDataSize,
-                     res);
-            res = LE_FAULT;
-        }
+        return LE_BUSY;
     }
-    return res;
+
+    return WriteBlock(partPtr, blockIndex, writeData, writeDataSize);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a stream to read data from a flash partition. The blocks of the given range are read one
+ * after the other, and their data written to the returned file descriptor. The end of file is
+ * reached after the last block of the range.
+ * - the range starts at the logical block index given by blockIndex.
+ * - the number of blocks to be read is given by blockCount, 0 meaning up to the last block of the
+ *   partition or of the UBI volume.
+ *
+ * @note
+ *      The end of the stream and its result are reported to the handler added by
+ *      le_flash_AddStreamEndHandler().
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is already in progress on this partition
+ *      - LE_FAULT         On other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_flash_OpenReadStream
+(
+    le_flash_PartitionRef_t partitionRef, ///< [IN] Partition reference to be used.
+    uint32_t                blockIndex,   ///< [IN] First logical block index to be read.
+    uint32_t                blockCount,   ///< [IN] Number of blocks to be read.
+    int*                    fdPtr         ///< [OUT] File descriptor to read the data from.
+)
+{
+    return OpenStream(partitionRef, false, blockIndex, blockCount, fdPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a stream to write data to a flash partition. The data written to the returned file
+ * descriptor are gathered into blocks, which are written one after the other as le_flash_Write()
+ * does. The last block is written when the file descriptor is closed by the client.
+ * - the range starts at the logical block index given by blockIndex.
+ * - the maximum number of blocks to be written is given by blockCount, 0 meaning up to the last
+ *   block of the partition. If more data are written, the stream ends with LE_OVERFLOW.
+ *
+ * @note
+ *      The end of the stream and its result are reported to the handler added by
+ *      le_flash_AddStreamEndHandler().
+ *
+ * @return
+ *      - LE_OK            On success
+ *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is already in progress on this partition
+ *      - LE_FAULT         On other error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_flash_OpenWriteStream
+(
+    le_flash_PartitionRef_t partitionRef, ///< [IN] Partition reference to be used.
+    uint32_t                blockIndex,   ///< [IN] First logical block index to be written.
+    uint32_t                blockCount,   ///< [IN] Maximum number of blocks to be written.
+    int*                    fdPtr         ///< [OUT] File descriptor to write the data to.
+)
+{
+    return OpenStream(partitionRef, true, blockIndex, blockCount, fdPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function adds a handler for the end of the streams of a partition. Only one handler can be
+ * added by partition.
+ */
+//--------------------------------------------------------------------------------------------------
+le_flash_StreamEndHandlerRef_t le_flash_AddStreamEndHandler
+(
+    le_flash_PartitionRef_t          partitionRef, ///< [IN] Partition reference.
+    le_flash_StreamEndHandlerFunc_t  handlerPtr,   ///< [IN] Handler pointer
+    void*                            contextPtr    ///< [IN] Associated context pointer
+)
+{
+    Partition_t *partPtr = GetPartitionFromRef(partitionRef);
+
+    if ((NULL == partPtr) || (NULL == handlerPtr))
+    {
+        LE_ERROR("Bad parameters");
+        return NULL;
+    }
+
+    if (NULL != partPtr->streamEndHandler)
+    {
+        LE_ERROR("Partition \"%s\" MTD%d: A stream end handler is already added",
+                 partPtr->partitionName, partPtr->mtdNum);
+        return NULL;
+    }
+
+    partPtr->streamEndHandler = handlerPtr;
+    partPtr->streamEndContextPtr = contextPtr;
+    partPtr->streamEndHandlerRef = le_ref_CreateRef(StreamHandlerRefMap, partPtr);
+
+    return partPtr->streamEndHandlerRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function removes a handler for the end of the streams of a partition.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_flash_RemoveStreamEndHandler
+(
+    le_flash_StreamEndHandlerRef_t handlerRef  ///< [IN] Handler reference
+)
+{
+    Partition_t *partPtr = le_ref_Lookup(StreamHandlerRefMap, handlerRef);
+
+    if ((NULL == partPtr) || (le_flash_GetClientSessionRef() != partPtr->client))
+    {
+        LE_ERROR("Invalid stream end handler reference %p", handlerRef);
+        return;
+    }
+
+    le_ref_DeleteRef(StreamHandlerRefMap, handlerRef);
+    partPtr->streamEndHandler = NULL;
+    partPtr->streamEndContextPtr = NULL;
+    partPtr->streamEndHandlerRef = NULL;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1324,6 +1918,7 @@ le_result_t le_flash_GetUbiVolumeInformation
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is in progress on the partition
  *      - LE_NOT_FOUND     If the flash partition is not found
  *      - LE_DUPLICATE     If the partition is already an UBI partition and isForcedCreate is not
  *                         set to true
@@ -1370,6 +1965,7 @@ le_result_t le_flash_CreateUbi
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is in progress on this partition
  *      - LE_NOT_PERMITTED If the UBI partition is not opened in write-only or read-write mode
  *      - LE_DUPLICATE     If the UBI volume already exists with a same name or a same volume ID
  *                         and isForcedCreate is not set to true
@@ -1399,6 +1995,11 @@ le_result_t le_flash_CreateUbiVolume
         return LE_BAD_PARAMETER;
     }
 
+    if (NULL != partPtr->stream.fdMonitor)
+    {
+        return LE_BUSY;
+    }
+
     LE_INFO("Creating UBI volume '%s' type %u partition \"%s\" MTD%d",
             volumeName, volumeType, partPtr->partitionName, partPtr->mtdNum);
 
@@ -1488,6 +2089,7 @@ le_result_t le_flash_CreateUbiVolume
  * @return
  *      - LE_OK            On success
  *      - LE_BAD_PARAMETER If a parameter is invalid
+ *      - LE_BUSY          If a stream is in progress on this partition
  *      - LE_NOT_PERMITTED If the UBI partition is not open in write-only or read-write mode
  *      - LE_NOT_FOUND     If the volume name is not found
  *      - LE_FAULT         On failure
@@ -1509,6 +2111,11 @@ le_result_t le_flash_DeleteUbiVolume
         return LE_BAD_PARAMETER;
     }
 
+    if (NULL != partPtr->stream.fdMonitor)
+    {
+        return LE_BUSY;
+    }
+
     res = ParseUbiVolumeNameAndGetVolId(volumeName, partPtr);
     if (LE_OK != res)
     {
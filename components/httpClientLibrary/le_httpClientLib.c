@@ -20,6 +20,7 @@
 #include "le_httpClientLib.h"
 #include "le_socketLib.h"
 #include "http.h"
+#include "sha256.h"
 
 //--------------------------------------------------------------------------------------------------
 // Symbol and Enum definitions
@@ -63,17 +64,59 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * HTTP request buffer size. This buffer is used internally when constructing HTTP requests.
+ * HTTP version at the start of the status line of a HTTP/1.0 response
  */
 //--------------------------------------------------------------------------------------------------
-#define REQUEST_BUFFER_SIZE         1024
+#define HTTP_1_0_VERSION            "HTTP/1.0"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * HTTP request buffer size. This buffer is used internally when constructing HTTP requests: the
+ * request line, header fields and body chunks are gathered in it before being sent.
+ */
+//--------------------------------------------------------------------------------------------------
+#define REQUEST_BUFFER_SIZE         LE_CONFIG_HTTPCLIENT_REQUEST_BUFFER_SIZE
 
 //--------------------------------------------------------------------------------------------------
 /**
  * HTTP response buffer size. This buffer is used internally when reading HTTP response.
  */
 //--------------------------------------------------------------------------------------------------
-#define RESPONSE_BUFFER_SIZE        1024
+#define RESPONSE_BUFFER_SIZE        LE_CONFIG_HTTPCLIENT_RESPONSE_BUFFER_SIZE
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of idle connections kept open to be reused by later HTTP sessions, and the time
+ * in seconds they are kept.
+ */
+//--------------------------------------------------------------------------------------------------
+#define IDLE_CONNECTIONS_NB         LE_CONFIG_HTTPCLIENT_IDLE_CONNECTION_MAX
+#define IDLE_CONNECTION_TIMEOUT     LE_CONFIG_HTTPCLIENT_IDLE_CONNECTION_TIMEOUT
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Chunk header of the chunked transfer encoding.  The chunk size is zero-padded to a fixed length,
+ * so that room can be reserved for the header before the size of the chunk is known.
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHUNK_HEADER_FORMAT         "%08X\r\n"
+#define CHUNK_HEADER_LEN            10
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * End of a chunk, and last chunk of a chunked body (without trailer)
+ */
+//--------------------------------------------------------------------------------------------------
+#define CHUNK_END                   CRLF
+#define LAST_CHUNK                  "0\r\n\r\n"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Minimum room left to the body construct callback in the request buffer.  When there is less room
+ * left after the header fields, they are sent first.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BODY_CHUNK_MIN_SIZE         (REQUEST_BUFFER_SIZE / 2)
 
 
 //--------------------------------------------------------------------------------------------------
@@ -100,6 +143,23 @@ typedef enum
 }
 HttpSessionState_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enum for secure connection settings.  Idle connections are only reused by HTTP sessions with the
+ * same settings.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    SECURITY_CERTIFICATE,      ///< Root CA certificate
+    SECURITY_OWN_CERTIFICATE,  ///< Module's own certificate
+    SECURITY_OWN_PRIVATE_KEY,  ///< Module's own private key
+    SECURITY_CIPHER_SUITES,    ///< Cipher suites index
+    SECURITY_AUTH_TYPE,        ///< Authentication type
+    SECURITY_TLS_VERSION       ///< TLS version
+}
+SecuritySetting_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Structure that defines TinyHTTP context
@@ -132,16 +192,51 @@ typedef struct
     TinyHttpCtx_t       tinyHttpCtx;               ///< TinyHTTP handler
     le_timer_Ref_t      timerRef;                  ///< Timer reference used as a timeout when
                                                    ///< receiving HTTP data from remote server
+    char                srcAddr[LE_MDC_IPV6_ADDR_MAX_BYTES]; ///< Source address of the session
+    uint32_t            timeout;                   ///< Communication timeout in milliseconds
+    sha256_Ctx_t        securityCtx;               ///< Digest of the secure connection settings
+    bool                isStarted;                 ///< True if the session has been started
+    bool                isConnected;               ///< True if the connection is open
+    bool                isKeepAlive;               ///< True if the connection can be reused after
+                                                   ///< the current response
+    bool                hasKeepAliveToken;         ///< True if the response has a keep-alive
+                                                   ///< connection option
+    char                rspVersion[sizeof(HTTP_1_0_VERSION) - 1]; ///< Start of the status line
+    size_t              rspVersionLen;             ///< Length of the data in rspVersion
+    bool                isChunked;                 ///< True to send request bodies with chunked
+                                                   ///< transfer encoding
+    size_t              txLength;                  ///< Length of the data in txBuffer
+    char                txBuffer[REQUEST_BUFFER_SIZE]; ///< Request data waiting to be sent
     le_httpClient_SendRequestRspCb_t responseCb;        ///< Asynchronous request result callback
     le_httpClient_BodyResponseCb_t   bodyResponseCb;    ///< User-defined callback: Body response
     le_httpClient_HeaderResponseCb_t headerResponseCb;  ///< User-defined callback: Header response
     le_httpClient_StatusCodeCb_t     statusCodeCb;      ///< User-defined callback: Status code
     le_httpClient_ResourceUpdateCb_t resourceUpdateCb;  ///< User-defined callback: Resources update
     le_httpClient_BodyConstructCb_t  bodyConstructCb;   ///< User-defined callback: Body construct
+    le_httpClient_BodySendCb_t       bodySendCb;        ///< User-defined callback: Body send
     le_httpClient_EventCb_t          eventCb;           ///< User-defined callback: Session events
 }
 HttpSessionCtx_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Structure that defines an idle connection, kept open after the deletion of its HTTP session to
+ * be reused by a later session to the same server.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_socket_Ref_t     socketRef;                 ///< Connected socket, NULL if the entry is free
+    char                host[HOST_ADDR_LEN];       ///< Host address of the remote server
+    uint16_t            port;                      ///< Port of the remote server
+    char                srcAddr[LE_MDC_IPV6_ADDR_MAX_BYTES]; ///< Source address
+    bool                isSecure;                  ///< True if the connection is secure
+    uint8_t             securityDigest[SHA256_DIGEST_LEN]; ///< Digest of the secure connection
+                                                           ///< settings
+    le_clk_Time_t       expiryTime;                ///< Time after which the connection is closed
+}
+IdleConnection_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Enum for HTTP command
@@ -221,6 +316,24 @@ static le_mem_PoolRef_t HttpSessionPoolRef = NULL;
 //--------------------------------------------------------------------------------------------------
  static le_ref_MapRef_t HttpSessionRefMap;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Idle connections which can be reused by new HTTP sessions.
+ *
+ * @note The sockets of the idle connections are handled through the socket library, whose
+ *       reference map is not protected against concurrent accesses: IdleConnectionsMutex only
+ *       protects the entries of this table, not the sockets they refer to.
+ */
+//--------------------------------------------------------------------------------------------------
+static IdleConnection_t IdleConnections[IDLE_CONNECTIONS_NB];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex protecting the entries of the idle connections table.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mutex_Ref_t IdleConnectionsMutex;
+
 //--------------------------------------------------------------------------------------------------
 // Internal functions
 //--------------------------------------------------------------------------------------------------
@@ -250,6 +363,7 @@ static HttpSessionCtx_t* NewHttpSessionContext
 
     // Zero-init HTTP session context
     memset(contextPtr, 0, sizeof(HttpSessionCtx_t));
+    sha256_Init(&contextPtr->securityCtx);
 
     // Create a safe reference for this object
     contextPtr->reference = le_ref_CreateRef(HttpSessionRefMap, contextPtr);
@@ -275,6 +389,364 @@ static void FreeHttpSessionContext
     le_mem_Release(contextPtr);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the connection of a HTTP session.  The session stays started: the connection is opened
+ * again by the next request.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CloseConnection
+(
+    HttpSessionCtx_t*    contextPtr    ///< [IN] HTTP session context pointer
+)
+{
+    if (contextPtr->isConnected)
+    {
+        le_socket_Disconnect(contextPtr->socketRef);
+        contextPtr->isConnected = false;
+    }
+    contextPtr->txLength = 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close an idle connection and free its entry.
+ *
+ * @note Must be called with IdleConnectionsMutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CloseIdleConnection
+(
+    IdleConnection_t*    idlePtr       ///< [IN] Idle connection
+)
+{
+    LE_DEBUG("Closing idle connection to %s:%u", idlePtr->host, idlePtr->port);
+
+    le_socket_Delete(idlePtr->socketRef);
+    memset(idlePtr, 0, sizeof(IdleConnection_t));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the idle connections which have expired.
+ *
+ * @note Must be called with IdleConnectionsMutex locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CloseExpiredIdleConnections
+(
+    void
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    int i;
+
+    for (i = 0; i < IDLE_CONNECTIONS_NB; i++)
+    {
+        if ((IdleConnections[i].socketRef) &&
+            (le_clk_GreaterThan(now, IdleConnections[i].expiryTime)))
+        {
+            CloseIdleConnection(&IdleConnections[i]);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the oldest idle connection, to free its socket.
+ *
+ * @return
+ *  - true if a connection has been closed, false if there is no idle connection.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool CloseOldestIdleConnection
+(
+    void
+)
+{
+    IdleConnection_t* oldestPtr = NULL;
+    int i;
+
+    le_mutex_Lock(IdleConnectionsMutex);
+
+    for (i = 0; i < IDLE_CONNECTIONS_NB; i++)
+    {
+        if ((IdleConnections[i].socketRef) &&
+            ((!oldestPtr) ||
+             (le_clk_GreaterThan(oldestPtr->expiryTime, IdleConnections[i].expiryTime))))
+        {
+            oldestPtr = &IdleConnections[i];
+        }
+    }
+
+    if (oldestPtr)
+    {
+        CloseIdleConnection(oldestPtr);
+    }
+
+    le_mutex_Unlock(IdleConnectionsMutex);
+
+    return (oldestPtr != NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Keep the connection of a HTTP session being deleted, so that a later session to the same server
+ * can reuse it.  The oldest idle connection is closed if there is no room left.
+ *
+ * @return
+ *  - true if the connection is kept (the session socket must not be deleted), false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool KeepIdleConnection
+(
+    HttpSessionCtx_t*    contextPtr    ///< [IN] HTTP session context pointer
+)
+{
+    IdleConnection_t* idlePtr = NULL;
+    le_clk_Time_t timeout = { .sec = IDLE_CONNECTION_TIMEOUT, .usec = 0 };
+    int i;
+
+    if ((!IDLE_CONNECTION_TIMEOUT) || (!contextPtr->isConnected) || (!contextPtr->isKeepAlive) ||
+        (contextPtr->state != STATE_IDLE) || (!le_socket_IsConnected(contextPtr->socketRef)))
+    {
+        return false;
+    }
+
+    le_mutex_Lock(IdleConnectionsMutex);
+
+    CloseExpiredIdleConnections();
+
+    for (i = 0; i < IDLE_CONNECTIONS_NB; i++)
+    {
+        if (!IdleConnections[i].socketRef)
+        {
+            idlePtr = &IdleConnections[i];
+        }
+        else if ((!idlePtr) ||
+                 ((idlePtr->socketRef) &&
+                  (le_clk_GreaterThan(idlePtr->expiryTime, IdleConnections[i].expiryTime))))
+        {
+            idlePtr = &IdleConnections[i];
+        }
+    }
+
+    if (idlePtr->socketRef)
+    {
+        CloseIdleConnection(idlePtr);
+    }
+
+    // The connection must not report events to the deleted session
+    if (le_socket_IsMonitoring(contextPtr->socketRef))
+    {
+        le_socket_SetMonitoring(contextPtr->socketRef, false);
+    }
+
+    idlePtr->socketRef = contextPtr->socketRef;
+    le_utf8_Copy(idlePtr->host, contextPtr->host, sizeof(idlePtr->host), NULL);
+    idlePtr->port = contextPtr->port;
+    le_utf8_Copy(idlePtr->srcAddr, contextPtr->srcAddr, sizeof(idlePtr->srcAddr), NULL);
+    idlePtr->isSecure = contextPtr->isSecure;
+    sha256_GetDigest(&contextPtr->securityCtx, idlePtr->securityDigest);
+    idlePtr->expiryTime = le_clk_Add(le_clk_GetRelativeTime(), timeout);
+
+    le_mutex_Unlock(IdleConnectionsMutex);
+
+    LE_DEBUG("Keeping idle connection to %s:%u", contextPtr->host, contextPtr->port);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take an idle connection to the server of a HTTP session, with the same source address and secure
+ * connection settings.
+ *
+ * @return
+ *  - Reference to the connected socket, or NULL if there is no such idle connection.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_socket_Ref_t TakeIdleConnection
+(
+    HttpSessionCtx_t*    contextPtr    ///< [IN] HTTP session context pointer
+)
+{
+    le_socket_Ref_t socketRef = NULL;
+    uint8_t securityDigest[SHA256_DIGEST_LEN];
+    int i;
+
+    sha256_GetDigest(&contextPtr->securityCtx, securityDigest);
+
+    le_mutex_Lock(IdleConnectionsMutex);
+
+    CloseExpiredIdleConnections();
+
+    for (i = 0; (i < IDLE_CONNECTIONS_NB) && (!socketRef); i++)
+    {
+        IdleConnection_t* idlePtr = &IdleConnections[i];
+
+        if ((!idlePtr->socketRef) ||
+            (idlePtr->port != contextPtr->port) ||
+            (idlePtr->isSecure != contextPtr->isSecure) ||
+            (memcmp(idlePtr->securityDigest, securityDigest, SHA256_DIGEST_LEN) != 0) ||
+            (strcmp(idlePtr->host, contextPtr->host) != 0) ||
+            (strcmp(idlePtr->srcAddr, contextPtr->srcAddr) != 0))
+        {
+            continue;
+        }
+
+        // The server may have closed the connection in the meantime
+        if (le_socket_IsConnected(idlePtr->socketRef))
+        {
+            socketRef = idlePtr->socketRef;
+            memset(idlePtr, 0, sizeof(IdleConnection_t));
+        }
+        else
+        {
+            CloseIdleConnection(idlePtr);
+        }
+    }
+
+    le_mutex_Unlock(IdleConnectionsMutex);
+
+    return socketRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Account for a secure connection setting of a HTTP session.  Idle connections are only reused by
+ * sessions with the same settings, which are told apart by their SHA-256 digest: unlike a CRC, it
+ * can't be matched by different certificates or keys.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddSecuritySetting
+(
+    HttpSessionCtx_t*    contextPtr,   ///< [IN] HTTP session context pointer
+    SecuritySetting_t    setting,      ///< [IN] Setting type
+    const uint8_t*       dataPtr,      ///< [IN] Setting data
+    size_t               dataLen       ///< [IN] Setting data length
+)
+{
+    uint8_t type = setting;
+    uint32_t length = dataLen;
+
+    // The length keeps the boundaries between the settings
+    sha256_Update(&contextPtr->securityCtx, &type, sizeof(type));
+    sha256_Update(&contextPtr->securityCtx, &length, sizeof(length));
+    sha256_Update(&contextPtr->securityCtx, dataPtr, dataLen);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send the request data gathered in the request buffer of a HTTP session.
+ *
+ * @return
+ *  - LE_OK            Function success
+ *  - LE_FAULT         Internal error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FlushRequest
+(
+    HttpSessionCtx_t*    contextPtr    ///< [IN] HTTP session context pointer
+)
+{
+    size_t length = contextPtr->txLength;
+
+    if (!length)
+    {
+        return LE_OK;
+    }
+
+    contextPtr->txLength = 0;
+    if (LE_OK != le_socket_Send(contextPtr->socketRef, contextPtr->txBuffer, length))
+    {
+        LE_ERROR("Unable to transmit request");
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append data to the request buffer of a HTTP session, sending the buffer first if there is not
+ * enough room left.
+ *
+ * @return
+ *  - LE_OK            Function success
+ *  - LE_FAULT         Internal error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t QueueRequest
+(
+    HttpSessionCtx_t*    contextPtr,   ///< [IN] HTTP session context pointer
+    const char*          dataPtr,      ///< [IN] Data pointer
+    size_t               length        ///< [IN] Data length
+)
+{
+    if (length > (sizeof(contextPtr->txBuffer) - contextPtr->txLength))
+    {
+        if (LE_OK != FlushRequest(contextPtr))
+        {
+            return LE_FAULT;
+        }
+
+        if (length > sizeof(contextPtr->txBuffer))
+        {
+            if (LE_OK != le_socket_Send(contextPtr->socketRef, dataPtr, length))
+            {
+                LE_ERROR("Unable to transmit request");
+                return LE_FAULT;
+            }
+            return LE_OK;
+        }
+    }
+
+    memcpy(contextPtr->txBuffer + contextPtr->txLength, dataPtr, length);
+    contextPtr->txLength += length;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make sure a started HTTP session is connected before sending a request: the connection is opened
+ * again if it has been closed, by the server or after the previous response.
+ *
+ * @return
+ *  - LE_OK            Function success
+ *  - Otherwise, the error returned by le_socket_Connect()
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t PrepareConnection
+(
+    HttpSessionCtx_t*    contextPtr    ///< [IN] HTTP session context pointer
+)
+{
+    le_result_t status;
+
+    if (!contextPtr->isStarted)
+    {
+        // Let the request fail as the session is not started
+        return LE_OK;
+    }
+
+    if (contextPtr->isConnected)
+    {
+        if (le_socket_IsConnected(contextPtr->socketRef))
+        {
+            return LE_OK;
+        }
+
+        LE_INFO("Connection closed by remote server, reconnecting");
+        CloseConnection(contextPtr);
+    }
+
+    status = le_socket_Connect(contextPtr->socketRef);
+    contextPtr->isConnected = (status == LE_OK);
+
+    return status;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * tinyHTTP callback for realloc
@@ -335,6 +807,58 @@ static void TinyHttpBodyRspCb
     }
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the value of a Connection header field, a comma-separated list of options, has an
+ * option.
+ *
+ * @return
+ *  - true if the option is in the list, false otherwise
+ */
+//--------------------------------------------------------------------------------------------------
+static bool HasConnectionOption
+(
+    const char* valuePtr,   ///< [IN] Header field value
+    int         nvalue,     ///< [IN] Header field value length
+    const char* optionPtr   ///< [IN] Option, in lowercase
+)
+{
+    size_t optionLen = strlen(optionPtr);
+    int start = 0;
+
+    while (start < nvalue)
+    {
+        int end = start;
+        int last;
+
+        while ((end < nvalue) && (valuePtr[end] != ','))
+        {
+            end++;
+        }
+
+        // Options are case-insensitive and may be surrounded by whitespace
+        last = end;
+        while ((start < last) && ((valuePtr[start] == ' ') || (valuePtr[start] == '\t')))
+        {
+            start++;
+        }
+        while ((last > start) && ((valuePtr[last - 1] == ' ') || (valuePtr[last - 1] == '\t')))
+        {
+            last--;
+        }
+
+        if (((size_t)(last - start) == optionLen) &&
+            (0 == strncasecmp(valuePtr + start, optionPtr, optionLen)))
+        {
+            return true;
+        }
+
+        start = end + 1;
+    }
+
+    return false;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * tinyHTTP callback for received data in HTTP header response
@@ -356,6 +880,19 @@ static void TinyHttpHeaderRspCb
         return;
     }
 
+    if ((nkey == (sizeof("connection") - 1)) && (0 == strncasecmp(keyPtr, "connection", nkey)))
+    {
+        // The server closes the connection after this response
+        if (HasConnectionOption(valuePtr, nvalue, "close"))
+        {
+            contextPtr->isKeepAlive = false;
+        }
+        if (HasConnectionOption(valuePtr, nvalue, "keep-alive"))
+        {
+            contextPtr->hasKeepAliveToken = true;
+        }
+    }
+
     if (contextPtr->headerResponseCb)
     {
         contextPtr->headerResponseCb(opaquePtr, keyPtr, nkey, valuePtr, nvalue);
@@ -431,7 +968,8 @@ static void TimeoutHandler
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Build HTTP request-line along with mandatory HTTP header resources and send it through socket.
+ * Build HTTP request-line along with mandatory HTTP header resources in the request buffer.  It is
+ * sent through socket along with the header fields.
  *
  * @return
  *  - LE_OK            Function success
@@ -445,7 +983,8 @@ static le_result_t BuildAndSendRequest
     char*                uriPtr        ///< [IN] URI buffer pointer
 )
 {
-    char buffer[REQUEST_BUFFER_SIZE] = {0};
+    char* buffer = contextPtr->txBuffer;
+    size_t size = sizeof(contextPtr->txBuffer);
     int length = 0;
     char* reqUriPtr = "";
     const char* IPV6COLON = ":";
@@ -467,26 +1006,31 @@ static le_result_t BuildAndSendRequest
     if( (char*)NULL != strstr(contextPtr->host, IPV6COLON) )
     {
         // The URI Host binding for ipv6 is with bracket and port number included
-        length = snprintf(buffer, sizeof(buffer), "%s /%s HTTP/1.1\r\n"
-                                              "Host: [%s]:%u\r\n",
-                                               SyntaxHttpCommandPtr[command],
-                                               reqUriPtr,
-                                               contextPtr->host,
-                                               contextPtr->port);
+        length = snprintf(buffer, size, "%s /%s HTTP/1.1\r\n"
+                                        "Host: [%s]:%u\r\n",
+                                         SyntaxHttpCommandPtr[command],
+                                         reqUriPtr,
+                                         contextPtr->host,
+                                         contextPtr->port);
 
     }
     else
     {
-        length = snprintf(buffer, sizeof(buffer), "%s /%s HTTP/1.1\r\n"
-                                              "host: %s:%d\r\n",
-                                               SyntaxHttpCommandPtr[command],
-                                               reqUriPtr,
-                                               contextPtr->host,
-                                               contextPtr->port);
+        length = snprintf(buffer, size, "%s /%s HTTP/1.1\r\n"
+                                        "host: %s:%d\r\n",
+                                         SyntaxHttpCommandPtr[command],
+                                         reqUriPtr,
+                                         contextPtr->host,
+                                         contextPtr->port);
     }
 
+    if ((length >= 0) && (length < size) && (contextPtr->isChunked) &&
+        ((command == HTTP_POST) || (command == HTTP_PUT)))
+    {
+        length += snprintf(buffer + length, size - length, "Transfer-Encoding: chunked\r\n");
+    }
 
-    if ((length < 0) || (length >= sizeof(buffer)))
+    if ((length < 0) || (length >= size))
     {
         LE_ERROR("Unable to construct request line");
         return LE_FAULT;
@@ -494,13 +1038,12 @@ static le_result_t BuildAndSendRequest
 
     // Save HTTP command request for later use
     contextPtr->command = command;
+    contextPtr->isKeepAlive = true;
+    contextPtr->hasKeepAliveToken = false;
+    contextPtr->rspVersionLen = 0;
 
-    // Send request through socket
-    if (LE_OK != le_socket_Send(contextPtr->socketRef, buffer, length))
-    {
-        LE_ERROR("Unable to transmit request");
-        return LE_FAULT;
-    }
+    // The request line is sent along with the header fields
+    contextPtr->txLength = length;
 
     return LE_OK;
 }
@@ -555,14 +1098,8 @@ static le_result_t BuildAndSendCredential
     le_utf8_Copy(buffer+length, CRLF, sizeof(buffer)-length, NULL);
     length += strlen(CRLF);
 
-    // Send request through socket
-    if (LE_OK != le_socket_Send(contextPtr->socketRef, buffer, length))
-    {
-        LE_ERROR("Unable to transmit request");
-        return LE_FAULT;
-    }
-
-    return LE_OK;
+    // Append header field to the request
+    return QueueRequest(contextPtr, buffer, length);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -647,19 +1184,152 @@ end:
         length += strlen(CRLF);
     }
 
-    // Send request through socket
-    if (LE_OK != le_socket_Send(contextPtr->socketRef, buffer, length))
+    // Append header field to the request
+    if (LE_OK != QueueRequest(contextPtr, buffer, length))
     {
-        LE_ERROR("Unable to transmit request");
         return LE_FAULT;
     }
 
+    // Send the request header, unless a body follows: its first chunk is sent along
+    if ((status == LE_TERMINATED) &&
+        (contextPtr->command != HTTP_POST) && (contextPtr->command != HTTP_PUT))
+    {
+        if (LE_OK != FlushRequest(contextPtr))
+        {
+            return LE_FAULT;
+        }
+    }
+
+    return status;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Terminate the body of the HTTP request and send the remaining request data through socket.
+ *
+ * @return
+ *  - LE_OK            Function success
+ *  - LE_FAULT         Internal error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t EndBody
+(
+    HttpSessionCtx_t*    contextPtr   ///< [IN] HTTP session context pointer
+)
+{
+    if ((contextPtr->isChunked) &&
+        (LE_OK != QueueRequest(contextPtr, LAST_CHUNK, sizeof(LAST_CHUNK) - 1)))
+    {
+        return LE_FAULT;
+    }
+
+    return FlushRequest(contextPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve user-defined HTTP body chunk from the body send callback and send it through socket.
+ * Chunks larger than the room left in the request buffer are sent directly from the user buffer.
+ *
+ * @return
+ *  - LE_OK            Function success
+ *  - LE_UNAVAILABLE   Nothing to send
+ *  - LE_TERMINATED    End of user body injection
+ *  - LE_FAULT         Internal error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SendUserBody
+(
+    HttpSessionCtx_t*    contextPtr   ///< [IN] HTTP session context pointer
+)
+{
+    const char* dataPtr = NULL;
+    size_t length = 0;
+    le_result_t status;
+
+    status = contextPtr->bodySendCb(contextPtr->reference, &dataPtr, &length);
+
+    // Suspend body injection when requested by user
+    if (status == LE_WOULD_BLOCK)
+    {
+        if (le_httpClient_IsAsyncMode(contextPtr->reference))
+        {
+            return status;
+        }
+
+        LE_WARN("LE_WOULD_BLOCK is irrelevant in synchronous HTTP request");
+        status = LE_OK;
+    }
+
+    if ((status != LE_OK) && (status != LE_TERMINATED))
+    {
+        return status;
+    }
+
+    if ((length) && (!dataPtr))
+    {
+        LE_ERROR("No body data provided");
+        return LE_FAULT;
+    }
+
+    if (length)
+    {
+        if (contextPtr->isChunked)
+        {
+            char header[CHUNK_HEADER_LEN + 1];
+            int headerLen = snprintf(header, sizeof(header), "%X" CRLF, (unsigned int)length);
+
+            if (LE_OK != QueueRequest(contextPtr, header, headerLen))
+            {
+                return LE_FAULT;
+            }
+        }
+
+        if (length <= (sizeof(contextPtr->txBuffer) - contextPtr->txLength))
+        {
+            // Cheaper to gather small chunks than to send them one by one
+            memcpy(contextPtr->txBuffer + contextPtr->txLength, dataPtr, length);
+            contextPtr->txLength += length;
+        }
+        else
+        {
+            if (LE_OK != FlushRequest(contextPtr))
+            {
+                return LE_FAULT;
+            }
+
+            if (LE_OK != le_socket_Send(contextPtr->socketRef, dataPtr, length))
+            {
+                LE_ERROR("Unable to transmit request");
+                return LE_FAULT;
+            }
+        }
+
+        if ((contextPtr->isChunked) &&
+            (LE_OK != QueueRequest(contextPtr, CHUNK_END, sizeof(CHUNK_END) - 1)))
+        {
+            return LE_FAULT;
+        }
+    }
+
+    if ((!length) || (status == LE_TERMINATED))
+    {
+        if (LE_OK != EndBody(contextPtr))
+        {
+            return LE_FAULT;
+        }
+
+        return length ? LE_TERMINATED : LE_UNAVAILABLE;
+    }
+
     return status;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Retrieve user-defined HTTP body chunk and send it through socket.
+ * Retrieve user-defined HTTP body chunk and send it through socket.  The body construct callback
+ * fills the request buffer directly, after the pending request data and the room reserved for the
+ * chunk header.
  *
  * @return
  *  - LE_OK            Function success
@@ -673,16 +1343,42 @@ static le_result_t BuildAndSendBody
     HttpSessionCtx_t*    contextPtr   ///< [IN] HTTP session context pointer
 )
 {
-    char buffer[REQUEST_BUFFER_SIZE] = {0};
-    int length = sizeof(buffer);
+    size_t reservedLen = 0;
+    size_t trailerLen = 0;
+    char* dataPtr;
+    int length;
     le_result_t status;
 
+    if (contextPtr->bodySendCb)
+    {
+        return SendUserBody(contextPtr);
+    }
+
     if (!contextPtr->bodyConstructCb)
     {
-        return LE_UNAVAILABLE;
+        return (LE_OK == EndBody(contextPtr)) ? LE_UNAVAILABLE : LE_FAULT;
+    }
+
+    if (contextPtr->isChunked)
+    {
+        reservedLen = CHUNK_HEADER_LEN;
+        trailerLen = (sizeof(CHUNK_END) - 1) + (sizeof(LAST_CHUNK) - 1);
+    }
+
+    // Send the pending request data first if there is not enough room left for the chunk
+    if ((sizeof(contextPtr->txBuffer) - contextPtr->txLength) <
+        (reservedLen + trailerLen + BODY_CHUNK_MIN_SIZE))
+    {
+        if (LE_OK != FlushRequest(contextPtr))
+        {
+            return LE_FAULT;
+        }
     }
 
-    status = contextPtr->bodyConstructCb(contextPtr->reference, buffer, &length);
+    dataPtr = contextPtr->txBuffer + contextPtr->txLength + reservedLen;
+    length = sizeof(contextPtr->txBuffer) - contextPtr->txLength - reservedLen - trailerLen;
+
+    status = contextPtr->bodyConstructCb(contextPtr->reference, dataPtr, &length);
 
     // Suspend resource injection when requested by user
     if (status == LE_WOULD_BLOCK)
@@ -696,19 +1392,44 @@ static le_result_t BuildAndSendBody
         status = LE_OK;
     }
 
-    // If buffer length value is zero, end processing
-    if (!length)
+    if ((status != LE_OK) && (status != LE_TERMINATED))
     {
-        return LE_UNAVAILABLE;
+        return status;
     }
 
-    // Send body chunk through socket
-    if (LE_OK != le_socket_Send(contextPtr->socketRef, buffer, length))
+    if ((length < 0) ||
+        ((size_t)length > (sizeof(contextPtr->txBuffer) - contextPtr->txLength - reservedLen - trailerLen)))
     {
-        LE_ERROR("Unable to transmit request");
+        LE_ERROR("Invalid body chunk length: %d", length);
         return LE_FAULT;
     }
 
+    if (length)
+    {
+        if (contextPtr->isChunked)
+        {
+            char header[CHUNK_HEADER_LEN + 1];
+
+            snprintf(header, sizeof(header), CHUNK_HEADER_FORMAT, (unsigned int)length);
+            memcpy(dataPtr - CHUNK_HEADER_LEN, header, CHUNK_HEADER_LEN);
+            memcpy(dataPtr + length, CHUNK_END, sizeof(CHUNK_END) - 1);
+            length += sizeof(CHUNK_END) - 1;
+        }
+
+        contextPtr->txLength += reservedLen + length;
+    }
+
+    // If buffer length value is zero, end processing
+    if ((!length) || (status == LE_TERMINATED))
+    {
+        if (LE_OK != EndBody(contextPtr))
+        {
+            return LE_FAULT;
+        }
+
+        return length ? LE_TERMINATED : LE_UNAVAILABLE;
+    }
+
     return status;
 }
 
@@ -768,6 +1489,20 @@ static le_result_t HandleHttpResponse
         goto end;
     }
 
+    // Keep the HTTP version of the response, at the start of its status line
+    if (contextPtr->rspVersionLen < sizeof(contextPtr->rspVersion))
+    {
+        size_t count = sizeof(contextPtr->rspVersion) - contextPtr->rspVersionLen;
+
+        if (count > length)
+        {
+            count = length;
+        }
+
+        memcpy(contextPtr->rspVersion + contextPtr->rspVersionLen, buffer, count);
+        contextPtr->rspVersionLen += count;
+    }
+
     while (needmore && length)
     {
         int read;
@@ -780,13 +1515,20 @@ static le_result_t HandleHttpResponse
                 HTTP_POST == contextPtr->command ||
                 HTTP_PUT == contextPtr->command ||
                 HTTP_DELETE == contextPtr->command) &&
-                tinyCtxPtr->handler.contentlength > 0)
+                ((tinyCtxPtr->handler.contentlength > 0) || (tinyCtxPtr->handler.chunked)))
             {
                 LE_DEBUG("HTTP_HEAD response received, continue reading data");
                 break;
             }
             else
             {
+                // Without length nor chunked encoding, the body of the response (if any) ends
+                // when the server closes the connection: it can't be reused.
+                if ((HTTP_HEAD != contextPtr->command) &&
+                    (tinyCtxPtr->handler.contentlength < 0) && (!tinyCtxPtr->handler.chunked))
+                {
+                    contextPtr->isKeepAlive = false;
+                }
                 needmore = 0;
             }
         }
@@ -812,6 +1554,14 @@ static le_result_t HandleHttpResponse
     // At this point, HTTP response has been totally read and processed correctly
     status = LE_TERMINATED;
 
+    // HTTP/1.0 servers close the connection unless they are asked to keep it and agree
+    if ((contextPtr->rspVersionLen == sizeof(contextPtr->rspVersion)) &&
+        (0 == memcmp(contextPtr->rspVersion, HTTP_1_0_VERSION, sizeof(contextPtr->rspVersion))) &&
+        (!contextPtr->hasKeepAliveToken))
+    {
+        contextPtr->isKeepAlive = false;
+    }
+
 end:
     http_free(&tinyCtxPtr->handler);
     tinyCtxPtr->isInit = false;
@@ -851,7 +1601,7 @@ static void HttpClientStateMachine
     {
         LE_INFO("Connection closed by remote server");
 
-        le_socket_Disconnect(socketRef);
+        CloseConnection(contextPtr);
 
         if (contextPtr->eventCb)
         {
@@ -1014,6 +1764,13 @@ static void HttpClientStateMachine
                     le_timer_Stop(contextPtr->timerRef);
                 }
 
+                // After a failure, the connection may still carry part of the request or of the
+                // response. The next request opens a new connection.
+                if ((contextPtr->result != LE_OK) || (!contextPtr->isKeepAlive))
+                {
+                    CloseConnection(contextPtr);
+                }
+
                 if (contextPtr->responseCb)
                 {
                     contextPtr->responseCb(contextPtr->reference, contextPtr->result);
@@ -1036,7 +1793,7 @@ static void HttpClientStateMachine
                     {
                         LE_INFO("Connection teared down: %d", status);
 
-                        le_httpClient_Stop(contextPtr->reference);
+                        CloseConnection(contextPtr);
                         if (contextPtr->eventCb)
                         {
                             contextPtr->eventCb(contextPtr->reference,
@@ -1155,9 +1912,20 @@ LE_SHARED le_httpClient_Ref_t le_httpClient_CreateOnSrcAddr
 
     strncpy(contextPtr->host, hostPtr + offset, sizeof(contextPtr->host)-1);
     contextPtr->port = port;
+    if (srcAddr)
+    {
+        strncpy(contextPtr->srcAddr, srcAddr, sizeof(contextPtr->srcAddr)-1);
+    }
+    contextPtr->timeout = COMM_TIMEOUT_DEFAULT_MS;
+
+    // Create the socket. Idle connections are closed if there is no socket left for the session.
+    do
+    {
+        contextPtr->socketRef = le_socket_Create(contextPtr->host, contextPtr->port, srcAddr,
+                                                 TCP_TYPE);
+    }
+    while ((NULL == contextPtr->socketRef) && (CloseOldestIdleConnection()));
 
-    // Create the socket
-    contextPtr->socketRef = le_socket_Create(contextPtr->host, contextPtr->port, srcAddr, TCP_TYPE);
     if (NULL == contextPtr->socketRef)
     {
         LE_ERROR("Failed to connect socket");
@@ -1213,7 +1981,11 @@ le_result_t le_httpClient_Delete
        tinyCtxPtr->isInit = false;
     }
 
-    le_socket_Delete(contextPtr->socketRef);
+    // Keep the connection for a later session to the same server if it can be reused
+    if (!KeepIdleConnection(contextPtr))
+    {
+        le_socket_Delete(contextPtr->socketRef);
+    }
     le_timer_Delete(contextPtr->timerRef);
 
     FreeHttpSessionContext(contextPtr);
@@ -1249,6 +2021,7 @@ le_result_t le_httpClient_SetTimeout
         le_timer_SetMsInterval(contextPtr->timerRef, timeout);
     }
 
+    contextPtr->timeout = timeout;
     return le_socket_SetTimeout(contextPtr->socketRef, timeout);
 }
 
@@ -1334,6 +2107,7 @@ le_result_t le_httpClient_AddCertificate
     if (status == LE_OK)
     {
         contextPtr->isSecure = true;
+        AddSecuritySetting(contextPtr, SECURITY_CERTIFICATE, certificatePtr, certificateLen);
     }
     else
     {
@@ -1368,7 +2142,13 @@ le_result_t le_httpClient_AddOwnCertificate
         return LE_BAD_PARAMETER;
     }
 
-    return le_socket_AddOwnCertificate(contextPtr->socketRef, certificatePtr, certificateLen);
+    le_result_t status = le_socket_AddOwnCertificate(contextPtr->socketRef, certificatePtr, certificateLen);
+    if (status == LE_OK)
+    {
+        AddSecuritySetting(contextPtr, SECURITY_OWN_CERTIFICATE, certificatePtr, certificateLen);
+    }
+
+    return status;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1396,7 +2176,13 @@ le_result_t le_httpClient_AddOwnPrivateKey
         return LE_BAD_PARAMETER;
     }
 
-    return le_socket_AddOwnPrivateKey(contextPtr->socketRef, pkeyPtr, pkeyLen);
+    le_result_t status = le_socket_AddOwnPrivateKey(contextPtr->socketRef, pkeyPtr, pkeyLen);
+    if (status == LE_OK)
+    {
+        AddSecuritySetting(contextPtr, SECURITY_OWN_PRIVATE_KEY, pkeyPtr, pkeyLen);
+    }
+
+    return status;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1423,7 +2209,13 @@ le_result_t le_httpClient_SetCipherSuites
         return LE_BAD_PARAMETER;
     }
 
-    return le_socket_SetCipherSuites(contextPtr->socketRef, cipherIdx);
+    le_result_t status = le_socket_SetCipherSuites(contextPtr->socketRef, cipherIdx);
+    if (status == LE_OK)
+    {
+        AddSecuritySetting(contextPtr, SECURITY_CIPHER_SUITES, &cipherIdx, sizeof(cipherIdx));
+    }
+
+    return status;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1450,7 +2242,13 @@ le_result_t le_httpClient_SetAuthType
         return LE_BAD_PARAMETER;
     }
 
-    return le_socket_SetAuthType(contextPtr->socketRef, auth);
+    le_result_t status = le_socket_SetAuthType(contextPtr->socketRef, auth);
+    if (status == LE_OK)
+    {
+        AddSecuritySetting(contextPtr, SECURITY_AUTH_TYPE, &auth, sizeof(auth));
+    }
+
+    return status;
 }
 
 
@@ -1479,7 +2277,13 @@ le_result_t le_httpClient_SetTLSVersion
         return LE_BAD_PARAMETER;
     }
 
-    return le_socket_SetTlsVersion(contextPtr->socketRef, tlsVersion);
+    le_result_t status = le_socket_SetTlsVersion(contextPtr->socketRef, tlsVersion);
+    if (status == LE_OK)
+    {
+        AddSecuritySetting(contextPtr, SECURITY_TLS_VERSION, &tlsVersion, sizeof(tlsVersion));
+    }
+
+    return status;
 #else
     LE_WARN("Setting TLS version isn't supported by this platform. Ignoring it.");
     return LE_OK;
@@ -1506,6 +2310,8 @@ le_result_t le_httpClient_Start
     le_httpClient_Ref_t  ref    ///< [IN] HTTP session context reference
 )
 {
+    le_socket_Ref_t idleSocketRef;
+    le_result_t status;
     HttpSessionCtx_t *contextPtr = (HttpSessionCtx_t *)le_ref_Lookup(HttpSessionRefMap, ref);
     if (contextPtr == NULL)
     {
@@ -1513,7 +2319,33 @@ le_result_t le_httpClient_Start
         return LE_BAD_PARAMETER;
     }
 
-    return le_socket_Connect(contextPtr->socketRef);
+    // Reuse the connection of a previous session to the same server if there is one, instead of
+    // connecting the socket of this session
+    idleSocketRef = TakeIdleConnection(contextPtr);
+    if (idleSocketRef)
+    {
+        LE_INFO("Reusing connection to %s:%u", contextPtr->host, contextPtr->port);
+
+        le_socket_SetTimeout(idleSocketRef, contextPtr->timeout);
+        if (le_socket_IsMonitoring(contextPtr->socketRef))
+        {
+            le_socket_AddEventHandler(idleSocketRef, HttpClientStateMachine, ref);
+            le_socket_SetMonitoring(idleSocketRef, true);
+        }
+
+        le_socket_Delete(contextPtr->socketRef);
+        contextPtr->socketRef = idleSocketRef;
+        status = LE_OK;
+    }
+    else
+    {
+        status = le_socket_Connect(contextPtr->socketRef);
+    }
+
+    contextPtr->isStarted = (status == LE_OK);
+    contextPtr->isConnected = (status == LE_OK);
+
+    return status;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1539,6 +2371,9 @@ le_result_t le_httpClient_Stop
     }
 
     contextPtr->state = STATE_IDLE;
+    contextPtr->isStarted = false;
+    contextPtr->isConnected = false;
+    contextPtr->txLength = 0;
     return le_socket_Disconnect(contextPtr->socketRef);
 }
 
@@ -1581,6 +2416,13 @@ le_result_t le_httpClient_SendRequest
         return LE_BUSY;
     }
 
+    status = PrepareConnection(contextPtr);
+    if (LE_OK != status)
+    {
+        LE_ERROR("Unable to connect to server");
+        return status;
+    }
+
     status = BuildAndSendRequest(contextPtr, command, requestUriPtr);
     if (LE_OK != status)
     {
@@ -1734,6 +2576,68 @@ le_result_t le_httpClient_SetBodyConstructCallback
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set callback to provide HTTP body data during a POST or PUT request, without copying it to the
+ * internal request buffer.  If set, this callback is used instead of the body construct callback.
+ *
+ * @return
+ *  - LE_OK            Function success
+ *  - LE_BAD_PARAMETER Invalid parameter
+ *  - LE_FAULT         Internal error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_httpClient_SetBodySendCallback
+(
+    le_httpClient_Ref_t              ref,       ///< [IN] HTTP session context reference
+    le_httpClient_BodySendCb_t       callback   ///< [IN] Callback
+)
+{
+    HttpSessionCtx_t *contextPtr = (HttpSessionCtx_t *)le_ref_Lookup(HttpSessionRefMap, ref);
+    if (contextPtr == NULL)
+    {
+        LE_ERROR("Reference not found: %p", ref);
+        return LE_BAD_PARAMETER;
+    }
+
+    contextPtr->bodySendCb = callback;
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable the chunked transfer encoding of the body of POST and PUT requests.  By
+ * default, the body is sent as is and its length must be given by a Content-Length header field.
+ *
+ * @return
+ *  - LE_OK            Function success
+ *  - LE_BAD_PARAMETER Invalid parameter
+ *  - LE_BUSY          A request is in progress
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_httpClient_SetChunkedTransfer
+(
+    le_httpClient_Ref_t     ref,      ///< [IN] HTTP session context reference
+    bool                    enable    ///< [IN] True to send bodies in chunks, false otherwise
+)
+{
+    HttpSessionCtx_t *contextPtr = (HttpSessionCtx_t *)le_ref_Lookup(HttpSessionRefMap, ref);
+    if (contextPtr == NULL)
+    {
+        LE_ERROR("Reference not found: %p", ref);
+        return LE_BAD_PARAMETER;
+    }
+
+    if (contextPtr->state != STATE_IDLE)
+    {
+        LE_ERROR("Busy handling previous request. Current state: %d", contextPtr->state);
+        return LE_BUSY;
+    }
+
+    contextPtr->isChunked = enable;
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set callback to get HTTP asynchronous events.
@@ -1861,6 +2765,13 @@ void le_httpClient_SendRequestAsync
         goto end;
     }
 
+    status = PrepareConnection(contextPtr);
+    if (LE_OK != status)
+    {
+        LE_ERROR("Unable to connect to server");
+        goto end;
+    }
+
     status = BuildAndSendRequest(contextPtr, command, requestUriPtr);
     if (LE_OK != status)
     {
@@ -1982,6 +2893,8 @@ COMPONENT_INIT_ONCE
                                                 HTTP_SESSIONS_NB,
                                                 sizeof(HttpSessionCtx_t));
     HttpSessionRefMap = le_ref_CreateMap("le_httpClientMap", HTTP_SESSIONS_NB);
+
+    IdleConnectionsMutex = le_mutex_CreateNonRecursive("httpClientIdleConn");
 }
 
 //--------------------------------------------------------------------------------------------------
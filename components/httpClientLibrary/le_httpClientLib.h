@@ -15,6 +15,8 @@
  * - Supports mostly-used HTTP commands. Check @ref le_httpCommand_t for the complete list.
  * - Synchronous and asynchronous HTTP requests
  * - Credentials management
+ * - Persistent connections (keep-alive), reused across requests and sessions
+ * - Chunked transfer encoding of request and response bodies
  *
  * Interactions between user application and HTTP client library rely on a set of callbacks to
  * build a request. The main advantage of this technique is to reduce memory usage and allocated
@@ -57,6 +59,7 @@
  * - Input callbacks: used to inject data in the HTTP request:
  *  - @ref le_httpClient_SetResourceUpdateCallback
  *  - @ref le_httpClient_SetBodyConstructCallback
+ *  - @ref le_httpClient_SetBodySendCallback
  *
  * - Output callbacks: used to retrieve data from HTTP server response:
  *  - @ref le_httpClient_SetBodyResponseCallback
@@ -73,6 +76,11 @@
  * @snippet "apps/test/httpServices/httpIntegrationTest/httpTestComponent/httpTest.c" HttpStatusCb
  * @snippet "apps/test/httpServices/httpIntegrationTest/httpTestComponent/httpTest.c" HttpSetCb
  *
+ * The body construct callback fills a buffer of the library, while the body send callback provides
+ * a pointer to the user data, which is sent without being copied when it is large enough. The body
+ * response callback is given a pointer to the data in the receive buffer of the library: it must
+ * copy the data it needs to keep.
+ *
  * @section http_client_synchronous Synchronous API
  * Once a reference is created and callbacks subscribed, user application can send HTTP requests
  * in a synchronous way using @ref le_httpClient_SendRequest.
@@ -158,6 +166,40 @@
  *        |                                                                             |
  *        +                                                                             +
  * @endcode
+ *
+ * @section http_client_keepalive Persistent connections
+ *
+ * The connection opened by @ref le_httpClient_Start is kept open between the requests of the
+ * session, unless the server answers with a "Connection: close" header field, does not give the
+ * length of a response body, or a request fails. In these cases, or if the server closes the
+ * connection, the next request of the session opens a new connection.
+ *
+ * When a started session is deleted without being stopped, its connection is kept open for a while
+ * and reused by the next session to the same host, port and source address, with the same secure
+ * connection settings: its @ref le_httpClient_Start call does not need to connect again, nor to
+ * perform a new TLS handshake. @ref le_httpClient_Stop always closes the connection.
+ * The number of idle connections and the time they are kept are set by the
+ * @c HTTPCLIENT_IDLE_CONNECTION_MAX and @c HTTPCLIENT_IDLE_CONNECTION_TIMEOUT configuration
+ * options.
+ *
+ * @section http_client_chunked Chunked transfer encoding
+ *
+ * Response bodies sent with the chunked transfer encoding are decoded before being reported to the
+ * body response callback.
+ *
+ * Request bodies of unknown length can be sent with the chunked transfer encoding after calling
+ * @ref le_httpClient_SetChunkedTransfer: each chunk of data provided by the body callback is sent
+ * as a chunk, and the body is terminated when the callback returns LE_TERMINATED or no data.
+ * Otherwise, the user application must give the length of the body in a Content-Length header
+ * field.
+ *
+ * @section http_client_buffers Buffer sizes
+ *
+ * The sizes of the request and response buffers of the library are set by the
+ * @c HTTPCLIENT_REQUEST_BUFFER_SIZE and @c HTTPCLIENT_RESPONSE_BUFFER_SIZE configuration options.
+ * The request line and header fields are gathered in the request buffer, along with the first body
+ * chunk, and sent at once.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 //--------------------------------------------------------------------------------------------------
@@ -278,6 +320,29 @@ typedef le_result_t (*le_httpClient_BodyConstructCb_t)
     int*                sizePtr     ///< [INOUT] Data pointer size
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Callback definition for HTTP body sending.
+ *  User sets the data pointer and size to the next chunk of data, then returns a status code.
+ *  The data is sent from the user buffer, which must remain valid until the callback is called
+ *  again or the request ends.
+ *
+ * @return
+ *  - LE_OK            Callback should be called again to gather another chunk of data
+ *  - LE_TERMINATED    All data have been transmitted, do not recall callback
+ *  - LE_WOULD_BLOCK   Suspend current request and resume when @ref le_httpClient_Resume is called
+ *  - LE_FAULT         Internal error
+ *
+ * @note Suspend mechanism is only relevant for asynchronous HTTP requests.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef le_result_t (*le_httpClient_BodySendCb_t)
+(
+    le_httpClient_Ref_t ref,        ///< [IN] HTTP session context reference
+    const char**        dataPtrPtr, ///< [OUT] Data pointer
+    size_t*             sizePtr     ///< [OUT] Data size
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Callback definition for resources (key/value pairs) insertion.
@@ -637,6 +702,40 @@ LE_SHARED le_result_t le_httpClient_SetResourceUpdateCallback
     le_httpClient_ResourceUpdateCb_t callback  ///< [IN] Callback
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set callback to provide HTTP body data during a POST or PUT request, without copying it to the
+ * internal request buffer.  If set, this callback is used instead of the body construct callback.
+ *
+ * @return
+ *  - LE_OK            Function success
+ *  - LE_BAD_PARAMETER Invalid parameter
+ *  - LE_FAULT         Internal error
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t le_httpClient_SetBodySendCallback
+(
+    le_httpClient_Ref_t              ref,       ///< [IN] HTTP session context reference
+    le_httpClient_BodySendCb_t       callback   ///< [IN] Callback
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable the chunked transfer encoding of the body of POST and PUT requests.  By
+ * default, the body is sent as is and its length must be given by a Content-Length header field.
+ *
+ * @return
+ *  - LE_OK            Function success
+ *  - LE_BAD_PARAMETER Invalid parameter
+ *  - LE_BUSY          A request is in progress
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t le_httpClient_SetChunkedTransfer
+(
+    le_httpClient_Ref_t     ref,      ///< [IN] HTTP session context reference
+    bool                    enable    ///< [IN] True to send bodies in chunks, false otherwise
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set callback to get HTTP asynchronous events.
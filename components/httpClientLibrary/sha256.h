@@ -0,0 +1,86 @@
+/**
+ * @file sha256.h
+ *
+ * SHA-256 digest (FIPS 180-4), used by the HTTP client library to identify the secure connection
+ * settings of its sessions.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LE_HTTP_SHA256_H
+#define LE_HTTP_SHA256_H
+
+#include "legato.h"
+
+//--------------------------------------------------------------------------------------------------
+// Symbol and Enum definitions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of a SHA-256 digest, in bytes
+ */
+//--------------------------------------------------------------------------------------------------
+#define SHA256_DIGEST_LEN   32
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Length of a SHA-256 block, in bytes
+ */
+//--------------------------------------------------------------------------------------------------
+#define SHA256_BLOCK_LEN    64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * SHA-256 computation context
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t state[8];                      ///< Intermediate hash value
+    uint64_t length;                        ///< Number of bytes hashed so far
+    uint8_t  block[SHA256_BLOCK_LEN];       ///< Bytes of the current block
+}
+sha256_Ctx_t;
+
+//--------------------------------------------------------------------------------------------------
+// Public functions
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start a SHA-256 computation
+ */
+//--------------------------------------------------------------------------------------------------
+void sha256_Init
+(
+    sha256_Ctx_t*   ctxPtr          ///< [OUT] Computation context
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add data to a SHA-256 computation
+ */
+//--------------------------------------------------------------------------------------------------
+void sha256_Update
+(
+    sha256_Ctx_t*   ctxPtr,         ///< [IN/OUT] Computation context
+    const void*     dataPtr,        ///< [IN] Data
+    size_t          dataLen         ///< [IN] Data length
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the digest of the data added to a SHA-256 computation.  The context is left unchanged, so
+ * that more data can be added to it.
+ */
+//--------------------------------------------------------------------------------------------------
+void sha256_GetDigest
+(
+    const sha256_Ctx_t* ctxPtr,                     ///< [IN] Computation context
+    uint8_t             digest[SHA256_DIGEST_LEN]   ///< [OUT] Digest
+);
+
+#endif /* LE_HTTP_SHA256_H */
@@ -36,6 +36,7 @@
 #include "pa_mrc.h"
 #include "mdmCfgEntries.h"
 #include "le_ms_local.h"
+#include "le_mrc_local.h"
 #include "watchdogChain.h"
 
 //--------------------------------------------------------------------------------------------------
@@ -71,6 +72,27 @@
 //--------------------------------------------------------------------------------------------------
 #define MAX_NUM_NEIGHBOR_LISTS    5
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of Neighboring Cells change reports we expect to have at one time.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_NUM_NEIGHBOR_CELLS_CHANGES    2
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default Neighboring Cells monitoring interval in seconds.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NEIGHBOR_CELLS_MONITORING_INTERVAL    5
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Default signal strength delta in dBm from which a neighboring cell is reported as changed.
+ */
+//--------------------------------------------------------------------------------------------------
+#define NEIGHBOR_CELLS_RX_LEVEL_DELTA    3
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum number of preferred operator lists we expect to have at one time.
@@ -530,6 +552,61 @@ LE_REF_DEFINE_STATIC_MAP(CellInfoCellMap, MAX_NUM_NEIGHBORS);
 //--------------------------------------------------------------------------------------------------
 static le_ref_MapRef_t CellRefMap;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Static pool for Neighboring Cells change reports.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(NeighborCellsChange,
+                          MAX_NUM_NEIGHBOR_CELLS_CHANGES,
+                          sizeof(NeighborCellsChange_t));
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for Neighboring Cells change reports.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t NeighborCellsChangePool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event ID for Neighboring Cells change notification.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_event_Id_t NeighborCellsChangeId;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Timer used to monitor the Neighboring Cells, and the thread which owns it.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t NeighborCellsTimerRef;
+static le_thread_Ref_t NeighborCellsThreadRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of registered Neighboring Cells change handlers. The Neighboring Cells are monitored as
+ * long as it is not 0.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t NeighborCellsHandlerCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Neighboring Cells monitoring interval in seconds and signal strength delta in dBm.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t NeighborCellsInterval = NEIGHBOR_CELLS_MONITORING_INTERVAL;
+static int32_t NeighborCellsRxLevelDelta = NEIGHBOR_CELLS_RX_LEVEL_DELTA;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Neighboring Cells as last reported to the Neighboring Cells change handlers.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mrc_NeighborCellData_t ReportedCells[LE_MRC_NEIGHBOR_CELLS_MAX];
+static size_t ReportedCellsCount;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Event ID for New Network Registration State notification.
@@ -2049,6 +2126,421 @@ static void RetrySyncNetworkTimeHandler
 }
 #endif
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill the data of a neighboring cell from its cell information.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetNeighborCellData
+(
+    const pa_mrc_CellInfo_t*   cellInfoPtr, ///< [IN] The cell information
+    le_mrc_NeighborCellData_t* cellPtr      ///< [OUT] The cell data
+)
+{
+    cellPtr->rat = cellInfoPtr->rat;
+    cellPtr->id = cellInfoPtr->id;
+    cellPtr->lac = cellInfoPtr->lac;
+    cellPtr->rxLevel = cellInfoPtr->rxLevel;
+    cellPtr->umtsEcIo = cellInfoPtr->umtsEcIo;
+    cellPtr->lteIntraRsrq = cellInfoPtr->lteIntraRsrq;
+    cellPtr->lteIntraRsrp = cellInfoPtr->lteIntraRsrp;
+    cellPtr->lteInterRsrq = cellInfoPtr->lteInterRsrq;
+    cellPtr->lteInterRsrp = cellInfoPtr->lteInterRsrp;
+    cellPtr->earfcn = cellInfoPtr->earfcn;
+    cellPtr->physCellId = cellInfoPtr->physCellId;
+    cellPtr->scramblingCode = cellInfoPtr->psc;
+    cellPtr->bsic = cellInfoPtr->bsic;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve the Neighboring Cells information into an array.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the array is filled with the first cells only
+ *      - LE_FAULT if the Neighboring Cells information could not be retrieved
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetNeighborCells
+(
+    le_mrc_NeighborCellData_t* cellsPtr,        ///< [OUT] The cells
+    size_t*                    cellsCountPtr    ///< [IN/OUT] Array size, then number of cells
+)
+{
+    le_dls_List_t  cellInfoList = LE_DLS_LIST_INIT;
+    le_dls_Link_t* linkPtr;
+    le_result_t    result = LE_OK;
+    size_t         count = 0;
+
+    if (pa_mrc_GetNeighborCellsInfo(&cellInfoList) < 0)
+    {
+        pa_mrc_DeleteNeighborCellsInfo(&cellInfoList);
+        *cellsCountPtr = 0;
+        return LE_FAULT;
+    }
+
+    for (linkPtr = le_dls_Peek(&cellInfoList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&cellInfoList, linkPtr))
+    {
+        if (count == *cellsCountPtr)
+        {
+            result = LE_OVERFLOW;
+            break;
+        }
+        SetNeighborCellData(CONTAINER_OF(linkPtr, pa_mrc_CellInfo_t, link), &cellsPtr[count]);
+        count++;
+    }
+
+    pa_mrc_DeleteNeighborCellsInfo(&cellInfoList);
+    *cellsCountPtr = count;
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy the networks of a scan information list into an array.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the array is filled with the first networks only
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetScanData
+(
+    le_dls_List_t*     scanInfoListPtr,     ///< [IN] List of pa_mrc_ScanInformation_t
+    le_mrc_ScanData_t* networksPtr,         ///< [OUT] The networks
+    size_t*            networksCountPtr     ///< [IN/OUT] Array size, then number of networks
+)
+{
+    le_dls_Link_t* linkPtr;
+    le_result_t    result = LE_OK;
+    size_t         count = 0;
+
+    for (linkPtr = le_dls_Peek(scanInfoListPtr);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(scanInfoListPtr, linkPtr))
+    {
+        pa_mrc_ScanInformation_t* scanInfoPtr = CONTAINER_OF(linkPtr,
+                                                             pa_mrc_ScanInformation_t,
+                                                             link);
+        le_mrc_ScanData_t* networkPtr;
+
+        if (count == *networksCountPtr)
+        {
+            result = LE_OVERFLOW;
+            break;
+        }
+
+        networkPtr = &networksPtr[count];
+
+        le_utf8_Copy(networkPtr->mcc, scanInfoPtr->mobileCode.mcc, sizeof(networkPtr->mcc), NULL);
+        le_utf8_Copy(networkPtr->mnc, scanInfoPtr->mobileCode.mnc, sizeof(networkPtr->mnc), NULL);
+        if (LE_OK != pa_mrc_GetScanInformationName(scanInfoPtr,
+                                                   networkPtr->name,
+                                                   sizeof(networkPtr->name)))
+        {
+            networkPtr->name[0] = '\0';
+        }
+        networkPtr->rat = scanInfoPtr->rat;
+        networkPtr->isInUse = scanInfoPtr->isInUse;
+        networkPtr->isAvailable = scanInfoPtr->isAvailable;
+        networkPtr->isHome = scanInfoPtr->isHome;
+        networkPtr->isForbidden = scanInfoPtr->isForbidden;
+        count++;
+    }
+
+    *networksCountPtr = count;
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether two neighboring cells data are about the same cell.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsSameNeighborCell
+(
+    const le_mrc_NeighborCellData_t* cell1Ptr,  ///< [IN] First cell
+    const le_mrc_NeighborCellData_t* cell2Ptr   ///< [IN] Second cell
+)
+{
+    return ((cell1Ptr->rat == cell2Ptr->rat) &&
+            (cell1Ptr->id == cell2Ptr->id) &&
+            (cell1Ptr->lac == cell2Ptr->lac) &&
+            (cell1Ptr->earfcn == cell2Ptr->earfcn) &&
+            (cell1Ptr->physCellId == cell2Ptr->physCellId) &&
+            (cell1Ptr->scramblingCode == cell2Ptr->scramblingCode) &&
+            (cell1Ptr->bsic == cell2Ptr->bsic));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a level moved by at least the given delta. Any change is reported with a delta
+ * of 0.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsLevelChanged
+(
+    int32_t previousLevel,  ///< [IN] Level last reported
+    int32_t level,          ///< [IN] Current level
+    int32_t delta           ///< [IN] Delta
+)
+{
+    int64_t diff = (int64_t)level - previousLevel;
+
+    if (diff < 0)
+    {
+        diff = -diff;
+    }
+
+    return ((0 == delta) ? (0 != diff) : (diff >= delta));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the levels of a neighboring cell changed enough to be reported.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsNeighborCellChanged
+(
+    const le_mrc_NeighborCellData_t* reportedPtr,   ///< [IN] Cell as last reported
+    const le_mrc_NeighborCellData_t* cellPtr,       ///< [IN] Current cell
+    int32_t                          delta          ///< [IN] Signal strength delta in dBm
+)
+{
+    // Ec/Io, RSRQ and RSRP are given with 1 decimal place.
+    int32_t decimalDelta = 10 * delta;
+
+    return (IsLevelChanged(reportedPtr->rxLevel, cellPtr->rxLevel, delta) ||
+            IsLevelChanged(reportedPtr->umtsEcIo, cellPtr->umtsEcIo, decimalDelta) ||
+            IsLevelChanged(reportedPtr->lteIntraRsrq, cellPtr->lteIntraRsrq, decimalDelta) ||
+            IsLevelChanged(reportedPtr->lteIntraRsrp, cellPtr->lteIntraRsrp, decimalDelta) ||
+            IsLevelChanged(reportedPtr->lteInterRsrq, cellPtr->lteInterRsrq, decimalDelta) ||
+            IsLevelChanged(reportedPtr->lteInterRsrp, cellPtr->lteInterRsrp, decimalDelta));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the Neighboring Cells change report from the cells last reported and the current cells,
+ * then update the cells last reported. A cell is changed when one of its levels moved by at least
+ * the delta since the value last reported for it (10 times the delta for the levels with 1 decimal
+ * place), and any change is reported with a delta of 0. The levels of an unchanged cell are kept
+ * as last reported, so that a slow drift is reported once it reaches the delta.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mrc_ComputeNeighborCellsChange
+(
+    le_mrc_NeighborCellData_t*       reportedPtr,      ///< [IN/OUT] Cells last reported
+    size_t*                          reportedCountPtr, ///< [IN/OUT] Number of cells last reported
+    const le_mrc_NeighborCellData_t* cellsPtr,         ///< [IN] Current cells
+    size_t                           cellsCount,       ///< [IN] Number of current cells
+    int32_t                          rxLevelDelta,     ///< [IN] Signal strength delta in dBm
+    NeighborCellsChange_t*           changePtr         ///< [OUT] Change report
+)
+{
+    le_mrc_NeighborCellData_t cells[LE_MRC_NEIGHBOR_CELLS_MAX];
+    bool                      isReportedFound[LE_MRC_NEIGHBOR_CELLS_MAX] = {false};
+    size_t                    reportedCount = *reportedCountPtr;
+    size_t                    i;
+    size_t                    j;
+
+    LE_ASSERT(cellsCount <= LE_MRC_NEIGHBOR_CELLS_MAX);
+    LE_ASSERT(reportedCount <= LE_MRC_NEIGHBOR_CELLS_MAX);
+
+    changePtr->addedCount = 0;
+    changePtr->changedCount = 0;
+    changePtr->removedCount = 0;
+
+    for (i = 0; i < cellsCount; i++)
+    {
+        cells[i] = cellsPtr[i];
+
+        for (j = 0; j < reportedCount; j++)
+        {
+            if ((!isReportedFound[j]) && IsSameNeighborCell(&reportedPtr[j], &cells[i]))
+            {
+                break;
+            }
+        }
+
+        if (j == reportedCount)
+        {
+            changePtr->added[changePtr->addedCount++] = cells[i];
+        }
+        else
+        {
+            isReportedFound[j] = true;
+            if (IsNeighborCellChanged(&reportedPtr[j], &cells[i], rxLevelDelta))
+            {
+                changePtr->changed[changePtr->changedCount++] = cells[i];
+            }
+            else
+            {
+                // Compare the next levels with the last reported ones, so that a slow drift is
+                // reported once it reaches the delta.
+                cells[i] = reportedPtr[j];
+            }
+        }
+    }
+
+    for (j = 0; j < reportedCount; j++)
+    {
+        if (!isReportedFound[j])
+        {
+            changePtr->removed[changePtr->removedCount++] = reportedPtr[j];
+        }
+    }
+
+    memcpy(reportedPtr, cells, cellsCount * sizeof(cells[0]));
+    *reportedCountPtr = cellsCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The first-layer Neighboring Cells Change Handler.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void FirstLayerNeighborCellsChangeHandler
+(
+    void* reportPtr,
+    void* secondLayerHandlerFunc
+)
+{
+    NeighborCellsChange_t* changePtr = (NeighborCellsChange_t*)reportPtr;
+    le_mrc_NeighborCellsChangeHandlerFunc_t clientHandlerFunc =
+        (le_mrc_NeighborCellsChangeHandlerFunc_t)secondLayerHandlerFunc;
+
+    clientHandlerFunc(changePtr->added, changePtr->addedCount,
+                      changePtr->changed, changePtr->changedCount,
+                      changePtr->removed, changePtr->removedCount,
+                      le_event_GetContextPtr());
+
+    // The reportPtr is a reference counted object, so need to release it
+    le_mem_Release(reportPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Retrieve the Neighboring Cells and notify the cells added, changed or removed since the previous
+ * notification. Called when the Neighboring Cells monitoring timer expires.
+ */
+//--------------------------------------------------------------------------------------------------
+static void NeighborCellsTimerHandler
+(
+    le_timer_Ref_t timerRef    ///< Timer that expired
+)
+{
+    le_mrc_NeighborCellData_t cells[LE_MRC_NEIGHBOR_CELLS_MAX];
+    size_t                    cellsCount = NUM_ARRAY_MEMBERS(cells);
+    NeighborCellsChange_t*    changePtr;
+
+    LE_UNUSED(timerRef);
+
+    // Keep the cells last reported on failure, rather than report them all as removed.
+    if (LE_FAULT == GetNeighborCells(cells, &cellsCount))
+    {
+        LE_WARN("Unable to retrieve the Neighboring Cells information!");
+        return;
+    }
+
+    changePtr = le_mem_ForceAlloc(NeighborCellsChangePool);
+    le_mrc_ComputeNeighborCellsChange(ReportedCells, &ReportedCellsCount, cells, cellsCount,
+                                      NeighborCellsRxLevelDelta, changePtr);
+
+    if ((0 == changePtr->addedCount) && (0 == changePtr->changedCount) &&
+        (0 == changePtr->removedCount))
+    {
+        le_mem_Release(changePtr);
+        return;
+    }
+
+    LE_DEBUG("Neighboring cells: %" PRIuS " added, %" PRIuS " changed, %" PRIuS " removed",
+             changePtr->addedCount, changePtr->changedCount, changePtr->removedCount);
+
+    // Notify all the registered client's handlers
+    le_event_ReportWithRefCounting(NeighborCellsChangeId, changePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start the Neighboring Cells monitoring when the first change handler is added. Called in the
+ * thread which owns the monitoring timer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void NeighborCellsHandlerAdded
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    NeighborCellsHandlerCount++;
+    if (1 == NeighborCellsHandlerCount)
+    {
+        le_timer_Start(NeighborCellsTimerRef);
+
+        // Report the cells detected so far without waiting for the first interval.
+        NeighborCellsTimerHandler(NeighborCellsTimerRef);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop the Neighboring Cells monitoring when the last change handler is removed. Called in the
+ * thread which owns the monitoring timer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void NeighborCellsHandlerRemoved
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    if (0 == NeighborCellsHandlerCount)
+    {
+        return;
+    }
+
+    NeighborCellsHandlerCount--;
+    if (0 == NeighborCellsHandlerCount)
+    {
+        le_timer_Stop(NeighborCellsTimerRef);
+
+        // The next handler gets all the detected cells as added.
+        ReportedCellsCount = 0;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply the Neighboring Cells monitoring interval. Called in the thread which owns the monitoring
+ * timer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SetNeighborCellsInterval
+(
+    void* param1Ptr,
+    void* param2Ptr
+)
+{
+    le_clk_Time_t interval = { .sec = NeighborCellsInterval };
+
+    LE_UNUSED(param1Ptr);
+    LE_UNUSED(param2Ptr);
+
+    le_timer_SetInterval(NeighborCellsTimerRef, interval);
+}
+
 //--------------------------------------------------------------------------------------------------
 // APIs.
 //--------------------------------------------------------------------------------------------------
@@ -2139,6 +2631,11 @@ void le_mrc_InitPools
     // References.
     CellListRefMap = le_ref_InitStaticMap(CellListRefMap, MAX_NUM_NEIGHBOR_LISTS);
 
+    // Create the pool for Neighboring Cells change reports.
+    NeighborCellsChangePool = le_mem_InitStaticPool(NeighborCellsChange,
+                                                    MAX_NUM_NEIGHBOR_CELLS_CHANGES,
+                                                    sizeof(NeighborCellsChange_t));
+
     // Create the pool for each client session Signal Metrics.
     MetricsSessionPool = le_mem_InitStaticPool(MetricsSession,
                                                MAX_NUM_METRICS_SESSION,
@@ -2201,6 +2698,15 @@ void le_mrc_Init
     // Register a handler function for new Rank indicate change indication
     pa_mrc_AddRankChangeHandler(RankChangeHandler);
 
+    // Create an event Id for Neighboring Cells change notification, and the timer used to
+    // monitor the Neighboring Cells while a handler is registered.
+    NeighborCellsChangeId = le_event_CreateIdWithRefCounting("NeighborCellsChange");
+    NeighborCellsThreadRef = le_thread_GetCurrent();
+    NeighborCellsTimerRef = le_timer_Create("Neighbor cells monitoring timer");
+    le_timer_SetHandler(NeighborCellsTimerRef, NeighborCellsTimerHandler);
+    le_timer_SetRepeat(NeighborCellsTimerRef, 0);
+    SetNeighborCellsInterval(NULL, NULL);
+
     // Register a handler function for network reject indication
     pa_mrc_AddNetworkRejectIndHandler(NetRegRejectHandler, NULL);
 
@@ -3392,6 +3898,86 @@ le_result_t le_mrc_SetRankChangeMonitoring
     return pa_mrc_SetRankChangeMonitoring(enable);
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register an handler for Neighboring Cells changes.
+ *
+ * @return A handler reference, which is only needed for later removal of the handler.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_mrc_NeighborCellsChangeHandlerRef_t le_mrc_AddNeighborCellsChangeHandler
+(
+    le_mrc_NeighborCellsChangeHandlerFunc_t handlerFuncPtr, ///< [IN] The handler function.
+    void*                                   contextPtr      ///< [IN] The handler's context.
+)
+{
+    le_event_HandlerRef_t        handlerRef;
+
+    if (handlerFuncPtr == NULL)
+    {
+        LE_KILL_CLIENT("Handler function is NULL !");
+        return NULL;
+    }
+
+    handlerRef = le_event_AddLayeredHandler("NeighborCellsChangeHandler",
+                                            NeighborCellsChangeId,
+                                            FirstLayerNeighborCellsChangeHandler,
+                                            handlerFuncPtr);
+
+    le_event_SetContextPtr(handlerRef, contextPtr);
+
+    le_event_QueueFunctionToThread(NeighborCellsThreadRef, NeighborCellsHandlerAdded, NULL, NULL);
+
+    return (le_mrc_NeighborCellsChangeHandlerRef_t)(handlerRef);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to remove an handler for Neighboring Cells changes.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mrc_RemoveNeighborCellsChangeHandler
+(
+    le_mrc_NeighborCellsChangeHandlerRef_t    handlerRef ///< [IN] The handler reference.
+)
+{
+    le_event_RemoveHandler((le_event_HandlerRef_t)handlerRef);
+
+    le_event_QueueFunctionToThread(NeighborCellsThreadRef, NeighborCellsHandlerRemoved, NULL, NULL);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to set the Neighboring Cells monitoring parameters used for the
+ * NeighborCellsChange event.
+ *
+ * @return
+ *      - LE_OK            The function succeeded.
+ *      - LE_BAD_PARAMETER The interval is 0.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_mrc_SetNeighborCellsChangeMonitoring
+(
+    uint32_t interval,      ///< [IN] Monitoring interval in seconds
+    uint16_t rxLevelDelta   ///< [IN] Signal strength delta in dBm
+)
+{
+    if (0 == interval)
+    {
+        LE_ERROR("Invalid monitoring interval");
+        return LE_BAD_PARAMETER;
+    }
+
+    NeighborCellsInterval = interval;
+    NeighborCellsRxLevelDelta = rxLevelDelta;
+
+    le_event_QueueFunctionToThread(NeighborCellsThreadRef, SetNeighborCellsInterval, NULL, NULL);
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the power of the Radio Module.
@@ -4291,6 +4877,118 @@ bool le_mrc_IsCellularNetworkForbidden
     return scanInformationPtr->isForbidden;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to get all the information of a Scan Information list in a single
+ * call.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the array is filled with the first networks of the list only
+ *      - LE_FAULT for all other errors
+ *
+ * @note
+ *      On failure, the process exits, so you don't have to worry about checking the returned
+ *      reference for validity.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_mrc_GetCellularNetworkScanData
+(
+    le_mrc_ScanInformationListRef_t scanInformationListRef, ///< [IN] The list of scan information.
+    le_mrc_ScanData_t*              networksPtr,            ///< [OUT] The networks in sight.
+    size_t*                         networksSizePtr         ///< [IN/OUT] Number of networks
+)
+{
+    ScanInfoList_t* scanInformationListPtr = le_ref_Lookup(ScanInformationListRefMap,
+                                                           scanInformationListRef);
+
+    if (scanInformationListPtr == NULL)
+    {
+        LE_KILL_CLIENT("Invalid reference (%p) provided!", scanInformationListRef);
+        return LE_FAULT;
+    }
+
+    if ((networksPtr == NULL) || (networksSizePtr == NULL))
+    {
+        LE_KILL_CLIENT("networksPtr is NULL.");
+        return LE_FAULT;
+    }
+
+    return GetScanData(&(scanInformationListPtr->paScanInfoList), networksPtr, networksSizePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to perform a cellular network scan and get the networks in sight
+ * in a single call.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_OVERFLOW if the array is filled with the first networks found only
+ *      - LE_FAULT if the scan failed
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_mrc_PerformCellularNetworkScanData
+(
+    le_mrc_RatBitMask_t ratMask,            ///< [IN] Radio Access Technology bitmask
+    le_mrc_ScanData_t*  networksPtr,        ///< [OUT] The networks in sight.
+    size_t*             networksSizePtr     ///< [IN/OUT] Number of networks
+)
+{
+    le_dls_List_t scanInfoList = LE_DLS_LIST_INIT;
+    le_result_t   result;
+
+    if ((networksPtr == NULL) || (networksSizePtr == NULL))
+    {
+        LE_KILL_CLIENT("networksPtr is NULL.");
+        return LE_FAULT;
+    }
+
+    LOCK();
+    result = pa_mrc_PerformNetworkScan(ratMask, PA_MRC_SCAN_PLMN, &scanInfoList);
+    UNLOCK();
+
+    if (result != LE_OK)
+    {
+        LE_ERROR("Network scan error");
+        *networksSizePtr = 0;
+        result = LE_FAULT;
+    }
+    else
+    {
+        result = GetScanData(&scanInfoList, networksPtr, networksSizePtr);
+    }
+
+    pa_mrc_DeleteScanInformation(&scanInfoList);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to retrieve the Neighboring Cells information in a single call.
+ *
+ * @return
+ *      - LE_OK on success, the array is empty when no neighboring cell is detected
+ *      - LE_OVERFLOW if the array is filled with the first cells found only
+ *      - LE_FAULT if the Neighboring Cells information could not be retrieved
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_mrc_GetNeighborCellsData
+(
+    le_mrc_NeighborCellData_t* cellsPtr,        ///< [OUT] The neighboring cells.
+    size_t*                    cellsSizePtr     ///< [IN/OUT] Number of cells
+)
+{
+    if ((cellsPtr == NULL) || (cellsSizePtr == NULL))
+    {
+        LE_KILL_CLIENT("cellsPtr is NULL.");
+        return LE_FAULT;
+    }
+
+    return GetNeighborCells(cellsPtr, cellsSizePtr);
+}
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -11,6 +11,22 @@
 #include "legato.h"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Neighboring Cells change report: the cells added, changed or removed since the previous report.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t                    addedCount;                           // number of added cells
+    le_mrc_NeighborCellData_t added[LE_MRC_NEIGHBOR_CELLS_MAX];     // added cells
+    size_t                    changedCount;                         // number of changed cells
+    le_mrc_NeighborCellData_t changed[LE_MRC_NEIGHBOR_CELLS_MAX];   // changed cells
+    size_t                    removedCount;                         // number of removed cells
+    le_mrc_NeighborCellData_t removed[LE_MRC_NEIGHBOR_CELLS_MAX];   // removed cells
+} NeighborCellsChange_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize MRC memory pools
@@ -48,4 +64,23 @@ le_result_t le_mrc_TestMccMnc
     const char*   mncPtr       ///< [IN] Mobile Network Code
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the Neighboring Cells change report from the cells last reported and the current cells,
+ * then update the cells last reported. A cell is changed when one of its levels moved by at least
+ * the delta since the value last reported for it (10 times the delta for the levels with 1 decimal
+ * place), and any change is reported with a delta of 0. The levels of an unchanged cell are kept
+ * as last reported, so that a slow drift is reported once it reaches the delta.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_mrc_ComputeNeighborCellsChange
+(
+    le_mrc_NeighborCellData_t*       reportedPtr,      ///< [IN/OUT] Cells last reported
+    size_t*                          reportedCountPtr, ///< [IN/OUT] Number of cells last reported
+    const le_mrc_NeighborCellData_t* cellsPtr,         ///< [IN] Current cells
+    size_t                           cellsCount,       ///< [IN] Number of current cells
+    int32_t                          rxLevelDelta,     ///< [IN] Signal strength delta in dBm
+    NeighborCellsChange_t*           changePtr         ///< [OUT] Change report
+);
+
 #endif // LEGATO_MRC_LOCAL_INCLUDE_GUARD
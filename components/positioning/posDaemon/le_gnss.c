@@ -199,6 +199,8 @@ typedef struct le_gnss_PositionSample
     bool              satMeasValid;           ///< if true, satMeas is set
     le_gnss_SvMeas_t  satMeas[LE_GNSS_SV_INFO_MAX_LEN];
                                               ///< Satellite Vehicle measurement information.
+    uint32_t          numOfRequests;          ///< Number of position sample requests sharing
+                                              ///< that sample.
     le_dls_Link_t   link;                     ///< Object node link
 }
 le_gnss_PositionSample_t;
@@ -218,6 +220,21 @@ typedef struct le_gnss_PositionHandler
 }
 le_gnss_PositionHandler_t;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position Data's Handler structure.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_gnss_PositionDataHandler
+{
+    le_gnss_PositionDataHandlerFunc_t handlerFuncPtr;      ///< The handler function address.
+    void*                             handlerContextPtr;   ///< The handler function context.
+    le_msg_SessionRef_t               sessionRef;          ///< Store message session reference.
+    le_dls_Link_t                     link;                ///< Object node link
+}
+le_gnss_PositionDataHandler_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Position sample request objet structure.
@@ -307,6 +324,39 @@ static int32_t NumOfPositionHandlers = 0;
 //--------------------------------------------------------------------------------------------------
 static le_dls_List_t PositionHandlerList = LE_DLS_LIST_DECL_INIT;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Static memory pool for position data handlers
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(PositionDataHandler,
+                          GNSS_POSITION_HANDLER_HIGH,
+                          sizeof(le_gnss_PositionDataHandler_t));
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory Pool for position data handlers.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t   PositionDataHandlerPoolRef;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of position data Handler functions.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static int32_t NumOfPositionDataHandlers = 0;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create and initialize the position data handlers list.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t PositionDataHandlerList = LE_DLS_LIST_DECL_INIT;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Memory Pool for position samples.
@@ -696,33 +746,29 @@ static void PositionSampleDestructor
     void* obj
 )
 {
-    le_gnss_PositionSample_t *positionSampleNodePtr;
-    le_dls_Link_t   *linkPtr;
+    le_gnss_PositionSample_t *positionSampleNodePtr = (le_gnss_PositionSample_t*)obj;
 
     LE_FATAL_IF((NULL == obj), "Position Sample Object does not exist!");
 
-    linkPtr = le_dls_Peek(&PositionSampleList);
-    if (linkPtr != NULL)
-    {
-        do
-        {
-            // Get the node from the list
-            positionSampleNodePtr = (le_gnss_PositionSample_t*)
-                                    CONTAINER_OF(linkPtr, le_gnss_PositionSample_t, link);
-            // Check the node.
-            if (positionSampleNodePtr == (le_gnss_PositionSample_t*)obj)
-            {
-                // Remove the node.
-                le_dls_Remove(&PositionSampleList, linkPtr);
-                linkPtr=NULL;
-            }
-            else
-            {
-                // Move to the next node.
-                linkPtr = le_dls_PeekNext(&PositionSampleList, linkPtr);
-            }
-        } while (linkPtr != NULL);
-    }
+    // The sample is always queued in the list while allocated, remove it directly.
+    le_dls_Remove(&PositionSampleList, &(positionSampleNodePtr->link));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Position Data Handler destructor.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void PositionDataHandlerDestructor
+(
+    void* obj
+)
+{
+    le_gnss_PositionDataHandler_t *positionDataHandlerNodePtr =
+                                                        (le_gnss_PositionDataHandler_t*)obj;
+
+    le_dls_Remove(&PositionDataHandlerList, &(positionDataHandlerNodePtr->link));
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1041,22 +1087,18 @@ static le_gnss_Client_t* GetClientSessionReference
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Convert the DOP value in the selected resolution.
+ * Convert the DOP value in the resolution selected by a given client.
  */
 //--------------------------------------------------------------------------------------------------
-static uint32_t ConvertDop
+static uint32_t ConvertClientDop
 (
-    uint32_t dopValue    ///< [IN] Dilution of Precision value to convert.
+    le_gnss_Client_t* clientRequestPtr,     ///< [IN] Client session, NULL for default resolution.
+    uint32_t dopValue                       ///< [IN] Dilution of Precision value to convert.
 )
 {
     uint16_t resValue = 0;
-
-    le_gnss_Client_t* clientRequestPtr = NULL;
-    le_msg_SessionRef_t sessionRef = le_gnss_GetClientSessionRef();
     le_gnss_Resolution_t resolution = LE_GNSS_RES_UNKNOWN;
 
-    clientRequestPtr = FindClientSessionReference(sessionRef);
-
     if (NULL != clientRequestPtr)
     {
         resolution = clientRequestPtr->dopResolution;
@@ -1086,22 +1128,34 @@ static uint32_t ConvertDop
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Convert the position data in the selected resolution.
+ * Convert the DOP value in the resolution selected by the current client session.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ConvertDop
+(
+    uint32_t dopValue    ///< [IN] Dilution of Precision value to convert.
+)
+{
+    return ConvertClientDop(FindClientSessionReference(le_gnss_GetClientSessionRef()), dopValue);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert the position data in the resolution selected by a given client.
  *
  * @return
  *  - LE_OK     The function succeed.
  *  - LE_FAULT  The function failed.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ConvertPositionData
+static le_result_t ConvertClientPositionData
 (
-    int32_t value,                 ///< [IN] Data value to convert.
-    le_gnss_DataType_t dataType,   ///< [IN] Data type.
-    int32_t* valuePtr              ///< [OUT] The converted data value.
+    le_gnss_Client_t* clientRequestPtr,     ///< [IN] Client session, NULL for default resolution.
+    int32_t value,                          ///< [IN] Data value to convert.
+    le_gnss_DataType_t dataType,            ///< [IN] Data type.
+    int32_t* valuePtr                       ///< [OUT] The converted data value.
 )
 {
-    le_gnss_Client_t* clientRequestPtr = NULL;
-    le_msg_SessionRef_t sessionRef = le_gnss_GetClientSessionRef();
     le_gnss_Resolution_t resolution = LE_GNSS_RES_UNKNOWN;
 
     if (NULL == valuePtr)
@@ -1110,8 +1164,6 @@ static le_result_t ConvertPositionData
         return LE_FAULT;
     }
 
-    clientRequestPtr = FindClientSessionReference(sessionRef);
-
     if (NULL != clientRequestPtr)
     {
         switch(dataType)
@@ -1172,6 +1224,221 @@ static le_result_t ConvertPositionData
     return LE_OK;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert the position data in the resolution selected by the current client session.
+ *
+ * @return
+ *  - LE_OK     The function succeed.
+ *  - LE_FAULT  The function failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ConvertPositionData
+(
+    int32_t value,                 ///< [IN] Data value to convert.
+    le_gnss_DataType_t dataType,   ///< [IN] Data type.
+    int32_t* valuePtr              ///< [OUT] The converted data value.
+)
+{
+    return ConvertClientPositionData(FindClientSessionReference(le_gnss_GetClientSessionRef()),
+                                     value, dataType, valuePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a DOP value for the snapshot of a position sample.
+ *
+ * @return The DOP value in the client resolution, UINT16_MAX if invalid.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint16_t PackDop
+(
+    le_gnss_Client_t* clientRequestPtr,     ///< [IN] Client session, NULL for default resolution.
+    bool dopValid,                          ///< [IN] Whether the DOP value is set.
+    uint32_t dopValue                       ///< [IN] Dilution of Precision value to convert.
+)
+{
+    if (dopValid)
+    {
+        uint32_t dop = ConvertClientDop(clientRequestPtr, dopValue);
+
+        // Test if the dop value exceeds a uint16_t after the conversion
+        if (!(dop >> 16))
+        {
+            return (uint16_t)dop;
+        }
+    }
+    return UINT16_MAX;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill the snapshot of a position sample, as the individual position sample getters would return
+ * the data for a given client.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PackSampleData
+(
+    const le_gnss_PositionSample_t* samplePtr,  ///< [IN] Position sample.
+    le_gnss_Client_t* clientRequestPtr,         ///< [IN] Client session, NULL for default
+                                                ///<      resolutions.
+    le_gnss_SampleData_t* dataPtr               ///< [OUT] Snapshot of the position sample.
+)
+{
+    dataPtr->fixState = samplePtr->fixState;
+
+    dataPtr->latitude = samplePtr->latitudeValid ? samplePtr->latitude : INT32_MAX;
+    dataPtr->longitude = samplePtr->longitudeValid ? samplePtr->longitude : INT32_MAX;
+    dataPtr->hAccuracy = samplePtr->hAccuracyValid ? samplePtr->hAccuracy : INT32_MAX;
+    dataPtr->horUncEllipseSemiMajor = samplePtr->horUncEllipseSemiMajorValid ?
+                                      samplePtr->horUncEllipseSemiMajor : UINT32_MAX;
+    dataPtr->horUncEllipseSemiMinor = samplePtr->horUncEllipseSemiMinorValid ?
+                                      samplePtr->horUncEllipseSemiMinor : UINT32_MAX;
+    dataPtr->horConfidence = samplePtr->horConfidenceValid ? samplePtr->horConfidence : UINT8_MAX;
+
+    dataPtr->altitude = samplePtr->altitudeValid ? samplePtr->altitude : INT32_MAX;
+    dataPtr->altitudeOnWgs84 = samplePtr->altitudeOnWgs84Valid ?
+                               samplePtr->altitudeOnWgs84 : INT32_MAX;
+    if ((!samplePtr->vAccuracyValid) ||
+        (LE_OK != ConvertClientPositionData(clientRequestPtr, samplePtr->vAccuracy,
+                                            LE_GNSS_DATA_VACCURACY, &dataPtr->vAccuracy)))
+    {
+        dataPtr->vAccuracy = INT32_MAX;
+    }
+
+    dataPtr->hSpeed = samplePtr->hSpeedValid ? samplePtr->hSpeed : UINT32_MAX;
+    if ((!samplePtr->hSpeedAccuracyValid) ||
+        (LE_OK != ConvertClientPositionData(clientRequestPtr, samplePtr->hSpeedAccuracy,
+                                            LE_GNSS_DATA_HSPEEDACCURACY,
+                                            (int32_t*)&dataPtr->hSpeedAccuracy)))
+    {
+        dataPtr->hSpeedAccuracy = UINT32_MAX;
+    }
+    dataPtr->vSpeed = samplePtr->vSpeedValid ? samplePtr->vSpeed : INT32_MAX;
+    if ((!samplePtr->vSpeedAccuracyValid) ||
+        (LE_OK != ConvertClientPositionData(clientRequestPtr, samplePtr->vSpeedAccuracy,
+                                            LE_GNSS_DATA_VSPEEDACCURACY,
+                                            &dataPtr->vSpeedAccuracy)))
+    {
+        dataPtr->vSpeedAccuracy = INT32_MAX;
+    }
+    dataPtr->direction = samplePtr->directionValid ? samplePtr->direction : UINT32_MAX;
+    dataPtr->directionAccuracy = samplePtr->directionAccuracyValid ?
+                                 samplePtr->directionAccuracy : UINT32_MAX;
+
+    dataPtr->dateValid = samplePtr->dateValid;
+    dataPtr->year = samplePtr->dateValid ? samplePtr->year : 0;
+    dataPtr->month = samplePtr->dateValid ? samplePtr->month : 0;
+    dataPtr->day = samplePtr->dateValid ? samplePtr->day : 0;
+
+    dataPtr->timeValid = samplePtr->timeValid;
+    dataPtr->hours = samplePtr->timeValid ? samplePtr->hours : 0;
+    dataPtr->minutes = samplePtr->timeValid ? samplePtr->minutes : 0;
+    dataPtr->seconds = samplePtr->timeValid ? samplePtr->seconds : 0;
+    dataPtr->milliseconds = samplePtr->timeValid ? samplePtr->milliseconds : 0;
+    dataPtr->epochTime = samplePtr->timeValid ? samplePtr->epochTime : 0;
+
+    dataPtr->gpsTimeValid = samplePtr->gpsTimeValid;
+    dataPtr->gpsWeek = samplePtr->gpsTimeValid ? samplePtr->gpsWeek : 0;
+    dataPtr->gpsTimeOfWeek = samplePtr->gpsTimeValid ? samplePtr->gpsTimeOfWeek : 0;
+    dataPtr->timeAccuracy = samplePtr->timeAccuracyValid ? samplePtr->timeAccuracy : UINT16_MAX;
+    dataPtr->leapSeconds = samplePtr->leapSecondsValid ? samplePtr->leapSeconds : UINT8_MAX;
+
+    dataPtr->pdop = PackDop(clientRequestPtr, samplePtr->pdopValid, samplePtr->pdop);
+    dataPtr->hdop = PackDop(clientRequestPtr, samplePtr->hdopValid, samplePtr->hdop);
+    dataPtr->vdop = PackDop(clientRequestPtr, samplePtr->vdopValid, samplePtr->vdop);
+    dataPtr->gdop = PackDop(clientRequestPtr, samplePtr->gdopValid, samplePtr->gdop);
+    dataPtr->tdop = PackDop(clientRequestPtr, samplePtr->tdopValid, samplePtr->tdop);
+
+    dataPtr->magneticDeviation = samplePtr->magneticDeviationValid ?
+                                 samplePtr->magneticDeviation : INT32_MAX;
+
+    dataPtr->satsInViewCount = samplePtr->satsInViewCountValid ?
+                               samplePtr->satsInViewCount : UINT8_MAX;
+    dataPtr->satsTrackingCount = samplePtr->satsTrackingCountValid ?
+                                 samplePtr->satsTrackingCount : UINT8_MAX;
+    dataPtr->satsUsedCount = samplePtr->satsUsedCountValid ? samplePtr->satsUsedCount : UINT8_MAX;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a position sample node holding a copy of the last position sample.
+ *
+ * The sample can be shared by several position sample requests, see CreateSampleRequest(), and is
+ * freed when the last of them is released, see ReleaseSampleRequest().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_PositionSample_t* CreateLastPositionSample
+(
+    void
+)
+{
+    le_gnss_PositionSample_t* positionSampleNodePtr =
+                            (le_gnss_PositionSample_t*)le_mem_ForceAlloc(PositionSamplePoolRef);
+
+    // Copy the position sample to the position sample node
+    memcpy(positionSampleNodePtr, &LastPositionSample, sizeof(le_gnss_PositionSample_t));
+    positionSampleNodePtr->numOfRequests = 0;
+
+    // Add the node to the queue of the list by passing in the node's link.
+    positionSampleNodePtr->link = LE_DLS_LINK_INIT;
+    le_dls_Queue(&PositionSampleList, &(positionSampleNodePtr->link));
+
+    return positionSampleNodePtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a position sample request on a position sample for a client session, and its safe
+ * reference.
+ *
+ * @return The safe reference of the position sample request.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_gnss_SampleRef_t CreateSampleRequest
+(
+    le_gnss_PositionSample_t* positionSampleNodePtr,    ///< [IN] Shared position sample.
+    le_msg_SessionRef_t sessionRef                      ///< [IN] Client session.
+)
+{
+    le_gnss_PositionSampleRequest_t* positionSampleRequestNodePtr =
+                (le_gnss_PositionSampleRequest_t*)le_mem_ForceAlloc(PositionSampleRequestPoolRef);
+
+    positionSampleNodePtr->numOfRequests++;
+    positionSampleRequestNodePtr->positionSampleNodePtr = positionSampleNodePtr;
+    positionSampleRequestNodePtr->sessionRef = sessionRef;
+    positionSampleRequestNodePtr->link = LE_DLS_LINK_INIT;
+    positionSampleRequestNodePtr->positionSampleRef = le_ref_CreateRef(PositionSampleMap,
+                                                                  positionSampleRequestNodePtr);
+
+    return positionSampleRequestNodePtr->positionSampleRef;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a position sample request, and the position sample if that request was the last one
+ * sharing it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseSampleRequest
+(
+    le_gnss_PositionSampleRequest_t* positionSampleRequestNodePtr ///< [IN] Sample request.
+)
+{
+    le_gnss_PositionSample_t* positionSampleNodePtr =
+                                                positionSampleRequestNodePtr->positionSampleNodePtr;
+
+    le_ref_DeleteRef(PositionSampleMap, positionSampleRequestNodePtr->positionSampleRef);
+    le_mem_Release(positionSampleRequestNodePtr);
+
+    LE_ASSERT(positionSampleNodePtr->numOfRequests > 0);
+    positionSampleNodePtr->numOfRequests--;
+    if (0 == positionSampleNodePtr->numOfRequests)
+    {
+        le_mem_Release(positionSampleNodePtr);
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 // APIs.
 //--------------------------------------------------------------------------------------------------
@@ -1187,11 +1454,7 @@ static void PaPositionHandler
     pa_Gnss_Position_t* positionPtr
 )
 {
-
-    le_gnss_PositionHandler_t*  positionHandlerNodePtr;
     le_dls_Link_t*              linkPtr;
-    le_gnss_PositionSampleRequest_t*    positionSampleRequestNodePtr=NULL;
-    uint8_t i;
 
     if (NULL == positionPtr)
     {
@@ -1203,73 +1466,103 @@ static void PaPositionHandler
 
     // Get the position sample data from the PA position data report
     GetPosSampleData(&LastPositionSample, positionPtr);
+    le_mem_Release(positionPtr);
 
-    if(!NumOfPositionHandlers)
+    if ((!NumOfPositionHandlers) && (!NumOfPositionDataHandlers))
     {
         LE_DEBUG("No positioning handlers, exit Handler Function");
-        le_mem_Release(positionPtr);
         return;
     }
 
+    // Call position handler(s).
+    // A single copy of the sample is shared by all the handlers, each of them getting its own
+    // request on it. The sample is freed when the last request is released.
     linkPtr = le_dls_Peek(&PositionHandlerList);
     if (NULL != linkPtr)
     {
-        // Create the position request sample node.
-        positionSampleRequestNodePtr =
-                 (le_gnss_PositionSampleRequest_t*)le_mem_ForceAlloc(PositionSampleRequestPoolRef);
-
-        // Create the position sample node.
-        positionSampleRequestNodePtr->positionSampleNodePtr =
-                 (le_gnss_PositionSample_t*)le_mem_ForceAlloc(PositionSamplePoolRef);
-
-        // Add reference for each subscribe handler.
-        for(i=0 ; i<NumOfPositionHandlers-1 ; i++)
-        {
-            le_mem_AddRef((void *)positionSampleRequestNodePtr);
-            le_mem_AddRef((void *)positionSampleRequestNodePtr->positionSampleNodePtr);
-        }
-
-        // Copy the position sample to the position sample node
-        memcpy(positionSampleRequestNodePtr->positionSampleNodePtr, &LastPositionSample,
-                     sizeof(le_gnss_PositionSample_t));
-
-        // Add the node to the queue of the list by passing in the node's link.
-        positionSampleRequestNodePtr->positionSampleNodePtr->link = LE_DLS_LINK_INIT;
-        le_dls_Queue(&PositionSampleList, &(positionSampleRequestNodePtr->
-                                                positionSampleNodePtr->link));
-
-        // Call Handler(s)
+        le_gnss_PositionSample_t* positionSampleNodePtr = CreateLastPositionSample();
         do
         {
             // Get the node from the list
-            positionHandlerNodePtr =
+            le_gnss_PositionHandler_t* positionHandlerNodePtr =
                 (le_gnss_PositionHandler_t*)CONTAINER_OF(linkPtr, le_gnss_PositionHandler_t, link);
 
             LE_DEBUG("Report sample %p to the corresponding handler (handler %p)",
-                     positionSampleRequestNodePtr->positionSampleNodePtr,
-                     positionHandlerNodePtr->handlerFuncPtr);
-
-            // Create a safe reference and call the client's handler
-            le_gnss_SampleRef_t safePositionSampleRef = le_ref_CreateRef(PositionSampleMap,
-                                                           positionSampleRequestNodePtr);
+                     positionSampleNodePtr, positionHandlerNodePtr->handlerFuncPtr);
 
-            // Store message session reference which will be useful for close session handler
-            positionSampleRequestNodePtr->sessionRef = positionHandlerNodePtr->sessionRef;
+            // Create a safe reference owned by the handler's client session, and call the
+            // client's handler
+            le_gnss_SampleRef_t safePositionSampleRef = CreateSampleRequest(positionSampleNodePtr,
+                                                            positionHandlerNodePtr->sessionRef);
 
-            // Store safereference which will be useful for close session handler
-            positionSampleRequestNodePtr->positionSampleRef = safePositionSampleRef;
-
-            if(safePositionSampleRef != NULL)
-            {
-                positionHandlerNodePtr->handlerFuncPtr(safePositionSampleRef,
+            positionHandlerNodePtr->handlerFuncPtr(safePositionSampleRef,
                                                    positionHandlerNodePtr->handlerContextPtr);
-            }
+
             // Move to the next node.
             linkPtr = le_dls_PeekNext(&PositionHandlerList, linkPtr);
         } while (NULL != linkPtr);
     }
 
-    le_mem_Release(positionPtr);
+    // Call position data handler(s), the snapshot is sent with the notification.
+    linkPtr = le_dls_Peek(&PositionDataHandlerList);
+    while (NULL != linkPtr)
+    {
+        le_gnss_SampleData_t sampleData;
+        le_gnss_PositionDataHandler_t* positionDataHandlerNodePtr =
+                                        (le_gnss_PositionDataHandler_t*)CONTAINER_OF(linkPtr,
+                                                             le_gnss_PositionDataHandler_t, link);
+
+        // Pack the sample in the resolutions selected by the handler's client session
+        PackSampleData(&LastPositionSample,
+                       FindClientSessionReference(positionDataHandlerNodePtr->sessionRef),
+                       &sampleData);
+
+        positionDataHandlerNodePtr->handlerFuncPtr(&sampleData,
+                                                   positionDataHandlerNodePtr->handlerContextPtr);
+
+        // Move to the next node.
+        linkPtr = le_dls_PeekNext(&PositionDataHandlerList, linkPtr);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Subscribe to the PA position data handler if not already done.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SubscribePaPositionHandler
+(
+    void
+)
+{
+    if (NULL == PaHandlerRef)
+    {
+        if ((PaHandlerRef=pa_gnss_AddPositionDataHandler(PaPositionHandler)) == NULL)
+        {
+            LE_ERROR("Failed to add PA position Data handler!");
+        }
+        else
+        {
+            LE_DEBUG("PaHandlerRef %p subscribed", PaHandlerRef);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unsubscribe from the PA position data handler when there is no more position handlers.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UnsubscribePaPositionHandler
+(
+    void
+)
+{
+    if ((0 == NumOfPositionHandlers) && (0 == NumOfPositionDataHandlers))
+    {
+        pa_gnss_RemovePositionDataHandler(PaHandlerRef);
+        PaHandlerRef = NULL;
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1341,6 +1634,22 @@ static void CloseSessionEventHandler
         result = le_ref_NextNode(iterRef);
     }
 
+    // Remove the position data handlers of the closed session.
+    le_dls_Link_t* linkPtr = le_dls_Peek(&PositionDataHandlerList);
+    while (NULL != linkPtr)
+    {
+        le_gnss_PositionDataHandler_t* positionDataHandlerNodePtr =
+                                        (le_gnss_PositionDataHandler_t*)CONTAINER_OF(linkPtr,
+                                                             le_gnss_PositionDataHandler_t, link);
+        linkPtr = le_dls_PeekNext(&PositionDataHandlerList, linkPtr);
+
+        if (positionDataHandlerNodePtr->sessionRef == sessionRef)
+        {
+            le_gnss_RemovePositionDataHandler(
+                                (le_gnss_PositionDataHandlerRef_t)positionDataHandlerNodePtr);
+        }
+    }
+
     iterRef = le_ref_GetIterator(ClientRequestRefMap);
     result = le_ref_NextNode(iterRef);
     while (LE_OK == result)
@@ -1467,6 +1776,12 @@ le_result_t gnss_Init
                                                    sizeof(le_gnss_PositionHandler_t));
     le_mem_SetDestructor(PositionHandlerPoolRef, PositionHandlerDestructor);
 
+    // Create a pool for Position Data Handler objects
+    PositionDataHandlerPoolRef = le_mem_InitStaticPool(PositionDataHandler,
+                                                       GNSS_POSITION_HANDLER_HIGH,
+                                                       sizeof(le_gnss_PositionDataHandler_t));
+    le_mem_SetDestructor(PositionDataHandlerPoolRef, PositionDataHandlerDestructor);
+
     // Create a pool for Position Sample objects
     PositionSamplePoolRef = le_mem_InitStaticPool(PositionSample,
                                                   GNSS_POSITION_SAMPLE_MAX,
@@ -1495,6 +1810,7 @@ le_result_t gnss_Init
 
     // Initialize Handler context
     NumOfPositionHandlers = 0;
+    NumOfPositionDataHandlers = 0;
     PaHandlerRef = NULL;
 
     // Initialize last Position sample
@@ -1578,17 +1894,7 @@ le_gnss_PositionHandlerRef_t le_gnss_AddPositionHandler
     LE_DEBUG("handler %p", handlerPtr);
 
     // Subscribe to PA position Data handler
-    if (NULL == PaHandlerRef)
-    {
-        if ((PaHandlerRef=pa_gnss_AddPositionDataHandler(PaPositionHandler)) == NULL)
-        {
-            LE_ERROR("Failed to add PA position Data handler!");
-        }
-        else
-        {
-            LE_DEBUG("PaHandlerRef %p subscribed", PaHandlerRef);
-        }
-    }
+    SubscribePaPositionHandler();
 
     // Update the position handler list with that new handler
     le_dls_Queue(&PositionHandlerList, &(positionHandlerPtr->link));
@@ -1640,11 +1946,84 @@ void le_gnss_RemovePositionHandler
         } while (linkPtr != NULL);
     }
 
-    if(NumOfPositionHandlers == 0)
+    UnsubscribePaPositionHandler();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to register an handler for position data notifications.
+ *
+ *  - A handler reference, which is only needed for later removal of the handler.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+le_gnss_PositionDataHandlerRef_t le_gnss_AddPositionDataHandler
+(
+    le_gnss_PositionDataHandlerFunc_t handlerPtr,      ///< [IN] The handler function.
+    void*                             contextPtr       ///< [IN] The context pointer
+)
+{
+    le_gnss_PositionDataHandler_t*  positionDataHandlerPtr=NULL;
+
+    LE_FATAL_IF((NULL == handlerPtr), "handlerPtr pointer is NULL !");
+
+    // Create the position data handler node.
+    positionDataHandlerPtr =
+                    (le_gnss_PositionDataHandler_t*)le_mem_ForceAlloc(PositionDataHandlerPoolRef);
+    positionDataHandlerPtr->link = LE_DLS_LINK_INIT;
+    positionDataHandlerPtr->handlerFuncPtr = handlerPtr;
+    positionDataHandlerPtr->handlerContextPtr = contextPtr;
+    positionDataHandlerPtr->sessionRef = le_gnss_GetClientSessionRef();
+
+    LE_DEBUG("handler %p", handlerPtr);
+
+    // Subscribe to PA position Data handler
+    SubscribePaPositionHandler();
+
+    // Update the position data handler list with that new handler
+    le_dls_Queue(&PositionDataHandlerList, &(positionDataHandlerPtr->link));
+    NumOfPositionDataHandlers++;
+
+    LE_DEBUG("Position data handler %p added", positionDataHandlerPtr->handlerFuncPtr);
+
+    return (le_gnss_PositionDataHandlerRef_t)positionDataHandlerPtr;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * This function must be called to remove a handler for position data notifications.
+ *
+ * @note Doesn't return on failure, so there's no need to check the return value for errors.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_gnss_RemovePositionDataHandler
+(
+    le_gnss_PositionDataHandlerRef_t    handlerRef ///< [IN] The handler reference.
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&PositionDataHandlerList);
+
+    while (NULL != linkPtr)
     {
-        pa_gnss_RemovePositionDataHandler(PaHandlerRef);
-        PaHandlerRef = NULL;
+        le_gnss_PositionDataHandler_t* positionDataHandlerNodePtr =
+                                        (le_gnss_PositionDataHandler_t*)CONTAINER_OF(linkPtr,
+                                                             le_gnss_PositionDataHandler_t, link);
+
+        // Check the node.
+        if ((le_gnss_PositionDataHandlerRef_t)positionDataHandlerNodePtr == handlerRef)
+        {
+            // Remove the node.
+            le_mem_Release(positionDataHandlerNodePtr);
+            NumOfPositionDataHandlers--;
+            break;
+        }
+
+        // Move to the next node.
+        linkPtr = le_dls_PeekNext(&PositionDataHandlerList, linkPtr);
     }
+
+    UnsubscribePaPositionHandler();
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -3227,6 +3606,80 @@ le_result_t le_gnss_GetMagneticDeviation
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get all the data of a position sample in a single call.
+ *
+ * @return
+ *  - LE_FAULT         Function failed to find the position sample.
+ *  - LE_OK            Function succeeded.
+ *
+ * @note If the caller is passing an invalid Position sample reference into this function,
+ *       it is a fatal error, the function will not return.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gnss_GetSampleData
+(
+    le_gnss_SampleRef_t positionSampleRef,
+        ///< [IN] Position sample's reference.
+
+    le_gnss_SampleData_t* dataPtr
+        ///< [OUT] Snapshot of the position sample.
+)
+{
+    le_gnss_PositionSampleRequest_t* positionSampleRequestNodePtr
+                                            = le_ref_Lookup(PositionSampleMap,positionSampleRef);
+
+    // Check input pointer
+    if (NULL == dataPtr)
+    {
+        LE_KILL_CLIENT("Invalid pointer provided!");
+        return LE_FAULT;
+    }
+
+    // Check position sample's reference
+    le_result_t result = ValidatePositionSamplePtr(positionSampleRequestNodePtr);
+    if (LE_OK != result)
+    {
+        return result;
+    }
+
+    PackSampleData(positionSampleRequestNodePtr->positionSampleNodePtr,
+                   FindClientSessionReference(le_gnss_GetClientSessionRef()),
+                   dataPtr);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get all the data of the last updated position sample in a single call.
+ *
+ * @return
+ *  - LE_FAULT         Function failed.
+ *  - LE_OK            Function succeeded.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gnss_GetLastSampleData
+(
+    le_gnss_SampleData_t* dataPtr
+        ///< [OUT] Snapshot of the last position sample.
+)
+{
+    // Check input pointer
+    if (NULL == dataPtr)
+    {
+        LE_KILL_CLIENT("Invalid pointer provided!");
+        return LE_FAULT;
+    }
+
+    PackSampleData(&LastPositionSample,
+                   FindClientSessionReference(le_gnss_GetClientSessionRef()),
+                   dataPtr);
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * This function gets the last updated position sample object reference.
@@ -3243,31 +3696,13 @@ le_gnss_SampleRef_t le_gnss_GetLastSampleRef
     void
 )
 {
-    le_gnss_PositionSampleRequest_t*   positionSampleRequestNodePtr=NULL;
-
     // Create the position sample node.
-    positionSampleRequestNodePtr =
-               (le_gnss_PositionSampleRequest_t*)le_mem_ForceAlloc(PositionSampleRequestPoolRef);
-    positionSampleRequestNodePtr->positionSampleNodePtr =
-               (le_gnss_PositionSample_t*)le_mem_ForceAlloc(PositionSamplePoolRef);
+    le_gnss_PositionSample_t* positionSampleNodePtr = CreateLastPositionSample();
 
-    // Copy the position sample to the position sample node
-    memcpy(positionSampleRequestNodePtr->positionSampleNodePtr, &LastPositionSample,
-           sizeof(le_gnss_PositionSample_t));
+    LE_DEBUG("Get sample %p", positionSampleNodePtr);
 
-    // Add the node to the queue of the list by passing in the node's link.
-    positionSampleRequestNodePtr->positionSampleNodePtr->link = LE_DLS_LINK_INIT;
-    le_dls_Queue(&PositionSampleList, &(positionSampleRequestNodePtr->positionSampleNodePtr->link));
-
-    LE_DEBUG("Get sample %p", positionSampleRequestNodePtr->positionSampleNodePtr);
-
-    positionSampleRequestNodePtr->sessionRef = le_gnss_GetClientSessionRef();
-
-    le_gnss_SampleRef_t reqRef = le_ref_CreateRef(PositionSampleMap, positionSampleRequestNodePtr);
-    positionSampleRequestNodePtr->positionSampleRef = reqRef;
-
-    // Create a safe reference and call the client's handler
-    return reqRef;
+    // Create a safe reference owned by the client session
+    return CreateSampleRequest(positionSampleNodePtr, le_gnss_GetClientSessionRef());
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -3293,9 +3728,7 @@ void le_gnss_ReleaseSampleRef
         return;
     }
 
-    le_ref_DeleteRef(PositionSampleMap,positionSampleRef);
-    le_mem_Release(positionSampleRequestNodePtr->positionSampleNodePtr);
-    le_mem_Release(positionSampleRequestNodePtr);
+    ReleaseSampleRequest(positionSampleRequestNodePtr);
 }
 
 //--------------------------------------------------------------------------------------------------
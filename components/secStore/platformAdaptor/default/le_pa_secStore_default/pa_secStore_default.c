@@ -204,6 +204,32 @@ LE_SHARED le_result_t pa_secStore_Move
     return LE_UNAVAILABLE;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Applies a batch of writes and deletes, in order, in a single persistence step: either all the
+ * operations are stored or none of them are, even if power is lost while they are being stored.
+ * Deleting a path that does not exist is not an error.
+ *
+ * This default implementation is weak so that platforms which can commit a batch atomically can
+ * provide it; without it, the secure storage daemon journals the batch itself.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NO_MEMORY if there is not enough memory to store the data.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_UNSUPPORTED if the platform can't apply a batch atomically.  Nothing was stored.
+ *      LE_FAULT if there was some other error.  Nothing was stored.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t __attribute__((weak)) pa_secStore_CommitBatch
+(
+    const pa_secStore_BatchOp_t* opsPtr,    ///< [IN] Operations of the batch.
+    size_t opCount                          ///< [IN] Number of operations.
+)
+{
+    return LE_UNSUPPORTED;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Re-initialize the secure storage if is already initialized.
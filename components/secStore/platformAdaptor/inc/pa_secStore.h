@@ -55,6 +55,20 @@ typedef void (*pa_secStore_GetEntry_t)
     void* contextPtr                ///< [IN] Pointer to the context supplied to pa_secStore_GetEntries()
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * An operation of a batch passed to pa_secStore_CommitBatch().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const char* pathPtr;            ///< Path to write to or to delete.
+    bool isDelete;                  ///< true to delete the path and everything under it.
+    const uint8_t* bufPtr;          ///< Data to write (unused for a delete).
+    size_t bufSize;                 ///< Size of the data to write (unused for a delete).
+}
+pa_secStore_BatchOp_t;
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -221,6 +235,27 @@ LE_SHARED le_result_t pa_secStore_Move
     const char* srcPathPtr                  ///< [IN] Source path.
 );
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Applies a batch of writes and deletes, in order, in a single persistence step: either all the
+ * operations are stored or none of them are, even if power is lost while they are being stored.
+ * Deleting a path that does not exist is not an error.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NO_MEMORY if there is not enough memory to store the data.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_UNSUPPORTED if the platform can't apply a batch atomically.  Nothing was stored.
+ *      LE_FAULT if there was some other error.  Nothing was stored.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t pa_secStore_CommitBatch
+(
+    const pa_secStore_BatchOp_t* opsPtr,    ///< [IN] Operations of the batch.
+    size_t opCount                          ///< [IN] Number of operations.
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Re-initialize the secure storage if is already initialized.
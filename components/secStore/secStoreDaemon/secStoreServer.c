@@ -193,6 +193,132 @@ static le_mem_PoolRef_t EntryPool = NULL;
 
 #endif /* end !MK_CONFIG_SECSTORE_DISABLE_ADMIN */
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Path in secure storage of the journal of the batch write being committed, used when the platform
+ * can't commit a batch atomically and LE_CONFIG_SECSTORE_BATCH_JOURNAL is set.  Operation n of the
+ * batch is journaled as "n/path" (the operation type followed by the item path) and, for a write,
+ * "n/data".  The "commit" item, which holds the number of operations, is written last: once it is
+ * stored, the batch is committed and is completed from the journal if the daemon is interrupted
+ * before it is applied.  A journal left by an older build, or before the option was cleared, is
+ * still completed.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BATCH_JOURNAL_PATH          "/batch"
+#define BATCH_JOURNAL_COMMIT_PATH   BATCH_JOURNAL_PATH "/commit"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Operation types in the batch journal.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BATCH_OP_WRITE              'W'
+#define BATCH_OP_DELETE             'D'
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of operations in a batch write.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BATCH_MAX_OPS               128
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes of data buffered by a batch write.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BATCH_MAX_BYTES             (8 * LE_SECSTORE_MAX_ITEM_SIZE)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Typical size of the data of a batch write operation.  Most items are keys and credentials, so
+ * their data is allocated from a pool of blocks of this size, and only larger ones from a pool of
+ * blocks of LE_SECSTORE_MAX_ITEM_SIZE.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BATCH_DATA_TYPICAL_BYTES    256
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimated number of clients doing a batch write at the same time.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BATCH_MAP_SIZE              7
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A write or a delete buffered by a batch write.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link;                         ///< Link in the batch's list of operations.
+    char path[SECSTORE_MAX_PATH_BYTES];         ///< Path of the item, or of the deleted entries.
+    bool isDelete;                              ///< true if the path and everything under it is
+                                                ///< deleted, otherwise the item is written.
+    size_t size;                                ///< Size of the data written.
+    uint8_t* dataPtr;                           ///< Data written, from BatchDataPool, or NULL.
+}
+BatchOp_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A client's batch write.  The client's writes and deletes are buffered until the batch ends.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_msg_SessionRef_t sessionRef;             ///< Session of the client.
+    unsigned int depth;                         ///< Number of batch writes started, not yet ended.
+    le_dls_List_t ops;                          ///< Buffered operations, in order.
+    size_t opCount;                             ///< Number of buffered operations.
+    size_t byteCount;                           ///< Number of bytes of data buffered.
+    bool hasDelete;                             ///< true if the batch deletes entries.
+#if !MK_CONFIG_SECSTORE_DISABLE_LIMIT
+    bool isLimitKnown;                          ///< true once limit and clientPath are set.
+    size_t limit;                               ///< Client's secure storage limit.
+    char clientPath[SECSTORE_MAX_PATH_BYTES];   ///< Path to the client's area.
+    ssize_t sizeDelta;                          ///< Change of the space used by the client once
+                                                ///< the batch is committed.
+#endif
+}
+Batch_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of batch writes.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t BatchPool = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of batch write operations.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t BatchOpPool = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of the data of batch write operations.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t BatchDataPool = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Batch writes in progress, by client session.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t BatchMap = NULL;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flag that indicates that no batch journal is left to complete.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsBatchJournalChecked = false;
+
 #if LE_CONFIG_LINUX
 
 //--------------------------------------------------------------------------------------------------
@@ -677,11 +803,579 @@ static void GetClientPath
 {
     le_result_t result;
 
-    bufPtr[0] = '\0';
-    result = le_path_Concat("/", bufPtr, bufSize,
-                (isApp ? CURR_SYS_PATH : USERS_PATH), clientNamePtr, (void *) NULL);
-    LE_FATAL_IF(result != LE_OK, "Buffer too small for secure storage path for %s.", clientNamePtr);
+    bufPtr[0] = '\0';
+    result = le_path_Concat("/", bufPtr, bufSize,
+                (isApp ? CURR_SYS_PATH : USERS_PATH), clientNamePtr, (void *) NULL);
+    LE_FATAL_IF(result != LE_OK, "Buffer too small for secure storage path for %s.", clientNamePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the session of the client of the current IPC message.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_msg_SessionRef_t GetClientSessionRef
+(
+    bool isGlobal                   ///< [IN] Is this an operation is the global domain?
+)
+{
+#if MK_CONFIG_SECSTORE_DISABLE_GLOBAL_ACCESS
+    LE_UNUSED(isGlobal);
+#else /* !MK_CONFIG_SECSTORE_DISABLE_GLOBAL_ACCESS */
+    if (isGlobal)
+    {
+        return secStoreGlobal_GetClientSessionRef();
+    }
+#endif /* end !MK_CONFIG_SECSTORE_DISABLE_GLOBAL_ACCESS */
+
+    return le_secStore_GetClientSessionRef();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the batch write in progress of the client of the current IPC message.
+ *
+ * @return
+ *      Pointer to the batch, or NULL if the client is not doing a batch write.
+ */
+//--------------------------------------------------------------------------------------------------
+static Batch_t* GetClientBatch
+(
+    bool isGlobal                   ///< [IN] Is this an operation is the global domain?
+)
+{
+    return le_hashmap_Get(BatchMap, GetClientSessionRef(isGlobal));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks if a path is a directory path or is under it.
+ *
+ * @return
+ *      true if the path is the directory or is under it.
+ *      false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsPathUnder
+(
+    const char* pathPtr,            ///< [IN] Path to check.
+    const char* dirPtr              ///< [IN] Directory path.
+)
+{
+    size_t len = strlen(dirPtr);
+
+    // Ignore the trailing separator of a directory path.
+    while ((len > 0) && (dirPtr[len - 1] == '/'))
+    {
+        len--;
+    }
+
+    return (strncmp(pathPtr, dirPtr, len) == 0) &&
+           ((pathPtr[len] == '\0') || (pathPtr[len] == '/'));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finds the last operation of a batch that sets an item: a write of the item, or a delete of the
+ * item or of one of its parents.
+ *
+ * @return
+ *      Pointer to the operation, or NULL if the batch does not change the item.
+ */
+//--------------------------------------------------------------------------------------------------
+static BatchOp_t* FindBatchOp
+(
+    Batch_t* batchPtr,              ///< [IN] Batch write.
+    const char* pathPtr             ///< [IN] Path of the item.
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_PeekTail(&batchPtr->ops);
+
+    while (linkPtr != NULL)
+    {
+        BatchOp_t* opPtr = CONTAINER_OF(linkPtr, BatchOp_t, link);
+
+        bool isMatch = opPtr->isDelete ? IsPathUnder(pathPtr, opPtr->path) :
+                                         (strcmp(pathPtr, opPtr->path) == 0);
+
+        if (isMatch)
+        {
+            return opPtr;
+        }
+
+        linkPtr = le_dls_PeekPrev(&batchPtr->ops, linkPtr);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks if a path exists once the operations buffered by a batch write are applied.
+ *
+ * @return
+ *      LE_OK if the path exists.
+ *      LE_NOT_FOUND if the path does not exist.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CheckBatchPath
+(
+    Batch_t* batchPtr,              ///< [IN] Batch write.
+    const char* pathPtr             ///< [IN] Path.
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_PeekTail(&batchPtr->ops);
+    size_t size;
+
+    while (linkPtr != NULL)
+    {
+        BatchOp_t* opPtr = CONTAINER_OF(linkPtr, BatchOp_t, link);
+
+        if (!opPtr->isDelete && IsPathUnder(opPtr->path, pathPtr))
+        {
+            return LE_OK;
+        }
+        if (opPtr->isDelete && IsPathUnder(pathPtr, opPtr->path))
+        {
+            return LE_NOT_FOUND;
+        }
+
+        linkPtr = le_dls_PeekPrev(&batchPtr->ops, linkPtr);
+    }
+
+    return pa_secStore_GetSize(pathPtr, &size);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Removes an operation from a batch write.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveBatchOp
+(
+    Batch_t* batchPtr,              ///< [IN] Batch write.
+    BatchOp_t* opPtr                ///< [IN] Operation to remove.
+)
+{
+    le_dls_Remove(&batchPtr->ops, &opPtr->link);
+    batchPtr->byteCount -= opPtr->size;
+    batchPtr->opCount--;
+    le_mem_Release(opPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffers a write or a delete in a batch write.  The operations of the batch that it overrides are
+ * dropped.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NO_MEMORY if the batch has too many operations or too much data.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t QueueBatchOp
+(
+    Batch_t* batchPtr,              ///< [IN] Batch write.
+    const char* pathPtr,            ///< [IN] Path of the item, or of the entries to delete.
+    const uint8_t* bufPtr,          ///< [IN] Data to write (NULL for a delete).
+    size_t bufSize,                 ///< [IN] Size of the data to write.
+    bool isDelete                   ///< [IN] true to delete the path and everything under it.
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&batchPtr->ops);
+
+    while (linkPtr != NULL)
+    {
+        BatchOp_t* opPtr = CONTAINER_OF(linkPtr, BatchOp_t, link);
+
+        linkPtr = le_dls_PeekNext(&batchPtr->ops, linkPtr);
+
+        if (isDelete ? IsPathUnder(opPtr->path, pathPtr) :
+                       (!opPtr->isDelete && (strcmp(opPtr->path, pathPtr) == 0)))
+        {
+            RemoveBatchOp(batchPtr, opPtr);
+        }
+    }
+
+    if (batchPtr->opCount >= BATCH_MAX_OPS)
+    {
+        LE_ERROR("Too many operations in the batch write.");
+        return LE_NO_MEMORY;
+    }
+
+    if (!isDelete && (batchPtr->byteCount + bufSize > BATCH_MAX_BYTES))
+    {
+        LE_ERROR("Too much data in the batch write.");
+        return LE_NO_MEMORY;
+    }
+
+    BatchOp_t* opPtr = le_mem_ForceAlloc(BatchOpPool);
+
+    opPtr->link = LE_DLS_LINK_INIT;
+    LE_ASSERT(le_utf8_Copy(opPtr->path, pathPtr, sizeof(opPtr->path), NULL) == LE_OK);
+    opPtr->isDelete = isDelete;
+    opPtr->size = 0;
+    opPtr->dataPtr = NULL;
+
+    if (isDelete)
+    {
+        batchPtr->hasDelete = true;
+    }
+    else
+    {
+        // Only the data is copied: a block is allocated even for an empty item, so that the
+        // operation always has a buffer to write from.
+        LE_ASSERT(bufSize <= LE_SECSTORE_MAX_ITEM_SIZE);
+        opPtr->dataPtr = le_mem_ForceVarAlloc(BatchDataPool, (bufSize > 0) ? bufSize : 1);
+        memcpy(opPtr->dataPtr, bufPtr, bufSize);
+        opPtr->size = bufSize;
+        batchPtr->byteCount += bufSize;
+    }
+
+    le_dls_Queue(&batchPtr->ops, &opPtr->link);
+    batchPtr->opCount++;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Destructor of batch write operations: releases the data of the operation.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BatchOpDestructor
+(
+    void* objPtr                    ///< [IN] Operation being released.
+)
+{
+    BatchOp_t* opPtr = objPtr;
+
+    if (opPtr->dataPtr != NULL)
+    {
+        le_mem_Release(opPtr->dataPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Releases a batch write and the operations it buffers.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeleteBatch
+(
+    Batch_t* batchPtr               ///< [IN] Batch write.
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    while ((linkPtr = le_dls_Pop(&batchPtr->ops)) != NULL)
+    {
+        le_mem_Release(CONTAINER_OF(linkPtr, BatchOp_t, link));
+    }
+
+    le_hashmap_Remove(BatchMap, batchPtr->sessionRef);
+    le_mem_Release(batchPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Applies an operation of a batch to the secure storage.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NO_MEMORY if there is not enough memory to store the item.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ApplyBatchOp
+(
+    const pa_secStore_BatchOp_t* opPtr  ///< [IN] Operation.
+)
+{
+    le_result_t result;
+
+    if (opPtr->isDelete)
+    {
+        result = pa_secStore_Delete(opPtr->pathPtr);
+
+        return (result == LE_NOT_FOUND) ? LE_OK : result;
+    }
+
+    return pa_secStore_Write(opPtr->pathPtr, opPtr->bufPtr, opPtr->bufSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Applies the operations of a batch to the secure storage, in order, one at a time.  Stops at the
+ * first operation that fails.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NO_MEMORY if there is not enough memory to store an item.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ApplyBatch
+(
+    const pa_secStore_BatchOp_t* opsPtr,    ///< [IN] Operations of the batch.
+    size_t opCount                          ///< [IN] Number of operations.
+)
+{
+    size_t i;
+
+    for (i = 0; i < opCount; i++)
+    {
+        le_result_t result = ApplyBatchOp(&opsPtr[i]);
+
+        if (result != LE_OK)
+        {
+            LE_ERROR("Could not store '%s' of the batch write: %s.",
+                     opsPtr[i].pathPtr, LE_RESULT_TXT(result));
+            return result;
+        }
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Builds the path of an item of an operation in the batch journal.
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetJournalPath
+(
+    size_t index,                   ///< [IN] Index of the operation.
+    const char* itemPtr,            ///< [IN] Item of the operation: "path" or "data".
+    char* bufPtr,                   ///< [OUT] Buffer to contain the path.
+    size_t bufSize                  ///< [IN] Size of the buffer.
+)
+{
+    LE_FATAL_IF(snprintf(bufPtr, bufSize, "%s/%" PRIuS "/%s", BATCH_JOURNAL_PATH, index, itemPtr)
+                >= bufSize,
+                "Batch journal path '%s...' is too long.", bufPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completes the batch write left in the journal by an interrupted commit, or discards the journal
+ * if the batch was not committed.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RecoverBatchJournal
+(
+    void
+)
+{
+    static uint8_t data[LE_SECSTORE_MAX_ITEM_SIZE];
+    char countStr[16] = "";
+    size_t len = sizeof(countStr) - 1;
+    int count;
+    int i;
+
+    le_result_t result = pa_secStore_Read(BATCH_JOURNAL_COMMIT_PATH, (uint8_t*)countStr, &len);
+
+    if (result == LE_NOT_FOUND)
+    {
+        // No batch was committed, drop what may have been journaled.
+        result = pa_secStore_Delete(BATCH_JOURNAL_PATH);
+
+        return (result == LE_NOT_FOUND) ? LE_OK : result;
+    }
+    else if (result != LE_OK)
+    {
+        return result;
+    }
+
+    countStr[len] = '\0';
+    if ((le_utf8_ParseInt(&count, countStr) != LE_OK) || (count < 0))
+    {
+        LE_ERROR("Invalid batch journal, discarding it.");
+        return pa_secStore_Delete(BATCH_JOURNAL_PATH);
+    }
+
+    LE_WARN("Completing a batch write of %d operations that was interrupted.", count);
+
+    for (i = 0; i < count; i++)
+    {
+        char path[SECSTORE_MAX_PATH_BYTES];
+        char entry[SECSTORE_MAX_PATH_BYTES + 1] = "";
+        pa_secStore_BatchOp_t op = { .bufPtr = data };
+
+        GetJournalPath(i, "path", path, sizeof(path));
+        len = sizeof(entry) - 1;
+        result = pa_secStore_Read(path, (uint8_t*)entry, &len);
+        if (result != LE_OK)
+        {
+            return result;
+        }
+        entry[len] = '\0';
+
+        op.pathPtr = entry + 1;
+        op.isDelete = (entry[0] == BATCH_OP_DELETE);
+
+        if (!op.isDelete)
+        {
+            GetJournalPath(i, "data", path, sizeof(path));
+            op.bufSize = sizeof(data);
+            result = pa_secStore_Read(path, data, &op.bufSize);
+            if (result != LE_OK)
+            {
+                return result;
+            }
+        }
+
+        result = ApplyBatchOp(&op);
+        if (result != LE_OK)
+        {
+            LE_ERROR("Could not store '%s' from the batch journal.", op.pathPtr);
+            return result;
+        }
+    }
+
+    return pa_secStore_Delete(BATCH_JOURNAL_PATH);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Makes sure that a batch write interrupted during its commit is completed before the secure
+ * storage is accessed.
+ *
+ * The journal is only replayed once: if an operation can't be stored from it, replaying it again
+ * would most likely fail the same way and block every access, so the journal is discarded and the
+ * batch is left partially stored.
+ *
+ * @return
+ *      LE_OK if successful, or if the journal was discarded.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CheckBatchJournal
+(
+    void
+)
+{
+    if (!IsBatchJournalChecked)
+    {
+        le_result_t result = RecoverBatchJournal();
+
+        if (result == LE_UNAVAILABLE)
+        {
+            return result;
+        }
+
+        if (result != LE_OK)
+        {
+            LE_CRIT("Could not complete the interrupted batch write (%s), discarding it.",
+                    LE_RESULT_TXT(result));
+            pa_secStore_Delete(BATCH_JOURNAL_PATH);
+        }
+
+        IsBatchJournalChecked = true;
+    }
+
+    return LE_OK;
+}
+
+
+#if LE_CONFIG_SECSTORE_BATCH_JOURNAL
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commits the operations of a batch through the batch journal: the operations are journaled, then
+ * applied one by one, then the journal is deleted.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NO_MEMORY if there is not enough memory to store the batch.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ *
+ * If an error is returned once the batch is journaled, the batch is partially stored: it is
+ * completed from the journal before the next access, or discarded if that fails too.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CommitBatchWithJournal
+(
+    const pa_secStore_BatchOp_t* opsPtr,    ///< [IN] Operations of the batch.
+    size_t opCount                          ///< [IN] Number of operations.
+)
+{
+    char path[SECSTORE_MAX_PATH_BYTES];
+    char countStr[16];
+    le_result_t result = LE_OK;
+    size_t i;
+
+    for (i = 0; (i < opCount) && (result == LE_OK); i++)
+    {
+        char entry[SECSTORE_MAX_PATH_BYTES + 1];
+
+        entry[0] = opsPtr[i].isDelete ? BATCH_OP_DELETE : BATCH_OP_WRITE;
+        LE_ASSERT(le_utf8_Copy(entry + 1, opsPtr[i].pathPtr, sizeof(entry) - 1, NULL) == LE_OK);
+
+        GetJournalPath(i, "path", path, sizeof(path));
+        result = pa_secStore_Write(path, (uint8_t*)entry, strlen(entry));
+
+        if ((result == LE_OK) && !opsPtr[i].isDelete)
+        {
+            GetJournalPath(i, "data", path, sizeof(path));
+            result = pa_secStore_Write(path, opsPtr[i].bufPtr, opsPtr[i].bufSize);
+        }
+    }
+
+    // Storing the number of operations commits the batch.
+    if (result == LE_OK)
+    {
+        snprintf(countStr, sizeof(countStr), "%" PRIuS, opCount);
+        result = pa_secStore_Write(BATCH_JOURNAL_COMMIT_PATH, (uint8_t*)countStr, strlen(countStr));
+    }
+
+    if (result != LE_OK)
+    {
+        LE_ERROR("Could not journal the batch write: %s.", LE_RESULT_TXT(result));
+        pa_secStore_Delete(BATCH_JOURNAL_PATH);
+        return result;
+    }
+
+    result = ApplyBatch(opsPtr, opCount);
+    if (result != LE_OK)
+    {
+        // The batch is committed: it is completed from the journal before the next access.
+        IsBatchJournalChecked = false;
+        return result;
+    }
+
+    if (pa_secStore_Delete(BATCH_JOURNAL_PATH) != LE_OK)
+    {
+        // Applying the journal again must happen before anything else is written.
+        IsBatchJournalChecked = false;
+    }
+
+    return LE_OK;
 }
+#endif /* end LE_CONFIG_SECSTORE_BATCH_JOURNAL */
+
 
 #if !MK_CONFIG_SECSTORE_DISABLE_LIMIT
 #define MAX_CLIENT_LIMIT_NUM 64
@@ -708,35 +1402,47 @@ static le_mem_PoolRef_t mapDataPool = NULL;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Checks if there is enough space in the client's area of secure storage for the client to write
- * the item.
+ * Gets the secure storage limit of a client.
  *
  * @return
- *      LE_OK if the item would fit in the client's area of secure storage.
- *      LE_NO_MEMORY if there is not enough memory to store the item.
- *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_OK if successful.
  *      LE_FAULT if there was an error.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t CheckClientLimit
+static le_result_t GetClientLimit
 (
     const char* clientNamePtr,              ///< [IN] Name of the client.
-    const char* clientPathPtr,              ///< [IN] Path to the client's area in secure storage.
-    const char* itemNamePtr,                ///< [IN] Name of the item.
-    size_t itemSize                         ///< [IN] Size, in bytes, of the item.
+    size_t* limitPtr                        ///< [OUT] Secure storage limit of the client.
 )
 {
-    // Get the secure storage limit for the client.
     appCfg_Iter_t iter = appCfg_FindApp(clientNamePtr);
     if (!iter)
     {
        LE_ERROR("iter is NULL");
        return LE_FAULT;
     }
-    size_t secStoreLimit = appCfg_GetSecStoreLimit(iter);
+    *limitPtr = appCfg_GetSecStoreLimit(iter);
     appCfg_DeleteIter(iter);
 
-    // Get the current amount of space used by the client.
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the space currently used by a client.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetClientUsedSpace
+(
+    const char* clientPathPtr,              ///< [IN] Path to the client's area in secure storage.
+    size_t* usedSpacePtr                    ///< [OUT] Space used by the client.
+)
+{
     le_result_t result;
     size_t usedSpace = 0;
 
@@ -764,6 +1470,61 @@ static le_result_t CheckClientLimit
         usedSpace = map->value;
     }
 
+    *usedSpacePtr = usedSpace;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks if there is enough space in the client's area of secure storage for the client to write
+ * the item.
+ *
+ * During a batch write, the limit is read once and the space used by the operations buffered by
+ * the batch is accounted for.  The space freed by the deletes of a batch is only taken into
+ * account once the batch is committed.
+ *
+ * @return
+ *      LE_OK if the item would fit in the client's area of secure storage.
+ *      LE_NO_MEMORY if there is not enough memory to store the item.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CheckClientLimit
+(
+    const char* clientNamePtr,              ///< [IN] Name of the client.
+    const char* clientPathPtr,              ///< [IN] Path to the client's area in secure storage.
+    const char* itemNamePtr,                ///< [IN] Name of the item.
+    size_t itemSize                         ///< [IN] Size, in bytes, of the item.
+)
+{
+    Batch_t* batchPtr = GetClientBatch(false);
+    size_t secStoreLimit;
+    size_t usedSpace;
+    le_result_t result;
+
+    // Get the secure storage limit for the client, once per batch.
+    if ((batchPtr != NULL) && batchPtr->isLimitKnown)
+    {
+        secStoreLimit = batchPtr->limit;
+    }
+    else
+    {
+        result = GetClientLimit(clientNamePtr, &secStoreLimit);
+        if (result != LE_OK)
+        {
+            return result;
+        }
+    }
+
+    // Get the current amount of space used by the client.
+    result = GetClientUsedSpace(clientPathPtr, &usedSpace);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
     // Get the size of the item in the secure storage if it already exists.
     char itemPath[SECSTORE_MAX_PATH_BYTES] = "";
 
@@ -772,16 +1533,43 @@ static le_result_t CheckClientLimit
             "Client %s's path for item %s is too long.", clientNamePtr, itemNamePtr);
 
     size_t origItemSize = 0;
-    result = pa_secStore_GetSize(itemPath, &origItemSize);
+    BatchOp_t* opPtr = (batchPtr != NULL) ? FindBatchOp(batchPtr, itemPath) : NULL;
 
-    if ( (result != LE_OK) && (result != LE_NOT_FOUND) )
+    if (opPtr != NULL)
     {
-        return result;
+        // The item is set by the batch.
+        origItemSize = opPtr->size;
+    }
+    else
+    {
+        result = pa_secStore_GetSize(itemPath, &origItemSize);
+
+        if ( (result != LE_OK) && (result != LE_NOT_FOUND) )
+        {
+            return result;
+        }
+    }
+
+    if (batchPtr != NULL)
+    {
+        usedSpace += batchPtr->sizeDelta;
     }
 
     // Calculate if replacing the item would fit within the limit.
     if (((ssize_t)(secStoreLimit - usedSpace + origItemSize - itemSize)) >= 0)
     {
+        if (batchPtr != NULL)
+        {
+            // Accounted for in the client's used space once the batch is committed.
+            batchPtr->isLimitKnown = true;
+            batchPtr->limit = secStoreLimit;
+            LE_ASSERT(le_utf8_Copy(batchPtr->clientPath, clientPathPtr,
+                                   sizeof(batchPtr->clientPath), NULL) == LE_OK);
+            batchPtr->sizeDelta += itemSize;
+            batchPtr->sizeDelta -= origItemSize;
+            return LE_OK;
+        }
+
         MapContext_t* map = (MapContext_t *)le_hashmap_Get(clientLimitMap, clientPathPtr);
         if(map)
         {
@@ -796,6 +1584,97 @@ static le_result_t CheckClientLimit
 
 #endif /* end !MK_CONFIG_SECSTORE_DISABLE_LIMIT */
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commits the operations buffered by a batch write.
+ *
+ * The platform adaptor commits the batch in a single step when it can: either all the operations
+ * are stored, or none is.  Otherwise the batch is committed through the batch journal if
+ * LE_CONFIG_SECSTORE_BATCH_JOURNAL is set, and its operations are applied one at a time if not.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NO_MEMORY if there is not enough memory to store the batch.
+ *      LE_UNAVAILABLE if the secure storage is currently unavailable.
+ *      LE_FAULT if there was some other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CommitBatch
+(
+    Batch_t* batchPtr               ///< [IN] Batch write.
+)
+{
+    pa_secStore_BatchOp_t ops[BATCH_MAX_OPS];
+    le_dls_Link_t* linkPtr;
+    size_t count = 0;
+    le_result_t result;
+
+    result = CheckBatchJournal();
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    for (linkPtr = le_dls_Peek(&batchPtr->ops);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&batchPtr->ops, linkPtr))
+    {
+        BatchOp_t* opPtr = CONTAINER_OF(linkPtr, BatchOp_t, link);
+
+        LE_ASSERT(count < NUM_ARRAY_MEMBERS(ops));
+        ops[count].pathPtr = opPtr->path;
+        ops[count].isDelete = opPtr->isDelete;
+        ops[count].bufPtr = opPtr->dataPtr;
+        ops[count].bufSize = opPtr->size;
+        count++;
+    }
+
+    if (count == 0)
+    {
+        return LE_OK;
+    }
+
+    result = pa_secStore_CommitBatch(ops, count);
+    if (result == LE_UNSUPPORTED)
+    {
+#if LE_CONFIG_SECSTORE_BATCH_JOURNAL
+        // A single operation is atomic on its own.
+        result = (count == 1) ? ApplyBatchOp(&ops[0]) : CommitBatchWithJournal(ops, count);
+#else
+        result = ApplyBatch(ops, count);
+#endif
+    }
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+#if !MK_CONFIG_SECSTORE_DISABLE_LIMIT
+    if (batchPtr->isLimitKnown)
+    {
+        MapContext_t* map = (MapContext_t *)le_hashmap_Get(clientLimitMap, batchPtr->clientPath);
+
+        if (map)
+        {
+            if (batchPtr->hasDelete)
+            {
+                // The space freed by the deletes is known once the client's area is sized again.
+                le_hashmap_Remove(clientLimitMap, map->key);
+                le_mem_Release(map);
+            }
+            else
+            {
+                map->value += batchPtr->sizeDelta;
+            }
+        }
+    }
+#endif
+
+    return LE_OK;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Check that item names are valid.
@@ -887,6 +1766,14 @@ static le_result_t PrepareOp
             return LE_FAULT;
         }
     }
+
+    // Complete a batch write interrupted during its commit before anything else is accessed.
+    result = CheckBatchJournal();
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
 #if LE_CONFIG_LINUX
     // Make sure systems are initialized.
     if (!IsCurrSysPathValid)
@@ -929,8 +1816,8 @@ static le_result_t PrepareOp
 #if MK_CONFIG_SECSTORE_DISABLE_LIMIT
         LE_UNUSED(checkLimit);
 #else /* !MK_CONFIG_SECSTORE_DISABLE_LIMIT */
-        // need to clean map at delete flow
-        if(0 == bufNumElements)
+        // need to clean map at delete flow (done when the batch is committed in a batch write)
+        if ((0 == bufNumElements) && (GetClientBatch(false) == NULL))
         {
             MapContext_t* map = (MapContext_t *)le_hashmap_Get(clientLimitMap, path);
             if(map)
@@ -980,6 +1867,7 @@ static le_result_t Write
 )
 {
     char        path[SECSTORE_MAX_PATH_BYTES] = {0};
+    Batch_t*    batchPtr = GetClientBatch(isGlobal);
     le_result_t result;
 
     LE_ASSERT(bufPtr != NULL);
@@ -990,6 +1878,12 @@ static le_result_t Write
         return result;
     }
 
+    if (batchPtr != NULL)
+    {
+        // The item is stored when the batch write ends.
+        return QueueBatchOp(batchPtr, path, bufPtr, bufNumElements, false);
+    }
+
     // Write the item to the secure storage.
     result = pa_secStore_Write(path, bufPtr, bufNumElements);
 
@@ -1072,6 +1966,8 @@ static le_result_t Read
 )
 {
     char        path[SECSTORE_MAX_PATH_BYTES] = {0};
+    Batch_t*    batchPtr = GetClientBatch(isGlobal);
+    BatchOp_t*  opPtr;
     le_result_t result;
 
     LE_ASSERT(bufPtr != NULL);
@@ -1083,8 +1979,30 @@ static le_result_t Read
         return result;
     }
 
-    // Read the item from the secure storage.
-    result = pa_secStore_Read(path, bufPtr, bufNumElementsPtr);
+    opPtr = (batchPtr != NULL) ? FindBatchOp(batchPtr, path) : NULL;
+    if (opPtr != NULL)
+    {
+        // Read the item as set by the batch write in progress.
+        if (opPtr->isDelete)
+        {
+            result = LE_NOT_FOUND;
+        }
+        else if (opPtr->size > *bufNumElementsPtr)
+        {
+            result = LE_OVERFLOW;
+        }
+        else
+        {
+            memcpy(bufPtr, opPtr->dataPtr, opPtr->size);
+            *bufNumElementsPtr = opPtr->size;
+            result = LE_OK;
+        }
+    }
+    else
+    {
+        // Read the item from the secure storage.
+        result = pa_secStore_Read(path, bufPtr, bufNumElementsPtr);
+    }
 
     // If there is an error, make sure that the buffer is empty.
     if ( (LE_OK != result) && (bufNumElementsPtr > 0) )
@@ -1164,12 +2082,24 @@ le_result_t Delete
 )
 {
     char path[SECSTORE_MAX_PATH_BYTES] = {0};
+    Batch_t* batchPtr = GetClientBatch(isGlobal);
     le_result_t result = PrepareOp(isGlobal, true, name, 0, false, path);
     if (result != LE_OK)
     {
         return result;
     }
 
+    if (batchPtr != NULL)
+    {
+        // The item is deleted when the batch write ends.
+        result = CheckBatchPath(batchPtr, path);
+        if (result != LE_OK)
+        {
+            return result;
+        }
+        return QueueBatchOp(batchPtr, path, NULL, 0, true);
+    }
+
     // Delete the item from the secure storage.
     return pa_secStore_Delete(path);
 }
@@ -1237,12 +2167,22 @@ static le_result_t GetMinimumBufferSize
 {
 
     char path[SECSTORE_MAX_PATH_BYTES] = {0};
+    Batch_t* batchPtr = GetClientBatch(isGlobal);
     le_result_t result = PrepareOp(isGlobal, true, name, 0, false, path);
     if (result != LE_OK)
     {
         return result;
     }
 
+    // An item set by the batch write in progress has the size set by the batch.  The size of a
+    // directory does not include the items written by the batch.
+    BatchOp_t* opPtr = (batchPtr != NULL) ? FindBatchOp(batchPtr, path) : NULL;
+    if (opPtr != NULL)
+    {
+        *sizePtr = (uint32_t) opPtr->size;
+        return opPtr->isDelete ? LE_NOT_FOUND : LE_OK;
+    }
+
     size_t size = 0;
 
     // TODO: replace with more efficient call
@@ -1302,13 +2242,113 @@ le_result_t secStoreGlobal_GetMinimumBufferSize
 
 #endif /* end !MK_CONFIG_SECSTORE_DISABLE_GLOBAL_ACCESS */
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts a batch write for the client, or nests a batch write in the client's batch write.
+ *
+ * @return
+ *      LE_OK if successful.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StartBatchWrite
+(
+    bool isGlobal                   ///< [IN] Is this a global secure storage operation?
+)
+{
+    Batch_t* batchPtr = GetClientBatch(isGlobal);
+
+    if (batchPtr != NULL)
+    {
+        batchPtr->depth++;
+        return LE_OK;
+    }
+
+    batchPtr = le_mem_ForceAlloc(BatchPool);
+    memset(batchPtr, 0, sizeof(*batchPtr));
+    batchPtr->sessionRef = GetClientSessionRef(isGlobal);
+    batchPtr->depth = 1;
+    batchPtr->ops = LE_DLS_LIST_INIT;
+
+    le_hashmap_Put(BatchMap, batchPtr->sessionRef, batchPtr);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Ends the client's batch write.  When the outermost batch write ends, the buffered operations are
+ * committed and the batch write is released, whether the commit succeeded or not.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if the batch could not be committed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t EndBatchWrite
+(
+    bool isGlobal                   ///< [IN] Is this a global secure storage operation?
+)
+{
+    Batch_t* batchPtr = GetClientBatch(isGlobal);
+    le_result_t result;
+
+    if (batchPtr == NULL)
+    {
+        LE_DEBUG("No batch write in progress.");
+        return LE_OK;
+    }
+
+    if (--batchPtr->depth > 0)
+    {
+        return LE_OK;
+    }
+
+    result = CommitBatch(batchPtr);
+    if (result != LE_OK)
+    {
+        LE_ERROR("Batch write of %" PRIuS " operations not stored: %s.",
+                 batchPtr->opCount, LE_RESULT_TXT(result));
+    }
+
+    DeleteBatch(batchPtr);
+
+    return (result == LE_OK) ? LE_OK : LE_FAULT;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discards the batch write a client left open when it disconnects.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CleanupClientBatch
+(
+    le_msg_SessionRef_t sessionRef,
+    void*               contextPtr
+)
+{
+    Batch_t* batchPtr = le_hashmap_Get(BatchMap, sessionRef);
+
+    if (batchPtr != NULL)
+    {
+        LE_WARN("Client disconnected during a batch write, discarding %" PRIuS " operations.",
+                batchPtr->opCount);
+        DeleteBatch(batchPtr);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Start the "batch write" that aggregates multiple write/delete operation into a single batch
  * with the purpose of improving the performance.
  *
  * The performance is optimized by postponing the data serialization (triggered by write/delete
- * API calls by this particular client) until the function EndBatchWrite is called.
+ * API calls by this particular client) until the function EndBatchWrite is called.  The batch is
+ * stored as a whole: either all its operations are stored, or none is.  Reads by the client see
+ * the batch's writes and deletes.  Batch writes can be nested; the batch is stored when the
+ * outermost batch write ends.
  *
  * @return
  *      LE_OK if successful.
@@ -1320,7 +2360,7 @@ le_result_t le_secStore_StartBatchWrite
     void
 )
 {
-    return LE_OK;
+    return StartBatchWrite(false);
 }
 
 #if !MK_CONFIG_SECSTORE_DISABLE_GLOBAL_ACCESS
@@ -1331,7 +2371,8 @@ le_result_t le_secStore_StartBatchWrite
  * with the purpose of improving the performance.
  *
  * The performance is optimized by postponing the data serialization (triggered by write/delete
- * API calls by this particular client) until the function EndBatchWrite is called.
+ * API calls by this particular client) until the function EndBatchWrite is called.  The batch is
+ * stored as a whole: either all its operations are stored, or none is.
  *
  * @return
  *      LE_OK if successful.
@@ -1343,7 +2384,7 @@ le_result_t secStoreGlobal_StartBatchWrite
     void
 )
 {
-    return LE_OK;
+    return StartBatchWrite(true);
 }
 
 #endif /* end !MK_CONFIG_SECSTORE_DISABLE_GLOBAL_ACCESS */
@@ -1352,9 +2393,8 @@ le_result_t secStoreGlobal_StartBatchWrite
 /**
  * Ends the "batch write" operation and serializes the data to the persistent storage.
  *
- * @note  - Failure to finish the (previously started) batch write may result in data loss.
- *        - This is not a transactional mechanism, i.e. the possibility to roll back the changes
- *          is not provided.
+ * @note  - The batch is stored as a whole, or not at all if LE_FAULT is returned.
+ *        - A batch write that is not ended before the client disconnects is discarded.
  *
  * @return
  *      LE_OK if successful.
@@ -1366,7 +2406,7 @@ le_result_t le_secStore_EndBatchWrite
     void
 )
 {
-    return LE_OK;
+    return EndBatchWrite(false);
 }
 
 #if !MK_CONFIG_SECSTORE_DISABLE_GLOBAL_ACCESS
@@ -1375,9 +2415,8 @@ le_result_t le_secStore_EndBatchWrite
 /**
  * Ends the "batch write" operation and serializes the data to the persistent storage.
  *
- * @note  - Failure to finish the (previously started) batch write may result in data loss.
- *        - This is not a transactional mechanism, i.e. the possibility to roll back the changes
- *          is not provided.
+ * @note  - The batch is stored as a whole, or not at all if LE_FAULT is returned.
+ *        - A batch write that is not ended before the client disconnects is discarded.
  *
  * @return
  *      LE_OK if successful.
@@ -1389,7 +2428,7 @@ le_result_t secStoreGlobal_EndBatchWrite
     void
 )
 {
-    return LE_OK;
+    return EndBatchWrite(true);
 }
 
 #endif /* end !MK_CONFIG_SECSTORE_DISABLE_GLOBAL_ACCESS */
@@ -2141,6 +3180,21 @@ COMPONENT_INIT
                                   NULL);
 #endif /* end !MK_CONFIG_SECSTORE_DISABLE_ADMIN */
 
+    BatchPool = le_mem_CreatePool("BatchPool", sizeof(Batch_t));
+    BatchOpPool = le_mem_CreatePool("BatchOpPool", sizeof(BatchOp_t));
+    le_mem_SetDestructor(BatchOpPool, BatchOpDestructor);
+    BatchDataPool = le_mem_CreatePool("BatchDataPool", LE_SECSTORE_MAX_ITEM_SIZE);
+    BatchDataPool = le_mem_CreateReducedPool(BatchDataPool, "BatchSmallDataPool",
+                                             0, BATCH_DATA_TYPICAL_BYTES);
+    BatchMap = le_hashmap_Create("BatchMap", BATCH_MAP_SIZE,
+                                 le_hashmap_HashVoidPointer, le_hashmap_EqualsVoidPointer);
+
+    // Register handlers that discard the batch writes left open when clients disconnect.
+    le_msg_AddServiceCloseHandler(le_secStore_GetServiceRef(), CleanupClientBatch, NULL);
+#if !MK_CONFIG_SECSTORE_DISABLE_GLOBAL_ACCESS
+    le_msg_AddServiceCloseHandler(secStoreGlobal_GetServiceRef(), CleanupClientBatch, NULL);
+#endif
+
 #if !MK_CONFIG_SECSTORE_DISABLE_LIMIT
     mapDataPool = le_mem_CreatePool("MapDataPool", sizeof(MapContext_t));
 
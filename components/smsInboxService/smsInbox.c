@@ -2,18 +2,19 @@
 /**
  *  SMS Inbox Server
  *
- * When the service is activated, or when a SMS is received, the SMS is copied from the SIM to a
- * specific folder (SMSINBOX_PATH/MSG_PATH).
+ * When the service is activated, or when a SMS is received, the SMS is copied from the SIM to the
+ * message store (SMSINBOX_PATH/STORE_FILE).
  *
- * Each SMS is copied into a dedicated file (named with a unique message identifier). The data
- * are stored using the Jannsson representation: Each data (imsi, SMS format, message length,
- * text/pdu, sender telephone number, timestamp, read/unread) are recorded with a key to retrieve
- * each value.
+ * The message store keeps all the messages (imsi, SMS format, message length, text/pdu, sender
+ * telephone number, timestamp) in a single append-only file, along with the message boxes each
+ * message belongs to and its read/unread state in each of them. An in-memory index of the
+ * messages and of the content of each message box is built when the store is loaded, so that
+ * receiving, browsing or updating a message only appends a record to the file, see smsStore.h.
  *
- * Each application using the SMS Inbox Server possesses a configuration file in
- * SMSINBOX_PATH/CONF_PATH directory (also encoding using Jansson format): this file is used to
- * store the message identifier contained in the application mailbox. It is updated each time is new
- * SMS is received.
+ * Previous versions stored each SMS in a dedicated Jansson file (SMSINBOX_PATH/MSG_PATH), and
+ * the message identifiers of each application message box in another Jansson file
+ * (SMSINBOX_PATH/CONF_PATH). These files are imported to the message store, then removed, the first
+ * time the store is loaded.
  *
  *  Copyright (C) Sierra Wireless Inc.
  */
@@ -23,6 +24,7 @@
 #include "interfaces.h"
 #include "mdmCfgEntries.h"
 #include "le_smsInbox.h"
+#include "smsStore.h"
 
 #include "le_print.h"
 #include "le_hex.h"
@@ -49,14 +51,21 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * File extension definition.
+ * Message store file name.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STORE_FILE "msgStore.bin"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Legacy file extension definition.
  */
 //--------------------------------------------------------------------------------------------------
 #define FILE_EXTENSION ".json"
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Json keys.
+ * Legacy Json keys.
  */
 //--------------------------------------------------------------------------------------------------
 #define JSON_FORMAT "format"
@@ -78,6 +87,10 @@
 //--------------------------------------------------------------------------------------------------
 #define MAX_APPS 16
 
+#if MAX_APPS > SMS_STORE_MAX_MBOX
+#error "The message store does not support that many message boxes"
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Default size of message box.
@@ -131,49 +144,6 @@
 //--------------------------------------------------------------------------------------------------
 typedef uint32_t MessageId_t;
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Browsing structure.
- *
- */
-//--------------------------------------------------------------------------------------------------
-typedef struct
-{
-    json_t* jsonObjPtr;
-    json_t* jsonArrayPtr;
-    uint32_t currentMessageIndex;
-    uint32_t maxIndex;
-}
-BrowseCtx_t;
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Entry description structure.
- *
- */
-//--------------------------------------------------------------------------------------------------
-typedef struct
-{
-    enum
-    {
-        DESC_INT,
-        DESC_STRING,
-        DESC_BOOL
-    }                               type;       ///< Union type (string or integer
-    union
-    {
-        struct
-        {
-            char*   strPtr;                     ///< String
-            size_t  lenStr;                     ///< Length of the string
-        }                  str;                 ///< Value for string
-        uint32_t           val;                 ///< Value for integer
-        bool               boolVal;             ///< Boolean value
-    }                               uVal;       ///< Union type
-}
-EntryDesc_t;
-
-
 //--------------------------------------------------------------------------------------------------
 /**
  * message box object structure.
@@ -197,8 +167,8 @@ MboxCtx_t;
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    MboxCtx_t *    mboxCtxPtr; ///< message box object
-    BrowseCtx_t    browseCtx;     ///< browsing context (for GetFirst/GetNext)
+    MboxCtx_t *         mboxCtxPtr; ///< message box object
+    smsStore_Cursor_t   cursor;     ///< browsing cursor (for GetFirst/GetNext)
 }
 MboxSession_t;
 
@@ -313,11 +283,11 @@ static char SimImsi[LE_SIM_IMSI_BYTES];
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Next message Identifier
+ * Whether the message store is loaded.
  *
  */
 //--------------------------------------------------------------------------------------------------
-static MessageId_t NextMessageId = 1;
+static bool IsStoreLoaded = false;
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -334,128 +304,6 @@ static le_mem_PoolRef_t SmsInboxHandlerPoolRef;
 //--------------------------------------------------------------------------------------------------
 static le_ref_MapRef_t ActivationRequestRefMap;
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Add a boolean value of a key in a Jason object
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t AddBooleanKeyInJsonObject
-(
-    json_t *jsonObjPtr, ///<[IN] json object
-    const char* key,    ///<[IN] Key to be added
-    bool value          ///<[IN] Value to be added
-)
-{
-    json_t *jsonBoolPtr;
-    int ret = -1;
-
-    if ( value == true )
-    {
-        jsonBoolPtr = json_true();
-    }
-    else
-    {
-        jsonBoolPtr = json_false();
-    }
-
-    if (jsonBoolPtr)
-    {
-        ret = json_object_set_new(jsonObjPtr, key, jsonBoolPtr);
-    }
-    else
-    {
-        LE_ERROR("Error during set of the key %s", key);
-    }
-
-    if (ret == 0)
-    {
-        return LE_OK;
-    }
-    else
-    {
-        return LE_FAULT;
-    }
-}
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Add an integer value of a key in a Jason object
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t AddIntegerKeyInJsonObject
-(
-    json_t *jsonObjPtr, ///<[IN] json object
-    const char* key,    ///<[IN] Key to be added
-    int  value          ///<[IN] Value to be added
-)
-{
-    json_t *jsonIntPtr = json_integer(value);
-    int ret = -1;
-
-    if (jsonIntPtr)
-    {
-        if (json_is_array(jsonObjPtr))
-        {
-            ret = json_array_append_new(jsonObjPtr, jsonIntPtr);
-        }
-        else
-        {
-            ret = json_object_set_new(jsonObjPtr, key, jsonIntPtr);
-        }
-    }
-    else
-    {
-        LE_ERROR("Error during set of the key %s", key);
-    }
-
-    if (ret == 0)
-    {
-        return LE_OK;
-    }
-    else
-    {
-        return LE_FAULT;
-    }
-}
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Add a string value of a key in a Jason object
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t AddStringKeyInJsonObject
-(
-    json_t *jsonObjPtr, ///<[IN] json object
-    const char* key,    ///<[IN] Key to be added
-    char* string        ///<[IN] String to be added
-)
-{
-    json_t * jsonStrPtr = json_string(string);
-    int ret = -1;
-
-    if (jsonStrPtr)
-    {
-        ret = json_object_set_new(jsonObjPtr, key, jsonStrPtr);
-    }
-    else
-    {
-        LE_ERROR("Error during set of the key %s", key);
-    }
-
-    if (ret == 0)
-    {
-        return LE_OK;
-    }
-    else
-    {
-        return LE_FAULT;
-    }
-}
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the SMSInbox directory path length
@@ -520,925 +368,585 @@ static void GetSMSInboxConfigPath
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Modify Json object
+ * Get the index of a message box in the message store
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ModifyJsonObj
+static uint8_t GetMboxIndex
 (
-    json_t* jsonObjPtr,         ///<[IN] Json object (root object)
-    json_t* jsonValPtr,         ///<[IN] Json value to be modified
-    char*   key,                ///<[IN] Key to modify
-    EntryDesc_t * modifPtr      ///<[IN] Requested modification
+    MboxCtx_t* mboxCtxPtr       ///<[IN] Message box
 )
 {
-    int res = 0;
-
-    if (jsonValPtr == NULL)
-    {
-        LE_ERROR("NULL jsonValPtr");
-        return LE_FAULT;
-    }
-
-    switch (modifPtr->type)
-    {
-        case DESC_STRING:
-            // check the type
-            if (json_is_string(jsonValPtr) == false)
-            {
-                LE_ERROR("Bad key format");
-                res = -1;
-            }
-
-            if ( res == 0 )
-            {
-                res = json_string_set(jsonValPtr, modifPtr->uVal.str.strPtr);
-            }
-        break;
-        case DESC_INT:
-            // check the type
-            if (json_is_integer(jsonValPtr) == false )
-            {
-                LE_ERROR("Bad key format");
-                res = -1;
-            }
-
-            if ( res == 0 )
-            {
-                res = json_integer_set(jsonValPtr, modifPtr->uVal.val);
-            }
-        break;
-        case DESC_BOOL:
-            // check the type
-            if ( (json_is_true(jsonValPtr) != true) && (json_is_false(jsonValPtr) != true) )
-            {
-                LE_ERROR("Bad key format");
-                res = -1;
-            }
-
-            if (( res == 0 ) &&
-                (AddBooleanKeyInJsonObject(jsonObjPtr, key, modifPtr->uVal.boolVal) != LE_OK))
-            {
-                res = -1;
-            }
-        break;
-        default:
-            res = -1;
-        break;
-    }
-
-    if (res < 0)
-    {
-        LE_ERROR(("Update error %d"), modifPtr->type);
-        return LE_FAULT;
-    }
-    else
-    {
-        LE_DEBUG("ModifyJsonObj OK");
-        return LE_OK;
-    }
-
+    return (uint8_t)(mboxCtxPtr - Apps);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Modify message file
+ * Read a legacy application's config file
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ModifyMsgEntry
+static le_result_t GetMsgListFromMbox
 (
-    MessageId_t messageId,      ///<[IN] Message identifier to be modified
-    char* keyPtr[],              ///<[IN] Key to modify
-    uint8_t nbKey,              ///<[IN] Number of elements in keyPtr
-    EntryDesc_t * modifPtr      ///<[IN] Requested modification
+    char* pathPtr,              ///<[IN] Application's config file path
+    json_t **jsonRootObjPtr,    ///<[OUT] json root object
+    json_t **jsonArrayPtr       ///<[OUT] messages in box list
 )
 {
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
     json_error_t error;
-    le_result_t res;
-    int indexKey = -1;
-
-    GetSMSInboxMessagePath(messageId, path, pathLen);
-
-    LE_DEBUG("ModifyMsgEntry: messageId %d, path %s",messageId, path);
-
-    json_t* jsonRootPtr = json_load_file(path, 0, &error);
+    *jsonRootObjPtr = json_load_file(pathPtr, 0, &error);
 
-    if ( jsonRootPtr == NULL )
+    if ( !(*jsonRootObjPtr) )
     {
         LE_ERROR("Json decoder error %s", error.text);
         return LE_FAULT;
     }
 
-    json_t* jsonValPtr = jsonRootPtr;
-    json_t* jsonSubObjPtr = jsonRootPtr;
+    *jsonArrayPtr = json_object_get(*jsonRootObjPtr, JSON_MSGINBOX);
 
-    while ( ( json_is_object(jsonValPtr) == true ) && ( nbKey > indexKey ) )
+    if ( !json_is_array(*jsonArrayPtr) )
     {
-        indexKey++;
-        jsonSubObjPtr = jsonValPtr;
-        jsonValPtr = json_object_get(jsonSubObjPtr, keyPtr[indexKey]);
+        LE_ERROR("No message list in %s", pathPtr);
+        json_decref(*jsonRootObjPtr);
+        return LE_FAULT;
     }
 
-    if ( !jsonValPtr )
-    {
-        if ((indexKey > -1) && (indexKey < nbKey))
-        {
-            LE_ERROR("Unable to get the object %s", keyPtr[indexKey]);
-        }
-        else
-        {
-            LE_ERROR("IndexKey: %d is out of range", indexKey);
-        }
+    return LE_OK;
+}
 
-        res = LE_FAULT;
-    }
-    else
-    {
-        if ((indexKey > -1) && (indexKey < nbKey))
-        {
-            res = ModifyJsonObj(jsonSubObjPtr, jsonValPtr, keyPtr[indexKey], modifPtr);
-        }
-        else
-        {
-            LE_ERROR("IndexKey: %d is out of range", indexKey);
-            res = LE_FAULT;
-        }
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a message is in the first entries of a legacy message list
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsInLegacyMsgList
+(
+    json_t* jsonArrayPtr,       ///<[IN] Message list
+    MessageId_t messageId,      ///<[IN] Message identifier
+    size_t count                ///<[IN] Number of entries to check
+)
+{
+    size_t i;
 
-    if ( res == LE_OK )
+    for (i = 0; (i < count) && (i < json_array_size(jsonArrayPtr)); i++)
     {
-        if (json_dump_file(jsonRootPtr, path, JSON_INDENT(1) | JSON_PRESERVE_ORDER) < 0)
+        if (json_integer_value(json_array_get(jsonArrayPtr, i)) == messageId)
         {
-            LE_ERROR("Json error");
-            res = LE_FAULT;
+            return true;
         }
     }
-    else
-    {
-        LE_ERROR("Something was wrong in ModifyJsonObj");
-    }
-
-    json_decref(jsonRootPtr);
 
-    return res;
+    return false;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read Json object
+ * Read a per application flag of a legacy message file
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ReadJsonObj
+static bool GetLegacyMsgFlag
 (
-    json_t* jsonValPtr,         ///<[IN] Json value to be read
-    char* keyPtr[],             ///<[IN] Key to read
-    uint8_t nbKey,              ///<[IN] Number of elements in keyPtr
-    EntryDesc_t * decodePtr     ///<[OUT] Decoding result
+    json_t* jsonRootPtr,        ///<[IN] Message file root object
+    const char* key,            ///<[IN] Flag key
+    const char* appNamePtr,     ///<[IN] Application name
+    bool defaultValue           ///<[IN] Value if the flag is not set
 )
 {
-    le_result_t res = LE_OK;
+    json_t* jsonValPtr = json_object_get(json_object_get(jsonRootPtr, key), appNamePtr);
 
-    if ( jsonValPtr == NULL )
+    if (json_is_boolean(jsonValPtr))
     {
-        LE_ERROR("No information");
-        return LE_FAULT;
+        return json_is_true(jsonValPtr);
     }
 
-    switch json_typeof(jsonValPtr)
-    {
-        case JSON_STRING:
-        {
-            if ( decodePtr->type != DESC_STRING )
-            {
-                LE_ERROR("Bad format %d", decodePtr->type);
-                res = LE_FAULT;
-            }
-
-            if (res == LE_OK)
-            {
-                const char* strPtr = json_string_value((const json_t *)jsonValPtr);
+    return defaultValue;
+}
 
-                if ( strlen(strPtr) >= decodePtr->uVal.str.lenStr )
-                {
-                    LE_ERROR("String too long");
-                    res = LE_OVERFLOW;
-                }
-                else
-                {
-                    strncpy(decodePtr->uVal.str.strPtr, strPtr, decodePtr->uVal.str.lenStr);
-                    decodePtr->uVal.str.lenStr = strlen(strPtr);
-                }
-            }
-        }
-        break;
-        case JSON_INTEGER:
-        {
-            if ( decodePtr->type != DESC_INT )
-            {
-                LE_ERROR("Bad format %d", decodePtr->type);
-                res = LE_FAULT;
-            }
-            else
-            {
-                decodePtr->uVal.val = json_integer_value((const json_t *)jsonValPtr);
-            }
-        }
-        break;
-        case JSON_TRUE:
-        case JSON_FALSE:
-        {
-            if ( decodePtr->type != DESC_BOOL )
-            {
-                LE_ERROR("Bad format %d", decodePtr->type);
-                res = LE_FAULT;
-            }
-            else
-            {
-                decodePtr->uVal.boolVal = json_is_true((const json_t *)jsonValPtr);
-            }
-        }
-        break;
-        case JSON_OBJECT:
-        {
-            // if key-value is an object, read the next key
-            if (nbKey >= 1)
-            {
-                json_t* jsonSubValPtr = json_object_get(jsonValPtr, keyPtr[0]);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a string of a legacy message file. The string is left empty if it is not set.
+ *
+ */
+//--------------------------------------------------------------------------------------------------
+static void GetLegacyMsgString
+(
+    json_t* jsonRootPtr,        ///<[IN] Message file root object
+    const char* key,            ///<[IN] String key
+    char* strPtr,               ///<[OUT] String
+    size_t strSize              ///<[IN] String buffer size
+)
+{
+    const char* valuePtr = json_string_value(json_object_get(jsonRootPtr, key));
 
-                if ( jsonSubValPtr )
-                {
-                    res = ReadJsonObj(jsonSubValPtr, &keyPtr[1], nbKey-1,  decodePtr );
-                }
-                else
-                {
-                    LE_ERROR("Bad format");
-                    res = LE_FAULT;
-                }
-            }
-            else
-            {
-                LE_ERROR("Key error");
-                res = LE_FAULT;
-            }
-        }
-        break;
-        case JSON_ARRAY:
-        case JSON_REAL:
-        case JSON_NULL:
-        default:
-            LE_ERROR("Bad json_typeof");
-            res = LE_FAULT;
-        break;
+    if ( valuePtr && (le_utf8_Copy(strPtr, valuePtr, strSize, NULL) != LE_OK) )
+    {
+        LE_WARN("Truncated %s: %s", key, valuePtr);
     }
-
-    return res;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Read Application's config file
+ * Decode a legacy message file
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t GetMsgListFromMbox
+static void DecodeLegacyMsg
 (
-    char* pathPtr,              ///<[IN] Application's config file path
-    json_t **jsonRootObjPtr,    ///<[OUT] json root object
-    json_t **jsonArrayPtr       ///<[OUT] messages in box list
+    json_t* jsonRootPtr,        ///<[IN] Message file root object
+    smsStore_Msg_t* msgPtr      ///<[OUT] Message content
 )
 {
-    json_error_t error;
-    *jsonRootObjPtr = json_load_file(pathPtr, 0, &error);
+    json_t* jsonFormatPtr = json_object_get(jsonRootPtr, JSON_FORMAT);
+    const char* payloadPtr = NULL;
 
-    if ( !(*jsonRootObjPtr) )
-    {
-        // File doesn't exist, create objects
-        *jsonRootObjPtr = json_object();
+    memset(msgPtr, 0, sizeof(*msgPtr));
 
-        if ( !(*jsonRootObjPtr) )
-        {
-            LE_ERROR("Json error");
-            return LE_FAULT;
-        }
-    }
+    msgPtr->format = json_is_integer(jsonFormatPtr) ? json_integer_value(jsonFormatPtr) :
+                                                      LE_SMS_FORMAT_UNKNOWN;
+    msgPtr->msgLen = json_integer_value(json_object_get(jsonRootPtr, JSON_MSGLEN));
 
-    *jsonArrayPtr = json_object_get(*jsonRootObjPtr, JSON_MSGINBOX);
+    GetLegacyMsgString(jsonRootPtr, JSON_IMSI, msgPtr->imsi, sizeof(msgPtr->imsi));
+    GetLegacyMsgString(jsonRootPtr, JSON_SENDERTEL, msgPtr->senderTel, sizeof(msgPtr->senderTel));
+    GetLegacyMsgString(jsonRootPtr, JSON_TIMESTAMP, msgPtr->timestamp, sizeof(msgPtr->timestamp));
 
-    if ( !(*jsonArrayPtr) )
+    switch (msgPtr->format)
     {
-        // Array doesn't exist, create it
-        *jsonArrayPtr = json_array();
+        case LE_SMS_FORMAT_TEXT:
+            payloadPtr = json_string_value(json_object_get(jsonRootPtr, JSON_TEXT));
+        break;
+        case LE_SMS_FORMAT_BINARY:
+            payloadPtr = json_string_value(json_object_get(jsonRootPtr, JSON_BIN));
+        break;
+        case LE_SMS_FORMAT_PDU:
+            payloadPtr = json_string_value(json_object_get(jsonRootPtr, JSON_PDU));
+        break;
+        default:
+        break;
+    }
+
+    if (payloadPtr)
+    {
+        // The payload was stored as an hexadecimal string
+        int32_t len = le_hex_StringToBinary(payloadPtr, strlen(payloadPtr),
+                                            msgPtr->data, sizeof(msgPtr->data));
 
-        if (!(*jsonArrayPtr))
+        if (len < 0)
         {
-            json_decref(*jsonRootObjPtr);
-            LE_ERROR("Json error");
-            return LE_FAULT;
+            LE_ERROR("Invalid payload");
+            len = 0;
         }
 
-        if ( json_object_set(*jsonRootObjPtr, JSON_MSGINBOX, *jsonArrayPtr) < 0 )
+        msgPtr->dataLen = len;
+
+        // The text was stored with its terminating NUL character
+        if (LE_SMS_FORMAT_TEXT == msgPtr->format)
         {
-            json_decref(*jsonRootObjPtr);
-            LE_ERROR("Json error");
-            return LE_FAULT;
+            msgPtr->dataLen = strnlen((char*) msgPtr->data, msgPtr->dataLen);
         }
     }
-
-    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Remove a message from the application's cfg file
+ * Remove the files of the legacy storage, including the orphan message files
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t DeleteMsgInAppCfg
+static void RemoveLegacyFiles
 (
-    char *appNamePtr,               ///<[IN] application name
-    MessageId_t deleteMessageId     ///<[IN] message to delete
+    void
 )
 {
-    uint32_t pathLen = GetSMSInboxConfigPathLen(appNamePtr);
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    GetSMSInboxConfigPath(appNamePtr, path, pathLen);
-    json_t *jsonObjPtr;
-    json_t *jsonArrayPtr;
+    const char* dirs[] = {SMSINBOX_PATH MSG_PATH, SMSINBOX_PATH CONF_PATH};
+    size_t i;
 
-    LE_DEBUG("DeleteMessageId %d, path %s",deleteMessageId, path);
-
-    if (GetMsgListFromMbox(path, &jsonObjPtr, &jsonArrayPtr) != LE_OK)
+    for (i = 0; i < NUM_ARRAY_MEMBERS(dirs); i++)
     {
-       LE_ERROR("No message");
-       return LE_FAULT;
-    }
-
-    int i;
-    MessageId_t messageId;
+        DIR* dirPtr = opendir(dirs[i]);
+        struct dirent* entryPtr;
+        char path[PATH_MAX];
 
-    for (i=0; i < json_array_size(jsonArrayPtr); i++)
-    {
-        json_t * jsonIntegerPtr = json_array_get(jsonArrayPtr, i);
+        if (NULL == dirPtr)
+        {
+            continue;
+        }
 
-        if (jsonIntegerPtr)
+        while (NULL != (entryPtr = readdir(dirPtr)))
         {
-            messageId = json_integer_value(jsonIntegerPtr);
+            const char* extPtr = strrchr(entryPtr->d_name, '.');
 
-            if (messageId == deleteMessageId)
+            if (extPtr && (0 == strcmp(extPtr, FILE_EXTENSION)))
             {
-                LE_DEBUG("Remove %d", (int) messageId);
-                json_array_remove(jsonArrayPtr, i);
+                snprintf(path, sizeof(path), "%s%s", dirs[i], entryPtr->d_name);
+                unlink(path);
             }
         }
-        else
-        {
-            LE_ERROR("Json error");
-        }
-    }
 
-    le_result_t res = LE_OK;
-    if ( json_dump_file(jsonObjPtr, path, JSON_INDENT(1) | JSON_PRESERVE_ORDER) < 0 )
-    {
-        res = LE_FAULT;
-        LE_ERROR("Json_dump_file error");
+        closedir(dirPtr);
+        rmdir(dirs[i]);
     }
-
-    json_decref(jsonObjPtr);
-
-    return res;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Check if a message belongs to a message box
+ * Import the messages of the legacy storage, where each message was a Json file and each
+ * application's message box a Json file listing its messages.
+ *
+ * The legacy files are only removed once all their messages are in the message store. Otherwise
+ * they are kept, and the messages not imported yet are imported on next start.
  *
  */
 //--------------------------------------------------------------------------------------------------
-
-static le_result_t CheckMessageIdInMbox
+static void MigrateLegacyStorage
 (
-    char* mboxName,
-    MessageId_t messageId
+    void
 )
 {
-    json_t *jsonRootObjPtr;
-    json_t *jsonArrayPtr;
-    uint32_t pathLen = GetSMSInboxConfigPathLen(mboxName);
-    char path[pathLen];
-    GetSMSInboxConfigPath(mboxName, path, pathLen);
+    json_t* jsonRootObjPtr[MAX_APPS] = {NULL};
+    json_t* jsonArrayPtr[MAX_APPS] = {NULL};
+    bool isLegacy = false;
+    bool isFailed = false;
+    int i;
 
-    if ( GetMsgListFromMbox(path, &jsonRootObjPtr, &jsonArrayPtr) != LE_OK )
+    for (i = 0; i < MAX_APPS; i++)
     {
-        LE_ERROR("Error in GetMsgListFromMbox");
-        return LE_FAULT;
+        if ( Apps[i].namePtr && (strlen(Apps[i].namePtr) != 0) )
+        {
+            uint32_t pathLen = GetSMSInboxConfigPathLen(Apps[i].namePtr);
+            char path[pathLen];
+            GetSMSInboxConfigPath(Apps[i].namePtr, path, pathLen);
+
+            if ( (0 == access(path, F_OK)) &&
+                 (GetMsgListFromMbox(path, &jsonRootObjPtr[i], &jsonArrayPtr[i]) == LE_OK) )
+            {
+                isLegacy = true;
+            }
+        }
     }
 
-    int i = 0;
+    if (isLegacy)
+    {
+        LE_INFO("Migrating the message boxes to %s", SMSINBOX_PATH STORE_FILE);
+    }
 
-    while (i < json_array_size(jsonArrayPtr))
+    for (i = 0; i < MAX_APPS; i++)
     {
-        json_t * jsonIntegerPtr = json_array_get(jsonArrayPtr, i);
-        MessageId_t msgId = 0;
+        size_t index;
 
-        if (jsonIntegerPtr)
-        {
-            msgId = json_integer_value(jsonIntegerPtr);
-        }
-        else
+        for (index = 0; jsonArrayPtr[i] && (index < json_array_size(jsonArrayPtr[i])); index++)
         {
-            LE_ERROR("Json error");
-            json_decref(jsonRootObjPtr);
-            return LE_FAULT;
-        }
+            MessageId_t messageId = json_integer_value(json_array_get(jsonArrayPtr[i], index));
+            uint16_t mboxMask = 0;
+            uint16_t unreadMask = 0;
+            json_error_t error;
+            smsStore_Msg_t msg;
+            int j;
+
+            // Skip the messages already imported from a previous message box or entry
+            bool isImported = IsInLegacyMsgList(jsonArrayPtr[i], messageId, index);
+            for (j = 0; j < i; j++)
+            {
+                isImported |= (jsonArrayPtr[j] &&
+                               IsInLegacyMsgList(jsonArrayPtr[j], messageId, SIZE_MAX));
+            }
 
-        LE_DEBUG("MessageId %d, msgId %d, i %d", messageId, msgId, i);
-        if (msgId == messageId)
-        {
-            json_decref(jsonRootObjPtr);
-            return LE_OK;
-        }
+            // Also skip the messages imported by a previous, partial migration
+            for (j = 0; j < MAX_APPS; j++)
+            {
+                isImported |= smsStore_IsInMbox(messageId, j);
+            }
 
-        i++;
-    }
+            if ( (0 == messageId) || isImported )
+            {
+                continue;
+            }
 
-    LE_ERROR("Bad msg id or mbox name");
-    json_decref(jsonRootObjPtr);
-    return LE_FAULT;
-}
+            uint16_t pathLen = GetSMSInboxMessagePathLen();
+            char path[pathLen];
+            GetSMSInboxMessagePath(messageId, path, pathLen);
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Decode message file
- *
- */
-//--------------------------------------------------------------------------------------------------
-static le_result_t DecodeMsgEntry
-(
-    char* mboxName,                      ///<[IN] mbox name
-    MessageId_t messageId,               ///<[IN] Message identifier to decode
-    char* keyPtr[],                      ///<[IN] Key to retrieve
-    uint8_t nbKey,                       ///<[IN] Number of elements in keyPtr
-    EntryDesc_t * decodePtr              ///<[IN/OUT] Decoding result
-)
-{
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    json_error_t error;
-    le_result_t res = LE_OK;
+            json_t* jsonMsgPtr = json_load_file(path, 0, &error);
+            if (NULL == jsonMsgPtr)
+            {
+                LE_WARN("Unable to import message %08x: %s", (int) messageId, error.text);
 
-    GetSMSInboxMessagePath(messageId, path, pathLen);
+                // A message listed but without its file has nothing left to import
+                isFailed |= (0 == access(path, F_OK));
+                continue;
+            }
 
-    json_t* jsonRootPtr = json_load_file(path, JSON_REJECT_DUPLICATES, &error);
+            for (j = 0; j < MAX_APPS; j++)
+            {
+                if ( jsonArrayPtr[j] &&
+                     IsInLegacyMsgList(jsonArrayPtr[j], messageId, SIZE_MAX) &&
+                     !GetLegacyMsgFlag(jsonMsgPtr, JSON_ISDELETED, Apps[j].namePtr, false) )
+                {
+                    mboxMask |= 1 << j;
 
-    if ( jsonRootPtr == NULL )
-    {
-        LE_ERROR("Json decoder error %s mboxName %s", error.text, mboxName);
-        DeleteMsgInAppCfg(mboxName, messageId);
-        return LE_FAULT;
+                    if (GetLegacyMsgFlag(jsonMsgPtr, JSON_ISUNREAD, Apps[j].namePtr, true))
+                    {
+                        unreadMask |= 1 << j;
+                    }
+                }
+            }
+
+            DecodeLegacyMsg(jsonMsgPtr, &msg);
+            json_decref(jsonMsgPtr);
+
+            if ( mboxMask && (smsStore_Import(messageId, &msg, mboxMask, unreadMask) != LE_OK) )
+            {
+                LE_ERROR("Unable to import message %08x", (int) messageId);
+                isFailed = true;
+            }
+        }
     }
 
-    res = ReadJsonObj(jsonRootPtr, keyPtr, nbKey, decodePtr);
+    for (i = 0; i < MAX_APPS; i++)
+    {
+        if (jsonRootObjPtr[i])
+        {
+            json_decref(jsonRootObjPtr[i]);
+        }
+    }
 
-    json_decref(jsonRootPtr);
+    if (isFailed)
+    {
+        LE_ERROR("Migration incomplete, legacy message boxes kept until next start");
+        return;
+    }
 
-    return res;
+    RemoveLegacyFiles();
 }
 
-
 //--------------------------------------------------------------------------------------------------
 /**
- * Check if an application requested the deletion of a message
+ * Load the message store, on first use
  *
  */
 //--------------------------------------------------------------------------------------------------
-static bool IsDeleted
+static le_result_t LoadStore
 (
-    MessageId_t messageId,  ///<[IN] Message identifier
-    char* appNamePtr        ///<[IN] Application name
+    void
 )
 {
-    EntryDesc_t decode;
-    decode.type = DESC_BOOL;
-    char* key[2] = {JSON_ISDELETED, appNamePtr};
-
-    if (DecodeMsgEntry(appNamePtr, messageId, key, 2, &decode) == LE_OK)
+    if (IsStoreLoaded)
     {
-        LE_DEBUG("Decode.uVal.boolVal %d", decode.uVal.boolVal);
-        return decode.uVal.boolVal;
+        return LE_OK;
     }
-    else
+
+    if (smsStore_Init(SMSINBOX_PATH STORE_FILE, le_smsInbox_mboxName, le_smsInbox_NbMbx) != LE_OK)
     {
-        // if error, delete the message
-        return true;
+        LE_ERROR("Unable to load the message store");
+        return LE_FAULT;
     }
+
+    MigrateLegacyStorage();
+
+    IsStoreLoaded = true;
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Perform the deleteion
+ * Check if a message belongs to a message box
  *
  */
 //--------------------------------------------------------------------------------------------------
-static void PerformDeletion
+static le_result_t CheckMessageIdInMbox
 (
-    MessageId_t messageId   ///<[IN] Message identifier
+    MboxCtx_t* mboxCtxPtr,
+    MessageId_t messageId
 )
 {
-    int i;
-    bool deleted = true;
-
-    for (i=0; i < MAX_APPS; i++)
+    if (smsStore_IsInMbox(messageId, GetMboxIndex(mboxCtxPtr)))
     {
-        if ( Apps[i].namePtr && (strlen(Apps[i].namePtr) != 0) )
-        {
-            deleted &= IsDeleted(messageId, Apps[i].namePtr);
-        }
+        return LE_OK;
     }
 
-    // All applications mark this message to be delteted => erase physically the message
-    if (deleted)
-    {
-        uint16_t pathLen = GetSMSInboxMessagePathLen();
-        char path[pathLen];
-        memset(path, 0, pathLen);
-
-        GetSMSInboxMessagePath(messageId, path, pathLen);
-
-        LE_DEBUG("Delete messageId %d, path %s",messageId, path);
-        unlink(path);
-    }
+    LE_ERROR("Bad msg id or mbox name");
+    return LE_FAULT;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Add a message in the application's cfg file
+ * Read a message from the message store
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t AddMsgInAppCfg
+static le_result_t ReadMsg
 (
-    MboxCtx_t* appsPtr,         ///<[IN] application config
-    MessageId_t messageId     ///<[IN] message to add
+    MessageId_t messageId,      ///<[IN] Message identifier
+    smsStore_Msg_t* msgPtr      ///<[OUT] Message content
 )
 {
-    uint32_t pathLen = GetSMSInboxConfigPathLen(appsPtr->namePtr);
-    char path[pathLen];
-    GetSMSInboxConfigPath(appsPtr->namePtr, path, pathLen);
-    json_t* jsonMsgIdPtr = NULL;
-    json_t* jsonPtr;
-    json_t* jsonArrayPtr;
-
-    if ( GetMsgListFromMbox (path, &jsonPtr, &jsonArrayPtr) != LE_OK )
+    if (smsStore_Get(messageId, msgPtr) != LE_OK)
     {
-        LE_ERROR("Message %s not found", path);
+        LE_ERROR("Unable to read message %08x", (int) messageId);
         return LE_FAULT;
     }
-    LE_DEBUG("Add messageId %d, path %s, array Size %"PRIuS, messageId,
-                                                          path,
-                                                          json_array_size(jsonArrayPtr) );
-
-    if ( json_array_size(jsonArrayPtr) == appsPtr->inboxSize )
-    {
-        // delete older entry
-        jsonMsgIdPtr = json_array_get(jsonArrayPtr, 0);
-        MessageId_t messageId = 0;
-
-        if (jsonMsgIdPtr)
-        {
-            messageId = json_integer_value(jsonMsgIdPtr);
-        }
-
-        if (messageId != 0)
-        {
-            json_array_remove(jsonArrayPtr, 0);
-
-            EntryDesc_t modif;
-            modif.type = DESC_BOOL;
-            modif.uVal.boolVal = true;
-            char* key[2]={JSON_ISDELETED, appsPtr->namePtr};
-
-            if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
-            {
-                LE_ERROR("Can't modify entry %08x, path %s", (int) messageId, path);
-            }
-
-            PerformDeletion(messageId);
-        }
-        else
-        {
-            json_decref(jsonPtr);
-            LE_ERROR("Json error");
-            return LE_FAULT;
-        }
-    }
-
-    if (AddIntegerKeyInJsonObject(jsonArrayPtr, NULL, messageId) != LE_OK)
-    {
-        json_decref(jsonPtr);
-        LE_ERROR("Json error");
-        return LE_FAULT;
-    }
-
-    if ( json_dump_file(jsonPtr, path, JSON_INDENT(1) | JSON_PRESERVE_ORDER) < 0 )
-    {
-        json_decref(jsonPtr);
-        LE_ERROR("Json error");
-        return LE_FAULT;
-    }
-
-    json_decref(jsonPtr);
-
-    // Use for the first initialization
-    if (jsonArrayPtr->refcount > 0)
-    {
-        json_decref(jsonArrayPtr);
-    }
 
     return LE_OK;
 }
 
-
-
 //--------------------------------------------------------------------------------------------------
 /**
- * Encode Json file
+ * Get the content of a received SMS
  *
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t EncodeMsgEntry
+static void GetSmsContent
 (
-    uint32_t fd,            ///<[IN] file descriptor
-    le_sms_MsgRef_t msgRef  ///<[IN] SMS to be encoding
+    le_sms_MsgRef_t msgRef,     ///<[IN] SMS to be stored
+    smsStore_Msg_t* msgPtr      ///<[OUT] Message content
 )
 {
-    json_t *jsonRootPtr = json_object();
-
-    if (!jsonRootPtr)
-    {
-        LE_ERROR("Json error");
-        return LE_FAULT;
-    }
-
-    // Add imsi in json file
-    AddStringKeyInJsonObject(jsonRootPtr, JSON_IMSI, SimImsi);
-
-    // Add sms format in json file
-    le_sms_Format_t format = le_sms_GetFormat(msgRef);
-    AddIntegerKeyInJsonObject(jsonRootPtr, JSON_FORMAT, (int) format);
-
-    // Unread by default for all applications
-    json_t *jsonUnreadPtr = json_object();
-    int i;
-    for (i=0; i < MAX_APPS; i++)
-    {
-        if ( Apps[i].namePtr && (strlen(Apps[i].namePtr) != 0) )
-        {
-            AddBooleanKeyInJsonObject(jsonUnreadPtr, Apps[i].namePtr, true);
-        }
-    }
-
-    json_object_set_new(jsonRootPtr, JSON_ISUNREAD, jsonUnreadPtr);
-
-    // Undeleted by default for all applications
-    json_t *jsonDeletePtr = json_object();
-    for (i=0; i < MAX_APPS; i++)
-    {
-        if ( Apps[i].namePtr && (strlen(Apps[i].namePtr) != 0) )
-        {
-            AddBooleanKeyInJsonObject(jsonDeletePtr, Apps[i].namePtr, false);
-        }
-    }
+    le_result_t result;
+
+    memset(msgPtr, 0, sizeof(*msgPtr));
 
-    json_object_set_new(jsonRootPtr, JSON_ISDELETED, jsonDeletePtr);
+    le_utf8_Copy(msgPtr->imsi, SimImsi, sizeof(msgPtr->imsi), NULL);
 
-    switch ( format )
+    msgPtr->format = le_sms_GetFormat(msgRef);
+
+    switch (msgPtr->format)
     {
         case LE_SMS_FORMAT_TEXT:
         case LE_SMS_FORMAT_BINARY:
         {
-            char tel[LE_MDMDEFS_PHONE_NUM_MAX_BYTES];
-            memset(tel, 0, LE_MDMDEFS_PHONE_NUM_MAX_BYTES);
-
             // Add phone number
-            le_result_t result = le_sms_GetSenderTel(msgRef, tel, LE_MDMDEFS_PHONE_NUM_MAX_BYTES);
+            result = le_sms_GetSenderTel(msgRef, msgPtr->senderTel, sizeof(msgPtr->senderTel));
 
             if (result != LE_OK)
             {
                 LE_ERROR("Unable to get the tel number %d", result);
+                msgPtr->senderTel[0] = '\0';
             }
             else
             {
-                LE_DEBUG("Tel num: %s", tel);
-                AddStringKeyInJsonObject(jsonRootPtr, JSON_SENDERTEL, tel);
+                LE_DEBUG("Tel num: %s", msgPtr->senderTel);
             }
 
             // Add timestamp
-            char timeStamp[LE_SMS_TIMESTAMP_MAX_BYTES];
-            result = le_sms_GetTimeStamp (msgRef, timeStamp, LE_SMS_TIMESTAMP_MAX_BYTES);
+            result = le_sms_GetTimeStamp(msgRef, msgPtr->timestamp, sizeof(msgPtr->timestamp));
 
             if (result != LE_OK)
             {
                 LE_ERROR("Unable to get the timestamp %d", result);
+                msgPtr->timestamp[0] = '\0';
             }
             else
             {
-                LE_DEBUG("Timestamp: %s", timeStamp);
-                AddStringKeyInJsonObject(jsonRootPtr, JSON_TIMESTAMP, timeStamp);
+                LE_DEBUG("Timestamp: %s", msgPtr->timestamp);
             }
 
-            size_t len = le_sms_GetUserdataLen(msgRef);
-            AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, len);
+            msgPtr->msgLen = le_sms_GetUserdataLen(msgRef);
 
-            // Add a character for last '\0'
-            len++;
-
-            uint8_t bin[len];
-            memset(bin, 0, len);
-            int32_t strLen = 2*len + 1;
-            char string[strLen];
-            memset(string, 0, strLen);
-            const char* jsonKey;
-
-            if (format == LE_SMS_FORMAT_TEXT)
+            if (msgPtr->format == LE_SMS_FORMAT_TEXT)
             {
                 // Get text
-                result = le_sms_GetText(msgRef, (char*) bin, len);
-                jsonKey = JSON_TEXT;
+                result = le_sms_GetText(msgRef, (char*) msgPtr->data, sizeof(msgPtr->data));
+                msgPtr->dataLen = strnlen((char*) msgPtr->data, sizeof(msgPtr->data));
             }
             else
             {
                 // Get binary
-                result = le_sms_GetBinary(msgRef, bin, &len);
-                jsonKey = JSON_BIN;
+                msgPtr->dataLen = sizeof(msgPtr->data);
+                result = le_sms_GetBinary(msgRef, msgPtr->data, &msgPtr->dataLen);
             }
 
             if (result != LE_OK)
             {
                 LE_ERROR("Unable to get payload %d", result);
-                AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, 0);
-            }
-            else
-            {
-                // Convert payload in string: json supports only utf-8 characters.
-                // Some extended-ASCII characters can be sent by SMS (such as character with accent)
-                // and can't be convert directly in utf-8. A convertion in string solves this issue.
-                strLen = le_hex_BinaryToString(bin, len, string, strLen);
-                AddStringKeyInJsonObject(jsonRootPtr, jsonKey, string);
-
+                msgPtr->msgLen = 0;
+                msgPtr->dataLen = 0;
             }
         }
         break;
 
         case LE_SMS_FORMAT_PDU:
         {
-            size_t len = le_sms_GetPDULen(msgRef);
-            AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, len);
-            // Add a character for last '\0'
-            len++;
-            uint8_t pdu[len];
-            memset(pdu, 0, len);
-            int32_t strLen = 2*len + 1;
-            char string[strLen];
-            memset(string, 0, strLen);
+            msgPtr->msgLen = le_sms_GetPDULen(msgRef);
 
             // Add pdu
-            le_result_t result = le_sms_GetPDU(msgRef, pdu, &len);
+            msgPtr->dataLen = sizeof(msgPtr->data);
+            result = le_sms_GetPDU(msgRef, msgPtr->data, &msgPtr->dataLen);
 
             if (result != LE_OK)
             {
                 LE_ERROR("Unable to get pdu %d", result);
-                AddIntegerKeyInJsonObject(jsonRootPtr, JSON_MSGLEN, 0);
+                msgPtr->msgLen = 0;
+                msgPtr->dataLen = 0;
             }
             else
             {
-                // Convert pdu in string
-                strLen = le_hex_BinaryToString(pdu, len, string, strLen);
-                AddStringKeyInJsonObject(jsonRootPtr, JSON_PDU, string);
                 LE_DEBUG("PDU format OK");
             }
         }
         break;
         case LE_SMS_FORMAT_UNKNOWN:
         default:
-            LE_ERROR("Bad format %d", format);
-    }
-
-    // Write json file in the file system
-    char* jsondumpStr = json_dumps( (const json_t *) jsonRootPtr,
-                                    JSON_INDENT(1) | JSON_PRESERVE_ORDER);
-    if (!jsondumpStr)
-    {
-        LE_ERROR("JsondumpStr is NULL");
-        return LE_FAULT;
-    }
-
-    char* restJsondumpStr = jsondumpStr;
-    ssize_t writeSize = strlen(jsondumpStr);
-    ssize_t writtenSize;
-
-    do
-    {
-        writtenSize = write( fd, restJsondumpStr, writeSize );
-        if (writtenSize > 0)
-        {
-            writeSize -= writtenSize;
-            restJsondumpStr += writtenSize;
-        }
+            LE_ERROR("Bad format %d", msgPtr->format);
     }
-    while ((writeSize > 0) && ((writtenSize >= 0) || (EINTR == errno)));
-
-    free(jsondumpStr);
-    json_decref(jsonRootPtr);
-
-    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Create a new message entry
+ * Store a received SMS in all the message boxes
  *
+ * The oldest messages of a full message box are removed from it.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t CreateMsgEntry
+static le_result_t StoreMsg
 (
-    MessageId_t *msgPtr,    ///<[OUT] create messageId
-    int32_t *fdPtr         ///<[OUT] Created file descriptor
+    le_sms_MsgRef_t msgRef,     ///<[IN] SMS to be stored
+    MessageId_t *msgPtr         ///<[OUT] Message identifier
 )
 {
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
-
-    GetSMSInboxMessagePath(NextMessageId, path, pathLen);
-    LE_DEBUG("Create entry: NextMessageId %d, path %s",NextMessageId, path);
-
-    *fdPtr = open( path, O_CREAT | O_RDWR | O_SYNC, S_IRUSR | S_IWUSR );
+    smsStore_Msg_t msg;
+    uint16_t mboxMask = 0;
+    int i;
 
-    if (*fdPtr < 0)
+    if (LoadStore() != LE_OK)
     {
-        LE_ERROR("No such file: %s: %m", path);
         return LE_FAULT;
     }
 
-    LE_DEBUG("New entry: %s", path);
-
-    int i;
+    GetSmsContent(msgRef, &msg);
 
     // For all the applications
     for (i = 0; i < MAX_APPS; i++)
     {
-        if ( Apps[i].namePtr && strlen(Apps[i].namePtr) )
+        if ( Apps[i].namePtr && strlen(Apps[i].namePtr) && (Apps[i].inboxSize > 0) )
         {
-            AddMsgInAppCfg(&Apps[i], NextMessageId);
-        }
-    }
-
-    *msgPtr = NextMessageId;
-
-    NextMessageId++;
-
-    return LE_OK;
-}
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Convert the file name string in hexa
- *
- * @return
- *      - Positive integer corresponding to the hexadecimal input string
- *      - -1 in case of error
- */
-//--------------------------------------------------------------------------------------------------
-static MessageId_t GetMessageId
-(
-    char* fileNamePtr  ///<[IN] file name to be converted
-)
-{
-    char *savePtr;
+            while (smsStore_GetCount(i) >= Apps[i].inboxSize)
+            {
+                // delete older entry
+                MessageId_t messageId = smsStore_GetOldest(i);
 
-    if(NULL != fileNamePtr)
-    {
-        char *str = strtok_r(fileNamePtr,".", &savePtr);
+                LE_DEBUG("Remove %08x from %s", (int) messageId, Apps[i].namePtr);
+                if (smsStore_RemoveFromMbox(messageId, i) != LE_OK)
+                {
+                    LE_ERROR("Can't remove entry %08x", (int) messageId);
+                    break;
+                }
+            }
 
-        if (NULL == str)
-        {
-            LE_ERROR("Unable to find . in the file name");
-            return -1;
+            mboxMask |= 1 << i;
         }
-        return le_hex_HexaToInteger(str);
     }
-    else
+
+    if (smsStore_Add(&msg, mboxMask, msgPtr) != LE_OK)
     {
-        LE_ERROR("Provided file name pointer is NULL");
-        return -1;
+        LE_ERROR("Unable to store the message");
+        return LE_FAULT;
     }
+
+    LE_DEBUG("New entry: %08x", (int) *msgPtr);
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1475,63 +983,10 @@ static void InitSmsInBoxDirectory
     void
 )
 {
-    struct dirent **namelist;
-    uint32_t nbSmsEntries;
-
     LE_DEBUG("InitSmsInBoxDirectory");
 
     // create directories
-    if (LE_OK != MkdirCreate(SMSINBOX_PATH))
-    {
-        return;
-    }
-
-    uint16_t pathLen = GetSMSInboxMessagePathLen();
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    snprintf(path, pathLen, "%s%s", SMSINBOX_PATH, CONF_PATH);
-
-    if (LE_OK != MkdirCreate(path))
-    {
-        return;
-    }
-
-    memset(path, 0, pathLen);
-    snprintf(path, pathLen, "%s%s", SMSINBOX_PATH, MSG_PATH);
-
-    if (LE_OK != MkdirCreate(path))
-    {
-        return;
-    }
-
-    nbSmsEntries = scandir(path, &namelist, NULL, alphasort);
-    if ( nbSmsEntries > 2 )
-    {
-        uint8_t len = strlen(namelist[nbSmsEntries-1]->d_name);
-        char name[len+1];
-        MessageId_t id;
-
-        memset(name, 0, len+1);
-        strncpy(name, namelist[nbSmsEntries-1]->d_name, len);
-
-        id = GetMessageId(name);
-        if (-1 == id)
-        {
-            LE_ERROR("Unable to get the id of %s", name);
-            return;
-        }
-
-        NextMessageId = ++id;
-
-        LE_DEBUG("NextMessageId %d", (int) NextMessageId);
-    }
-
-    while (nbSmsEntries--)
-    {
-        free(namelist[nbSmsEntries]);
-    }
-
-    free(namelist);
+    MkdirCreate(SMSINBOX_PATH);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -1545,7 +1000,6 @@ static void MoveSmsFromSimToFolder
     void
 )
 {
-    int32_t fd;
     le_result_t result = LE_OK;
 
     le_sms_MsgListRef_t msgListRef = le_sms_CreateRxMsgList();
@@ -1562,18 +1016,7 @@ static void MoveSmsFromSimToFolder
     {
         MessageId_t msgId;
 
-        result = CreateMsgEntry(&msgId, &fd);
-
-        if (result == LE_OK)
-        {
-            if ( EncodeMsgEntry(fd, smsRef) != LE_OK )
-            {
-                LE_ERROR("Encoding issue");
-            }
-
-            close(fd);
-        }
-        else
+        if (StoreMsg(smsRef, &msgId) != LE_OK)
         {
             LE_ERROR("Error during new entry creation");
         }
@@ -1602,23 +1045,12 @@ static void NewSmsMsgHandler
     void*           contextPtr
 )
 {
-    int32_t fd;
     le_result_t result;
     MessageId_t msgId;
 
     LE_DEBUG("Receive new message");
 
-    result = CreateMsgEntry(&msgId, &fd);
-
-    if (result == LE_OK)
-    {
-        result = EncodeMsgEntry(fd, msgRef);
-        close(fd);
-    }
-    else
-    {
-        LE_ERROR("CreateMsgEntry error");
-    }
+    result = StoreMsg(msgRef, &msgId);
 
     if (result == LE_OK)
     {
@@ -1630,7 +1062,7 @@ static void NewSmsMsgHandler
     }
     else
     {
-        LE_ERROR("EncodeMsgEntry error");
+        LE_ERROR("StoreMsg error");
     }
 }
 
@@ -1868,6 +1300,11 @@ SmsInbox_SessionRef_t SmsInbox_Open
         return NULL;
     }
 
+    if (LoadStore() != LE_OK)
+    {
+        return NULL;
+    }
+
     int i;
 
     for (i=0; i < MAX_APPS; i++)
@@ -1878,7 +1315,7 @@ SmsInbox_SessionRef_t SmsInbox_Open
             clientRequestPtr->mboxSessionPtr = (MboxSession_t*) le_mem_ForceAlloc(MboxSessionPool);
 
             clientRequestPtr->mboxSessionPtr->mboxCtxPtr = &Apps[i];
-            memset(&clientRequestPtr->mboxSessionPtr->browseCtx, 0, sizeof(BrowseCtx_t));
+            memset(&clientRequestPtr->mboxSessionPtr->cursor, 0, sizeof(smsStore_Cursor_t));
 
             SmsInbox_SessionRef_t reqRef = le_ref_CreateRef(ActivationRequestRefMap,
                                                             clientRequestPtr);
@@ -1921,6 +1358,7 @@ void SmsInbox_Close
         return;
     }
 
+    smsStore_CloseCursor(&clientRequestPtr->mboxSessionPtr->cursor);
     le_mem_Release(clientRequestPtr->mboxSessionPtr);
     le_mem_Release(clientRequestPtr);
 
@@ -2040,30 +1478,17 @@ void SmsInbox_DeleteMsg
         return;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t modif;
-    modif.type = DESC_BOOL;
-    modif.uVal.boolVal = true;
-    char* key[2]={JSON_ISDELETED, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
-
-    if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
-    {
-        LE_ERROR("ModifyMsgEntry error");
-    }
-
-    if (DeleteMsgInAppCfg(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId)
-                          != LE_OK)
+    if (smsStore_RemoveFromMbox((MessageId_t) msgId,
+                                GetMboxIndex(clientRequestPtr->mboxSessionPtr->mboxCtxPtr)) != LE_OK)
     {
-        LE_ERROR("DeleteMsgInAppCfg error");
+        LE_ERROR("Unable to delete message %08x", (int) msgId);
     }
-
-    PerformDeletion(messageId);
 }
 
 
@@ -2111,14 +1536,13 @@ le_result_t SmsInbox_GetImsi
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    le_result_t res;
+    smsStore_Msg_t msg;
 
     memset(imsiPtr, 0, imsiNumElements);
 
@@ -2127,19 +1551,20 @@ le_result_t SmsInbox_GetImsi
         return LE_OVERFLOW;
     }
 
-    EntryDesc_t decode;
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = imsiPtr;
-    decode.uVal.str.lenStr = imsiNumElements;
-    char* key[1] = {JSON_IMSI};
+    if (ReadMsg((MessageId_t) msgId, &msg) != LE_OK)
+    {
+        return LE_FAULT;
+    }
 
-    if ((res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr,
-                              messageId, key, 1, &decode)) == LE_OK)
+    if (le_utf8_Copy(imsiPtr, msg.imsi, imsiNumElements, NULL) != LE_OK)
     {
-        SmsInbox_MarkRead(sessionRef, msgId);
+        LE_ERROR("String too long");
+        return LE_OVERFLOW;
     }
 
-    return res;
+    SmsInbox_MarkRead(sessionRef, msgId);
+
+    return LE_OK;
 }
 
 
@@ -2178,27 +1603,22 @@ le_sms_Format_t SmsInbox_GetFormat
         return 0;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return 0;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
-    decode.type = DESC_INT;
-    char* key[1] = {JSON_FORMAT};
+    smsStore_Msg_t msg;
 
-    if (DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 1,
-                      &decode) == LE_OK)
-    {
-        SmsInbox_MarkRead(sessionRef, msgId);
-        return decode.uVal.val;
-    }
-    else
+    if (ReadMsg((MessageId_t) msgId, &msg) != LE_OK)
     {
         return LE_SMSINBOX_FORMAT_UNKNOWN;
     }
+
+    SmsInbox_MarkRead(sessionRef, msgId);
+
+    return msg.format;
 }
 
 
@@ -2243,28 +1663,37 @@ le_result_t SmsInbox_GetSenderTel
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    le_result_t res;
-    EntryDesc_t decode;
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = telPtr;
-    decode.uVal.str.lenStr = telNumElements;
+    smsStore_Msg_t msg;
+
     memset(telPtr, 0, telNumElements);
-    char* key[1] = {JSON_SENDERTEL};
 
-    if ((res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key,
-                              1, &decode)) == LE_OK)
+    if (ReadMsg((MessageId_t) msgId, &msg) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    if (LE_SMS_FORMAT_PDU == msg.format)
+    {
+        LE_ERROR("No sender tel in a PDU message");
+        return LE_FAULT;
+    }
+
+    if (le_utf8_Copy(telPtr, msg.senderTel, telNumElements, NULL) != LE_OK)
     {
-        SmsInbox_MarkRead(sessionRef, msgId);
+        LE_ERROR("String too long");
+        memset(telPtr, 0, telNumElements);
+        return LE_OVERFLOW;
     }
 
-    return res;
+    SmsInbox_MarkRead(sessionRef, msgId);
+
+    return LE_OK;
 }
 
 
@@ -2313,28 +1742,37 @@ le_result_t SmsInbox_GetTimeStamp
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = timestampPtr;
-    decode.uVal.str.lenStr = timestampNumElements;
+    smsStore_Msg_t msg;
+
     memset(timestampPtr, 0, timestampNumElements);
-    char* key[1] = {JSON_TIMESTAMP};
-    le_result_t res;
 
-    if ( (res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId,
-                               key, 1, &decode)) == LE_OK )
+    if (ReadMsg((MessageId_t) msgId, &msg) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    if (LE_SMS_FORMAT_PDU == msg.format)
+    {
+        LE_ERROR("No timestamp in a PDU message");
+        return LE_FAULT;
+    }
+
+    if (le_utf8_Copy(timestampPtr, msg.timestamp, timestampNumElements, NULL) != LE_OK)
     {
-        SmsInbox_MarkRead(sessionRef, msgId);
+        LE_ERROR("String too long");
+        memset(timestampPtr, 0, timestampNumElements);
+        return LE_OVERFLOW;
     }
 
-    return res;
+    SmsInbox_MarkRead(sessionRef, msgId);
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2370,33 +1808,22 @@ size_t SmsInbox_GetMsgLen
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-
-    EntryDesc_t decode;
-    decode.type = DESC_INT;
-    char* key[1] = {JSON_MSGLEN};
-    le_result_t res;
-
-    if ( (res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr,
-                                messageId,
-                                key,
-                                1,
-                                &decode)) == LE_OK )
-    {
-        SmsInbox_MarkRead(sessionRef, msgId);
+    smsStore_Msg_t msg;
 
-        return decode.uVal.val;
-    }
-    else
+    if (ReadMsg((MessageId_t) msgId, &msg) != LE_OK)
     {
         return 0;
     }
+
+    SmsInbox_MarkRead(sessionRef, msgId);
+
+    return msg.msgLen;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2442,42 +1869,38 @@ le_result_t SmsInbox_GetText
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
-    le_result_t res;
-    size_t len = 2*textNumElements+1;
-    char tmpTextPtr[len];
-    memset(tmpTextPtr, 0, len);
-    memset(textPtr, 0, textNumElements);
+    smsStore_Msg_t msg;
 
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = tmpTextPtr;
-    decode.uVal.str.lenStr = len;
-    char* key[1] = {JSON_TEXT};
+    memset(textPtr, 0, textNumElements);
 
-    res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 1,
-                         &decode);
+    if (ReadMsg((MessageId_t) msgId, &msg) != LE_OK)
+    {
+        return LE_FAULT;
+    }
 
-    if ( res == LE_OK )
+    if (LE_SMS_FORMAT_TEXT != msg.format)
     {
-        if ( le_hex_StringToBinary(tmpTextPtr,
-                                   decode.uVal.str.lenStr,
-                                   (uint8_t*) textPtr,
-                                   textNumElements ) < 0 )
-        {
-            return LE_FAULT;
-        }
+        LE_ERROR("Bad format %d", msg.format);
+        return LE_FAULT;
+    }
 
-        SmsInbox_MarkRead(sessionRef, msgId);
+    if (msg.dataLen >= textNumElements)
+    {
+        LE_ERROR("String too long");
+        return LE_OVERFLOW;
     }
 
-    return res;
+    memcpy(textPtr, msg.data, msg.dataLen);
+
+    SmsInbox_MarkRead(sessionRef, msgId);
+
+    return LE_OK;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2529,46 +1952,39 @@ le_result_t SmsInbox_GetBinary
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    le_result_t res;
-    EntryDesc_t decode;
-    size_t len = 2*(*binNumElementsPtr)+1;
-    char tmpBinPtr[len];
-    memset(tmpBinPtr, 0, len);
-    memset(binPtr, 0, *binNumElementsPtr);
+    smsStore_Msg_t msg;
 
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = tmpBinPtr;
-    decode.uVal.str.lenStr = len;
-    char* key[1] = {JSON_BIN};
+    memset(binPtr, 0, *binNumElementsPtr);
 
-    res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId,
-                         key, 1, &decode);
+    if (ReadMsg((MessageId_t) msgId, &msg) != LE_OK)
+    {
+        return LE_FAULT;
+    }
 
-    if ( res == LE_OK )
+    if (LE_SMS_FORMAT_BINARY != msg.format)
     {
-        int32_t binNumElements = le_hex_StringToBinary(tmpBinPtr,
-                                                    decode.uVal.str.lenStr,
-                                                    binPtr,
-                                                    *binNumElementsPtr);
+        LE_ERROR("Bad format %d", msg.format);
+        return LE_FAULT;
+    }
 
-        if ( binNumElements < 0 )
-        {
-            return LE_FAULT;
-        }
+    if (msg.dataLen > *binNumElementsPtr)
+    {
+        LE_ERROR("Buffer too small");
+        return LE_OVERFLOW;
+    }
 
-        *binNumElementsPtr = binNumElements;
+    memcpy(binPtr, msg.data, msg.dataLen);
+    *binNumElementsPtr = msg.dataLen;
 
-        SmsInbox_MarkRead(sessionRef, msgId);
-    }
+    SmsInbox_MarkRead(sessionRef, msgId);
 
-    return res;
+    return LE_OK;
 }
 
 
@@ -2624,46 +2040,39 @@ le_result_t SmsInbox_GetPdu
         return 0;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return 0;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    le_result_t res;
-    EntryDesc_t decode;
-    size_t len = 2*(*pduNumElementsPtr)+1;
-    char tmpPduPtr[len];
-    memset(tmpPduPtr, 0, len);
-    memset(pduPtr, 0, *pduNumElementsPtr);
+    smsStore_Msg_t msg;
 
-    decode.type = DESC_STRING;
-    decode.uVal.str.strPtr = tmpPduPtr;
-    decode.uVal.str.lenStr = len;
-    char* key[1] = {JSON_PDU};
+    memset(pduPtr, 0, *pduNumElementsPtr);
 
-    res = DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 1,
-                         &decode);
+    if (ReadMsg((MessageId_t) msgId, &msg) != LE_OK)
+    {
+        return LE_FAULT;
+    }
 
-    if ( res == LE_OK )
+    if (LE_SMS_FORMAT_PDU != msg.format)
     {
-        int32_t pduNumElements = le_hex_StringToBinary(tmpPduPtr,
-                                                    decode.uVal.str.lenStr,
-                                                    pduPtr,
-                                                    *pduNumElementsPtr);
+        LE_ERROR("Bad format %d", msg.format);
+        return LE_FAULT;
+    }
 
-        if ( pduNumElements < 0 )
-        {
-            return LE_FAULT;
-        }
+    if (msg.dataLen > *pduNumElementsPtr)
+    {
+        LE_ERROR("Buffer too small");
+        return LE_OVERFLOW;
+    }
 
-        *pduNumElementsPtr = pduNumElements;
+    memcpy(pduPtr, msg.data, msg.dataLen);
+    *pduNumElementsPtr = msg.dataLen;
 
-        SmsInbox_MarkRead(sessionRef, msgId);
-    }
+    SmsInbox_MarkRead(sessionRef, msgId);
 
-    return res;
+    return LE_OK;
 }
 
 
@@ -2698,75 +2107,16 @@ uint32_t SmsInbox_GetFirst
         return 0;
     }
 
-    uint32_t pathLen = GetSMSInboxConfigPathLen(clientRequestPtr->
-                                                mboxSessionPtr->mboxCtxPtr->namePtr);
-    char path[pathLen];
-    memset(path, 0, pathLen);
-    GetSMSInboxConfigPath(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, path, pathLen);
-    le_result_t res = LE_OK;
-    MessageId_t messageId=0;
-
-    if ( GetMsgListFromMbox(path,
-                        &clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr,
-                        &clientRequestPtr->mboxSessionPtr->browseCtx.jsonArrayPtr) != LE_OK )
-    {
-        LE_ERROR("Error in GetMsgListFromMbox");
-        return 0;
-    }
-
-    clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex =
-                      json_array_size(clientRequestPtr->mboxSessionPtr->browseCtx.jsonArrayPtr);
-
-    LE_DEBUG("MaxIndex %d", clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex);
-
-    if ( clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex > 0 )
-    {
-        json_t * jsonIntegerPtr =
-                 json_array_get(clientRequestPtr->mboxSessionPtr->browseCtx.jsonArrayPtr, 0);
-
-        if (jsonIntegerPtr)
-        {
-            messageId = json_integer_value(jsonIntegerPtr);
-        }
-        else
-        {
-            LE_ERROR("Json error");
-            res = LE_FAULT;
-        }
+    MboxSession_t* mboxSessionPtr = clientRequestPtr->mboxSessionPtr;
+    MessageId_t messageId = smsStore_GetFirst(&mboxSessionPtr->cursor,
+                                              GetMboxIndex(mboxSessionPtr->mboxCtxPtr));
 
-        if (messageId)
-        {
-            clientRequestPtr->mboxSessionPtr->browseCtx.currentMessageIndex = 1;
-        }
-        else
-        {
-            LE_ERROR("Json error");
-            res = LE_FAULT;
-        }
-    }
-    else
+    if (0 == messageId)
     {
-        res = LE_FAULT;
         LE_DEBUG("Empty mbox");
     }
 
-    if (res == LE_FAULT)
-    {
-        if (clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr)
-        {
-            json_decref(clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr);
-        }
-
-        memset(&clientRequestPtr->mboxSessionPtr->browseCtx, 0, sizeof(BrowseCtx_t));
-
-        return 0;
-    }
-    else
-    {
-        return messageId;
-    }
-
-    return 0;
+    return messageId;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2794,60 +2144,20 @@ uint32_t SmsInbox_GetNext
         return LE_BAD_PARAMETER;
     }
 
-    while(clientRequestPtr->mboxSessionPtr->browseCtx.maxIndex !=
-          clientRequestPtr->mboxSessionPtr->browseCtx.currentMessageIndex)
+    if (clientRequestPtr->mboxSessionPtr == NULL)
     {
-        LE_DEBUG("CurrentIndex %d, maxIndex %d", clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.currentMessageIndex,
-                                                 clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.maxIndex);
-
-        json_t * jsonIntegerPtr = json_array_get(clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.jsonArrayPtr,
-                                                 clientRequestPtr->
-                                                 mboxSessionPtr->browseCtx.currentMessageIndex);
-
-        if (jsonIntegerPtr)
-        {
-            MessageId_t messageId = json_integer_value(jsonIntegerPtr);
-
-            if (messageId > 0)
-            {
-                clientRequestPtr->mboxSessionPtr->browseCtx.currentMessageIndex++;
-
-                // Check if the message exist (it may be deleted since the GetFirst call)
-                uint16_t pathLen = GetSMSInboxMessagePathLen();
-                char path[pathLen];
-                memset(path, 0, pathLen);
-                GetSMSInboxMessagePath(messageId, path, pathLen);
-                int32_t fd = open(path, O_RDWR);
+        LE_ERROR("Bad mbox reference");
+        return 0;
+    }
 
-                if (fd >= 0)
-                {
-                    // message is still existing
-                    close(fd);
-                    return messageId;
-                }
+    MessageId_t messageId = smsStore_GetNext(&clientRequestPtr->mboxSessionPtr->cursor);
 
-                // else continue the parsing
-            }
-            else
-            {
-                LE_ERROR("Json error");
-            }
-        }
-        else
-        {
-            LE_ERROR("Json error");
-        }
+    if (0 == messageId)
+    {
+        LE_DEBUG("No more messages");
     }
 
-    // Parsing end => free the memory
-    LE_DEBUG("No more messages");
-    json_decref(clientRequestPtr->mboxSessionPtr->browseCtx.jsonObjPtr);
-    memset(&clientRequestPtr->mboxSessionPtr->browseCtx, 0, sizeof(BrowseCtx_t));
-
-    return 0;
+    return messageId;
 }
 //--------------------------------------------------------------------------------------------------
 /**
@@ -2886,27 +2196,14 @@ bool SmsInbox_IsUnread
         return LE_BAD_PARAMETER;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return LE_BAD_PARAMETER;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t decode;
-    decode.type = DESC_BOOL;
-    char* key[] = {JSON_ISUNREAD, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
-
-    if (DecodeMsgEntry(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, messageId, key, 2,
-                       &decode) == LE_OK)
-    {
-        return decode.uVal.boolVal;
-    }
-    else
-    {
-        LE_ERROR("Error in DecodeMsgEntry");
-        return false;
-    }
+    return smsStore_IsUnread((MessageId_t) msgId,
+                             GetMboxIndex(clientRequestPtr->mboxSessionPtr->mboxCtxPtr));
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2941,21 +2238,17 @@ void SmsInbox_MarkRead
         return;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t modif;
-    modif.type = DESC_BOOL;
-    modif.uVal.boolVal = false;
-    char* key[2]={JSON_ISUNREAD, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
-
-    if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
+    if (smsStore_SetUnread((MessageId_t) msgId,
+                           GetMboxIndex(clientRequestPtr->mboxSessionPtr->mboxCtxPtr),
+                           false) != LE_OK)
     {
-        LE_ERROR("Error in ModifyMsgEntry");
+        LE_ERROR("Unable to mark message %08x as read", (int) msgId);
     }
 }
 
@@ -2991,21 +2284,17 @@ void SmsInbox_MarkUnread
         return;
     }
 
-    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr, msgId) != LE_OK)
+    if (CheckMessageIdInMbox(clientRequestPtr->mboxSessionPtr->mboxCtxPtr, msgId) != LE_OK)
     {
         LE_ERROR("Message not included into the mbox");
         return;
     }
 
-    MessageId_t messageId = (MessageId_t) msgId;
-    EntryDesc_t modif;
-    modif.type = DESC_BOOL;
-    modif.uVal.boolVal = true;
-    char* key[2]={JSON_ISUNREAD, clientRequestPtr->mboxSessionPtr->mboxCtxPtr->namePtr};
-
-    if (ModifyMsgEntry(messageId, key, 2, &modif) != LE_OK)
+    if (smsStore_SetUnread((MessageId_t) msgId,
+                           GetMboxIndex(clientRequestPtr->mboxSessionPtr->mboxCtxPtr),
+                           true) != LE_OK)
     {
-        LE_ERROR("Error in ModifyMsgEntry");
+        LE_ERROR("Unable to mark message %08x as unread", (int) msgId);
     }
 }
 
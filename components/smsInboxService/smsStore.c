@@ -0,0 +1,1901 @@
+// -------------------------------------------------------------------------------------------------
+/**
+ *  SMS Inbox Server
+ *
+ *  Append-only message store, see smsStore.h.
+ *
+ *  Copyright (C) Sierra Wireless Inc.
+ */
+// -------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+#include "smsStore.h"
+
+#include <sys/mman.h>
+
+//--------------------------------------------------------------------------------------------------
+// Symbols and enums.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic number identifying the store file, in the message identifier of the header record.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STORE_MAGIC 0x53494d53
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Version of the record format.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECORD_VERSION 1
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record types.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECORD_TYPE_HEADER  1
+#define RECORD_TYPE_MSG     2
+#define RECORD_TYPE_STATE   3
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes of a message box name, including the terminating NUL.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MBOX_NAME_MAX_BYTES 64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes of a message record.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSG_RECORD_MAX_BYTES (sizeof(RecordHeader_t) + sizeof(MsgRecord_t) +                     \
+                              LE_SIM_IMSI_BYTES + LE_MDMDEFS_PHONE_NUM_MAX_BYTES +                \
+                              LE_SMS_TIMESTAMP_MAX_BYTES + SMS_STORE_DATA_MAX_BYTES)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes of the header record.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HEADER_RECORD_MAX_BYTES (sizeof(RecordHeader_t) + sizeof(HeaderRecord_t) +               \
+                                 (SMS_STORE_MAX_MBOX * MBOX_NAME_MAX_BYTES))
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The store file is compacted when the bytes of the records no longer describing the store reach
+ * this threshold and the size of the live message records.
+ */
+//--------------------------------------------------------------------------------------------------
+#define COMPACT_MIN_BYTES (16 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer used to write the compacted store file.
+ */
+//--------------------------------------------------------------------------------------------------
+#define COMPACT_BUFFER_BYTES (16 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the message hash map.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MSG_MAP_SIZE 512
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of messages expected in the default message boxes, used to size the pools.
+ */
+//--------------------------------------------------------------------------------------------------
+#define DEFAULT_MSG_COUNT 32
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of a message box index remapping an unknown message box.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MBOX_UNKNOWN 0xFF
+
+//--------------------------------------------------------------------------------------------------
+// Data structures.
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header common to all the records of the store file.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t crc;           ///< CRC32 of the rest of the record, payload included
+    uint32_t msgId;         ///< Message identifier, or STORE_MAGIC for the header record
+    uint16_t payloadLen;    ///< Number of bytes following this header
+    uint8_t  type;          ///< Record type
+    uint8_t  version;       ///< Record format version
+}
+RecordHeader_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Payload of the header record, followed by the NUL terminated message box names.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t nextMsgId;     ///< Next message identifier when the file was written
+    uint8_t  mboxCount;     ///< Number of message box names
+    uint8_t  reserved[3];
+}
+HeaderRecord_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Payload of a message record, followed by the IMSI, the sender telephone number, the time stamp
+ * (without terminating NUL) and the message data.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t msgLen;        ///< Message length
+    uint16_t mboxMask;      ///< Message boxes containing the message
+    uint16_t unreadMask;    ///< Message boxes where the message is unread
+    uint16_t dataLen;       ///< Number of bytes of data
+    uint8_t  format;        ///< Message format
+    uint8_t  imsiLen;       ///< Number of bytes of the IMSI
+    uint8_t  senderTelLen;  ///< Number of bytes of the sender telephone number
+    uint8_t  timestampLen;  ///< Number of bytes of the time stamp
+    uint8_t  reserved[2];
+}
+MsgRecord_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Payload of a state record.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint16_t mboxMask;      ///< Message boxes containing the message, 0 if it is deleted
+    uint16_t unreadMask;    ///< Message boxes where the message is unread
+}
+StateRecord_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index entry of a message.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct MsgEntry
+{
+    uint32_t            msgId;      ///< Message identifier, hash map key
+    uint16_t            mboxMask;   ///< Message boxes containing the message
+    uint16_t            unreadMask; ///< Message boxes where the message is unread
+    off_t               offset;     ///< Offset of the message record in the store file
+    uint32_t            recordLen;  ///< Number of bytes of the message record
+    struct MboxNode*    nodesPtr;   ///< Message box nodes of the message
+    le_dls_Link_t       link;       ///< Link in the list of messages, in arrival order
+}
+MsgEntry_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Node of a message in a message box list.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct MboxNode
+{
+    MsgEntry_t*         msgPtr;     ///< Message
+    struct MboxNode*    nextPtr;    ///< Next message box node of the same message
+    uint8_t             mboxIdx;    ///< Message box
+    le_dls_Link_t       link;       ///< Link in the message box list
+}
+MboxNode_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message box index.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_List_t list;             ///< Message nodes, in arrival order
+    uint32_t      count;            ///< Number of messages
+}
+Mbox_t;
+
+//--------------------------------------------------------------------------------------------------
+//                                       Static declarations
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pools for the message entries and the message box nodes.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t MsgPool;
+static le_mem_PoolRef_t NodePool;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash map of the messages, by identifier.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t MsgMap;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * List of the messages, in arrival order.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t MsgList = LE_DLS_LIST_INIT;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message boxes.
+ */
+//--------------------------------------------------------------------------------------------------
+static Mbox_t Mboxes[SMS_STORE_MAX_MBOX];
+static const char* const* MboxNames;
+static uint8_t MboxCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message box index of each message box of the header record being replayed.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t MboxRemap[SMS_STORE_MAX_MBOX];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * List of the open browsing cursors.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t CursorList = LE_DLS_LIST_INIT;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store file.
+ */
+//--------------------------------------------------------------------------------------------------
+static char StorePath[PATH_MAX];
+static int StoreFd = -1;
+static off_t StoreSize;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes of the header record and of the live message records of the store file.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HeaderBytes;
+static size_t LiveBytes;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Next message identifier.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t NextMsgId = 1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Last read message. The identifier is 0 when nothing is cached.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t CachedMsgId;
+static smsStore_Msg_t CachedMsg;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Buffer used to write the compacted store file.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t CompactBuffer[COMPACT_BUFFER_BYTES];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the CRC of a record.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ComputeRecordCrc
+(
+    const uint8_t* recordPtr        ///<[IN] Record, header included
+)
+{
+    RecordHeader_t header;
+
+    memcpy(&header, recordPtr, sizeof(header));
+
+    return le_crc_Crc32(recordPtr + sizeof(header.crc),
+                        sizeof(header) - sizeof(header.crc) + header.payloadLen,
+                        LE_CRC_START_CRC32);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fill the header of a record, the payload being already in place, and compute its CRC.
+ *
+ * @return Number of bytes of the record.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t SealRecord
+(
+    uint8_t* recordPtr,             ///<[IN] Record
+    uint8_t  type,                  ///<[IN] Record type
+    uint32_t msgId,                 ///<[IN] Message identifier
+    size_t   payloadLen             ///<[IN] Number of bytes of payload
+)
+{
+    RecordHeader_t header;
+
+    header.crc = 0;
+    header.msgId = msgId;
+    header.payloadLen = (uint16_t)payloadLen;
+    header.type = type;
+    header.version = RECORD_VERSION;
+    memcpy(recordPtr, &header, sizeof(header));
+
+    header.crc = ComputeRecordCrc(recordPtr);
+    memcpy(recordPtr, &header, sizeof(header));
+
+    return sizeof(header) + payloadLen;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build the header record.
+ *
+ * @return Number of bytes of the record.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t BuildHeaderRecord
+(
+    uint8_t* recordPtr              ///<[OUT] Record, HEADER_RECORD_MAX_BYTES long
+)
+{
+    HeaderRecord_t headerRecord;
+    size_t payloadLen = sizeof(headerRecord);
+    int i;
+
+    memset(&headerRecord, 0, sizeof(headerRecord));
+    headerRecord.nextMsgId = NextMsgId;
+    headerRecord.mboxCount = MboxCount;
+    memcpy(recordPtr + sizeof(RecordHeader_t), &headerRecord, sizeof(headerRecord));
+
+    for (i = 0; i < MboxCount; i++)
+    {
+        size_t nameLen = strlen(MboxNames[i]) + 1;
+
+        memcpy(recordPtr + sizeof(RecordHeader_t) + payloadLen, MboxNames[i], nameLen);
+        payloadLen += nameLen;
+    }
+
+    return SealRecord(recordPtr, RECORD_TYPE_HEADER, STORE_MAGIC, payloadLen);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build a message record.
+ *
+ * @return Number of bytes of the record, 0 if the message is too big.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t BuildMsgRecord
+(
+    uint8_t*              recordPtr,    ///<[OUT] Record, MSG_RECORD_MAX_BYTES long
+    uint32_t              msgId,        ///<[IN] Message identifier
+    const smsStore_Msg_t* msgPtr,       ///<[IN] Message content
+    uint16_t              mboxMask,     ///<[IN] Message boxes containing the message
+    uint16_t              unreadMask    ///<[IN] Message boxes where the message is unread
+)
+{
+    MsgRecord_t msgRecord;
+    uint8_t* payloadPtr = recordPtr + sizeof(RecordHeader_t);
+    size_t payloadLen = sizeof(msgRecord);
+
+    if (msgPtr->dataLen > SMS_STORE_DATA_MAX_BYTES)
+    {
+        LE_ERROR("Message data too long: %"PRIuS, msgPtr->dataLen);
+        return 0;
+    }
+
+    memset(&msgRecord, 0, sizeof(msgRecord));
+    msgRecord.msgLen = msgPtr->msgLen;
+    msgRecord.mboxMask = mboxMask;
+    msgRecord.unreadMask = unreadMask;
+    msgRecord.dataLen = (uint16_t)msgPtr->dataLen;
+    msgRecord.format = (uint8_t)msgPtr->format;
+    msgRecord.imsiLen = (uint8_t)strnlen(msgPtr->imsi, sizeof(msgPtr->imsi) - 1);
+    msgRecord.senderTelLen = (uint8_t)strnlen(msgPtr->senderTel, sizeof(msgPtr->senderTel) - 1);
+    msgRecord.timestampLen = (uint8_t)strnlen(msgPtr->timestamp, sizeof(msgPtr->timestamp) - 1);
+    memcpy(payloadPtr, &msgRecord, sizeof(msgRecord));
+
+    memcpy(payloadPtr + payloadLen, msgPtr->imsi, msgRecord.imsiLen);
+    payloadLen += msgRecord.imsiLen;
+    memcpy(payloadPtr + payloadLen, msgPtr->senderTel, msgRecord.senderTelLen);
+    payloadLen += msgRecord.senderTelLen;
+    memcpy(payloadPtr + payloadLen, msgPtr->timestamp, msgRecord.timestampLen);
+    payloadLen += msgRecord.timestampLen;
+    memcpy(payloadPtr + payloadLen, msgPtr->data, msgPtr->dataLen);
+    payloadLen += msgPtr->dataLen;
+
+    return SealRecord(recordPtr, RECORD_TYPE_MSG, msgId, payloadLen);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decode a message record.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT if the record is inconsistent
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t DecodeMsgRecord
+(
+    const uint8_t*  recordPtr,      ///<[IN] Record
+    smsStore_Msg_t* msgPtr          ///<[OUT] Message content
+)
+{
+    RecordHeader_t header;
+    MsgRecord_t msgRecord;
+    const uint8_t* payloadPtr = recordPtr + sizeof(header);
+    size_t offset = sizeof(msgRecord);
+
+    memcpy(&header, recordPtr, sizeof(header));
+    memcpy(&msgRecord, payloadPtr, sizeof(msgRecord));
+
+    if ((header.type != RECORD_TYPE_MSG) ||
+        (msgRecord.imsiLen >= sizeof(msgPtr->imsi)) ||
+        (msgRecord.senderTelLen >= sizeof(msgPtr->senderTel)) ||
+        (msgRecord.timestampLen >= sizeof(msgPtr->timestamp)) ||
+        (msgRecord.dataLen > sizeof(msgPtr->data)) ||
+        (header.payloadLen != sizeof(msgRecord) + msgRecord.imsiLen + msgRecord.senderTelLen +
+                              msgRecord.timestampLen + msgRecord.dataLen))
+    {
+        LE_ERROR("Inconsistent record for message %"PRIu32, header.msgId);
+        return LE_FAULT;
+    }
+
+    memset(msgPtr, 0, sizeof(*msgPtr));
+    msgPtr->format = (le_sms_Format_t)msgRecord.format;
+    msgPtr->msgLen = msgRecord.msgLen;
+
+    memcpy(msgPtr->imsi, payloadPtr + offset, msgRecord.imsiLen);
+    offset += msgRecord.imsiLen;
+    memcpy(msgPtr->senderTel, payloadPtr + offset, msgRecord.senderTelLen);
+    offset += msgRecord.senderTelLen;
+    memcpy(msgPtr->timestamp, payloadPtr + offset, msgRecord.timestampLen);
+    offset += msgRecord.timestampLen;
+    memcpy(msgPtr->data, payloadPtr + offset, msgRecord.dataLen);
+    msgPtr->dataLen = msgRecord.dataLen;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a buffer to a file.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteAll
+(
+    int            fd,              ///<[IN] File descriptor
+    const uint8_t* bufPtr,          ///<[IN] Buffer
+    size_t         len              ///<[IN] Number of bytes to write
+)
+{
+    while (len > 0)
+    {
+        ssize_t writtenSize = write(fd, bufPtr, len);
+
+        if (writtenSize < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            LE_ERROR("Write error: %m");
+            return LE_FAULT;
+        }
+
+        bufPtr += writtenSize;
+        len -= writtenSize;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a record to the store file, and wait for it to reach the storage. The file is restored to
+ * its previous size on failure.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AppendRecord
+(
+    const uint8_t* recordPtr,       ///<[IN] Record
+    size_t         recordLen        ///<[IN] Number of bytes of the record
+)
+{
+    if ((WriteAll(StoreFd, recordPtr, recordLen) != LE_OK) || (fdatasync(StoreFd) != 0))
+    {
+        LE_ERROR("Unable to append to %s", StorePath);
+        if (ftruncate(StoreFd, StoreSize) != 0)
+        {
+            LE_ERROR("Unable to restore %s: %m", StorePath);
+        }
+        return LE_FAULT;
+    }
+
+    StoreSize += recordLen;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a state record to the store file.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AppendStateRecord
+(
+    uint32_t msgId,                 ///<[IN] Message identifier
+    uint16_t mboxMask,              ///<[IN] Message boxes containing the message
+    uint16_t unreadMask             ///<[IN] Message boxes where the message is unread
+)
+{
+    uint8_t record[sizeof(RecordHeader_t) + sizeof(StateRecord_t)];
+    StateRecord_t stateRecord;
+
+    stateRecord.mboxMask = mboxMask;
+    stateRecord.unreadMask = unreadMask;
+    memcpy(record + sizeof(RecordHeader_t), &stateRecord, sizeof(stateRecord));
+
+    return AppendRecord(record,
+                        SealRecord(record, RECORD_TYPE_STATE, msgId, sizeof(stateRecord)));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Look up a message.
+ *
+ * @return The message entry, NULL if not found.
+ */
+//--------------------------------------------------------------------------------------------------
+static MsgEntry_t* FindMsg
+(
+    uint32_t msgId                  ///<[IN] Message identifier
+)
+{
+    return le_hashmap_Get(MsgMap, &msgId);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a message to a message box list.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddNode
+(
+    MsgEntry_t* msgPtr,             ///<[IN] Message
+    uint8_t     mboxIdx             ///<[IN] Message box
+)
+{
+    MboxNode_t* nodePtr = le_mem_ForceAlloc(NodePool);
+
+    nodePtr->msgPtr = msgPtr;
+    nodePtr->mboxIdx = mboxIdx;
+    nodePtr->nextPtr = msgPtr->nodesPtr;
+    nodePtr->link = LE_DLS_LINK_INIT;
+    msgPtr->nodesPtr = nodePtr;
+
+    le_dls_Queue(&Mboxes[mboxIdx].list, &nodePtr->link);
+    Mboxes[mboxIdx].count++;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a message from a message box list. The cursors on this message move back to the previous
+ * message of the message box.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RemoveNode
+(
+    MsgEntry_t* msgPtr,             ///<[IN] Message
+    uint8_t     mboxIdx             ///<[IN] Message box
+)
+{
+    MboxNode_t** nodePtrPtr = &msgPtr->nodesPtr;
+    MboxNode_t* nodePtr;
+    le_dls_Link_t* linkPtr;
+
+    while ((*nodePtrPtr) && ((*nodePtrPtr)->mboxIdx != mboxIdx))
+    {
+        nodePtrPtr = &(*nodePtrPtr)->nextPtr;
+    }
+
+    nodePtr = *nodePtrPtr;
+    if (NULL == nodePtr)
+    {
+        return;
+    }
+    *nodePtrPtr = nodePtr->nextPtr;
+
+    linkPtr = le_dls_Peek(&CursorList);
+    while (linkPtr)
+    {
+        smsStore_Cursor_t* cursorPtr = CONTAINER_OF(linkPtr, smsStore_Cursor_t, link);
+
+        if (cursorPtr->nodeLinkPtr == &nodePtr->link)
+        {
+            cursorPtr->nodeLinkPtr = le_dls_PeekPrev(&Mboxes[mboxIdx].list, &nodePtr->link);
+        }
+        linkPtr = le_dls_PeekNext(&CursorList, linkPtr);
+    }
+
+    le_dls_Remove(&Mboxes[mboxIdx].list, &nodePtr->link);
+    Mboxes[mboxIdx].count--;
+    le_mem_Release(nodePtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the message boxes and the unread state of a message in the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void UpdateMsg
+(
+    MsgEntry_t* msgPtr,             ///<[IN] Message
+    uint16_t    mboxMask,           ///<[IN] Message boxes containing the message
+    uint16_t    unreadMask          ///<[IN] Message boxes where the message is unread
+)
+{
+    uint8_t mboxIdx;
+
+    for (mboxIdx = 0; mboxIdx < MboxCount; mboxIdx++)
+    {
+        uint16_t mboxBit = 1 << mboxIdx;
+
+        if ((msgPtr->mboxMask & mboxBit) && !(mboxMask & mboxBit))
+        {
+            RemoveNode(msgPtr, mboxIdx);
+        }
+        else if (!(msgPtr->mboxMask & mboxBit) && (mboxMask & mboxBit))
+        {
+            AddNode(msgPtr, mboxIdx);
+        }
+    }
+
+    msgPtr->mboxMask = mboxMask;
+    msgPtr->unreadMask = unreadMask & mboxMask;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a message to the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddMsg
+(
+    uint32_t msgId,                 ///<[IN] Message identifier
+    off_t    offset,                ///<[IN] Offset of the message record
+    size_t   recordLen,             ///<[IN] Number of bytes of the message record
+    uint16_t mboxMask,              ///<[IN] Message boxes containing the message
+    uint16_t unreadMask             ///<[IN] Message boxes where the message is unread
+)
+{
+    MsgEntry_t* msgPtr = le_mem_ForceAlloc(MsgPool);
+
+    msgPtr->msgId = msgId;
+    msgPtr->mboxMask = 0;
+    msgPtr->unreadMask = 0;
+    msgPtr->offset = offset;
+    msgPtr->recordLen = recordLen;
+    msgPtr->nodesPtr = NULL;
+    msgPtr->link = LE_DLS_LINK_INIT;
+
+    le_hashmap_Put(MsgMap, &msgPtr->msgId, msgPtr);
+    le_dls_Queue(&MsgList, &msgPtr->link);
+    UpdateMsg(msgPtr, mboxMask, unreadMask);
+
+    LiveBytes += recordLen;
+    if (msgId >= NextMsgId)
+    {
+        NextMsgId = msgId + 1;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a message from the index.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DropMsg
+(
+    MsgEntry_t* msgPtr              ///<[IN] Message
+)
+{
+    UpdateMsg(msgPtr, 0, 0);
+
+    le_hashmap_Remove(MsgMap, &msgPtr->msgId);
+    le_dls_Remove(&MsgList, &msgPtr->link);
+    LiveBytes -= msgPtr->recordLen;
+
+    if (CachedMsgId == msgPtr->msgId)
+    {
+        CachedMsgId = 0;
+    }
+
+    le_mem_Release(msgPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Translate a message box mask of the store file to the current message boxes.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint16_t RemapMask
+(
+    uint16_t mask                   ///<[IN] Mask read from the store file
+)
+{
+    uint16_t remappedMask = 0;
+    int i;
+
+    for (i = 0; i < SMS_STORE_MAX_MBOX; i++)
+    {
+        if ((mask & (1 << i)) && (MboxRemap[i] != MBOX_UNKNOWN))
+        {
+            remappedMask |= 1 << MboxRemap[i];
+        }
+    }
+
+    return remappedMask;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay the header record, matching its message boxes with the current ones.
+ *
+ * @return
+ *      - LE_OK on success, isIdentityPtr telling if the message boxes are unchanged
+ *      - LE_FAULT if the header record is invalid
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReplayHeaderRecord
+(
+    const uint8_t* recordPtr,       ///<[IN] Record
+    bool*          isIdentityPtr    ///<[OUT] Whether the message boxes are unchanged
+)
+{
+    RecordHeader_t header;
+    HeaderRecord_t headerRecord;
+    const char* namePtr;
+    const char* endPtr;
+    int i;
+    int j;
+
+    memcpy(&header, recordPtr, sizeof(header));
+    if ((header.type != RECORD_TYPE_HEADER) || (header.msgId != STORE_MAGIC) ||
+        (header.payloadLen < sizeof(headerRecord)))
+    {
+        return LE_FAULT;
+    }
+
+    memcpy(&headerRecord, recordPtr + sizeof(header), sizeof(headerRecord));
+    if (headerRecord.mboxCount > SMS_STORE_MAX_MBOX)
+    {
+        return LE_FAULT;
+    }
+
+    if (headerRecord.nextMsgId > NextMsgId)
+    {
+        NextMsgId = headerRecord.nextMsgId;
+    }
+
+    *isIdentityPtr = (headerRecord.mboxCount == MboxCount);
+    memset(MboxRemap, MBOX_UNKNOWN, sizeof(MboxRemap));
+
+    namePtr = (const char*)recordPtr + sizeof(header) + sizeof(headerRecord);
+    endPtr = (const char*)recordPtr + sizeof(header) + header.payloadLen;
+    for (i = 0; i < headerRecord.mboxCount; i++)
+    {
+        size_t nameLen = strnlen(namePtr, endPtr - namePtr);
+
+        if (namePtr + nameLen >= endPtr)
+        {
+            return LE_FAULT;
+        }
+
+        for (j = 0; j < MboxCount; j++)
+        {
+            if (0 == strcmp(namePtr, MboxNames[j]))
+            {
+                MboxRemap[i] = j;
+                break;
+            }
+        }
+
+        if (MBOX_UNKNOWN == MboxRemap[i])
+        {
+            LE_WARN("Message box %s no longer exists, dropping its messages", namePtr);
+            *isIdentityPtr = false;
+        }
+        else if (MboxRemap[i] != i)
+        {
+            LE_INFO("Message box %s moved from %d to %d", namePtr, i, MboxRemap[i]);
+            *isIdentityPtr = false;
+        }
+
+        namePtr += nameLen + 1;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay a message or a state record.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReplayRecord
+(
+    const uint8_t* recordPtr,       ///<[IN] Record
+    off_t          offset           ///<[IN] Offset of the record in the store file
+)
+{
+    RecordHeader_t header;
+    MsgEntry_t* msgPtr;
+
+    memcpy(&header, recordPtr, sizeof(header));
+    msgPtr = FindMsg(header.msgId);
+
+    if ((header.type == RECORD_TYPE_MSG) && (header.payloadLen >= sizeof(MsgRecord_t)))
+    {
+        MsgRecord_t msgRecord;
+        uint16_t mboxMask;
+
+        memcpy(&msgRecord, recordPtr + sizeof(header), sizeof(msgRecord));
+        mboxMask = RemapMask(msgRecord.mboxMask);
+
+        // A message record replaces any previous message with the same identifier
+        if (msgPtr)
+        {
+            DropMsg(msgPtr);
+        }
+
+        if (mboxMask)
+        {
+            AddMsg(header.msgId, offset, sizeof(header) + header.payloadLen, mboxMask,
+                   RemapMask(msgRecord.unreadMask));
+        }
+    }
+    else if ((header.type == RECORD_TYPE_STATE) && (header.payloadLen >= sizeof(StateRecord_t)))
+    {
+        StateRecord_t stateRecord;
+        uint16_t mboxMask;
+
+        memcpy(&stateRecord, recordPtr + sizeof(header), sizeof(stateRecord));
+        mboxMask = RemapMask(stateRecord.mboxMask);
+
+        if (NULL == msgPtr)
+        {
+            LE_DEBUG("State of unknown message %"PRIu32, header.msgId);
+        }
+        else if (0 == mboxMask)
+        {
+            DropMsg(msgPtr);
+        }
+        else
+        {
+            UpdateMsg(msgPtr, mboxMask, RemapMask(stateRecord.unreadMask));
+        }
+    }
+    else
+    {
+        LE_WARN("Skipping record type %d at offset %"PRIdS, header.type, (ssize_t)offset);
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the record at an offset of the store file.
+ *
+ * @return Number of bytes of the record, 0 if there is no valid record at this offset.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t CheckRecord
+(
+    const uint8_t* basePtr,         ///<[IN] Mapped store file
+    off_t          size,            ///<[IN] File size
+    off_t          offset           ///<[IN] Offset of the record
+)
+{
+    RecordHeader_t header;
+    size_t recordLen;
+
+    if ((size_t)(size - offset) < sizeof(header))
+    {
+        return 0;
+    }
+
+    memcpy(&header, basePtr + offset, sizeof(header));
+    recordLen = sizeof(header) + header.payloadLen;
+    if (((size_t)(size - offset) < recordLen) ||
+        (header.version != RECORD_VERSION) ||
+        (header.crc != ComputeRecordCrc(basePtr + offset)))
+    {
+        return 0;
+    }
+
+    return recordLen;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay the store file to build the index. Invalid bytes between two valid records are skipped,
+ * so that a damaged record doesn't lose the records following it. Invalid bytes at the end of the
+ * file are left out of the valid size: they are a record whose write was interrupted.
+ *
+ * @return
+ *      - LE_OK on success, isIdentityPtr telling if the message boxes are unchanged
+ *      - LE_FAULT if the file doesn't start with a valid header record
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReplayStore
+(
+    const uint8_t* basePtr,         ///<[IN] Mapped store file
+    off_t*         sizePtr,         ///<[IN/OUT] File size, end of the last valid record as output
+    bool*          isIdentityPtr,   ///<[OUT] Whether the message boxes are unchanged
+    bool*          isDamagedPtr     ///<[OUT] Whether invalid bytes were skipped
+)
+{
+    size_t recordLen = CheckRecord(basePtr, *sizePtr, 0);
+    off_t offset;
+
+    *isDamagedPtr = false;
+
+    if ((0 == recordLen) || (ReplayHeaderRecord(basePtr, isIdentityPtr) != LE_OK))
+    {
+        return LE_FAULT;
+    }
+    HeaderBytes = recordLen;
+    offset = recordLen;
+
+    while (offset < *sizePtr)
+    {
+        off_t nextOffset;
+
+        recordLen = CheckRecord(basePtr, *sizePtr, offset);
+        if (recordLen > 0)
+        {
+            ReplayRecord(basePtr + offset, offset);
+            offset += recordLen;
+            continue;
+        }
+
+        // Look for the next valid record
+        nextOffset = offset + 1;
+        while ((nextOffset < *sizePtr) && (0 == CheckRecord(basePtr, *sizePtr, nextOffset)))
+        {
+            nextOffset++;
+        }
+
+        if (nextOffset >= *sizePtr)
+        {
+            LE_WARN("Dropping %"PRIdS" bytes of invalid records at offset %"PRIdS,
+                    (ssize_t)(*sizePtr - offset), (ssize_t)offset);
+            *sizePtr = offset;
+            break;
+        }
+
+        LE_ERROR("Skipping %"PRIdS" bytes of invalid records at offset %"PRIdS,
+                 (ssize_t)(nextOffset - offset), (ssize_t)offset);
+        *isDamagedPtr = true;
+        offset = nextOffset;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Keep a damaged store file as \<path\>.bad, replacing the previous one, so that the messages it
+ * holds can still be recovered. The store file is either moved or hard linked there.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SetAsideStore
+(
+    bool isMoved                    ///<[IN] Whether the store file is moved, or linked
+)
+{
+    char badPath[PATH_MAX];
+
+    if (snprintf(badPath, sizeof(badPath), "%s.bad", StorePath) >= (int)sizeof(badPath))
+    {
+        LE_ERROR("Store path too long");
+        return LE_FAULT;
+    }
+
+    if ((unlink(badPath) != 0) && (errno != ENOENT))
+    {
+        LE_ERROR("Unable to remove %s: %m", badPath);
+        return LE_FAULT;
+    }
+
+    if ((isMoved ? rename(StorePath, badPath) : link(StorePath, badPath)) != 0)
+    {
+        LE_ERROR("Unable to keep %s as %s: %m", StorePath, badPath);
+        return LE_FAULT;
+    }
+
+    LE_WARN("Damaged store kept as %s", badPath);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the store file, creating it if needed.
+ *
+ * @return
+ *      - LE_OK on success, isIdentityPtr telling if the message boxes are unchanged
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LoadStore
+(
+    bool* isIdentityPtr,            ///<[OUT] Whether the message boxes are unchanged
+    bool* isDamagedPtr              ///<[OUT] Whether invalid records were skipped
+)
+{
+    struct stat st;
+
+    *isIdentityPtr = true;
+    *isDamagedPtr = false;
+
+    StoreFd = open(StorePath, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (StoreFd < 0)
+    {
+        LE_ERROR("Unable to open %s: %m", StorePath);
+        return LE_FAULT;
+    }
+
+    if (fstat(StoreFd, &st) != 0)
+    {
+        LE_ERROR("Unable to stat %s: %m", StorePath);
+        return LE_FAULT;
+    }
+    StoreSize = st.st_size;
+
+    if (StoreSize > 0)
+    {
+        off_t validSize = StoreSize;
+        void* basePtr = mmap(NULL, StoreSize, PROT_READ, MAP_SHARED, StoreFd, 0);
+
+        if (MAP_FAILED == basePtr)
+        {
+            LE_ERROR("Unable to map %s: %m", StorePath);
+            return LE_FAULT;
+        }
+
+        if (ReplayStore(basePtr, &validSize, isIdentityPtr, isDamagedPtr) != LE_OK)
+        {
+            LE_ERROR("%s is not a valid store, starting a new one", StorePath);
+            munmap(basePtr, StoreSize);
+            close(StoreFd);
+            StoreFd = -1;
+
+            if (SetAsideStore(true) != LE_OK)
+            {
+                return LE_FAULT;
+            }
+            return LoadStore(isIdentityPtr, isDamagedPtr);
+        }
+        munmap(basePtr, StoreSize);
+
+        if (*isDamagedPtr)
+        {
+            // The store is rewritten from the index by the caller, the damaged file is kept aside
+            if (SetAsideStore(false) != LE_OK)
+            {
+                return LE_FAULT;
+            }
+        }
+        else if (validSize < StoreSize)
+        {
+            if (ftruncate(StoreFd, validSize) != 0)
+            {
+                LE_ERROR("Unable to truncate %s: %m", StorePath);
+                return LE_FAULT;
+            }
+            StoreSize = validSize;
+        }
+    }
+
+    if (0 == StoreSize)
+    {
+        uint8_t record[HEADER_RECORD_MAX_BYTES];
+        size_t recordLen = BuildHeaderRecord(record);
+
+        if (AppendRecord(record, recordLen) != LE_OK)
+        {
+            return LE_FAULT;
+        }
+        HeaderBytes = recordLen;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Flush the compaction buffer to a file.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FlushCompactBuffer
+(
+    int     fd,                     ///<[IN] File descriptor
+    size_t* usedPtr                 ///<[IN/OUT] Number of bytes in the buffer
+)
+{
+    le_result_t result = WriteAll(fd, CompactBuffer, *usedPtr);
+
+    *usedPtr = 0;
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the header record and the live message records, with their current state, to a file.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteCompactedStore
+(
+    int            fd,              ///<[IN] File descriptor
+    const uint8_t* basePtr          ///<[IN] Mapped current store file
+)
+{
+    le_dls_Link_t* linkPtr = le_dls_Peek(&MsgList);
+    size_t used = BuildHeaderRecord(CompactBuffer);
+
+    while (linkPtr)
+    {
+        MsgEntry_t* msgPtr = CONTAINER_OF(linkPtr, MsgEntry_t, link);
+        RecordHeader_t header;
+        MsgRecord_t msgRecord;
+        uint8_t* recordPtr;
+
+        if ((used + msgPtr->recordLen > sizeof(CompactBuffer)) &&
+            (FlushCompactBuffer(fd, &used) != LE_OK))
+        {
+            return LE_FAULT;
+        }
+
+        recordPtr = CompactBuffer + used;
+        memcpy(recordPtr, basePtr + msgPtr->offset, msgPtr->recordLen);
+        memcpy(&header, recordPtr, sizeof(header));
+        memcpy(&msgRecord, recordPtr + sizeof(header), sizeof(msgRecord));
+
+        msgRecord.mboxMask = msgPtr->mboxMask;
+        msgRecord.unreadMask = msgPtr->unreadMask;
+        memcpy(recordPtr + sizeof(header), &msgRecord, sizeof(msgRecord));
+        used += SealRecord(recordPtr, RECORD_TYPE_MSG, msgPtr->msgId, header.payloadLen);
+
+        linkPtr = le_dls_PeekNext(&MsgList, linkPtr);
+    }
+
+    if ((FlushCompactBuffer(fd, &used) != LE_OK) || (fdatasync(fd) != 0))
+    {
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Synchronize the directory of the store file, so that a rename of the file reaches the storage.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SyncStoreDir
+(
+    void
+)
+{
+    char dirPath[PATH_MAX];
+    char* slashPtr;
+    int fd;
+    int result;
+
+    LE_ASSERT_OK(le_utf8_Copy(dirPath, StorePath, sizeof(dirPath), NULL));
+    slashPtr = strrchr(dirPath, '/');
+    if (NULL == slashPtr)
+    {
+        LE_ASSERT_OK(le_utf8_Copy(dirPath, ".", sizeof(dirPath), NULL));
+    }
+    else
+    {
+        // Keep the slash of the root directory
+        slashPtr[(slashPtr == dirPath) ? 1 : 0] = '\0';
+    }
+
+    fd = open(dirPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        LE_ERROR("Unable to open %s: %m", dirPath);
+        return LE_FAULT;
+    }
+
+    result = fsync(fd);
+    if (result != 0)
+    {
+        LE_ERROR("Unable to sync %s: %m", dirPath);
+    }
+    close(fd);
+
+    return (0 == result) ? LE_OK : LE_FAULT;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compact the store file if the records no longer describing the store take too much space.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CompactIfNeeded
+(
+    void
+)
+{
+    size_t staleBytes = (size_t)StoreSize - HeaderBytes - LiveBytes;
+
+    if ((staleBytes >= COMPACT_MIN_BYTES) && (staleBytes >= LiveBytes))
+    {
+        smsStore_Compact();
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the store, loading and indexing the content of the store file.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT if the store file cannot be opened or written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Init
+(
+    const char*        pathPtr,         ///< [IN] Store file path
+    const char* const* mboxNamePtr,     ///< [IN] Message box names
+    uint8_t            mboxCount        ///< [IN] Number of message boxes
+)
+{
+    bool isIdentity;
+    bool isDamaged;
+    int i;
+
+    LE_ASSERT(mboxCount <= SMS_STORE_MAX_MBOX);
+    LE_ASSERT(StoreFd < 0);
+
+    for (i = 0; i < mboxCount; i++)
+    {
+        if (strlen(mboxNamePtr[i]) >= MBOX_NAME_MAX_BYTES)
+        {
+            LE_ERROR("Message box name too long: %s", mboxNamePtr[i]);
+            return LE_FAULT;
+        }
+    }
+
+    if (le_utf8_Copy(StorePath, pathPtr, sizeof(StorePath), NULL) != LE_OK)
+    {
+        LE_ERROR("Store path too long: %s", pathPtr);
+        return LE_FAULT;
+    }
+
+    if (NULL == MsgPool)
+    {
+        MsgPool = le_mem_CreatePool("SmsStoreMsgPool", sizeof(MsgEntry_t));
+        le_mem_ExpandPool(MsgPool, DEFAULT_MSG_COUNT);
+        NodePool = le_mem_CreatePool("SmsStoreNodePool", sizeof(MboxNode_t));
+        le_mem_ExpandPool(NodePool, DEFAULT_MSG_COUNT);
+        MsgMap = le_hashmap_Create("SmsStoreMsgMap", MSG_MAP_SIZE,
+                                   le_hashmap_HashUInt32, le_hashmap_EqualsUInt32);
+    }
+
+    MboxNames = mboxNamePtr;
+    MboxCount = mboxCount;
+    memset(Mboxes, 0, sizeof(Mboxes));
+    HeaderBytes = 0;
+    LiveBytes = 0;
+    NextMsgId = 1;
+    CachedMsgId = 0;
+
+    if (LoadStore(&isIdentity, &isDamaged) != LE_OK)
+    {
+        smsStore_Close();
+        return LE_FAULT;
+    }
+
+    LE_INFO("%"PRIuS" messages loaded from %s", le_hashmap_Size(MsgMap), StorePath);
+
+    if ((!isIdentity) || isDamaged)
+    {
+        // Rewrite the file with the current message boxes, or without the damaged records
+        smsStore_Compact();
+    }
+    else
+    {
+        CompactIfNeeded();
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the store, releasing the index. The open cursors are closed.
+ */
+//--------------------------------------------------------------------------------------------------
+void smsStore_Close
+(
+    void
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    while (NULL != (linkPtr = le_dls_Pop(&CursorList)))
+    {
+        CONTAINER_OF(linkPtr, smsStore_Cursor_t, link)->isOpen = false;
+    }
+
+    while (NULL != (linkPtr = le_dls_Peek(&MsgList)))
+    {
+        DropMsg(CONTAINER_OF(linkPtr, MsgEntry_t, link));
+    }
+
+    if (StoreFd >= 0)
+    {
+        close(StoreFd);
+        StoreFd = -1;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a message record and index the message.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER if the message does not belong to any valid message box
+ *      - LE_FAULT if the message cannot be written
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteMsg
+(
+    uint32_t              msgId,        ///< [IN] Message identifier
+    const smsStore_Msg_t* msgPtr,       ///< [IN] Message content
+    uint16_t              mboxMask,     ///< [IN] Message boxes containing the message
+    uint16_t              unreadMask    ///< [IN] Message boxes where the message is unread
+)
+{
+    uint8_t record[MSG_RECORD_MAX_BYTES];
+    size_t recordLen;
+    off_t offset = StoreSize;
+    MsgEntry_t* previousPtr;
+
+    mboxMask &= (1 << MboxCount) - 1;
+    unreadMask &= mboxMask;
+    if ((0 == mboxMask) || (StoreFd < 0))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    recordLen = BuildMsgRecord(record, msgId, msgPtr, mboxMask, unreadMask);
+    if ((0 == recordLen) || (AppendRecord(record, recordLen) != LE_OK))
+    {
+        return LE_FAULT;
+    }
+
+    previousPtr = FindMsg(msgId);
+    if (previousPtr)
+    {
+        DropMsg(previousPtr);
+    }
+    AddMsg(msgId, offset, recordLen, mboxMask, unreadMask);
+
+    // The new message is likely to be read soon
+    CachedMsgId = msgId;
+    CachedMsg = *msgPtr;
+
+    CompactIfNeeded();
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a new message to some message boxes, where it is unread.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER if the message does not belong to any valid message box
+ *      - LE_FAULT if the message cannot be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Add
+(
+    const smsStore_Msg_t* msgPtr,       ///< [IN] Message content
+    uint16_t              mboxMask,     ///< [IN] Message boxes receiving the message
+    uint32_t*             msgIdPtr      ///< [OUT] Message identifier
+)
+{
+    uint32_t msgId = NextMsgId;
+    le_result_t result;
+
+    // Skip the invalid identifier, and the messages still present after a wrap around
+    while ((0 == msgId) || FindMsg(msgId))
+    {
+        msgId++;
+    }
+
+    result = WriteMsg(msgId, msgPtr, mboxMask, mboxMask);
+    if (LE_OK == result)
+    {
+        NextMsgId = msgId + 1;
+        *msgIdPtr = msgId;
+    }
+
+    return result;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a message with a given identifier and state, replacing any message with the same
+ * identifier.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER if the identifier is 0 or the message does not belong to any valid
+ *        message box
+ *      - LE_FAULT if the message cannot be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Import
+(
+    uint32_t              msgId,        ///< [IN] Message identifier
+    const smsStore_Msg_t* msgPtr,       ///< [IN] Message content
+    uint16_t              mboxMask,     ///< [IN] Message boxes containing the message
+    uint16_t              unreadMask    ///< [IN] Message boxes where the message is unread
+)
+{
+    if (0 == msgId)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    return WriteMsg(msgId, msgPtr, mboxMask, unreadMask);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the content of a message.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message does not exist
+ *      - LE_FAULT if the message cannot be read
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Get
+(
+    uint32_t        msgId,              ///< [IN] Message identifier
+    smsStore_Msg_t* msgPtr              ///< [OUT] Message content
+)
+{
+    uint8_t record[MSG_RECORD_MAX_BYTES];
+    MsgEntry_t* entryPtr = FindMsg(msgId);
+    ssize_t readSize;
+
+    if (NULL == entryPtr)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    if (CachedMsgId == msgId)
+    {
+        *msgPtr = CachedMsg;
+        return LE_OK;
+    }
+
+    if (entryPtr->recordLen > sizeof(record))
+    {
+        LE_ERROR("Record of message %"PRIu32" too long", msgId);
+        return LE_FAULT;
+    }
+
+    do
+    {
+        readSize = pread(StoreFd, record, entryPtr->recordLen, entryPtr->offset);
+    }
+    while ((readSize < 0) && (EINTR == errno));
+
+    if (readSize != (ssize_t)entryPtr->recordLen)
+    {
+        LE_ERROR("Unable to read message %"PRIu32": %m", msgId);
+        return LE_FAULT;
+    }
+
+    if ((ComputeRecordCrc(record) != ((RecordHeader_t*)record)->crc) ||
+        (DecodeMsgRecord(record, msgPtr) != LE_OK))
+    {
+        LE_ERROR("Corrupted record for message %"PRIu32, msgId);
+        return LE_FAULT;
+    }
+
+    CachedMsgId = msgId;
+    CachedMsg = *msgPtr;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a message belongs to a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+bool smsStore_IsInMbox
+(
+    uint32_t msgId,                     ///< [IN] Message identifier
+    uint8_t  mboxIdx                    ///< [IN] Message box
+)
+{
+    MsgEntry_t* msgPtr = FindMsg(msgId);
+
+    return (msgPtr && (mboxIdx < MboxCount) && (msgPtr->mboxMask & (1 << mboxIdx)));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a message is unread in a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+bool smsStore_IsUnread
+(
+    uint32_t msgId,                     ///< [IN] Message identifier
+    uint8_t  mboxIdx                    ///< [IN] Message box
+)
+{
+    MsgEntry_t* msgPtr = FindMsg(msgId);
+
+    return (msgPtr && (mboxIdx < MboxCount) && (msgPtr->unreadMask & (1 << mboxIdx)));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark a message as read or unread in a message box.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message does not belong to the message box
+ *      - LE_FAULT if the new state cannot be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_SetUnread
+(
+    uint32_t msgId,                     ///< [IN] Message identifier
+    uint8_t  mboxIdx,                   ///< [IN] Message box
+    bool     isUnread                   ///< [IN] New unread state
+)
+{
+    MsgEntry_t* msgPtr = FindMsg(msgId);
+    uint16_t unreadMask;
+
+    if (!smsStore_IsInMbox(msgId, mboxIdx))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    unreadMask = isUnread ? (msgPtr->unreadMask | (1 << mboxIdx)) :
+                            (msgPtr->unreadMask & ~(1 << mboxIdx));
+    if (unreadMask == msgPtr->unreadMask)
+    {
+        return LE_OK;
+    }
+
+    if (AppendStateRecord(msgId, msgPtr->mboxMask, unreadMask) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+    msgPtr->unreadMask = unreadMask;
+
+    CompactIfNeeded();
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a message from a message box. The message is deleted when it no longer belongs to any
+ * message box.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message does not belong to the message box
+ *      - LE_FAULT if the new state cannot be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_RemoveFromMbox
+(
+    uint32_t msgId,                     ///< [IN] Message identifier
+    uint8_t  mboxIdx                    ///< [IN] Message box
+)
+{
+    MsgEntry_t* msgPtr = FindMsg(msgId);
+    uint16_t mboxMask;
+
+    if (!smsStore_IsInMbox(msgId, mboxIdx))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    mboxMask = msgPtr->mboxMask & ~(1 << mboxIdx);
+    if (AppendStateRecord(msgId, mboxMask, msgPtr->unreadMask & mboxMask) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    if (0 == mboxMask)
+    {
+        LE_DEBUG("Delete message %"PRIu32, msgId);
+        DropMsg(msgPtr);
+    }
+    else
+    {
+        UpdateMsg(msgPtr, mboxMask, msgPtr->unreadMask);
+    }
+
+    CompactIfNeeded();
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of messages in a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetCount
+(
+    uint8_t mboxIdx                     ///< [IN] Message box
+)
+{
+    return (mboxIdx < MboxCount) ? Mboxes[mboxIdx].count : 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the oldest message of a message box.
+ *
+ * @return
+ *      - Message identifier
+ *      - 0 if the message box is empty
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetOldest
+(
+    uint8_t mboxIdx                     ///< [IN] Message box
+)
+{
+    le_dls_Link_t* linkPtr;
+
+    if (mboxIdx >= MboxCount)
+    {
+        return 0;
+    }
+
+    linkPtr = le_dls_Peek(&Mboxes[mboxIdx].list);
+
+    return linkPtr ? CONTAINER_OF(linkPtr, MboxNode_t, link)->msgPtr->msgId : 0;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start browsing a message box, from the oldest to the newest message.
+ *
+ * @return
+ *      - Identifier of the first message
+ *      - 0 if the message box is empty, the cursor being closed
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetFirst
+(
+    smsStore_Cursor_t* cursorPtr,       ///< [IN] Cursor
+    uint8_t            mboxIdx          ///< [IN] Message box
+)
+{
+    smsStore_CloseCursor(cursorPtr);
+
+    if (mboxIdx >= MboxCount)
+    {
+        return 0;
+    }
+
+    cursorPtr->mboxIdx = mboxIdx;
+    cursorPtr->nodeLinkPtr = NULL;
+    cursorPtr->link = LE_DLS_LINK_INIT;
+    cursorPtr->isOpen = true;
+    le_dls_Queue(&CursorList, &cursorPtr->link);
+
+    return smsStore_GetNext(cursorPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the next message of a browsed message box.
+ *
+ * @return
+ *      - Identifier of the next message
+ *      - 0 if there is no more message, the cursor being closed
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetNext
+(
+    smsStore_Cursor_t* cursorPtr        ///< [IN] Cursor
+)
+{
+    le_dls_List_t* listPtr;
+    le_dls_Link_t* linkPtr;
+
+    if (!cursorPtr->isOpen)
+    {
+        return 0;
+    }
+
+    listPtr = &Mboxes[cursorPtr->mboxIdx].list;
+    linkPtr = cursorPtr->nodeLinkPtr ? le_dls_PeekNext(listPtr, cursorPtr->nodeLinkPtr) :
+                                       le_dls_Peek(listPtr);
+    if (NULL == linkPtr)
+    {
+        smsStore_CloseCursor(cursorPtr);
+        return 0;
+    }
+
+    cursorPtr->nodeLinkPtr = linkPtr;
+
+    return CONTAINER_OF(linkPtr, MboxNode_t, link)->msgPtr->msgId;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop browsing a message box. It is valid to close a cursor which is not open.
+ */
+//--------------------------------------------------------------------------------------------------
+void smsStore_CloseCursor
+(
+    smsStore_Cursor_t* cursorPtr        ///< [IN] Cursor
+)
+{
+    if (cursorPtr->isOpen)
+    {
+        le_dls_Remove(&CursorList, &cursorPtr->link);
+        cursorPtr->isOpen = false;
+    }
+    cursorPtr->nodeLinkPtr = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rewrite the store file with the live messages only.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on failure, the previous file being kept
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Compact
+(
+    void
+)
+{
+    char tmpPath[PATH_MAX];
+    le_dls_Link_t* linkPtr;
+    void* basePtr;
+    off_t offset;
+    int fd;
+
+    if (StoreFd < 0)
+    {
+        return LE_FAULT;
+    }
+
+    if (snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", StorePath) >= (int)sizeof(tmpPath))
+    {
+        LE_ERROR("Store path too long");
+        return LE_FAULT;
+    }
+
+    LE_INFO("Compacting %s: %"PRIdS" bytes, %"PRIuS" live", StorePath, (ssize_t)StoreSize,
+            HeaderBytes + LiveBytes);
+
+    basePtr = mmap(NULL, StoreSize, PROT_READ, MAP_SHARED, StoreFd, 0);
+    if (MAP_FAILED == basePtr)
+    {
+        LE_ERROR("Unable to map %s: %m", StorePath);
+        return LE_FAULT;
+    }
+
+    fd = open(tmpPath, O_RDWR | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        LE_ERROR("Unable to open %s: %m", tmpPath);
+        munmap(basePtr, StoreSize);
+        return LE_FAULT;
+    }
+
+    if ((WriteCompactedStore(fd, basePtr) != LE_OK) || (rename(tmpPath, StorePath) != 0))
+    {
+        LE_ERROR("Unable to compact %s: %m", StorePath);
+        close(fd);
+        unlink(tmpPath);
+        munmap(basePtr, StoreSize);
+        return LE_FAULT;
+    }
+
+    munmap(basePtr, StoreSize);
+    close(StoreFd);
+    StoreFd = fd;
+
+    // The next records are appended to the new file, which must not be replaced by the previous
+    // one after a power loss
+    SyncStoreDir();
+
+    // The message records keep their size and order in the new file
+    HeaderBytes = BuildHeaderRecord(CompactBuffer);
+    offset = HeaderBytes;
+    linkPtr = le_dls_Peek(&MsgList);
+    while (linkPtr)
+    {
+        MsgEntry_t* msgPtr = CONTAINER_OF(linkPtr, MsgEntry_t, link);
+
+        msgPtr->offset = offset;
+        offset += msgPtr->recordLen;
+        linkPtr = le_dls_PeekNext(&MsgList, linkPtr);
+    }
+    StoreSize = offset;
+
+    return LE_OK;
+}
@@ -0,0 +1,327 @@
+/**
+ * @file smsStore.h
+ *
+ * SMS Inbox message store.
+ *
+ * The messages of all the message boxes are kept in a single append-only binary file. Each record
+ * of the file is protected by a CRC32 and is one of:
+ *  - a header record, at the beginning of the file, giving the next message identifier and the
+ *    names of the message boxes the masks of the other records refer to,
+ *  - a message record, holding the message content and the message boxes it belongs to, along with
+ *    its unread state in each of them,
+ *  - a state record, updating the message boxes and the unread state of a previous message.
+ *
+ * The file is replayed once when the store is initialized to build an in-memory index: a hash map
+ * of the messages, giving the offset of their record in the file, and an ordered list of the
+ * messages per message box. Adding a message, or changing its state, only appends one record to
+ * the file and updates the index. The messages are read back from the file when their content is
+ * requested, the last read message being cached.
+ *
+ * When the records no longer describing the store become as big as the live ones, the file is
+ * compacted: the live message records are rewritten, with their current state, to a new file which
+ * then atomically replaces the previous one.
+ *
+ * An invalid record at the end of the file, whose write was interrupted, is dropped. Invalid bytes
+ * followed by valid records are skipped, the file being kept as \<path\>.bad and then compacted. A
+ * file without a valid header record is moved to \<path\>.bad and a new store is started.
+ *
+ * <hr>
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#ifndef LEGATO_SMS_STORE_INCLUDE_GUARD
+#define LEGATO_SMS_STORE_INCLUDE_GUARD
+
+#include "legato.h"
+#include "interfaces.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of message boxes in the store.
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMS_STORE_MAX_MBOX 16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of bytes of a message payload (text, binary data or PDU).
+ */
+//--------------------------------------------------------------------------------------------------
+#define SMS_STORE_DATA_MAX_BYTES 256
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message content.
+ *
+ * Strings are empty when the corresponding information is not available for the message. For text
+ * messages, the data holds the text without its terminating NUL character.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sms_Format_t format;                                 ///< Message format
+    uint32_t        msgLen;                                 ///< Message length
+    char            imsi[LE_SIM_IMSI_BYTES];                ///< IMSI of the receiver SIM
+    char            senderTel[LE_MDMDEFS_PHONE_NUM_MAX_BYTES]; ///< Sender telephone number
+    char            timestamp[LE_SMS_TIMESTAMP_MAX_BYTES];  ///< Message time stamp
+    uint8_t         data[SMS_STORE_DATA_MAX_BYTES];         ///< Text, binary data or PDU
+    size_t          dataLen;                                ///< Number of bytes in data
+}
+smsStore_Msg_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message box browsing cursor.
+ *
+ * A cursor remains valid when the messages of the message box are deleted while browsing it.
+ * It must be closed with smsStore_CloseCursor() before its memory is released.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t  link;            ///< Link in the list of open cursors
+    le_dls_Link_t* nodeLinkPtr;     ///< Current message in the message box, NULL if before first
+    uint8_t        mboxIdx;         ///< Browsed message box
+    bool           isOpen;          ///< Whether the cursor is in the list of open cursors
+}
+smsStore_Cursor_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the store, loading and indexing the content of the store file.
+ *
+ * The message boxes are identified by their index in the name table. When the file was written
+ * with a different table, the message boxes are matched by name and the messages of the message
+ * boxes which no longer exist are dropped.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT if the store file cannot be opened or written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Init
+(
+    const char*        pathPtr,         ///< [IN] Store file path
+    const char* const* mboxNamePtr,     ///< [IN] Message box names
+    uint8_t            mboxCount        ///< [IN] Number of message boxes
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the store, releasing the index. The open cursors are closed.
+ */
+//--------------------------------------------------------------------------------------------------
+void smsStore_Close
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a new message to some message boxes, where it is unread.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER if the message does not belong to any valid message box
+ *      - LE_FAULT if the message cannot be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Add
+(
+    const smsStore_Msg_t* msgPtr,       ///< [IN] Message content
+    uint16_t              mboxMask,     ///< [IN] Message boxes receiving the message
+    uint32_t*             msgIdPtr      ///< [OUT] Message identifier
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a message with a given identifier and state, replacing any message with the same
+ * identifier. This is used to import the messages of another storage.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER if the identifier is 0 or the message does not belong to any valid
+ *        message box
+ *      - LE_FAULT if the message cannot be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Import
+(
+    uint32_t              msgId,        ///< [IN] Message identifier
+    const smsStore_Msg_t* msgPtr,       ///< [IN] Message content
+    uint16_t              mboxMask,     ///< [IN] Message boxes containing the message
+    uint16_t              unreadMask    ///< [IN] Message boxes where the message is unread
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the content of a message.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message does not exist
+ *      - LE_FAULT if the message cannot be read
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Get
+(
+    uint32_t        msgId,              ///< [IN] Message identifier
+    smsStore_Msg_t* msgPtr              ///< [OUT] Message content
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a message belongs to a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+bool smsStore_IsInMbox
+(
+    uint32_t msgId,                     ///< [IN] Message identifier
+    uint8_t  mboxIdx                    ///< [IN] Message box
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a message is unread in a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+bool smsStore_IsUnread
+(
+    uint32_t msgId,                     ///< [IN] Message identifier
+    uint8_t  mboxIdx                    ///< [IN] Message box
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mark a message as read or unread in a message box.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message does not belong to the message box
+ *      - LE_FAULT if the new state cannot be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_SetUnread
+(
+    uint32_t msgId,                     ///< [IN] Message identifier
+    uint8_t  mboxIdx,                   ///< [IN] Message box
+    bool     isUnread                   ///< [IN] New unread state
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Remove a message from a message box. The message is deleted when it no longer belongs to any
+ * message box.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_NOT_FOUND if the message does not belong to the message box
+ *      - LE_FAULT if the new state cannot be written
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_RemoveFromMbox
+(
+    uint32_t msgId,                     ///< [IN] Message identifier
+    uint8_t  mboxIdx                    ///< [IN] Message box
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of messages in a message box.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetCount
+(
+    uint8_t mboxIdx                     ///< [IN] Message box
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the oldest message of a message box.
+ *
+ * @return
+ *      - Message identifier
+ *      - 0 if the message box is empty
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetOldest
+(
+    uint8_t mboxIdx                     ///< [IN] Message box
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start browsing a message box, from the oldest to the newest message.
+ *
+ * @return
+ *      - Identifier of the first message
+ *      - 0 if the message box is empty, the cursor being closed
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetFirst
+(
+    smsStore_Cursor_t* cursorPtr,       ///< [IN] Cursor
+    uint8_t            mboxIdx          ///< [IN] Message box
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the next message of a browsed message box.
+ *
+ * @return
+ *      - Identifier of the next message
+ *      - 0 if there is no more message, the cursor being closed
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t smsStore_GetNext
+(
+    smsStore_Cursor_t* cursorPtr        ///< [IN] Cursor
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stop browsing a message box. It is valid to close a cursor which is not open.
+ */
+//--------------------------------------------------------------------------------------------------
+void smsStore_CloseCursor
+(
+    smsStore_Cursor_t* cursorPtr        ///< [IN] Cursor
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rewrite the store file with the live messages only.
+ *
+ * @note The store is compacted automatically when needed, this is only required to force it.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_FAULT on failure, the previous file being kept
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t smsStore_Compact
+(
+    void
+);
+
+#endif // LEGATO_SMS_STORE_INCLUDE_GUARD
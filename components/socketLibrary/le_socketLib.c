@@ -910,9 +910,48 @@ le_result_t le_socket_Disconnect
         contextPtr->monitorRef = NULL;
     }
 
+    // The file descriptor is closed: it must not be used, nor closed again when the socket is
+    // deleted, as it may have been reused for another socket in the meantime.
+    contextPtr->fd = -1;
+
     return status;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the socket connection can still be used to send data: the socket is connected,
+ * the connection has not been closed by the remote peer and, for unsecure sockets, no unexpected
+ * data is waiting to be read.  This function does not block nor consume any data.
+ *
+ * @return
+ *  - True if the connection can be used, false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool le_socket_IsConnected
+(
+    le_socket_Ref_t    ref   ///< [IN] Socket context reference
+)
+{
+    le_result_t status;
+    SocketCtx_t *contextPtr = (SocketCtx_t *)le_ref_Lookup(SocketRefMap, ref);
+    if (contextPtr == NULL)
+    {
+        LE_ERROR("Reference not found: %p", ref);
+        return false;
+    }
+
+    if (contextPtr->fd == -1)
+    {
+        return false;
+    }
+
+    status = netSocket_CheckConnection(contextPtr->fd);
+
+    // Records pending on a secure connection are not necessarily application data (e.g. TLS
+    // session tickets), they are handled by the next read.
+    return (status == LE_OK) || ((status == LE_BUSY) && contextPtr->isSecure);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Send data through the socket.
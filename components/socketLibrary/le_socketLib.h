@@ -366,6 +366,21 @@ LE_SHARED le_result_t le_socket_Disconnect
     le_socket_Ref_t    ref   ///< [IN] Socket context reference
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether the socket connection can still be used to send data: the socket is connected,
+ * the connection has not been closed by the remote peer and, for unsecure sockets, no unexpected
+ * data is waiting to be read.  This function does not block nor consume any data.
+ *
+ * @return
+ *  - True if the connection can be used, false otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED bool le_socket_IsConnected
+(
+    le_socket_Ref_t    ref   ///< [IN] Socket context reference
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Send data through the socket
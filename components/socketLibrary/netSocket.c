@@ -597,3 +597,70 @@ le_result_t netSocket_Read
     LE_INFO("Read size: %"PRIuS, *bufLenPtr);
     return LE_OK;
 }
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the state of a connected socket file descriptor without blocking nor consuming any data.
+ *
+ * @return
+ *  - LE_OK            The connection is open and there is nothing to read
+ *  - LE_BUSY          The connection is open and data is waiting to be read
+ *  - LE_CLOSED        The connection has been closed by the remote peer
+ *  - LE_BAD_PARAMETER Invalid parameter
+ *  - LE_FAULT         Internal error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t netSocket_CheckConnection
+(
+    int     fd            ///< [IN] Socket file descriptor
+)
+{
+    fd_set set;
+    int rv, count;
+    char data;
+    struct timeval time = {.tv_sec = 0, .tv_usec = 0};
+
+    if (fd < 0)
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    do
+    {
+       FD_ZERO(&set);
+       FD_SET(fd, &set);
+       rv = select(fd + 1, &set, NULL, NULL, &time);
+    }
+    while (rv == -1 && errno == EINTR);
+
+    if (rv == 0)
+    {
+        return LE_OK;
+    }
+    else if (rv < 0)
+    {
+        return LE_FAULT;
+    }
+
+    // Readable: either data is pending, or the peer closed the connection
+    do
+    {
+       count = recv(fd, &data, sizeof(data), MSG_PEEK | MSG_DONTWAIT);
+    }
+    while (count == -1 && errno == EINTR);
+
+    if (count > 0)
+    {
+        return LE_BUSY;
+    }
+    else if (count == 0)
+    {
+        return LE_CLOSED;
+    }
+    else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+    {
+        return LE_OK;
+    }
+
+    return LE_FAULT;
+}
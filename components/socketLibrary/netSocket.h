@@ -135,4 +135,21 @@ le_result_t netSocket_Read
     uint32_t timeout      ///< [IN] Read timeout in milliseconds.
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check the state of a connected socket file descriptor without blocking nor consuming any data.
+ *
+ * @return
+ *  - LE_OK            The connection is open and there is nothing to read
+ *  - LE_BUSY          The connection is open and data is waiting to be read
+ *  - LE_CLOSED        The connection has been closed by the remote peer
+ *  - LE_BAD_PARAMETER Invalid parameter
+ *  - LE_FAULT         Internal error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t netSocket_CheckConnection
+(
+    int     fd            ///< [IN] Socket file descriptor
+);
+
 #endif /* LE_NET_SOCKET_LIB_H */
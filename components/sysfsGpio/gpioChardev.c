@@ -0,0 +1,624 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Access to the GPIO lines through the version 2 of the Linux GPIO character device interface.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "gpioChardev.h"
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+#if defined(GPIO_V2_GET_LINE_IOCTL)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File descriptor of the open chip.
+ */
+//--------------------------------------------------------------------------------------------------
+static int ChipFd = -1;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of lines of the open chip.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t LineCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Correspondence between the GPIOCHARDEV_ flags and the kernel flags.
+ */
+//--------------------------------------------------------------------------------------------------
+static const struct
+{
+    uint32_t flag;              ///< GPIOCHARDEV_ flag
+    uint64_t kernelFlag;        ///< GPIO_V2_LINE_FLAG_ flag
+}
+FlagMap[] =
+{
+    { GPIOCHARDEV_INPUT,         GPIO_V2_LINE_FLAG_INPUT },
+    { GPIOCHARDEV_OUTPUT,        GPIO_V2_LINE_FLAG_OUTPUT },
+    { GPIOCHARDEV_ACTIVE_LOW,    GPIO_V2_LINE_FLAG_ACTIVE_LOW },
+    { GPIOCHARDEV_EDGE_RISING,   GPIO_V2_LINE_FLAG_EDGE_RISING },
+    { GPIOCHARDEV_EDGE_FALLING,  GPIO_V2_LINE_FLAG_EDGE_FALLING },
+    { GPIOCHARDEV_OPEN_DRAIN,    GPIO_V2_LINE_FLAG_OPEN_DRAIN },
+    { GPIOCHARDEV_PULL_UP,       GPIO_V2_LINE_FLAG_BIAS_PULL_UP },
+    { GPIOCHARDEV_PULL_DOWN,     GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN },
+    { GPIOCHARDEV_BIAS_DISABLED, GPIO_V2_LINE_FLAG_BIAS_DISABLED },
+};
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert GPIOCHARDEV_ flags to kernel flags.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ToKernelFlags
+(
+    uint32_t flags
+)
+{
+    uint64_t kernelFlags = 0;
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(FlagMap); i++)
+    {
+        if (flags & FlagMap[i].flag)
+        {
+            kernelFlags |= FlagMap[i].kernelFlag;
+        }
+    }
+
+    return kernelFlags;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert kernel flags to GPIOCHARDEV_ flags.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t FromKernelFlags
+(
+    uint64_t kernelFlags
+)
+{
+    uint32_t flags = 0;
+    size_t i;
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(FlagMap); i++)
+    {
+        if (kernelFlags & FlagMap[i].kernelFlag)
+        {
+            flags |= FlagMap[i].flag;
+        }
+    }
+
+    return flags;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert the errno of a failed ioctl() to a result code.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ErrnoToResult
+(
+    int err
+)
+{
+    switch (err)
+    {
+        case EBUSY:
+            return LE_BUSY;
+        case EINVAL:
+            return LE_BAD_PARAMETER;
+        default:
+            return LE_FAULT;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Call ioctl(), retrying when interrupted by a signal.
+ */
+//--------------------------------------------------------------------------------------------------
+static int Ioctl
+(
+    int fd,
+    unsigned long request,
+    void* argPtr
+)
+{
+    int ret;
+
+    do
+    {
+        ret = ioctl(fd, request, argPtr);
+    }
+    while ((ret == -1) && (errno == EINTR));
+
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Build a kernel line configuration.
+ *
+ * The most common configuration, the one of the first line, is the default configuration and
+ * each other configuration takes one attribute, as does the values of the output lines.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_OVERFLOW if there are too many different configurations
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t BuildConfig
+(
+    struct gpio_v2_line_config* configPtr,  ///< [OUT] Kernel configuration
+    const uint32_t* flagsPtr,               ///< [IN] GPIOCHARDEV_ flags of each line
+    uint32_t        count,                  ///< [IN] Number of lines
+    uint64_t        values                  ///< [IN] Values of the output lines
+)
+{
+    uint64_t outputMask = 0;
+    uint32_t i;
+    uint32_t j;
+
+    memset(configPtr, 0, sizeof(*configPtr));
+    configPtr->flags = ToKernelFlags(flagsPtr[0]);
+
+    for (i = 0; i < count; i++)
+    {
+        uint64_t kernelFlags = ToKernelFlags(flagsPtr[i]);
+
+        if (flagsPtr[i] & GPIOCHARDEV_OUTPUT)
+        {
+            outputMask |= (uint64_t)1 << i;
+        }
+
+        if (kernelFlags == configPtr->flags)
+        {
+            continue;
+        }
+
+        for (j = 0; j < configPtr->num_attrs; j++)
+        {
+            if (configPtr->attrs[j].attr.flags == kernelFlags)
+            {
+                break;
+            }
+        }
+
+        if (j == configPtr->num_attrs)
+        {
+            // Keep one attribute for the output values
+            if (configPtr->num_attrs >= GPIO_V2_LINE_NUM_ATTRS_MAX - 1)
+            {
+                return LE_OVERFLOW;
+            }
+            configPtr->attrs[j].attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+            configPtr->attrs[j].attr.flags = kernelFlags;
+            configPtr->num_attrs++;
+        }
+        configPtr->attrs[j].mask |= (uint64_t)1 << i;
+    }
+
+    if (outputMask)
+    {
+        j = configPtr->num_attrs++;
+        configPtr->attrs[j].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+        configPtr->attrs[j].attr.values = values & outputMask;
+        configPtr->attrs[j].mask = outputMask;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a GPIO chip. Only one chip is handled at a time.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_UNSUPPORTED if the kernel or its headers do not provide the version 2 of the GPIO
+ *    character device interface
+ *  - LE_NOT_FOUND if the chip does not exist
+ *  - LE_FAULT on any other failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_Open
+(
+    const char* pathPtr         ///< [IN] Chip device path, e.g. /dev/gpiochip0
+)
+{
+    struct gpiochip_info chipInfo;
+    struct gpio_v2_line_info lineInfo;
+    int fd;
+
+    gpioChardev_Close();
+
+    do
+    {
+        fd = open(pathPtr, O_RDWR | O_CLOEXEC);
+    }
+    while ((fd == -1) && (errno == EINTR));
+
+    if (fd == -1)
+    {
+        LE_DEBUG("Unable to open %s: %m", pathPtr);
+        return (errno == ENOENT) ? LE_NOT_FOUND : LE_FAULT;
+    }
+
+    memset(&chipInfo, 0, sizeof(chipInfo));
+    if (Ioctl(fd, GPIO_GET_CHIPINFO_IOCTL, &chipInfo) == -1)
+    {
+        LE_WARN("%s is not a GPIO chip: %m", pathPtr);
+        close(fd);
+        return LE_FAULT;
+    }
+
+    // Older kernels only provide the version 1 of the interface
+    memset(&lineInfo, 0, sizeof(lineInfo));
+    if ((chipInfo.lines == 0) || (Ioctl(fd, GPIO_V2_GET_LINEINFO_IOCTL, &lineInfo) == -1))
+    {
+        LE_INFO("GPIO character device v2 not supported by %s", pathPtr);
+        close(fd);
+        return LE_UNSUPPORTED;
+    }
+
+    LE_INFO("Using GPIO chip %s (%s), %u lines", pathPtr, chipInfo.label, chipInfo.lines);
+    ChipFd = fd;
+    LineCount = chipInfo.lines;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the GPIO chip. The line requests stay valid until they are released.
+ */
+//--------------------------------------------------------------------------------------------------
+void gpioChardev_Close
+(
+    void
+)
+{
+    if (ChipFd != -1)
+    {
+        close(ChipFd);
+        ChipFd = -1;
+        LineCount = 0;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of lines of the GPIO chip.
+ *
+ * @return The number of lines, 0 if no chip is open
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t gpioChardev_GetLineCount
+(
+    void
+)
+{
+    return LineCount;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current configuration of a line, as reported by the kernel.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_GetLineFlags
+(
+    uint32_t  offset,           ///< [IN] Line offset in the chip
+    uint32_t* flagsPtr          ///< [OUT] GPIOCHARDEV_ flags
+)
+{
+    struct gpio_v2_line_info lineInfo;
+
+    memset(&lineInfo, 0, sizeof(lineInfo));
+    lineInfo.offset = offset;
+
+    if (Ioctl(ChipFd, GPIO_V2_GET_LINEINFO_IOCTL, &lineInfo) == -1)
+    {
+        LE_ERROR("Unable to get the information of line %"PRIu32": %m", offset);
+        return LE_FAULT;
+    }
+
+    *flagsPtr = FromKernelFlags(lineInfo.flags);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request some lines of the GPIO chip.
+ *
+ * A line requested without direction flag keeps its current direction and, if it is an output,
+ * its current value.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_BUSY if a line is already requested, through the character device or the sysfs
+ *  - LE_OVERFLOW if the lines have too many different configurations
+ *  - LE_BAD_PARAMETER if a line or a configuration is invalid
+ *  - LE_FAULT on any other failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_Request
+(
+    const uint32_t* offsetsPtr, ///< [IN] Line offsets in the chip
+    const uint32_t* flagsPtr,   ///< [IN] GPIOCHARDEV_ flags of each line
+    uint32_t        count,      ///< [IN] Number of lines
+    uint64_t        values,     ///< [IN] Initial values of the output lines
+    const char*     consumerPtr,///< [IN] Consumer name reported by the kernel
+    int*            fdPtr       ///< [OUT] Request file descriptor
+)
+{
+    struct gpio_v2_line_request request;
+    le_result_t result;
+    int flags;
+
+    if ((count == 0) || (count > GPIOCHARDEV_MAX_LINES) || (count > GPIO_V2_LINES_MAX))
+    {
+        return LE_BAD_PARAMETER;
+    }
+
+    memset(&request, 0, sizeof(request));
+    memcpy(request.offsets, offsetsPtr, count * sizeof(offsetsPtr[0]));
+    request.num_lines = count;
+    le_utf8_Copy(request.consumer, consumerPtr, sizeof(request.consumer), NULL);
+
+    result = BuildConfig(&request.config, flagsPtr, count, values);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    if (Ioctl(ChipFd, GPIO_V2_GET_LINE_IOCTL, &request) == -1)
+    {
+        LE_ERROR("Unable to request %"PRIu32" line(s) from line %"PRIu32": %m",
+                 count, offsetsPtr[0]);
+        return ErrnoToResult(errno);
+    }
+
+    // Edge events are read from the fd monitor handlers, which must not block
+    flags = fcntl(request.fd, F_GETFL);
+    if ((flags == -1) || (fcntl(request.fd, F_SETFL, flags | O_NONBLOCK) == -1))
+    {
+        LE_ERROR("Unable to make the line request non-blocking: %m");
+        close(request.fd);
+        return LE_FAULT;
+    }
+
+    *fdPtr = request.fd;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Change the configuration of the lines of a request.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_OVERFLOW if the lines have too many different configurations
+ *  - LE_BAD_PARAMETER if a configuration is invalid
+ *  - LE_FAULT on any other failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_SetConfig
+(
+    int             fd,         ///< [IN] Request file descriptor
+    const uint32_t* flagsPtr,   ///< [IN] GPIOCHARDEV_ flags of each line
+    uint32_t        count,      ///< [IN] Number of lines of the request
+    uint64_t        values      ///< [IN] Values of the output lines
+)
+{
+    struct gpio_v2_line_config config;
+    le_result_t result;
+
+    result = BuildConfig(&config, flagsPtr, count, values);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    if (Ioctl(fd, GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) == -1)
+    {
+        LE_ERROR("Unable to configure the lines: %m");
+        return ErrnoToResult(errno);
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the values of some lines of a request.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_GetValues
+(
+    int       fd,               ///< [IN] Request file descriptor
+    uint64_t  mask,             ///< [IN] Lines to read
+    uint64_t* valuesPtr         ///< [OUT] Line values
+)
+{
+    struct gpio_v2_line_values lineValues = { .bits = 0, .mask = mask };
+
+    if (Ioctl(fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &lineValues) == -1)
+    {
+        LE_ERROR("Unable to read the lines: %m");
+        return LE_FAULT;
+    }
+
+    *valuesPtr = lineValues.bits & mask;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the values of some output lines of a request, all at once.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_SetValues
+(
+    int      fd,                ///< [IN] Request file descriptor
+    uint64_t mask,              ///< [IN] Lines to write
+    uint64_t values             ///< [IN] Line values
+)
+{
+    struct gpio_v2_line_values lineValues = { .bits = values & mask, .mask = mask };
+
+    if (Ioctl(fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &lineValues) == -1)
+    {
+        LE_ERROR("Unable to write the lines: %m");
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the next edge event of a request. The request file descriptor is non-blocking.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_WOULD_BLOCK if no event is pending
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_ReadEvent
+(
+    int       fd,               ///< [IN] Request file descriptor
+    uint32_t* offsetPtr,        ///< [OUT] Offset in the chip of the line
+    bool*     isRisingPtr       ///< [OUT] Rising edge, otherwise falling edge
+)
+{
+    struct gpio_v2_line_event event;
+    ssize_t count;
+
+    do
+    {
+        count = read(fd, &event, sizeof(event));
+    }
+    while ((count == -1) && (errno == EINTR));
+
+    if (count == -1)
+    {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return LE_WOULD_BLOCK;
+        }
+        LE_ERROR("Unable to read the line events: %m");
+        return LE_FAULT;
+    }
+
+    // The kernel only returns whole events
+    if (count != sizeof(event))
+    {
+        LE_ERROR("Truncated line event (%zd bytes)", count);
+        return LE_FAULT;
+    }
+
+    *offsetPtr = event.offset;
+    *isRisingPtr = (event.id == GPIO_V2_LINE_EVENT_RISING_EDGE);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the lines of a request.
+ */
+//--------------------------------------------------------------------------------------------------
+void gpioChardev_Release
+(
+    int fd                      ///< [IN] Request file descriptor
+)
+{
+    LE_WARN_IF(close(fd) == -1, "Failed to release the line request: %m");
+}
+
+#else // GPIO_V2_GET_LINE_IOCTL
+
+//--------------------------------------------------------------------------------------------------
+/*
+ * The kernel headers do not provide the version 2 of the interface: the chip can never be opened,
+ * so that the other functions are never called.
+ */
+//--------------------------------------------------------------------------------------------------
+
+le_result_t gpioChardev_Open(const char* pathPtr)
+{
+    LE_INFO("GPIO character device v2 not supported by the kernel headers");
+    return LE_UNSUPPORTED;
+}
+
+void gpioChardev_Close(void)
+{
+}
+
+uint32_t gpioChardev_GetLineCount(void)
+{
+    return 0;
+}
+
+le_result_t gpioChardev_GetLineFlags(uint32_t offset, uint32_t* flagsPtr)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t gpioChardev_Request(const uint32_t* offsetsPtr, const uint32_t* flagsPtr,
+                                uint32_t count, uint64_t values, const char* consumerPtr,
+                                int* fdPtr)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t gpioChardev_SetConfig(int fd, const uint32_t* flagsPtr, uint32_t count,
+                                  uint64_t values)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t gpioChardev_GetValues(int fd, uint64_t mask, uint64_t* valuesPtr)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t gpioChardev_SetValues(int fd, uint64_t mask, uint64_t values)
+{
+    return LE_UNSUPPORTED;
+}
+
+le_result_t gpioChardev_ReadEvent(int fd, uint32_t* offsetPtr, bool* isRisingPtr)
+{
+    return LE_UNSUPPORTED;
+}
+
+void gpioChardev_Release(int fd)
+{
+}
+
+#endif // GPIO_V2_GET_LINE_IOCTL
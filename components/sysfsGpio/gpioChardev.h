@@ -0,0 +1,203 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Access to the GPIO lines through the Linux GPIO character device (/dev/gpiochipN).
+ *
+ * Unlike the sysfs, the character device hands out a file descriptor per line request, which is
+ * kept open for as long as the lines are used. Configuring the lines, reading and writing their
+ * values are then single ioctl() calls on that file descriptor, whatever the number of lines of
+ * the request, and edge events are queued by the kernel and read from the same file descriptor.
+ *
+ * The values and masks of a request are bit fields in which bit n is the n-th line of the request.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef GPIOCHARDEV_INCLUDE_GUARD
+#define GPIOCHARDEV_INCLUDE_GUARD
+
+#include "legato.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of lines of a request.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GPIOCHARDEV_MAX_LINES       64
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Line configuration flags.
+ */
+//--------------------------------------------------------------------------------------------------
+#define GPIOCHARDEV_INPUT           0x0001  ///< Line is an input
+#define GPIOCHARDEV_OUTPUT          0x0002  ///< Line is an output
+#define GPIOCHARDEV_ACTIVE_LOW      0x0004  ///< Line is active-low
+#define GPIOCHARDEV_EDGE_RISING     0x0008  ///< Rising edges are reported (input only)
+#define GPIOCHARDEV_EDGE_FALLING    0x0010  ///< Falling edges are reported (input only)
+#define GPIOCHARDEV_OPEN_DRAIN      0x0020  ///< Output is open-drain
+#define GPIOCHARDEV_PULL_UP         0x0040  ///< Pull-up resistor enabled
+#define GPIOCHARDEV_PULL_DOWN       0x0080  ///< Pull-down resistor enabled
+#define GPIOCHARDEV_BIAS_DISABLED   0x0100  ///< Pull-up and pull-down resistors disabled
+
+#define GPIOCHARDEV_EDGE_BOTH       (GPIOCHARDEV_EDGE_RISING | GPIOCHARDEV_EDGE_FALLING)
+#define GPIOCHARDEV_BIAS_MASK       (GPIOCHARDEV_PULL_UP | GPIOCHARDEV_PULL_DOWN | \
+                                     GPIOCHARDEV_BIAS_DISABLED)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a GPIO chip. Only one chip is handled at a time.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_UNSUPPORTED if the kernel or its headers do not provide the version 2 of the GPIO
+ *    character device interface
+ *  - LE_NOT_FOUND if the chip does not exist
+ *  - LE_FAULT on any other failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_Open
+(
+    const char* pathPtr         ///< [IN] Chip device path, e.g. /dev/gpiochip0
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Close the GPIO chip. The line requests stay valid until they are released.
+ */
+//--------------------------------------------------------------------------------------------------
+void gpioChardev_Close
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of lines of the GPIO chip.
+ *
+ * @return The number of lines, 0 if no chip is open
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t gpioChardev_GetLineCount
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current configuration of a line, as reported by the kernel.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_GetLineFlags
+(
+    uint32_t  offset,           ///< [IN] Line offset in the chip
+    uint32_t* flagsPtr          ///< [OUT] GPIOCHARDEV_ flags
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request some lines of the GPIO chip.
+ *
+ * A line requested without direction flag keeps its current direction and, if it is an output,
+ * its current value.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_BUSY if a line is already requested, through the character device or the sysfs
+ *  - LE_OVERFLOW if the lines have too many different configurations
+ *  - LE_BAD_PARAMETER if a line or a configuration is invalid
+ *  - LE_FAULT on any other failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_Request
+(
+    const uint32_t* offsetsPtr, ///< [IN] Line offsets in the chip
+    const uint32_t* flagsPtr,   ///< [IN] GPIOCHARDEV_ flags of each line
+    uint32_t        count,      ///< [IN] Number of lines
+    uint64_t        values,     ///< [IN] Initial values of the output lines
+    const char*     consumerPtr,///< [IN] Consumer name reported by the kernel
+    int*            fdPtr       ///< [OUT] Request file descriptor
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Change the configuration of the lines of a request.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_OVERFLOW if the lines have too many different configurations
+ *  - LE_BAD_PARAMETER if a configuration is invalid
+ *  - LE_FAULT on any other failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_SetConfig
+(
+    int             fd,         ///< [IN] Request file descriptor
+    const uint32_t* flagsPtr,   ///< [IN] GPIOCHARDEV_ flags of each line
+    uint32_t        count,      ///< [IN] Number of lines of the request
+    uint64_t        values      ///< [IN] Values of the output lines
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the values of some lines of a request.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_GetValues
+(
+    int       fd,               ///< [IN] Request file descriptor
+    uint64_t  mask,             ///< [IN] Lines to read
+    uint64_t* valuesPtr         ///< [OUT] Line values
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write the values of some output lines of a request, all at once.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_SetValues
+(
+    int      fd,                ///< [IN] Request file descriptor
+    uint64_t mask,              ///< [IN] Lines to write
+    uint64_t values             ///< [IN] Line values
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the next edge event of a request. The request file descriptor is non-blocking.
+ *
+ * @return
+ *  - LE_OK on success
+ *  - LE_WOULD_BLOCK if no event is pending
+ *  - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioChardev_ReadEvent
+(
+    int       fd,               ///< [IN] Request file descriptor
+    uint32_t* offsetPtr,        ///< [OUT] Offset in the chip of the line
+    bool*     isRisingPtr       ///< [OUT] Rising edge, otherwise falling edge
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the lines of a request.
+ */
+//--------------------------------------------------------------------------------------------------
+void gpioChardev_Release
+(
+    int fd                      ///< [IN] Request file descriptor
+);
+
+#endif // GPIOCHARDEV_INCLUDE_GUARD
@@ -0,0 +1,377 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file gpioGroup.c
+ *
+ * Implementation of the le_gpioGroup API: the lines of the pins of a group are requested at once
+ * from the GPIO character device, so that they are read or written with a single ioctl().
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+#include "gpioSysfs.h"
+#include "gpioChardev.h"
+#include "gpioGroup.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of groups: each pin belongs to one group at most.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_GROUPS      GPIOCHARDEV_MAX_LINES
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Group of pins.
+ *
+ * The lines are requested in ascending pin order, so that the n-th line of the request is the
+ * n-th pin of pinMask.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    int                 fd;                                 ///< Line request
+    uint32_t            count;                              ///< Number of pins
+    uint64_t            pinMask;                            ///< Pins of the group
+    uint64_t            outputMask;                         ///< Output pins of the group
+    gpioSysfs_GpioRef_t gpioRefs[GPIOCHARDEV_MAX_LINES];    ///< GPIO objects of the pins
+    le_msg_SessionRef_t sessionRef;                         ///< Client session
+}
+Group_t;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool and reference map of the groups.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(GroupPool, MAX_GROUPS, sizeof(Group_t));
+static le_mem_PoolRef_t GroupPool;
+LE_REF_DEFINE_STATIC_MAP(GroupRefMap, MAX_GROUPS);
+static le_ref_MapRef_t GroupRefMap;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * GPIO objects of the pins, pin n + 1 being at index n.
+ */
+//--------------------------------------------------------------------------------------------------
+static const gpioSysfs_GpioRef_t* GpioRefsPtr;
+static size_t GpioRefCount;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pins which can be grouped.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t AvailableMask;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a mask of pins to a mask of lines of a group.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t PinsToLines
+(
+    const Group_t* groupPtr,    ///< [IN] Group
+    uint64_t pins               ///< [IN] Pin mask
+)
+{
+    uint64_t pinMask = groupPtr->pinMask;
+    uint64_t lines = 0;
+    uint32_t i;
+
+    for (i = 0; i < groupPtr->count; i++)
+    {
+        uint64_t pinBit = pinMask & -pinMask;
+
+        if (pins & pinBit)
+        {
+            lines |= (uint64_t)1 << i;
+        }
+        pinMask &= ~pinBit;
+    }
+
+    return lines;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Convert a mask of lines of a group to a mask of pins.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t LinesToPins
+(
+    const Group_t* groupPtr,    ///< [IN] Group
+    uint64_t lines              ///< [IN] Line mask
+)
+{
+    uint64_t pinMask = groupPtr->pinMask;
+    uint64_t pins = 0;
+    uint32_t i;
+
+    for (i = 0; i < groupPtr->count; i++)
+    {
+        uint64_t pinBit = pinMask & -pinMask;
+
+        if (lines & ((uint64_t)1 << i))
+        {
+            pins |= pinBit;
+        }
+        pinMask &= ~pinBit;
+    }
+
+    return pins;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a group and its pins.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseGroup
+(
+    le_gpioGroup_GroupRef_t groupRef,   ///< [IN] Group reference
+    Group_t* groupPtr                   ///< [IN] Group
+)
+{
+    uint32_t i;
+
+    gpioChardev_Release(groupPtr->fd);
+
+    for (i = 0; i < groupPtr->count; i++)
+    {
+        groupPtr->gpioRefs[i]->inUse = false;
+    }
+
+    LE_INFO("Released GPIO group 0x%016"PRIx64, groupPtr->pinMask);
+    le_ref_DeleteRef(GroupRefMap, groupRef);
+    le_mem_Release(groupPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the groups of a client when it disconnects.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SessionCloseHandler
+(
+    le_msg_SessionRef_t sessionRef,     ///< [IN] Client session
+    void* contextPtr                    ///< [IN] Unused
+)
+{
+    le_ref_IterRef_t iterRef = le_ref_GetIterator(GroupRefMap);
+
+    while (le_ref_NextNode(iterRef) == LE_OK)
+    {
+        Group_t* groupPtr = (Group_t*)le_ref_GetValue(iterRef);
+
+        if (groupPtr->sessionRef == sessionRef)
+        {
+            ReleaseGroup((le_gpioGroup_GroupRef_t)le_ref_GetSafeRef(iterRef), groupPtr);
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request a group of pins and configure them.
+ *
+ * @return
+ *      - A reference to the group
+ *      - NULL if a pin is not available, is already in use or cannot be configured
+ */
+//--------------------------------------------------------------------------------------------------
+le_gpioGroup_GroupRef_t le_gpioGroup_Request
+(
+    uint64_t pinMask,           ///< [IN] Pins of the group, bit n for pin n + 1
+    uint64_t outputMask,        ///< [IN] Pins configured as outputs, the others are inputs
+    uint64_t activeLowMask,     ///< [IN] Active-low pins, the others are active-high
+    uint64_t values             ///< [IN] Initial values of the outputs (true = active)
+)
+{
+    uint32_t offsets[GPIOCHARDEV_MAX_LINES];
+    uint32_t flags[GPIOCHARDEV_MAX_LINES];
+    Group_t* groupPtr;
+    uint32_t count = 0;
+    size_t pin;
+
+    if ((pinMask == 0) || (pinMask & ~AvailableMask))
+    {
+        LE_ERROR("Pins 0x%016"PRIx64" are not available", pinMask & ~AvailableMask);
+        return NULL;
+    }
+
+    groupPtr = le_mem_ForceAlloc(GroupPool);
+
+    for (pin = 0; pin < GpioRefCount; pin++)
+    {
+        uint64_t pinBit = (uint64_t)1 << pin;
+        gpioSysfs_GpioRef_t gpioRef = GpioRefsPtr[pin];
+
+        if (!(pinMask & pinBit))
+        {
+            continue;
+        }
+
+        if (gpioRef->inUse || (gpioSysfs_GetLineOffset(gpioRef, &offsets[count]) != LE_OK))
+        {
+            LE_ERROR("GPIO %d is in use or not available for groups", gpioRef->pinNum);
+            le_mem_Release(groupPtr);
+            return NULL;
+        }
+
+        flags[count] = ((outputMask & pinBit) ? GPIOCHARDEV_OUTPUT : GPIOCHARDEV_INPUT) |
+                       ((activeLowMask & pinBit) ? GPIOCHARDEV_ACTIVE_LOW : 0);
+        groupPtr->gpioRefs[count] = gpioRef;
+        count++;
+    }
+
+    groupPtr->count = count;
+    groupPtr->pinMask = pinMask;
+    groupPtr->outputMask = outputMask & pinMask;
+    groupPtr->sessionRef = le_gpioGroup_GetClientSessionRef();
+
+    if (gpioChardev_Request(offsets, flags, count, PinsToLines(groupPtr, values), "le_gpioGroup",
+                            &groupPtr->fd) != LE_OK)
+    {
+        LE_ERROR("Unable to request GPIO group 0x%016"PRIx64, pinMask);
+        le_mem_Release(groupPtr);
+        return NULL;
+    }
+
+    // The pin services are refused while the pins are grouped
+    for (pin = 0; pin < count; pin++)
+    {
+        groupPtr->gpioRefs[pin]->inUse = true;
+    }
+
+    LE_INFO("Assigned GPIO group 0x%016"PRIx64", outputs 0x%016"PRIx64,
+            pinMask, groupPtr->outputMask);
+
+    return le_ref_CreateRef(GroupRefMap, groupPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the values of all the pins of a group at once.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER if the group reference is invalid
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gpioGroup_Read
+(
+    le_gpioGroup_GroupRef_t groupRef,   ///< [IN] Group reference
+    uint64_t* valuesPtr                 ///< [OUT] Values of the pins, bit n for pin n + 1
+)
+{
+    Group_t* groupPtr = le_ref_Lookup(GroupRefMap, groupRef);
+    uint64_t lines;
+
+    if (groupPtr == NULL)
+    {
+        LE_ERROR("Invalid group reference %p", groupRef);
+        return LE_BAD_PARAMETER;
+    }
+
+    if (gpioChardev_GetValues(groupPtr->fd, PinsToLines(groupPtr, groupPtr->pinMask), &lines)
+        != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    *valuesPtr = LinesToPins(groupPtr, lines);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Set the values of some outputs of a group at once.
+ *
+ * @return
+ *      - LE_OK on success
+ *      - LE_BAD_PARAMETER if the group reference is invalid or a pin is not an output of the group
+ *      - LE_FAULT on failure
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_gpioGroup_Write
+(
+    le_gpioGroup_GroupRef_t groupRef,   ///< [IN] Group reference
+    uint64_t mask,                      ///< [IN] Outputs to set, bit n for pin n + 1
+    uint64_t values                     ///< [IN] Values of the outputs
+)
+{
+    Group_t* groupPtr = le_ref_Lookup(GroupRefMap, groupRef);
+
+    if (groupPtr == NULL)
+    {
+        LE_ERROR("Invalid group reference %p", groupRef);
+        return LE_BAD_PARAMETER;
+    }
+
+    if (mask & ~groupPtr->outputMask)
+    {
+        LE_ERROR("Pins 0x%016"PRIx64" are not outputs of the group", mask & ~groupPtr->outputMask);
+        return LE_BAD_PARAMETER;
+    }
+
+    return gpioChardev_SetValues(groupPtr->fd, PinsToLines(groupPtr, mask),
+                                 PinsToLines(groupPtr, values));
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a group of pins. The pins keep their configuration and values.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_gpioGroup_Release
+(
+    le_gpioGroup_GroupRef_t groupRef    ///< [IN] Group reference
+)
+{
+    Group_t* groupPtr = le_ref_Lookup(GroupRefMap, groupRef);
+
+    if (groupPtr == NULL)
+    {
+        LE_KILL_CLIENT("Invalid group reference %p", groupRef);
+        return;
+    }
+
+    ReleaseGroup(groupRef, groupPtr);
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the groups and advertise the le_gpioGroup service, if the GPIO character device is
+ * used.
+ */
+//--------------------------------------------------------------------------------------------------
+void gpioGroup_Init
+(
+    const gpioSysfs_GpioRef_t* gpioRefsPtr, ///< [IN] GPIO objects, of pins 1 to count
+    size_t count,                           ///< [IN] Number of GPIO objects
+    uint64_t availableMask                  ///< [IN] Available pins, bit n for pin n + 1
+)
+{
+    LE_ASSERT(count <= GPIOCHARDEV_MAX_LINES);
+
+    if (!gpioSysfs_IsChardevUsed())
+    {
+        LE_INFO("GPIO groups need the GPIO character device, not starting the group service");
+        return;
+    }
+
+    GpioRefsPtr = gpioRefsPtr;
+    GpioRefCount = count;
+    AvailableMask = availableMask;
+
+    GroupPool = le_mem_InitStaticPool(GroupPool, MAX_GROUPS, sizeof(Group_t));
+    GroupRefMap = le_ref_InitStaticMap(GroupRefMap, MAX_GROUPS);
+
+    le_gpioGroup_AdvertiseService();
+    le_msg_AddServiceCloseHandler(le_gpioGroup_GetServiceRef(), SessionCloseHandler, NULL);
+}
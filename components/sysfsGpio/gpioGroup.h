@@ -0,0 +1,27 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Groups of GPIO pins, driven at once through the GPIO character device.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef GPIOGROUP_INCLUDE_GUARD
+#define GPIOGROUP_INCLUDE_GUARD
+
+#include "legato.h"
+#include "gpioSysfs.h"
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the groups and advertise the le_gpioGroup service, if the GPIO character device is
+ * used.
+ */
+//--------------------------------------------------------------------------------------------------
+void gpioGroup_Init
+(
+    const gpioSysfs_GpioRef_t* gpioRefsPtr, ///< [IN] GPIO objects, of pins 1 to count
+    size_t count,                           ///< [IN] Number of GPIO objects
+    uint64_t availableMask                  ///< [IN] Available pins, bit n for pin n + 1
+);
+
+#endif // GPIOGROUP_INCLUDE_GUARD
@@ -13,6 +13,7 @@
 #include "legato.h"
 #include "interfaces.h"
 #include "gpioSysfs.h"
+#include "gpioGroup.h"
 #include "watchdogChain.h"
 
 //--------------------------------------------------------------------------------------------------
@@ -29,7 +30,7 @@
 //--------------------------------------------------------------------------------------------------
 #define MS_WDOG_INTERVAL 8
 
-static struct gpioSysfs_Gpio SysfsGpioPin1 = {1,"gpio1",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin1 = {1,"gpio1",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin1 = &SysfsGpioPin1;
 
 void gpioPin1_InputMonitorHandlerFunc (int fd, short events)
@@ -163,7 +164,7 @@ le_result_t le_gpioPin1_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin2 = {2,"gpio2",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin2 = {2,"gpio2",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin2 = &SysfsGpioPin2;
 
 void gpioPin2_InputMonitorHandlerFunc (int fd, short events)
@@ -297,7 +298,7 @@ le_result_t le_gpioPin2_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin3 = {3,"gpio3",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin3 = {3,"gpio3",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin3 = &SysfsGpioPin3;
 
 void gpioPin3_InputMonitorHandlerFunc (int fd, short events)
@@ -431,7 +432,7 @@ le_result_t le_gpioPin3_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin4 = {4,"gpio4",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin4 = {4,"gpio4",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin4 = &SysfsGpioPin4;
 
 void gpioPin4_InputMonitorHandlerFunc (int fd, short events)
@@ -565,7 +566,7 @@ le_result_t le_gpioPin4_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin5 = {5,"gpio5",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin5 = {5,"gpio5",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin5 = &SysfsGpioPin5;
 
 void gpioPin5_InputMonitorHandlerFunc (int fd, short events)
@@ -699,7 +700,7 @@ le_result_t le_gpioPin5_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin6 = {6,"gpio6",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin6 = {6,"gpio6",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin6 = &SysfsGpioPin6;
 
 void gpioPin6_InputMonitorHandlerFunc (int fd, short events)
@@ -833,7 +834,7 @@ le_result_t le_gpioPin6_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin7 = {7,"gpio7",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin7 = {7,"gpio7",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin7 = &SysfsGpioPin7;
 
 void gpioPin7_InputMonitorHandlerFunc (int fd, short events)
@@ -967,7 +968,7 @@ le_result_t le_gpioPin7_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin8 = {8,"gpio8",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin8 = {8,"gpio8",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin8 = &SysfsGpioPin8;
 
 void gpioPin8_InputMonitorHandlerFunc (int fd, short events)
@@ -1101,7 +1102,7 @@ le_result_t le_gpioPin8_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin9 = {9,"gpio9",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin9 = {9,"gpio9",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin9 = &SysfsGpioPin9;
 
 void gpioPin9_InputMonitorHandlerFunc (int fd, short events)
@@ -1235,7 +1236,7 @@ le_result_t le_gpioPin9_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin10 = {10,"gpio10",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin10 = {10,"gpio10",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin10 = &SysfsGpioPin10;
 
 void gpioPin10_InputMonitorHandlerFunc (int fd, short events)
@@ -1369,7 +1370,7 @@ le_result_t le_gpioPin10_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin11 = {11,"gpio11",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin11 = {11,"gpio11",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin11 = &SysfsGpioPin11;
 
 void gpioPin11_InputMonitorHandlerFunc (int fd, short events)
@@ -1503,7 +1504,7 @@ le_result_t le_gpioPin11_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin12 = {12,"gpio12",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin12 = {12,"gpio12",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin12 = &SysfsGpioPin12;
 
 void gpioPin12_InputMonitorHandlerFunc (int fd, short events)
@@ -1637,7 +1638,7 @@ le_result_t le_gpioPin12_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin13 = {13,"gpio13",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin13 = {13,"gpio13",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin13 = &SysfsGpioPin13;
 
 void gpioPin13_InputMonitorHandlerFunc (int fd, short events)
@@ -1771,7 +1772,7 @@ le_result_t le_gpioPin13_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin14 = {14,"gpio14",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin14 = {14,"gpio14",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin14 = &SysfsGpioPin14;
 
 void gpioPin14_InputMonitorHandlerFunc (int fd, short events)
@@ -1905,7 +1906,7 @@ le_result_t le_gpioPin14_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin15 = {15,"gpio15",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin15 = {15,"gpio15",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin15 = &SysfsGpioPin15;
 
 void gpioPin15_InputMonitorHandlerFunc (int fd, short events)
@@ -2039,7 +2040,7 @@ le_result_t le_gpioPin15_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin16 = {16,"gpio16",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin16 = {16,"gpio16",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin16 = &SysfsGpioPin16;
 
 void gpioPin16_InputMonitorHandlerFunc (int fd, short events)
@@ -2173,7 +2174,7 @@ le_result_t le_gpioPin16_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin17 = {17,"gpio17",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin17 = {17,"gpio17",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin17 = &SysfsGpioPin17;
 
 void gpioPin17_InputMonitorHandlerFunc (int fd, short events)
@@ -2307,7 +2308,7 @@ le_result_t le_gpioPin17_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin18 = {18,"gpio18",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin18 = {18,"gpio18",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin18 = &SysfsGpioPin18;
 
 void gpioPin18_InputMonitorHandlerFunc (int fd, short events)
@@ -2441,7 +2442,7 @@ le_result_t le_gpioPin18_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin19 = {19,"gpio19",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin19 = {19,"gpio19",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin19 = &SysfsGpioPin19;
 
 void gpioPin19_InputMonitorHandlerFunc (int fd, short events)
@@ -2575,7 +2576,7 @@ le_result_t le_gpioPin19_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin20 = {20,"gpio20",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin20 = {20,"gpio20",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin20 = &SysfsGpioPin20;
 
 void gpioPin20_InputMonitorHandlerFunc (int fd, short events)
@@ -2709,7 +2710,7 @@ le_result_t le_gpioPin20_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin21 = {21,"gpio21",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin21 = {21,"gpio21",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin21 = &SysfsGpioPin21;
 
 void gpioPin21_InputMonitorHandlerFunc (int fd, short events)
@@ -2843,7 +2844,7 @@ le_result_t le_gpioPin21_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin22 = {22,"gpio22",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin22 = {22,"gpio22",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin22 = &SysfsGpioPin22;
 
 void gpioPin22_InputMonitorHandlerFunc (int fd, short events)
@@ -2977,7 +2978,7 @@ le_result_t le_gpioPin22_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin23 = {23,"gpio23",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin23 = {23,"gpio23",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin23 = &SysfsGpioPin23;
 
 void gpioPin23_InputMonitorHandlerFunc (int fd, short events)
@@ -3111,7 +3112,7 @@ le_result_t le_gpioPin23_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin24 = {24,"gpio24",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin24 = {24,"gpio24",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin24 = &SysfsGpioPin24;
 
 void gpioPin24_InputMonitorHandlerFunc (int fd, short events)
@@ -3245,7 +3246,7 @@ le_result_t le_gpioPin24_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin25 = {25,"gpio25",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin25 = {25,"gpio25",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin25 = &SysfsGpioPin25;
 
 void gpioPin25_InputMonitorHandlerFunc (int fd, short events)
@@ -3379,7 +3380,7 @@ le_result_t le_gpioPin25_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin26 = {26,"gpio26",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin26 = {26,"gpio26",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin26 = &SysfsGpioPin26;
 
 void gpioPin26_InputMonitorHandlerFunc (int fd, short events)
@@ -3513,7 +3514,7 @@ le_result_t le_gpioPin26_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin27 = {27,"gpio27",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin27 = {27,"gpio27",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin27 = &SysfsGpioPin27;
 
 void gpioPin27_InputMonitorHandlerFunc (int fd, short events)
@@ -3647,7 +3648,7 @@ le_result_t le_gpioPin27_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin28 = {28,"gpio28",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin28 = {28,"gpio28",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin28 = &SysfsGpioPin28;
 
 void gpioPin28_InputMonitorHandlerFunc (int fd, short events)
@@ -3781,7 +3782,7 @@ le_result_t le_gpioPin28_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin29 = {29,"gpio29",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin29 = {29,"gpio29",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin29 = &SysfsGpioPin29;
 
 void gpioPin29_InputMonitorHandlerFunc (int fd, short events)
@@ -3915,7 +3916,7 @@ le_result_t le_gpioPin29_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin30 = {30,"gpio30",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin30 = {30,"gpio30",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin30 = &SysfsGpioPin30;
 
 void gpioPin30_InputMonitorHandlerFunc (int fd, short events)
@@ -4049,7 +4050,7 @@ le_result_t le_gpioPin30_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin31 = {31,"gpio31",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin31 = {31,"gpio31",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin31 = &SysfsGpioPin31;
 
 void gpioPin31_InputMonitorHandlerFunc (int fd, short events)
@@ -4183,7 +4184,7 @@ le_result_t le_gpioPin31_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin32 = {32,"gpio32",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin32 = {32,"gpio32",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin32 = &SysfsGpioPin32;
 
 void gpioPin32_InputMonitorHandlerFunc (int fd, short events)
@@ -4317,7 +4318,7 @@ le_result_t le_gpioPin32_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin33 = {33,"gpio33",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin33 = {33,"gpio33",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin33 = &SysfsGpioPin33;
 
 void gpioPin33_InputMonitorHandlerFunc (int fd, short events)
@@ -4451,7 +4452,7 @@ le_result_t le_gpioPin33_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin34 = {34,"gpio34",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin34 = {34,"gpio34",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin34 = &SysfsGpioPin34;
 
 void gpioPin34_InputMonitorHandlerFunc (int fd, short events)
@@ -4585,7 +4586,7 @@ le_result_t le_gpioPin34_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin35 = {35,"gpio35",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin35 = {35,"gpio35",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin35 = &SysfsGpioPin35;
 
 void gpioPin35_InputMonitorHandlerFunc (int fd, short events)
@@ -4719,7 +4720,7 @@ le_result_t le_gpioPin35_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin36 = {36,"gpio36",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin36 = {36,"gpio36",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin36 = &SysfsGpioPin36;
 
 void gpioPin36_InputMonitorHandlerFunc (int fd, short events)
@@ -4853,7 +4854,7 @@ le_result_t le_gpioPin36_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin37 = {37,"gpio37",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin37 = {37,"gpio37",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin37 = &SysfsGpioPin37;
 
 void gpioPin37_InputMonitorHandlerFunc (int fd, short events)
@@ -4987,7 +4988,7 @@ le_result_t le_gpioPin37_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin38 = {38,"gpio38",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin38 = {38,"gpio38",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin38 = &SysfsGpioPin38;
 
 void gpioPin38_InputMonitorHandlerFunc (int fd, short events)
@@ -5121,7 +5122,7 @@ le_result_t le_gpioPin38_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin39 = {39,"gpio39",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin39 = {39,"gpio39",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin39 = &SysfsGpioPin39;
 
 void gpioPin39_InputMonitorHandlerFunc (int fd, short events)
@@ -5255,7 +5256,7 @@ le_result_t le_gpioPin39_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin40 = {40,"gpio40",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin40 = {40,"gpio40",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin40 = &SysfsGpioPin40;
 
 void gpioPin40_InputMonitorHandlerFunc (int fd, short events)
@@ -5389,7 +5390,7 @@ le_result_t le_gpioPin40_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin41 = {41,"gpio41",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin41 = {41,"gpio41",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin41 = &SysfsGpioPin41;
 
 void gpioPin41_InputMonitorHandlerFunc (int fd, short events)
@@ -5523,7 +5524,7 @@ le_result_t le_gpioPin41_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin42 = {42,"gpio42",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin42 = {42,"gpio42",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin42 = &SysfsGpioPin42;
 
 void gpioPin42_InputMonitorHandlerFunc (int fd, short events)
@@ -5657,7 +5658,7 @@ le_result_t le_gpioPin42_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin43 = {43,"gpio43",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin43 = {43,"gpio43",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin43 = &SysfsGpioPin43;
 
 void gpioPin43_InputMonitorHandlerFunc (int fd, short events)
@@ -5791,7 +5792,7 @@ le_result_t le_gpioPin43_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin44 = {44,"gpio44",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin44 = {44,"gpio44",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin44 = &SysfsGpioPin44;
 
 void gpioPin44_InputMonitorHandlerFunc (int fd, short events)
@@ -5925,7 +5926,7 @@ le_result_t le_gpioPin44_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin45 = {45,"gpio45",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin45 = {45,"gpio45",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin45 = &SysfsGpioPin45;
 
 void gpioPin45_InputMonitorHandlerFunc (int fd, short events)
@@ -6059,7 +6060,7 @@ le_result_t le_gpioPin45_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin46 = {46,"gpio46",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin46 = {46,"gpio46",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin46 = &SysfsGpioPin46;
 
 void gpioPin46_InputMonitorHandlerFunc (int fd, short events)
@@ -6193,7 +6194,7 @@ le_result_t le_gpioPin46_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin47 = {47,"gpio47",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin47 = {47,"gpio47",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin47 = &SysfsGpioPin47;
 
 void gpioPin47_InputMonitorHandlerFunc (int fd, short events)
@@ -6327,7 +6328,7 @@ le_result_t le_gpioPin47_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin48 = {48,"gpio48",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin48 = {48,"gpio48",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin48 = &SysfsGpioPin48;
 
 void gpioPin48_InputMonitorHandlerFunc (int fd, short events)
@@ -6461,7 +6462,7 @@ le_result_t le_gpioPin48_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin49 = {49,"gpio49",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin49 = {49,"gpio49",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin49 = &SysfsGpioPin49;
 
 void gpioPin49_InputMonitorHandlerFunc (int fd, short events)
@@ -6595,7 +6596,7 @@ le_result_t le_gpioPin49_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin50 = {50,"gpio50",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin50 = {50,"gpio50",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin50 = &SysfsGpioPin50;
 
 void gpioPin50_InputMonitorHandlerFunc (int fd, short events)
@@ -6729,7 +6730,7 @@ le_result_t le_gpioPin50_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin51 = {51,"gpio51",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin51 = {51,"gpio51",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin51 = &SysfsGpioPin51;
 
 void gpioPin51_InputMonitorHandlerFunc (int fd, short events)
@@ -6863,7 +6864,7 @@ le_result_t le_gpioPin51_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin52 = {52,"gpio52",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin52 = {52,"gpio52",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin52 = &SysfsGpioPin52;
 
 void gpioPin52_InputMonitorHandlerFunc (int fd, short events)
@@ -6997,7 +6998,7 @@ le_result_t le_gpioPin52_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin53 = {53,"gpio53",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin53 = {53,"gpio53",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin53 = &SysfsGpioPin53;
 
 void gpioPin53_InputMonitorHandlerFunc (int fd, short events)
@@ -7131,7 +7132,7 @@ le_result_t le_gpioPin53_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin54 = {54,"gpio54",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin54 = {54,"gpio54",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin54 = &SysfsGpioPin54;
 
 void gpioPin54_InputMonitorHandlerFunc (int fd, short events)
@@ -7265,7 +7266,7 @@ le_result_t le_gpioPin54_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin55 = {55,"gpio55",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin55 = {55,"gpio55",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin55 = &SysfsGpioPin55;
 
 void gpioPin55_InputMonitorHandlerFunc (int fd, short events)
@@ -7399,7 +7400,7 @@ le_result_t le_gpioPin55_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin56 = {56,"gpio56",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin56 = {56,"gpio56",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin56 = &SysfsGpioPin56;
 
 void gpioPin56_InputMonitorHandlerFunc (int fd, short events)
@@ -7533,7 +7534,7 @@ le_result_t le_gpioPin56_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin57 = {57,"gpio57",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin57 = {57,"gpio57",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin57 = &SysfsGpioPin57;
 
 void gpioPin57_InputMonitorHandlerFunc (int fd, short events)
@@ -7667,7 +7668,7 @@ le_result_t le_gpioPin57_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin58 = {58,"gpio58",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin58 = {58,"gpio58",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin58 = &SysfsGpioPin58;
 
 void gpioPin58_InputMonitorHandlerFunc (int fd, short events)
@@ -7801,7 +7802,7 @@ le_result_t le_gpioPin58_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin59 = {59,"gpio59",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin59 = {59,"gpio59",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin59 = &SysfsGpioPin59;
 
 void gpioPin59_InputMonitorHandlerFunc (int fd, short events)
@@ -7935,7 +7936,7 @@ le_result_t le_gpioPin59_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin60 = {60,"gpio60",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin60 = {60,"gpio60",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin60 = &SysfsGpioPin60;
 
 void gpioPin60_InputMonitorHandlerFunc (int fd, short events)
@@ -8069,7 +8070,7 @@ le_result_t le_gpioPin60_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin61 = {61,"gpio61",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin61 = {61,"gpio61",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin61 = &SysfsGpioPin61;
 
 void gpioPin61_InputMonitorHandlerFunc (int fd, short events)
@@ -8203,7 +8204,7 @@ le_result_t le_gpioPin61_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin62 = {62,"gpio62",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin62 = {62,"gpio62",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin62 = &SysfsGpioPin62;
 
 void gpioPin62_InputMonitorHandlerFunc (int fd, short events)
@@ -8337,7 +8338,7 @@ le_result_t le_gpioPin62_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin63 = {63,"gpio63",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin63 = {63,"gpio63",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin63 = &SysfsGpioPin63;
 
 void gpioPin63_InputMonitorHandlerFunc (int fd, short events)
@@ -8471,7 +8472,7 @@ le_result_t le_gpioPin63_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
-static struct gpioSysfs_Gpio SysfsGpioPin64 = {64,"gpio64",false,NULL,NULL,NULL,NULL};
+static struct gpioSysfs_Gpio SysfsGpioPin64 = {64,"gpio64",false,NULL,NULL,NULL,NULL,false,-1,0};
 static gpioSysfs_GpioRef_t gpioRefPin64 = &SysfsGpioPin64;
 
 void gpioPin64_InputMonitorHandlerFunc (int fd, short events)
@@ -8598,6 +8599,79 @@ le_result_t le_gpioPin64_DisableEdgeSense (void)
  */
 //--------------------------------------------------------------------------------------------------
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * GPIO objects of all the pins, pin n + 1 being at index n.
+ */
+//--------------------------------------------------------------------------------------------------
+static const gpioSysfs_GpioRef_t GpioRefs[] =
+{
+    &SysfsGpioPin1,
+    &SysfsGpioPin2,
+    &SysfsGpioPin3,
+    &SysfsGpioPin4,
+    &SysfsGpioPin5,
+    &SysfsGpioPin6,
+    &SysfsGpioPin7,
+    &SysfsGpioPin8,
+    &SysfsGpioPin9,
+    &SysfsGpioPin10,
+    &SysfsGpioPin11,
+    &SysfsGpioPin12,
+    &SysfsGpioPin13,
+    &SysfsGpioPin14,
+    &SysfsGpioPin15,
+    &SysfsGpioPin16,
+    &SysfsGpioPin17,
+    &SysfsGpioPin18,
+    &SysfsGpioPin19,
+    &SysfsGpioPin20,
+    &SysfsGpioPin21,
+    &SysfsGpioPin22,
+    &SysfsGpioPin23,
+    &SysfsGpioPin24,
+    &SysfsGpioPin25,
+    &SysfsGpioPin26,
+    &SysfsGpioPin27,
+    &SysfsGpioPin28,
+    &SysfsGpioPin29,
+    &SysfsGpioPin30,
+    &SysfsGpioPin31,
+    &SysfsGpioPin32,
+    &SysfsGpioPin33,
+    &SysfsGpioPin34,
+    &SysfsGpioPin35,
+    &SysfsGpioPin36,
+    &SysfsGpioPin37,
+    &SysfsGpioPin38,
+    &SysfsGpioPin39,
+    &SysfsGpioPin40,
+    &SysfsGpioPin41,
+    &SysfsGpioPin42,
+    &SysfsGpioPin43,
+    &SysfsGpioPin44,
+    &SysfsGpioPin45,
+    &SysfsGpioPin46,
+    &SysfsGpioPin47,
+    &SysfsGpioPin48,
+    &SysfsGpioPin49,
+    &SysfsGpioPin50,
+    &SysfsGpioPin51,
+    &SysfsGpioPin52,
+    &SysfsGpioPin53,
+    &SysfsGpioPin54,
+    &SysfsGpioPin55,
+    &SysfsGpioPin56,
+    &SysfsGpioPin57,
+    &SysfsGpioPin58,
+    &SysfsGpioPin59,
+    &SysfsGpioPin60,
+    &SysfsGpioPin61,
+    &SysfsGpioPin62,
+    &SysfsGpioPin63,
+    &SysfsGpioPin64,
+};
+
 //--------------------------------------------------------------------------------------------------
 /**
  * "Global" functions - that apply to whole GPIO functionality, not just
@@ -8663,6 +8737,7 @@ le_result_t le_gpioCfg_GetSupportedGpioList
 COMPONENT_INIT
 {
     gpioSysfs_Design_t gpioDesign = SYSFS_GPIO_DESIGN_V1;
+    uint64_t availableMask = 0;
 
     gpioSysfs_Initialize(&gpioDesign);
 
@@ -8738,6 +8813,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(1) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/1", false))
     {
         LE_INFO("Starting GPIO Service for Pin 1");
+        availableMask |= (uint64_t)1 << 0;
         le_gpioPin1_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin1_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8755,6 +8831,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(2) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/2", false))
     {
         LE_INFO("Starting GPIO Service for Pin 2");
+        availableMask |= (uint64_t)1 << 1;
         le_gpioPin2_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin2_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8772,6 +8849,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(3) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/3", false))
     {
         LE_INFO("Starting GPIO Service for Pin 3");
+        availableMask |= (uint64_t)1 << 2;
         le_gpioPin3_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin3_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8789,6 +8867,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(4) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/4", false))
     {
         LE_INFO("Starting GPIO Service for Pin 4");
+        availableMask |= (uint64_t)1 << 3;
         le_gpioPin4_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin4_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8806,6 +8885,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(5) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/5", false))
     {
         LE_INFO("Starting GPIO Service for Pin 5");
+        availableMask |= (uint64_t)1 << 4;
         le_gpioPin5_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin5_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8823,6 +8903,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(6) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/6", false))
     {
         LE_INFO("Starting GPIO Service for Pin 6");
+        availableMask |= (uint64_t)1 << 5;
         le_gpioPin6_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin6_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8840,6 +8921,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(7) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/7", false))
     {
         LE_INFO("Starting GPIO Service for Pin 7");
+        availableMask |= (uint64_t)1 << 6;
         le_gpioPin7_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin7_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8857,6 +8939,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(8) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/8", false))
     {
         LE_INFO("Starting GPIO Service for Pin 8");
+        availableMask |= (uint64_t)1 << 7;
         le_gpioPin8_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin8_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8874,6 +8957,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(9) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/9", false))
     {
         LE_INFO("Starting GPIO Service for Pin 9");
+        availableMask |= (uint64_t)1 << 8;
         le_gpioPin9_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin9_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8891,6 +8975,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(10) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/10", false))
     {
         LE_INFO("Starting GPIO Service for Pin 10");
+        availableMask |= (uint64_t)1 << 9;
         le_gpioPin10_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin10_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8908,6 +8993,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(11) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/11", false))
     {
         LE_INFO("Starting GPIO Service for Pin 11");
+        availableMask |= (uint64_t)1 << 10;
         le_gpioPin11_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin11_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8925,6 +9011,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(12) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/12", false))
     {
         LE_INFO("Starting GPIO Service for Pin 12");
+        availableMask |= (uint64_t)1 << 11;
         le_gpioPin12_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin12_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8942,6 +9029,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(13) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/13", false))
     {
         LE_INFO("Starting GPIO Service for Pin 13");
+        availableMask |= (uint64_t)1 << 12;
         le_gpioPin13_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin13_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8959,6 +9047,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(14) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/14", false))
     {
         LE_INFO("Starting GPIO Service for Pin 14");
+        availableMask |= (uint64_t)1 << 13;
         le_gpioPin14_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin14_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8976,6 +9065,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(15) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/15", false))
     {
         LE_INFO("Starting GPIO Service for Pin 15");
+        availableMask |= (uint64_t)1 << 14;
         le_gpioPin15_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin15_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -8993,6 +9083,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(16) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/16", false))
     {
         LE_INFO("Starting GPIO Service for Pin 16");
+        availableMask |= (uint64_t)1 << 15;
         le_gpioPin16_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin16_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9010,6 +9101,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(17) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/17", false))
     {
         LE_INFO("Starting GPIO Service for Pin 17");
+        availableMask |= (uint64_t)1 << 16;
         le_gpioPin17_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin17_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9027,6 +9119,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(18) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/18", false))
     {
         LE_INFO("Starting GPIO Service for Pin 18");
+        availableMask |= (uint64_t)1 << 17;
         le_gpioPin18_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin18_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9044,6 +9137,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(19) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/19", false))
     {
         LE_INFO("Starting GPIO Service for Pin 19");
+        availableMask |= (uint64_t)1 << 18;
         le_gpioPin19_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin19_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9061,6 +9155,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(20) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/20", false))
     {
         LE_INFO("Starting GPIO Service for Pin 20");
+        availableMask |= (uint64_t)1 << 19;
         le_gpioPin20_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin20_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9078,6 +9173,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(21) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/21", false))
     {
         LE_INFO("Starting GPIO Service for Pin 21");
+        availableMask |= (uint64_t)1 << 20;
         le_gpioPin21_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin21_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9095,6 +9191,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(22) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/22", false))
     {
         LE_INFO("Starting GPIO Service for Pin 22");
+        availableMask |= (uint64_t)1 << 21;
         le_gpioPin22_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin22_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9112,6 +9209,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(23) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/23", false))
     {
         LE_INFO("Starting GPIO Service for Pin 23");
+        availableMask |= (uint64_t)1 << 22;
         le_gpioPin23_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin23_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9129,6 +9227,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(24) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/24", false))
     {
         LE_INFO("Starting GPIO Service for Pin 24");
+        availableMask |= (uint64_t)1 << 23;
         le_gpioPin24_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin24_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9146,6 +9245,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(25) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/25", false))
     {
         LE_INFO("Starting GPIO Service for Pin 25");
+        availableMask |= (uint64_t)1 << 24;
         le_gpioPin25_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin25_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9163,6 +9263,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(26) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/26", false))
     {
         LE_INFO("Starting GPIO Service for Pin 26");
+        availableMask |= (uint64_t)1 << 25;
         le_gpioPin26_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin26_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9180,6 +9281,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(27) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/27", false))
     {
         LE_INFO("Starting GPIO Service for Pin 27");
+        availableMask |= (uint64_t)1 << 26;
         le_gpioPin27_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin27_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9197,6 +9299,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(28) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/28", false))
     {
         LE_INFO("Starting GPIO Service for Pin 28");
+        availableMask |= (uint64_t)1 << 27;
         le_gpioPin28_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin28_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9214,6 +9317,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(29) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/29", false))
     {
         LE_INFO("Starting GPIO Service for Pin 29");
+        availableMask |= (uint64_t)1 << 28;
         le_gpioPin29_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin29_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9231,6 +9335,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(30) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/30", false))
     {
         LE_INFO("Starting GPIO Service for Pin 30");
+        availableMask |= (uint64_t)1 << 29;
         le_gpioPin30_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin30_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9248,6 +9353,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(31) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/31", false))
     {
         LE_INFO("Starting GPIO Service for Pin 31");
+        availableMask |= (uint64_t)1 << 30;
         le_gpioPin31_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin31_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9265,6 +9371,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(32) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/32", false))
     {
         LE_INFO("Starting GPIO Service for Pin 32");
+        availableMask |= (uint64_t)1 << 31;
         le_gpioPin32_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin32_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9282,6 +9389,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(33) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/33", false))
     {
         LE_INFO("Starting GPIO Service for Pin 33");
+        availableMask |= (uint64_t)1 << 32;
         le_gpioPin33_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin33_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9299,6 +9407,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(34) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/34", false))
     {
         LE_INFO("Starting GPIO Service for Pin 34");
+        availableMask |= (uint64_t)1 << 33;
         le_gpioPin34_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin34_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9316,6 +9425,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(35) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/35", false))
     {
         LE_INFO("Starting GPIO Service for Pin 35");
+        availableMask |= (uint64_t)1 << 34;
         le_gpioPin35_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin35_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9333,6 +9443,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(36) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/36", false))
     {
         LE_INFO("Starting GPIO Service for Pin 36");
+        availableMask |= (uint64_t)1 << 35;
         le_gpioPin36_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin36_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9350,6 +9461,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(37) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/37", false))
     {
         LE_INFO("Starting GPIO Service for Pin 37");
+        availableMask |= (uint64_t)1 << 36;
         le_gpioPin37_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin37_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9367,6 +9479,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(38) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/38", false))
     {
         LE_INFO("Starting GPIO Service for Pin 38");
+        availableMask |= (uint64_t)1 << 37;
         le_gpioPin38_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin38_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9384,6 +9497,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(39) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/39", false))
     {
         LE_INFO("Starting GPIO Service for Pin 39");
+        availableMask |= (uint64_t)1 << 38;
         le_gpioPin39_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin39_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9401,6 +9515,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(40) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/40", false))
     {
         LE_INFO("Starting GPIO Service for Pin 40");
+        availableMask |= (uint64_t)1 << 39;
         le_gpioPin40_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin40_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9418,6 +9533,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(41) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/41", false))
     {
         LE_INFO("Starting GPIO Service for Pin 41");
+        availableMask |= (uint64_t)1 << 40;
         le_gpioPin41_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin41_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9435,6 +9551,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(42) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/42", false))
     {
         LE_INFO("Starting GPIO Service for Pin 42");
+        availableMask |= (uint64_t)1 << 41;
         le_gpioPin42_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin42_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9452,6 +9569,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(43) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/43", false))
     {
         LE_INFO("Starting GPIO Service for Pin 43");
+        availableMask |= (uint64_t)1 << 42;
         le_gpioPin43_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin43_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9469,6 +9587,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(44) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/44", false))
     {
         LE_INFO("Starting GPIO Service for Pin 44");
+        availableMask |= (uint64_t)1 << 43;
         le_gpioPin44_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin44_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9486,6 +9605,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(45) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/45", false))
     {
         LE_INFO("Starting GPIO Service for Pin 45");
+        availableMask |= (uint64_t)1 << 44;
         le_gpioPin45_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin45_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9503,6 +9623,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(46) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/46", false))
     {
         LE_INFO("Starting GPIO Service for Pin 46");
+        availableMask |= (uint64_t)1 << 45;
         le_gpioPin46_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin46_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9520,6 +9641,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(47) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/47", false))
     {
         LE_INFO("Starting GPIO Service for Pin 47");
+        availableMask |= (uint64_t)1 << 46;
         le_gpioPin47_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin47_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9537,6 +9659,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(48) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/48", false))
     {
         LE_INFO("Starting GPIO Service for Pin 48");
+        availableMask |= (uint64_t)1 << 47;
         le_gpioPin48_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin48_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9554,6 +9677,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(49) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/49", false))
     {
         LE_INFO("Starting GPIO Service for Pin 49");
+        availableMask |= (uint64_t)1 << 48;
         le_gpioPin49_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin49_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9571,6 +9695,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(50) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/50", false))
     {
         LE_INFO("Starting GPIO Service for Pin 50");
+        availableMask |= (uint64_t)1 << 49;
         le_gpioPin50_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin50_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9588,6 +9713,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(51) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/51", false))
     {
         LE_INFO("Starting GPIO Service for Pin 51");
+        availableMask |= (uint64_t)1 << 50;
         le_gpioPin51_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin51_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9605,6 +9731,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(52) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/52", false))
     {
         LE_INFO("Starting GPIO Service for Pin 52");
+        availableMask |= (uint64_t)1 << 51;
         le_gpioPin52_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin52_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9622,6 +9749,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(53) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/53", false))
     {
         LE_INFO("Starting GPIO Service for Pin 53");
+        availableMask |= (uint64_t)1 << 52;
         le_gpioPin53_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin53_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9639,6 +9767,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(54) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/54", false))
     {
         LE_INFO("Starting GPIO Service for Pin 54");
+        availableMask |= (uint64_t)1 << 53;
         le_gpioPin54_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin54_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9656,6 +9785,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(55) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/55", false))
     {
         LE_INFO("Starting GPIO Service for Pin 55");
+        availableMask |= (uint64_t)1 << 54;
         le_gpioPin55_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin55_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9673,6 +9803,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(56) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/56", false))
     {
         LE_INFO("Starting GPIO Service for Pin 56");
+        availableMask |= (uint64_t)1 << 55;
         le_gpioPin56_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin56_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9690,6 +9821,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(57) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/57", false))
     {
         LE_INFO("Starting GPIO Service for Pin 57");
+        availableMask |= (uint64_t)1 << 56;
         le_gpioPin57_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin57_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9707,6 +9839,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(58) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/58", false))
     {
         LE_INFO("Starting GPIO Service for Pin 58");
+        availableMask |= (uint64_t)1 << 57;
         le_gpioPin58_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin58_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9724,6 +9857,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(59) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/59", false))
     {
         LE_INFO("Starting GPIO Service for Pin 59");
+        availableMask |= (uint64_t)1 << 58;
         le_gpioPin59_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin59_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9741,6 +9875,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(60) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/60", false))
     {
         LE_INFO("Starting GPIO Service for Pin 60");
+        availableMask |= (uint64_t)1 << 59;
         le_gpioPin60_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin60_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9758,6 +9893,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(61) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/61", false))
     {
         LE_INFO("Starting GPIO Service for Pin 61");
+        availableMask |= (uint64_t)1 << 60;
         le_gpioPin61_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin61_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9775,6 +9911,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(62) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/62", false))
     {
         LE_INFO("Starting GPIO Service for Pin 62");
+        availableMask |= (uint64_t)1 << 61;
         le_gpioPin62_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin62_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9792,6 +9929,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(63) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/63", false))
     {
         LE_INFO("Starting GPIO Service for Pin 63");
+        availableMask |= (uint64_t)1 << 62;
         le_gpioPin63_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin63_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9809,6 +9947,7 @@ COMPONENT_INIT
     if (gpioSysfs_IsPinAvailable(64) && !le_cfg_QuickGetBool("gpioService:/pins/disabled/64", false))
     {
         LE_INFO("Starting GPIO Service for Pin 64");
+        availableMask |= (uint64_t)1 << 63;
         le_gpioPin64_AdvertiseService();
         le_msg_AddServiceOpenHandler(le_gpioPin64_GetServiceRef(),
                                      gpioSysfs_SessionOpenHandlerFunc,
@@ -9822,6 +9961,9 @@ COMPONENT_INIT
         LE_INFO("Skipping starting GPIO Service for Pin 64 - pin not available or disabled by config");
     }
 
+    // Create the group service, for the available pins
+    gpioGroup_Init(GpioRefs, NUM_ARRAY_MEMBERS(GpioRefs), availableMask);
+
     // Begin monitoring main event loop
     // Try to kick a couple of times before each timeout.
     le_clk_Time_t watchdogInterval = { .sec = MS_WDOG_INTERVAL };
@@ -453,6 +453,7 @@ bool gpioSysfs_IsPinAvailable
  * Initialize the GPIO sys fs and return the GPIO design found:
  *   - SYSFS_GPIO_DESIGN_V2 if /sys/class/gpio/v2/alias_export exists and is writable,
  *   - SYSFS_GPIO_DESIGN_V1 else.
+ * The GPIO character device is then opened, if available.
  */
 //--------------------------------------------------------------------------------------------------
 void gpioSysfs_Initialize
@@ -460,6 +461,33 @@ void gpioSysfs_Initialize
     gpioSysfs_Design_t* gpioDesignPtr    ///< [OUT] Current GPIO design for sysfs
 );
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if the pins are driven through the GPIO character device.
+ *
+ * @return true if the GPIO character device is used, false if only the sysfs is.
+ */
+//--------------------------------------------------------------------------------------------------
+bool gpioSysfs_IsChardevUsed
+(
+    void
+);
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the offset of the line of a pin in the GPIO chip.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_UNSUPPORTED if the pin is not driven through the GPIO character device
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_GetLineOffset
+(
+    gpioSysfs_GpioRef_t gpioRef,        ///< [IN] GPIO object reference
+    uint32_t* offsetPtr                 ///< [OUT] Line offset
+);
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The struct of Sysfs object
@@ -473,6 +501,9 @@ struct gpioSysfs_Gpio {
     void *callbackContextPtr;                     ///< Client context to be passed back
     le_fdMonitor_Ref_t fdMonitor;                 ///< fdMonitor Object associated to this GPIO
     le_msg_SessionRef_t currentSession;           ///< Current valid IPC session for this pin
+    bool hasLine;                                 ///< Is the pin driven through a line request?
+    int lineFd;                                   ///< Line request of the GPIO character device
+    uint32_t lineFlags;                           ///< Current GPIOCHARDEV_ flags of the line
 };
 
 
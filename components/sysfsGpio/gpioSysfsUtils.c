@@ -12,6 +12,7 @@
 #include "legato.h"
 #include "interfaces.h"
 #include "gpioSysfs.h"
+#include "gpioChardev.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -23,6 +24,18 @@
 #define SYSFS_GPIO_ALIAS_PREFIX   "/v2/alias_"
 #define SYSFS_GPIO_ALIASES_PATH   "/v2/aliases_exported/"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Configuration of the GPIO character device:
+ * - disabled: the pins are only driven through the sysfs
+ * - chip: character device of the GPIO chip, found from the sysfs by default
+ * - base: pin number of the first line of the chip, when the chip is configured
+ */
+//--------------------------------------------------------------------------------------------------
+#define CFG_CHARDEV_DISABLED      "gpioService:/chardev/disabled"
+#define CFG_CHARDEV_CHIP          "gpioService:/chardev/chip"
+#define CFG_CHARDEV_BASE          "gpioService:/chardev/base"
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Max and Min Pin Numbers
@@ -46,6 +59,20 @@ static char GpioAliasesPath[sizeof(SYSFS_GPIO_ALIASES_PATH) + 1];
 //--------------------------------------------------------------------------------------------------
 static gpioSysfs_Design_t GpioDesign = SYSFS_GPIO_DESIGN_V1;
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Are the pins driven through the GPIO character device?
+ */
+//--------------------------------------------------------------------------------------------------
+static bool UseChardev = false;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pin number of the first line of the GPIO chip.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t ChardevBase = MIN_PIN_NUMBER;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Remove the change callback for the given GPIO
@@ -63,8 +90,14 @@ static void RemoveChangeCallback
         const int fd = le_fdMonitor_GetFd(gpioRef->fdMonitor);
         le_fdMonitor_Delete(gpioRef->fdMonitor);
         gpioRef->fdMonitor = NULL;
-        const int ret = close(fd);
-        LE_WARN_IF(ret == -1, "Failed to close file descriptor for gpio %d: %m", gpioRef->pinNum);
+
+        // The line request stays open, only the sysfs value file is closed
+        if (!gpioRef->hasLine)
+        {
+            const int ret = close(fd);
+            LE_WARN_IF(ret == -1, "Failed to close file descriptor for gpio %d: %m",
+                       gpioRef->pinNum);
+        }
     }
 
     LE_DEBUG("Removing callback references");
@@ -73,6 +106,161 @@ static void RemoveChangeCallback
     gpioRef->handlerPtr = NULL;
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Configure the line of a pin driven through the GPIO character device.
+ *
+ * The configuration is applied in a single request. Unless a value is given, an output keeps the
+ * level it drives, whatever its polarity, and an input turned into an output drives a low level as
+ * when "out" is written to the sysfs direction.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_BAD_PARAMETER if the configuration is invalid
+ * - LE_FAULT on any other failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t SetLineFlags
+(
+    gpioSysfs_GpioRef_t gpioRef,    ///< [IN] GPIO object reference
+    uint32_t flags,                 ///< [IN] GPIOCHARDEV_ flags
+    bool hasValue,                  ///< [IN] Is the value of the output given?
+    bool value                      ///< [IN] Value of the output, if given
+)
+{
+    uint32_t configFlags = flags;
+    le_result_t res;
+
+    // Edge detection is only available on inputs, the edges of an output are kept for later
+    if (flags & GPIOCHARDEV_OUTPUT)
+    {
+        configFlags &= ~GPIOCHARDEV_EDGE_BOTH;
+
+        if (!hasValue)
+        {
+            uint64_t current = 0;
+            bool level = false;
+
+            if ((gpioRef->lineFlags & GPIOCHARDEV_OUTPUT) &&
+                (gpioChardev_GetValues(gpioRef->lineFd, 1, &current) == LE_OK))
+            {
+                level = (current != 0) ^ ((gpioRef->lineFlags & GPIOCHARDEV_ACTIVE_LOW) != 0);
+            }
+            value = level ^ ((flags & GPIOCHARDEV_ACTIVE_LOW) != 0);
+        }
+    }
+
+    res = gpioChardev_SetConfig(gpioRef->lineFd, &configFlags, 1, value);
+    if (res != LE_OK)
+    {
+        LE_ERROR("Unable to configure GPIO %d (flags 0x%"PRIx32")", gpioRef->pinNum, configFlags);
+        return (res == LE_BAD_PARAMETER) ? res : LE_FAULT;
+    }
+
+    gpioRef->lineFlags = flags;
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Request the line of a pin from the GPIO character device. The line keeps its configuration.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_UNSUPPORTED if the pin is not a line of the GPIO chip
+ * - LE_BUSY if the line is already used, e.g. exported in the sysfs
+ * - LE_FAULT on any other failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RequestLine
+(
+    gpioSysfs_GpioRef_t gpioRef     ///< [IN] GPIO object reference
+)
+{
+    uint32_t offset;
+    uint32_t flags;
+    uint32_t requestFlags = 0;
+    le_result_t res;
+
+    if (gpioRef->hasLine)
+    {
+        return LE_OK;
+    }
+
+    res = gpioSysfs_GetLineOffset(gpioRef, &offset);
+    if (res != LE_OK)
+    {
+        return res;
+    }
+
+    res = gpioChardev_GetLineFlags(offset, &flags);
+    if (res != LE_OK)
+    {
+        return res;
+    }
+
+    // Without direction flag, the line is requested as it is
+    res = gpioChardev_Request(&offset, &requestFlags, 1, 0, gpioRef->gpioName, &gpioRef->lineFd);
+    if (res != LE_OK)
+    {
+        return res;
+    }
+
+    gpioRef->hasLine = true;
+    gpioRef->lineFlags = flags & (GPIOCHARDEV_INPUT | GPIOCHARDEV_OUTPUT);
+
+    // The request reset the polarity and the resistors of the line, restore them
+    flags &= ~GPIOCHARDEV_EDGE_BOTH;
+    if ((flags != gpioRef->lineFlags) && (SetLineFlags(gpioRef, flags, false, false) != LE_OK))
+    {
+        LE_WARN("Unable to restore the configuration of GPIO %d", gpioRef->pinNum);
+    }
+
+    LE_DEBUG("GPIO %d requested as line %"PRIu32", flags 0x%"PRIx32,
+             gpioRef->pinNum, offset, gpioRef->lineFlags);
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discard the edge events queued on the line of a pin.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DrainLineEvents
+(
+    gpioSysfs_GpioRef_t gpioRef     ///< [IN] GPIO object reference
+)
+{
+    uint32_t offset;
+    bool isRising;
+
+    while (gpioChardev_ReadEvent(gpioRef->lineFd, &offset, &isRising) == LE_OK)
+    {
+    }
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the line request of a pin, so that the line can be exported in the sysfs or requested
+ * along with other ones. The line is requested again when a client connects to the pin service.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseLine
+(
+    gpioSysfs_GpioRef_t gpioRef         ///< [IN] GPIO object reference
+)
+{
+    if (gpioRef->hasLine)
+    {
+        gpioChardev_Release(gpioRef->lineFd);
+        gpioRef->hasLine = false;
+        gpioRef->lineFd = -1;
+        gpioRef->lineFlags = 0;
+    }
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Check if sysfs gpio path exists.
@@ -325,6 +513,41 @@ static le_result_t WriteOutputValue
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Drive an output through the GPIO character device. An input is first turned into an output.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_IO_ERROR on failure
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteLineValue
+(
+    gpioSysfs_GpioRef_t gpioRef,              ///< [IN] GPIO object reference
+    bool value                                ///< [IN] Active or inactive
+)
+{
+    le_result_t res;
+
+    if (gpioRef->lineFlags & GPIOCHARDEV_OUTPUT)
+    {
+        res = gpioChardev_SetValues(gpioRef->lineFd, 1, value);
+    }
+    else
+    {
+        res = SetLineFlags(gpioRef, (gpioRef->lineFlags & ~GPIOCHARDEV_INPUT) | GPIOCHARDEV_OUTPUT,
+                           true, value);
+    }
+
+    if (res != LE_OK)
+    {
+        LE_ERROR("Failed to set GPIO %s to %s", gpioRef->gpioName, value ? "high" : "low");
+        return LE_IO_ERROR;
+    }
+
+    return LE_OK;
+}
 //--------------------------------------------------------------------------------------------------
 /**
  * Rising or Falling of Edge sensitivity
@@ -353,6 +576,35 @@ static le_result_t SetEdgeSense
         return LE_BAD_PARAMETER;
     }
 
+    if (gpioRef->hasLine)
+    {
+        uint32_t flags = gpioRef->lineFlags & ~GPIOCHARDEV_EDGE_BOTH;
+
+        switch(edge)
+        {
+            case SYSFS_EDGE_SENSE_RISING:
+                flags |= GPIOCHARDEV_EDGE_RISING;
+                break;
+            case SYSFS_EDGE_SENSE_FALLING:
+                flags |= GPIOCHARDEV_EDGE_FALLING;
+                break;
+            case SYSFS_EDGE_SENSE_BOTH:
+                flags |= GPIOCHARDEV_EDGE_BOTH;
+                break;
+            default:
+                break;
+        }
+
+        // The edge of an output is not refused, it is kept until the pin is turned into an input
+        if (!(flags & GPIOCHARDEV_INPUT))
+        {
+            gpioRef->lineFlags = flags;
+            return LE_OK;
+        }
+
+        return SetLineFlags(gpioRef, flags, false, false);
+    }
+
     snprintf(path, sizeof(path), "%s%s%s/%s", SYSFS_GPIO_PATH, GpioAliasesPath,
              gpioRef->gpioName, "edge");
 
@@ -440,7 +692,27 @@ le_result_t gpioSysfs_SetPullUpDown
         return LE_BAD_PARAMETER;
     }
 
-    // It is not possible to disable the resistors
+    if (gpioRef->hasLine)
+    {
+        uint32_t flags = gpioRef->lineFlags & ~GPIOCHARDEV_BIAS_MASK;
+
+        switch (pud)
+        {
+            case SYSFS_PULLUPDOWN_TYPE_DOWN:
+                flags |= GPIOCHARDEV_PULL_DOWN;
+                break;
+            case SYSFS_PULLUPDOWN_TYPE_UP:
+                flags |= GPIOCHARDEV_PULL_UP;
+                break;
+            default:
+                flags |= GPIOCHARDEV_BIAS_DISABLED;
+                break;
+        }
+
+        return SetLineFlags(gpioRef, flags, false, false);
+    }
+
+    // It is not possible to disable the resistors through the sysfs
     if (pud == SYSFS_PULLUPDOWN_TYPE_OFF)
     {
         LE_ERROR("Disabling the resistors is not supported");
@@ -469,6 +741,15 @@ le_result_t gpioSysfs_SetPushPullOutput
 {
     le_result_t res = LE_OK;
 
+    if ((gpioRef != NULL) && gpioRef->hasLine)
+    {
+        // Direction, polarity and value are set at once, without glitch
+        return SetLineFlags(gpioRef,
+                            GPIOCHARDEV_OUTPUT | (gpioRef->lineFlags & GPIOCHARDEV_BIAS_MASK) |
+                            ((polarity == SYSFS_ACTIVE_TYPE_LOW) ? GPIOCHARDEV_ACTIVE_LOW : 0),
+                            true, value);
+    }
+
     res = SetDirection(gpioRef, SYSFS_PIN_MODE_OUTPUT);
     if (LE_OK != res)
     {
@@ -506,6 +787,15 @@ le_result_t gpioSysfs_SetOpenDrain
     bool value                            ///< [IN] Initial value to drive
 )
 {
+    if ((gpioRef != NULL) && gpioRef->hasLine)
+    {
+        return SetLineFlags(gpioRef,
+                            GPIOCHARDEV_OUTPUT | GPIOCHARDEV_OPEN_DRAIN |
+                            (gpioRef->lineFlags & GPIOCHARDEV_BIAS_MASK) |
+                            ((polarity == SYSFS_ACTIVE_TYPE_LOW) ? GPIOCHARDEV_ACTIVE_LOW : 0),
+                            true, value);
+    }
+
     LE_WARN("Open Drain API not implemented in sysfs GPIO");
     return LE_NOT_IMPLEMENTED;
 }
@@ -540,6 +830,15 @@ le_result_t gpioSysfs_SetInput
 {
     le_result_t res = LE_OK;
 
+    if ((gpioRef != NULL) && gpioRef->hasLine)
+    {
+        return SetLineFlags(gpioRef,
+                            GPIOCHARDEV_INPUT |
+                            (gpioRef->lineFlags & (GPIOCHARDEV_BIAS_MASK | GPIOCHARDEV_EDGE_BOTH)) |
+                            ((polarity == SYSFS_ACTIVE_TYPE_LOW) ? GPIOCHARDEV_ACTIVE_LOW : 0),
+                            false, false);
+    }
+
     res = SetDirection(gpioRef, SYSFS_PIN_MODE_INPUT);
 
     if (LE_OK != res)
@@ -588,6 +887,14 @@ le_result_t gpioSysfs_SetPolarity
         return LE_BAD_PARAMETER;
     }
 
+    if (gpioRef->hasLine)
+    {
+        return SetLineFlags(gpioRef,
+                            (gpioRef->lineFlags & ~GPIOCHARDEV_ACTIVE_LOW) |
+                            ((level == SYSFS_ACTIVE_TYPE_LOW) ? GPIOCHARDEV_ACTIVE_LOW : 0),
+                            false, false);
+    }
+
     snprintf(path, sizeof(path), "%s%s%s/%s", SYSFS_GPIO_PATH, GpioAliasesPath,
              gpioRef->gpioName, "active_low");
     snprintf(attr, sizeof(attr), "%d", level);
@@ -649,6 +956,18 @@ void* gpioSysfs_SetChangeCallback
     gpioRef->handlerPtr = handlerPtr;
     gpioRef->callbackContextPtr = contextPtr;
 
+    // The edge events are queued by the kernel on the line request
+    if (gpioRef->hasLine)
+    {
+        DrainLineEvents(gpioRef);
+
+        LE_DEBUG("Setting up line monitor for fd %d and pin %s", gpioRef->lineFd,
+                 gpioRef->gpioName);
+        gpioRef->fdMonitor = le_fdMonitor_Create(gpioRef->gpioName, gpioRef->lineFd, fdMonFunc,
+                                                 POLLIN);
+        return gpioRef;
+    }
+
     // Start monitoring the fd for the correct GPIO
     snprintf(monFile, sizeof(monFile), "%s%s%s/%s", SYSFS_GPIO_PATH, GpioAliasesPath,
              gpioRef->gpioName, "value");
@@ -754,6 +1073,17 @@ gpioSysfs_Value_t gpioSysfs_ReadValue
         return -1;
     }
 
+    if (gpioRef->hasLine)
+    {
+        uint64_t values;
+
+        if (gpioChardev_GetValues(gpioRef->lineFd, 1, &values) != LE_OK)
+        {
+            return -1;
+        }
+        return values ? SYSFS_VALUE_HIGH : SYSFS_VALUE_LOW;
+    }
+
     snprintf(path, sizeof(path), "%s%s%s/%s", SYSFS_GPIO_PATH, GpioAliasesPath,
              gpioRef->gpioName, "value");
     leResult = ReadSysGpioSignalAttr(path, sizeof(result), result);
@@ -781,6 +1111,11 @@ le_result_t gpioSysfs_Activate
     gpioSysfs_GpioRef_t gpioRef
 )
 {
+    if ((gpioRef != NULL) && gpioRef->hasLine)
+    {
+        return WriteLineValue(gpioRef, true);
+    }
+
     if (LE_OK != SetDirection(gpioRef, SYSFS_PIN_MODE_OUTPUT))
     {
         LE_ERROR("Failed to set Direction on GPIO %s", gpioRef->gpioName);
@@ -807,6 +1142,11 @@ le_result_t gpioSysfs_Deactivate
     gpioSysfs_GpioRef_t gpioRef
 )
 {
+    if ((gpioRef != NULL) && gpioRef->hasLine)
+    {
+        return WriteLineValue(gpioRef, false);
+    }
+
     if (LE_OK != SetDirection(gpioRef, SYSFS_PIN_MODE_OUTPUT))
     {
         LE_ERROR("Failed to set Direction on GPIO %s", gpioRef->gpioName);
@@ -866,6 +1206,11 @@ bool gpioSysfs_IsInput
         return false;
     }
 
+    if (gpioRef->hasLine)
+    {
+        return ((gpioRef->lineFlags & GPIOCHARDEV_INPUT) != 0);
+    }
+
     snprintf(path, sizeof(path), "%s%s%s/%s", SYSFS_GPIO_PATH, GpioAliasesPath,
              gpioRef->gpioName, "direction");
     leResult = ReadSysGpioSignalAttr(path, sizeof(result), result);
@@ -916,6 +1261,19 @@ gpioSysfs_PullUpDownType_t gpioSysfs_GetPullUpDown
         return -1;
     }
 
+    if (gpioRef->hasLine)
+    {
+        if (gpioRef->lineFlags & GPIOCHARDEV_PULL_DOWN)
+        {
+            return SYSFS_PULLUPDOWN_TYPE_DOWN;
+        }
+        if (gpioRef->lineFlags & GPIOCHARDEV_PULL_UP)
+        {
+            return SYSFS_PULLUPDOWN_TYPE_UP;
+        }
+        return SYSFS_PULLUPDOWN_TYPE_OFF;
+    }
+
     snprintf(path, sizeof(path), "%s%s%s/%s", SYSFS_GPIO_PATH, GpioAliasesPath,
              gpioRef->gpioName, "pull");
     leResult = ReadSysGpioSignalAttr(path, sizeof(result), result);
@@ -965,6 +1323,12 @@ gpioSysfs_ActiveType_t gpioSysfs_GetPolarity
         return -1;
     }
 
+    if (gpioRef->hasLine)
+    {
+        return (gpioRef->lineFlags & GPIOCHARDEV_ACTIVE_LOW) ? SYSFS_ACTIVE_TYPE_LOW :
+                                                               SYSFS_ACTIVE_TYPE_HIGH;
+    }
+
     snprintf(path, sizeof(path), "%s%s%s/%s", SYSFS_GPIO_PATH, GpioAliasesPath,
              gpioRef->gpioName, "active_low");
     leResult = ReadSysGpioSignalAttr(path, sizeof(result), result);
@@ -1014,6 +1378,21 @@ gpioSysfs_EdgeSensivityMode_t gpioSysfs_GetEdgeSense
         return SYSFS_EDGE_SENSE_NONE;
     }
 
+    if (gpioRef->hasLine)
+    {
+        switch (gpioRef->lineFlags & GPIOCHARDEV_EDGE_BOTH)
+        {
+            case GPIOCHARDEV_EDGE_RISING:
+                return SYSFS_EDGE_SENSE_RISING;
+            case GPIOCHARDEV_EDGE_FALLING:
+                return SYSFS_EDGE_SENSE_FALLING;
+            case GPIOCHARDEV_EDGE_BOTH:
+                return SYSFS_EDGE_SENSE_BOTH;
+            default:
+                return SYSFS_EDGE_SENSE_NONE;
+        }
+    }
+
     snprintf(path, sizeof(path), "%s%s%s/%s", SYSFS_GPIO_PATH, GpioAliasesPath,
              gpioRef->gpioName, "edge");
     leResult = ReadSysGpioSignalAttr(path, sizeof(result), result);
@@ -1091,6 +1470,21 @@ void gpioSysfs_InputMonitorHandlerFunc
         return;
     }
 
+    // Report every queued edge; the state after a rising edge is active
+    if (gpioRef->hasLine)
+    {
+        uint32_t offset;
+        bool isRising;
+
+        while ((gpioRef->handlerPtr != NULL) &&
+               (gpioChardev_ReadEvent(fd, &offset, &isRising) == LE_OK))
+        {
+            LE_DEBUG("Calling change callback for %s", gpioRef->gpioName);
+            gpioRef->handlerPtr(isRising, gpioRef->callbackContextPtr);
+        }
+        return;
+    }
+
     // Seek to the start of the file - this is required to prevent
     // repeated triggers - see https://www.kernel.org/doc/Documentation/gpio/sysfs.txt
     LE_DEBUG("Seek to start of file %d", fd);
@@ -1165,8 +1559,13 @@ void gpioSysfs_SessionOpenHandlerFunc
         return;
     }
 
-    // Export the pin in sysfs to make it available for use
-    if (LE_OK != ExportGpio(gpioRef))
+    // Drive the pin through the GPIO character device if possible, otherwise export it in sysfs
+    // to make it available for use
+    if (UseChardev && (RequestLine(gpioRef) == LE_OK))
+    {
+        LE_DEBUG("GPIO %s driven through the GPIO character device", gpioRef->gpioName);
+    }
+    else if (LE_OK != ExportGpio(gpioRef))
     {
         LE_WARN("Unable to export GPIO %s for use - stopping session", gpioRef->gpioName);
         le_msg_CloseSession(sessionRef);
@@ -1219,6 +1618,9 @@ void gpioSysfs_SessionCloseHandlerFunc
 
     RemoveChangeCallback(gpioRef);
 
+    // A requested line can't be exported in the sysfs or grouped, so it is only kept while in use
+    ReleaseLine(gpioRef);
+
     gpioRef->currentSession = NULL;
 }
 
@@ -1288,11 +1690,195 @@ bool gpioSysfs_IsPinAvailable
     return (check & (1 << bitInMask));
 }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a numeric attribute of a GPIO controller in the sysfs, e.g. its base or its ngpio.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_FAULT if the attribute can't be read or is not a number
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadControllerAttr
+(
+    const char* controllerPtr,  ///< [IN] Controller name in the sysfs, e.g. gpiochip1
+    const char* attrNamePtr,    ///< [IN] Attribute name
+    uint32_t*   valuePtr        ///< [OUT] Attribute value
+)
+{
+    char path[PATH_MAX];
+    char attr[16];
+    char* endPtr;
+
+    snprintf(path, sizeof(path), "%s/%s/%s", SYSFS_GPIO_PATH, controllerPtr, attrNamePtr);
+    if (ReadSysGpioSignalAttr(path, sizeof(attr), attr) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    errno = 0;
+    *valuePtr = strtoul(attr, &endPtr, 10);
+    if ((errno != 0) || (endPtr == attr))
+    {
+        return LE_FAULT;
+    }
+
+    return LE_OK;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the GPIO character device of the pins from the GPIO controllers of the sysfs.
+ *
+ * The controller is the one which implements the first pin, and its character device is found in
+ * its device directory.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_NOT_FOUND if no controller implements the pins or if it has no character device
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FindChardev
+(
+    char*     chipPathPtr,      ///< [OUT] Character device of the controller
+    size_t    chipPathSize,     ///< [IN] Size of the character device buffer
+    uint32_t* basePtr,          ///< [OUT] Pin number of the first line of the controller
+    uint32_t* countPtr          ///< [OUT] Number of lines of the controller
+)
+{
+    char path[PATH_MAX];
+    char controller[NAME_MAX + 1] = "";
+    DIR* dirPtr;
+    struct dirent* entryPtr;
+    le_result_t res = LE_NOT_FOUND;
+
+    dirPtr = opendir(SYSFS_GPIO_PATH);
+    if (dirPtr == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    while ((entryPtr = readdir(dirPtr)) != NULL)
+    {
+        uint32_t base;
+        uint32_t count;
+
+        if (strncmp(entryPtr->d_name, "gpiochip", sizeof("gpiochip") - 1) != 0)
+        {
+            continue;
+        }
+
+        if ((ReadControllerAttr(entryPtr->d_name, "base", &base) != LE_OK) ||
+            (ReadControllerAttr(entryPtr->d_name, "ngpio", &count) != LE_OK))
+        {
+            continue;
+        }
+
+        if ((base <= MIN_PIN_NUMBER) && (MIN_PIN_NUMBER - base < count))
+        {
+            LE_ASSERT_OK(le_utf8_Copy(controller, entryPtr->d_name, sizeof(controller), NULL));
+            *basePtr = base;
+            *countPtr = count;
+            break;
+        }
+    }
+    closedir(dirPtr);
+
+    if (controller[0] == '\0')
+    {
+        return LE_NOT_FOUND;
+    }
+
+    // The device directory of the controller holds its gpiochipN character device
+    snprintf(path, sizeof(path), "%s/%s/device", SYSFS_GPIO_PATH, controller);
+    dirPtr = opendir(path);
+    if (dirPtr == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    while ((entryPtr = readdir(dirPtr)) != NULL)
+    {
+        if (strncmp(entryPtr->d_name, "gpiochip", sizeof("gpiochip") - 1) == 0)
+        {
+            snprintf(chipPathPtr, chipPathSize, "/dev/%s", entryPtr->d_name);
+            res = LE_OK;
+            break;
+        }
+    }
+    closedir(dirPtr);
+
+    return res;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open the GPIO character device of the pins, if enabled by LE_CONFIG_GPIO_CHARDEV and not
+ * disabled in the config tree.
+ *
+ * By default, the character device and the base of the pins are the ones of the GPIO controller
+ * which implements the pins in the sysfs. The GPIO design V2 aliases the pins to GPIOs which are
+ * not known here, so only the sysfs is used then, unless the chip and its base are configured.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitializeChardev
+(
+    void
+)
+{
+    char chipPath[PATH_MAX] = "";
+    uint32_t lineCount = 0;
+
+    if (!LE_CONFIG_IS_ENABLED(LE_CONFIG_GPIO_CHARDEV))
+    {
+        LE_DEBUG("GPIO character device not enabled, using sysfs");
+        return;
+    }
+
+    if (le_cfg_QuickGetBool(CFG_CHARDEV_DISABLED, false))
+    {
+        LE_INFO("GPIO character device disabled by config");
+        return;
+    }
+
+    if ((LE_OK == le_cfg_QuickGetString(CFG_CHARDEV_CHIP, chipPath, sizeof(chipPath), "")) &&
+        (chipPath[0] != '\0'))
+    {
+        ChardevBase = le_cfg_QuickGetInt(CFG_CHARDEV_BASE, MIN_PIN_NUMBER);
+    }
+    else if ((GpioDesign != SYSFS_GPIO_DESIGN_V1) ||
+             (FindChardev(chipPath, sizeof(chipPath), &ChardevBase, &lineCount) != LE_OK))
+    {
+        LE_INFO("No GPIO character device, using sysfs");
+        return;
+    }
+
+    if (gpioChardev_Open(chipPath) != LE_OK)
+    {
+        LE_INFO("Unable to open %s, using sysfs", chipPath);
+        return;
+    }
+
+    // The chip found must be the controller of the sysfs
+    if ((lineCount != 0) && (gpioChardev_GetLineCount() != lineCount))
+    {
+        LE_WARN("%s has %"PRIu32" lines instead of %"PRIu32", using sysfs",
+                chipPath, gpioChardev_GetLineCount(), lineCount);
+        gpioChardev_Close();
+        return;
+    }
+
+    UseChardev = true;
+    LE_INFO("Pins from %"PRIu32" driven through %s", ChardevBase, chipPath);
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize the GPIO sys fs and return the GPIO design found:
  *   - SYSFS_GPIO_DESIGN_V2 if /sys/class/gpio/v2/alias_export exists and is writable,
  *   - SYSFS_GPIO_DESIGN_V1 else.
+ *
+ * The GPIO character device is then opened, if available.
  */
 //--------------------------------------------------------------------------------------------------
 void gpioSysfs_Initialize
@@ -1311,4 +1897,47 @@ void gpioSysfs_Initialize
         snprintf(GpioAliasesPath, sizeof(GpioAliasesPath), "%s", SYSFS_GPIO_ALIASES_PATH);
         *gpioDesignPtr = GpioDesign = SYSFS_GPIO_DESIGN_V2;
     }
+
+    InitializeChardev();
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if the pins are driven through the GPIO character device.
+ *
+ * @return true if the GPIO character device is used, false if only the sysfs is.
+ */
+//--------------------------------------------------------------------------------------------------
+bool gpioSysfs_IsChardevUsed
+(
+    void
+)
+{
+    return UseChardev;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the offset of the line of a pin in the GPIO chip.
+ *
+ * @return
+ * - LE_OK on success
+ * - LE_UNSUPPORTED if the pin is not driven through the GPIO character device
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t gpioSysfs_GetLineOffset
+(
+    gpioSysfs_GpioRef_t gpioRef,        ///< [IN] GPIO object reference
+    uint32_t* offsetPtr                 ///< [OUT] Line offset
+)
+{
+    if ((!UseChardev) || (gpioRef->pinNum < ChardevBase) ||
+        (gpioRef->pinNum - ChardevBase >= gpioChardev_GetLineCount()))
+    {
+        return LE_UNSUPPORTED;
+    }
+
+    *offsetPtr = gpioRef->pinNum - ChardevBase;
+
+    return LE_OK;
 }
@@ -628,12 +628,54 @@ void le_cfg_GetNodeType
         nodeType = ni_GetNodeType(iteratorRef, pathPtr);
     }
 
+    // Clients which predate binary nodes expect binary values in strings.
+    if (nodeType == LE_CFG_TYPE_BINARY)
+    {
+        nodeType = LE_CFG_TYPE_STRING;
+    }
+
     le_cfg_GetNodeTypeRespond(commandRef, nodeType);
 }
 
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Check if the node that the iterator is currently pointing at holds a binary value.
+ *
+ *  \b Responds \b With:
+ *
+ *  True if the node is a binary node, false if not.
+ */
+// -------------------------------------------------------------------------------------------------
+void le_cfg_IsBinary
+(
+    le_cfg_ServerCmdRef_t commandRef,  ///< [IN] Reference used to generate a reply for this
+                                       ///<      request.
+    le_cfg_IteratorRef_t externalRef,  ///< [IN] Iterator object to use to read from the tree.
+    const char* pathPtr                ///< [IN] Absolute or relative path to read from.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Checking if the iterator's <%p> current node is binary.", externalRef);
+    LE_DEBUG_IF((pathPtr != NULL) && (strlen(pathPtr) != 0), "** Offset by \"%s\"", pathPtr);
+
+    ni_IteratorRef_t iteratorRef = GetIteratorFromRef(externalRef);
+    bool isBinary = false;
+
+    if ((NULL != pathPtr) && (NULL != iteratorRef)
+        && (false == CheckPathForSpecifier(pathPtr)))
+    {
+        isBinary = (ni_GetNodeType(iteratorRef, pathPtr) == LE_CFG_TYPE_BINARY);
+    }
+
+    le_cfg_IsBinaryRespond(commandRef, isBinary);
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Get the name of the node that the iterator is currently pointing at.
@@ -1026,60 +1068,25 @@ void le_cfg_GetBinary
     uint8_t* binaryBuf = le_mem_ForceAlloc(tdb_GetBinaryDataMemoryPool());
     size_t binaryLen = MaxBinary(maxBinary);
 
-    char* stringBuf = le_mem_ForceAlloc(tdb_GetEncodedStringMemoryPool());
-    stringBuf[0] = 0;
-    size_t stringBufSize = TDB_MAX_ENCODED_SIZE;
-
-    // Encode the default valaue
-    char* defaultStringBuf = le_mem_ForceAlloc(tdb_GetEncodedStringMemoryPool());
-    defaultStringBuf[0] = 0;
-    size_t defaultEncodedSize = TDB_MAX_ENCODED_SIZE;
-    result = le_base64_Encode(defaultValue,
-                              defaultValueSize,
-                              defaultStringBuf,
-                              &defaultEncodedSize);
-    if (LE_OK != result)
-    {
-        LE_ERROR("ERROR encoding default value: %s", LE_RESULT_TXT(result));
-        // Encode error - sending back the default value
-        le_cfg_GetBinaryRespond(commandRef, LE_FORMAT_ERROR, defaultValue, defaultValueSize);
-    }
-
-    // Get the encoded string
-    result = LE_OK;
     if ((NULL != pathPtr) && (NULL != iteratorRef)
         && (false == CheckPathForSpecifier(pathPtr)))
     {
-        result = ni_GetNodeValueString(iteratorRef,
+        result = ni_GetNodeValueBinary(iteratorRef,
                                        pathPtr,
-                                       stringBuf,
-                                       stringBufSize,
-                                       defaultStringBuf);
-    }
-    if (LE_OK != result)
-    {
-        // Node not found or has empty type: sending back the default value
-        le_cfg_GetBinaryRespond(commandRef, result, defaultValue, defaultValueSize);
+                                       binaryBuf,
+                                       &binaryLen,
+                                       defaultValue,
+                                       defaultValueSize);
+        LE_ERROR_IF(result == LE_FORMAT_ERROR, "ERROR decoding binary data.");
+
+        le_cfg_GetBinaryRespond(commandRef, result, binaryBuf, binaryLen);
     }
     else
     {
-        // Decode the string into binary data.
-        result = le_base64_Decode(stringBuf,
-                                  strlen(stringBuf),
-                                  binaryBuf,
-                                  &binaryLen);
-        if (LE_OK != result)
-        {
-            LE_ERROR("ERROR decoding binary data: %s", LE_RESULT_TXT(result));
-        }
-
-        // Send back the decoded value
-        le_cfg_GetBinaryRespond(commandRef, result, binaryBuf, binaryLen);
+        le_cfg_GetBinaryRespond(commandRef, result, defaultValue, defaultValueSize);
     }
 
     le_mem_Release(binaryBuf);
-    le_mem_Release(stringBuf);
-    le_mem_Release(defaultStringBuf);
 }
 
 
@@ -1109,9 +1116,6 @@ void le_cfg_SetBinary
 
     LE_DEBUG_IF((pathPtr != NULL) && (strlen(pathPtr) != 0), "** Offset by \"%s\"", pathPtr);
 
-    char* stringBuf = le_mem_ForceAlloc(tdb_GetEncodedStringMemoryPool());
-    size_t encodedSize = TDB_MAX_ENCODED_SIZE;
-
     ni_IteratorRef_t iteratorRef = GetWriteIteratorFromRef(externalRef);
 
     if ((NULL != pathPtr) && (NULL != iteratorRef)
@@ -1122,22 +1126,14 @@ void le_cfg_SetBinary
         if (0 == strcmp(treeNamePtr, "system"))
         {
             LE_ERROR("Binary data is not supported for the system tree");
-            goto cleanup;
         }
-
-        // encode the data and write it to the node
-        le_result_t result = le_base64_Encode(valuePtr, size, stringBuf, &encodedSize);
-        if (LE_OK != result)
+        else
         {
-            LE_ERROR("ERROR encoding binary data: %s", LE_RESULT_TXT(result));
-            goto cleanup;
+            ni_SetNodeValueBinary(iteratorRef, pathPtr, valuePtr, size);
         }
-        ni_SetNodeValueString(iteratorRef, pathPtr, stringBuf);
     }
 
-cleanup:
     le_cfg_SetBinaryRespond(commandRef);
-    le_mem_Release(stringBuf);
 }
 
 
@@ -1508,13 +1504,12 @@ void le_cfg_QuickSetString
 
     if (treeRef != NULL)
     {
-        rq_HandleQuickSetData(le_cfg_GetClientSessionRef(),
-                              commandRef,
-                              userRef,
-                              treeRef,
-                              tp_GetPathOnly(pathPtr),
-                              valuePtr,
-                              RQ_SET_STRING);
+        rq_HandleQuickSetString(le_cfg_GetClientSessionRef(),
+                                commandRef,
+                                userRef,
+                                treeRef,
+                                tp_GetPathOnly(pathPtr),
+                                valuePtr);
     }
 }
 
@@ -1587,27 +1582,13 @@ void le_cfg_QuickSetBinary
             return;
         }
 
-        // encode the data and write it to the node
-        char* stringBuf = le_mem_ForceAlloc(tdb_GetEncodedStringMemoryPool());
-        stringBuf[0] = 0;
-        size_t encodedSize = TDB_MAX_ENCODED_SIZE;
-
-        le_result_t result = le_base64_Encode(valuePtr, size, stringBuf, &encodedSize);
-        if (LE_OK != result)
-        {
-            LE_ERROR("ERROR encoding binary data: %s", LE_RESULT_TXT(result));
-        }
-        else
-        {
-            rq_HandleQuickSetData(le_cfg_GetClientSessionRef(),
-                                  commandRef,
-                                  userRef,
-                                  treeRef,
-                                  tp_GetPathOnly(pathPtr),
-                                  stringBuf,
-                                  RQ_SET_BINARY);
-        }
-        le_mem_Release(stringBuf);
+        rq_HandleQuickSetBinary(le_cfg_GetClientSessionRef(),
+                                commandRef,
+                                userRef,
+                                treeRef,
+                                tp_GetPathOnly(pathPtr),
+                                valuePtr,
+                                size);
     }
 }
 
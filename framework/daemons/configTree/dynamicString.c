@@ -42,6 +42,8 @@ typedef struct
     int32_t magic;       ///< Safety value.  If this isn't set to HEADER_MAGIC then the string is
                          ///<   invalid.
     le_sls_List_t list;  ///< The list of the segments that this string is made up of.
+    size_t dataSize;     ///< Number of bytes held if the string holds binary data, in which case
+                         ///<   the segments are packed full and not NULL terminated.
 
     // TODO: Other quick access stats as needed.  Like byte and char counts.
 }
@@ -316,6 +318,7 @@ dstr_Ref_t dstr_New
 
     newHeadRef->head.magic = HEADER_MAGIC;
     newHeadRef->head.list = LE_SLS_LIST_INIT;
+    newHeadRef->head.dataSize = 0;
 
     return newHeadRef;
 }
@@ -463,6 +466,8 @@ void dstr_CopyFromCstr
     le_result_t result;
     dstr_Ref_t destSegmentRef = NewOrFirstSegmentRef(destStrRef);
 
+    destStrRef->head.dataSize = 0;
+
     do
     {
         size_t bytesCopied = 0;
@@ -503,6 +508,8 @@ void dstr_Copy
     dstr_Ref_t sourceSegmentRef = FirstSegmentRef(sourceStrPtr);
     dstr_Ref_t destSegmentRef = NewOrFirstSegmentRef(destStrPtr);
 
+    destStrPtr->head.dataSize = sourceStrPtr->head.dataSize;
+
     while (sourceSegmentRef != NULL)
     {
         memcpy(destSegmentRef->body.value, sourceSegmentRef->body.value, SEGMENT_SIZE);
@@ -520,6 +527,115 @@ void dstr_Copy
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Copy a block of binary data into a dynamic string.  The data is packed into the string's
+ *  segments as is, without any encoding, and the string will grow or shrink as required.
+ */
+//--------------------------------------------------------------------------------------------------
+void dstr_CopyFromBytes
+(
+    dstr_Ref_t destStrRef,   ///< [OUT] The dynamic string to copy to.
+    const uint8_t* dataPtr,  ///< [IN]  The data to copy.
+    size_t dataSize          ///< [IN]  The number of bytes to copy.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    dstr_Ref_t destSegmentRef = NewOrFirstSegmentRef(destStrRef);
+
+    destStrRef->head.dataSize = dataSize;
+
+    for (;;)
+    {
+        size_t chunkSize = (dataSize < SEGMENT_SIZE) ? dataSize : SEGMENT_SIZE;
+
+        memcpy(destSegmentRef->body.value, dataPtr, chunkSize);
+        dataPtr += chunkSize;
+        dataSize -= chunkSize;
+
+        if (dataSize == 0)
+        {
+            break;
+        }
+
+        destSegmentRef = NewOrNextSegmentRef(destStrRef, destSegmentRef);
+    }
+
+    FreeAnyAfter(destStrRef, destSegmentRef);
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Copy the binary data held by a dynamic string into a buffer.
+ *
+ *  @return LE_OK if the data fit within the supplied buffer.
+ *          LE_OVERFLOW if the data had to be truncated during the copy.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t dstr_CopyToBytes
+(
+    uint8_t* destPtr,               ///< [OUT]    The destination buffer.
+    size_t* destSizePtr,            ///< [IN/OUT] The size of the buffer on the way in, the number
+                                    ///<          of bytes copied on the way out.
+    const dstr_Ref_t sourceStrRef   ///< [IN]     The dynamic string to copy from.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    VALIDATE_HEADER(sourceStrRef);
+
+    le_result_t result = LE_OK;
+    size_t remaining = sourceStrRef->head.dataSize;
+    dstr_Ref_t segmentRef = NULL;
+
+    if (remaining > *destSizePtr)
+    {
+        remaining = *destSizePtr;
+        result = LE_OVERFLOW;
+    }
+
+    *destSizePtr = remaining;
+
+    for (segmentRef = FirstSegmentRef(sourceStrRef);
+         (segmentRef != NULL) && (remaining > 0);
+         segmentRef = NextSegmentRef(sourceStrRef, segmentRef))
+    {
+        size_t chunkSize = (remaining < SEGMENT_SIZE) ? remaining : SEGMENT_SIZE;
+
+        memcpy(destPtr, segmentRef->body.value, chunkSize);
+        destPtr += chunkSize;
+        remaining -= chunkSize;
+    }
+
+    return result;
+}
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the size of the binary data held by a dynamic string.
+ *
+ *  @return The number of bytes stored by dstr_CopyFromBytes, or 0 if the string holds text.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t dstr_NumDataBytes
+(
+    const dstr_Ref_t strRef  ///< [IN] The dynamic string object to read.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    VALIDATE_HEADER(strRef);
+
+    return strRef->head.dataSize;
+}
+
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Call to check the dynamic string if it's effectively empty.
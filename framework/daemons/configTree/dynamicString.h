@@ -140,6 +140,56 @@ void dstr_Copy
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Copy a block of binary data into a dynamic string.  The data is packed into the string's
+ *  segments as is, without any encoding, and the string will grow or shrink as required.
+ */
+//--------------------------------------------------------------------------------------------------
+void dstr_CopyFromBytes
+(
+    dstr_Ref_t destStrRef,   ///< [OUT] The dynamic string to copy to.
+    const uint8_t* dataPtr,  ///< [IN]  The data to copy.
+    size_t dataSize          ///< [IN]  The number of bytes to copy.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Copy the binary data held by a dynamic string into a buffer.
+ *
+ *  @return LE_OK if the data fit within the supplied buffer.
+ *          LE_OVERFLOW if the data had to be truncated during the copy.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t dstr_CopyToBytes
+(
+    uint8_t* destPtr,               ///< [OUT]    The destination buffer.
+    size_t* destSizePtr,            ///< [IN/OUT] The size of the buffer on the way in, the number
+                                    ///<          of bytes copied on the way out.
+    const dstr_Ref_t sourceStrRef   ///< [IN]     The dynamic string to copy from.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the size of the binary data held by a dynamic string.
+ *
+ *  @return The number of bytes stored by dstr_CopyFromBytes, or 0 if the string holds text.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t dstr_NumDataBytes
+(
+    const dstr_Ref_t strRef  ///< [IN] The dynamic string object to read.
+);
+
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Call to check the dynamic string if it's effectively empty.
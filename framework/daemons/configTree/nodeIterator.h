@@ -511,6 +511,45 @@ void ni_SetNodeValueString
 
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Get the binary value for a given node in the tree.
+ *
+ *  @return LE_OK if the value will fit within the supplied buffer, LE_OVERFLOW otherwise.
+ *          LE_FORMAT_ERROR if the node holds a string that isn't base64 encoded binary data.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t ni_GetNodeValueBinary
+(
+    ni_IteratorRef_t iteratorRef,  ///< [IN]     The iterator object to access.
+    const char* pathPtr,           ///< [IN]     Optional path to another node in the tree.
+    uint8_t* destBufferPtr,        ///< [OUT]    The buffer to copy the data into.
+    size_t* sizePtr,               ///< [IN/OUT] Size of the buffer on the way in, size of the
+                                   ///<          value on the way out.
+    const uint8_t* defaultPtr,     ///< [IN]     If the value can not be found, use this one
+                                   ///<          instead.
+    size_t defaultSize             ///< [IN]     Size of the default value.
+);
+
+
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ *  Write a binary value into the config tree.
+ */
+//--------------------------------------------------------------------------------------------------
+void ni_SetNodeValueBinary
+(
+    ni_IteratorRef_t iteratorRef,  ///< [IN] The iterator object to access.
+    const char* pathPtr,           ///< [IN] Optional path to another node in the tree.
+    const uint8_t* valuePtr,       ///< [IN] Write this value into the tree.
+    size_t valueSize               ///< [IN] Size of the value.
+);
+
+
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  *  Read an integer value from a node in the config tree.
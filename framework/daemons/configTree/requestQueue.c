@@ -67,6 +67,12 @@ typedef struct UpdateRequest
             union
             {
                 char AsStringPtr[TDB_MAX_ENCODED_SIZE];
+                struct
+                {
+                    uint8_t data[LE_CFG_BINARY_LEN];
+                    size_t size;
+                }
+                AsBinary;
                 int AsInt;
                 float AsFloat;
                 bool AsBool;
@@ -359,19 +365,34 @@ static void ProcessRequestQueue
                     break;
 
                 case RQ_SET_STRING:
+                    LE_DEBUG("Processing deferred quick 'set string' for user %u (%s) "
+                             "on tree '%s'.",
+                             tu_GetUserId(requestPtr->userRef),
+                             tu_GetUserName(requestPtr->userRef),
+                             tdb_GetTreeName(requestPtr->treeRef));
+
+                    rq_HandleQuickSetString(requestPtr->sessionRef,
+                                            requestPtr->commandRef,
+                                            requestPtr->userRef,
+                                            requestPtr->treeRef,
+                                            requestPtr->data.writeReq.pathPtr,
+                                            requestPtr->data.writeReq.value.AsStringPtr);
+                    break;
+
                 case RQ_SET_BINARY:
-                    LE_DEBUG("Processing deferred quick 'set string/binary' for user %u (%s) on tree '%s'.",
+                    LE_DEBUG("Processing deferred quick 'set binary' for user %u (%s) "
+                             "on tree '%s'.",
                              tu_GetUserId(requestPtr->userRef),
                              tu_GetUserName(requestPtr->userRef),
                              tdb_GetTreeName(requestPtr->treeRef));
 
-                    rq_HandleQuickSetData(requestPtr->sessionRef,
-                                          requestPtr->commandRef,
-                                          requestPtr->userRef,
-                                          requestPtr->treeRef,
-                                          requestPtr->data.writeReq.pathPtr,
-                                          requestPtr->data.writeReq.value.AsStringPtr,
-                                          requestPtr->type);
+                    rq_HandleQuickSetBinary(requestPtr->sessionRef,
+                                            requestPtr->commandRef,
+                                            requestPtr->userRef,
+                                            requestPtr->treeRef,
+                                            requestPtr->data.writeReq.pathPtr,
+                                            requestPtr->data.writeReq.value.AsBinary.data,
+                                            requestPtr->data.writeReq.value.AsBinary.size);
                     break;
 
                 case RQ_SET_INT:
@@ -814,10 +835,10 @@ void rq_HandleQuickGetString
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Write a string or binary value to a node in the tree.
+ *  Write a string value to a node in the tree.
  */
 // -------------------------------------------------------------------------------------------------
-void rq_HandleQuickSetData
+void rq_HandleQuickSetString
 (
     le_msg_SessionRef_t sessionRef,    ///< [IN] The session this request occured on.
     le_cfg_ServerCmdRef_t commandRef,  ///< [IN] This handle is used to generate the reply for this
@@ -825,20 +846,17 @@ void rq_HandleQuickSetData
     tu_UserRef_t userRef,              ///< [IN] The user that's requesting the action.
     tdb_TreeRef_t treeRef,             ///< [IN] The tree that we're peforming the action on.
     const char* pathPtr,               ///< [IN] The path to the node to access.
-    const char* valuePtr,              ///< [IN] The value to set.
-    RequestType_t reqType              ///< [IN] Request type: whether this a string or
-                                       ///<      an encoded binary data.
+    const char* valuePtr               ///< [IN] The value to set.
 )
 //--------------------------------------------------------------------------------------------------
 {
     if (CanQuickSet(treeRef) == false)
     {
-        UpdateRequest_t* requestPtr = NewRequestBlock(
-                                        reqType,
-                                        userRef,
-                                        treeRef,
-                                        sessionRef,
-                                        commandRef);
+        UpdateRequest_t* requestPtr = NewRequestBlock(RQ_SET_STRING,
+                                                      userRef,
+                                                      treeRef,
+                                                      sessionRef,
+                                                      commandRef);
 
         LE_ASSERT(le_utf8_Copy(requestPtr->data.writeReq.pathPtr,
                                pathPtr,
@@ -864,18 +882,62 @@ void rq_HandleQuickSetData
         ni_SetNodeValueString(iteratorRef, NULL, valuePtr);
         ni_Commit(iteratorRef);
         ni_Release(iteratorRef);
-        if (RQ_SET_BINARY == reqType)
-        {
-            le_cfg_QuickSetBinaryRespond(commandRef);
-        }
-        else if (RQ_SET_STRING == reqType)
-        {
-            le_cfg_QuickSetStringRespond(commandRef);
-        }
-        else
-        {
-            LE_ERROR("Unexpected request type: %d", reqType);
-        }
+
+        le_cfg_QuickSetStringRespond(commandRef);
+    }
+}
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a binary value to a node in the tree.
+ */
+// -------------------------------------------------------------------------------------------------
+void rq_HandleQuickSetBinary
+(
+    le_msg_SessionRef_t sessionRef,    ///< [IN] The session this request occured on.
+    le_cfg_ServerCmdRef_t commandRef,  ///< [IN] This handle is used to generate the reply for this
+                                       ///<      message.
+    tu_UserRef_t userRef,              ///< [IN] The user that's requesting the action.
+    tdb_TreeRef_t treeRef,             ///< [IN] The tree that we're peforming the action on.
+    const char* pathPtr,               ///< [IN] The path to the node to access.
+    const uint8_t* valuePtr,           ///< [IN] The value to set.
+    size_t valueSize                   ///< [IN] Size of the value.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (CanQuickSet(treeRef) == false)
+    {
+        UpdateRequest_t* requestPtr = NewRequestBlock(RQ_SET_BINARY,
+                                                      userRef,
+                                                      treeRef,
+                                                      sessionRef,
+                                                      commandRef);
+
+        LE_ASSERT(le_utf8_Copy(requestPtr->data.writeReq.pathPtr,
+                               pathPtr,
+                               sizeof(requestPtr->data.writeReq.pathPtr),
+                               NULL) == LE_OK);
+
+        LE_ASSERT(valueSize <= sizeof(requestPtr->data.writeReq.value.AsBinary.data));
+        memcpy(requestPtr->data.writeReq.value.AsBinary.data, valuePtr, valueSize);
+        requestPtr->data.writeReq.value.AsBinary.size = valueSize;
+
+        QueueRequest(tdb_GetRequestQueue(treeRef), requestPtr);
+    }
+    else
+    {
+        ni_IteratorRef_t iteratorRef = ni_CreateIterator(sessionRef,
+                                                         userRef,
+                                                         treeRef,
+                                                         NI_WRITE,
+                                                         pathPtr);
+
+        ni_SetNodeValueBinary(iteratorRef, NULL, valuePtr, valueSize);
+        ni_Commit(iteratorRef);
+        ni_Release(iteratorRef);
+
+        le_cfg_QuickSetBinaryRespond(commandRef);
     }
 }
 
@@ -899,17 +961,12 @@ void rq_HandleQuickGetBinary
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_result_t result = LE_OK;
-
     ni_IteratorRef_t iteratorRef = ni_CreateIterator(sessionRef,
                                                      userRef,
                                                      treeRef,
                                                      NI_READ,
                                                      pathPtr);
 
-    char* stringBuf = le_mem_ForceAlloc(tdb_GetEncodedStringMemoryPool());
-    stringBuf[0] = 0;
-
     uint8_t* binaryBuf = le_mem_ForceAlloc(tdb_GetBinaryDataMemoryPool());
     size_t binaryLen = maxBinary;
     if (maxBinary > LE_CFG_BINARY_LEN)
@@ -917,55 +974,18 @@ void rq_HandleQuickGetBinary
         binaryLen = LE_CFG_BINARY_LEN;
     }
 
-    // Encode the default valaue
-    char* defaultStringBuf = le_mem_ForceAlloc(tdb_GetEncodedStringMemoryPool());
-    defaultStringBuf[0] = 0;
-    size_t defaultEncodedSize = TDB_MAX_ENCODED_SIZE;
-    result = le_base64_Encode(defaultValuePtr,
-                              defaultValueSize,
-                              defaultStringBuf,
-                              &defaultEncodedSize);
-    if (LE_OK != result)
-    {
-        LE_ERROR("ERROR encoding default value: %s", LE_RESULT_TXT(result));
-        // Encode error - sending back the default value
-        le_cfg_QuickGetBinaryRespond(commandRef,
-                                     LE_FORMAT_ERROR,
-                                     defaultValuePtr,
-                                     defaultValueSize);
-    }
-
-    // Get the encoded string
-    result = ni_GetNodeValueString(iteratorRef,
-                                   pathPtr,
-                                   stringBuf,
-                                   TDB_MAX_ENCODED_SIZE,
-                                   defaultStringBuf);
-    if (LE_OK != result)
-    {
-        // Node not found or has empty type: sending back the default value
-        le_cfg_QuickGetBinaryRespond(commandRef, result, defaultValuePtr, defaultValueSize);
-    }
-    else
-    {
-        // Decode the string into binary data.
-        result = le_base64_Decode(stringBuf,
-                                  strlen(stringBuf),
-                                  binaryBuf,
-                                  &binaryLen);
-        if (LE_OK != result)
-        {
-            LE_ERROR("ERROR decoding default value: %s", LE_RESULT_TXT(result));
-        }
+    le_result_t result = ni_GetNodeValueBinary(iteratorRef,
+                                               pathPtr,
+                                               binaryBuf,
+                                               &binaryLen,
+                                               defaultValuePtr,
+                                               defaultValueSize);
+    LE_ERROR_IF(result == LE_FORMAT_ERROR, "ERROR decoding binary data.");
 
-        // Send back the decoded value
-        le_cfg_QuickGetBinaryRespond(commandRef, result, binaryBuf, binaryLen);
-    }
+    le_cfg_QuickGetBinaryRespond(commandRef, result, binaryBuf, binaryLen);
 
     ni_Release(iteratorRef);
-    le_mem_Release(stringBuf);
     le_mem_Release(binaryBuf);
-    le_mem_Release(defaultStringBuf);
 }
 
 
@@ -173,10 +173,10 @@ void rq_HandleQuickGetString
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Write a string or binary value to a node in the tree.
+ *  Write a string value to a node in the tree.
  */
 // -------------------------------------------------------------------------------------------------
-void rq_HandleQuickSetData
+void rq_HandleQuickSetString
 (
     le_msg_SessionRef_t sessionRef,    ///< [IN] The session this request occured on.
     le_cfg_ServerCmdRef_t commandRef,  ///< [IN] This handle is used to generate the reply for this
@@ -184,9 +184,26 @@ void rq_HandleQuickSetData
     tu_UserRef_t userRef,              ///< [IN] The user that's requesting the action.
     tdb_TreeRef_t treeRef,             ///< [IN] The tree that we're peforming the action on.
     const char* pathPtr,               ///< [IN] The path to the node to access.
-    const char* valuePtr,              ///< [IN] The value to set.
-    RequestType_t reqType              ///< [IN] Request type: whether this a string or
-                                       ///<      an encoded binary data.
+    const char* valuePtr               ///< [IN] The value to set.
+);
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a binary value to a node in the tree.
+ */
+// -------------------------------------------------------------------------------------------------
+void rq_HandleQuickSetBinary
+(
+    le_msg_SessionRef_t sessionRef,    ///< [IN] The session this request occured on.
+    le_cfg_ServerCmdRef_t commandRef,  ///< [IN] This handle is used to generate the reply for this
+                                       ///<      message.
+    tu_UserRef_t userRef,              ///< [IN] The user that's requesting the action.
+    tdb_TreeRef_t treeRef,             ///< [IN] The tree that we're peforming the action on.
+    const char* pathPtr,               ///< [IN] The path to the node to access.
+    const uint8_t* valuePtr,           ///< [IN] The value to set.
+    size_t valueSize                   ///< [IN] Size of the value.
 );
 
 
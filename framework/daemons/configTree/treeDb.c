@@ -68,6 +68,19 @@
  *  Shadow Trees don't have handlers, request queues, write iterator references or read iterator
  *  counts.
  *
+ *  <b>Tree Files:</b>
+ *
+ *  Trees are persisted as a stream of tokens: '~' for an empty value, !t or !f for a bool, [int],
+ *  (float), "string" and { "name" value ... } for a stem.
+ *
+ *  How binary values are stored depends on LE_CONFIG_CFGTREE_FORMAT_VERSION.  With format 1, they
+ *  are base64 encoded into string nodes, which all the versions of the daemon can read.  With
+ *  format 2, they are kept in binary nodes and stored as #<size>:<raw bytes>, so that they are
+ *  neither encoded nor escaped.  Daemons built before format 2 existed can't read these tokens, so
+ *  a format 2 daemon creates a marker file before it first writes one.  When a format 1 daemon
+ *  finds this marker, it loads all the trees and writes back the ones holding binary nodes with
+ *  their values as strings, then deletes the marker.  Older daemons can then be installed.
+ *
  *  <b>Event Handler Registration:</b>
  *
  *  The config tree allows clients to register callbacks to be notified if certian sections of a
@@ -325,6 +338,7 @@ typedef enum
     TT_INT_VALUE,       ///< Signed integer.
     TT_FLOAT_VALUE,     ///< Floating point number.
     TT_STRING_VALUE,    ///< UTF-8 text string.
+    TT_BINARY_VALUE,    ///< Raw binary data.
     TT_OPEN_GROUP,      ///< Start of grouping.
     TT_CLOSE_GROUP      ///< End of grouping.
 }
@@ -394,6 +408,16 @@ LE_MEM_DEFINE_STATIC_POOL(EncodedString, LE_CONFIG_CFGTREE_MAX_ENCODED_STRING_PO
 le_mem_PoolRef_t EncodedStringPool = NULL;
 
 
+/// File created before binary values are first written as #<size>:<raw bytes> tokens.
+#define RAW_BINARY_MARKER_PATH  CFG_TREE_PATH "/.rawBinary"
+
+/// Set when a tree file holds binary values which are to be stored back as strings.
+static bool HasRawBinary = false;
+
+/// Set when a tree holding binary values couldn't be stored back with the values as strings.
+static bool IsRawBinaryLeft = false;
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Clear all flags from the given node.
@@ -608,6 +632,7 @@ static void NodeDestructor
         case LE_CFG_TYPE_BOOL:
         case LE_CFG_TYPE_INT:
         case LE_CFG_TYPE_FLOAT:
+        case LE_CFG_TYPE_BINARY:
             if (nodeRef->info.valueRef)
             {
                 dstr_Release(nodeRef->info.valueRef);
@@ -960,9 +985,9 @@ static bool NodeExists
 
 // -------------------------------------------------------------------------------------------------
 /**
- *  Check the given node type and see if it should have a string value.
+ *  Check the given node type and see if it should have a string or binary value.
  *
- *  @return True if the given node could hold a string value.  False if not.
+ *  @return True if the given node could hold a value string.  False if not.
  */
 // -------------------------------------------------------------------------------------------------
 static bool IsStringType
@@ -976,7 +1001,8 @@ static bool IsStringType
     if (   (type == LE_CFG_TYPE_STRING)
         || (type == LE_CFG_TYPE_BOOL)
         || (type == LE_CFG_TYPE_INT)
-        || (type == LE_CFG_TYPE_FLOAT))
+        || (type == LE_CFG_TYPE_FLOAT)
+        || (type == LE_CFG_TYPE_BINARY))
     {
         return true;
     }
@@ -1745,6 +1771,28 @@ static bool TreeFileExists
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Call this function to delete a tree file from the filesystem.
+ */
+// -------------------------------------------------------------------------------------------------
+static void DeleteTreeFile
+(
+    const char* filePathPtr  ///< Path to the tree file in question.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_DEBUG("** Deleting tree file, '%s'.", filePathPtr);
+
+    if (unlink(filePathPtr) != 0)
+    {
+        LE_ERROR("File delete failure, '%s', reason '%m'.", filePathPtr);
+    }
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  * Check the filesystem and get the current "valid" version of the file and update the tree object
@@ -2080,6 +2128,72 @@ static le_result_t ReadStringToken
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read a binary value from the config tree file.  The value is stored as its size in decimal, a
+ *  ':' and then the raw bytes.
+ *
+ *  @return LE_OK if the data is read from the file.
+ *          LE_FORMAT_ERROR if the data fails to be read from the file.
+ *          LE_OVERFLOW if the data doesn't fit in provided buffer (truncated).
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t ReadBinaryToken
+(
+    FILE* filePtr,      ///< [IN]  The file we're reading from.
+    uint8_t* dataPtr,   ///< [OUT] Buffer to hold the data we've read.
+    size_t dataMax,     ///< [IN]  How big is the supplied buffer?
+    size_t* dataSizePtr ///< [OUT] The number of bytes read into the buffer.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    size_t size = 0;
+    int next;
+
+    while ((next = fgetc(filePtr)) != ':')
+    {
+        if (   (next < '0')
+            || (next > '9')
+            || (size > LE_CFG_BINARY_LEN))
+        {
+            LE_ERROR("Bad size in binary value.");
+            return LE_FORMAT_ERROR;
+        }
+
+        size = (size * 10) + (next - '0');
+    }
+
+    if (dataMax > LE_CFG_BINARY_LEN)
+    {
+        dataMax = LE_CFG_BINARY_LEN;
+    }
+
+    *dataSizePtr = (size < dataMax) ? size : dataMax;
+
+    if (fread(dataPtr, 1, *dataSizePtr, filePtr) != *dataSizePtr)
+    {
+        LE_ERROR("Unexpected EOF in binary value.");
+        return LE_FORMAT_ERROR;
+    }
+
+    if (size > *dataSizePtr)
+    {
+        LE_ERROR("Binary value is too large.  (%" PRIuS "/%" PRIuS ")", size, dataMax);
+
+        if (fseek(filePtr, size - *dataSizePtr, SEEK_CUR) != 0)
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        return LE_OVERFLOW;
+    }
+
+    return LE_OK;
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Read a token from the input stream.
@@ -2093,11 +2207,13 @@ static le_result_t ReadToken
     FILE* filePtr,         ///< [IN]  The file we're reading from.
     char* stringPtr,       ///< [OUT] String buffer to hold the token we've read.
     size_t stringSize,     ///< [IN]  How big is the supplied string buffer?
-    TokenType_t* typePtr   ///< [OUT] The type of token read from the file.
+    TokenType_t* typePtr,  ///< [OUT] The type of token read from the file.
+    size_t* dataSizePtr    ///< [OUT] For binary values, the number of bytes read into the buffer.
 )
 // -------------------------------------------------------------------------------------------------
 {
     *stringPtr = 0;
+    *dataSizePtr = 0;
 
     if (SkipWhiteSpace(filePtr) != LE_OK)
     {
@@ -2130,6 +2246,10 @@ static le_result_t ReadToken
                 *typePtr = TT_STRING_VALUE;
                 return ReadStringToken(filePtr, stringPtr, stringSize);
 
+            case '#':
+                *typePtr = TT_BINARY_VALUE;
+                return ReadBinaryToken(filePtr, (uint8_t*)stringPtr, stringSize, dataSizePtr);
+
             case '{':
                 *typePtr = TT_OPEN_GROUP;
                 return LE_OK;
@@ -2234,6 +2354,64 @@ static le_result_t WriteStringValue
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Write a binary value token to the output stream: its size, a ':' and the raw bytes.
+ *
+ *  @return LE_OK if the write succeeded, LE_IO_ERROR if the write failed.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t WriteBinaryValue
+(
+    FILE* filePtr,         ///< [IN] The file to write to.
+    tdb_NodeRef_t nodeRef  ///< [IN] The binary node to write.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    static bool isMarked = false;
+
+    // Tell format 1 daemons to store the binary values back as strings, should they be installed.
+    if (!isMarked)
+    {
+        int fd = open(RAW_BINARY_MARKER_PATH, O_WRONLY | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+
+        if (fd < 0)
+        {
+            LE_ERROR("Could not create '%s': %m", RAW_BINARY_MARKER_PATH);
+            return LE_IO_ERROR;
+        }
+
+        close(fd);
+        isMarked = true;
+    }
+
+    uint8_t* dataPtr = le_mem_ForceAlloc(BinaryDataPool);
+    size_t dataSize = LE_CFG_BINARY_LEN;
+    char header[SMALL_STR];
+
+    tdb_GetValueAsBinary(nodeRef, dataPtr, &dataSize, NULL, 0);
+    snprintf(header, sizeof(header), "#%" PRIuS ":", dataSize);
+
+    le_result_t result = WriteFile(filePtr, header, strlen(header));
+
+    if (result == LE_OK)
+    {
+        result = WriteFile(filePtr, dataPtr, dataSize);
+    }
+
+    if (result == LE_OK)
+    {
+        result = WriteFile(filePtr, " ", 1);
+    }
+
+    le_mem_Release(dataPtr);
+
+    return result;
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Read a node value from the given file.  If the value is a collection, then read in those nodes
@@ -2257,9 +2435,10 @@ static le_result_t InternalReadNode
     le_result_t result = LE_OK;
 
     TokenType_t tokenType;
+    size_t dataSize;
 
     // Try to read this node's value.
-    result = ReadToken(filePtr, stringBuffer, stringBufferSize, &tokenType);
+    result = ReadToken(filePtr, stringBuffer, stringBufferSize, &tokenType, &dataSize);
     if ((result != LE_OK) && (result != LE_OVERFLOW))
     {
         LE_ERROR("Unexpected EOF or bad token in file.");
@@ -2293,6 +2472,12 @@ static le_result_t InternalReadNode
             tdb_SetValueAsString(nodeRef, stringBuffer);
             break;
 
+        case TT_BINARY_VALUE:
+            // With format 1, the value is stored as a string, so the file has to be written back.
+            tdb_SetValueAsBinary(nodeRef, (uint8_t*)stringBuffer, dataSize);
+            HasRawBinary = HasRawBinary || (LE_CONFIG_CFGTREE_FORMAT_VERSION < 2);
+            break;
+
         case TT_EMPTY_VALUE:
             // The node has already been cleared, so there's nothing left to do but make sure that
             // the node exists.
@@ -2302,7 +2487,11 @@ static le_result_t InternalReadNode
         case TT_OPEN_GROUP:
             while (tokenType != TT_CLOSE_GROUP)
             {
-                if (ReadToken(filePtr, stringBuffer, stringBufferSize, &tokenType) != LE_OK)
+                if (ReadToken(filePtr,
+                              stringBuffer,
+                              stringBufferSize,
+                              &tokenType,
+                              &dataSize) != LE_OK)
                 {
                     LE_ERROR("Unexpected EOF or bad token in file while looking for '}'.");
                     result = LE_FORMAT_ERROR;
@@ -2411,12 +2600,15 @@ static le_result_t InternalWriteNode
         return WriteFile(filePtr, "~ ", 2);
     }
 
-    // Get the node's value as a string.
+    // Get the node's value as a string, binary values are written as they are.
     char* stringBuffer = le_mem_ForceAlloc(EncodedStringPool);
     size_t stringBufferSize = TDB_MAX_ENCODED_SIZE;
     le_result_t result = LE_OK;
 
-    tdb_GetValueAsString(nodeRef, stringBuffer, stringBufferSize, "");
+    if (nodeRef->type != LE_CFG_TYPE_BINARY)
+    {
+        tdb_GetValueAsString(nodeRef, stringBuffer, stringBufferSize, "");
+    }
 
     // Now, depending on the type of node, write out any required format information.
     switch (nodeRef->type)
@@ -2445,6 +2637,10 @@ static le_result_t InternalWriteNode
             result = WriteStringValue(filePtr, '(', ')', stringBuffer);
             break;
 
+        case LE_CFG_TYPE_BINARY:
+            result = WriteBinaryValue(filePtr, nodeRef);
+            break;
+
         // Looks like this node is a collection, so write out it's child nodes now.
         case LE_CFG_TYPE_STEM:
             if ((result = WriteFile(filePtr, "{ ", 2)) == LE_OK)
@@ -2536,6 +2732,77 @@ static void IncrementRevision
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Serialize a tree to a new revision of its tree file, and delete the previous revision.
+ *
+ *  @return LE_OK if the tree is written, LE_IO_ERROR if it isn't.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t SaveTree
+(
+    tdb_TreeRef_t treeRef  ///< [IN] The tree to write to the filesystem.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    // Increment revision of the tree and open a tree file for writing.
+    int oldId = treeRef->revisionId;
+
+    IncrementRevision(treeRef);
+
+    char filePath[LE_CFG_STR_LEN_BYTES] = "";
+    GetTreePath(treeRef->name, treeRef->revisionId, filePath, sizeof(filePath));
+
+    LE_DEBUG("Attempting to serialize the tree to '%s'.", filePath);
+
+    FILE* filePtr = NULL;
+
+    filePtr = fopen(filePath, "w+");
+
+    if (!filePtr && (EROFS == errno))
+    {
+        // In case we are R/O for the config tree, we discard the update to flash
+        return LE_IO_ERROR;
+    }
+
+    if (!filePtr)
+    {
+        LE_EMERG("Failed to open config file '%s' (%m).", filePath);
+        LE_EMERG("Changes have been merged in memory, however they could not be committed to the "
+                 "filesystem!!");
+        return LE_IO_ERROR;
+    }
+
+    // We have a tree file to write to, so stream the new tree to it then close the output file.
+    le_result_t writeResult = tdb_WriteTreeNode(treeRef->rootNodeRef, filePtr);
+
+    int retVal = fclose(filePtr);
+    LE_EMERG_IF(retVal == EOF,
+                "An error occurred while closing the tree file: %s", LE_ERRNO_TXT(errno));
+
+    // Finally remove the old version of the tree file, if there is one.
+    if (writeResult == LE_OK)
+    {
+        if (   (oldId != 0)
+            && (TreeFileExists(treeRef->name, oldId)))
+        {
+            GetTreePath(treeRef->name, oldId, filePath, sizeof(filePath));
+            DeleteTreeFile(filePath);
+        }
+    }
+    else
+    {
+        // The write failed, delete the new file we attempted to create.
+        LE_EMERG("The attempt to write to the config tree file, '%s,' failed.", filePath);
+        DeleteTreeFile(filePath);
+    }
+
+    return writeResult;
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Attempt to load a configuration tree from a config file.  This function will look for the latest
@@ -2582,14 +2849,28 @@ static void LoadTree
         }
         else
         {
+            HasRawBinary = false;
+
             if (tdb_ReadTreeNode(treeRef->rootNodeRef, fileRef) == false)
             {
                 LE_ERROR("Could not parse configuration tree file: %s.", pathPtr);
                 le_mem_Release(treeRef->rootNodeRef);
                 treeRef->rootNodeRef = NewNode();
+                HasRawBinary = false;
             }
 
             fclose(fileRef);
+
+            // Store the binary values back as strings, so that older daemons can read the tree.
+            if (HasRawBinary)
+            {
+                LE_INFO("Writing back configuration tree '%s' with format 1.", treeRef->name);
+
+                if (SaveTree(treeRef) != LE_OK)
+                {
+                    IsRawBinaryLeft = true;
+                }
+            }
         }
     }
 }
@@ -2682,28 +2963,6 @@ static bool OnHandlerRegistrationCleanup
 
 
 
-// -------------------------------------------------------------------------------------------------
-/**
- *  Call this function to delete a tree file from the filesystem.
- */
-// -------------------------------------------------------------------------------------------------
-static void DeleteTreeFile
-(
-    const char* filePathPtr  ///< Path to the tree file in question.
-)
-// -------------------------------------------------------------------------------------------------
-{
-    LE_DEBUG("** Deleting tree file, '%s'.", filePathPtr);
-
-    if (unlink(filePathPtr) != 0)
-    {
-        LE_ERROR("File delete failure, '%s', reason '%m'.", filePathPtr);
-    }
-}
-
-
-
-
 // -------------------------------------------------------------------------------------------------
 /**
  *  Find the root node represented by the path ref.
@@ -2735,6 +2994,72 @@ static tdb_NodeRef_t GetPathBaseNodeRef
 }
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  If a format 2 daemon left binary values in the tree files, load all the trees so that the ones
+ *  holding such values are written back with the values as strings.  The marker file is deleted
+ *  once all of them are.
+ */
+// -------------------------------------------------------------------------------------------------
+static void ConvertRawBinaryTrees
+(
+    void
+)
+// -------------------------------------------------------------------------------------------------
+{
+    if (access(RAW_BINARY_MARKER_PATH, F_OK) != 0)
+    {
+        return;
+    }
+
+    DIR* dirPtr = opendir(CFG_TREE_PATH);
+
+    if (dirPtr == NULL)
+    {
+        LE_ERROR("Could not open configTree dir, '%s': %m", CFG_TREE_PATH);
+        return;
+    }
+
+    LE_INFO("Looking for binary values to store as strings in the configuration trees.");
+    IsRawBinaryLeft = false;
+
+    struct dirent* dirEntryPtr;
+
+    while ((dirEntryPtr = readdir(dirPtr)) != NULL)
+    {
+        char* dotStrPtr = strrchr(dirEntryPtr->d_name, '.');
+        char treeName[MAX_TREE_NAME_BYTES] = "";
+
+        if (   (dotStrPtr == NULL)
+            || (   (strcmp(dotStrPtr, ".paper") != 0)
+                && (strcmp(dotStrPtr, ".rock") != 0)
+                && (strcmp(dotStrPtr, ".scissors") != 0)))
+        {
+            continue;
+        }
+
+        // Trees which are already loaded are not loaded again.
+        if (le_utf8_CopyUpToSubStr(treeName,
+                                   dirEntryPtr->d_name,
+                                   dotStrPtr,
+                                   sizeof(treeName),
+                                   NULL) == LE_OK)
+        {
+            tdb_GetTree(treeName);
+        }
+    }
+
+    closedir(dirPtr);
+
+    if (!IsRawBinaryLeft)
+    {
+        DeleteTreeFile(RAW_BINARY_MARKER_PATH);
+    }
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Initialize the tree DB subsystem, and automaticly load the system tree from the filesystem.
@@ -2786,6 +3111,11 @@ void tdb_Init
 
     // Preload the system tree.
     tdb_GetTree("system");
+
+    if (LE_CONFIG_CFGTREE_FORMAT_VERSION < 2)
+    {
+        ConvertRawBinaryTrees();
+    }
 }
 
 
@@ -3141,58 +3471,8 @@ void tdb_MergeTree
     // Now, go through and call the triggered callbacks.
     FireTriggeredCallbacks();
 
-    // Now increment revision of the tree and open a tree file for writing.
-    tdb_TreeRef_t originalTreeRef = shadowTreeRef->originalTreeRef;
-    int oldId = originalTreeRef->revisionId;
-
-    IncrementRevision(originalTreeRef);
-
-    char filePath[LE_CFG_STR_LEN_BYTES] = "";
-    GetTreePath(originalTreeRef->name, originalTreeRef->revisionId, filePath, sizeof(filePath));
-
-    LE_DEBUG("Changes merged, now attempting to serialize the tree to '%s'.", filePath);
-
-    FILE* filePtr = NULL;
-
-    filePtr = fopen(filePath, "w+");
-
-    if (!filePtr && (EROFS == errno))
-    {
-        // In case we are R/O for the config tree, we discard the update to flash
-        return;
-    }
-
-    if (!filePtr)
-    {
-        LE_EMERG("Failed to open config file '%s' (%m).", filePath);
-        LE_EMERG("Changes have been merged in memory, however they could not be committed to the "
-                 "filesystem!!");
-        return;
-    }
-
-    // We have a tree file to write to, so stream the new tree to it then close the output file.
-    le_result_t writeResult = tdb_WriteTreeNode(originalTreeRef->rootNodeRef, filePtr);
-
-    int retVal = fclose(filePtr);
-    LE_EMERG_IF(retVal == EOF,
-                "An error occurred while closing the tree file: %s", LE_ERRNO_TXT(errno));
-
-    // Finally remove the old version of the tree file, if there is one.
-    if (writeResult == LE_OK)
-    {
-        if (   (oldId != 0)
-            && (TreeFileExists(originalTreeRef->name, oldId)))
-        {
-            GetTreePath(originalTreeRef->name, oldId, filePath, sizeof(filePath));
-            DeleteTreeFile(filePath);
-        }
-    }
-    else
-    {
-        // The write failed, delete the new file we attempted to create.
-        LE_EMERG("The attempt to write to the config tree file, '%s,' failed.", filePath);
-        DeleteTreeFile(filePath);
-    }
+    // Now write the updated tree out.
+    SaveTree(shadowTreeRef->originalTreeRef);
 }
 
 
@@ -3955,6 +4235,19 @@ le_result_t tdb_GetValueAsString
         return le_utf8_Copy(stringPtr, defaultPtr, maxSize, NULL);
     }
 
+    // Binary values are handed out base64 encoded, the way they used to be stored.
+    if (type == LE_CFG_TYPE_BINARY)
+    {
+        uint8_t* dataPtr = le_mem_ForceAlloc(BinaryDataPool);
+        size_t dataSize = LE_CFG_BINARY_LEN;
+
+        tdb_GetValueAsBinary(nodeRef, dataPtr, &dataSize, NULL, 0);
+        le_result_t result = le_base64_Encode(dataPtr, dataSize, stringPtr, &maxSize);
+
+        le_mem_Release(dataPtr);
+        return result;
+    }
+
     // Check to see if we have the value locally, or if we need to go back to the original node for
     // the value.
     if (nodeRef->info.valueRef == NULL)
@@ -4019,6 +4312,125 @@ void tdb_SetValueAsString
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read the given node's binary value.  String values are taken to be base64 encoded binary data,
+ *  which is how binary values used to be stored.
+ *
+ *  @return LE_OK if the value is copied ok.
+ *          LE_OVERFLOW if the value can not fit in the supplied buffer.
+ *          LE_FORMAT_ERROR if a string value can not be decoded.
+ */
+// -------------------------------------------------------------------------------------------------
+le_result_t tdb_GetValueAsBinary
+(
+    tdb_NodeRef_t nodeRef,       ///< [IN]     The node object to read.
+    uint8_t* dataPtr,            ///< [OUT]    Target buffer for the value.
+    size_t* dataSizePtr,         ///< [IN/OUT] Size of the buffer on the way in, size of the value
+                                 ///<          on the way out.
+    const uint8_t* defaultPtr,   ///< [IN]     Default value to use in the event that the requested
+                                 ///<          value doesn't exist or isn't binary.
+    size_t defaultSize           ///< [IN]     Size of the default value.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(nodeRef != NULL);
+
+    switch (tdb_GetNodeType(nodeRef))
+    {
+        case LE_CFG_TYPE_BINARY:
+            if (nodeRef->info.valueRef == NULL)
+            {
+                LE_ASSERT(IsShadow(nodeRef) && (nodeRef->shadowRef != NULL));
+                return dstr_CopyToBytes(dataPtr, dataSizePtr, nodeRef->shadowRef->info.valueRef);
+            }
+            return dstr_CopyToBytes(dataPtr, dataSizePtr, nodeRef->info.valueRef);
+
+        case LE_CFG_TYPE_STRING:
+            {
+                char* stringPtr = le_mem_ForceAlloc(EncodedStringPool);
+                le_result_t result = tdb_GetValueAsString(nodeRef,
+                                                          stringPtr,
+                                                          TDB_MAX_ENCODED_SIZE,
+                                                          "");
+                if (result == LE_OK)
+                {
+                    result = le_base64_Decode(stringPtr, strlen(stringPtr), dataPtr, dataSizePtr);
+                }
+
+                le_mem_Release(stringPtr);
+                return result;
+            }
+
+        default:
+            if (defaultSize > *dataSizePtr)
+            {
+                return LE_OVERFLOW;
+            }
+
+            if (defaultSize > 0)
+            {
+                memcpy(dataPtr, defaultPtr, defaultSize);
+            }
+            *dataSizePtr = defaultSize;
+            return LE_OK;
+    }
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Set the given node to a binary value, stored as is with format 2, or base64 encoded in a string
+ *  with format 1.  If the given node is a stem then all children will be lost.
+ */
+// -------------------------------------------------------------------------------------------------
+void tdb_SetValueAsBinary
+(
+    tdb_NodeRef_t nodeRef,   ///< [IN] The node to set.
+    const uint8_t* dataPtr,  ///< [IN] The value to write to the node.
+    size_t dataSize          ///< [IN] Size of the value.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(nodeRef != NULL);
+
+    // With format 1, binary values are stored base64 encoded in string nodes.
+    if (LE_CONFIG_CFGTREE_FORMAT_VERSION < 2)
+    {
+        char* stringPtr = le_mem_ForceAlloc(EncodedStringPool);
+        size_t stringSize = TDB_MAX_ENCODED_SIZE;
+
+        LE_ASSERT(le_base64_Encode(dataPtr, dataSize, stringPtr, &stringSize) == LE_OK);
+        tdb_SetValueAsString(nodeRef, stringPtr);
+
+        le_mem_Release(stringPtr);
+        return;
+    }
+
+    if (nodeRef->type != LE_CFG_TYPE_EMPTY)
+    {
+        tdb_SetEmpty(nodeRef);
+        nodeRef->info.valueRef = NULL;
+    }
+
+    nodeRef->type = LE_CFG_TYPE_BINARY;
+
+    if (nodeRef->info.valueRef == NULL)
+    {
+        nodeRef->info.valueRef = dstr_New();
+    }
+
+    dstr_CopyFromBytes(nodeRef->info.valueRef, dataPtr, dataSize);
+
+    SetModifiedFlag(nodeRef);
+    tdb_EnsureExists(nodeRef);
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Read the given node and interpret it as a boolean value.
@@ -556,6 +556,47 @@ void tdb_SetValueAsString
 
 
 
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read the given node's binary value.  String values are taken to be base64 encoded binary data,
+ *  which is how binary values used to be stored.
+ *
+ *  @return LE_OK if the value is copied ok.
+ *          LE_OVERFLOW if the value can not fit in the supplied buffer.
+ *          LE_FORMAT_ERROR if a string value can not be decoded.
+ */
+// -------------------------------------------------------------------------------------------------
+le_result_t tdb_GetValueAsBinary
+(
+    tdb_NodeRef_t nodeRef,       ///< [IN]     The node object to read.
+    uint8_t* dataPtr,            ///< [OUT]    Target buffer for the value.
+    size_t* dataSizePtr,         ///< [IN/OUT] Size of the buffer on the way in, size of the value
+                                 ///<          on the way out.
+    const uint8_t* defaultPtr,   ///< [IN]     Default value to use in the event that the requested
+                                 ///<          value doesn't exist or isn't binary.
+    size_t defaultSize           ///< [IN]     Size of the default value.
+);
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Set the given node to a binary value, stored as is.  If the given node is a stem then all
+ *  children will be lost.
+ */
+// -------------------------------------------------------------------------------------------------
+void tdb_SetValueAsBinary
+(
+    tdb_NodeRef_t nodeRef,   ///< [IN] The node to set.
+    const uint8_t* dataPtr,  ///< [IN] The value to write to the node.
+    size_t dataSize          ///< [IN] Size of the value.
+);
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Read the given node and interpret it as a boolean value.
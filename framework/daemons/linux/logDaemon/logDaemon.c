@@ -63,6 +63,7 @@
  */
 
 #include "legato.h"
+#include "interfaces.h"
 
 #include "logDaemon.h"
 
@@ -71,6 +72,11 @@
 #include "linux/logPlatform.h"
 #include "log.h"
 
+#if LE_CONFIG_LOG_STORE
+#include "logStore.h"
+#include "smack.h"
+#endif
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Maximum number of processes that we expect to see.  Used to set the hashmap and pool sizes.
@@ -2461,6 +2467,659 @@ static void ForgetProcess
 
 
 
+#if LE_CONFIG_LOG_STORE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Interval between syncs of the log store.  Messages at least as severe as STORE_SYNC_LEVEL are
+ * synced right away.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STORE_SYNC_INTERVAL_MS      5000
+#define STORE_SYNC_LEVEL            LE_LOG_CRIT
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of datagrams read from the log store socket in one go, so that a flood of
+ * messages doesn't starve the log control services.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_STORE_DGRAMS_PER_EVENT  32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of messages sent to the log control tool for one query.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_QUERY_LINES             1000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer a stored message is formatted into, enough for the longest message.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STORED_LINE_BYTES           (LOG_STORE_MAX_DGRAM_BYTES + LIMIT_MAX_PROCESS_NAME_BYTES + 64)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The log store, or NULL if it could not be opened.
+ */
+//--------------------------------------------------------------------------------------------------
+static logStore_Ref_t StoreRef = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Least severe level of the messages kept in the log store (LE_CONFIG_LOG_STORE_LEVEL).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_log_Level_t StoreLevel = LE_LOG_INFO;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Monitor of the socket through which processes send messages to the log store, or NULL if
+ * processes can't send messages to the store.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_fdMonitor_Ref_t StoreMonitorRef = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * State of a log store query.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_msg_SessionRef_t toolIpcSessionRef;  ///< Log control tool's IPC session.
+    size_t lineCount;                       ///< Number of messages sent to the tool.
+    bool isTruncated;                       ///< true if there were more matching messages.
+}
+StoreQuery_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * State of a log store query made through the le_logStore API.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    FILE* filePtr;                          ///< File the messages are written to.
+    size_t lineCount;                       ///< Number of messages written to the file.
+    bool isTruncated;                       ///< true if there were more matching messages.
+    bool isFailed;                          ///< true if a message couldn't be written.
+}
+StoreFileQuery_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the current time, in microseconds since the Epoch.
+ *
+ * @return The time.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetTimeUs
+(
+    void
+)
+{
+    le_clk_Time_t now = le_clk_GetAbsoluteTime();
+
+    return (uint64_t)now.sec * 1000000 + now.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a message to the log store.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StoreMessage
+(
+    uint64_t timeUs,            ///< [IN] Time of the message, in microseconds since the Epoch.
+    le_log_Level_t level,       ///< [IN] Severity level.
+    const char* procNamePtr,    ///< [IN] Process name.
+    pid_t pid,                  ///< [IN] PID of the process.
+    const char* compNamePtr,    ///< [IN] Component name, empty if not known.
+    const char* msgPtr          ///< [IN] Message.
+)
+{
+    logStore_Record_t record =
+    {
+        .timeUs = timeUs,
+        .level = level,
+        .pid = pid,
+        .procNamePtr = procNamePtr,
+        .compNamePtr = compNamePtr,
+        .msgPtr = msgPtr,
+    };
+
+    if ((StoreRef == NULL) || (level < StoreLevel))
+    {
+        return;
+    }
+
+    if ((logStore_Append(StoreRef, &record) == LE_OK) && (level >= STORE_SYNC_LEVEL))
+    {
+        logStore_Sync(StoreRef);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the messages sent by processes to the log store socket and stores them.
+ *
+ * The sender of each message is identified by the credentials the kernel attaches to it: only the
+ * messages of the components registered with the daemon are stored, under the name of their
+ * process.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StoreSocketHandler
+(
+    int   fd,
+    short events
+)
+{
+    int i;
+
+    if (!(events & POLLIN))
+    {
+        LE_ERROR("Unexpected events %d on the log store socket.", events);
+        return;
+    }
+
+    for (i = 0; i < MAX_STORE_DGRAMS_PER_EVENT; i++)
+    {
+        // One more word, so that there is room for a terminator after the longest datagram.
+        uint64_t buffer[LOG_STORE_MAX_DGRAM_BYTES / sizeof(uint64_t) + 1];
+        const LogStoreMsgHeader_t* headerPtr = (const LogStoreMsgHeader_t*)buffer;
+        union
+        {
+            struct cmsghdr header;
+            char bytes[CMSG_SPACE(sizeof(struct ucred))];
+        }
+        control;
+        struct iovec iov = { .iov_base = buffer, .iov_len = LOG_STORE_MAX_DGRAM_BYTES };
+        struct msghdr msgHeader =
+        {
+            .msg_iov = &iov,
+            .msg_iovlen = 1,
+            .msg_control = control.bytes,
+            .msg_controllen = sizeof(control.bytes),
+        };
+        struct cmsghdr* cmsgPtr;
+        struct ucred cred;
+        RunningProcess_t* procPtr;
+        const char* endPtr;
+        const char* compNamePtr;
+        const char* msgPtr;
+
+        ssize_t count = recvmsg(fd, &msgHeader, MSG_DONTWAIT);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+            {
+                LE_ERROR("Failed to read from the log store socket: %m.");
+            }
+            break;
+        }
+
+        cmsgPtr = CMSG_FIRSTHDR(&msgHeader);
+        if ((cmsgPtr == NULL) || (msgHeader.msg_flags & MSG_CTRUNC) ||
+            (cmsgPtr->cmsg_level != SOL_SOCKET) || (cmsgPtr->cmsg_type != SCM_CREDENTIALS) ||
+            (cmsgPtr->cmsg_len != CMSG_LEN(sizeof(cred))))
+        {
+            LE_WARN("Dropped log store message without credentials.");
+            continue;
+        }
+        memcpy(&cred, CMSG_DATA(cmsgPtr), sizeof(cred));
+
+        // Messages of unknown processes are dropped quietly, so that they can't flood the logs.
+        procPtr = FindProcessByPid(cred.pid);
+        if ((procPtr == NULL) || (procPtr->procNameObjPtr == NULL))
+        {
+            LE_DEBUG("Dropped log store message from unregistered PID %d.", (int)cred.pid);
+            continue;
+        }
+
+        endPtr = (const char*)buffer + count;
+        *(char*)endPtr = '\0';
+
+        compNamePtr = (const char*)(headerPtr + 1);
+        if ((count < (ssize_t)sizeof(*headerPtr)) || (headerPtr->level > LE_LOG_EMERG))
+        {
+            LE_WARN("Dropped malformed log store message from PID %d.", (int)cred.pid);
+            continue;
+        }
+
+        msgPtr = compNamePtr + strlen(compNamePtr) + 1;
+        if (msgPtr > endPtr)
+        {
+            LE_WARN("Dropped malformed log store message from PID %d.", (int)cred.pid);
+            continue;
+        }
+
+        if (FindLogSession(procPtr, compNamePtr) == NULL)
+        {
+            LE_DEBUG("Dropped log store message from unregistered component '%s' of PID %d.",
+                     compNamePtr, (int)cred.pid);
+            continue;
+        }
+
+        StoreMessage(headerPtr->timeUs, headerPtr->level, procPtr->procNameObjPtr->name, cred.pid,
+                     compNamePtr, msgPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Syncs the log store periodically.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StoreSyncTimerHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    logStore_Sync(StoreRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens the log store and the socket through which processes send messages to it.  The store is
+ * disabled if it can't be opened.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InitStore
+(
+    void
+)
+{
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    le_timer_Ref_t timerRef;
+    int passCred = 1;
+    int fd;
+
+    StoreLevel = log_StrToSeverityLevel(LE_CONFIG_LOG_STORE_LEVEL);
+    LE_ASSERT(StoreLevel != (le_log_Level_t)-1);
+
+    StoreRef = logStore_Open(LE_CONFIG_LOG_STORE_PATH, LE_CONFIG_LOG_STORE_SIZE * 1024);
+    if (StoreRef == NULL)
+    {
+        LE_ERROR("Log store disabled.");
+        return;
+    }
+
+    timerRef = le_timer_Create("LogStoreSync");
+    LE_ASSERT_OK(le_timer_SetMsInterval(timerRef, STORE_SYNC_INTERVAL_MS));
+    LE_ASSERT_OK(le_timer_SetRepeat(timerRef, 0));
+    LE_ASSERT_OK(le_timer_SetHandler(timerRef, StoreSyncTimerHandler));
+    LE_ASSERT_OK(le_timer_Start(timerRef));
+
+    LE_ASSERT(le_utf8_Copy(addr.sun_path, LOG_STORE_SOCKET_PATH, sizeof(addr.sun_path),
+                           NULL) == LE_OK);
+
+    fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+    {
+        LE_ERROR("Failed to create the log store socket: %m.");
+        return;
+    }
+
+    if ((unlink(addr.sun_path) != 0) && (errno != ENOENT))
+    {
+        LE_WARN("Couldn't unlink '%s': %m.", addr.sun_path);
+    }
+
+    // Any process may write to the socket: the kernel credentials of each message tell who sent it.
+    if ((setsockopt(fd, SOL_SOCKET, SO_PASSCRED, &passCred, sizeof(passCred)) != 0) ||
+        (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) ||
+        (chmod(addr.sun_path, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH) != 0))
+    {
+        LE_ERROR("Failed to set up the log store socket '%s': %m.", addr.sun_path);
+        fd_Close(fd);
+        return;
+    }
+    smack_SetLabel(addr.sun_path, "*");
+
+    StoreMonitorRef = le_fdMonitor_Create("LogStore", fd, StoreSocketHandler, POLLIN);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tells a client the least severe level of the messages to send to the log store.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendStoreLevel
+(
+    le_msg_SessionRef_t ipcSessionRef,  ///< [IN] Client's IPC session.
+    const char* componentName           ///< [IN] Component that registered.
+)
+{
+    if (StoreMonitorRef == NULL)
+    {
+        return;
+    }
+
+    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(ipcSessionRef);
+    char* payloadPtr = le_msg_GetPayloadPtr(msgRef);
+    size_t maxSize = le_msg_GetMaxPayloadSize(msgRef);
+
+    if (snprintf(payloadPtr, maxSize, "%c%s/%s", LOG_CMD_SET_STORE_LEVEL, componentName,
+                 LE_CONFIG_LOG_STORE_LEVEL) >= maxSize)
+    {
+        LE_CRIT("Component name '%s' too long.", componentName);
+        le_msg_ReleaseMsg(msgRef);
+        return;
+    }
+
+    le_msg_Send(msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Formats a message of the log store as a line of text.  Long messages are truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FormatStoredMessage
+(
+    const logStore_Record_t* recordPtr,     ///< [IN] Message.
+    char* linePtr,                          ///< [OUT] Buffer the line is written to.
+    size_t lineSize                         ///< [IN] Size of the buffer.
+)
+{
+    char timeStr[32] = "";
+    time_t seconds = recordPtr->timeUs / 1000000;
+    struct tm tm;
+
+    if (localtime_r(&seconds, &tm) != NULL)
+    {
+        strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &tm);
+    }
+
+    snprintf(linePtr, lineSize, "%s.%03u | %s | %s[%d]%s%s | %s",
+             timeStr, (unsigned int)((recordPtr->timeUs / 1000) % 1000),
+             GetLevelString(recordPtr->level),
+             recordPtr->procNamePtr, (int)recordPtr->pid,
+             (recordPtr->compNamePtr[0] == '\0') ? "" : "/", recordPtr->compNamePtr,
+             recordPtr->msgPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a message of the log store to the log control tool.
+ *
+ * @return true to continue the query, false to stop it.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool SendStoredMessage
+(
+    const logStore_Record_t* recordPtr,     ///< [IN] Message.
+    void* contextPtr                        ///< [IN] Query state.
+)
+{
+    StoreQuery_t* queryPtr = contextPtr;
+    char line[LOG_MAX_CMD_PACKET_BYTES];
+
+    if (queryPtr->lineCount >= MAX_QUERY_LINES)
+    {
+        queryPtr->isTruncated = true;
+        return false;
+    }
+
+    FormatStoredMessage(recordPtr, line, sizeof(line));
+    SendToLogTool(queryPtr->toolIpcSessionRef, line);
+    queryPtr->lineCount++;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a message of the log store to the file of a le_logStore query.
+ *
+ * @return true to continue the query, false to stop it.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool WriteStoredMessage
+(
+    const logStore_Record_t* recordPtr,     ///< [IN] Message.
+    void* contextPtr                        ///< [IN] Query state.
+)
+{
+    StoreFileQuery_t* queryPtr = contextPtr;
+    char line[STORED_LINE_BYTES];
+
+    if (queryPtr->lineCount >= LE_LOGSTORE_MAX_MESSAGES)
+    {
+        queryPtr->isTruncated = true;
+        return false;
+    }
+
+    FormatStoredMessage(recordPtr, line, sizeof(line));
+    if (fprintf(queryPtr->filePtr, "%s\n", line) < 0)
+    {
+        queryPtr->isFailed = true;
+        return false;
+    }
+    queryPtr->lineCount++;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a temporary file that is removed once its last file descriptor is closed.
+ *
+ * @return The file descriptor, or -1 if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static int CreateQueryFile
+(
+    void
+)
+{
+    char path[] = LE_CONFIG_RUNTIME_DIR "/logStoreQueryXXXXXX";
+    int fd = mkstemp(path);
+
+    if (fd < 0)
+    {
+        LE_ERROR("Failed to create '%s': %m.", path);
+        return -1;
+    }
+
+    // The file isn't needed by name: the client gets a file descriptor.
+    if (unlink(path) != 0)
+    {
+        LE_ERROR("Failed to unlink '%s': %m.", path);
+        fd_Close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes the messages of the log store that match a le_logStore query to a temporary file.
+ *
+ * The messages are written to a file rather than streamed to the client, so that a slow client
+ * can't hold up the daemon.
+ *
+ * @return
+ *      LE_OK if the file holds all the matching messages.
+ *      LE_OVERFLOW if only the oldest LE_LOGSTORE_MAX_MESSAGES messages are in the file.
+ *      LE_UNAVAILABLE if the log store couldn't be opened.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t QueryStoreToFile
+(
+    const logStore_Filter_t* filterPtr,     ///< [IN] Messages to write.
+    int* fdPtr                              ///< [OUT] File the messages were written to.
+)
+{
+    StoreFileQuery_t query = { .filePtr = NULL };
+    size_t blocksRead = 0;
+    le_result_t result;
+    int fd;
+
+    *fdPtr = -1;
+
+    if (StoreRef == NULL)
+    {
+        return LE_UNAVAILABLE;
+    }
+
+    fd = CreateQueryFile();
+    if (fd < 0)
+    {
+        return LE_FAULT;
+    }
+
+    // The stream gets its own file descriptor, so that closing it leaves the client's open.
+    query.filePtr = fdopen(dup(fd), "w");
+    if (query.filePtr == NULL)
+    {
+        LE_ERROR("Failed to open the log store query file: %m.");
+        fd_Close(fd);
+        return LE_FAULT;
+    }
+
+    result = logStore_Query(StoreRef, filterPtr, WriteStoredMessage, &query, &blocksRead);
+
+    if ((fclose(query.filePtr) != 0) || query.isFailed)
+    {
+        LE_ERROR("Failed to write the log store query file: %m.");
+        result = LE_FAULT;
+    }
+    else if ((result == LE_OK) && (lseek(fd, 0, SEEK_SET) != 0))
+    {
+        LE_ERROR("Failed to rewind the log store query file: %m.");
+        result = LE_FAULT;
+    }
+
+    if (result != LE_OK)
+    {
+        fd_Close(fd);
+        return LE_FAULT;
+    }
+
+    LE_DEBUG("Log store query: %" PRIuS " messages from %" PRIuS " blocks.",
+             query.lineCount, blocksRead);
+
+    *fdPtr = fd;
+
+    return query.isTruncated ? LE_OVERFLOW : LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends the messages of the log store that match a query to the log control tool.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void QueryStore
+(
+    const char* processName,
+    const char* componentName,
+    const char* queryStr,                   ///< [IN] "level,start,end" (see logDaemon.h).
+    le_msg_SessionRef_t toolIpcSessionRef   ///< [IN] Reference to log control tool's IPC session.
+)
+{
+    logStore_Filter_t filter = { .minLevel = LE_LOG_DEBUG };
+    StoreQuery_t query = { .toolIpcSessionRef = toolIpcSessionRef };
+    char levelStr[16];
+    char message[128];
+    unsigned long long startSec;
+    unsigned long long endSec;
+    size_t blocksRead = 0;
+    size_t numBytes;
+    pid_t pid;
+
+    if (StoreRef == NULL)
+    {
+        SendToLogTool(toolIpcSessionRef, "***ERROR: The log store is not available.");
+        return;
+    }
+
+    if ((le_utf8_CopyUpToSubStr(levelStr, queryStr, ",", sizeof(levelStr), &numBytes) != LE_OK) ||
+        (sscanf(queryStr + numBytes, ",%llu,%llu", &startSec, &endSec) != 2))
+    {
+        snprintf(message, sizeof(message), "***ERROR: Invalid log store query '%s'.", queryStr);
+        LE_WARN("%s", message);
+        SendToLogTool(toolIpcSessionRef, message);
+        return;
+    }
+
+    if (levelStr[0] != '\0')
+    {
+        filter.minLevel = log_StrToSeverityLevel(levelStr);
+        if (filter.minLevel == (le_log_Level_t)-1)
+        {
+            snprintf(message, sizeof(message), "***ERROR: Invalid log level '%s'.", levelStr);
+            SendToLogTool(toolIpcSessionRef, message);
+            return;
+        }
+    }
+
+    filter.startUs = startSec * 1000000;
+    filter.endUs = (endSec == 0) ? 0 : endSec * 1000000 + 999999;
+
+    pid = StringToPid(processName);
+    if (pid > 0)
+    {
+        filter.pid = pid;
+    }
+    else if (strcmp(processName, "*") != 0)
+    {
+        filter.procNamePtr = processName;
+    }
+
+    if (strcmp(componentName, "*") != 0)
+    {
+        filter.compNamePtr = componentName;
+    }
+
+    if (logStore_Query(StoreRef, &filter, SendStoredMessage, &query, &blocksRead) != LE_OK)
+    {
+        SendToLogTool(toolIpcSessionRef, "***ERROR: Failed to read the log store.");
+        return;
+    }
+
+    LE_DEBUG("Log store query '%s/%s' %s: %" PRIuS " messages from %" PRIuS " blocks.",
+             processName, componentName, queryStr, query.lineCount, blocksRead);
+
+    if (query.isTruncated)
+    {
+        snprintf(message, sizeof(message),
+                 "(Stopped after %d messages, narrow the query to see the others.)",
+                 MAX_QUERY_LINES);
+        SendToLogTool(toolIpcSessionRef, message);
+    }
+}
+#endif /* end LE_CONFIG_LOG_STORE */
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Process a message received from a connected log session client.
@@ -2490,6 +3149,9 @@ static void ClientMsgReceiveHandler
             case LOG_CMD_REG_COMPONENT:
 
                 RegComponent(processName, componentName, commandDataPtr, ipcSessionRef);
+#if LE_CONFIG_LOG_STORE
+                SendStoreLevel(ipcSessionRef, componentName);
+#endif
                 le_msg_Respond(msgRef);
 
                 return;
@@ -2499,6 +3161,7 @@ static void ClientMsgReceiveHandler
             case LOG_CMD_DISABLE_TRACE:
             case LOG_CMD_LIST_COMPONENTS:
             case LOG_CMD_FORGET_PROCESS:
+            case LOG_CMD_QUERY_STORE:
 
                 LE_ERROR("Client attempted to issue a log control command (%c)!", command);
 
@@ -2586,6 +3249,16 @@ static void ControlToolMsgReceiveHandler
 
                 break;
 
+            case LOG_CMD_QUERY_STORE:
+
+#if LE_CONFIG_LOG_STORE
+                QueryStore(processName, componentName, commandDataPtr, ipcSessionRef);
+#else
+                SendToLogTool(ipcSessionRef, "***ERROR: The log store is not enabled.");
+#endif
+
+                break;
+
             default:
 
                 LE_ERROR("Unknown command byte '%c' received from log control tool.", command);
@@ -2644,7 +3317,7 @@ static void LogFdMessages
 
         do
         {
-            c = read(fd, msg, sizeof(msg));
+            c = read(fd, msg, sizeof(msg) - 1);
         }
         while ( (c == -1) && (errno == EINTR) );
 
@@ -2660,6 +3333,13 @@ static void LogFdMessages
         // TODO: Don't log the app name for now so that it matches all the other log formats.  Add
         //       the app name to all log messages at the same time.
         log_LogGenericMsg(fdLogPtr->level, fdLogPtr->procName, fdLogPtr->pid, msg);
+
+#if LE_CONFIG_LOG_STORE
+        if (c > 0)
+        {
+            StoreMessage(GetTimeUs(), fdLogPtr->level, fdLogPtr->procName, fdLogPtr->pid, "", msg);
+        }
+#endif
     }
 
     if ( (events & POLLRDHUP) || (events & POLLERR) || (events & POLLHUP) )
@@ -2788,6 +3468,64 @@ void logFd_StdOut
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the messages of the log store that match a query.
+ *
+ * @return
+ *      LE_OK if the file descriptor holds all the matching messages.
+ *      LE_OVERFLOW if more than LE_LOGSTORE_MAX_MESSAGES messages match; the file descriptor holds
+ *                  the oldest.
+ *      LE_UNSUPPORTED if the framework doesn't keep a log store.
+ *      LE_UNAVAILABLE if the log store couldn't be opened.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_logStore_Query
+(
+    le_logStore_Level_t minLevel,   ///< [IN] Least severe level returned.
+    const char* procName,           ///< [IN] Process name, empty for all processes.
+    int32_t pid,                    ///< [IN] Process ID, 0 for all processes.
+    const char* compName,           ///< [IN] Component name, empty for all components.
+    uint64_t startUs,               ///< [IN] Earliest time returned, 0 for no limit.
+    uint64_t endUs,                 ///< [IN] Latest time returned, 0 for no limit.
+    int* fdPtr                      ///< [OUT] File to read the messages from.
+)
+{
+#if LE_CONFIG_LOG_STORE
+    // The levels of the API are those of le_log_Level_t.
+    logStore_Filter_t filter =
+    {
+        .minLevel = (le_log_Level_t)minLevel,
+        .startUs = startUs,
+        .endUs = endUs,
+        .procNamePtr = (procName[0] == '\0') ? NULL : procName,
+        .pid = (pid > 0) ? pid : 0,
+        .compNamePtr = (compName[0] == '\0') ? NULL : compName,
+    };
+
+    if ((uint32_t)minLevel > LE_LOGSTORE_EMERG)
+    {
+        LE_KILL_CLIENT("Invalid log level %d.", (int)minLevel);
+        *fdPtr = -1;
+        return LE_FAULT;
+    }
+
+    return QueryStoreToFile(&filter, fdPtr);
+#else
+    LE_UNUSED(minLevel);
+    LE_UNUSED(procName);
+    LE_UNUSED(pid);
+    LE_UNUSED(compName);
+    LE_UNUSED(startUs);
+    LE_UNUSED(endUs);
+
+    *fdPtr = -1;
+    return LE_UNSUPPORTED;
+#endif
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * The main function for the log daemon.  Listens for commands from process/components and log tools
@@ -2844,6 +3582,10 @@ COMPONENT_INIT
     le_msg_SetServiceRecvHandler(serviceRef, ControlToolMsgReceiveHandler, NULL);
     le_msg_AdvertiseService(serviceRef);
 
+#if LE_CONFIG_LOG_STORE
+    InitStore();
+#endif
+
     // Close the fd that we inherited from the Supervisor.  This will let the Supervisor know that
     // we are initialized.  Then re-open it to /dev/null so that it cannot be reused later.
     FILE* filePtr;
@@ -96,6 +96,14 @@
 #define LOG_CMD_REG_COMPONENT           'r' // CommandData = string containing the process ID.
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Logging commands that can be sent from the log daemon to the components only.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_CMD_SET_STORE_LEVEL         's' // CommandData = level string (see below)
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Logging commands that can be sent from the log tool to the log daemon only.
@@ -103,6 +111,61 @@
 //--------------------------------------------------------------------------------------------------
 #define LOG_CMD_LIST_COMPONENTS         'c' // No ProcessName, ComponentName, or CommandData
 #define LOG_CMD_FORGET_PROCESS          'x' // No ComponentName or CommandData
+#define LOG_CMD_QUERY_STORE             'q' // CommandData = "level,start,end" (see below)
+
+
+// =========================================================================
+//  LOG STORE
+// =========================================================================
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Log store query commands.  The ProcessName and ComponentName select the messages of a process
+ * (by name or PID) and component, or "*" for all.  The CommandData is the least severe level
+ * string, or an empty string for all levels, followed by the start and end of the time range, in
+ * seconds since the Epoch, separated by commas.  A start or end of 0 means no limit.  The Log
+ * Control Daemon sends one line for each stored message.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_STORE_QUERY_SEPARATOR       ','
+
+
+#if LE_CONFIG_LOG_STORE
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Path of the datagram socket through which processes send log messages to the log store.  Once a
+ * component has registered, the Log Control Daemon tells it the least severe level of the
+ * messages to send with a LOG_CMD_SET_STORE_LEVEL command.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_STORE_SOCKET_PATH           LE_CONFIG_RUNTIME_DIR "/" LE_CONFIG_LOG_STORE_SOCKET_NAME
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a datagram sent to the log store.  Longer messages are truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOG_STORE_MAX_DGRAM_BYTES       1024
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of a datagram sent to the log store.  It is followed by the component name and the
+ * message, each null-terminated.  The sending process is not part of the datagram: the Log Control
+ * Daemon gets it from the credentials the kernel attaches to the datagram.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t timeUs;        ///< Time of the message, in microseconds since the Epoch.
+    uint8_t  level;         ///< Severity level (le_log_Level_t).
+    uint8_t  reserved[7];   ///< Set to 0.
+}
+LogStoreMsgHeader_t;
+
+#endif /* end LE_CONFIG_LOG_STORE */
 
 
 // =========================================================================
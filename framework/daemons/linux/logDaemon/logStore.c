@@ -0,0 +1,847 @@
+//--------------------------------------------------------------------------------------------------
+/** @file logStore.c
+ *
+ * Persistent, size-bounded store of log messages.
+ *
+ * The store file is an array of BLOCK_BYTES blocks.  Each block starts with a header, followed by
+ * variable-size records.  The record after the last one of a block starts with a zero size.  The
+ * blocks are used as a ring, and the block with the highest sequence number is the one being
+ * written.
+ *
+ * The header of the block being written is only kept up to date in memory, and written to the file
+ * when the store is synced and when the block is full.  When the store is opened, the records of
+ * that block are walked to bring its header up to date, in case the Log Control Daemon was not
+ * stopped cleanly.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "logStore.h"
+#include "fileDescriptor.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of a block of the store file.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BLOCK_BYTES             (16 * 1024)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Minimum number of blocks of a store.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MIN_BLOCKS              4
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Value of the magic field of a block header ("LOGS").
+ */
+//--------------------------------------------------------------------------------------------------
+#define BLOCK_MAGIC             0x53474f4cU
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum length of a stored message.  Process and component names are limited to UINT8_MAX.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_MSG_LEN             1024
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records are aligned to this size in a block.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RECORD_ALIGN            8
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of a block.  Summarizes the records of the block, so that a query can tell from the
+ * header alone if the block may have matching records.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;             ///< BLOCK_MAGIC.
+    uint32_t seq;               ///< Sequence number of the block, 0 if never used.
+    uint64_t firstTimeUs;       ///< Earliest time of the records.
+    uint64_t lastTimeUs;        ///< Latest time of the records.
+    uint64_t procMask;          ///< Bits set by the process names of the records (see NameMask()).
+    uint64_t compMask;          ///< Bits set by the component names of the records.
+    uint32_t recordCount;       ///< Number of records.
+    uint32_t usedBytes;         ///< Size of the records.
+    uint8_t  levelMask;         ///< Bit n set if there is a record of level n.
+    uint8_t  reserved[7];       ///< Set to 0.
+}
+BlockHeader_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header of a record.  It is followed by the process name, component name and message, each
+ * null-terminated.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint16_t size;              ///< Size of the record, including padding.  0 ends the block.
+    uint8_t  level;             ///< Severity level.
+    uint8_t  procNameLen;       ///< Length of the process name.
+    uint8_t  compNameLen;       ///< Length of the component name.
+    uint8_t  reserved;          ///< Set to 0.
+    uint16_t msgLen;            ///< Length of the message.
+    int32_t  pid;               ///< PID of the process.
+    uint32_t reserved2;         ///< Set to 0.
+    uint64_t timeUs;            ///< Time of the message, in microseconds since the Epoch.
+}
+RecordHeader_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the end marker written after the last record of a block.
+ */
+//--------------------------------------------------------------------------------------------------
+#define END_MARK_BYTES          sizeof(uint16_t)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of a record.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_RECORD_BYTES        (sizeof(RecordHeader_t) + 2 * UINT8_MAX + MAX_MSG_LEN + 3 + \
+                                 RECORD_ALIGN)
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * An open store.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct logStore_Store
+{
+    int fd;                             ///< Store file.
+    uint32_t blockCount;                ///< Number of blocks of the file.
+    uint32_t curBlock;                  ///< Index of the block being written.
+    BlockHeader_t curHeader;            ///< Header of the block being written.
+    bool isHeaderDirty;                 ///< true if curHeader was not written to the file.
+    bool isDataDirty;                   ///< true if the file was written since the last sync.
+    uint64_t buffer[BLOCK_BYTES / sizeof(uint64_t)];    ///< Block read by a query.
+}
+Store_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of stores.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t StorePool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Computes the bits set in a block header's name mask by a name.
+ *
+ * @return The bits.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t NameMask
+(
+    const char* namePtr             ///< [IN] Process or component name.
+)
+{
+    size_t hash = le_hashmap_HashString(namePtr);
+
+    return (1ULL << (hash & 63)) | (1ULL << ((hash >> 6) & 63));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the offset of a block in the store file.
+ *
+ * @return The offset.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline off_t BlockOffset
+(
+    uint32_t index                  ///< [IN] Index of the block.
+)
+{
+    return (off_t)index * BLOCK_BYTES;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads from the store file.  What is past the end of the file reads as zeros.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadAt
+(
+    int fd,                         ///< [IN] Store file.
+    void* bufPtr,                   ///< [OUT] Buffer.
+    size_t size,                    ///< [IN] Number of bytes to read.
+    off_t offset                    ///< [IN] Offset in the file.
+)
+{
+    uint8_t* destPtr = bufPtr;
+
+    while (size > 0)
+    {
+        ssize_t count = pread(fd, destPtr, size, offset);
+
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LE_ERROR("Failed to read the log store: %m.");
+            return LE_FAULT;
+        }
+        if (count == 0)
+        {
+            memset(destPtr, 0, size);
+            break;
+        }
+
+        destPtr += count;
+        size -= count;
+        offset += count;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes to the store file.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t WriteAt
+(
+    int fd,                         ///< [IN] Store file.
+    const void* bufPtr,             ///< [IN] Data to write.
+    size_t size,                    ///< [IN] Number of bytes to write.
+    off_t offset                    ///< [IN] Offset in the file.
+)
+{
+    const uint8_t* srcPtr = bufPtr;
+
+    while (size > 0)
+    {
+        ssize_t count = pwrite(fd, srcPtr, size, offset);
+
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LE_ERROR("Failed to write the log store: %m.");
+            return LE_FAULT;
+        }
+
+        srcPtr += count;
+        size -= count;
+        offset += count;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks that a block header read from the file is for a block that was used.
+ *
+ * @return true if the block holds records.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsValidHeader
+(
+    const BlockHeader_t* headerPtr  ///< [IN] Block header.
+)
+{
+    return (headerPtr->magic == BLOCK_MAGIC) &&
+           (headerPtr->seq != 0) &&
+           (headerPtr->usedBytes <= BLOCK_BYTES - sizeof(BlockHeader_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the next record of a block read into memory.
+ *
+ * @return Pointer to the record, or NULL if there are no more valid records.
+ */
+//--------------------------------------------------------------------------------------------------
+static const RecordHeader_t* NextRecord
+(
+    const uint8_t* blockPtr,        ///< [IN] Block.
+    size_t* offsetPtr,              ///< [IN/OUT] Offset of the record, moved to the next record.
+    size_t endOffset                ///< [IN] Offset of the end of the records.
+)
+{
+    size_t offset = *offsetPtr;
+
+    if (offset + sizeof(RecordHeader_t) > endOffset)
+    {
+        return NULL;
+    }
+
+    const RecordHeader_t* recPtr = (const RecordHeader_t*)(blockPtr + offset);
+    const char* procNamePtr = (const char*)(recPtr + 1);
+    const char* compNamePtr = procNamePtr + recPtr->procNameLen + 1;
+    const char* msgPtr = compNamePtr + recPtr->compNameLen + 1;
+
+    if ((recPtr->size < sizeof(RecordHeader_t) +
+                        recPtr->procNameLen + recPtr->compNameLen + recPtr->msgLen + 3) ||
+        (recPtr->size % RECORD_ALIGN != 0) ||
+        (offset + recPtr->size > endOffset) ||
+        (procNamePtr[recPtr->procNameLen] != '\0') ||
+        (compNamePtr[recPtr->compNameLen] != '\0') ||
+        (msgPtr[recPtr->msgLen] != '\0'))
+    {
+        return NULL;
+    }
+
+    *offsetPtr = offset + recPtr->size;
+
+    return recPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a record to the summary of a block header.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToHeader
+(
+    BlockHeader_t* headerPtr,       ///< [IN/OUT] Block header.
+    const RecordHeader_t* recPtr    ///< [IN] Record, followed by its strings.
+)
+{
+    const char* procNamePtr = (const char*)(recPtr + 1);
+    const char* compNamePtr = procNamePtr + recPtr->procNameLen + 1;
+
+    if ((headerPtr->recordCount == 0) || (recPtr->timeUs < headerPtr->firstTimeUs))
+    {
+        headerPtr->firstTimeUs = recPtr->timeUs;
+    }
+    if ((headerPtr->recordCount == 0) || (recPtr->timeUs > headerPtr->lastTimeUs))
+    {
+        headerPtr->lastTimeUs = recPtr->timeUs;
+    }
+
+    headerPtr->procMask |= NameMask(procNamePtr);
+    headerPtr->compMask |= NameMask(compNamePtr);
+    headerPtr->levelMask |= (uint8_t)(1U << recPtr->level);
+    headerPtr->recordCount++;
+    headerPtr->usedBytes += recPtr->size;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Starts writing a block: its header is reset and written, erasing the records it held.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t StartBlock
+(
+    Store_t* storePtr,              ///< [IN] Store.
+    uint32_t index,                 ///< [IN] Index of the block.
+    uint32_t seq                    ///< [IN] Sequence number of the block.
+)
+{
+    uint8_t buffer[sizeof(BlockHeader_t) + END_MARK_BYTES] = { 0 };
+
+    memset(&storePtr->curHeader, 0, sizeof(storePtr->curHeader));
+    storePtr->curHeader.magic = BLOCK_MAGIC;
+    storePtr->curHeader.seq = seq;
+    storePtr->curBlock = index;
+    storePtr->isHeaderDirty = false;
+    storePtr->isDataDirty = true;
+
+    memcpy(buffer, &storePtr->curHeader, sizeof(storePtr->curHeader));
+
+    return WriteAt(storePtr->fd, buffer, sizeof(buffer), BlockOffset(index));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Brings the header of the block being written up to date with the records of the block.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RebuildHeader
+(
+    Store_t* storePtr               ///< [IN] Store, with curBlock set.
+)
+{
+    const uint8_t* blockPtr = (const uint8_t*)storePtr->buffer;
+    BlockHeader_t header;
+    const RecordHeader_t* recPtr;
+    size_t offset = sizeof(BlockHeader_t);
+
+    if (ReadAt(storePtr->fd, storePtr->buffer, BLOCK_BYTES,
+               BlockOffset(storePtr->curBlock)) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    memcpy(&header, blockPtr, sizeof(header));
+    storePtr->curHeader = header;
+    storePtr->curHeader.firstTimeUs = 0;
+    storePtr->curHeader.lastTimeUs = 0;
+    storePtr->curHeader.procMask = 0;
+    storePtr->curHeader.compMask = 0;
+    storePtr->curHeader.recordCount = 0;
+    storePtr->curHeader.usedBytes = 0;
+    storePtr->curHeader.levelMask = 0;
+
+    while ((recPtr = NextRecord(blockPtr, &offset, BLOCK_BYTES)) != NULL)
+    {
+        AddToHeader(&storePtr->curHeader, recPtr);
+    }
+
+    if (storePtr->curHeader.recordCount != header.recordCount)
+    {
+        LE_INFO("Recovered %" PRIu32 " log store records that were not indexed.",
+                storePtr->curHeader.recordCount - header.recordCount);
+        storePtr->isHeaderDirty = true;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks from its header if a block may have records matching a filter.
+ *
+ * @return true if the block has to be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool MayMatch
+(
+    const BlockHeader_t* headerPtr,         ///< [IN] Block header.
+    const logStore_Filter_t* filterPtr      ///< [IN] Filter.
+)
+{
+    uint64_t mask;
+
+    if ((headerPtr->levelMask & ~((1U << filterPtr->minLevel) - 1)) == 0)
+    {
+        return false;
+    }
+
+    if (((filterPtr->startUs != 0) && (headerPtr->lastTimeUs < filterPtr->startUs)) ||
+        ((filterPtr->endUs != 0) && (headerPtr->firstTimeUs > filterPtr->endUs)))
+    {
+        return false;
+    }
+
+    if (filterPtr->procNamePtr != NULL)
+    {
+        mask = NameMask(filterPtr->procNamePtr);
+        if ((headerPtr->procMask & mask) != mask)
+        {
+            return false;
+        }
+    }
+
+    if (filterPtr->compNamePtr != NULL)
+    {
+        mask = NameMask(filterPtr->compNamePtr);
+        if ((headerPtr->compMask & mask) != mask)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Checks if a record matches a filter.
+ *
+ * @return true if it matches.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Matches
+(
+    const logStore_Record_t* recordPtr,     ///< [IN] Record.
+    const logStore_Filter_t* filterPtr      ///< [IN] Filter.
+)
+{
+    return (recordPtr->level >= filterPtr->minLevel) &&
+           ((filterPtr->startUs == 0) || (recordPtr->timeUs >= filterPtr->startUs)) &&
+           ((filterPtr->endUs == 0) || (recordPtr->timeUs <= filterPtr->endUs)) &&
+           ((filterPtr->pid == 0) || (recordPtr->pid == filterPtr->pid)) &&
+           ((filterPtr->procNamePtr == NULL) ||
+            (strcmp(recordPtr->procNamePtr, filterPtr->procNamePtr) == 0)) &&
+           ((filterPtr->compNamePtr == NULL) ||
+            (strcmp(recordPtr->compNamePtr, filterPtr->compNamePtr) == 0));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens a log store, creating it if needed.  A store created with a different size is emptied.
+ *
+ * @return Reference to the store, or NULL if the file could not be opened.
+ */
+//--------------------------------------------------------------------------------------------------
+logStore_Ref_t logStore_Open
+(
+    const char* pathPtr,            ///< [IN] Path of the store file.
+    size_t size                     ///< [IN] Size of the store, in bytes.
+)
+{
+    uint32_t blockCount = size / BLOCK_BYTES;
+    uint32_t maxSeq = 0;
+    uint32_t newest = 0;
+    struct stat st;
+    uint32_t i;
+    int fd;
+
+    if (blockCount < MIN_BLOCKS)
+    {
+        blockCount = MIN_BLOCKS;
+    }
+
+    fd = open(pathPtr, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        LE_ERROR("Failed to open log store '%s': %m.", pathPtr);
+        return NULL;
+    }
+
+    if (fstat(fd, &st) != 0)
+    {
+        LE_ERROR("Failed to stat log store '%s': %m.", pathPtr);
+        fd_Close(fd);
+        return NULL;
+    }
+
+    if (st.st_size != BlockOffset(blockCount))
+    {
+        if (st.st_size != 0)
+        {
+            LE_WARN("Log store '%s' resized, dropping its messages.", pathPtr);
+        }
+
+        if ((ftruncate(fd, 0) != 0) || (ftruncate(fd, BlockOffset(blockCount)) != 0))
+        {
+            LE_ERROR("Failed to size log store '%s': %m.", pathPtr);
+            fd_Close(fd);
+            return NULL;
+        }
+    }
+
+    if (StorePool == NULL)
+    {
+        StorePool = le_mem_CreatePool("LogStore", sizeof(Store_t));
+    }
+
+    Store_t* storePtr = le_mem_ForceAlloc(StorePool);
+    memset(storePtr, 0, sizeof(*storePtr));
+    storePtr->fd = fd;
+    storePtr->blockCount = blockCount;
+
+    // The block being written is the one with the highest sequence number.
+    for (i = 0; i < blockCount; i++)
+    {
+        BlockHeader_t header;
+
+        if (ReadAt(fd, &header, sizeof(header), BlockOffset(i)) != LE_OK)
+        {
+            break;
+        }
+
+        if (IsValidHeader(&header) && (header.seq > maxSeq))
+        {
+            maxSeq = header.seq;
+            newest = i;
+        }
+    }
+
+    le_result_t result;
+
+    if (i < blockCount)
+    {
+        result = LE_FAULT;
+    }
+    else if (maxSeq == 0)
+    {
+        result = StartBlock(storePtr, 0, 1);
+    }
+    else
+    {
+        storePtr->curBlock = newest;
+        result = RebuildHeader(storePtr);
+    }
+
+    if (result != LE_OK)
+    {
+        fd_Close(fd);
+        le_mem_Release(storePtr);
+        return NULL;
+    }
+
+    LE_DEBUG("Opened log store '%s': %" PRIu32 " blocks, writing block %" PRIu32 ".",
+             pathPtr, blockCount, storePtr->curBlock);
+
+    return storePtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes what is pending to the store, then closes it.
+ */
+//--------------------------------------------------------------------------------------------------
+void logStore_Close
+(
+    logStore_Ref_t storeRef         ///< [IN] Store.
+)
+{
+    logStore_Sync(storeRef);
+    fd_Close(storeRef->fd);
+    le_mem_Release(storeRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends a message to a store, dropping the oldest messages if the store is full.  Long names
+ * and messages are truncated.
+ *
+ * The message is written to the file, but only stored persistently after logStore_Sync().
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if the message could not be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logStore_Append
+(
+    logStore_Ref_t storeRef,                ///< [IN] Store.
+    const logStore_Record_t* recordPtr      ///< [IN] Message.
+)
+{
+    uint64_t buffer[(MAX_RECORD_BYTES + END_MARK_BYTES) / sizeof(uint64_t) + 1];
+    RecordHeader_t* recPtr = (RecordHeader_t*)buffer;
+    const char* compNamePtr = (recordPtr->compNamePtr != NULL) ? recordPtr->compNamePtr : "";
+    size_t procNameLen = strnlen(recordPtr->procNamePtr, UINT8_MAX);
+    size_t compNameLen = strnlen(compNamePtr, UINT8_MAX);
+    size_t msgLen = strnlen(recordPtr->msgPtr, MAX_MSG_LEN);
+    size_t size = sizeof(RecordHeader_t) + procNameLen + compNameLen + msgLen + 3;
+    size_t offset;
+    char* strPtr;
+
+    size = (size + RECORD_ALIGN - 1) & ~(size_t)(RECORD_ALIGN - 1);
+
+    // Move to the next block, erasing its oldest messages, if the record doesn't fit.
+    offset = sizeof(BlockHeader_t) + storeRef->curHeader.usedBytes;
+    if (offset + size > BLOCK_BYTES)
+    {
+        if ((WriteAt(storeRef->fd, &storeRef->curHeader, sizeof(storeRef->curHeader),
+                     BlockOffset(storeRef->curBlock)) != LE_OK) ||
+            (StartBlock(storeRef, (storeRef->curBlock + 1) % storeRef->blockCount,
+                        storeRef->curHeader.seq + 1) != LE_OK))
+        {
+            return LE_FAULT;
+        }
+        offset = sizeof(BlockHeader_t);
+    }
+
+    memset(buffer, 0, size + END_MARK_BYTES);
+    recPtr->size = size;
+    recPtr->level = recordPtr->level;
+    recPtr->procNameLen = procNameLen;
+    recPtr->compNameLen = compNameLen;
+    recPtr->msgLen = msgLen;
+    recPtr->pid = recordPtr->pid;
+    recPtr->timeUs = recordPtr->timeUs;
+
+    strPtr = (char*)(recPtr + 1);
+    memcpy(strPtr, recordPtr->procNamePtr, procNameLen);
+    strPtr += procNameLen + 1;
+    memcpy(strPtr, compNamePtr, compNameLen);
+    strPtr += compNameLen + 1;
+    memcpy(strPtr, recordPtr->msgPtr, msgLen);
+
+    // Write the end marker after the record, unless the record fills the block.
+    if (WriteAt(storeRef->fd, buffer,
+                (offset + size + END_MARK_BYTES <= BLOCK_BYTES) ? size + END_MARK_BYTES : size,
+                BlockOffset(storeRef->curBlock) + offset) != LE_OK)
+    {
+        return LE_FAULT;
+    }
+
+    AddToHeader(&storeRef->curHeader, recPtr);
+    storeRef->isHeaderDirty = true;
+    storeRef->isDataDirty = true;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stores the messages appended so far persistently.  Does nothing if nothing was appended since
+ * the last call.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logStore_Sync
+(
+    logStore_Ref_t storeRef         ///< [IN] Store.
+)
+{
+    if (storeRef->isHeaderDirty)
+    {
+        if (WriteAt(storeRef->fd, &storeRef->curHeader, sizeof(storeRef->curHeader),
+                    BlockOffset(storeRef->curBlock)) != LE_OK)
+        {
+            return LE_FAULT;
+        }
+        storeRef->isHeaderDirty = false;
+    }
+
+    if (storeRef->isDataDirty)
+    {
+        if (fdatasync(storeRef->fd) != 0)
+        {
+            LE_ERROR("Failed to sync the log store: %m.");
+            return LE_FAULT;
+        }
+        storeRef->isDataDirty = false;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reports the messages of a store that match a filter, oldest first.  Only the blocks whose index
+ * entry may match the filter are read.
+ *
+ * @return
+ *      - LE_OK if successful, including if the query was stopped by the record function.
+ *      - LE_FAULT if the store could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logStore_Query
+(
+    logStore_Ref_t storeRef,                ///< [IN] Store.
+    const logStore_Filter_t* filterPtr,     ///< [IN] Filter.
+    logStore_RecordFunc_t recordFunc,       ///< [IN] Function called for each matching message.
+    void* contextPtr,                       ///< [IN] Passed to the record function.
+    size_t* blocksReadPtr                   ///< [OUT] Number of blocks read.  Can be NULL.
+)
+{
+    const uint8_t* blockPtr = (const uint8_t*)storeRef->buffer;
+    size_t blocksRead = 0;
+    le_result_t result = LE_OK;
+    bool isStopped = false;
+    uint32_t i;
+
+    // The oldest block is the one after the block being written.
+    for (i = 1; (i <= storeRef->blockCount) && !isStopped; i++)
+    {
+        uint32_t index = (storeRef->curBlock + i) % storeRef->blockCount;
+        BlockHeader_t header;
+        const RecordHeader_t* recPtr;
+        size_t offset = sizeof(BlockHeader_t);
+
+        if (index == storeRef->curBlock)
+        {
+            header = storeRef->curHeader;
+        }
+        else if (ReadAt(storeRef->fd, &header, sizeof(header), BlockOffset(index)) != LE_OK)
+        {
+            result = LE_FAULT;
+            break;
+        }
+
+        if (!IsValidHeader(&header) || (header.recordCount == 0) || !MayMatch(&header, filterPtr))
+        {
+            continue;
+        }
+
+        if (ReadAt(storeRef->fd, storeRef->buffer, sizeof(BlockHeader_t) + header.usedBytes,
+                   BlockOffset(index)) != LE_OK)
+        {
+            result = LE_FAULT;
+            break;
+        }
+        blocksRead++;
+
+        while (!isStopped &&
+               ((recPtr = NextRecord(blockPtr, &offset,
+                                     sizeof(BlockHeader_t) + header.usedBytes)) != NULL))
+        {
+            const char* procNamePtr = (const char*)(recPtr + 1);
+            const char* compNamePtr = procNamePtr + recPtr->procNameLen + 1;
+            logStore_Record_t record =
+            {
+                .timeUs = recPtr->timeUs,
+                .level = recPtr->level,
+                .pid = recPtr->pid,
+                .procNamePtr = procNamePtr,
+                .compNamePtr = compNamePtr,
+                .msgPtr = compNamePtr + recPtr->compNameLen + 1,
+            };
+
+            if (Matches(&record, filterPtr))
+            {
+                isStopped = !recordFunc(&record, contextPtr);
+            }
+        }
+    }
+
+    if (blocksReadPtr != NULL)
+    {
+        *blocksReadPtr = blocksRead;
+    }
+
+    return result;
+}
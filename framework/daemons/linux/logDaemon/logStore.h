@@ -0,0 +1,158 @@
+//--------------------------------------------------------------------------------------------------
+/** @file logStore.h
+ *
+ * Persistent, size-bounded store of log messages, written by the Log Control Daemon.
+ *
+ * The store is a file divided into fixed-size blocks used as a ring: messages are appended to the
+ * current block and, once it is full, the next block (the one holding the oldest messages) is
+ * erased and becomes the current block.  The header of each block summarizes its messages: time
+ * range, levels present and a bit mask of the process and component names.  These headers are
+ * the index of the store: a query only reads the blocks whose header says they may hold matching
+ * messages.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_SRC_LOG_STORE_INCLUDE_GUARD
+#define LEGATO_SRC_LOG_STORE_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to an open log store.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct logStore_Store* logStore_Ref_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A stored log message.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t        timeUs;         ///< Time of the message, in microseconds since the Epoch.
+    le_log_Level_t  level;          ///< Severity level.
+    pid_t           pid;            ///< PID of the process.
+    const char*     procNamePtr;    ///< Process name.
+    const char*     compNamePtr;    ///< Component name, empty if not known.
+    const char*     msgPtr;         ///< Message.
+}
+logStore_Record_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Selects the messages reported by a query.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_log_Level_t  minLevel;       ///< Least severe level reported.
+    uint64_t        startUs;        ///< Earliest time reported, 0 for no limit.
+    uint64_t        endUs;          ///< Latest time reported, 0 for no limit.
+    const char*     procNamePtr;    ///< Process name, NULL for all processes.
+    pid_t           pid;            ///< PID of the process, 0 for all processes.
+    const char*     compNamePtr;    ///< Component name, NULL for all components.
+}
+logStore_Filter_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function called for each message reported by a query.  The record is only valid during the
+ * call.
+ *
+ * @return true to continue the query, false to stop it.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef bool (*logStore_RecordFunc_t)
+(
+    const logStore_Record_t* recordPtr,     ///< [IN] Message.
+    void* contextPtr                        ///< [IN] Context pointer passed to logStore_Query().
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens a log store, creating it if needed.  A store created with a different size is emptied.
+ *
+ * @return Reference to the store, or NULL if the file could not be opened.
+ */
+//--------------------------------------------------------------------------------------------------
+logStore_Ref_t logStore_Open
+(
+    const char* pathPtr,            ///< [IN] Path of the store file.
+    size_t size                     ///< [IN] Size of the store, in bytes.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes what is pending to the store, then closes it.
+ */
+//--------------------------------------------------------------------------------------------------
+void logStore_Close
+(
+    logStore_Ref_t storeRef         ///< [IN] Store.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Appends a message to a store, dropping the oldest messages if the store is full.  Long names
+ * and messages are truncated.
+ *
+ * The message is written to the file, but only stored persistently after logStore_Sync().
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if the message could not be written.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logStore_Append
+(
+    logStore_Ref_t storeRef,                ///< [IN] Store.
+    const logStore_Record_t* recordPtr      ///< [IN] Message.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Stores the messages appended so far persistently.  Does nothing if nothing was appended since
+ * the last call.
+ *
+ * @return
+ *      - LE_OK if successful.
+ *      - LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logStore_Sync
+(
+    logStore_Ref_t storeRef         ///< [IN] Store.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reports the messages of a store that match a filter, oldest first.  Only the blocks whose index
+ * entry may match the filter are read.
+ *
+ * @return
+ *      - LE_OK if successful, including if the query was stopped by the record function.
+ *      - LE_FAULT if the store could not be read.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t logStore_Query
+(
+    logStore_Ref_t storeRef,                ///< [IN] Store.
+    const logStore_Filter_t* filterPtr,     ///< [IN] Filter.
+    logStore_RecordFunc_t recordFunc,       ///< [IN] Function called for each matching message.
+    void* contextPtr,                       ///< [IN] Passed to the record function.
+    size_t* blocksReadPtr                   ///< [OUT] Number of blocks read.  Can be NULL.
+);
+
+
+#endif // LEGATO_SRC_LOG_STORE_INCLUDE_GUARD
@@ -27,6 +27,12 @@
 #define LE_SDTP_PROTOCOL_ID     "sdirTool"
 
 
+//--------------------------------------------------------------------------------------------------
+/// Maximum number of bindings that can be carried by a single LE_SDTP_MSGID_BIND message.
+//--------------------------------------------------------------------------------------------------
+#define LE_SDTP_MAX_BINDINGS_PER_MSG    16
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Message type IDs.
@@ -42,7 +48,10 @@ typedef enum
 
     LE_SDTP_MSGID_UNBIND_ALL,       ///< Delete all bindings (This message has no payload).
 
-    LE_SDTP_MSGID_BIND,             ///< Create one binding.  The payload is the binding details.
+    LE_SDTP_MSGID_BIND,             ///< Create one or more bindings.  The payload is the number
+                                    ///  of bindings and their details.  Client connections that
+                                    ///  were waiting for any of the bindings are dispatched once
+                                    ///  all the bindings in the message have been created.
                                     ///  If the Service Directory runs into an error, it will
                                     ///  drop the connection to the sdir tool without responding.
 }
@@ -51,17 +60,30 @@ le_sdtp_MsgType_t;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Message structure.
+ * Binding details.
  */
 //--------------------------------------------------------------------------------------------------
 typedef struct
 {
-    le_sdtp_MsgType_t msgType;  ///< Indicates what type of message this is.
     uid_t client;               ///< Unix user ID of the client.
     uid_t server;               ///< Unix user ID of the server.
     char clientInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES]; ///< Client's interface name.
     char serverInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES]; ///< Server's interface name.
 }
+le_sdtp_Binding_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Message structure.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_sdtp_MsgType_t msgType;  ///< Indicates what type of message this is.
+    uint32_t bindingCount;      ///< Number of valid entries in bindings[] (BIND only).
+    le_sdtp_Binding_t bindings[LE_SDTP_MAX_BINDINGS_PER_MSG]; ///< Bindings (BIND only).
+}
 le_sdtp_Msg_t;
 
 
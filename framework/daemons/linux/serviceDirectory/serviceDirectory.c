@@ -70,7 +70,7 @@ User List ------> User --+---> Name               |        |        |
 @endverbatim
  *
  * The User object represents a single user account.  It has a unique ID which is used as the key
- * to find it in the User List.  Each User also has
+ * to find it in the User Map.  Each User also has
  *  - list of bindings from a client-side interface name to a server's user name and service name.
  *  - list of services that it offers, and
  *  - list of client connections that are waiting for a binding to be created for them.
@@ -98,32 +98,49 @@ User List ------> User --+---> Name               |        |        |
  * Each Binding object and Connection object holds a reference count on a User object.  A User
  * object will be deleted when all associated Binding objects and Connection objects are deleted.
  *
+ * Because every client connect, service advertisement and binding change needs to find objects
+ * in these lists, and hundreds of those happen together at start-up, the lists are also indexed
+ * by hash maps:
+ *  - the User Map indexes User objects by user ID,
+ *  - the Binding Map indexes Binding objects by (client User, client interface name),
+ *  - the Service Map indexes the Server Connections on Service Lists by (User, service name), and
+ *  - the Binding Target Map indexes Binding Target objects by (server User, service name).  A
+ *    Binding Target keeps a list of all the Binding objects that point to its service, and is
+ *    deleted when the last of those Bindings is deleted.
+ *
+ * The lists are still used wherever all objects are visited (e.g., by the 'sdir list' command).
+ * Every object is added to and removed from its index together with its list.
+ *
  *
  * @section sd_theoryOfOperation Theory of Operation
  *
  * When a client connects and makes a request to open a service, the client's UID is looked up in
- * the User List.  The client User's Binding List is searched for the interface name provided by
+ * the User Map.  The Binding Map is searched for the client User and interface name provided by
  * the client.  If a matching Binding object is not found, the Client Connection object is added
  * to the User object's Unbound Clients List.  If a matching Binding object is found, it will
- * specify the server User object and service name.  The server's User's Service List will be
- * searched for a matching Server Connection object.  If no matching Server Connection can be
+ * specify the server User object and service name.  The Service Map will be searched for a
+ * matching Server Connection object.  If no matching Server Connection can be
  * found, the Client Connection is added to the Binding object's Waiting Clients List.
  *
- * When a server connects and advertises a service, the server UID is looked-up in the User List.
- * The service name is then searched for in the Service List for that User.  If a Server Connection
+ * When a server connects and advertises a service, the server UID is looked-up in the User Map.
+ * The service name is then searched for in the Service Map for that User.  If a Server Connection
  * object is not found for that service name on that User, the new one is is added to the list.
  * Otherwise, the new server connection is dropped.
  *
- * When a new Server Connection is added to a Service List, all users' Binding Lists are
- * searched for matching bindings, and if any that match have non-empty Waiting Clients Lists,
- * all those Client Connections are removed from those lists and dispatched to the new Server
- * Connection.
+ * When a new Server Connection is added to a Service List, the Binding Target for that service
+ * is looked up to find the matching bindings, and if any that match have non-empty Waiting
+ * Clients Lists, all those Client Connections are removed from those lists and dispatched to the
+ * new Server Connection.
  *
  * When a Binding is added, it is added to the client's User object's Binding List.  That user's
  * Unbound Clients List will then be checked for matches to the new binding, and if any are found,
  * they will be removed from the Unbound Clients List and processed as though they are
  * new client connections (see above).
  *
+ * The 'sdir load' command sends bindings in batches (see @ref sdirToolProtocol.h).  All the
+ * bindings of a batch are added first, then every Unbound Clients List is walked once, looking up
+ * each waiting client's interface in the Binding Map.
+ *
  * Likewise, if a Binding is deleted while it has Client Connections on its Waiting Clients List,
  * those Client Connections will be removed from that list and processed as though they are new
  * client connections (see above).
@@ -252,6 +269,28 @@ static le_mem_PoolRef_t UserPoolRef;
 static le_dls_List_t UserList = LE_DLS_LIST_INIT;
 
 
+//--------------------------------------------------------------------------------------------------
+/// The User Map, which indexes all User objects by their Unix user ID.
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t UserMapRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key identifying an interface (client interface or service) of a particular user.  Used as the
+ * key of the Binding Map, the Service Map and the Binding Target Map.  The key is embedded in the
+ * object that is stored in the map, so both pointers must remain valid for as long as the object
+ * is in the map.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const User_t*   userPtr;            ///< Ptr to the User object that owns the interface.
+    const char*     interfaceName;      ///< Name of the interface.
+}
+InterfaceKey_t;
+
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -267,6 +306,7 @@ typedef struct
     User_t*                     userPtr;        ///< Pointer to the User object for the client uid.
     pid_t                       pid;            ///< Process ID of client process.
     svcdir_InterfaceDetails_t   interface;      ///< IPC interface details.
+    InterfaceKey_t              serviceKey;     ///< Key in the Service Map (once advertised).
 }
 ServerConnection_t;
 
@@ -277,6 +317,41 @@ ServerConnection_t;
 static le_mem_PoolRef_t ServerConnectionPoolRef;
 
 
+//--------------------------------------------------------------------------------------------------
+/// The Service Map, which indexes the Server Connections on all users' Service Lists by
+/// (server user, service name).
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t ServiceMapRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Represents a service (server user and service name) that one or more bindings point to.
+ * Objects of this type are allocated from the Binding Target Pool and are indexed in the
+ * Binding Target Map.  Each Binding object holds a reference count on its Binding Target.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    InterfaceKey_t      key;                ///< Key in the Binding Target Map.
+    char                serviceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES]; ///< Service name
+    le_dls_List_t       bindingList;        ///< List of Bindings that point to this service.
+}
+BindingTarget_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/// Pool from which Binding Target objects are allocated.
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t BindingTargetPoolRef;
+
+
+//--------------------------------------------------------------------------------------------------
+/// The Binding Target Map, which indexes Binding Target objects by (server user, service name).
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t BindingTargetMapRef;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Represents a binding from a user's client interface to a service.  Objects of this type are
@@ -286,10 +361,13 @@ static le_mem_PoolRef_t ServerConnectionPoolRef;
 typedef struct
 {
     le_dls_Link_t       link;               ///< Used to link into the User's Binding List.
+    le_dls_Link_t       targetLink;         ///< Used to link into the Target's Binding List.
     User_t*             clientUserPtr;      ///< Ptr to the client User whose Binding List I'm in.
     User_t*             serverUserPtr;      ///< Ptr to the User who serves the service.
     char                clientInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES];///< Client I/F name
     char                serverInterfaceName[LIMIT_MAX_IPC_INTERFACE_NAME_BYTES];///< Service name
+    InterfaceKey_t      clientKey;          ///< Key in the Binding Map.
+    BindingTarget_t*    targetPtr;          ///< Ptr to the Binding Target for the service.
     ServerConnection_t* serverConnectionPtr;///< Ptr to Server Connection (NULL if service unavail.)
     le_dls_List_t       waitingClientsList; ///< List of Client Connections waiting for the service.
 }
@@ -302,6 +380,13 @@ Binding_t;
 static le_mem_PoolRef_t BindingPoolRef;
 
 
+//--------------------------------------------------------------------------------------------------
+/// The Binding Map, which indexes the Bindings on all users' Binding Lists by
+/// (client user, client interface name).
+//--------------------------------------------------------------------------------------------------
+static le_hashmap_Ref_t BindingMapRef;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Enumeration of the different states that a client connection can be in.
@@ -372,6 +457,48 @@ static le_fdMonitor_Ref_t ServerSocketMonitorRef;
 // =======================================
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hashing function for Interface Keys.
+ *
+ * @return The hash value of the key.
+ **/
+//--------------------------------------------------------------------------------------------------
+static size_t HashInterfaceKey
+(
+    const void* keyPtr  ///< [in] Ptr to the Interface Key.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const InterfaceKey_t* interfaceKeyPtr = keyPtr;
+
+    return le_hashmap_HashString(interfaceKeyPtr->interfaceName) * 31
+           + interfaceKeyPtr->userPtr->uid;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Equality function for Interface Keys.
+ *
+ * @return true if the keys refer to the same interface of the same user.
+ **/
+//--------------------------------------------------------------------------------------------------
+static bool EqualsInterfaceKey
+(
+    const void* firstKeyPtr,    ///< [in] Ptr to the first Interface Key.
+    const void* secondKeyPtr    ///< [in] Ptr to the second Interface Key.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const InterfaceKey_t* firstPtr = firstKeyPtr;
+    const InterfaceKey_t* secondPtr = secondKeyPtr;
+
+    return (   (firstPtr->userPtr == secondPtr->userPtr)
+            && (strcmp(firstPtr->interfaceName, secondPtr->interfaceName) == 0) );
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a User object for a given Unix user ID.
@@ -401,8 +528,9 @@ static User_t* CreateUser
     userPtr->serviceList = LE_DLS_LIST_INIT;
     userPtr->unboundClientsList = LE_DLS_LIST_INIT;
 
-    // Add it to the User List.
+    // Add it to the User List and the User Map.
     le_dls_Queue(&UserList, &userPtr->link);
+    le_hashmap_Put(UserMapRef, &userPtr->uid, userPtr);
 
     return userPtr;
 }
@@ -410,7 +538,7 @@ static User_t* CreateUser
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Searches the User List for a particular Unix user ID.  If found, increments the reference count
+ * Looks up a particular Unix user ID in the User Map.  If found, increments the reference count
  * on that object.  If not found, creates a new User object.
  *
  * @return Pointer to the User object.
@@ -422,19 +550,12 @@ static User_t* GetUser
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&UserList);
+    User_t* userPtr = le_hashmap_Get(UserMapRef, &uid);
 
-    while (linkPtr != NULL)
+    if (userPtr != NULL)
     {
-        User_t* userPtr = CONTAINER_OF(linkPtr, User_t, link);
-
-        if (userPtr->uid == uid)
-        {
-            le_mem_AddRef(userPtr);
-            return userPtr;
-        }
-
-        linkPtr = le_dls_PeekNext(&UserList, linkPtr);
+        le_mem_AddRef(userPtr);
+        return userPtr;
     }
 
     return CreateUser(uid);
@@ -455,14 +576,15 @@ static void UserDestructor
 {
     User_t* userPtr = objPtr;
 
-    // Remove the User object from the User List.
+    // Remove the User object from the User List and the User Map.
     le_dls_Remove(&UserList, &userPtr->link);
+    le_hashmap_Remove(UserMapRef, &userPtr->uid);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Searches a (client) User's Binding List for a particular client-side interface name.
+ * Looks up a (client) User's binding for a particular client-side interface name.
  *
  * @return Pointer to the Binding object or NULL if not found.
  **/
@@ -474,21 +596,9 @@ static Binding_t* FindBinding
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&userPtr->bindingList);
+    InterfaceKey_t key = { .userPtr = userPtr, .interfaceName = interfaceName };
 
-    while (linkPtr != NULL)
-    {
-        Binding_t* bindingPtr = CONTAINER_OF(linkPtr, Binding_t, link);
-
-        if (strcmp(bindingPtr->clientInterfaceName, interfaceName) == 0)
-        {
-            return bindingPtr;
-        }
-
-        linkPtr = le_dls_PeekNext(&userPtr->bindingList, linkPtr);
-    }
-
-    return NULL;
+    return le_hashmap_Get(BindingMapRef, &key);
 }
 
 
@@ -599,9 +709,9 @@ static le_result_t ReceiveMessage
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Searches a User's Service List for a particular service name.
+ * Looks up a particular service name among the services on a User's Service List.
  *
- * @return Pointer to the Server Connection object for the matching service.
+ * @return Pointer to the Server Connection object for the matching service, or NULL if not found.
  **/
 //--------------------------------------------------------------------------------------------------
 static ServerConnection_t* FindService
@@ -611,21 +721,86 @@ static ServerConnection_t* FindService
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&userPtr->serviceList);
+    InterfaceKey_t key = { .userPtr = userPtr, .interfaceName = serviceName };
 
-    while (linkPtr != NULL)
-    {
-        ServerConnection_t* serverConnectionPtr = CONTAINER_OF(linkPtr, ServerConnection_t, link);
+    return le_hashmap_Get(ServiceMapRef, &key);
+}
 
-        if (strcmp(serverConnectionPtr->interface.interfaceName, serviceName) == 0)
-        {
-            return serverConnectionPtr;
-        }
 
-        linkPtr = le_dls_PeekNext(&userPtr->serviceList, linkPtr);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Looks up the Binding Target for a given service of a given (server) user.
+ *
+ * @return Pointer to the Binding Target object, or NULL if no binding points to the service.
+ **/
+//--------------------------------------------------------------------------------------------------
+static BindingTarget_t* FindBindingTarget
+(
+    const User_t* userPtr,      ///< [in] Ptr to the server's User object.
+    const char* serviceName     ///< [in] Service name string.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    InterfaceKey_t key = { .userPtr = userPtr, .interfaceName = serviceName };
+
+    return le_hashmap_Get(BindingTargetMapRef, &key);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the Binding Target for a given service of a given (server) user, creating it if it doesn't
+ * exist yet.  Increments the reference count on an existing object.
+ *
+ * @return Pointer to the Binding Target object.
+ **/
+//--------------------------------------------------------------------------------------------------
+static BindingTarget_t* GetBindingTarget
+(
+    User_t* userPtr,            ///< [in] Ptr to the server's User object.
+    const char* serviceName     ///< [in] Service name string.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    BindingTarget_t* targetPtr = FindBindingTarget(userPtr, serviceName);
+
+    if (targetPtr != NULL)
+    {
+        le_mem_AddRef(targetPtr);
+        return targetPtr;
     }
 
-    return NULL;
+    targetPtr = le_mem_ForceAlloc(BindingTargetPoolRef);
+
+    // Note: we know the service name is a valid length.
+    le_utf8_Copy(targetPtr->serviceName, serviceName, sizeof(targetPtr->serviceName), NULL);
+    targetPtr->key.userPtr = userPtr;
+    targetPtr->key.interfaceName = targetPtr->serviceName;
+    targetPtr->bindingList = LE_DLS_LIST_INIT;
+
+    le_hashmap_Put(BindingTargetMapRef, &targetPtr->key, targetPtr);
+
+    return targetPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Destructor function that runs when a Binding Target object's reference count reaches zero and
+ * the object is about to be released back into its pool.
+ *
+ * @note The Bindings hold references to the server User object, so it is still valid here.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BindingTargetDestructor
+(
+    void* objPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    BindingTarget_t* targetPtr = objPtr;
+
+    le_hashmap_Remove(BindingTargetMapRef, &targetPtr->key);
 }
 
 
@@ -912,10 +1087,12 @@ static void FollowBinding
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a Binding object for a given binding between a client user's interface name and a
- * Service.
+ * Service, without checking for unbound client connections that match the new binding.
+ *
+ * @return Pointer to the new Binding object, or NULL if an identical binding already exists.
  **/
 //--------------------------------------------------------------------------------------------------
-static void CreateBinding
+static Binding_t* AddBinding
 (
     uid_t   clientUserId,               ///< [in] Client's user ID.
     const char* clientInterfaceName,    ///< [in] Client's interface name.
@@ -944,7 +1121,7 @@ static void CreateBinding
                     serverInterfaceName);
             le_mem_Release(clientUserPtr);
             le_mem_Release(serverUserPtr);
-            return;
+            return NULL;
         }
 
         // Warn if it's not the same.
@@ -975,6 +1152,7 @@ static void CreateBinding
     Binding_t* bindingPtr = le_mem_ForceAlloc(BindingPoolRef);
 
     bindingPtr->link = LE_DLS_LINK_INIT;
+    bindingPtr->targetLink = LE_DLS_LINK_INIT;
 
     // Copy the interface names into the Binding object.
     // Note: we know the interface names are valid lengths.
@@ -994,13 +1172,36 @@ static void CreateBinding
     bindingPtr->serverConnectionPtr = NULL;
     bindingPtr->waitingClientsList = LE_DLS_LIST_INIT;
 
-    // Add the Binding to the client User's Binding List.
+    // Add the Binding to the client User's Binding List and the Binding Map.
     le_dls_Queue(&bindingPtr->clientUserPtr->bindingList, &bindingPtr->link);
+    bindingPtr->clientKey.userPtr = clientUserPtr;
+    bindingPtr->clientKey.interfaceName = bindingPtr->clientInterfaceName;
+    le_hashmap_Put(BindingMapRef, &bindingPtr->clientKey, bindingPtr);
+
+    // Add the Binding to the Binding List of the service it points to, so the server can find
+    // it quickly when it advertises or withdraws the service.
+    bindingPtr->targetPtr = GetBindingTarget(serverUserPtr, serverInterfaceName);
+    le_dls_Queue(&bindingPtr->targetPtr->bindingList, &bindingPtr->targetLink);
 
     // Look for a server serving the binding's destination service.
     bindingPtr->serverConnectionPtr = FindService(bindingPtr->serverUserPtr, serverInterfaceName);
 
-    // Check for unbound client connections that match the new binding.
+    return bindingPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dispatches a User's unbound client connections that match a given client interface name via
+ * the binding for that interface.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ResolveUnboundClients
+(
+    Binding_t* bindingPtr       ///< [in] Ptr to the (new) Binding.
+)
+//--------------------------------------------------------------------------------------------------
+{
     le_dls_List_t* unboundClientsListPtr = &(bindingPtr->clientUserPtr->unboundClientsList);
     le_dls_Link_t* linkPtr = le_dls_Peek(unboundClientsListPtr);
     while (linkPtr != NULL)
@@ -1012,7 +1213,8 @@ static void CreateBinding
         linkPtr = le_dls_PeekNext(unboundClientsListPtr, linkPtr);
 
         // If this is the binding this client has been waiting for,
-        if (strcmp(clientConnectionPtr->interface.interfaceName, clientInterfaceName) == 0)
+        if (strcmp(clientConnectionPtr->interface.interfaceName,
+                   bindingPtr->clientInterfaceName) == 0)
         {
             // Remove this client connection from the list of unbound clients and
             // dispatch it via the binding.
@@ -1024,6 +1226,81 @@ static void CreateBinding
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Dispatches all users' unbound client connections for which a binding now exists.
+ *
+ * This is used after a batch of bindings has been added, so each Unbound Clients List is walked
+ * once per batch rather than once per binding.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ResolveAllUnboundClients
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Link_t* userLinkPtr = le_dls_Peek(&UserList);
+
+    while (userLinkPtr != NULL)
+    {
+        User_t* userPtr = CONTAINER_OF(userLinkPtr, User_t, link);
+
+        // Dispatching a client releases the Client Connection's reference to the User object,
+        // so hold a reference to ensure that it doesn't go away while we walk its list.
+        le_mem_AddRef(userPtr);
+
+        le_dls_List_t* unboundClientsListPtr = &(userPtr->unboundClientsList);
+        le_dls_Link_t* linkPtr = le_dls_Peek(unboundClientsListPtr);
+        while (linkPtr != NULL)
+        {
+            ClientConnection_t* clientConnectionPtr = CONTAINER_OF(linkPtr,
+                                                                   ClientConnection_t,
+                                                                   link);
+            linkPtr = le_dls_PeekNext(unboundClientsListPtr, linkPtr);
+
+            Binding_t* bindingPtr = FindBinding(userPtr,
+                                                clientConnectionPtr->interface.interfaceName);
+            if (bindingPtr != NULL)
+            {
+                le_dls_Remove(unboundClientsListPtr, &clientConnectionPtr->link);
+                FollowBinding(bindingPtr, clientConnectionPtr, true /* shouldWait */ );
+            }
+        }
+
+        userLinkPtr = le_dls_PeekNext(&UserList, userLinkPtr);
+
+        le_mem_Release(userPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a Binding object for a given binding between a client user's interface name and a
+ * Service, and dispatches any unbound client connections that match the new binding.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void CreateBinding
+(
+    uid_t   clientUserId,               ///< [in] Client's user ID.
+    const char* clientInterfaceName,    ///< [in] Client's interface name.
+    uid_t   serverUserId,               ///< [in] Server's user ID.
+    const char* serverInterfaceName     ///< [in] Server's interface (service) name.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Binding_t* bindingPtr = AddBinding(clientUserId,
+                                       clientInterfaceName,
+                                       serverUserId,
+                                       serverInterfaceName);
+    if (bindingPtr != NULL)
+    {
+        ResolveUnboundClients(bindingPtr);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create built-in, hard-coded bindings.
@@ -1075,51 +1352,43 @@ static void ResolveBindingsToServer
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // For each user,
-    le_dls_Link_t* userLinkPtr = le_dls_Peek(&UserList);
+    // Find the bindings that point at the new server's service.
+    BindingTarget_t* targetPtr = FindBindingTarget(connectionPtr->userPtr,
+                                                   connectionPtr->interface.interfaceName);
+    if (targetPtr == NULL)
+    {
+        return;
+    }
 
-    while (userLinkPtr != NULL)
+    // For each of those bindings,
+    le_dls_Link_t* bindingLinkPtr = le_dls_Peek(&targetPtr->bindingList);
+    while (bindingLinkPtr != NULL)
     {
-        User_t* userPtr = CONTAINER_OF(userLinkPtr, User_t, link);
+        Binding_t* bindingPtr = CONTAINER_OF(bindingLinkPtr, Binding_t, targetLink);
 
-        // For each of the user's bindings,
-        le_dls_Link_t* bindingLinkPtr = le_dls_Peek(&userPtr->bindingList);
-        while (bindingLinkPtr != NULL)
-        {
-            Binding_t* bindingPtr = CONTAINER_OF(bindingLinkPtr, Binding_t, link);
+        bindingPtr->serverConnectionPtr = connectionPtr;
 
-            // If the binding is pointing at the new server's service,
-            if (   (connectionPtr->userPtr == bindingPtr->serverUserPtr)
-                && (0 == strcmp(connectionPtr->interface.interfaceName,
-                                bindingPtr->serverInterfaceName))  )
+        // While there's still a client connection on the Waiting Clients List, get
+        // a pointer to the first one, without removing it from the list, then try
+        // to dispatch that client to the server.
+        le_dls_Link_t* clientLinkPtr;
+        while (NULL != (clientLinkPtr = le_dls_Peek(&bindingPtr->waitingClientsList)))
+        {
+            ClientConnection_t* clientConnectionPtr = CONTAINER_OF(clientLinkPtr,
+                                                                   ClientConnection_t,
+                                                                   link);
+            if (DispatchToServer(clientConnectionPtr, connectionPtr) == LE_CLOSED)
             {
-                bindingPtr->serverConnectionPtr = connectionPtr;
-
-                // While there's still a client connection on the Waiting Clients List, get
-                // a pointer to the first one, without removing it from the list, then try
-                // to dispatch that client to the server.
-                le_dls_Link_t* clientLinkPtr;
-                while (NULL != (clientLinkPtr = le_dls_Peek(&bindingPtr->waitingClientsList)))
-                {
-                    ClientConnection_t* clientConnectionPtr = CONTAINER_OF(clientLinkPtr,
-                                                                           ClientConnection_t,
-                                                                           link);
-                    if (DispatchToServer(clientConnectionPtr, connectionPtr) == LE_CLOSED)
-                    {
-                        // Server went down.  Client was left on the Waiting Clients List.
-                        // Server Connection destructor was run and it disconnected itself
-                        // from the Binding object.
-                        return;
-                    }
-                    // NOTE: If the server didn't go down, then the Client Connection has been
-                    // deleted and its destructor removed it from the Waiting Clients List.
-                }
+                // Server went down.  Client was left on the Waiting Clients List.
+                // Server Connection destructor was run and it disconnected itself
+                // from the Binding object.
+                return;
             }
-
-            bindingLinkPtr = le_dls_PeekNext(&userPtr->bindingList, bindingLinkPtr);
+            // NOTE: If the server didn't go down, then the Client Connection has been
+            // deleted and its destructor removed it from the Waiting Clients List.
         }
 
-        userLinkPtr = le_dls_PeekNext(&UserList, userLinkPtr);
+        bindingLinkPtr = le_dls_PeekNext(&targetPtr->bindingList, bindingLinkPtr);
     }
 }
 
@@ -1153,8 +1422,11 @@ static void ProcessAdvertisementFromServer
     // connection to the service list.
     else
     {
-        // Add the object to the User's Service List.
+        // Add the object to the User's Service List and the Service Map.
         le_dls_Queue(&connectionPtr->userPtr->serviceList, &connectionPtr->link);
+        connectionPtr->serviceKey.userPtr = connectionPtr->userPtr;
+        connectionPtr->serviceKey.interfaceName = connectionPtr->interface.interfaceName;
+        le_hashmap_Put(ServiceMapRef, &connectionPtr->serviceKey, connectionPtr);
 
         LE_DEBUG("Server (uid %u '%s', pid %d) now serving service '%s' (%s).",
                  connectionPtr->userPtr->uid,
@@ -1715,33 +1987,6 @@ static void ServerConnectionDestructor
 {
     ServerConnection_t* connectionPtr = objPtr;
 
-    // Disassociate the Server Connection object from all Binding objects that refer to it...
-
-    // For each user,
-    le_dls_Link_t* userLinkPtr = le_dls_Peek(&UserList);
-
-    while (userLinkPtr != NULL)
-    {
-        User_t* userPtr = CONTAINER_OF(userLinkPtr, User_t, link);
-
-        // For each of the user's bindings,
-        le_dls_Link_t* bindingLinkPtr = le_dls_Peek(&userPtr->bindingList);
-        while (bindingLinkPtr != NULL)
-        {
-            Binding_t* bindingPtr = CONTAINER_OF(bindingLinkPtr, Binding_t, link);
-
-            // If the binding is associated with the deleted server connection,
-            if (connectionPtr == bindingPtr->serverConnectionPtr)
-            {
-                bindingPtr->serverConnectionPtr = NULL;
-            }
-
-            bindingLinkPtr = le_dls_PeekNext(&userPtr->bindingList, bindingLinkPtr);
-        }
-
-        userLinkPtr = le_dls_PeekNext(&UserList, userLinkPtr);
-    }
-
     if (connectionPtr->interface.interfaceName[0] == '\0')
     {
         LE_DEBUG("Server (uid %u '%s', pid %d) disconnected without ever advertising a service.",
@@ -1764,6 +2009,27 @@ static void ServerConnectionDestructor
         if (le_dls_IsInList(&connectionPtr->userPtr->serviceList, &connectionPtr->link))
         {
             le_dls_Remove(&connectionPtr->userPtr->serviceList, &connectionPtr->link);
+            le_hashmap_Remove(ServiceMapRef, &connectionPtr->serviceKey);
+
+            // Disassociate the Server Connection object from all Binding objects that refer to it.
+            // Only a connection that made it into the Service List can be referred to.
+            BindingTarget_t* targetPtr = FindBindingTarget(connectionPtr->userPtr,
+                                                           connectionPtr->interface.interfaceName);
+            if (targetPtr != NULL)
+            {
+                le_dls_Link_t* bindingLinkPtr = le_dls_Peek(&targetPtr->bindingList);
+                while (bindingLinkPtr != NULL)
+                {
+                    Binding_t* bindingPtr = CONTAINER_OF(bindingLinkPtr, Binding_t, targetLink);
+
+                    if (connectionPtr == bindingPtr->serverConnectionPtr)
+                    {
+                        bindingPtr->serverConnectionPtr = NULL;
+                    }
+
+                    bindingLinkPtr = le_dls_PeekNext(&targetPtr->bindingList, bindingLinkPtr);
+                }
+            }
         }
     }
 
@@ -1854,8 +2120,16 @@ static void BindingDestructor
 {
     Binding_t* bindingPtr = objPtr;
 
-    // Remove the Binding object from the User's Binding List.
+    // Remove the Binding object from the User's Binding List and the Binding Map.
     le_dls_Remove(&bindingPtr->clientUserPtr->bindingList, &bindingPtr->link);
+    le_hashmap_Remove(BindingMapRef, &bindingPtr->clientKey);
+
+    // Remove the Binding object from its Binding Target's list and release the target.
+    // NOTE: This must be done before releasing the server's User object, which is part of the
+    //       target's key.
+    le_dls_Remove(&bindingPtr->targetPtr->bindingList, &bindingPtr->targetLink);
+    le_mem_Release(bindingPtr->targetPtr);
+    bindingPtr->targetPtr = NULL;
 
     // While the list of waiting clients is not empty, pop one off and process it.
     le_dls_Link_t* linkPtr;
@@ -2517,43 +2791,97 @@ static void SdirToolUnbindAll
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Handles a "Bind" request from the 'sdir' tool.
+ * Checks the binding details received from the 'sdir' tool.
+ *
+ * @return true if the binding is valid.  Otherwise, the client has been killed.
  */
 //--------------------------------------------------------------------------------------------------
-static void SdirToolBind
+static bool IsValidToolBinding
 (
-    const le_sdtp_Msg_t* msgPtr   ///< [in] Pointer to the request message payload.
+    const le_sdtp_Binding_t* bindingPtr   ///< [in] Pointer to the binding details.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    size_t len = strnlen(msgPtr->clientInterfaceName, LIMIT_MAX_IPC_INTERFACE_NAME_BYTES);
+    size_t len = strnlen(bindingPtr->clientInterfaceName, LIMIT_MAX_IPC_INTERFACE_NAME_BYTES);
     if (len == 0)
     {
         LE_KILL_CLIENT("Client interface name empty.");
+        return false;
     }
-    else if (len == LIMIT_MAX_IPC_INTERFACE_NAME_BYTES)
+    if (len == LIMIT_MAX_IPC_INTERFACE_NAME_BYTES)
     {
         LE_KILL_CLIENT("Client interface name not null terminated!");
+        return false;
     }
-    else
+
+    len = strnlen(bindingPtr->serverInterfaceName, LIMIT_MAX_IPC_INTERFACE_NAME_BYTES);
+    if (len == 0)
     {
-        len = strnlen(msgPtr->serverInterfaceName, LIMIT_MAX_IPC_INTERFACE_NAME_BYTES);
-        if (len == 0)
-        {
-            LE_KILL_CLIENT("Server interface name empty.");
-        }
-        else if (len == LIMIT_MAX_IPC_INTERFACE_NAME_BYTES)
-        {
-            LE_KILL_CLIENT("Server interface name not null terminated!");
-        }
-        else
+        LE_KILL_CLIENT("Server interface name empty.");
+        return false;
+    }
+    if (len == LIMIT_MAX_IPC_INTERFACE_NAME_BYTES)
+    {
+        LE_KILL_CLIENT("Server interface name not null terminated!");
+        return false;
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Handles a "Bind" request from the 'sdir' tool.
+ *
+ * All the bindings in the request are created first.  Unbound client connections are then
+ * matched against them in a single pass.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SdirToolBind
+(
+    const le_sdtp_Msg_t* msgPtr   ///< [in] Pointer to the request message payload.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((msgPtr->bindingCount == 0) || (msgPtr->bindingCount > LE_SDTP_MAX_BINDINGS_PER_MSG))
+    {
+        LE_KILL_CLIENT("Invalid binding count %" PRIu32 ".", msgPtr->bindingCount);
+        return;
+    }
+
+    uint32_t i;
+    for (i = 0; i < msgPtr->bindingCount; i++)
+    {
+        if (!IsValidToolBinding(&msgPtr->bindings[i]))
         {
-            CreateBinding(msgPtr->client,
-                          msgPtr->clientInterfaceName,
-                          msgPtr->server,
-                          msgPtr->serverInterfaceName);
+            return;
         }
     }
+
+    // A single binding only needs to check the client's Unbound Clients List for one interface.
+    if (msgPtr->bindingCount == 1)
+    {
+        const le_sdtp_Binding_t* bindingPtr = &msgPtr->bindings[0];
+
+        CreateBinding(bindingPtr->client,
+                      bindingPtr->clientInterfaceName,
+                      bindingPtr->server,
+                      bindingPtr->serverInterfaceName);
+        return;
+    }
+
+    for (i = 0; i < msgPtr->bindingCount; i++)
+    {
+        const le_sdtp_Binding_t* bindingPtr = &msgPtr->bindings[i];
+
+        AddBinding(bindingPtr->client,
+                   bindingPtr->clientInterfaceName,
+                   bindingPtr->server,
+                   bindingPtr->serverInterfaceName);
+    }
+
+    ResolveAllUnboundClients();
 }
 
 
@@ -2640,19 +2968,40 @@ COMPONENT_INIT
     ServerConnectionPoolRef = le_mem_CreatePool("Server Connection", sizeof(ServerConnection_t));
     UserPoolRef = le_mem_CreatePool("User", sizeof(User_t));
     BindingPoolRef = le_mem_CreatePool("Binding", sizeof(Binding_t));
+    BindingTargetPoolRef = le_mem_CreatePool("Binding Target", sizeof(BindingTarget_t));
 
     /// Expand the pools to their expected maximum sizes.
-    /// @todo Make this configurable.
     le_mem_ExpandPool(ClientConnectionPoolRef, 100);
-    le_mem_ExpandPool(ServerConnectionPoolRef, 30);
-    le_mem_ExpandPool(UserPoolRef, 30);
-    le_mem_ExpandPool(BindingPoolRef, 30);
+    le_mem_ExpandPool(ServerConnectionPoolRef, LE_CONFIG_SVCDIR_EXPECTED_SERVICES);
+    le_mem_ExpandPool(UserPoolRef, LE_CONFIG_SVCDIR_EXPECTED_USERS);
+    le_mem_ExpandPool(BindingPoolRef, LE_CONFIG_SVCDIR_EXPECTED_BINDINGS);
+    le_mem_ExpandPool(BindingTargetPoolRef, LE_CONFIG_SVCDIR_EXPECTED_BINDINGS);
+
+    // Create the indexes.
+    LE_ASSERT(sizeof(uid_t) == sizeof(uint32_t));
+    UserMapRef = le_hashmap_Create("Users",
+                                   LE_CONFIG_SVCDIR_EXPECTED_USERS,
+                                   le_hashmap_HashUInt32,
+                                   le_hashmap_EqualsUInt32);
+    BindingMapRef = le_hashmap_Create("Bindings",
+                                      LE_CONFIG_SVCDIR_EXPECTED_BINDINGS,
+                                      HashInterfaceKey,
+                                      EqualsInterfaceKey);
+    BindingTargetMapRef = le_hashmap_Create("Binding Targets",
+                                            LE_CONFIG_SVCDIR_EXPECTED_BINDINGS,
+                                            HashInterfaceKey,
+                                            EqualsInterfaceKey);
+    ServiceMapRef = le_hashmap_Create("Services",
+                                      LE_CONFIG_SVCDIR_EXPECTED_SERVICES,
+                                      HashInterfaceKey,
+                                      EqualsInterfaceKey);
 
     // Register destructor functions.
     le_mem_SetDestructor(ClientConnectionPoolRef, ClientConnectionDestructor);
     le_mem_SetDestructor(ServerConnectionPoolRef, ServerConnectionDestructor);
     le_mem_SetDestructor(UserPoolRef, UserDestructor);
     le_mem_SetDestructor(BindingPoolRef, BindingDestructor);
+    le_mem_SetDestructor(BindingTargetPoolRef, BindingTargetDestructor);
 
     // Create built-in, hard-coded bindings.
     CreateHardCodedBindings();
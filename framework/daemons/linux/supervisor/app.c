@@ -2459,6 +2459,18 @@ static le_result_t CreateDefaultTmpLinks
         }
     }
 
+#if LE_CONFIG_LOG_STORE
+    // The log store socket is missing if the Log Control Daemon couldn't open the store, in which
+    // case there's nothing to link.
+    const char* storeSocketPathPtr = LE_CONFIG_RUNTIME_DIR "/" LE_CONFIG_LOG_STORE_SOCKET_NAME;
+
+    if ((access(storeSocketPathPtr, F_OK) == 0) &&
+        (CreateFileLink(appRef, appDirLabelPtr, storeSocketPathPtr, "/tmp/legato/") != LE_OK))
+    {
+        return LE_FAULT;
+    }
+#endif
+
     return LE_OK;
 }
 
@@ -11,9 +11,12 @@
 #include "smack.h"
 #include "sysPaths.h"
 #include "kernelModules.h"
+#include "kmodLoader.h"
 #include "le_cfg_interface.h"
 #include "supervisor.h"
 
+#include <sys/syscall.h>
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Memory pool size for module objects and strings
@@ -41,6 +44,15 @@
 #define STRINGS_MAX_BUFFER_SIZE (LE_CFG_NAME_LEN + LE_CFG_STR_LEN + 2 + 2)
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of the parameter string passed to finit_module(), in the form of
+ * "<name>=<value> <name>=<value> ...\0".
+ */
+//--------------------------------------------------------------------------------------------------
+#define PARAMS_MAX_BUFFER_SIZE 4096
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Root of configTree containing module parameters
@@ -51,7 +63,8 @@
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Module insert command and format, arguments are module path and module params
+ * Module insert command and format, arguments are module path and module params.
+ * Only used if the kernel doesn't support finit_module().
  */
 //--------------------------------------------------------------------------------------------------
 #define INSMOD_COMMAND "/sbin/insmod"
@@ -122,6 +135,9 @@ typedef struct
                                                              // traversing to detect cycle
     bool               recurStack;                           // Track recursion stack while
                                                              // traversing to detect cycle
+    bool               isLevelKnown;                         // has level been computed
+    size_t             level;                                // Depth in the dependency graph
+    kmodLoader_Job_t   loadJob;                              // Job to load the module
 }
 KModuleObj_t;
 
@@ -136,6 +152,7 @@ static struct {
     le_mem_PoolRef_t    stringPool;        // memory pool of strings (for argv)
     le_mem_PoolRef_t    reqModStringPool;  // memory pool of required kernel modules strings
     le_mem_PoolRef_t    depModStringPool;  // memory pool of depend system kernel modules strings
+    le_mem_PoolRef_t    paramsPool;        // memory pool of finit_module() parameter strings
     le_hashmap_Ref_t    moduleTable;       // table for kernel module objects
     le_hashmap_Ref_t    dependModuleTable; // table for depends system kernel modules
 } KModuleHandler = {NULL};
@@ -1025,136 +1042,341 @@ static le_result_t TraverseDependencyInsert
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Install each kernel module.
- * modprobe the system dependency module and insmod the Legato kernel module.
+ * Get the level of a module in the dependency graph: 0 if the module requires no other module,
+ * otherwise one more than the highest level of the modules it requires.
+ *
+ * Modules involved in a cyclic dependency never get here, as traversing their dependencies fails.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t InstallEachKernelModule(KModuleObj_t *m, bool enableUseCount)
+static size_t ModuleGetLevel(KModuleObj_t *m)
+{
+    le_sls_Link_t* modNameLinkPtr;
+    size_t level = 0;
+
+    if (m->isLevelKnown)
+    {
+        return m->level;
+    }
+
+    modNameLinkPtr = le_sls_Peek(&(m->reqModuleName));
+    while (modNameLinkPtr != NULL)
+    {
+        ModNameNode_t* modNameNodePtr = CONTAINER_OF(modNameLinkPtr, ModNameNode_t, link);
+        KModuleObj_t* reqModPtr = le_hashmap_Get(KModuleHandler.moduleTable,
+                                                 modNameNodePtr->modName);
+        if (reqModPtr != NULL)
+        {
+            size_t reqLevel = ModuleGetLevel(reqModPtr) + 1;
+
+            if (reqLevel > level)
+            {
+                level = reqLevel;
+            }
+        }
+
+        modNameLinkPtr = le_sls_PeekNext(&(m->reqModuleName), modNameLinkPtr);
+    }
+
+    m->level = level;
+    m->isLevelKnown = true;
+
+    return level;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * modprobe the system dependency modules of a Legato kernel module.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t InstallDependsModules(KModuleObj_t *mod)
 {
     le_result_t result;
-    le_dls_Link_t *listLink;
-    /* The ordered list of required kernel modules to install */
-    le_dls_List_t ModuleInsertList = LE_DLS_LIST_INIT;
+    le_sls_Link_t *depModNameLinkPtr = le_sls_Peek(&(mod->dependsModuleName));
+
+    while (depModNameLinkPtr != NULL)
+    {
+        DepModNameNode_t* depModNameNodePtr = CONTAINER_OF(depModNameLinkPtr,
+                                                           DepModNameNode_t, link);
+        char *depargv[] = {MODPROBE_COMMAND, depModNameNodePtr->modName, NULL};
+
+        result = ExecuteCommand(depargv, ARRAY_LENGTH(depargv)-1, NULL);
+        if (result != LE_OK)
+        {
+            LE_CRIT("Command '%s' '%s' execution failed.", depargv[0], depargv[1]);
+            return result;
+        }
+
+        DepModNameNode_t *depModPtr = le_hashmap_Get(KModuleHandler.dependModuleTable,
+                                                     depModNameNodePtr->modName);
+        if (depModPtr == NULL)
+        {
+            LE_ERROR("Lookup for module '%s' failed.", depModNameNodePtr->modName);
+            return LE_NOT_FOUND;
+        }
+
+        depModPtr->useCount++;
+        depModNameLinkPtr = le_sls_PeekNext(&(mod->dependsModuleName), depModNameLinkPtr);
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Run the install script of a module and check that the module is live afterwards.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RunInstallScript(KModuleObj_t *mod)
+{
     ProcModules_t procModules;
+    char *scriptargv[] = {mod->installScript, mod->path, NULL};
 
-    result = TraverseDependencyInsert(&ModuleInsertList, m, enableUseCount);
+    le_result_t result = ExecuteCommand(scriptargv, ARRAY_LENGTH(scriptargv)-1, NULL);
     if (result != LE_OK)
     {
-        /* If the module is marked optional, ignore fault, otherwise take fault action. */
-        if (m->isOptional)
+        LE_CRIT("Install script '%s' execution failed", mod->installScript);
+        return result;
+    }
+
+    /* Read module load status from /proc/modules */
+    procModules =  CheckProcModules(mod->name);
+
+    if (procModules.loadStatus != STATUS_INSTALLED)
+    {
+        LE_INFO("Module '%s' not in 'Live' state, wait for 10 seconds.", mod->name);
+        le_thread_Sleep(10);
+
+        /* If the module is not in live state, wait for 10 seconds to see if the
+         * module recovers to live state, otherwise restart the system.
+         */
+        if (procModules.loadStatus != STATUS_INSTALLED)
         {
-            LE_WARN("Traversing module '%s' dependencies failed, ignore as module is optional",
-                    m->name);
-            return LE_OK;
+            if (mod->isOptional)
+            {
+                LE_INFO("Module '%s' not in 'Live' state and is optional. "
+                        "Skip restarting system.", mod->name);
+            }
+            else
+            {
+                LE_CRIT("Module '%s' not in 'Live' state. Restart system ...", mod->name);
+            }
+            return LE_FAULT;
         }
-        else
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load a module's .ko file with finit_module(), passing the module parameters.
+ * Falls back to insmod if the kernel doesn't support finit_module().
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LoadModuleFile(KModuleObj_t *mod)
+{
+    le_result_t result = LE_OK;
+    char *params = le_mem_ForceAlloc(KModuleHandler.paramsPool);
+    size_t paramsLen = 0;
+    int i;
+
+    /* Join the parameters (argv[2] onwards) into one space separated string */
+    params[0] = '\0';
+    for (i = 2; i < mod->argc; i++)
+    {
+        size_t len = 0;
+
+        if ((i > 2) && (paramsLen < PARAMS_MAX_BUFFER_SIZE - 1))
         {
-            LE_ERROR("Traversing module '%s' dependencies failed, fault action will be taken",
-                     m->name);
-            return result;
+            params[paramsLen++] = ' ';
+            params[paramsLen] = '\0';
+        }
+
+        if (le_utf8_Copy(params + paramsLen, mod->argv[i],
+                         PARAMS_MAX_BUFFER_SIZE - paramsLen, &len) != LE_OK)
+        {
+            LE_CRIT("Parameters of module '%s' too long.", mod->name);
+            le_mem_Release(params);
+            return LE_OVERFLOW;
         }
+        paramsLen += len;
     }
 
-    while ((listLink = le_dls_Pop(&ModuleInsertList)) != NULL)
+    LE_INFO("Load '%s' %s", mod->path, params);
+
+    int fd = open(mod->path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
     {
-        KModuleObj_t *mod = CONTAINER_OF(listLink, KModuleObj_t, dependencyLink);
+        LE_CRIT("Failed to open module '%s' (%m).", mod->path);
+        le_mem_Release(params);
+        return LE_FAULT;
+    }
 
-        if (mod->moduleLoadStatus != STATUS_INSTALLED)
+    if (syscall(SYS_finit_module, fd, params, 0) != 0)
+    {
+        if (errno == ENOSYS)
         {
-            le_sls_Link_t *depModNameLinkPtr = le_sls_Peek(&(mod->dependsModuleName));
+            LE_DEBUG("finit_module() not supported, using insmod.");
+            mod->argv[0] = INSMOD_COMMAND;
+            result = ExecuteCommand(mod->argv, mod->argc, NULL);
+        }
+        else
+        {
+            LE_CRIT("Failed to load module '%s' (%m).", mod->path);
+            result = LE_FAULT;
+        }
+    }
 
-            while (depModNameLinkPtr != NULL)
-            {
-                /* Install dependency system modules if any before installing the Legato module */
-                DepModNameNode_t* depModNameNodePtr = CONTAINER_OF(depModNameLinkPtr,
-                                                                   DepModNameNode_t, link);
-                char *depargv[] = {MODPROBE_COMMAND, depModNameNodePtr->modName, NULL};
+    fd_Close(fd);
+    le_mem_Release(params);
 
-                result = ExecuteCommand(depargv, ARRAY_LENGTH(depargv)-1, NULL);
-                if (result != LE_OK)
-                {
-                    LE_CRIT("Command '%s' '%s' execution failed.", depargv[0], depargv[1]);
-                    return result;
-                }
+    return result;
+}
 
-                DepModNameNode_t *depModPtr = le_hashmap_Get(KModuleHandler.dependModuleTable,
-                                                             depModNameNodePtr->modName);
-                if (depModPtr == NULL)
-                {
-                    LE_ERROR("Lookup for module '%s' failed.", depModNameNodePtr->modName);
-                    return LE_NOT_FOUND;
-                }
 
-                depModPtr->useCount++;
-                depModNameLinkPtr = le_sls_PeekNext(&(mod->dependsModuleName), depModNameLinkPtr);
-            }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load function for the kernel module loader: execute the install script of the module if it is
+ * provided, otherwise load the module's .ko file.  May run in several threads at once.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t LoadModule(void *contextPtr)
+{
+    KModuleObj_t *mod = contextPtr;
 
-            /* If install script is provided, execute the script otherwise execute insmod */
-            if (strcmp(mod->installScript, "") != 0)
-            {
-                char *scriptargv[] = {mod->installScript, mod->path, NULL};
+    if (strcmp(mod->installScript, "") != 0)
+    {
+        return RunInstallScript(mod);
+    }
 
-                result = ExecuteCommand(scriptargv, ARRAY_LENGTH(scriptargv)-1, NULL);
-                if (result != LE_OK)
-                {
-                    LE_CRIT("Install script '%s' execution failed", mod->installScript);
+    return LoadModuleFile(mod);
+}
 
-                    if (mod->isOptional)
-                    {
-                        continue;
-                    }
-                    return result;
-                }
 
-                /* Read module load status from /proc/modules */
-                procModules =  CheckProcModules(mod->name);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Move the modules of a list built by TraverseDependencyInsert() to a list of load jobs, skipping
+ * modules that are already installed or already in the job list.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueLoadJobs(le_dls_List_t *moduleInsertListPtr, le_dls_List_t *jobListPtr)
+{
+    le_dls_Link_t *listLink;
 
-                if (procModules.loadStatus != STATUS_INSTALLED)
-                {
-                    LE_INFO("Module '%s' not in 'Live' state, wait for 10 seconds.", mod->name);
-                    le_thread_Sleep(10);
+    while ((listLink = le_dls_Pop(moduleInsertListPtr)) != NULL)
+    {
+        KModuleObj_t *mod = CONTAINER_OF(listLink, KModuleObj_t, dependencyLink);
 
-                    /* If the module is not in live state, wait for 10 seconds to see if the
-                     * module recovers to live state, otherwise restart the system.
-                     */
-                    if (procModules.loadStatus != STATUS_INSTALLED)
-                    {
-                        if (mod->isOptional)
-                        {
-                            LE_INFO(
-                                "Module '%s' not in 'Live' state and is optional. "
-                                "Skip restarting system.",
-                                mod->name);
-                            continue;
-                        }
+        if ((mod->moduleLoadStatus == STATUS_INSTALLED)
+            || le_dls_IsInList(jobListPtr, &(mod->loadJob.link)))
+        {
+            continue;
+        }
 
-                        LE_CRIT("Module '%s' not in 'Live' state. Restart system ...", mod->name);
-                        return LE_FAULT;
-                    }
-                }
-            }
-            else
-            {
-                mod->argv[0] = INSMOD_COMMAND;
+        mod->loadJob.link = LE_DLS_LINK_INIT;
+        mod->loadJob.name = mod->name;
+        mod->loadJob.level = ModuleGetLevel(mod);
+        mod->loadJob.isOptional = mod->isOptional;
+        mod->loadJob.contextPtr = mod;
+        mod->loadJob.result = LE_UNAVAILABLE;
+        le_dls_Queue(jobListPtr, &(mod->loadJob.link));
+    }
+}
 
-                result = ExecuteCommand(mod->argv, mod->argc, NULL);
-                if (result != LE_OK)
-                {
-                    if (mod->isOptional)
-                    {
-                        LE_INFO("Ignoring failure. "
-                                 "Module '%s' failed to load and is an optional module.", mod->name);
-                        continue;
-                    }
-                    return result;
-                }
-            }
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Install the modules of a list of load jobs, emptying the list.
+ *
+ * The system dependency modules are installed first, one by one.  The Legato kernel modules are
+ * then loaded level by level, the modules of a level in parallel (see kmodLoader.h).
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t RunLoadJobs(le_dls_List_t *jobListPtr)
+{
+    le_result_t result = LE_OK;
+    bool isLoaderRun = false;
+    le_dls_Link_t *listLink;
+
+    /* Install dependency system modules if any before installing the Legato modules */
+    for (listLink = le_dls_Peek(jobListPtr);
+         (listLink != NULL) && (result == LE_OK);
+         listLink = le_dls_PeekNext(jobListPtr, listLink))
+    {
+        result = InstallDependsModules(CONTAINER_OF(listLink, KModuleObj_t, loadJob.link));
+    }
+
+    if (result == LE_OK)
+    {
+        result = kmodLoader_Run(jobListPtr, LoadModule, LE_CONFIG_SUPERV_KMOD_MAX_PARALLEL_LOADS);
+        isLoaderRun = true;
+    }
+
+    while ((listLink = le_dls_Pop(jobListPtr)) != NULL)
+    {
+        KModuleObj_t *mod = CONTAINER_OF(listLink, KModuleObj_t, loadJob.link);
+
+        /* No module was loaded if a system dependency module failed to install */
+        if (!isLoaderRun)
+        {
+            continue;
+        }
+
+        if (mod->loadJob.result == LE_OK)
+        {
             mod->moduleLoadStatus = STATUS_INSTALLED;
             LE_INFO("New kernel module '%s'", mod->name);
         }
+        else if ((mod->loadJob.result != LE_UNAVAILABLE) && mod->isOptional)
+        {
+            LE_INFO("Ignoring failure. "
+                    "Module '%s' failed to load and is an optional module.", mod->name);
+        }
     }
-    return LE_OK;
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Install each kernel module.
+ * modprobe the system dependency module and insmod the Legato kernel module.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t InstallEachKernelModule(KModuleObj_t *m, bool enableUseCount)
+{
+    le_result_t result;
+    /* The ordered list of required kernel modules to install */
+    le_dls_List_t ModuleInsertList = LE_DLS_LIST_INIT;
+
+    /* The list of load jobs of those modules */
+    le_dls_List_t jobList = LE_DLS_LIST_INIT;
+
+    result = TraverseDependencyInsert(&ModuleInsertList, m, enableUseCount);
+    if (result != LE_OK)
+    {
+        /* If the module is marked optional, ignore fault, otherwise take fault action. */
+        if (m->isOptional)
+        {
+            LE_WARN("Traversing module '%s' dependencies failed, ignore as module is optional",
+                    m->name);
+            return LE_OK;
+        }
+        else
+        {
+            LE_ERROR("Traversing module '%s' dependencies failed, fault action will be taken",
+                     m->name);
+            return result;
+        }
+    }
+
+    QueueLoadJobs(&ModuleInsertList, &jobList);
+
+    return RunLoadJobs(&jobList);
 }
 
 
@@ -1243,7 +1465,10 @@ static void setIsRequiredModule()
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Iterate through the module table and install kernel module
+ * Iterate through the module table and install kernel module.
+ *
+ * The dependencies of all the auto-loaded modules are gathered first, so that the modules of each
+ * dependency level can be loaded in parallel across the whole system.
  */
 //--------------------------------------------------------------------------------------------------
 static void installModules()
@@ -1251,6 +1476,8 @@ static void installModules()
     KModuleObj_t *modPtr;
     le_result_t result;
     le_dls_Link_t* linkPtr;
+    /* The list of load jobs of all kernel modules to install */
+    le_dls_List_t jobList = LE_DLS_LIST_INIT;
 
     /* Traverse linked list in alphabetical order of module name and traverse dependencies. */
     linkPtr = le_dls_Peek(&ModuleAlphaOrderList);
@@ -1270,16 +1497,38 @@ static void installModules()
             continue;
         }
 
-        result = InstallEachKernelModule(modPtr, true);
+        /* The ordered list of kernel modules required by this module */
+        le_dls_List_t moduleInsertList = LE_DLS_LIST_INIT;
+
+        result = TraverseDependencyInsert(&moduleInsertList, modPtr, true);
         if (result != LE_OK)
         {
-            LE_ERROR("Error in installing module %s. Restarting system ...", modPtr->name);
-            framework_Reboot();
-            break;
+            /* If the module is marked optional, ignore fault, otherwise take fault action. */
+            if (!modPtr->isOptional)
+            {
+                LE_ERROR("Error in installing module %s. Restarting system ...", modPtr->name);
+                framework_Reboot();
+                return;
+            }
+
+            LE_WARN("Traversing module '%s' dependencies failed, ignore as module is optional",
+                    modPtr->name);
+            while (le_dls_Pop(&moduleInsertList) != NULL)
+            {
+            }
         }
 
+        QueueLoadJobs(&moduleInsertList, &jobList);
+
         linkPtr = le_dls_PeekNext(&ModuleAlphaOrderList, linkPtr);
     }
+
+    result = RunLoadJobs(&jobList);
+    if (result != LE_OK)
+    {
+        LE_ERROR("Error in installing kernel modules. Restarting system ...");
+        framework_Reboot();
+    }
 }
 
 
@@ -1681,6 +1930,10 @@ void kernelModules_Init(void)
                                                         sizeof(DepModNameNode_t));
     le_mem_ExpandPool(KModuleHandler.depModStringPool, STRINGS_DEFAULT_POOL_SIZE);
 
+    // Create memory pool of parameter strings passed to finit_module()
+    KModuleHandler.paramsPool = le_mem_CreatePool("Module Load Params Mem Pool",
+                                                  PARAMS_MAX_BUFFER_SIZE);
+
     // Note that modules.dep file cannot be used for the time being as it requires kernel changes.
     // This option will be investigated in the future. Also, to support backward compatibility of
     // existing targets, module dependency support without kernel changes is a must.
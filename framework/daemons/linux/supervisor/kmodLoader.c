@@ -0,0 +1,218 @@
+//--------------------------------------------------------------------------------------------------
+/** @file kmodLoader.c
+ *
+ * Runs kernel module load jobs level by level, loading the modules of a level concurrently.
+ *
+ * The calling thread takes part in loading the modules of each level, together with up to
+ * maxThreads - 1 helper threads that are started for the level and joined before the next level
+ * starts.  The threads take the next job of the level from the job list under a mutex.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "kmodLoader.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of threads used to load the modules of a level.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_THREADS 16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * State shared by the threads that load the modules of a level.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_mutex_Ref_t          mutexRef;       ///< Protects nextLinkPtr.
+    le_dls_List_t*          jobListPtr;     ///< List of all the jobs.
+    le_dls_Link_t*          nextLinkPtr;    ///< Where to look for the next job of the level.
+    size_t                  level;          ///< Level being loaded.
+    kmodLoader_LoadFunc_t   loadFunc;       ///< Function that loads a module.
+}
+LevelRun_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Takes the next job of the level being loaded.
+ *
+ * @return Pointer to the job, or NULL if all the jobs of the level have been taken.
+ */
+//--------------------------------------------------------------------------------------------------
+static kmodLoader_Job_t* TakeNextJob
+(
+    LevelRun_t* runPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    kmodLoader_Job_t* jobPtr = NULL;
+
+    le_mutex_Lock(runPtr->mutexRef);
+
+    while ((jobPtr == NULL) && (runPtr->nextLinkPtr != NULL))
+    {
+        kmodLoader_Job_t* candidatePtr = CONTAINER_OF(runPtr->nextLinkPtr, kmodLoader_Job_t, link);
+
+        if (candidatePtr->level == runPtr->level)
+        {
+            jobPtr = candidatePtr;
+        }
+
+        runPtr->nextLinkPtr = le_dls_PeekNext(runPtr->jobListPtr, runPtr->nextLinkPtr);
+    }
+
+    le_mutex_Unlock(runPtr->mutexRef);
+
+    return jobPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Loads modules of the level until there are none left.  Runs in the calling thread and in the
+ * helper threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* LoadLevelJobs
+(
+    void* contextPtr    ///< [IN] Pointer to the LevelRun_t.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LevelRun_t* runPtr = contextPtr;
+    kmodLoader_Job_t* jobPtr;
+
+    while ((jobPtr = TakeNextJob(runPtr)) != NULL)
+    {
+        LE_DEBUG("Loading module '%s' (level %" PRIuS ").", jobPtr->name, jobPtr->level);
+
+        jobPtr->result = runPtr->loadFunc(jobPtr->contextPtr);
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs a list of jobs, level by level.  Up to maxThreads jobs of the same level are run at the
+ * same time.  The list is not modified and the jobs can be in any order.
+ *
+ * If a job that isn't optional fails, the remaining jobs of its level are still run, but the jobs
+ * of the higher levels are not (their result stays LE_UNAVAILABLE).
+ *
+ * @return
+ *   - LE_OK if all the jobs that are not optional succeeded.
+ *   - LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t kmodLoader_Run
+(
+    le_dls_List_t* jobListPtr,          ///< [IN] List of jobs.
+    kmodLoader_LoadFunc_t loadFunc,     ///< [IN] Function that loads a module.
+    size_t maxThreads                   ///< [IN] Maximum number of modules loaded at once.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_dls_Link_t* linkPtr;
+    size_t maxLevel = 0;
+
+    if (maxThreads == 0)
+    {
+        maxThreads = 1;
+    }
+    else if (maxThreads > MAX_THREADS)
+    {
+        maxThreads = MAX_THREADS;
+    }
+
+    for (linkPtr = le_dls_Peek(jobListPtr);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(jobListPtr, linkPtr))
+    {
+        kmodLoader_Job_t* jobPtr = CONTAINER_OF(linkPtr, kmodLoader_Job_t, link);
+
+        jobPtr->result = LE_UNAVAILABLE;
+        if (jobPtr->level > maxLevel)
+        {
+            maxLevel = jobPtr->level;
+        }
+    }
+
+    LevelRun_t run =
+    {
+        .mutexRef = le_mutex_CreateNonRecursive("kmodLoader"),
+        .jobListPtr = jobListPtr,
+        .loadFunc = loadFunc,
+    };
+    le_result_t result = LE_OK;
+    size_t level;
+
+    for (level = 0; (level <= maxLevel) && (result == LE_OK); level++)
+    {
+        le_thread_Ref_t threadRefs[MAX_THREADS - 1];
+        size_t jobCount = 0;
+        size_t threadCount;
+        size_t i;
+
+        for (linkPtr = le_dls_Peek(jobListPtr);
+             linkPtr != NULL;
+             linkPtr = le_dls_PeekNext(jobListPtr, linkPtr))
+        {
+            if (CONTAINER_OF(linkPtr, kmodLoader_Job_t, link)->level == level)
+            {
+                jobCount++;
+            }
+        }
+
+        if (jobCount == 0)
+        {
+            continue;
+        }
+
+        run.level = level;
+        run.nextLinkPtr = le_dls_Peek(jobListPtr);
+
+        // Start the helper threads; the calling thread is the last loader.
+        threadCount = (jobCount < maxThreads ? jobCount : maxThreads) - 1;
+        for (i = 0; i < threadCount; i++)
+        {
+            threadRefs[i] = le_thread_Create("kmodLoader", LoadLevelJobs, &run);
+            le_thread_SetJoinable(threadRefs[i]);
+            le_thread_Start(threadRefs[i]);
+        }
+
+        LoadLevelJobs(&run);
+
+        for (i = 0; i < threadCount; i++)
+        {
+            LE_ASSERT_OK(le_thread_Join(threadRefs[i], NULL));
+        }
+
+        // Stop after this level if a module that isn't optional failed to load.
+        for (linkPtr = le_dls_Peek(jobListPtr);
+             linkPtr != NULL;
+             linkPtr = le_dls_PeekNext(jobListPtr, linkPtr))
+        {
+            kmodLoader_Job_t* jobPtr = CONTAINER_OF(linkPtr, kmodLoader_Job_t, link);
+
+            if ((jobPtr->level == level) && (jobPtr->result != LE_OK) && !jobPtr->isOptional)
+            {
+                LE_ERROR("Module '%s' failed to load (%s); not loading modules above level %"
+                         PRIuS ".", jobPtr->name, LE_RESULT_TXT(jobPtr->result), level);
+                result = LE_FAULT;
+            }
+        }
+    }
+
+    le_mutex_Delete(run.mutexRef);
+
+    return result;
+}
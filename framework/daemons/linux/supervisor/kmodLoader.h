@@ -0,0 +1,73 @@
+//--------------------------------------------------------------------------------------------------
+/** @file kmodLoader.h
+ *
+ * Runs kernel module load jobs level by level, loading the modules of a level concurrently.
+ *
+ * A module's level is its depth in the dependency graph: modules without dependencies are at
+ * level 0, and any other module is one level above the deepest module it depends on.  All the
+ * modules of a level are therefore independent of each other and can be loaded at the same time,
+ * once every module of the lower levels has been loaded.
+ *
+ * The loader does not know how a module is loaded.  The caller provides a load function, which
+ * is called once per job, possibly from several threads at the same time.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_SRC_KMOD_LOADER_INCLUDE_GUARD
+#define LEGATO_SRC_KMOD_LOADER_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function that loads the module of a job.
+ *
+ * @return LE_OK if the module was loaded, or an error code otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef le_result_t (*kmodLoader_LoadFunc_t)
+(
+    void* contextPtr            ///< [IN] Context pointer of the job.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A module load job.  Jobs are usually embedded in the caller's module objects.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t   link;       ///< Link in the list of jobs passed to kmodLoader_Run().
+    const char*     name;       ///< Module name, for logging.
+    size_t          level;      ///< Dependency level of the module.
+    bool            isOptional; ///< true if a failure to load the module should be ignored.
+    void*           contextPtr; ///< Passed to the load function.
+    le_result_t     result;     ///< Result of the load function, or LE_UNAVAILABLE if not run.
+}
+kmodLoader_Job_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs a list of jobs, level by level.  Up to maxThreads jobs of the same level are run at the
+ * same time.  The list is not modified and the jobs can be in any order.
+ *
+ * If a job that isn't optional fails, the remaining jobs of its level are still run, but the jobs
+ * of the higher levels are not (their result stays LE_UNAVAILABLE).
+ *
+ * @return
+ *   - LE_OK if all the jobs that are not optional succeeded.
+ *   - LE_FAULT otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t kmodLoader_Run
+(
+    le_dls_List_t* jobListPtr,          ///< [IN] List of jobs.
+    kmodLoader_LoadFunc_t loadFunc,     ///< [IN] Function that loads a module.
+    size_t maxThreads                   ///< [IN] Maximum number of modules loaded at once.
+);
+
+
+#endif // LEGATO_SRC_KMOD_LOADER_INCLUDE_GUARD
@@ -162,6 +162,66 @@
  * le_atomFile_TryOpenStream(), le_atomFile_TryCreateStream() and le_atomFile_TryDelete() are their
  * non-blocking counterparts.
  *
+ * @section c_atomFile_append Appending
+ *
+ * Opening a file for writing with le_atomFile_Open() copies the whole file, so that the changes can
+ * be made to the copy.  When the file is only going to be replaced, use le_atomFile_Create() with
+ * LE_FLOCK_REPLACE_IF_EXIST, which doesn't copy it.  When data is only going to be appended to the
+ * file, use le_atomFile_OpenAppend() (or le_atomFile_TryOpenAppend()): the data is written
+ * directly at the end of the file, and removed again if the changes are cancelled or interrupted
+ * by a power-cut.  The file is closed using le_atomFile_Close() or le_atomFile_Cancel() as usual.
+ *
+ * @code
+ *
+ *      int fd = le_atomFile_OpenAppend("./myfile.log");
+ *
+ *      if (fd < 0)
+ *      {
+ *          // Print error message and exit.
+ *      }
+ *
+ *      write(fd, record, recordSize);              // Appended, but not committed yet.
+ *
+ *      le_result_t result = le_atomFile_Close(fd); // Commits the appended data.
+ *
+ * @endcode
+ *
+ * @section c_atomFile_transactions Transactions
+ *
+ * Changes to several files in the same directory can be committed together, so that either all
+ * the files are changed or none are, even if a power-cut occurs during the commit.  Committing a
+ * transaction also costs a single directory sync, rather than one per file.
+ *
+ * Open the files for writing as usual, add them to a transaction created by
+ * le_atomFile_CreateTransaction() using le_atomFile_AddToTransaction() (or
+ * le_atomFile_AddStreamToTransaction() for file streams), then call le_atomFile_CommitTransaction()
+ * or le_atomFile_CancelTransaction().  These close all the files of the transaction, which must not
+ * be closed individually.
+ *
+ * @code
+ *
+ *      le_atomFile_TransactionRef_t txnRef = le_atomFile_CreateTransaction();
+ *
+ *      int fd1 = le_atomFile_Create("./cfg", LE_FLOCK_WRITE, LE_FLOCK_REPLACE_IF_EXIST, 0600);
+ *      int fd2 = le_atomFile_Create("./cfg.sig", LE_FLOCK_WRITE, LE_FLOCK_REPLACE_IF_EXIST, 0600);
+ *
+ *      if ((fd1 < 0) || (fd2 < 0))
+ *      {
+ *          // Cancel the files that were opened, print error message and exit.
+ *      }
+ *
+ *      le_atomFile_AddToTransaction(txnRef, fd1);
+ *      le_atomFile_AddToTransaction(txnRef, fd2);
+ *
+ *      // Write the new contents of both files.
+ *
+ *      le_result_t result = le_atomFile_CommitTransaction(txnRef); // Changes both files.
+ *
+ * @endcode
+ *
+ * If an append or a transaction is interrupted, the file is recovered the next time it is opened
+ * through this API.
+ *
  * @section c_atomFile_threading Multiple Threads
  *
  * All the functions in this API are thread-safe and reentrant.
@@ -260,6 +320,14 @@
 #include "le_fileLock.h"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_atomFile_Transaction* le_atomFile_TransactionRef_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Opens an existing file for atomic access operation.
@@ -396,6 +464,53 @@ LE_API_FILESYSTEM le_result_t le_atomFile_Close
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens an existing file for atomic appends.
+ *
+ * Unlike le_atomFile_Open(), the file isn't copied: data is written directly at the end of the
+ * file (the file descriptor has O_APPEND set) and is removed again if the changes are cancelled or
+ * interrupted by a crash or power loss.  The existing contents of the file must not be changed
+ * (e.g. with ftruncate()).
+ *
+ * This is a blocking call. It will block until it can open the target file for writing.
+ *
+ * @return
+ *      A file descriptor if successful.
+ *      LE_NOT_FOUND if the file does not exist.
+ *      LE_FAULT if there was an error.
+ *
+ * @note
+ *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_API_FILESYSTEM LE_FULL_API int le_atomFile_OpenAppend
+(
+    const char* pathNamePtr             ///< [IN] Path of the file to open
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Same as @c le_atomFile_OpenAppend() except that it is non-blocking function and it will fail and
+ * return LE_WOULD_BLOCK immediately if target file has incompatible lock.
+ *
+ * @return
+ *      A file descriptor if successful.
+ *      LE_NOT_FOUND if the file does not exist.
+ *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *      LE_FAULT if there was an error.
+ *
+ * @note
+ *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_API_FILESYSTEM LE_FULL_API int le_atomFile_TryOpenAppend
+(
+    const char* pathNamePtr             ///< [IN] Path of the file to open
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Opens an existing file via C standard library buffered file stream for atomic operation.
@@ -590,4 +705,91 @@ LE_API_FILESYSTEM LE_FULL_API le_result_t le_atomFile_TryDelete
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a transaction, used to commit changes to several files together.
+ *
+ * @return
+ *      Reference to the transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_API_FILESYSTEM LE_FULL_API le_atomFile_TransactionRef_t le_atomFile_CreateTransaction
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a file to a transaction.  The file must have been opened for writing by le_atomFile_Open(),
+ * le_atomFile_Create() or their non-blocking counterparts, and all the files of a transaction must
+ * be in the same directory.
+ *
+ * Once added, the file must not be closed by le_atomFile_Close() or le_atomFile_Cancel(); it is
+ * closed when the transaction is committed or cancelled.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_BAD_PARAMETER if the file isn't in the same directory as the other files of the
+ *      transaction.
+ *      LE_OVERFLOW if the transaction already has the maximum number of files.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_API_FILESYSTEM LE_FULL_API le_result_t le_atomFile_AddToTransaction
+(
+    le_atomFile_TransactionRef_t txnRef,    ///< [IN] Transaction.
+    int fd                                  ///< [IN] File descriptor of the file to add.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Same as @c le_atomFile_AddToTransaction() except that it works on a file stream obtained by
+ * le_atomFile_OpenStream(), le_atomFile_CreateStream() or their non-blocking counterparts.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_BAD_PARAMETER if the file isn't in the same directory as the other files of the
+ *      transaction.
+ *      LE_OVERFLOW if the transaction already has the maximum number of files.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_API_FILESYSTEM LE_FULL_API le_result_t le_atomFile_AddStreamToTransaction
+(
+    le_atomFile_TransactionRef_t txnRef,    ///< [IN] Transaction.
+    FILE* fileStreamPtr                     ///< [IN] File stream of the file to add.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commits the changes to all the files of a transaction, closes them and deletes the transaction.
+ * Either all the files are changed, or none are, even if the commit is interrupted by a crash or a
+ * power loss.  The files are closed and the transaction deleted in both success and error
+ * scenario.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_API_FILESYSTEM LE_FULL_API le_result_t le_atomFile_CommitTransaction
+(
+    le_atomFile_TransactionRef_t txnRef     ///< [IN] Transaction to commit.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cancels the changes to all the files of a transaction, closes them and deletes the transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_API_FILESYSTEM LE_FULL_API void le_atomFile_CancelTransaction
+(
+    le_atomFile_TransactionRef_t txnRef     ///< [IN] Transaction to cancel.
+);
+
+
 #endif //LEGATO_ATOMIC_INCLUDE_GUARD
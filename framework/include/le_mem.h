@@ -529,6 +529,9 @@ typedef struct le_mem_Pool
 #endif
 
     le_mem_Destructor_t destructor;     ///< The destructor for objects in this pool.
+#if LE_CONFIG_STATS_PAGE
+    void* statsSlotPtr;                 ///< Slot of this pool in the statistics page, or NULL.
+#endif
 #if LE_CONFIG_MEM_POOL_NAMES_ENABLED
     char name[LE_MEM_LIMIT_MAX_MEM_POOL_NAME_BYTES]; ///< Name of the pool.
 #endif
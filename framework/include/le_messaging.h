@@ -1011,7 +1011,8 @@ typedef struct le_msg_LocalMessage
 {
     struct le_msg_Message message;          ///< Pointer to base message
     int fd;                                 ///< File descriptor sent with message (via Get/SetFd)
-    le_sem_Ref_t responseReady;             ///< Semaphore which will be set when response is ready
+    struct le_msg_LocalCompletion* responseReadyPtr; ///< Completion of the client thread
+                                            ///< waiting for the response (NULL if none)
     bool needsResponse;                     ///< True if message needs a response
     le_msg_ResponseCallback_t completionCallback; ///< Function to be called when transaction done.
     void* contextPtr;                       ///< Opaque value to be passed to handler function.
@@ -225,8 +225,8 @@ typedef struct le_ref_Iter *le_ref_IterRef_t;
 struct le_ref_Block;
 
 
-// Internal block sizing
-#define LE_REF_BLOCK_SIZE(numRefs)  (1 + (numRefs))
+// Internal block sizing: a header word, then two words per reference (pointer and generation).
+#define LE_REF_BLOCK_SIZE(numRefs)  (1 + 2 * (numRefs))
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -249,8 +249,12 @@ struct le_ref_Map
     size_t               size;      ///< Total allocated entries.
     size_t               maxRefs;   ///< Nominal maximum number of safe references.
     uint32_t             mapBase;   ///< Randomized "base" for references in this map.
+    size_t               usedCount; ///< Number of entries that have been used at least once.
+    size_t               freeHead;  ///< Oldest deleted entry, next one to be reused.
+    size_t               freeTail;  ///< Newest deleted entry.
 
-    struct le_ref_Block *blocksPtr; ///< Block list head.
+    struct le_ref_Block *blocksPtr;     ///< Initial block, holding maxRefs entries.
+    struct le_ref_Block *overflowPtr;   ///< Overflow block, grown once the initial block is full.
 };
 
 //--------------------------------------------------------------------------------------------------
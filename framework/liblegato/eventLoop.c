@@ -564,6 +564,10 @@ void event_ProcessOneEventReport
 
     // Pop an Event Report off the head of the Event Queue (inside a critical section).
     linkPtr = le_sls_Pop(&perThreadRecPtr->eventQueue);
+    if (linkPtr != NULL)
+    {
+        STATSPAGE_ADD(perThreadRecPtr->statsSlotPtr, eventBacklog, -1);
+    }
 
     event_Unlock(oldState);
 
@@ -572,6 +576,8 @@ void event_ProcessOneEventReport
         return;
     }
 
+    STATSPAGE_INC(perThreadRecPtr->statsSlotPtr, eventsProcessed);
+
     // Convert the link pointer into a pointer to the Report base class.
     reportObjPtr = CONTAINER_OF(linkPtr, Report_t, link);
 
@@ -730,6 +736,7 @@ static void QueueFunction_NoLock
 
     // Queue it to the Event Queue.
     le_sls_Queue(&perThreadRecPtr->eventQueue, &reportPtr->baseClass.link);
+    STATSPAGE_ADD_MAX(perThreadRecPtr->statsSlotPtr, eventBacklog, maxEventBacklog, 1);
 
     // Write to the eventfd to notify the Event Loop that there is something on the queue.
     fa_event_TriggerEvent_NoLock(perThreadRecPtr);
@@ -834,6 +841,9 @@ event_PerThreadRec_t* event_CreatePerThreadInfo
 
     // Set the context pointer to NULL for safety's sake.
     recPtr->contextPtr = NULL;
+#if LE_CONFIG_STATS_PAGE
+    recPtr->statsSlotPtr = NULL;    // Filled in by the thread module.
+#endif
 
     // Initialize the FD Monitor module's thread-specific stuff.
     fdMon_InitThread(recPtr);
@@ -1246,6 +1256,7 @@ void le_event_Report
         memset(reportObjPtr->payload, 0, eventPtr->payloadSize);
         memcpy(reportObjPtr->payload, payloadPtr, payloadSize);
         le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
+        STATSPAGE_ADD_MAX(perThreadRecPtr->statsSlotPtr, eventBacklog, maxEventBacklog, 1);
 
         // Increment the eventfd for the handler's thread's Event Queue.
         // This will wake up the thread and tell it that it has something on its Event Queue.
@@ -1307,6 +1318,7 @@ void le_event_ReportWithRefCounting
         reportObjPtr->payload[0] = objectPtr;
         le_mem_AddRef(objectPtr);
         le_sls_Queue(&perThreadRecPtr->eventQueue, &reportObjPtr->baseClass.link);
+        STATSPAGE_ADD_MAX(perThreadRecPtr->statsSlotPtr, eventBacklog, maxEventBacklog, 1);
 
         // Increment the eventfd for the handler's thread's Event Queue.
         // This will wake up the thread and tell it that it has something on its Event Queue.
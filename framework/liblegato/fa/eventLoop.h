@@ -10,6 +10,7 @@
 #define FA_EVENTLOOP_H_INCLUDE_GUARD
 
 #include "legato.h"
+#include "../statsPage.h"
 
 
 // File Descriptor Monitor
@@ -50,6 +51,9 @@ typedef struct
                                             ///< balance between queued events and monitored fds
                                             ///< in le_event_ServiceLoop().
     void*                currentEvent;      ///< Pointer to the current event report being processed
+#if LE_CONFIG_STATS_PAGE
+    statsPage_ThreadSlot_t* statsSlotPtr;   ///< Statistics page slot of the thread, or NULL.
+#endif
 }
 event_PerThreadRec_t;
 
@@ -11,6 +11,7 @@
 
 #include "legato.h"
 #include "../limit.h"
+#include "../statsPage.h"
 
 // Forward reference.
 struct thread_Obj;
@@ -76,6 +77,9 @@ typedef struct
                                         ///  associated with the currently running timerFD,
                                         ///  or NULL if there are no timers on the active list.
                                         ///  This is normally the first timer on the list.
+#if LE_CONFIG_STATS_PAGE
+    statsPage_ThreadSlot_t* statsSlotPtr; ///< Statistics page slot of the thread, or NULL.
+#endif
 }
 timer_ThreadRec_t;
 
@@ -18,10 +18,31 @@
  * during the re-naming should keep the original file intact. All the aforementioned steps are
  * followed in this API implementation,
  *
+ * Two operations record their progress in the lock file of the file instead:
+ *
+ *  - Appends (le_atomFile_OpenAppend()) write to the original file directly. The original size of
+ *    the file is recorded in the lock file and synchronized before the first write, and the record
+ *    is cleared once the appended data is synchronized. If the lock file still holds the record
+ *    when the file is next opened, the append was interrupted and the file is truncated back.
+ *
+ *  - Transactions (le_atomFile_CommitTransaction()) mark the lock file of each of their files, and
+ *    write the list of their files, with the inode number of each temporary copy, to a journal
+ *    that is hard linked next to every file of the transaction. A single synchronization of the
+ *    directory then makes the temporary copies and the journal durable together, before the
+ *    copies are renamed. The journal is then deleted and the directory synchronized again before
+ *    the marks are cleared, so that no journal is left behind. If a mark is found when one of the
+ *    files is next opened, the transaction is completed if every temporary copy made it to disk,
+ *    and rolled back otherwise.
+ *
+ * The record of the lock file is read (and interrupted operations recovered) every time the lock
+ * file of a file is obtained, so a file is never seen in the middle of an append or a transaction.
+ * The lock file is open anyway, so this doesn't cost a look-up of another file.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
 #include "legato.h"
+#include "atomFile.h"
 #include "fileDescriptor.h"
 #include "file.h"
 #include <sys/file.h>
@@ -43,6 +64,22 @@
 #define LOCK_FILE_EXTENSION       ".lock~~XXXXXX"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum size of the record held by a lock file.  A lock file is empty until an append or a
+ * transaction is first done on the file, and holds a single "\n" when no append or transaction is
+ * in progress (or was interrupted).  It otherwise holds either:
+ *
+ *      "append <original size>\n"
+ *
+ * or, if the file belongs to a transaction whose journal is next to the file:
+ *
+ *      "txn\n"
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOCK_RECORD_MAX_BYTES     32
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Temp directory to use for lock file when directory is not writable
@@ -51,6 +88,37 @@
 #define LOCK_FILE_TEMP_DIR        "/tmp/"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extension used for the journal file of a transaction.  A journal is absent unless a transaction
+ * is in progress on the file (or was interrupted).  It then holds:
+ *
+ *      "txn <number of files>\n"
+ *      "<inode number of temporary file> <file name>\n"     (for each file of the transaction)
+ *      "end\n"
+ */
+//--------------------------------------------------------------------------------------------------
+#define JOURNAL_FILE_EXTENSION    ".jnl~~"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of files in a transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_TRANSACTION_FILES     16
+
+
+#if LE_CONFIG_ATOM_FILE_CRASH_POINTS
+//--------------------------------------------------------------------------------------------------
+/**
+ * Point at which a crash is simulated, for testing.
+ */
+//--------------------------------------------------------------------------------------------------
+static atomFile_CrashPoint_t CrashPoint = ATOMFILE_CRASH_NONE;
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Mutex used to protect shared data structures in this module.
@@ -77,11 +145,40 @@ typedef struct
     int tempFd;                           ///< File descriptor of temp file.
     int originFd;                         ///< File descriptor of original file.
     int lockFd;                           ///< File descriptor for lock file.
+    bool isAppend;                        ///< true if opened by OpenAppend().
+    off_t appendOffset;                   ///< Size of the file before appending (appends only).
+    FILE* streamPtr;                      ///< Stream of temp file, if added to a transaction.
+    struct le_atomFile_Transaction* txnPtr; ///< Transaction the file belongs to, or NULL.
+    le_dls_Link_t   txnLink;              ///< Used to link into the transaction's file list.
     char filePath[PATH_MAX];              ///< Original file path
 }
 FileAccess_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Transaction: a group of files that are committed together.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_atomFile_Transaction
+{
+    le_dls_List_t fileList;               ///< FileAccess_t objects of the files.
+    size_t fileCount;                     ///< Number of files in the transaction.
+    dev_t dirDev;                         ///< Device of the directory containing the files.
+    ino_t dirIno;                         ///< Inode of the directory containing the files.
+    char dirPath[PATH_MAX];               ///< Path of the directory containing the files.
+}
+Transaction_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool to allocate Transaction_t objects.
+ **/
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t TransactionPool;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Pool to allocate FileAccess_t objects.
@@ -142,7 +239,7 @@ static FileAccess_t* GetFileData
  * Store atomically accessed file info to memory
  **/
 //--------------------------------------------------------------------------------------------------
-static void SaveFileData
+static FileAccess_t* SaveFileData
 (
     int fd,                   ///< File descriptor of atomically accessed file.
     int lockFd,               ///< File descriptor of lock file.
@@ -158,10 +255,17 @@ static void SaveFileData
     accessPtr->originFd = fd;
     accessPtr->lockFd = lockFd;
     accessPtr->tempFd = tempFd;
+    accessPtr->isAppend = false;
+    accessPtr->appendOffset = 0;
+    accessPtr->streamPtr = NULL;
+    accessPtr->txnPtr = NULL;
+    accessPtr->txnLink = LE_DLS_LINK_INIT;
     LE_ASSERT_OK(le_utf8_Copy(accessPtr->filePath, pathNamePtr, sizeof(accessPtr->filePath), NULL));
     le_dls_Queue(&FileAccessList, &accessPtr->link);
 
     UNLOCK
+
+    return accessPtr;
 }
 
 
@@ -335,835 +439,821 @@ static le_result_t CheckIfRegFileExist
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Open lock file for the file which will do atomic operation. If there is no lock file, this
- * function will create and open lock file
- *
- * @return
- *      A file descriptor for doing atomic operation.
- *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
- *      LE_FAULT if there was an error.
+ * Gets the path of the directory containing a file.
  **/
 //--------------------------------------------------------------------------------------------------
-static int OpenLockFile
+static void GetDirPath
 (
-    const char* pathNamePtr,             ///< [IN] Path of the file for which lockfile should be open
-    le_flock_AccessMode_t accessMode,    ///< [IN] The access mode to open the file with.
-    bool blocking                        ///< [IN] true if blocking, false if non-blocking.
+    const char* filePath,           ///< [IN] Path of the file.
+    char* dirPath,                  ///< [OUT] Path of the directory containing the file.
+    size_t dirPathSize              ///< [IN] Size of the dirPath buffer.
 )
 {
-    char lockFilePath[PATH_MAX];
-    GetFilePath(pathNamePtr, LOCK_FILE_EXTENSION, lockFilePath, sizeof(lockFilePath));
-
-    int lockFd;
+    LE_ASSERT_OK(le_path_GetDir(filePath, "/", dirPath, dirPathSize));
 
-    if (blocking)
-    {
-        lockFd = le_flock_Create(lockFilePath,
-                                 accessMode,
-                                 LE_FLOCK_OPEN_IF_EXIST,
-                                 S_IRUSR | S_IWUSR);
-    }
-    else
+    // le_path_GetDir returns file name when no path is specified.
+    if (!le_dir_IsDir(dirPath))
     {
-        lockFd = le_flock_TryCreate(lockFilePath,
-                                    accessMode,
-                                    LE_FLOCK_OPEN_IF_EXIST,
-                                    S_IRUSR | S_IWUSR);
+        LE_ASSERT_OK(le_utf8_Copy(dirPath, ".", dirPathSize, NULL));
     }
-
-    return lockFd;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Creates temporary file for doing all intermediate operations. This function is used to create
- * temporary file when original file exists. File permissions are copied from the original file.
+ * Syncs a directory to disk, so that changes to its entries are durable.
  *
  * @return
- *      A file descriptor for doing atomic operation.
- *      LE_NOT_FOUND if the file does not exist.
- *      LE_FAULT if there was an error.
- **/
+ *      LE_OK if successful
+ *      LE_FAULT if failed.
+ */
 //--------------------------------------------------------------------------------------------------
-static int CreateTempFromOriginal
+static le_result_t SyncDir
 (
-    const char* origPathPtr,             ///< [IN] Path to original file.
-    const char* tempPathPtr,             ///< [IN] Path to temporary file.
-    le_flock_AccessMode_t accessMode,    ///< [IN] The access mode to open the file with.
-    bool copy                            ///< [IN] Whether content of original file should be copied
-                                         ///<      to temporary file.
+    const char* dirPath             ///< [IN] Path of the directory.
 )
 {
-    // Delete the temporary file if exists.
-    unlink(tempPathPtr);
-
-    // File permission mode in temporary file should be same as original file, so set the
-    // processor umask to 0.
-    mode_t old_mode = umask((mode_t)0);
-    int tempfd;
-
-    if (copy)
+    int dirFd;
+    do
     {
-        // Copy the contents to temporary file.
-        if (file_Copy(origPathPtr, tempPathPtr, NULL) == LE_OK)
-        {
-            // Temp file already exists. So opening should be fine.
-            tempfd = le_flock_Open(tempPathPtr, accessMode);
-        }
-        else
-        {
-            tempfd = LE_FAULT;
-        }
+        // Directory can be opened with read-only flag
+        dirFd = open(dirPath, O_RDONLY | O_CLOEXEC);
     }
-    else
+    while ( (dirFd == -1) && (errno == EINTR) );
+
+    if (dirFd == -1)
     {
-        // Temp file doesn't exist, so create it with original file permission
-        struct stat fileStatus;
+        LE_CRIT("Failed to open directory '%s' (%m).", dirPath);
+        return LE_FAULT;
+    }
 
-        // Get the original file permission mode and create a temp file with same permission mode.
-        if (stat(origPathPtr, &fileStatus) == 0)
-        {
-            tempfd = le_flock_Create(tempPathPtr,
-                                     accessMode,
-                                     LE_FLOCK_REPLACE_IF_EXIST,
-                                     fileStatus.st_mode);
-        }
-        else
-        {
-            LE_CRIT("Error when trying to stat '%s'. (%m)", origPathPtr);
-            tempfd = LE_FAULT;
-        }
+    // Now do a sync on directory
+    if (fsync(dirFd) == -1)
+    {
+        LE_CRIT("Failed to do fsync on directory: '%s' (%m).", dirPath);
+        fd_Close(dirFd);
+        return LE_FAULT;
     }
 
-    umask(old_mode);
+    fd_Close(dirFd);
 
-    return tempfd;
+    return LE_OK;
 }
 
 
+#if LE_CONFIG_ATOM_FILE_CRASH_POINTS
 //--------------------------------------------------------------------------------------------------
 /**
- * Creates temporary file stream for doing all intermediate operations. This function is used to
- * create temporary file when original file exists. File permissions are copied from the original
- * file.
- *
- * If there was an error NULL is returned and resultPtr is set to:
- *      LE_NOT_FOUND if file doesn't exists.
- *      LE_FAULT if there was an error.
+ * Simulates a crash, by terminating the process immediately without any clean-up, if the crash
+ * point was set to this point by the test code.  The data written but not synced yet is kept in
+ * the page cache, so this doesn't simulate its loss in a power cut.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SimulateCrash
+(
+    atomFile_CrashPoint_t point         ///< [IN] Point reached.
+)
+{
+    if (CrashPoint == point)
+    {
+        LE_WARN("Simulating a crash at crash point %d.", point);
+        _exit(EXIT_FAILURE);
+    }
+}
+#else
+#define SimulateCrash(point)
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the record of a lock file.
  *
  * @return
- *      Buffered file stream handle to the file if successful.
- *      NULL if there was an error.
- **/
+ *      true if the lock file holds a record, which is copied to the buffer with a terminating null.
+ *      false if it doesn't (it is empty or cleared), or can't be read.
+ */
 //--------------------------------------------------------------------------------------------------
-static FILE* CreateTempStreamFromOriginal
+static bool ReadLockRecord
 (
-    const char* origPathPtr,             ///< [IN] Path to original file.
-    const char* tempPathPtr,             ///< [IN] Path to temporary file.
-    le_flock_AccessMode_t accessMode,    ///< [IN] The access mode to open the file with.
-    bool copy,                           ///< [IN] Whether content of original file should be copied
-                                         ///<      to temporary file.
-    le_result_t* resultPtr               ///< [OUT] A pointer to result code
+    int lockFd,                         ///< [IN] File descriptor of the lock file.
+    char* recordPtr,                    ///< [OUT] Buffer for the record.
+    size_t recordSize                   ///< [IN] Size of the buffer.
 )
 {
-    // Delete the temporary file if exists.
-    unlink(tempPathPtr);
-
-    // File permission mode in temporary file should be same as original file, so set the
-    // processor umask to 0.
-    mode_t old_mode = umask((mode_t)0);
-    FILE* file;
+    ssize_t len;
 
-    if (copy)
+    do
     {
-        // Copy the contents to temporary file.
-        if (file_Copy(origPathPtr, tempPathPtr, NULL) == LE_OK)
-        {
-            // Temp file already exists. So opening should be fine.
-            file = le_flock_OpenStream(tempPathPtr, accessMode, resultPtr);
-        }
-        else
-        {
-            if (resultPtr != NULL)
-            {
-                *resultPtr = LE_FAULT;
-            }
-            file = NULL;
-        }
+        len = pread(lockFd, recordPtr, recordSize - 1, 0);
     }
-    else
-    {
-        // Temp file doesn't exist, so create it with original file permission
-        struct stat fileStatus;
-
-        // Get the original file permission mode and create a temp file with same permission mode.
-        if (stat(origPathPtr, &fileStatus) == 0)
-        {
-            file = le_flock_CreateStream(tempPathPtr,
-                                         accessMode,
-                                         LE_FLOCK_REPLACE_IF_EXIST,
-                                         fileStatus.st_mode,
-                                         resultPtr);
-        }
-        else
-        {
-            LE_CRIT("Error when trying to stat '%s'. (%m)", origPathPtr);
+    while ((len == -1) && (errno == EINTR));
 
-            if (resultPtr != NULL)
-            {
-                *resultPtr = LE_FAULT;
-            }
-            file = NULL;
-        }
+    if (len == -1)
+    {
+        LE_CRIT("Failed to read lock file (%m).");
+        return false;
     }
 
-    umask(old_mode);
+    recordPtr[len] = '\0';
 
-    return file;
+    return ((len > 0) && (recordPtr[0] != '\n'));
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Open an existing file for atomic operation.
+ * Writes a record to a lock file and syncs it to disk.
  *
  * @return
- *      A file descriptor for doing atomic operation.
- *      LE_NOT_FOUND if the file does not exist.
- *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
- *      LE_FAULT if there was an error.
- **/
+ *      LE_OK if successful
+ *      LE_FAULT if failed.
+ */
 //--------------------------------------------------------------------------------------------------
-static int Open
+static le_result_t WriteLockRecord
 (
-    const char* pathNamePtr,             ///< [IN] Path of the file to open.
-    le_flock_AccessMode_t accessMode,    ///< [IN] The access mode to open the file with.
-    bool blocking                        ///< [IN] true if blocking, false if non-blocking.
+    int lockFd,                         ///< [IN] File descriptor of the lock file.
+    const char* recordPtr               ///< [IN] Record, ending with a newline.
 )
 {
-    LE_ASSERT(pathNamePtr != NULL);
-    LE_ASSERT(pathNamePtr[0] != '\0');
-
-    // High level algorithm:
-    // if (Read-Only access requested)
-    //     1. Lock the lockfile
-    //     2. Lock the file and return the file descriptor
-    // else
-    //     1. Lock the lockfile.
-    //     2. Lock the original file.
-    //     3. Create a temp copy of the file and lock that temp copy
-    //     4. Open the temp copy and return the file descriptor.
-
-    // Open(or lock) the lockfile.
-    int lockFd = OpenLockFile(pathNamePtr, accessMode, blocking);
+    size_t len = strlen(recordPtr);
 
-    if (lockFd < 0)
+    if ((pwrite(lockFd, recordPtr, len, 0) != (ssize_t)len) ||
+        (ftruncate(lockFd, len) == -1) ||
+        (fdatasync(lockFd) == -1))
     {
-        return lockFd;
+        LE_CRIT("Failed to write lock file record (%m).");
+        return LE_FAULT;
     }
 
-    if (accessMode == LE_FLOCK_READ)
-    {
-        // Note: Even for read access we need to put lock the lockfile. This should be done to avoid
-        // a race condition (e.g. Process A requests write access to an existing file named abc.txt
-        // and it's access request is granted, now process B requests read access to abc.txt, so
-        // process B opens abc.txt but it is blocked when it tries to acquire read lock. Now when
-        // process A commits all its changes, it renames the temporary file to abc.txt, hence
-        // process B is pointing to wrong inode)
+    return LE_OK;
+}
 
-        // We need to consider blocking here as well, otherwise this api call will be blocked if
-        // file is already opened by using le_flock api.
-        int fd = blocking ? le_flock_Open(pathNamePtr, accessMode) :
-                            le_flock_TryOpen(pathNamePtr, accessMode);
 
-        if (fd < 0)
-        {
-            le_flock_Close(lockFd);
-            return fd;
-        }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Clears the record of a lock file.  The first byte is overwritten first, so a record is never
+ * seen cut short.
+ *
+ * @return
+ *      LE_OK if successful
+ *      LE_FAULT if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ClearLockRecord
+(
+    int lockFd,                         ///< [IN] File descriptor of the lock file.
+    bool sync                           ///< [IN] true if the clearing has to reach the disk.
+)
+{
+    if ((pwrite(lockFd, "\n", 1, 0) != 1) ||
+        (ftruncate(lockFd, 1) == -1) ||
+        (sync && (fdatasync(lockFd) == -1)))
+    {
+        LE_CRIT("Failed to clear lock file record (%m).");
+        return LE_FAULT;
+    }
 
-        // Store info about this file in the File Access List.
-        SaveFileData(fd, lockFd, -1, pathNamePtr);
+    return LE_OK;
+}
 
-        return fd;
-    }
-    else
-    {
-        // We need to consider blocking here as well, otherwise this api call will be blocked if
-        // file is already opened by using le_flock api.
-        int fd = blocking ? le_flock_Open(pathNamePtr, accessMode):
-                            le_flock_TryOpen(pathNamePtr, accessMode);
 
-        if (fd < 0)
-        {
-            le_flock_Close(lockFd);
-            return fd;
-        }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Entry of a transaction journal.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    ino_t ino;                          ///< Inode number of the temporary file.
+    char name[NAME_MAX + 1];            ///< Name of the file, in the journal's directory.
+}
+JournalEntry_t;
 
-        char tempFilePath[PATH_MAX];
-        GetFilePath(pathNamePtr, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
 
-        // Now open the temporary file.
-        int tempfd = CreateTempFromOriginal(pathNamePtr,
-                                            tempFilePath,
-                                            accessMode,
-                                            true);
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the next file entry of a transaction journal.
+ *
+ * @return
+ *      LE_OK if an entry was read.
+ *      LE_OUT_OF_RANGE if the end of the journal was reached.
+ *      LE_FORMAT_ERROR if the journal is incomplete or corrupted.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadJournalEntry
+(
+    FILE* journalPtr,                   ///< [IN] Journal, positioned on an entry.
+    JournalEntry_t* entryPtr            ///< [OUT] Entry read.
+)
+{
+    char line[NAME_MAX + 32];
 
-        if (tempfd < 0)
-        {
-           le_flock_Close(fd);
-           le_flock_Close(lockFd);
-           return tempfd;
-        }
+    if (fgets(line, sizeof(line), journalPtr) == NULL)
+    {
+        return LE_FORMAT_ERROR;
+    }
 
-        // Store info about this file in the File Access List.
-        SaveFileData(fd, lockFd, tempfd, pathNamePtr);
+    if (strcmp(line, "end\n") == 0)
+    {
+        return LE_OUT_OF_RANGE;
+    }
 
-        return tempfd;
+    // Every line is complete, so an entry cut by a crash is detected.
+    size_t len = strlen(line);
+    if ((len == 0) || (line[len - 1] != '\n'))
+    {
+        return LE_FORMAT_ERROR;
     }
+    line[len - 1] = '\0';
+
+    char* namePtr;
+    errno = 0;
+    unsigned long long ino = strtoull(line, &namePtr, 10);
+
+    if ((errno != 0) || (namePtr == line) || (*namePtr != ' ') || (namePtr[1] == '\0') ||
+        (strchr(namePtr + 1, '/') != NULL) ||
+        (le_utf8_Copy(entryPtr->name, namePtr + 1, sizeof(entryPtr->name), NULL) != LE_OK))
+    {
+        return LE_FORMAT_ERROR;
+    }
+
+    entryPtr->ino = (ino_t)ino;
+
+    return LE_OK;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Create a file for atomic operation.
+ * Checks whether a file of an interrupted transaction made it to disk.
  *
  * @return
- *      File descriptor for doing atomic operation.
- *      LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode
- *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
- *      LE_FAULT if there was an error.
- **/
+ *      true if the file was renamed already, or if both its temporary copy and its journal link
+ *      exist.
+ *      false if the file was lost (the transaction didn't reach the directory sync).
+ */
 //--------------------------------------------------------------------------------------------------
-static int Create
+static bool IsEntryOnDisk
 (
-    const char* pathNamePtr,            ///< [IN] Path of the file to open.
-    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
-    le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
-    mode_t permissions,                 ///< [IN] The file permissions used when creating the file.
-    bool blocking                       ///< [IN] true if blocking, false if non-blocking.
+    const char* filePath,               ///< [IN] Path of the file.
+    ino_t ino                           ///< [IN] Inode number of its temporary copy.
 )
 {
-    LE_ASSERT(pathNamePtr != NULL);
-    LE_ASSERT(pathNamePtr[0] != '\0');
+    char tempFilePath[PATH_MAX];
+    char journalPath[PATH_MAX];
+    struct stat fileStatus;
 
-    // High level algorithm:
-    //
-    // if (file exists)
-    //     if (Read-Only access requested)
-    //         1. Lock the lockfile
-    //         2. Lock the file and return the file descriptor
-    //     else
-    //         1. Lock the lockfile.
-    //         2. Lock the original file.
-    //         3. Create a temp copy of the file and lock that temp copy
-    //         4. Open the temp copy and return the file descriptor.
-    //  else
-    //     1. Lock the lockfile.
-    //     2. Create a temp copy and lock that temp copy
-    //     3. Open the temp copy and return the file descriptor.
+    GetFilePath(filePath, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
+    GetFilePath(filePath, JOURNAL_FILE_EXTENSION, journalPath, sizeof(journalPath));
 
-    char tempFilePath[PATH_MAX];
-    GetFilePath(pathNamePtr, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
+    if ((stat(tempFilePath, &fileStatus) == 0) && (fileStatus.st_ino == ino))
+    {
+        return (access(journalPath, F_OK) == 0);
+    }
 
-    int lockFd = OpenLockFile(pathNamePtr, accessMode, blocking);
+    return ((stat(filePath, &fileStatus) == 0) && (fileStatus.st_ino == ino));
+}
 
-    if (lockFd < 0)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completes or rolls back an interrupted transaction.
+ *
+ * The transaction is completed if every one of its files made it to disk, and rolled back
+ * otherwise.  The file being opened is recovered under the lock that was just obtained; any other
+ * file of the transaction is only recovered if its lock is free.  If it isn't, whoever holds the
+ * lock recovered it when obtaining the lock.
+ *
+ * As in a commit, the journals are deleted and the directory synced before the marks of the lock
+ * files are cleared, so that no journal is left behind.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecoverTransaction
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file being opened.
+    int lockFd                          ///< [IN] File descriptor of its lock file.
+)
+{
+    char dirPath[PATH_MAX];
+    char journalPath[PATH_MAX];
+    char filePath[PATH_MAX];
+    int lockFds[MAX_TRANSACTION_FILES];
+    size_t lockCount = 0;
+    JournalEntry_t entry;
+    le_result_t result;
+    size_t count = 0;
+    bool isComplete = true;
+
+    GetDirPath(pathNamePtr, dirPath, sizeof(dirPath));
+    GetFilePath(pathNamePtr, JOURNAL_FILE_EXTENSION, journalPath, sizeof(journalPath));
+
+    FILE* journalPtr = fopen(journalPath, "re");
+
+    if (journalPtr == NULL)
     {
-        return lockFd;
+        if (errno != ENOENT)
+        {
+            LE_CRIT("Failed to open journal '%s' (%m).", journalPath);
+            return;
+        }
+
+        // The transaction was done with the file, only the mark was left.
+        ClearLockRecord(lockFd, false);
+        return;
     }
 
-    // Check whether pathNamePtr points to an existent regular file.
-    le_result_t fileExistResult = CheckIfRegFileExist(pathNamePtr);
+    char line[64];
+    unsigned long long fileCount;
+    char end;
 
-    // Something error happened, so return immediately
-    if (fileExistResult == LE_FAULT)
+    if ((fgets(line, sizeof(line), journalPtr) == NULL) ||
+        (sscanf(line, "txn %llu%c", &fileCount, &end) != 2) || (end != '\n') ||
+        (fileCount == 0) || (fileCount > MAX_TRANSACTION_FILES))
     {
-        // No need to print any error message as it was done in CheckRegFile() function.
-        le_flock_Close(lockFd);
-        return LE_FAULT;
+        // The first write of the journal was cut short, so it wasn't linked and nothing was
+        // changed yet.
+        LE_WARN("Discarding incomplete journal '%s'.", journalPath);
+        fclose(journalPtr);
+        DeleteFile(journalPath);
+        SyncDir(dirPath);
+        ClearLockRecord(lockFd, false);
+        return;
     }
 
-    int fd = -1;
-    int tempfd = -1;
-    bool copy;
+    long entriesPos = ftell(journalPtr);
 
-    if ((accessMode == LE_FLOCK_READ) && (fileExistResult == LE_OK))
+    // First pass: find out whether all the files of the transaction are on disk.
+    while ((result = ReadJournalEntry(journalPtr, &entry)) == LE_OK)
     {
-        // We need to consider blocking here as well, otherwise this api call will be
-        // blocked if file is already opened by using le_flock api
-        fd = blocking ? le_flock_Create(pathNamePtr, accessMode, createMode, permissions) :
-                        le_flock_TryCreate(pathNamePtr, accessMode, createMode, permissions);
-        if (fd < 0)
+        LE_ASSERT(snprintf(filePath, sizeof(filePath), "%s/%s", dirPath, entry.name)
+                      < sizeof(filePath));
+
+        count++;
+        if (!IsEntryOnDisk(filePath, entry.ino))
         {
-            le_flock_Close(lockFd);
-            return fd;
+            isComplete = false;
         }
+    }
 
-        // Store info about this file in the File Access List.
-        SaveFileData(fd, lockFd, -1, pathNamePtr);
-
-        return fd;
+    if ((result != LE_OUT_OF_RANGE) || (count != fileCount))
+    {
+        // The journal itself is incomplete, so nothing was renamed yet.
+        isComplete = false;
     }
 
-    if (fileExistResult == LE_OK)
+    LE_WARN("Found interrupted transaction on '%s'; %s.",
+            pathNamePtr, isComplete ? "completing it" : "rolling it back");
+
+    // Second pass: rename (or delete) the temporary files and remove the journals.
+    LE_ASSERT(fseek(journalPtr, entriesPos, SEEK_SET) == 0);
+    const char* ownNamePtr = le_path_GetBasenamePtr(pathNamePtr, "/");
+
+    while (ReadJournalEntry(journalPtr, &entry) == LE_OK)
     {
-        switch(createMode)
+        char tempFilePath[PATH_MAX];
+        char entryJournalPath[PATH_MAX];
+        char lockFilePath[PATH_MAX];
+        struct stat fileStatus;
+
+        LE_ASSERT(snprintf(filePath, sizeof(filePath), "%s/%s", dirPath, entry.name)
+                      < sizeof(filePath));
+        GetFilePath(filePath, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
+        GetFilePath(filePath, JOURNAL_FILE_EXTENSION, entryJournalPath, sizeof(entryJournalPath));
+
+        if ((strcmp(entry.name, ownNamePtr) != 0) && (lockCount < MAX_TRANSACTION_FILES))
         {
-            case LE_FLOCK_OPEN_IF_EXIST:
-            case LE_FLOCK_REPLACE_IF_EXIST:
-                // We need to consider blocking here as well, otherwise this api call will be
-                // blocked if file is already opened by using le_flock api.
-                fd = blocking ? le_flock_Open(pathNamePtr, accessMode) :
-                                le_flock_TryOpen(pathNamePtr, accessMode);
+            GetFilePath(filePath, LOCK_FILE_EXTENSION, lockFilePath, sizeof(lockFilePath));
+            int entryLockFd = le_flock_TryCreate(lockFilePath,
+                                                 LE_FLOCK_READ_AND_WRITE,
+                                                 LE_FLOCK_OPEN_IF_EXIST,
+                                                 S_IRUSR | S_IWUSR);
+            if (entryLockFd < 0)
+            {
+                LE_DEBUG("'%s' is in use; leaving its recovery to its user.", filePath);
+                continue;
+            }
 
-                if (fd < 0)
+            lockFds[lockCount++] = entryLockFd;
+        }
+
+        if ((stat(tempFilePath, &fileStatus) == 0) && (fileStatus.st_ino == entry.ino))
+        {
+            if (isComplete)
+            {
+                if (rename(tempFilePath, filePath) != 0)
                 {
-                    le_flock_Close(lockFd);
-                    return fd;
+                    LE_CRIT("Failed rename '%s' to '%s' (%m).", tempFilePath, filePath);
                 }
-
-                copy = (createMode == LE_FLOCK_OPEN_IF_EXIST);   // Copy if LE_FLOCK_OPEN_IF_EXIST
-                                                                 // specified.
-                // Now open and lock the temporary file.
-                tempfd = CreateTempFromOriginal(pathNamePtr,
-                                                tempFilePath,
-                                                accessMode,
-                                                copy);
-                break;
-
-            case LE_FLOCK_FAIL_IF_EXIST:
-                le_flock_Close(lockFd);
-                return LE_DUPLICATE;
+            }
+            else
+            {
+                DeleteFile(tempFilePath);
+            }
         }
+
+        DeleteFile(entryJournalPath);
     }
-    else          // File doesn't exist
+
+    fclose(journalPtr);
+
+    // An incomplete journal has no links, but make sure it goes away too.
+    DeleteFile(journalPath);
+
+    if (SyncDir(dirPath) == LE_OK)
     {
-        fd = -1;
-        // Unlink the temp file, this is needed to avoid a bug (old temp file exists and creation
-        // of new file requested with different permission mode. In this case, new permission mode
-        // will be discarded)
-        unlink(tempFilePath);
+        ClearLockRecord(lockFd, false);
+    }
 
-        // No need to use TryCreate as we already opened (i.e. locked) the lockfile
-        tempfd = le_flock_Create(tempFilePath,
-                                 accessMode,
-                                 LE_FLOCK_REPLACE_IF_EXIST,
-                                 permissions);
+    while (lockCount > 0)
+    {
+        lockCount--;
+        ClearLockRecord(lockFds[lockCount], false);
+        le_flock_Close(lockFds[lockCount]);
     }
+}
 
 
-    if (tempfd < 0)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Truncates a file back to the size it had before an interrupted append.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecoverAppend
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file.
+    int lockFd,                         ///< [IN] File descriptor of its lock file.
+    off_t size                          ///< [IN] Size of the file before the append.
+)
+{
+    LE_WARN("Found interrupted append to '%s'; truncating it back to %lld bytes.",
+            pathNamePtr, (long long)size);
+
+    int fd = open(pathNamePtr, O_WRONLY | O_CLOEXEC);
+
+    if (fd == -1)
     {
-        if (fd > -1)
+        if (errno != ENOENT)
         {
-            le_flock_Close(fd);
+            LE_CRIT("Failed to open '%s' (%m).", pathNamePtr);
+            return;
         }
-        le_flock_Close(lockFd);
-        return tempfd;
     }
+    else
+    {
+        struct stat fileStatus;
 
-    // Store info about this file in the File Access List.
-    SaveFileData(fd, lockFd, tempfd, pathNamePtr);
+        if ((fstat(fd, &fileStatus) == 0) && (fileStatus.st_size > size) &&
+            ((ftruncate(fd, size) == -1) || (fsync(fd) == -1)))
+        {
+            LE_CRIT("Failed to truncate '%s' (%m).", pathNamePtr);
+            fd_Close(fd);
+            return;
+        }
 
-    return tempfd;
+        fd_Close(fd);
+    }
+
+    ClearLockRecord(lockFd, true);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Sync files to disk
- *
- * @return
- *      LE_OK if successful
- *      LE_FAULT if failed.
+ * Recovers a file from an interrupted append or transaction.  Must be called with an exclusive
+ * lock on the lock file of the file.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t SyncFile
+static void RecoverFile
 (
-    FileAccess_t* accessPtr,            ///< [IN] Object containing files to be Sync-ed
-    const char* tempFilePath            ///< [IN] Path to temporary file.
+    const char* pathNamePtr,            ///< [IN] Path of the file.
+    int lockFd,                         ///< [IN] File descriptor of its lock file, for writing.
+    const char* recordPtr               ///< [IN] Record of the lock file.
 )
 {
-    // Do a fsync to ensure write to temporary file goes to storage device.
-     if (fsync(accessPtr->tempFd) == -1)
-     {
-         LE_CRIT("Failed to do fsync on file '%s' (%m).", tempFilePath);
-         return LE_FAULT;
-     }
-
-     char dirName[PATH_MAX];
+    unsigned long long value;
+    char end;
 
-     // Get containing directory
-     LE_ASSERT_OK(le_path_GetDir(accessPtr->filePath, "/", dirName, sizeof(dirName)));
-
-     // le_path_GetDir returns file name when no path is specified.
-     if (!le_dir_IsDir(dirName))
-     {
-         dirName[0] = '.';
-         dirName[1] = 0;
-     }
-
-     int dirFd;
-     do
-     {
-         // Directory can be opened with read-only flag
-         dirFd = open(dirName, O_RDONLY);
-     }
-     while ( (dirFd == -1) && (errno == EINTR) );
-
-     if (dirFd == -1)
-     {
-         LE_CRIT("Failed to open directory '%s' (%m).", dirName);
-         return LE_FAULT;
-     }
-
-     // Now do a sync on directory
-     if (fsync(dirFd) == -1)
-     {
-         LE_CRIT("Failed to do fsync on directory: '%s' (%m).", dirName);
-         fd_Close(dirFd);
-         return LE_FAULT;
-     }
-
-     fd_Close(dirFd);
-
-     if (rename(tempFilePath, accessPtr->filePath))
-     {
-         LE_CRIT("Failed rename '%s' to '%s' (%m).", tempFilePath, accessPtr->filePath);
-         return LE_FAULT;
-     }
-
-     return LE_OK;
+    if ((sscanf(recordPtr, "append %llu%c", &value, &end) == 2) && (end == '\n'))
+    {
+        RecoverAppend(pathNamePtr, lockFd, (off_t)value);
+    }
+    else if (strcmp(recordPtr, "txn\n") == 0)
+    {
+        RecoverTransaction(pathNamePtr, lockFd);
+    }
+    else
+    {
+        // The first write of the record was cut short, so nothing was changed yet.
+        LE_WARN("Discarding incomplete record of the lock file of '%s'.", pathNamePtr);
+        ClearLockRecord(lockFd, true);
+    }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Commit or cancel all changes done on the file.
+ * Changes the lock held on a lock file, between shared and exclusive.  The change is not atomic:
+ * the lock held is released before the new one is obtained.
  *
  * @return
  *      LE_OK if successful.
- *      LE_FAULT if there was an error
+ *      LE_WOULD_BLOCK if blocking is false and there is an incompatible lock on the file.
+ *      LE_FAULT if there was an error.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t Close
+static le_result_t ChangeLock
 (
-    int fd,                   ///< [IN] File descriptor to close.
-    bool commit               ///< [IN] true to commit, false to cancel changes.
+    int lockFd,                         ///< [IN] Lock file descriptor.
+    int lockType,                       ///< [IN] LOCK_SH or LOCK_EX.
+    bool blocking                       ///< [IN] true if blocking, false if non-blocking.
 )
 {
-    LE_ASSERT(fd > -1);
-
-    // High level algorithm:
-    // if (file opened with Read-Only access )
-    //     1. Close the file and release resources
-    // else
-    //     if (Commit requested)
-    //        1. Sync the temp copy
-    //        2. Sync the containing directory
-    //        3. Rename the temp copy to appropriate name
-    //        4. Close files and release resources
-    //     else   // Cancel requested
-    //        1. Delete the temp copy
-    //        2. Close files and release resources
-
-    // Find out info about this file descriptor.
-    FileAccess_t* accessPtr = GetFileData(fd);
-
-    // Coding bug. So terminate immediately.
-    LE_FATAL_IF(accessPtr == NULL, "Bad file descriptor: %d", fd);
-
-    le_result_t result = LE_OK;
+    int r;
 
-    if ((accessPtr->originFd == fd) &&
-        (accessPtr->tempFd < 0))
+    do
     {
-        le_flock_Close(fd);
-        le_flock_Close(accessPtr->lockFd);
+        r = flock(lockFd, blocking ? lockType : (lockType | LOCK_NB));
     }
-    else
-    {
-        char tempFilePath[PATH_MAX];
-        GetFilePath(accessPtr->filePath, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
-
-        if (commit)  // Commit all the necessary changes.
-        {
-            result = SyncFile(accessPtr, tempFilePath);
-        }
-        else  // Cancel all changes, i.e. delete the temporary file
-        {
-            // Following function unlinks the file. Unlink is ok while file descriptor is open. File
-            // will be deleted when file descriptor will be closed.
-            result = DeleteFile(tempFilePath);
-        }
+    while ((r == -1) && (errno == EINTR));
 
-        // Now close temp and original file descriptor.
-        le_flock_Close(fd);
-
-        if (accessPtr->originFd > -1)
+    if (r == -1)
+    {
+        if (!blocking && (errno == EWOULDBLOCK))
         {
-            le_flock_Close(accessPtr->originFd);
+            return LE_WOULD_BLOCK;
         }
 
-        le_flock_Close(accessPtr->lockFd);
+        LE_ERROR("Could not change lock (%m).");
+        return LE_FAULT;
     }
 
-    // Release memory.
-    DeleteFileData(accessPtr);
-
-    return result;
+    return LE_OK;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Atomically and safely deletes a file.
+ * Open lock file for the file which will do atomic operation. If there is no lock file, this
+ * function will create and open lock file.  Once the lock is obtained, any interrupted append or
+ * transaction on the file is recovered.
  *
  * @return
- *      LE_OK if successful.
- *      LE_NOT_FOUND if file doesn't exists.
- *      LE_WOULD_BLOCK if file is already locked (i.e. someone is using it).
+ *      A file descriptor for doing atomic operation.
+ *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
  *      LE_FAULT if there was an error.
- */
+ **/
 //--------------------------------------------------------------------------------------------------
-static le_result_t Delete
+static int OpenLockFile
 (
-    const char* pathNamePtr,            ///< [IN] Path of the file to delete.
-    bool blocking                       ///< [IN] True if blocking, false if non-blocking.
+    const char* pathNamePtr,             ///< [IN] Path of the file for which lockfile should be open
+    le_flock_AccessMode_t accessMode,    ///< [IN] The access mode to open the file with.
+    bool blocking                        ///< [IN] true if blocking, false if non-blocking.
 )
 {
-    // High level algorithm:
-    //    1. Lock the lockfile.
-    //    2. Lock the original file.
-    //    3. Rename original file to a temporary file
-    //    4. Unlink the temporary file and unlock lockfile.
+    char lockFilePath[PATH_MAX];
+    GetFilePath(pathNamePtr, LOCK_FILE_EXTENSION, lockFilePath, sizeof(lockFilePath));
 
-    int lockFd = OpenLockFile(pathNamePtr, LE_FLOCK_APPEND, blocking);
+    // Writers record their progress in the lock file, so they open it for writing as well.
+    le_flock_AccessMode_t lockMode = (accessMode == LE_FLOCK_READ) ? LE_FLOCK_READ :
+                                                                     LE_FLOCK_READ_AND_WRITE;
+    int lockFd;
+
+    if (blocking)
+    {
+        lockFd = le_flock_Create(lockFilePath,
+                                 lockMode,
+                                 LE_FLOCK_OPEN_IF_EXIST,
+                                 S_IRUSR | S_IWUSR);
+    }
+    else
+    {
+        lockFd = le_flock_TryCreate(lockFilePath,
+                                    lockMode,
+                                    LE_FLOCK_OPEN_IF_EXIST,
+                                    S_IRUSR | S_IWUSR);
+    }
 
     if (lockFd < 0)
     {
         return lockFd;
     }
 
-    // This locking is needed to avoid some unexpected race condition (e.g. process A opens a file
-    // using le_flock_Open() api and starts writing on this file. Process B calls
-    // le_atomFile_Delete() function to delete the same file. If no locking mechanism is used here,
-    // process B will delete the file while process A is writing on this file.)
-    int fd = blocking ? le_flock_Open(pathNamePtr, LE_FLOCK_WRITE) :
-                        le_flock_TryOpen(pathNamePtr, LE_FLOCK_WRITE);
+    // This is the common case: nothing to recover.
+    char record[LOCK_RECORD_MAX_BYTES];
 
-    if (fd < 0)
+    if (!ReadLockRecord(lockFd, record, sizeof(record)))
     {
-        le_flock_Close(lockFd);
-        return fd;
+        return lockFd;
     }
 
-    char lockFilePath[PATH_MAX];
-    char tempFilePath[PATH_MAX];
-    GetFilePath(pathNamePtr, LOCK_FILE_EXTENSION, lockFilePath, sizeof(lockFilePath));
-    GetFilePath(pathNamePtr, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
-
-    if (rename(pathNamePtr, tempFilePath) == -1)
+    // Finish off any interrupted change before anything else is done with the file.  The recovery
+    // changes the file, so it needs an exclusive lock: readers share their lock, so they get an
+    // exclusive one, and a descriptor to write the record with, for the time of the recovery.
+    if (lockMode != LE_FLOCK_READ)
     {
-        LE_CRIT("Failed rename '%s' to '%s' (%m).", pathNamePtr, tempFilePath);
-        le_flock_Close(fd);
-        le_flock_Close(lockFd);
-        return LE_FAULT;
+        RecoverFile(pathNamePtr, lockFd, record);
+        return lockFd;
     }
 
-    DeleteFile(tempFilePath);
+    le_result_t result = ChangeLock(lockFd, LOCK_EX, blocking);
 
-    le_flock_Close(fd);
+    if (result == LE_OK)
+    {
+        int writeFd = open(lockFilePath, O_RDWR | O_CLOEXEC);
 
-    // Note: Don't unlink the lockfile, it may lead to race condition (e.g. process B opens lockfile
-    // but can't lock as process A is on the way to delete lockfile, when process A closes lockfile
-    // descriptor, process B can lock the lockfile, now if process C checks lockfile it won't find
-    // any lockfile and can create and lock the lockfile).
-    // Size of lockfile is zero, so it won't matter much.
-    le_flock_Close(lockFd);
+        if (writeFd == -1)
+        {
+            LE_CRIT("Failed to open '%s' for recovery (%m).", lockFilePath);
+        }
+        else
+        {
+            // Another reader may have recovered the file while the lock was released.
+            if (ReadLockRecord(writeFd, record, sizeof(record)))
+            {
+                RecoverFile(pathNamePtr, writeFd, record);
+            }
+            fd_Close(writeFd);
+        }
 
-    return LE_OK;
+        result = ChangeLock(lockFd, LOCK_SH, blocking);
+    }
+
+    if (result != LE_OK)
+    {
+        le_flock_Close(lockFd);
+        return result;
+    }
+
+    return lockFd;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Opens an existing file for atomic access operation.
- *
- * The file can be open for reading, writing or both as specified in the accessMode argument.
- * Parameter accessMode specifies the lock to be applied on the file (read lock will be applied for
- * LE_FLOCK_READ and write lock will be placed for all other cases).
- *
- * This is a blocking call. It will block until it can open the target file with specified
- * accessMode.
+ * Creates temporary file for doing all intermediate operations. This function is used to create
+ * temporary file when original file exists. File permissions are copied from the original file.
  *
  * @return
- *      A file descriptor if successful.
+ *      A file descriptor for doing atomic operation.
  *      LE_NOT_FOUND if the file does not exist.
  *      LE_FAULT if there was an error.
- *
- * @note
- *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
- */
+ **/
 //--------------------------------------------------------------------------------------------------
-int le_atomFile_Open
+static int CreateTempFromOriginal
 (
-    const char* pathNamePtr,            ///< [IN] Path of the file to open
-    le_flock_AccessMode_t accessMode    ///< [IN] The access mode to open the file with.
+    const char* origPathPtr,             ///< [IN] Path to original file.
+    const char* tempPathPtr,             ///< [IN] Path to temporary file.
+    le_flock_AccessMode_t accessMode,    ///< [IN] The access mode to open the file with.
+    bool copy                            ///< [IN] Whether content of original file should be copied
+                                         ///<      to temporary file.
 )
 {
+    // Delete the temporary file if exists.
+    unlink(tempPathPtr);
 
-    return Open(pathNamePtr, accessMode, true);
+    // File permission mode in temporary file should be same as original file, so set the
+    // processor umask to 0.
+    mode_t old_mode = umask((mode_t)0);
+    int tempfd;
+
+    if (copy)
+    {
+        // Copy the contents to temporary file.
+        if (file_Copy(origPathPtr, tempPathPtr, NULL) == LE_OK)
+        {
+            // Temp file already exists. So opening should be fine.
+            tempfd = le_flock_Open(tempPathPtr, accessMode);
+        }
+        else
+        {
+            tempfd = LE_FAULT;
+        }
+    }
+    else
+    {
+        // Temp file doesn't exist, so create it with original file permission
+        struct stat fileStatus;
+
+        // Get the original file permission mode and create a temp file with same permission mode.
+        if (stat(origPathPtr, &fileStatus) == 0)
+        {
+            tempfd = le_flock_Create(tempPathPtr,
+                                     accessMode,
+                                     LE_FLOCK_REPLACE_IF_EXIST,
+                                     fileStatus.st_mode);
+        }
+        else
+        {
+            LE_CRIT("Error when trying to stat '%s'. (%m)", origPathPtr);
+            tempfd = LE_FAULT;
+        }
+    }
+
+    umask(old_mode);
 
+    return tempfd;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Creates and opens file for atomic operation.
- *
- * If the file does not exist it will be created with the file permissions specified in the argument
- * permissions (modified by the process's umask).  Refer to the POSIX function open(2) for details
- * of mode_t:
- *
- * http://man7.org/linux/man-pages/man2/open.2.html
+ * Creates temporary file stream for doing all intermediate operations. This function is used to
+ * create temporary file when original file exists. File permissions are copied from the original
+ * file.
  *
- * The file can be opened for reading, writing or both as specified in the accessMode argument.
- * Parameter accessMode specifies the lock to be applied on the file (read lock will be applied for
- * LE_FLOCK_READ and write lock will be placed for all other cases).
- *
- * This is a blocking call. It will block until it can create and open the target file with specified
- * parameters(i.e. accessMode, createMode, permissions).
- *
- * @return
- *      A file descriptor if successful.
- *      LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode
- *      LE_FAULT if there was an error.
- *
- * @note
- *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
- */
-//--------------------------------------------------------------------------------------------------
-int le_atomFile_Create
-(
-    const char* pathNamePtr,            ///< [IN] Path of the file to open
-    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
-    le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
-    mode_t permissions                  ///< [IN] The file permissions used when creating the file.
-                                        ///       See the function header comments for more details.
-)
-{
-    return Create(pathNamePtr, accessMode, createMode, permissions, true);
-}
-
-
-//--------------------------------------------------------------------------------------------------
-/**
- * Same as @c le_atomFile_Open() except that it is non-blocking function and it will fail and return
- * LE_WOULD_BLOCK immediately if target file has incompatible lock.
+ * If there was an error NULL is returned and resultPtr is set to:
+ *      LE_NOT_FOUND if file doesn't exists.
+ *      LE_FAULT if there was an error.
  *
  * @return
- *      A file descriptor if successful.
- *      LE_NOT_FOUND if the file does not exist.
- *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
- *      LE_FAULT if there was an error.
- *
- * @note
- *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
- */
+ *      Buffered file stream handle to the file if successful.
+ *      NULL if there was an error.
+ **/
 //--------------------------------------------------------------------------------------------------
-int le_atomFile_TryOpen
+static FILE* CreateTempStreamFromOriginal
 (
-    const char* pathNamePtr,            ///< [IN] Path of the file to open
-    le_flock_AccessMode_t accessMode    ///< [IN] The access mode to open the file with.
+    const char* origPathPtr,             ///< [IN] Path to original file.
+    const char* tempPathPtr,             ///< [IN] Path to temporary file.
+    le_flock_AccessMode_t accessMode,    ///< [IN] The access mode to open the file with.
+    bool copy,                           ///< [IN] Whether content of original file should be copied
+                                         ///<      to temporary file.
+    le_result_t* resultPtr               ///< [OUT] A pointer to result code
 )
 {
-    return Open(pathNamePtr, accessMode, false);
-}
+    // Delete the temporary file if exists.
+    unlink(tempPathPtr);
 
+    // File permission mode in temporary file should be same as original file, so set the
+    // processor umask to 0.
+    mode_t old_mode = umask((mode_t)0);
+    FILE* file;
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Same as @c le_atomFile_Create() except that it is non-blocking function and  it will fail and
- * return LE_WOULD_BLOCK immediately if target file has incompatible lock.
- *
- * @return
- *      A file descriptor if successful.
- *      LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode
- *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
- *      LE_FAULT if there was an error.
- *
- * @note
- *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
- */
-//--------------------------------------------------------------------------------------------------
-int le_atomFile_TryCreate
-(
-    const char* pathNamePtr,            ///< [IN] Path of the file to open
-    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
-    le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
-    mode_t permissions                  ///< [IN] The file permissions used when creating the file.
-)
-{
-    return Create(pathNamePtr, accessMode, createMode, permissions, false);
-}
+    if (copy)
+    {
+        // Copy the contents to temporary file.
+        if (file_Copy(origPathPtr, tempPathPtr, NULL) == LE_OK)
+        {
+            // Temp file already exists. So opening should be fine.
+            file = le_flock_OpenStream(tempPathPtr, accessMode, resultPtr);
+        }
+        else
+        {
+            if (resultPtr != NULL)
+            {
+                *resultPtr = LE_FAULT;
+            }
+            file = NULL;
+        }
+    }
+    else
+    {
+        // Temp file doesn't exist, so create it with original file permission
+        struct stat fileStatus;
 
+        // Get the original file permission mode and create a temp file with same permission mode.
+        if (stat(origPathPtr, &fileStatus) == 0)
+        {
+            file = le_flock_CreateStream(tempPathPtr,
+                                         accessMode,
+                                         LE_FLOCK_REPLACE_IF_EXIST,
+                                         fileStatus.st_mode,
+                                         resultPtr);
+        }
+        else
+        {
+            LE_CRIT("Error when trying to stat '%s'. (%m)", origPathPtr);
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Cancels all changes and closes the file descriptor.
- */
-//--------------------------------------------------------------------------------------------------
-void le_atomFile_Cancel
-(
-    int fd                              /// [IN] The file descriptor to close.
-)
-{
-    Close(fd, false);
-}
+            if (resultPtr != NULL)
+            {
+                *resultPtr = LE_FAULT;
+            }
+            file = NULL;
+        }
+    }
 
+    umask(old_mode);
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Commits all changes and closes the file descriptor. No need to close the file descriptor again if
- * this function returns error (i.e. file descriptor is closed in both success and error scenario).
- *
- * @return
- *      LE_OK if successful.
- *      LE_FAULT if there was an error
- */
-//--------------------------------------------------------------------------------------------------
-le_result_t le_atomFile_Close
-(
-    int fd                              /// [IN] The file descriptor to close.
-)
-{
-    return Close(fd, true);
+    return file;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Open a stream for atomic operation.
- *
- * If there was an error NULL is returned and resultPtr is set to:
- *   - LE_NOT_FOUND if the file does not exist.
- *   - LE_WOULD_BLOCK if there is already an incompatible lock on the file.
- *   - LE_FAULT if there was an error.
+ * Open an existing file for atomic operation.
  *
  * @return
- *      Buffered file stream handle to the file if successful.
- *      NULL if there was an error.
+ *      A file descriptor for doing atomic operation.
+ *      LE_NOT_FOUND if the file does not exist.
+ *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *      LE_FAULT if there was an error.
  **/
 //--------------------------------------------------------------------------------------------------
-static FILE* OpenStream
+static int Open
 (
-    const char* pathNamePtr,            ///< [IN] Path of the file to open.
-    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
-    bool blocking,                      ///< [IN] true if blocking, false if non-blocking.
-    le_result_t* resultPtr              ///< [OUT] A pointer to result code.
+    const char* pathNamePtr,             ///< [IN] Path of the file to open.
+    le_flock_AccessMode_t accessMode,    ///< [IN] The access mode to open the file with.
+    bool blocking                        ///< [IN] true if blocking, false if non-blocking.
 )
 {
     LE_ASSERT(pathNamePtr != NULL);
@@ -1172,127 +1262,121 @@ static FILE* OpenStream
     // High level algorithm:
     // if (Read-Only access requested)
     //     1. Lock the lockfile
-    //     2. Lock the file and return the file stream
+    //     2. Lock the file and return the file descriptor
     // else
-    //     1. Lock the lockfile
-    //     2. Lock the original file
+    //     1. Lock the lockfile.
+    //     2. Lock the original file.
     //     3. Create a temp copy of the file and lock that temp copy
-    //     4. Open the temp copy and return the file stream
+    //     4. Open the temp copy and return the file descriptor.
 
+    // Open(or lock) the lockfile.
     int lockFd = OpenLockFile(pathNamePtr, accessMode, blocking);
 
     if (lockFd < 0)
     {
-        if (resultPtr != NULL)
-        {
-            *resultPtr = lockFd;
-        }
-        return NULL;
+        return lockFd;
     }
 
     if (accessMode == LE_FLOCK_READ)
     {
+        // Note: Even for read access we need to put lock the lockfile. This should be done to avoid
+        // a race condition (e.g. Process A requests write access to an existing file named abc.txt
+        // and it's access request is granted, now process B requests read access to abc.txt, so
+        // process B opens abc.txt but it is blocked when it tries to acquire read lock. Now when
+        // process A commits all its changes, it renames the temporary file to abc.txt, hence
+        // process B is pointing to wrong inode)
+
         // We need to consider blocking here as well, otherwise this api call will be blocked if
         // file is already opened by using le_flock api.
-        FILE* file = blocking ? le_flock_OpenStream(pathNamePtr, accessMode, resultPtr) :
-                                le_flock_TryOpenStream(pathNamePtr, accessMode, resultPtr);
+        int fd = blocking ? le_flock_Open(pathNamePtr, accessMode) :
+                            le_flock_TryOpen(pathNamePtr, accessMode);
 
-        if (file == NULL)
+        if (fd < 0)
         {
             le_flock_Close(lockFd);
-            return file;
+            return fd;
         }
 
         // Store info about this file in the File Access List.
-        SaveFileData(fileno(file), lockFd, -1, pathNamePtr);
+        SaveFileData(fd, lockFd, -1, pathNamePtr);
 
-        return file;
+        return fd;
     }
     else
     {
         // We need to consider blocking here as well, otherwise this api call will be blocked if
         // file is already opened by using le_flock api.
-        int fd = blocking ? le_flock_Open(pathNamePtr, accessMode) :
+        int fd = blocking ? le_flock_Open(pathNamePtr, accessMode):
                             le_flock_TryOpen(pathNamePtr, accessMode);
 
         if (fd < 0)
         {
-            if (resultPtr != NULL)
-            {
-                *resultPtr = fd;
-            }
             le_flock_Close(lockFd);
-            return NULL;
+            return fd;
         }
 
         char tempFilePath[PATH_MAX];
         GetFilePath(pathNamePtr, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
 
-        // Now open and lock the temporary file.
-        FILE* file = CreateTempStreamFromOriginal(pathNamePtr,
-                                                  tempFilePath,
-                                                  accessMode,
-                                                  true,        // Copy the content of original file
-                                                  resultPtr);
+        // Now open the temporary file.
+        int tempfd = CreateTempFromOriginal(pathNamePtr,
+                                            tempFilePath,
+                                            accessMode,
+                                            true);
 
-        if (file == NULL)
+        if (tempfd < 0)
         {
-            le_flock_Close(fd);
-            le_flock_Close(lockFd);
-            return NULL;
+           le_flock_Close(fd);
+           le_flock_Close(lockFd);
+           return tempfd;
         }
 
         // Store info about this file in the File Access List.
-        SaveFileData(fd, lockFd, fileno(file), pathNamePtr);
+        SaveFileData(fd, lockFd, tempfd, pathNamePtr);
 
-        return file;
+        return tempfd;
     }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Creates a file stream for atomic operation.
- *
- * If there was an error NULL is returned and resultPtr is set to:
- *  - LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode.
- *  - LE_WOULD_BLOCK if there is already an incompatible lock on the file.
- *  - LE_FAULT if there was an error.
+ * Create a file for atomic operation.
  *
  * @return
- *      Buffered file stream handle to the file if successful.
- *      NULL if there was an error.
+ *      File descriptor for doing atomic operation.
+ *      LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode
+ *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *      LE_FAULT if there was an error.
  **/
 //--------------------------------------------------------------------------------------------------
-static FILE* CreateStream
+static int Create
 (
     const char* pathNamePtr,            ///< [IN] Path of the file to open.
     le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
     le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
     mode_t permissions,                 ///< [IN] The file permissions used when creating the file.
-    bool blocking,                      ///< [IN] true if blocking, false if non-blocking.
-    le_result_t* resultPtr              ///< [OUT] A pointer to result code
+    bool blocking                       ///< [IN] true if blocking, false if non-blocking.
 )
 {
     LE_ASSERT(pathNamePtr != NULL);
     LE_ASSERT(pathNamePtr[0] != '\0');
 
-
     // High level algorithm:
     //
     // if (file exists)
     //     if (Read-Only access requested)
     //         1. Lock the lockfile
-    //         2. Lock the file and return the file stream.
+    //         2. Lock the file and return the file descriptor
     //     else
     //         1. Lock the lockfile.
     //         2. Lock the original file.
     //         3. Create a temp copy of the file and lock that temp copy
-    //         4. Open the temp copy and return the file stream.
+    //         4. Open the temp copy and return the file descriptor.
     //  else
     //     1. Lock the lockfile.
     //     2. Create a temp copy and lock that temp copy
-    //     3. Open the temp copy and return the file stream.
+    //     3. Open the temp copy and return the file descriptor.
 
     char tempFilePath[PATH_MAX];
     GetFilePath(pathNamePtr, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
@@ -1301,60 +1385,40 @@ static FILE* CreateStream
 
     if (lockFd < 0)
     {
-        if (resultPtr != NULL)
-        {
-            *resultPtr = lockFd;
-        }
-        return NULL;
+        return lockFd;
     }
 
-    FILE* file = NULL;
-    int fd = -1;
-    bool copy;
-
-    // Check whether pathNamePtr points to an existent regular file. This one has to be done after
-    // lock is acquired to avoid race condition (e.g. process A checks existence of file abc.txt
-    // then block on locking lockfile, where as in the mean time process B rename/delete abc.txt.
-    // In this case process A has old stale information)
+    // Check whether pathNamePtr points to an existent regular file.
     le_result_t fileExistResult = CheckIfRegFileExist(pathNamePtr);
 
     // Something error happened, so return immediately
     if (fileExistResult == LE_FAULT)
     {
-        // No need to print any error message as it was done in CheckIfRegFileExist() function.
-        if (resultPtr != NULL)
-        {
-            *resultPtr = LE_FAULT;
-        }
-
+        // No need to print any error message as it was done in CheckRegFile() function.
         le_flock_Close(lockFd);
-        return NULL;
+        return LE_FAULT;
     }
 
+    int fd = -1;
+    int tempfd = -1;
+    bool copy;
+
     if ((accessMode == LE_FLOCK_READ) && (fileExistResult == LE_OK))
     {
         // We need to consider blocking here as well, otherwise this api call will be
         // blocked if file is already opened by using le_flock api
-        file = blocking ? le_flock_CreateStream(pathNamePtr,
-                                                accessMode,
-                                                createMode,
-                                                permissions,
-                                                resultPtr) :
-                          le_flock_TryCreateStream(pathNamePtr,
-                                                   accessMode,
-                                                   createMode,
-                                                   permissions,
-                                                   resultPtr);
-        if (file == NULL)
+        fd = blocking ? le_flock_Create(pathNamePtr, accessMode, createMode, permissions) :
+                        le_flock_TryCreate(pathNamePtr, accessMode, createMode, permissions);
+        if (fd < 0)
         {
             le_flock_Close(lockFd);
-            return file;
+            return fd;
         }
 
         // Store info about this file in the File Access List.
-        SaveFileData(fileno(file), lockFd, -1, pathNamePtr);
+        SaveFileData(fd, lockFd, -1, pathNamePtr);
 
-        return file;
+        return fd;
     }
 
     if (fileExistResult == LE_OK)
@@ -1363,41 +1427,29 @@ static FILE* CreateStream
         {
             case LE_FLOCK_OPEN_IF_EXIST:
             case LE_FLOCK_REPLACE_IF_EXIST:
-                // We need to consider blocking here as well, otherwise this api call will be blocked if
-                // file is already opened by using le_flock api.
+                // We need to consider blocking here as well, otherwise this api call will be
+                // blocked if file is already opened by using le_flock api.
                 fd = blocking ? le_flock_Open(pathNamePtr, accessMode) :
                                 le_flock_TryOpen(pathNamePtr, accessMode);
 
                 if (fd < 0)
                 {
-                    if (resultPtr != NULL)
-                    {
-                        *resultPtr = fd;
-                    }
-
                     le_flock_Close(lockFd);
-                    return NULL;
+                    return fd;
                 }
 
                 copy = (createMode == LE_FLOCK_OPEN_IF_EXIST);   // Copy if LE_FLOCK_OPEN_IF_EXIST
                                                                  // specified.
                 // Now open and lock the temporary file.
-                file = CreateTempStreamFromOriginal(pathNamePtr,
-                                                    tempFilePath,
-                                                    accessMode,
-                                                    copy,
-                                                    resultPtr);
+                tempfd = CreateTempFromOriginal(pathNamePtr,
+                                                tempFilePath,
+                                                accessMode,
+                                                copy);
                 break;
 
             case LE_FLOCK_FAIL_IF_EXIST:
-
-                if (resultPtr != NULL)
-                {
-                    *resultPtr = LE_DUPLICATE;
-                }
                 le_flock_Close(lockFd);
-
-                return NULL;
+                return LE_DUPLICATE;
         }
     }
     else          // File doesn't exist
@@ -1408,43 +1460,233 @@ static FILE* CreateStream
         // will be discarded)
         unlink(tempFilePath);
 
-        // No need to use TryCreate as it is a temp file and we already locked the lockfile.
-        file =  le_flock_CreateStream(tempFilePath,
-                                      accessMode,
-                                      LE_FLOCK_REPLACE_IF_EXIST,
-                                      permissions,
-                                      resultPtr);
+        // No need to use TryCreate as we already opened (i.e. locked) the lockfile
+        tempfd = le_flock_Create(tempFilePath,
+                                 accessMode,
+                                 LE_FLOCK_REPLACE_IF_EXIST,
+                                 permissions);
     }
 
-    if (file == NULL)
+
+    if (tempfd < 0)
     {
         if (fd > -1)
         {
             le_flock_Close(fd);
         }
         le_flock_Close(lockFd);
-        return NULL;
+        return tempfd;
     }
 
     // Store info about this file in the File Access List.
-    SaveFileData(fd, lockFd, fileno(file), pathNamePtr);
+    SaveFileData(fd, lockFd, tempfd, pathNamePtr);
 
-    return file;
+    return tempfd;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Commit or cancel all changes done on the stream.
+ * Sync files to disk
+ *
+ * @return
+ *      LE_OK if successful
+ *      LE_FAULT if failed.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t CloseStream
+static le_result_t SyncFile
 (
-    FILE* file,               ///< [IN] File Stream to close
+    FileAccess_t* accessPtr,            ///< [IN] Object containing files to be Sync-ed
+    const char* tempFilePath            ///< [IN] Path to temporary file.
+)
+{
+    // Do a fsync to ensure write to temporary file goes to storage device.
+     if (fsync(accessPtr->tempFd) == -1)
+     {
+         LE_CRIT("Failed to do fsync on file '%s' (%m).", tempFilePath);
+         return LE_FAULT;
+     }
+
+     char dirName[PATH_MAX];
+
+     // Get containing directory and sync it.
+     GetDirPath(accessPtr->filePath, dirName, sizeof(dirName));
+
+     if (SyncDir(dirName) != LE_OK)
+     {
+         return LE_FAULT;
+     }
+
+     if (rename(tempFilePath, accessPtr->filePath))
+     {
+         LE_CRIT("Failed rename '%s' to '%s' (%m).", tempFilePath, accessPtr->filePath);
+         return LE_FAULT;
+     }
+
+     return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open an existing file for atomic appends.  Rather than copying the file, the original size of
+ * the file is recorded in its lock file, and the file is opened directly.
+ *
+ * @return
+ *      A file descriptor for doing atomic operation.
+ *      LE_NOT_FOUND if the file does not exist.
+ *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *      LE_FAULT if there was an error.
+ **/
+//--------------------------------------------------------------------------------------------------
+static int OpenAppend
+(
+    const char* pathNamePtr,             ///< [IN] Path of the file to open.
+    bool blocking                        ///< [IN] true if blocking, false if non-blocking.
+)
+{
+    LE_ASSERT(pathNamePtr != NULL);
+    LE_ASSERT(pathNamePtr[0] != '\0');
+
+    // High level algorithm:
+    //     1. Lock the lockfile.
+    //     2. Lock the original file, opened for appending.
+    //     3. Record the size of the original file in the lock file and sync the lock file.
+    //     4. Return the file descriptor of the original file.
+
+    char dirPath[PATH_MAX];
+    GetDirPath(pathNamePtr, dirPath, sizeof(dirPath));
+
+    // The lock file must be next to the file, not in the temporary directory.
+    if (access(dirPath, W_OK) != 0)
+    {
+        LE_CRIT("Can't append atomically to '%s': directory not writable (%m).", pathNamePtr);
+        return LE_FAULT;
+    }
+
+    int lockFd = OpenLockFile(pathNamePtr, LE_FLOCK_READ_AND_APPEND, blocking);
+
+    if (lockFd < 0)
+    {
+        return lockFd;
+    }
+
+    int fd = blocking ? le_flock_Open(pathNamePtr, LE_FLOCK_READ_AND_APPEND) :
+                        le_flock_TryOpen(pathNamePtr, LE_FLOCK_READ_AND_APPEND);
+
+    if (fd < 0)
+    {
+        le_flock_Close(lockFd);
+        return fd;
+    }
+
+    struct stat fileStatus;
+
+    if (fstat(fd, &fileStatus) != 0)
+    {
+        LE_CRIT("Error when trying to stat '%s'. (%m)", pathNamePtr);
+        le_flock_Close(fd);
+        le_flock_Close(lockFd);
+        return LE_FAULT;
+    }
+
+    // The record is left cleared rather than deleted once the append is done.  When it is first
+    // written, the lock file was just created, so the directory is synced so that the lock file
+    // can't disappear in a power loss.
+    struct stat lockStatus;
+    char record[LOCK_RECORD_MAX_BYTES];
+    snprintf(record, sizeof(record), "append %lld\n", (long long)fileStatus.st_size);
+
+    if ((fstat(lockFd, &lockStatus) != 0) ||
+        (WriteLockRecord(lockFd, record) != LE_OK) ||
+        ((lockStatus.st_size == 0) && (SyncDir(dirPath) != LE_OK)))
+    {
+        LE_CRIT("Failed to record append to '%s' (%m).", pathNamePtr);
+        le_flock_Close(fd);
+        le_flock_Close(lockFd);
+        return LE_FAULT;
+    }
+
+    SimulateCrash(ATOMFILE_CRASH_APPEND_RECORD_WRITTEN);
+
+    FileAccess_t* accessPtr = SaveFileData(fd, lockFd, -1, pathNamePtr);
+    accessPtr->isAppend = true;
+    accessPtr->appendOffset = fileStatus.st_size;
+
+    return fd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commit or cancel the appends done to a file opened by OpenAppend(), and close it.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CloseAppend
+(
+    FileAccess_t* accessPtr,            ///< [IN] File to close.
+    bool commit                         ///< [IN] true to commit, false to cancel changes.
+)
+{
+    // High level algorithm:
+    //     1. Commit: sync the file.  Cancel: truncate the file back to its original size.
+    //     2. Clear the record of the lock file and sync it.
+    //     3. Close files and release resources.
+    //
+    // If the record can't be cleared, the appended data will be removed the next time the file
+    // is opened.
+
+    le_result_t result = LE_OK;
+
+    if (commit)
+    {
+        if (fsync(accessPtr->originFd) == -1)
+        {
+            LE_CRIT("Failed to do fsync on file '%s' (%m).", accessPtr->filePath);
+            result = LE_FAULT;
+        }
+    }
+    else if ((ftruncate(accessPtr->originFd, accessPtr->appendOffset) == -1) ||
+             (fsync(accessPtr->originFd) == -1))
+    {
+        LE_CRIT("Failed to truncate file '%s' (%m).", accessPtr->filePath);
+        result = LE_FAULT;
+    }
+
+    SimulateCrash(ATOMFILE_CRASH_APPEND_FILE_SYNCED);
+
+    if (result == LE_OK)
+    {
+        result = ClearLockRecord(accessPtr->lockFd, true);
+    }
+
+    le_flock_Close(accessPtr->originFd);
+    le_flock_Close(accessPtr->lockFd);
+
+    return (commit ? result : LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commit or cancel all changes done on the file.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Close
+(
+    int fd,                   ///< [IN] File descriptor to close.
     bool commit               ///< [IN] true to commit, false to cancel changes.
 )
 {
-    LE_ASSERT(file != NULL);
+    LE_ASSERT(fd > -1);
 
     // High level algorithm:
     // if (file opened with Read-Only access )
@@ -1459,21 +1701,23 @@ static le_result_t CloseStream
     //        1. Delete the temp copy
     //        2. Close files and release resources
 
-    int fd = fileno(file);
-
-    LE_ASSERT(fd > -1);
-
+    // Find out info about this file descriptor.
     FileAccess_t* accessPtr = GetFileData(fd);
 
-    // Coding bug. Terminate immediately.
-    LE_FATAL_IF(accessPtr == NULL, "Bad file stream: %p", file);
+    // Coding bug. So terminate immediately.
+    LE_FATAL_IF(accessPtr == NULL, "Bad file descriptor: %d", fd);
+    LE_FATAL_IF(accessPtr->txnPtr != NULL, "File descriptor %d belongs to a transaction", fd);
 
     le_result_t result = LE_OK;
 
-    if ((accessPtr->tempFd < 0) &&  // Negative tempfd implies READ_ONLY access requested.
-        (accessPtr->originFd == fd))
+    if (accessPtr->isAppend)
     {
-        le_flock_CloseStream(file);
+        result = CloseAppend(accessPtr, commit);
+    }
+    else if ((accessPtr->originFd == fd) &&
+             (accessPtr->tempFd < 0))
+    {
+        le_flock_Close(fd);
         le_flock_Close(accessPtr->lockFd);
     }
     else
@@ -1483,37 +1727,17 @@ static le_result_t CloseStream
 
         if (commit)  // Commit all the necessary changes.
         {
-            // Now flush data to OS.
-            int flushResult;
-            do
-            {
-                flushResult = fflush(file);
-            }
-            while ( (flushResult != 0) && (errno == EINTR) );
-
-            if (flushResult != 0)
-            {
-                LE_CRIT("Failed to flush file '%s' (%m).", tempFilePath);
-                result = LE_FAULT;
-            }
-
-            if (result == LE_OK)
-            {
-                //Now flush data to disk
-                result = SyncFile(accessPtr, tempFilePath);
-            }
+            result = SyncFile(accessPtr, tempFilePath);
         }
-        else   // Discard all the changes
+        else  // Cancel all changes, i.e. delete the temporary file
         {
             // Following function unlinks the file. Unlink is ok while file descriptor is open. File
             // will be deleted when file descriptor will be closed.
             result = DeleteFile(tempFilePath);
         }
 
-        // Now close temporary and original file.
-
-        // It is ok to close stream after renaming it as it is in same filesystem.
-        le_flock_CloseStream(file);
+        // Now close temp and original file descriptor.
+        le_flock_Close(fd);
 
         if (accessPtr->originFd > -1)
         {
@@ -1523,7 +1747,7 @@ static le_result_t CloseStream
         le_flock_Close(accessPtr->lockFd);
     }
 
-    // Release allocated memory
+    // Release memory.
     DeleteFileData(accessPtr);
 
     return result;
@@ -1532,218 +1756,1391 @@ static le_result_t CloseStream
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Opens an existing file via C standard library buffered file stream for atomic operation.
- *
- * The file can be open for reading, writing or both as specified in the accessMode argument.
- * Parameter accessMode specifies the lock to be applied on the file (read lock will be applied for
- * LE_FLOCK_READ and write lock will be placed for all other cases).
- *
- * This is a blocking call. It will block until it can open the target file with specified
- * accessMode.
- *
- * If there was an error NULL is returned and resultPtr is set to:
- *   - LE_NOT_FOUND if the file does not exist.
- *   - LE_FAULT if there was an error.
+ * Atomically and safely deletes a file.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if file doesn't exists.
+ *      LE_WOULD_BLOCK if file is already locked (i.e. someone is using it).
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t Delete
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to delete.
+    bool blocking                       ///< [IN] True if blocking, false if non-blocking.
+)
+{
+    // High level algorithm:
+    //    1. Lock the lockfile.
+    //    2. Lock the original file.
+    //    3. Rename original file to a temporary file
+    //    4. Unlink the temporary file and unlock lockfile.
+
+    int lockFd = OpenLockFile(pathNamePtr, LE_FLOCK_APPEND, blocking);
+
+    if (lockFd < 0)
+    {
+        return lockFd;
+    }
+
+    // This locking is needed to avoid some unexpected race condition (e.g. process A opens a file
+    // using le_flock_Open() api and starts writing on this file. Process B calls
+    // le_atomFile_Delete() function to delete the same file. If no locking mechanism is used here,
+    // process B will delete the file while process A is writing on this file.)
+    int fd = blocking ? le_flock_Open(pathNamePtr, LE_FLOCK_WRITE) :
+                        le_flock_TryOpen(pathNamePtr, LE_FLOCK_WRITE);
+
+    if (fd < 0)
+    {
+        le_flock_Close(lockFd);
+        return fd;
+    }
+
+    char lockFilePath[PATH_MAX];
+    char tempFilePath[PATH_MAX];
+    GetFilePath(pathNamePtr, LOCK_FILE_EXTENSION, lockFilePath, sizeof(lockFilePath));
+    GetFilePath(pathNamePtr, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
+
+    if (rename(pathNamePtr, tempFilePath) == -1)
+    {
+        LE_CRIT("Failed rename '%s' to '%s' (%m).", pathNamePtr, tempFilePath);
+        le_flock_Close(fd);
+        le_flock_Close(lockFd);
+        return LE_FAULT;
+    }
+
+    DeleteFile(tempFilePath);
+
+    // There is no journal, as the file was recovered when the lockfile was locked, unless the
+    // recovery failed: don't leave it behind.
+    char journalPath[PATH_MAX];
+    GetFilePath(pathNamePtr, JOURNAL_FILE_EXTENSION, journalPath, sizeof(journalPath));
+    if (access(journalPath, F_OK) == 0)
+    {
+        DeleteFile(journalPath);
+    }
+
+    char dirPath[PATH_MAX];
+    GetDirPath(pathNamePtr, dirPath, sizeof(dirPath));
+    le_result_t result = SyncDir(dirPath);
+
+    le_flock_Close(fd);
+
+    // Note: Don't unlink the lockfile, it may lead to race condition (e.g. process B opens lockfile
+    // but can't lock as process A is on the way to delete lockfile, when process A closes lockfile
+    // descriptor, process B can lock the lockfile, now if process C checks lockfile it won't find
+    // any lockfile and can create and lock the lockfile).
+    // Size of lockfile is at most a byte, so it won't matter much.
+    le_flock_Close(lockFd);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens an existing file for atomic access operation.
+ *
+ * The file can be open for reading, writing or both as specified in the accessMode argument.
+ * Parameter accessMode specifies the lock to be applied on the file (read lock will be applied for
+ * LE_FLOCK_READ and write lock will be placed for all other cases).
+ *
+ * This is a blocking call. It will block until it can open the target file with specified
+ * accessMode.
+ *
+ * @return
+ *      A file descriptor if successful.
+ *      LE_NOT_FOUND if the file does not exist.
+ *      LE_FAULT if there was an error.
+ *
+ * @note
+ *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
+ */
+//--------------------------------------------------------------------------------------------------
+int le_atomFile_Open
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to open
+    le_flock_AccessMode_t accessMode    ///< [IN] The access mode to open the file with.
+)
+{
+
+    return Open(pathNamePtr, accessMode, true);
+
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates and opens file for atomic operation.
+ *
+ * If the file does not exist it will be created with the file permissions specified in the argument
+ * permissions (modified by the process's umask).  Refer to the POSIX function open(2) for details
+ * of mode_t:
+ *
+ * http://man7.org/linux/man-pages/man2/open.2.html
+ *
+ * The file can be opened for reading, writing or both as specified in the accessMode argument.
+ * Parameter accessMode specifies the lock to be applied on the file (read lock will be applied for
+ * LE_FLOCK_READ and write lock will be placed for all other cases).
+ *
+ * This is a blocking call. It will block until it can create and open the target file with specified
+ * parameters(i.e. accessMode, createMode, permissions).
+ *
+ * @return
+ *      A file descriptor if successful.
+ *      LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode
+ *      LE_FAULT if there was an error.
+ *
+ * @note
+ *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
+ */
+//--------------------------------------------------------------------------------------------------
+int le_atomFile_Create
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to open
+    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
+    le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
+    mode_t permissions                  ///< [IN] The file permissions used when creating the file.
+                                        ///       See the function header comments for more details.
+)
+{
+    return Create(pathNamePtr, accessMode, createMode, permissions, true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Same as @c le_atomFile_Open() except that it is non-blocking function and it will fail and return
+ * LE_WOULD_BLOCK immediately if target file has incompatible lock.
+ *
+ * @return
+ *      A file descriptor if successful.
+ *      LE_NOT_FOUND if the file does not exist.
+ *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *      LE_FAULT if there was an error.
+ *
+ * @note
+ *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
+ */
+//--------------------------------------------------------------------------------------------------
+int le_atomFile_TryOpen
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to open
+    le_flock_AccessMode_t accessMode    ///< [IN] The access mode to open the file with.
+)
+{
+    return Open(pathNamePtr, accessMode, false);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Same as @c le_atomFile_Create() except that it is non-blocking function and  it will fail and
+ * return LE_WOULD_BLOCK immediately if target file has incompatible lock.
+ *
+ * @return
+ *      A file descriptor if successful.
+ *      LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode
+ *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *      LE_FAULT if there was an error.
+ *
+ * @note
+ *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
+ */
+//--------------------------------------------------------------------------------------------------
+int le_atomFile_TryCreate
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to open
+    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
+    le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
+    mode_t permissions                  ///< [IN] The file permissions used when creating the file.
+)
+{
+    return Create(pathNamePtr, accessMode, createMode, permissions, false);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cancels all changes and closes the file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_atomFile_Cancel
+(
+    int fd                              /// [IN] The file descriptor to close.
+)
+{
+    Close(fd, false);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commits all changes and closes the file descriptor. No need to close the file descriptor again if
+ * this function returns error (i.e. file descriptor is closed in both success and error scenario).
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atomFile_Close
+(
+    int fd                              /// [IN] The file descriptor to close.
+)
+{
+    return Close(fd, true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens an existing file for atomic appends.
+ *
+ * Unlike le_atomFile_Open(), the file isn't copied: data is written directly at the end of the
+ * file (the file descriptor has O_APPEND set) and is removed again if the changes are cancelled or
+ * interrupted by a crash or power loss.  The existing contents of the file must not be changed
+ * (e.g. with ftruncate()).
+ *
+ * This is a blocking call. It will block until it can open the target file for writing.
+ *
+ * @return
+ *      A file descriptor if successful.
+ *      LE_NOT_FOUND if the file does not exist.
+ *      LE_FAULT if there was an error.
+ *
+ * @note
+ *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
+ */
+//--------------------------------------------------------------------------------------------------
+int le_atomFile_OpenAppend
+(
+    const char* pathNamePtr             ///< [IN] Path of the file to open
+)
+{
+    return OpenAppend(pathNamePtr, true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Same as @c le_atomFile_OpenAppend() except that it is non-blocking function and it will fail and
+ * return LE_WOULD_BLOCK immediately if target file has incompatible lock.
+ *
+ * @return
+ *      A file descriptor if successful.
+ *      LE_NOT_FOUND if the file does not exist.
+ *      LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *      LE_FAULT if there was an error.
+ *
+ * @note
+ *     File must be closed using le_atomFile_Close() or le_atomFile_Cancel() function.
+ */
+//--------------------------------------------------------------------------------------------------
+int le_atomFile_TryOpenAppend
+(
+    const char* pathNamePtr             ///< [IN] Path of the file to open
+)
+{
+    return OpenAppend(pathNamePtr, false);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Open a stream for atomic operation.
+ *
+ * If there was an error NULL is returned and resultPtr is set to:
+ *   - LE_NOT_FOUND if the file does not exist.
+ *   - LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *   - LE_FAULT if there was an error.
+ *
+ * @return
+ *      Buffered file stream handle to the file if successful.
+ *      NULL if there was an error.
+ **/
+//--------------------------------------------------------------------------------------------------
+static FILE* OpenStream
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to open.
+    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
+    bool blocking,                      ///< [IN] true if blocking, false if non-blocking.
+    le_result_t* resultPtr              ///< [OUT] A pointer to result code.
+)
+{
+    LE_ASSERT(pathNamePtr != NULL);
+    LE_ASSERT(pathNamePtr[0] != '\0');
+
+    // High level algorithm:
+    // if (Read-Only access requested)
+    //     1. Lock the lockfile
+    //     2. Lock the file and return the file stream
+    // else
+    //     1. Lock the lockfile
+    //     2. Lock the original file
+    //     3. Create a temp copy of the file and lock that temp copy
+    //     4. Open the temp copy and return the file stream
+
+    int lockFd = OpenLockFile(pathNamePtr, accessMode, blocking);
+
+    if (lockFd < 0)
+    {
+        if (resultPtr != NULL)
+        {
+            *resultPtr = lockFd;
+        }
+        return NULL;
+    }
+
+    if (accessMode == LE_FLOCK_READ)
+    {
+        // We need to consider blocking here as well, otherwise this api call will be blocked if
+        // file is already opened by using le_flock api.
+        FILE* file = blocking ? le_flock_OpenStream(pathNamePtr, accessMode, resultPtr) :
+                                le_flock_TryOpenStream(pathNamePtr, accessMode, resultPtr);
+
+        if (file == NULL)
+        {
+            le_flock_Close(lockFd);
+            return file;
+        }
+
+        // Store info about this file in the File Access List.
+        SaveFileData(fileno(file), lockFd, -1, pathNamePtr);
+
+        return file;
+    }
+    else
+    {
+        // We need to consider blocking here as well, otherwise this api call will be blocked if
+        // file is already opened by using le_flock api.
+        int fd = blocking ? le_flock_Open(pathNamePtr, accessMode) :
+                            le_flock_TryOpen(pathNamePtr, accessMode);
+
+        if (fd < 0)
+        {
+            if (resultPtr != NULL)
+            {
+                *resultPtr = fd;
+            }
+            le_flock_Close(lockFd);
+            return NULL;
+        }
+
+        char tempFilePath[PATH_MAX];
+        GetFilePath(pathNamePtr, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
+
+        // Now open and lock the temporary file.
+        FILE* file = CreateTempStreamFromOriginal(pathNamePtr,
+                                                  tempFilePath,
+                                                  accessMode,
+                                                  true,        // Copy the content of original file
+                                                  resultPtr);
+
+        if (file == NULL)
+        {
+            le_flock_Close(fd);
+            le_flock_Close(lockFd);
+            return NULL;
+        }
+
+        // Store info about this file in the File Access List.
+        SaveFileData(fd, lockFd, fileno(file), pathNamePtr);
+
+        return file;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a file stream for atomic operation.
+ *
+ * If there was an error NULL is returned and resultPtr is set to:
+ *  - LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode.
+ *  - LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *  - LE_FAULT if there was an error.
+ *
+ * @return
+ *      Buffered file stream handle to the file if successful.
+ *      NULL if there was an error.
+ **/
+//--------------------------------------------------------------------------------------------------
+static FILE* CreateStream
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to open.
+    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
+    le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
+    mode_t permissions,                 ///< [IN] The file permissions used when creating the file.
+    bool blocking,                      ///< [IN] true if blocking, false if non-blocking.
+    le_result_t* resultPtr              ///< [OUT] A pointer to result code
+)
+{
+    LE_ASSERT(pathNamePtr != NULL);
+    LE_ASSERT(pathNamePtr[0] != '\0');
+
+
+    // High level algorithm:
+    //
+    // if (file exists)
+    //     if (Read-Only access requested)
+    //         1. Lock the lockfile
+    //         2. Lock the file and return the file stream.
+    //     else
+    //         1. Lock the lockfile.
+    //         2. Lock the original file.
+    //         3. Create a temp copy of the file and lock that temp copy
+    //         4. Open the temp copy and return the file stream.
+    //  else
+    //     1. Lock the lockfile.
+    //     2. Create a temp copy and lock that temp copy
+    //     3. Open the temp copy and return the file stream.
+
+    char tempFilePath[PATH_MAX];
+    GetFilePath(pathNamePtr, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
+
+    int lockFd = OpenLockFile(pathNamePtr, accessMode, blocking);
+
+    if (lockFd < 0)
+    {
+        if (resultPtr != NULL)
+        {
+            *resultPtr = lockFd;
+        }
+        return NULL;
+    }
+
+    FILE* file = NULL;
+    int fd = -1;
+    bool copy;
+
+    // Check whether pathNamePtr points to an existent regular file. This one has to be done after
+    // lock is acquired to avoid race condition (e.g. process A checks existence of file abc.txt
+    // then block on locking lockfile, where as in the mean time process B rename/delete abc.txt.
+    // In this case process A has old stale information)
+    le_result_t fileExistResult = CheckIfRegFileExist(pathNamePtr);
+
+    // Something error happened, so return immediately
+    if (fileExistResult == LE_FAULT)
+    {
+        // No need to print any error message as it was done in CheckIfRegFileExist() function.
+        if (resultPtr != NULL)
+        {
+            *resultPtr = LE_FAULT;
+        }
+
+        le_flock_Close(lockFd);
+        return NULL;
+    }
+
+    if ((accessMode == LE_FLOCK_READ) && (fileExistResult == LE_OK))
+    {
+        // We need to consider blocking here as well, otherwise this api call will be
+        // blocked if file is already opened by using le_flock api
+        file = blocking ? le_flock_CreateStream(pathNamePtr,
+                                                accessMode,
+                                                createMode,
+                                                permissions,
+                                                resultPtr) :
+                          le_flock_TryCreateStream(pathNamePtr,
+                                                   accessMode,
+                                                   createMode,
+                                                   permissions,
+                                                   resultPtr);
+        if (file == NULL)
+        {
+            le_flock_Close(lockFd);
+            return file;
+        }
+
+        // Store info about this file in the File Access List.
+        SaveFileData(fileno(file), lockFd, -1, pathNamePtr);
+
+        return file;
+    }
+
+    if (fileExistResult == LE_OK)
+    {
+        switch(createMode)
+        {
+            case LE_FLOCK_OPEN_IF_EXIST:
+            case LE_FLOCK_REPLACE_IF_EXIST:
+                // We need to consider blocking here as well, otherwise this api call will be blocked if
+                // file is already opened by using le_flock api.
+                fd = blocking ? le_flock_Open(pathNamePtr, accessMode) :
+                                le_flock_TryOpen(pathNamePtr, accessMode);
+
+                if (fd < 0)
+                {
+                    if (resultPtr != NULL)
+                    {
+                        *resultPtr = fd;
+                    }
+
+                    le_flock_Close(lockFd);
+                    return NULL;
+                }
+
+                copy = (createMode == LE_FLOCK_OPEN_IF_EXIST);   // Copy if LE_FLOCK_OPEN_IF_EXIST
+                                                                 // specified.
+                // Now open and lock the temporary file.
+                file = CreateTempStreamFromOriginal(pathNamePtr,
+                                                    tempFilePath,
+                                                    accessMode,
+                                                    copy,
+                                                    resultPtr);
+                break;
+
+            case LE_FLOCK_FAIL_IF_EXIST:
+
+                if (resultPtr != NULL)
+                {
+                    *resultPtr = LE_DUPLICATE;
+                }
+                le_flock_Close(lockFd);
+
+                return NULL;
+        }
+    }
+    else          // File doesn't exist
+    {
+        fd = -1;
+        // Unlink the temp file, this is needed to avoid a bug (old temp file exists and creation
+        // of new file requested with different permission mode. In this case, new permission mode
+        // will be discarded)
+        unlink(tempFilePath);
+
+        // No need to use TryCreate as it is a temp file and we already locked the lockfile.
+        file =  le_flock_CreateStream(tempFilePath,
+                                      accessMode,
+                                      LE_FLOCK_REPLACE_IF_EXIST,
+                                      permissions,
+                                      resultPtr);
+    }
+
+    if (file == NULL)
+    {
+        if (fd > -1)
+        {
+            le_flock_Close(fd);
+        }
+        le_flock_Close(lockFd);
+        return NULL;
+    }
+
+    // Store info about this file in the File Access List.
+    SaveFileData(fd, lockFd, fileno(file), pathNamePtr);
+
+    return file;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commit or cancel all changes done on the stream.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t CloseStream
+(
+    FILE* file,               ///< [IN] File Stream to close
+    bool commit               ///< [IN] true to commit, false to cancel changes.
+)
+{
+    LE_ASSERT(file != NULL);
+
+    // High level algorithm:
+    // if (file opened with Read-Only access )
+    //     1. Close the file and release resources
+    // else
+    //     if (Commit requested)
+    //        1. Sync the temp copy
+    //        2. Sync the containing directory
+    //        3. Rename the temp copy to appropriate name
+    //        4. Close files and release resources
+    //     else   // Cancel requested
+    //        1. Delete the temp copy
+    //        2. Close files and release resources
+
+    int fd = fileno(file);
+
+    LE_ASSERT(fd > -1);
+
+    FileAccess_t* accessPtr = GetFileData(fd);
+
+    // Coding bug. Terminate immediately.
+    LE_FATAL_IF(accessPtr == NULL, "Bad file stream: %p", file);
+    LE_FATAL_IF(accessPtr->txnPtr != NULL, "File stream %p belongs to a transaction", file);
+
+    le_result_t result = LE_OK;
+
+    if ((accessPtr->tempFd < 0) &&  // Negative tempfd implies READ_ONLY access requested.
+        (accessPtr->originFd == fd))
+    {
+        le_flock_CloseStream(file);
+        le_flock_Close(accessPtr->lockFd);
+    }
+    else
+    {
+        char tempFilePath[PATH_MAX];
+        GetFilePath(accessPtr->filePath, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
+
+        if (commit)  // Commit all the necessary changes.
+        {
+            // Now flush data to OS.
+            int flushResult;
+            do
+            {
+                flushResult = fflush(file);
+            }
+            while ( (flushResult != 0) && (errno == EINTR) );
+
+            if (flushResult != 0)
+            {
+                LE_CRIT("Failed to flush file '%s' (%m).", tempFilePath);
+                result = LE_FAULT;
+            }
+
+            if (result == LE_OK)
+            {
+                //Now flush data to disk
+                result = SyncFile(accessPtr, tempFilePath);
+            }
+        }
+        else   // Discard all the changes
+        {
+            // Following function unlinks the file. Unlink is ok while file descriptor is open. File
+            // will be deleted when file descriptor will be closed.
+            result = DeleteFile(tempFilePath);
+        }
+
+        // Now close temporary and original file.
+
+        // It is ok to close stream after renaming it as it is in same filesystem.
+        le_flock_CloseStream(file);
+
+        if (accessPtr->originFd > -1)
+        {
+            le_flock_Close(accessPtr->originFd);
+        }
+
+        le_flock_Close(accessPtr->lockFd);
+    }
+
+    // Release allocated memory
+    DeleteFileData(accessPtr);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Opens an existing file via C standard library buffered file stream for atomic operation.
+ *
+ * The file can be open for reading, writing or both as specified in the accessMode argument.
+ * Parameter accessMode specifies the lock to be applied on the file (read lock will be applied for
+ * LE_FLOCK_READ and write lock will be placed for all other cases).
+ *
+ * This is a blocking call. It will block until it can open the target file with specified
+ * accessMode.
+ *
+ * If there was an error NULL is returned and resultPtr is set to:
+ *   - LE_NOT_FOUND if the file does not exist.
+ *   - LE_FAULT if there was an error.
+ *
+ * @return
+ *      Buffered file stream handle to the file if successful.
+ *      NULL if there was an error.
+ *
+ * @note
+ *     Stream must be closed using le_atomFile_CloseStream() or le_atomFile_CancelStream()
+ *     function.
+ */
+//--------------------------------------------------------------------------------------------------
+FILE* le_atomFile_OpenStream
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to open
+    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
+    le_result_t* resultPtr              ///< [OUT] A pointer to result code.
+)
+{
+    return OpenStream(pathNamePtr, accessMode, true, resultPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates and open a file via C standard library buffered file stream for atomic operation.
+ *
+ * If the file does not exist it will be created with the file permissions specified in the argument
+ * permissions (modified by the process's umask).  Refer to the POSIX function open(2) for details
+ * of mode_t:
+ *
+ * http://man7.org/linux/man-pages/man2/open.2.html
+ *
+ * The file can be opened for reading, writing or both as specified in the accessMode argument.
+ * Parameter accessMode specifies the lock to be applied on the file (read lock will be applied for
+ * LE_FLOCK_READ and write lock will be placed for all other cases).
+ *
+ * This is a blocking call. It will block until it can create and open the target file with
+ * specified parameters(i.e. accessMode, createMode, permissions).
+ *
+ * If there was an error NULL is returned and resultPtr is set to:
+ *  - LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode.
+ *  - LE_FAULT if there was an error.
+ *
+ * @return
+ *      Buffered file stream handle to the file if successful.
+ *      NULL if there was an error.
+ *
+ * @note
+ *     Stream must be closed using le_atomFile_CloseStream() or le_atomFile_CancelStream()
+ *     function.
+ */
+//--------------------------------------------------------------------------------------------------
+FILE* le_atomFile_CreateStream
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to open
+    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
+    le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
+    mode_t permissions,                 ///< [IN] The file permissions used when creating the file.
+                                        ///       See the function header comments for more details.
+    le_result_t* resultPtr              ///< [OUT] A pointer to result code.
+)
+{
+    return CreateStream(pathNamePtr, accessMode, createMode, permissions, true, resultPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Same as @c le_atomFile_OpenStream() except that it is non-blocking function and it will fail and
+ * return LE_WOULD_BLOCK immediately if target file has incompatible lock.
+ *
+ * If there was an error NULL is returned and resultPtr is set to:
+ *   - LE_NOT_FOUND if the file does not exist.
+ *   - LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *   - LE_FAULT if there was an error.
+ *
+ * @return
+ *      Buffered file stream handle to the file if successful.
+ *      NULL if there was an error.
+ *
+ * @note
+ *     Stream must be closed using le_atomFile_CloseStream() or le_atomFile_CancelStream()
+ *     function.
+ */
+//--------------------------------------------------------------------------------------------------
+FILE* le_atomFile_TryOpenStream
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to open
+    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
+    le_result_t* resultPtr              ///< [OUT] A pointer to result code.
+)
+{
+    return OpenStream(pathNamePtr, accessMode, false, resultPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Same as @c le_atomFile_CreateStream() except that it is non-blocking function and  it will fail
+ * and return LE_WOULD_BLOCK immediately if target file has incompatible lock.
+ *
+ * If there was an error NULL is returned and resultPtr is set to:
+ *  - LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode.
+ *  - LE_WOULD_BLOCK if there is already an incompatible lock on the file.
+ *  - LE_FAULT if there was an error.
+ *
+ * @return
+ *      Buffered file stream handle to the file if successful.
+ *      NULL if there was an error.
+ *
+ * @note
+ *     Stream must be closed using le_atomFile_CloseStream() or le_atomFile_CancelStream()
+ *     function.
+ */
+//--------------------------------------------------------------------------------------------------
+FILE* le_atomFile_TryCreateStream
+(
+    const char* pathNamePtr,            ///< [IN] Path of the file to open
+    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
+    le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
+    mode_t permissions,                 ///< [IN] The file permissions used when creating the file.
+    le_result_t* resultPtr              ///< [OUT] A pointer to result code.
+)
+{
+    return CreateStream(pathNamePtr, accessMode, createMode, permissions, false, resultPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cancels all changes and closes the file stream.
+ */
+//--------------------------------------------------------------------------------------------------
+void le_atomFile_CancelStream
+(
+    FILE* fileStreamPtr               ///< [IN] File stream pointer to close
+)
+{
+    CloseStream(fileStreamPtr, false);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Commits all changes and closes the file stream. No need to close the file stream again if this
+ * function returns error (i.e. file stream is closed in both success and error scenario).
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atomFile_CloseStream
+(
+    FILE* fileStreamPtr             ///< [IN] File stream pointer to close
+)
+{
+    return CloseStream(fileStreamPtr, true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Atomically deletes a file. This function also ensures safe deletion of file (i.e. if any other
+ * process/thread is using the file by acquiring file lock, it won't delete the file unless lock is
+ * released). This is a blocking call. It will block until lock on file is released.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if file doesn't exists.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atomFile_Delete
+(
+    const char* pathNamePtr            ///< [IN] Path of the file to delete
+)
+{
+    return Delete(pathNamePtr, true);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Same as @c le_atomFile_Delete() except that it is non-blocking function and it will fail and
+ * return LE_WOULD_BLOCK immediately if target file is locked.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_NOT_FOUND if file doesn't exists.
+ *      LE_WOULD_BLOCK if file is already locked (i.e. someone is using it).
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atomFile_TryDelete
+(
+    const char* pathNamePtr            ///< [IN] Path of the file to delete
+)
+{
+    return Delete(pathNamePtr, false);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a transaction, used to commit changes to several files together.
+ *
+ * @return
+ *      Reference to the transaction.
+ */
+//--------------------------------------------------------------------------------------------------
+le_atomFile_TransactionRef_t le_atomFile_CreateTransaction
+(
+    void
+)
+{
+    Transaction_t* txnPtr = le_mem_ForceAlloc(TransactionPool);
+
+    txnPtr->fileList = LE_DLS_LIST_INIT;
+    txnPtr->fileCount = 0;
+    txnPtr->dirPath[0] = '\0';
+
+    return txnPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a file to a transaction.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_BAD_PARAMETER if the file isn't in the same directory as the other files of the
+ *      transaction, or its name can't be stored in the journal.
+ *      LE_OVERFLOW if the transaction already has the maximum number of files.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t AddToTransaction
+(
+    Transaction_t* txnPtr,              ///< [IN] Transaction.
+    int fd,                             ///< [IN] File descriptor of the temporary file.
+    FILE* streamPtr                     ///< [IN] Stream of the temporary file, or NULL.
+)
+{
+    LE_ASSERT(txnPtr != NULL);
+
+    FileAccess_t* accessPtr = GetFileData(fd);
+
+    // Coding bugs. So terminate immediately.
+    LE_FATAL_IF(accessPtr == NULL, "Bad file descriptor: %d", fd);
+    LE_FATAL_IF(accessPtr->tempFd != fd,
+                "File descriptor %d was not opened by le_atomFile_Open() or le_atomFile_Create()"
+                " for writing", fd);
+    LE_FATAL_IF(accessPtr->txnPtr != NULL, "File descriptor %d already belongs to a transaction",
+                fd);
+
+    if (txnPtr->fileCount >= MAX_TRANSACTION_FILES)
+    {
+        LE_ERROR("Too many files in transaction (max %d).", MAX_TRANSACTION_FILES);
+        return LE_OVERFLOW;
+    }
+
+    if (strchr(le_path_GetBasenamePtr(accessPtr->filePath, "/"), '\n') != NULL)
+    {
+        LE_ERROR("File name '%s' can't be part of a transaction.", accessPtr->filePath);
+        return LE_BAD_PARAMETER;
+    }
+
+    // All the files must be in the same directory, as the directory is synced once for all.
+    char dirPath[PATH_MAX];
+    struct stat dirStatus;
+
+    GetDirPath(accessPtr->filePath, dirPath, sizeof(dirPath));
+
+    if (stat(dirPath, &dirStatus) != 0)
+    {
+        LE_CRIT("Error when trying to stat '%s'. (%m)", dirPath);
+        return LE_FAULT;
+    }
+
+    if (txnPtr->fileCount == 0)
+    {
+        LE_ASSERT_OK(le_utf8_Copy(txnPtr->dirPath, dirPath, sizeof(txnPtr->dirPath), NULL));
+        txnPtr->dirDev = dirStatus.st_dev;
+        txnPtr->dirIno = dirStatus.st_ino;
+    }
+    else if ((dirStatus.st_dev != txnPtr->dirDev) || (dirStatus.st_ino != txnPtr->dirIno))
+    {
+        LE_ERROR("'%s' is not in directory '%s' like the other files of the transaction.",
+                 accessPtr->filePath, txnPtr->dirPath);
+        return LE_BAD_PARAMETER;
+    }
+
+    accessPtr->txnPtr = txnPtr;
+    accessPtr->streamPtr = streamPtr;
+    le_dls_Queue(&txnPtr->fileList, &accessPtr->txnLink);
+    txnPtr->fileCount++;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a file to a transaction.  The file must have been opened for writing by le_atomFile_Open(),
+ * le_atomFile_Create() or their non-blocking counterparts, and all the files of a transaction must
+ * be in the same directory.
+ *
+ * Once added, the file must not be closed by le_atomFile_Close() or le_atomFile_Cancel(); it is
+ * closed when the transaction is committed or cancelled.
+ *
+ * @return
+ *      LE_OK if successful.
+ *      LE_BAD_PARAMETER if the file isn't in the same directory as the other files of the
+ *      transaction.
+ *      LE_OVERFLOW if the transaction already has the maximum number of files.
+ *      LE_FAULT if there was an error.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t le_atomFile_AddToTransaction
+(
+    le_atomFile_TransactionRef_t txnRef,    ///< [IN] Transaction.
+    int fd                                  ///< [IN] File descriptor of the file to add.
+)
+{
+    return AddToTransaction(txnRef, fd, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Same as @c le_atomFile_AddToTransaction() except that it works on a file stream obtained by
+ * le_atomFile_OpenStream(), le_atomFile_CreateStream() or their non-blocking counterparts.
  *
  * @return
- *      Buffered file stream handle to the file if successful.
- *      NULL if there was an error.
- *
- * @note
- *     Stream must be closed using le_atomFile_CloseStream() or le_atomFile_CancelStream()
- *     function.
+ *      LE_OK if successful.
+ *      LE_BAD_PARAMETER if the file isn't in the same directory as the other files of the
+ *      transaction.
+ *      LE_OVERFLOW if the transaction already has the maximum number of files.
+ *      LE_FAULT if there was an error.
  */
 //--------------------------------------------------------------------------------------------------
-FILE* le_atomFile_OpenStream
+le_result_t le_atomFile_AddStreamToTransaction
 (
-    const char* pathNamePtr,            ///< [IN] Path of the file to open
-    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
-    le_result_t* resultPtr              ///< [OUT] A pointer to result code.
+    le_atomFile_TransactionRef_t txnRef,    ///< [IN] Transaction.
+    FILE* fileStreamPtr                     ///< [IN] File stream of the file to add.
 )
 {
-    return OpenStream(pathNamePtr, accessMode, true, resultPtr);
+    LE_ASSERT(fileStreamPtr != NULL);
+
+    return AddToTransaction(txnRef, fileno(fileStreamPtr), fileStreamPtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Creates and open a file via C standard library buffered file stream for atomic operation.
- *
- * If the file does not exist it will be created with the file permissions specified in the argument
- * permissions (modified by the process's umask).  Refer to the POSIX function open(2) for details
- * of mode_t:
- *
- * http://man7.org/linux/man-pages/man2/open.2.html
- *
- * The file can be opened for reading, writing or both as specified in the accessMode argument.
- * Parameter accessMode specifies the lock to be applied on the file (read lock will be applied for
- * LE_FLOCK_READ and write lock will be placed for all other cases).
- *
- * This is a blocking call. It will block until it can create and open the target file with
- * specified parameters(i.e. accessMode, createMode, permissions).
- *
- * If there was an error NULL is returned and resultPtr is set to:
- *  - LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode.
- *  - LE_FAULT if there was an error.
+ * Writes the journal of a transaction next to its first file, and links it next to the others.
  *
  * @return
- *      Buffered file stream handle to the file if successful.
- *      NULL if there was an error.
- *
- * @note
- *     Stream must be closed using le_atomFile_CloseStream() or le_atomFile_CancelStream()
- *     function.
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error.
  */
 //--------------------------------------------------------------------------------------------------
-FILE* le_atomFile_CreateStream
+static le_result_t WriteTransactionJournal
 (
-    const char* pathNamePtr,            ///< [IN] Path of the file to open
-    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
-    le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
-    mode_t permissions,                 ///< [IN] The file permissions used when creating the file.
-                                        ///       See the function header comments for more details.
-    le_result_t* resultPtr              ///< [OUT] A pointer to result code.
+    Transaction_t* txnPtr               ///< [IN] Transaction.
 )
 {
-    return CreateStream(pathNamePtr, accessMode, createMode, permissions, true, resultPtr);
+    le_dls_Link_t* linkPtr = le_dls_Peek(&txnPtr->fileList);
+    FileAccess_t* accessPtr = CONTAINER_OF(linkPtr, FileAccess_t, txnLink);
+    char firstJournalPath[PATH_MAX];
+    char journalPath[PATH_MAX];
+
+    GetFilePath(accessPtr->filePath, JOURNAL_FILE_EXTENSION,
+                firstJournalPath, sizeof(firstJournalPath));
+
+    // An interrupted transaction was recovered when the file's lock was obtained, so an existing
+    // journal is only left by a recovery that failed.
+    DeleteFile(firstJournalPath);
+
+    int journalFd = open(firstJournalPath,
+                         O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+                         S_IRUSR | S_IWUSR);
+
+    if (journalFd == -1)
+    {
+        LE_CRIT("Failed to create journal '%s' (%m).", firstJournalPath);
+        return LE_FAULT;
+    }
+
+    bool ok = (dprintf(journalFd, "txn %" PRIuS "\n", txnPtr->fileCount) > 0);
+
+    for (; ok && (linkPtr != NULL); linkPtr = le_dls_PeekNext(&txnPtr->fileList, linkPtr))
+    {
+        struct stat fileStatus;
+
+        accessPtr = CONTAINER_OF(linkPtr, FileAccess_t, txnLink);
+        ok = (fstat(accessPtr->tempFd, &fileStatus) == 0) &&
+             (dprintf(journalFd, "%llu %s\n", (unsigned long long)fileStatus.st_ino,
+                      le_path_GetBasenamePtr(accessPtr->filePath, "/")) > 0);
+    }
+
+    ok = ok && (dprintf(journalFd, "end\n") > 0) && (fsync(journalFd) == 0);
+    fd_Close(journalFd);
+
+    if (!ok)
+    {
+        LE_CRIT("Failed to write journal '%s' (%m).", firstJournalPath);
+        return LE_FAULT;
+    }
+
+    // Link the journal next to the other files, so that opening any of them finds it.
+    linkPtr = le_dls_PeekNext(&txnPtr->fileList, le_dls_Peek(&txnPtr->fileList));
+
+    for (; linkPtr != NULL; linkPtr = le_dls_PeekNext(&txnPtr->fileList, linkPtr))
+    {
+        accessPtr = CONTAINER_OF(linkPtr, FileAccess_t, txnLink);
+        GetFilePath(accessPtr->filePath, JOURNAL_FILE_EXTENSION, journalPath, sizeof(journalPath));
+
+        DeleteFile(journalPath);
+
+        if (link(firstJournalPath, journalPath) != 0)
+        {
+            LE_CRIT("Failed to link '%s' to '%s' (%m).", firstJournalPath, journalPath);
+            return LE_FAULT;
+        }
+    }
+
+    return LE_OK;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Same as @c le_atomFile_OpenStream() except that it is non-blocking function and it will fail and
- * return LE_WOULD_BLOCK immediately if target file has incompatible lock.
- *
- * If there was an error NULL is returned and resultPtr is set to:
- *   - LE_NOT_FOUND if the file does not exist.
- *   - LE_WOULD_BLOCK if there is already an incompatible lock on the file.
- *   - LE_FAULT if there was an error.
- *
- * @return
- *      Buffered file stream handle to the file if successful.
- *      NULL if there was an error.
- *
- * @note
- *     Stream must be closed using le_atomFile_CloseStream() or le_atomFile_CancelStream()
- *     function.
+ * Deletes the journal links of the files of a transaction, and clears the marks of their lock
+ * files once the deletion is durable.  If the directory can't be synced, the marks are kept so
+ * that a journal that reappears after a power loss is recovered.
  */
 //--------------------------------------------------------------------------------------------------
-FILE* le_atomFile_TryOpenStream
+static void DeleteTransactionJournal
 (
-    const char* pathNamePtr,            ///< [IN] Path of the file to open
-    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
-    le_result_t* resultPtr              ///< [OUT] A pointer to result code.
+    Transaction_t* txnPtr               ///< [IN] Transaction.
 )
 {
-    return OpenStream(pathNamePtr, accessMode, false, resultPtr);
+    le_dls_Link_t* linkPtr;
+
+    for (linkPtr = le_dls_Peek(&txnPtr->fileList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&txnPtr->fileList, linkPtr))
+    {
+        FileAccess_t* accessPtr = CONTAINER_OF(linkPtr, FileAccess_t, txnLink);
+        char journalPath[PATH_MAX];
+
+        GetFilePath(accessPtr->filePath, JOURNAL_FILE_EXTENSION, journalPath, sizeof(journalPath));
+        DeleteFile(journalPath);
+    }
+
+    SimulateCrash(ATOMFILE_CRASH_TXN_JOURNAL_DELETED);
+
+    if (SyncDir(txnPtr->dirPath) != LE_OK)
+    {
+        return;
+    }
+
+    // A mark left by a crash from now on only costs opening a missing journal.
+    for (linkPtr = le_dls_Peek(&txnPtr->fileList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&txnPtr->fileList, linkPtr))
+    {
+        FileAccess_t* accessPtr = CONTAINER_OF(linkPtr, FileAccess_t, txnLink);
+
+        ClearLockRecord(accessPtr->lockFd, false);
+    }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Same as @c le_atomFile_CreateStream() except that it is non-blocking function and  it will fail
- * and return LE_WOULD_BLOCK immediately if target file has incompatible lock.
- *
- * If there was an error NULL is returned and resultPtr is set to:
- *  - LE_DUPLICATE if the file already exists and LE_FLOCK_FAIL_IF_EXIST is specified in createMode.
- *  - LE_WOULD_BLOCK if there is already an incompatible lock on the file.
- *  - LE_FAULT if there was an error.
+ * Commits the changes to all the files of a transaction.
  *
  * @return
- *      Buffered file stream handle to the file if successful.
- *      NULL if there was an error.
- *
- * @note
- *     Stream must be closed using le_atomFile_CloseStream() or le_atomFile_CancelStream()
- *     function.
+ *      LE_OK if successful.
+ *      LE_FAULT if there was an error before any file was changed.
+ *      LE_IO_ERROR if a file couldn't be renamed; the journal is kept.
  */
 //--------------------------------------------------------------------------------------------------
-FILE* le_atomFile_TryCreateStream
+static le_result_t CommitTransaction
 (
-    const char* pathNamePtr,            ///< [IN] Path of the file to open
-    le_flock_AccessMode_t accessMode,   ///< [IN] The access mode to open the file with.
-    le_flock_CreateMode_t createMode,   ///< [IN] The action to take if the file already exists.
-    mode_t permissions,                 ///< [IN] The file permissions used when creating the file.
-    le_result_t* resultPtr              ///< [OUT] A pointer to result code.
+    Transaction_t* txnPtr               ///< [IN] Transaction.
 )
 {
-    return CreateStream(pathNamePtr, accessMode, createMode, permissions, false, resultPtr);
+    // High level algorithm:
+    //     1. Sync the temp copies.
+    //     2. Mark the lock file of every file.
+    //     3. Write the journal and link it next to every file.
+    //     4. Sync the containing directory (once for all the files).
+    //     5. Rename the temp copies to the files.
+    //     6. Delete the journal, sync the directory again and clear the marks.
+    //
+    // Until step 4 completes, a crash rolls the transaction back; after it, a crash completes it
+    // (see RecoverTransaction()).  If the commit fails before step 5, the journal is deleted and
+    // the temp copies are discarded when the files are closed.
+
+    le_dls_Link_t* linkPtr;
+    char tempFilePath[PATH_MAX];
+
+    for (linkPtr = le_dls_Peek(&txnPtr->fileList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&txnPtr->fileList, linkPtr))
+    {
+        FileAccess_t* accessPtr = CONTAINER_OF(linkPtr, FileAccess_t, txnLink);
+
+        if (((accessPtr->streamPtr != NULL) && (fflush(accessPtr->streamPtr) != 0)) ||
+            (fsync(accessPtr->tempFd) == -1))
+        {
+            LE_CRIT("Failed to sync file '%s' (%m).", accessPtr->filePath);
+            return LE_FAULT;
+        }
+    }
+
+    SimulateCrash(ATOMFILE_CRASH_TXN_FILES_SYNCED);
+
+    for (linkPtr = le_dls_Peek(&txnPtr->fileList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&txnPtr->fileList, linkPtr))
+    {
+        FileAccess_t* accessPtr = CONTAINER_OF(linkPtr, FileAccess_t, txnLink);
+
+        if (WriteLockRecord(accessPtr->lockFd, "txn\n") != LE_OK)
+        {
+            DeleteTransactionJournal(txnPtr);
+            return LE_FAULT;
+        }
+    }
+
+    if (WriteTransactionJournal(txnPtr) != LE_OK)
+    {
+        DeleteTransactionJournal(txnPtr);
+        return LE_FAULT;
+    }
+
+    SimulateCrash(ATOMFILE_CRASH_TXN_JOURNAL_WRITTEN);
+
+    if (SyncDir(txnPtr->dirPath) != LE_OK)
+    {
+        DeleteTransactionJournal(txnPtr);
+        return LE_FAULT;
+    }
+
+    SimulateCrash(ATOMFILE_CRASH_TXN_DIR_SYNCED);
+
+    le_result_t result = LE_OK;
+
+    for (linkPtr = le_dls_Peek(&txnPtr->fileList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekNext(&txnPtr->fileList, linkPtr))
+    {
+        FileAccess_t* accessPtr = CONTAINER_OF(linkPtr, FileAccess_t, txnLink);
+
+        GetFilePath(accessPtr->filePath, TEMP_FILE_EXTENSION, tempFilePath, sizeof(tempFilePath));
+
+        if (rename(tempFilePath, accessPtr->filePath) != 0)
+        {
+            LE_CRIT("Failed rename '%s' to '%s' (%m).", tempFilePath, accessPtr->filePath);
+            result = LE_IO_ERROR;
+        }
+
+        SimulateCrash(ATOMFILE_CRASH_TXN_FIRST_FILE_RENAMED);
+    }
+
+    // If a rename failed, keep the journal (and the temp copies) so the transaction is completed
+    // the next time one of the files is opened.
+    if (result == LE_OK)
+    {
+        DeleteTransactionJournal(txnPtr);
+    }
+
+    return result;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Cancels all changes and closes the file stream.
+ * Closes all the files of a transaction and deletes the transaction.
  */
 //--------------------------------------------------------------------------------------------------
-void le_atomFile_CancelStream
+static void DeleteTransaction
 (
-    FILE* fileStreamPtr               ///< [IN] File stream pointer to close
+    Transaction_t* txnPtr,              ///< [IN] Transaction.
+    bool deleteTempFiles                ///< [IN] true to delete the temporary files.
 )
 {
-    CloseStream(fileStreamPtr, false);
+    le_dls_Link_t* linkPtr;
+
+    while ((linkPtr = le_dls_Pop(&txnPtr->fileList)) != NULL)
+    {
+        FileAccess_t* accessPtr = CONTAINER_OF(linkPtr, FileAccess_t, txnLink);
+
+        if (deleteTempFiles)
+        {
+            char tempFilePath[PATH_MAX];
+
+            GetFilePath(accessPtr->filePath, TEMP_FILE_EXTENSION,
+                        tempFilePath, sizeof(tempFilePath));
+            DeleteFile(tempFilePath);
+        }
+
+        if (accessPtr->streamPtr != NULL)
+        {
+            le_flock_CloseStream(accessPtr->streamPtr);
+        }
+        else
+        {
+            le_flock_Close(accessPtr->tempFd);
+        }
+
+        if (accessPtr->originFd > -1)
+        {
+            le_flock_Close(accessPtr->originFd);
+        }
+
+        le_flock_Close(accessPtr->lockFd);
+
+        DeleteFileData(accessPtr);
+    }
+
+    le_mem_Release(txnPtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Commits all changes and closes the file stream. No need to close the file stream again if this
- * function returns error (i.e. file stream is closed in both success and error scenario).
+ * Commits the changes to all the files of a transaction, closes them and deletes the transaction.
+ * Either all the files are changed, or none are, even if the commit is interrupted by a crash or a
+ * power loss.  The files are closed and the transaction deleted in both success and error
+ * scenario.
  *
  * @return
  *      LE_OK if successful.
- *      LE_FAULT if there was an error
+ *      LE_FAULT if there was an error.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t le_atomFile_CloseStream
+le_result_t le_atomFile_CommitTransaction
 (
-    FILE* fileStreamPtr             ///< [IN] File stream pointer to close
+    le_atomFile_TransactionRef_t txnRef     ///< [IN] Transaction to commit.
 )
 {
-    return CloseStream(fileStreamPtr, true);
+    LE_ASSERT(txnRef != NULL);
+
+    le_result_t result = LE_OK;
+
+    if (txnRef->fileCount > 0)
+    {
+        result = CommitTransaction(txnRef);
+    }
+
+    DeleteTransaction(txnRef, (result == LE_FAULT));
+
+    return (result == LE_OK ? LE_OK : LE_FAULT);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Atomically deletes a file. This function also ensures safe deletion of file (i.e. if any other
- * process/thread is using the file by acquiring file lock, it won't delete the file unless lock is
- * released). This is a blocking call. It will block until lock on file is released.
- *
- * @return
- *      LE_OK if successful.
- *      LE_NOT_FOUND if file doesn't exists.
- *      LE_FAULT if there was an error.
+ * Cancels the changes to all the files of a transaction, closes them and deletes the transaction.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t le_atomFile_Delete
+void le_atomFile_CancelTransaction
 (
-    const char* pathNamePtr            ///< [IN] Path of the file to delete
+    le_atomFile_TransactionRef_t txnRef     ///< [IN] Transaction to cancel.
 )
 {
-    return Delete(pathNamePtr, true);
+    LE_ASSERT(txnRef != NULL);
+
+    DeleteTransaction(txnRef, true);
 }
 
 
+#if LE_CONFIG_ATOM_FILE_CRASH_POINTS
 //--------------------------------------------------------------------------------------------------
 /**
- * Same as @c le_atomFile_Delete() except that it is non-blocking function and it will fail and
- * return LE_WOULD_BLOCK immediately if target file is locked.
- *
- * @return
- *      LE_OK if successful.
- *      LE_NOT_FOUND if file doesn't exists.
- *      LE_WOULD_BLOCK if file is already locked (i.e. someone is using it).
- *      LE_FAULT if there was an error.
+ * Sets the point at which the next append or transaction commit simulates a crash, by terminating
+ * the process immediately.  Only meant for testing.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t le_atomFile_TryDelete
+void atomFile_SetCrashPoint
 (
-    const char* pathNamePtr            ///< [IN] Path of the file to delete
+    atomFile_CrashPoint_t point         ///< [IN] Crash point, or ATOMFILE_CRASH_NONE.
 )
 {
-    return Delete(pathNamePtr, false);
+    CrashPoint = point;
 }
+#endif
 
 
 //--------------------------------------------------------------------------------------------------
@@ -1760,4 +3157,6 @@ void atomFile_Init
     // Initialize pools
     FileAccessPool = le_mem_CreatePool("AtomicFileAccessPool",
                                         sizeof(FileAccess_t));
+    TransactionPool = le_mem_CreatePool("AtomicFileTransactionPool",
+                                        sizeof(Transaction_t));
 }
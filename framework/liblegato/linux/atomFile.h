@@ -28,4 +28,41 @@ void atomFile_Init
 );
 
 
+#if LE_CONFIG_ATOM_FILE_CRASH_POINTS
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Points in an atomic append or transaction commit at which a crash can be simulated by
+ * atomFile_SetCrashPoint(), for testing recovery.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    ATOMFILE_CRASH_NONE,                    ///< No simulated crash.
+    ATOMFILE_CRASH_APPEND_RECORD_WRITTEN,   ///< Append: size recorded, nothing appended yet.
+    ATOMFILE_CRASH_APPEND_FILE_SYNCED,      ///< Append: data synced, record not cleared yet.
+    ATOMFILE_CRASH_TXN_FILES_SYNCED,        ///< Transaction: temp copies synced, no journal yet.
+    ATOMFILE_CRASH_TXN_JOURNAL_WRITTEN,     ///< Transaction: files marked, journal linked.
+    ATOMFILE_CRASH_TXN_DIR_SYNCED,          ///< Transaction: directory synced, nothing renamed.
+    ATOMFILE_CRASH_TXN_FIRST_FILE_RENAMED,  ///< Transaction: only the first file renamed.
+    ATOMFILE_CRASH_TXN_JOURNAL_DELETED      ///< Transaction: journal deleted, marks left.
+}
+atomFile_CrashPoint_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sets the point at which the next append or transaction commit simulates a crash, by terminating
+ * the process immediately.  Only available if the framework is built with
+ * LE_CONFIG_ATOM_FILE_CRASH_POINTS, for testing.
+ */
+//--------------------------------------------------------------------------------------------------
+void atomFile_SetCrashPoint
+(
+    atomFile_CrashPoint_t point         ///< [IN] Crash point, or ATOMFILE_CRASH_NONE.
+);
+
+#endif // LE_CONFIG_ATOM_FILE_CRASH_POINTS
+
+
 #endif  // LEGATO_SRC_ATOM_FILE_INCLUDE_GUARD
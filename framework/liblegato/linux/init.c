@@ -22,6 +22,7 @@
 #include "rand.h"
 #include "safeRef.h"
 #include "signals.h"
+#include "statsPage.h"
 #include "test.h"
 #include "thread.h"
 #include "timer.h"
@@ -56,6 +57,9 @@ __attribute__((constructor)) void _legato_InitFramework
                         // available for other modules' initialization.
     mem_Init();         // Many things rely on memory pools, so initialize them as soon as possible.
     log_Init();         // Uses memory pools.
+#if LE_CONFIG_STATS_PAGE
+    statsPage_Init();   // Uses memory pools and logging.
+#endif
     sig_Init();         // Uses memory pools.
     safeRef_Init();     // Uses memory pools and hash maps.
     pathIter_Init();    // Uses memory pools and safe references.
@@ -114,6 +114,25 @@ static le_log_TraceRef_t TraceRef;
 #define TRACE(...) LE_TRACE(TraceRef, ##__VA_ARGS__)
 
 
+#if LE_CONFIG_LOG_STORE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Datagram socket connected to the log store of the Log Control Daemon, or -1 if messages are not
+ * stored.
+ **/
+//--------------------------------------------------------------------------------------------------
+static int StoreFd = -1;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Least severe level of the messages sent to the log store.
+ **/
+//--------------------------------------------------------------------------------------------------
+static le_log_Level_t StoreLevel = LE_LOG_EMERG;
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * POSIX threads "Fast" mutex used to protect structures in this module from multi-threaded
@@ -755,6 +774,97 @@ static bool ParseCmdPacket
 }
 
 
+#if LE_CONFIG_LOG_STORE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Connects to the log store, so that messages at least as severe as a given level are stored.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ConnectToLogStore
+(
+    const char* levelStr        ///< [IN] Least severe level of the messages to store.
+)
+{
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    int level = log_StrToSeverityLevel(levelStr);
+
+    if (level == -1)
+    {
+        LE_ERROR("Invalid log store level '%s'.", levelStr);
+        return;
+    }
+
+    Lock();
+
+    StoreLevel = level;
+
+    if (StoreFd < 0)
+    {
+        // Non-blocking, so that a busy Log Control Daemon drops messages rather than stalls us.
+        StoreFd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+
+        LE_ASSERT(le_utf8_Copy(addr.sun_path, LOG_STORE_SOCKET_PATH, sizeof(addr.sun_path),
+                               NULL) == LE_OK);
+
+        if (StoreFd < 0)
+        {
+            LE_WARN("Failed to create the log store socket: %m.");
+        }
+        else if (connect(StoreFd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+        {
+            LE_WARN("Failed to connect to the log store: %m.");
+            close(StoreFd);
+            StoreFd = -1;
+        }
+    }
+
+    Unlock();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends a message to the log store.  The message is dropped if the socket is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SendToLogStore
+(
+    le_log_Level_t level,       ///< [IN] Severity level.
+    const char* compNamePtr,    ///< [IN] Component name.
+    const char* msgPtr          ///< [IN] Message.
+)
+{
+    uint64_t buffer[LOG_STORE_MAX_DGRAM_BYTES / sizeof(uint64_t)];
+    LogStoreMsgHeader_t* headerPtr = (LogStoreMsgHeader_t*)buffer;
+    char* strPtr = (char*)(headerPtr + 1);
+    size_t size = sizeof(buffer) - sizeof(*headerPtr);
+    le_clk_Time_t now = le_clk_GetAbsoluteTime();
+    int savedErrno = errno;
+    int len;
+
+    memset(headerPtr, 0, sizeof(*headerPtr));
+    headerPtr->timeUs = (uint64_t)now.sec * 1000000 + now.usec;
+    headerPtr->level = level;
+
+    len = snprintf(strPtr, size, "%s%c%s", compNamePtr, '\0', msgPtr);
+    if ((len < 0) || ((size_t)len >= size))
+    {
+        len = size - 1;
+    }
+
+    // Hold the mutex so the socket can't be closed under us.  The send doesn't block.
+    Lock();
+    if (StoreFd >= 0)
+    {
+        (void)send(StoreFd, buffer, sizeof(*headerPtr) + len + 1, MSG_DONTWAIT | MSG_NOSIGNAL);
+    }
+    Unlock();
+
+    errno = savedErrno;
+}
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Processes a remote logging command.  This function should be called by the event loop when there
@@ -798,6 +908,12 @@ static void ProcessLogCmd
                 DisableTrace(componentName, commandDataPtr);
                 break;
 
+#if LE_CONFIG_LOG_STORE
+            case LOG_CMD_SET_STORE_LEVEL:
+                ConnectToLogStore(commandDataPtr);
+                break;
+#endif
+
             default:
                 LE_ERROR("Invalid command character '%c'.", command);
                 break;
@@ -1022,6 +1138,17 @@ void log_DisconnectFromControlDaemon
         }
         le_msg_DeleteSession(IpcSessionRef);
         IpcSessionRef = NULL;
+
+#if LE_CONFIG_LOG_STORE
+        // The store socket is reconnected when the Log Control Daemon sends the store level again.
+        Lock();
+        if (StoreFd >= 0)
+        {
+            close(StoreFd);
+            StoreFd = -1;
+        }
+        Unlock();
+#endif
 }
 
 /// Expose old symbol name to support apps compiled against an older liblegato.
@@ -1196,6 +1323,13 @@ void fa_log_Send
     // it.  If there was a truncation then that'll just show up in the logs.
     vsnprintf(msg, sizeof(msg), formatPtr, args);
 
+#if LE_CONFIG_LOG_STORE
+    if ((StoreFd >= 0) && (level != (le_log_Level_t)-1) && (level >= StoreLevel))
+    {
+        SendToLogStore(level, compNamePtr, msg);
+    }
+#endif
+
     // If running on an embedded target, write the message out to the log.
 #ifdef LEGATO_EMBEDDED
 
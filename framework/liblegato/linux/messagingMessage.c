@@ -106,6 +106,41 @@ static void MessageDestructor
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the file descriptor to be sent with a message.
+ *
+ * For a response, this is the fd set by the server for the response.  The fd kept in the message
+ * is left where it is, so that the message can be sent again if the socket was full.
+ *
+ * @return The fd to send, or -1 if none.
+ */
+//--------------------------------------------------------------------------------------------------
+static int GetFdToSend
+(
+    UnixMessage_t* msgPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // If this is a response message,
+    if (le_msg_NeedsResponse(&msgPtr->message))
+    {
+        // If there was an fd that was received from the client but not fetched from the message
+        // generate a warning and close that fd.
+        if (msgPtr->fd >= 0)
+        {
+            LE_WARN("File descriptor not retrieved from message received from client.");
+            fd_Close(msgPtr->fd);
+            msgPtr->fd = -1;
+        }
+
+        return msgPtr->clientServer.server.responseFd;
+    }
+
+    return msgPtr->fd;
+}
+
+
 // =======================================
 //  PROTECTED (INTER-MODULE) FUNCTIONS
 // =======================================
@@ -183,33 +218,59 @@ le_result_t msgMessage_Send
 {
     UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRef);
 
-    // If this is a response message,
-    if (le_msg_NeedsResponse(msgRef))
-    {
-        // If there was an fd that was received from the client but not fetched from the message
-        // generate a warning and close that fd.
-        if (msgPtr->fd >= 0)
-        {
-            LE_WARN("File descriptor not retrieved from message received from client.");
-            fd_Close(msgPtr->fd);
-        }
-
-        // Move the responseFd to the normal fd position in the message object.
-        msgPtr->fd = msgPtr->clientServer.server.responseFd;
-        msgPtr->clientServer.server.responseFd = -1;
-    }
-
     // The first bytes come from our transaction ID and the rest (if any)
     // from our Message object's payload section, which comes right after the transaction ID.
     return unixSocket_SendMsg(  socketFd,
                                 &msgPtr->txnId,
                                 sizeof(msgPtr->txnId) +
                                 le_msg_GetMaxPayloadSize(msgMessage_GetMessageRef(msgPtr)),
-                                msgPtr->fd,
+                                GetFdToSend(msgPtr),
                                 false   ); // Don't send process credentials.
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send several messages over a connected socket in one system call.
+ *
+ * Messages are sent in order.  Sending stops at the first message that can't be sent; it and the
+ * ones after it are left untouched and can be sent again later.
+ *
+ * @return
+ * - LE_OK if at least one message was sent.
+ * - LE_NO_MEMORY if the socket doesn't have enough send buffer space available right now.
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_SendBatch
+(
+    int                  socketFd,      ///< [IN] Connected socket's file descriptor.
+    le_msg_MessageRef_t* msgRefArray,   ///< [IN] Messages to be sent.
+    size_t               msgCount,      ///< [IN] Number of messages (at most
+                                        ///       UNIXSOCKET_MAX_BATCH_SIZE).
+    size_t*              sentCountPtr   ///< [OUT] Number of messages sent.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    unixSocket_BatchMsg_t batch[UNIXSOCKET_MAX_BATCH_SIZE];
+    size_t i;
+
+    LE_ASSERT(msgCount <= UNIXSOCKET_MAX_BATCH_SIZE);
+
+    for (i = 0; i < msgCount; i++)
+    {
+        UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRefArray[i]);
+
+        batch[i].dataPtr = &msgPtr->txnId;
+        batch[i].dataSize = sizeof(msgPtr->txnId) + le_msg_GetMaxPayloadSize(msgRefArray[i]);
+        batch[i].fd = GetFdToSend(msgPtr);
+    }
+
+    return unixSocket_SendMsgBatch(socketFd, batch, msgCount, sentCountPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Receive a single message from a connected socket.
@@ -247,6 +308,75 @@ le_result_t msgMessage_Receive
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive the messages waiting on a connected socket, up to a given number, in one system call.
+ *
+ * Messages that were received but were too big or whose file descriptor couldn't be received are
+ * released and their entries in the array set to NULL.  They still count as received.  The
+ * messages that were not received are left untouched for the caller to release or reuse.
+ *
+ * Fewer messages than asked for are received when no more are waiting.
+ *
+ * @return
+ * - LE_OK if at least one message was received.
+ * - LE_WOULD_BLOCK if there's nothing there to receive and the socket is set non-blocking.
+ * - LE_CLOSED if the connection has closed.
+ * - LE_FAULT if an error was encountered.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_ReceiveBatch
+(
+    int                  socketFd,          ///< [IN] The socket's file descriptor.
+    le_msg_MessageRef_t* msgRefArray,       ///< [IN+OUT] Message objects to store the received
+                                            ///           messages in.
+    size_t               msgCount,          ///< [IN] Number of message objects (at most
+                                            ///       UNIXSOCKET_MAX_BATCH_SIZE).
+    size_t*              receivedCountPtr   ///< [OUT] Number of messages received.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    unixSocket_BatchMsg_t batch[UNIXSOCKET_MAX_BATCH_SIZE];
+    size_t i;
+
+    LE_ASSERT(msgCount <= UNIXSOCKET_MAX_BATCH_SIZE);
+
+    // Receive the first bytes of each message into its transaction ID and the rest (if any)
+    // into its payload section.
+    for (i = 0; i < msgCount; i++)
+    {
+        UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRefArray[i]);
+
+        batch[i].dataPtr = &msgPtr->txnId;
+        batch[i].dataSize = sizeof(msgPtr->txnId) + le_msg_GetMaxPayloadSize(msgRefArray[i]);
+    }
+
+    le_result_t result = unixSocket_ReceiveMsgBatch(socketFd, batch, msgCount, receivedCountPtr);
+
+    for (i = 0; i < *receivedCountPtr; i++)
+    {
+        UnixMessage_t* msgPtr = msgMessage_GetUnixMessagePtr(msgRefArray[i]);
+
+        msgPtr->fd = batch[i].fd;
+        if (msgSession_GetInterfaceType(msgRefArray[i]->sessionRef) == LE_MSG_INTERFACE_SERVER)
+        {
+            msgPtr->clientServer.server.responseFd = -1;
+        }
+
+        if (batch[i].result != LE_OK)
+        {
+            LE_ERROR("Discarding message received on fd %d (%s).",
+                     socketFd,
+                     LE_RESULT_TXT(batch[i].result));
+            le_msg_ReleaseMsg(msgRefArray[i]);
+            msgRefArray[i] = NULL;
+        }
+    }
+
+    return result;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sets a Message object's transaction ID.
@@ -306,6 +436,56 @@ void msgMessage_CallCompletionCallback
 }
 
 
+#if LE_CONFIG_IPC_LATENCY_HISTOGRAM
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the current relative time, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t GetNowUs
+(
+    void
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    return (uint64_t)now.sec * 1000000 + now.usec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Marks the start of the transaction a Message object is part of.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_SetStartTime
+(
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    msgMessage_GetUnixMessagePtr(msgRef)->startTimeUs = GetNowUs();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the time elapsed since msgMessage_SetStartTime() was called on a Message object.
+ *
+ * @return The elapsed time, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t msgMessage_GetElapsedUs
+(
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetNowUs() - msgMessage_GetUnixMessagePtr(msgRef)->startTimeUs;
+}
+#endif
+
+
 // =======================================
 //  PUBLIC API FUNCTIONS
 // =======================================
@@ -366,6 +546,9 @@ le_msg_MessageRef_t le_msg_CreateMsg
 
     msgPtr->fd = -1;
     msgPtr->txnId = 0;
+#if LE_CONFIG_IPC_LATENCY_HISTOGRAM
+    msgPtr->startTimeUs = 0;
+#endif
     memset(msgPtr->payload, 0, le_msg_GetProtocolMaxMsgSize(protocolRef));
 
     return msgMessage_GetMessageRef(msgPtr);
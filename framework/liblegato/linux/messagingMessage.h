@@ -40,6 +40,10 @@ typedef struct le_msg_UnixMessage
     }
     clientServer;
 
+#if LE_CONFIG_IPC_LATENCY_HISTOGRAM
+    uint64_t                    startTimeUs; ///< When the transaction started, for the session's
+                                             ///  latency histogram (relative clock, in us).
+#endif
     int                         fd;         ///< File descriptor to send or received (-1 = no fd)
     void*                       txnId;      ///< Safe reference value used as a transaction ID.
     void*                       payload[0]; ///< Variable-length payload buffer appears at the end.
@@ -108,6 +112,50 @@ le_result_t msgMessage_Receive
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Send several messages over a connected socket in one system call.
+ *
+ * Sending stops at the first message that can't be sent; it and the ones after it are left
+ * untouched.
+ *
+ * @return
+ * - LE_OK if at least one message was sent.
+ * - LE_NO_MEMORY if the socket doesn't have enough send buffer space available right now.
+ * - LE_COMM_ERROR if the socket reported an error on the send operation.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_SendBatch
+(
+    int                  socketFd,      ///< [IN] Connected socket's file descriptor.
+    le_msg_MessageRef_t* msgRefArray,   ///< [IN] Messages to be sent.
+    size_t               msgCount,      ///< [IN] Number of messages.
+    size_t*              sentCountPtr   ///< [OUT] Number of messages sent.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receive the messages waiting on a connected socket, up to a given number, in one system call.
+ *
+ * Bad messages are released and their entries set to NULL.
+ *
+ * @return
+ * - LE_OK if at least one message was received.
+ * - LE_WOULD_BLOCK if there's nothing there to receive and the socket is set non-blocking.
+ * - LE_CLOSED if the connection has closed.
+ * - LE_COMM_ERROR if an error was encountered.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t msgMessage_ReceiveBatch
+(
+    int                  socketFd,          ///< [IN] The socket's file descriptor.
+    le_msg_MessageRef_t* msgRefArray,       ///< [IN+OUT] Message objects to receive into.
+    size_t               msgCount,          ///< [IN] Number of message objects.
+    size_t*              receivedCountPtr   ///< [OUT] Number of messages received.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Gets a pointer to the queue link inside a Message object.
@@ -192,4 +240,30 @@ void msgMessage_CallCompletionCallback
 );
 
 
+#if LE_CONFIG_IPC_LATENCY_HISTOGRAM
+//--------------------------------------------------------------------------------------------------
+/**
+ * Marks the start of the transaction a Message object is part of.
+ */
+//--------------------------------------------------------------------------------------------------
+void msgMessage_SetStartTime
+(
+    le_msg_MessageRef_t msgRef
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the time elapsed since msgMessage_SetStartTime() was called on a Message object.
+ *
+ * @return The elapsed time, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t msgMessage_GetElapsedUs
+(
+    le_msg_MessageRef_t msgRef
+);
+#endif
+
+
 #endif // LEGATO_MESSAGING_MESSAGE_H_INCLUDE_GUARD
@@ -93,6 +93,29 @@ static le_msg_SessionRef_t msgSession_GetSessionRef(msgSession_UnixSession_t *un
 static void AttemptOpen(msgSession_UnixSession_t* sessionPtr);
 
 
+#if LE_CONFIG_IPC_LATENCY_HISTOGRAM
+//--------------------------------------------------------------------------------------------------
+/**
+ * Records the latency of a finished transaction in the session's latency histogram.
+ *
+ * On the client side, the request message's start time is when the request was sent.  On the
+ * server side, it is when the request was received, and the message is reused for the response.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RecordLatency
+(
+    msgSession_UnixSession_t* sessionPtr,
+    le_msg_MessageRef_t msgRef          ///< [in] Request message of the transaction.
+)
+{
+    statsPage_RecordLatency(sessionPtr->statsSlotPtr, msgMessage_GetElapsedUs(msgRef));
+}
+#else
+#define RecordLatency(sessionPtr, msgRef)
+#define msgMessage_SetStartTime(msgRef)
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Pushes a message onto the tail of the Transmit Queue.
@@ -111,6 +134,7 @@ static void PushTransmitQueue
 
     LOCK
     le_dls_Queue(&sessionPtr->transmitQueue, linkPtr);
+    STATSPAGE_ADD_MAX(sessionPtr->statsSlotPtr, txQueueDepth, maxTxQueueDepth, 1);
     UNLOCK
 }
 
@@ -139,6 +163,7 @@ static le_msg_MessageRef_t PopTransmitQueue
 
     if (linkPtr != NULL)
     {
+        STATSPAGE_ADD(sessionPtr->statsSlotPtr, txQueueDepth, -1);
         return msgMessage_GetMessageContainingLink(linkPtr);
     }
 
@@ -165,6 +190,8 @@ static void UnPopTransmitQueue
     LOCK
     le_dls_Stack(&sessionPtr->transmitQueue, linkPtr);
     UNLOCK
+
+    STATSPAGE_ADD(sessionPtr->statsSlotPtr, txQueueDepth, 1);
 }
 
 
@@ -181,6 +208,7 @@ static inline void PushReceiveQueue
 //--------------------------------------------------------------------------------------------------
 {
     le_dls_Queue(&sessionPtr->receiveQueue, msgMessage_GetQueueLinkPtr(msgRef));
+    STATSPAGE_ADD(sessionPtr->statsSlotPtr, rxQueueDepth, 1);
 }
 
 
@@ -204,6 +232,7 @@ static le_msg_MessageRef_t PopReceiveQueue
 
     if (linkPtr != NULL)
     {
+        STATSPAGE_ADD(sessionPtr->statsSlotPtr, rxQueueDepth, -1);
         return msgMessage_GetMessageContainingLink(linkPtr);
     }
 
@@ -295,6 +324,8 @@ static void AddToTxnList
     le_dls_Queue(&sessionPtr->txnList, msgMessage_GetQueueLinkPtr(msgRef));
 
     UNLOCK
+
+    STATSPAGE_ADD(sessionPtr->statsSlotPtr, pendingTxns, 1);
 }
 
 
@@ -315,6 +346,8 @@ static void RemoveFromTxnList
     le_dls_Remove(&sessionPtr->txnList, msgMessage_GetQueueLinkPtr(msgRef));
 
     UNLOCK
+
+    STATSPAGE_ADD(sessionPtr->statsSlotPtr, pendingTxns, -1);
 }
 
 
@@ -345,6 +378,8 @@ static void PurgeTxnList
             break;
         }
 
+        STATSPAGE_ADD(sessionPtr->statsSlotPtr, pendingTxns, -1);
+
         le_msg_MessageRef_t msgRef = msgMessage_GetMessageContainingLink(linkPtr);
 
         DeleteTxnId(msgRef);
@@ -452,9 +487,18 @@ static msgSession_UnixSession_t* CreateSession
     sessionPtr->openContextPtr = NULL;
     sessionPtr->closeHandler = NULL;
     sessionPtr->closeContextPtr = NULL;
+    sessionPtr->rxBatchSize = 1;
 
     sessionPtr->interfaceRef = interfaceRef;
 
+#if LE_CONFIG_STATS_PAGE
+    sessionPtr->statsSlotPtr = statsPage_AllocSlot(STATSPAGE_TABLE_SESSION,
+                                                   le_msg_GetInterfaceName(interfaceRef));
+    STATSPAGE_SET(sessionPtr->statsSlotPtr,
+                  isServer,
+                  (interfaceRef->interfaceType == LE_MSG_INTERFACE_SERVER));
+#endif
+
     SessionObjListChangeCount++;
     msgInterface_AddSession(interfaceRef, msgSession_GetSessionRef(sessionPtr));
 
@@ -476,6 +520,7 @@ static void CloseSession
 //--------------------------------------------------------------------------------------------------
 {
     sessionPtr->state = LE_MSG_SESSION_STATE_CLOSED;
+    STATSPAGE_SET(sessionPtr->statsSlotPtr, isOpen, 0);
 
     // Always notify the server on close.
     if (sessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_SERVER)
@@ -534,6 +579,10 @@ static void DeleteSession
                                msgSession_GetSessionRef(sessionPtr),
                                mutexLocked);
 
+#if LE_CONFIG_STATS_PAGE
+    statsPage_FreeSlot(sessionPtr->statsSlotPtr);
+#endif
+
     // Release the Session object itself.
     le_mem_Release(sessionPtr);
 }
@@ -774,6 +823,8 @@ static void ProcessMessageFromServer
         // Remove the request message from the session's Transaction List.
         RemoveFromTxnList(sessionPtr, requestMsgRef);
 
+        RecordLatency(sessionPtr, requestMsgRef);
+
         // Call the completion callback function from the request message.
         msgMessage_CallCompletionCallback(requestMsgRef, msgRef);
 
@@ -812,6 +863,8 @@ static void ProcessReceivedMessages
 
     while (NULL != (linkPtr = le_dls_Pop(&sessionPtr->receiveQueue)))
     {
+        STATSPAGE_ADD(sessionPtr->statsSlotPtr, rxQueueDepth, -1);
+
         le_msg_MessageRef_t msgRef = msgMessage_GetMessageContainingLink(linkPtr);
 
         if (sessionPtr->interfaceRef->interfaceType == LE_MSG_INTERFACE_CLIENT)
@@ -926,33 +979,95 @@ static void ClientSocketError
 //--------------------------------------------------------------------------------------------------
 /**
  * Receive messages from the socket and put them on the Receive Queue.
+ *
+ * Messages are received in batches.  The first batch is sized from the number of messages
+ * received last time, and the batch size doubles while batches come back full.  At most
+ * LE_CONFIG_IPC_SESSION_BURST_LIMIT messages are received, unless the socket has to be drained
+ * because the connection is closing; the rest are received on the next pass of the event loop.
  */
 //--------------------------------------------------------------------------------------------------
 static void ReceiveMessages
 (
-    msgSession_UnixSession_t* sessionPtr
+    msgSession_UnixSession_t* sessionPtr,
+    bool isDrainNeeded      ///< true = receive everything, ignoring the burst limit.
 )
 //--------------------------------------------------------------------------------------------------
 {
+    le_msg_MessageRef_t msgRefs[LE_CONFIG_IPC_BATCH_SIZE];
+    size_t batchSize = sessionPtr->rxBatchSize;
+    size_t totalCount = 0;
+    size_t i;
+
     for (;;)
     {
-        // Create a Message object.
-        le_msg_MessageRef_t msgRef = le_msg_CreateMsg(msgSession_GetSessionRef(sessionPtr));
+        size_t receivedCount = 0;
 
-        // Receive from the socket into the Message object.
-        le_result_t result = msgMessage_Receive(sessionPtr->socketFd, msgRef);
+        if ((!isDrainNeeded) && (batchSize > LE_CONFIG_IPC_SESSION_BURST_LIMIT - totalCount))
+        {
+            batchSize = LE_CONFIG_IPC_SESSION_BURST_LIMIT - totalCount;
+        }
 
-        if (result == LE_OK)
+        // Create the Message objects.
+        for (i = 0; i < batchSize; i++)
         {
-            // Received something.  Push it onto the Receive Queue for later processing.
-            PushReceiveQueue(sessionPtr, msgRef);
+            msgRefs[i] = le_msg_CreateMsg(msgSession_GetSessionRef(sessionPtr));
         }
-        else
+
+        // Receive from the socket into the Message objects.
+        le_result_t result = msgMessage_ReceiveBatch(sessionPtr->socketFd,
+                                                     msgRefs,
+                                                     batchSize,
+                                                     &receivedCount);
+
+        for (i = 0; i < receivedCount; i++)
+        {
+            // Messages that could not be received properly have already been released.
+            if (msgRefs[i] != NULL)
+            {
+                STATSPAGE_INC(sessionPtr->statsSlotPtr, msgsReceived);
+                msgMessage_SetStartTime(msgRefs[i]);
+
+                // Push it onto the Receive Queue for later processing.
+                PushReceiveQueue(sessionPtr, msgRefs[i]);
+            }
+        }
+
+        // Release the Message objects that weren't needed.
+        for (i = receivedCount; i < batchSize; i++)
+        {
+            le_msg_ReleaseMsg(msgRefs[i]);
+        }
+
+        totalCount += receivedCount;
+
+        // A short batch means there is nothing left to receive from the socket.  We are done.
+        if ((result != LE_OK) || (receivedCount < batchSize))
         {
-            // Nothing left to receive from the socket.  We are done.
-            le_msg_ReleaseMsg(msgRef);
             break;
         }
+
+        // Leave the rest for later if this session has had its share of this pass.
+        if ((!isDrainNeeded) && (totalCount >= LE_CONFIG_IPC_SESSION_BURST_LIMIT))
+        {
+            break;
+        }
+
+        batchSize *= 2;
+        if (batchSize > LE_CONFIG_IPC_BATCH_SIZE)
+        {
+            batchSize = LE_CONFIG_IPC_BATCH_SIZE;
+        }
+    }
+
+    // Expect about as many messages next time.  Asking for one more than that lets a short batch
+    // tell us the socket is empty without another system call.
+    if (totalCount < LE_CONFIG_IPC_BATCH_SIZE)
+    {
+        sessionPtr->rxBatchSize = totalCount + 1;
+    }
+    else
+    {
+        sessionPtr->rxBatchSize = LE_CONFIG_IPC_BATCH_SIZE;
     }
 }
 
@@ -1003,10 +1118,63 @@ static void ServerSocketError
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finish with a message that has been sent from a session's Transmit Queue.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FinishSentMessage
+(
+    msgSession_UnixSession_t* sessionPtr,
+    le_msg_MessageRef_t msgRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    STATSPAGE_INC(sessionPtr->statsSlotPtr, msgsSent);
+
+    switch (sessionPtr->interfaceRef->interfaceType)
+    {
+        // If this is the client side of the session,
+        case LE_MSG_INTERFACE_CLIENT:
+            // If a response is expected from the other side later, then put this
+            // message on the Transaction List.
+            if (msgMessage_GetTxnId(msgRef) != 0)
+            {
+                AddToTxnList(sessionPtr, msgRef);
+            }
+            // Otherwise, release it.
+            else
+            {
+                le_msg_ReleaseMsg(msgRef);
+            }
+
+            break;
+
+        // If this is the server side of the session,
+        case LE_MSG_INTERFACE_SERVER:
+            // Release the message, but first clear out the transaction ID so that
+            // the message knows that it is not being deleted without a reponse message
+            // being sent if one was expected.
+            msgMessage_SetTxnId(msgRef, 0);
+            le_msg_ReleaseMsg(msgRef);
+
+            break;
+
+        default:
+            LE_FATAL("Unhandled interface type (%d)",
+                     sessionPtr->interfaceRef->interfaceType);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Send messages from a session's Transmit Queue until either the socket becomes full or there
  * are no more messages waiting on the queue.
+ *
+ * Messages are sent in batches of up to LE_CONFIG_IPC_BATCH_SIZE.  After
+ * LE_CONFIG_IPC_SESSION_BURST_LIMIT messages, the rest are left for the next pass of the event
+ * loop.
  */
 //--------------------------------------------------------------------------------------------------
 static void SendFromTransmitQueue
@@ -1015,63 +1183,69 @@ static void SendFromTransmitQueue
 )
 //--------------------------------------------------------------------------------------------------
 {
+    le_msg_MessageRef_t msgRefs[LE_CONFIG_IPC_BATCH_SIZE];
+    size_t budget = LE_CONFIG_IPC_SESSION_BURST_LIMIT;
+
     for (;;)
     {
-        le_msg_MessageRef_t msgRef = PopTransmitQueue(sessionPtr);
+        size_t msgCount = 0;
+        size_t sentCount = 0;
+        size_t i;
 
-        if (msgRef == NULL)
+        while ((msgCount < budget) && (msgCount < LE_CONFIG_IPC_BATCH_SIZE))
         {
-            // Since the Transmit Queue is empty, tell the FD Monitor that we don't need to be
-            // notified about writeability anymore.
-            DisableWriteabilityNotification(sessionPtr);
+            le_msg_MessageRef_t msgRef = PopTransmitQueue(sessionPtr);
+
+            if (msgRef == NULL)
+            {
+                break;
+            }
+            msgRefs[msgCount++] = msgRef;
+        }
+
+        if (msgCount == 0)
+        {
+            if (budget == 0)
+            {
+                // Messages are still waiting, but this session has had its share of this pass.
+                // The socket is writeable, so the FD Monitor will call us back on the next pass.
+                EnableWriteabilityNotification(sessionPtr);
+            }
+            else
+            {
+                // Since the Transmit Queue is empty, tell the FD Monitor that we don't need to be
+                // notified about writeability anymore.
+                DisableWriteabilityNotification(sessionPtr);
+            }
             break;
         }
 
-        le_result_t result = msgMessage_Send(sessionPtr->socketFd, msgRef);
+        le_result_t result = msgMessage_SendBatch(sessionPtr->socketFd,
+                                                  msgRefs,
+                                                  msgCount,
+                                                  &sentCount);
+
+        for (i = 0; i < sentCount; i++)
+        {
+            FinishSentMessage(sessionPtr, msgRefs[i]);
+        }
+
+        // Put the messages that weren't sent back on the head of the queue, in order.
+        for (i = msgCount; i > sentCount; i--)
+        {
+            UnPopTransmitQueue(sessionPtr, msgRefs[i - 1]);
+        }
+
+        budget -= sentCount;
 
         switch (result)
         {
             case LE_OK:
-                switch (sessionPtr->interfaceRef->interfaceType)
-                {
-                    // If this is the client side of the session,
-                    case LE_MSG_INTERFACE_CLIENT:
-                        // If a response is expected from the other side later, then put this
-                        // message on the Transaction List.
-                        if (msgMessage_GetTxnId(msgRef) != 0)
-                        {
-                            AddToTxnList(sessionPtr, msgRef);
-                        }
-                        // Otherwise, release it.
-                        else
-                        {
-                            le_msg_ReleaseMsg(msgRef);
-                        }
-
-                        break;
-
-                    // If this is the server side of the session,
-                    case LE_MSG_INTERFACE_SERVER:
-                        // Release the message, but first clear out the transaction ID so that
-                        // the message knows that it is not being deleted without a reponse message
-                        // being sent if one was expected.
-                        msgMessage_SetTxnId(msgRef, 0);
-                        le_msg_ReleaseMsg(msgRef);
-
-                        break;
-
-                    default:
-                        LE_FATAL("Unhandled interface type (%d)",
-                                 sessionPtr->interfaceRef->interfaceType);
-                }
-
-                break;  // Continue to loop around and send another.
+                break;  // Continue to loop around and send more.
 
             case LE_NO_MEMORY:
-                // Have to wait for the socket to become writeable.  Put the message back on
-                // the head of the queue and ask the FD Monitor to tell us when the socket becomes
-                // writeable again.
-                UnPopTransmitQueue(sessionPtr, msgRef);
+                // Have to wait for the socket to become writeable.  Ask the FD Monitor to tell
+                // us when the socket becomes writeable again.
                 EnableWriteabilityNotification(sessionPtr);
 
                 return;
@@ -1079,10 +1253,8 @@ static void SendFromTransmitQueue
             case LE_COMM_ERROR:
                 // In this case, we expect a handler function to be called by the FD Monitor,
                 // so we don't need to handle this case here.  However, we must stop
-                // trying to transmit now.  Stick the current message back on the Transmit Queue
-                // so it gets cleaned up with the others when the session closes.
-                UnPopTransmitQueue(sessionPtr, msgRef);
-
+                // trying to transmit now.  The messages left on the Transmit Queue get cleaned
+                // up with the others when the session closes.
                 return;
 
             default:
@@ -1100,7 +1272,8 @@ static void SendFromTransmitQueue
 //--------------------------------------------------------------------------------------------------
 static void ClientSocketReadable
 (
-    msgSession_UnixSession_t* sessionPtr
+    msgSession_UnixSession_t* sessionPtr,
+    bool isDrainNeeded      ///< true = the connection is closing, receive everything left.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -1127,6 +1300,7 @@ static void ClientSocketReadable
             else
             {
                 sessionPtr->state = LE_MSG_SESSION_STATE_OPEN;
+                STATSPAGE_SET(sessionPtr->statsSlotPtr, isOpen, 1);
 
                 // Call the client's completion callback.
                 sessionPtr->openHandler(msgSession_GetSessionRef(sessionPtr), sessionPtr->openContextPtr);
@@ -1136,7 +1310,7 @@ static void ClientSocketReadable
         case LE_MSG_SESSION_STATE_OPEN:
             // The Session is already open, so this is either an asynchronous response
             // message or an indication message from the server.
-            ReceiveMessages(sessionPtr);
+            ReceiveMessages(sessionPtr, isDrainNeeded);
             ProcessReceivedMessages(sessionPtr);
             break;
 
@@ -1196,7 +1370,7 @@ static void ClientSocketEventHandler
 
     if (events & POLLIN)
     {
-        ClientSocketReadable(sessionPtr);
+        ClientSocketReadable(sessionPtr, (events & (POLLHUP | POLLRDHUP | POLLERR)) != 0);
     }
 
     if (events & (POLLHUP | POLLRDHUP))
@@ -1222,7 +1396,8 @@ static void ClientSocketEventHandler
 //--------------------------------------------------------------------------------------------------
 static void ServerSocketReadable
 (
-    msgSession_UnixSession_t* sessionPtr
+    msgSession_UnixSession_t* sessionPtr,
+    bool isDrainNeeded      ///< true = the connection is closing, receive everything left.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -1230,7 +1405,7 @@ static void ServerSocketReadable
                 "Unexpected session state (%d).",
                 sessionPtr->state);
 
-    ReceiveMessages(sessionPtr);
+    ReceiveMessages(sessionPtr, isDrainNeeded);
     ProcessReceivedMessages(sessionPtr);
 }
 
@@ -1274,7 +1449,7 @@ static void ServerSocketEventHandler
 
     if (events & POLLIN)
     {
-        ServerSocketReadable(sessionPtr);
+        ServerSocketReadable(sessionPtr, (events & (POLLHUP | POLLRDHUP | POLLERR)) != 0);
     }
 
     if (events & (POLLHUP | POLLRDHUP))
@@ -1464,6 +1639,7 @@ static le_result_t AttemptOpenSync
                 StartSocketMonitoring(sessionPtr, ClientSocketEventHandler);
 
                 sessionPtr->state = LE_MSG_SESSION_STATE_OPEN;
+                STATSPAGE_SET(sessionPtr->statsSlotPtr, isOpen, 1);
             }
             else
             {
@@ -1634,6 +1810,14 @@ void msgSession_SendMessage
     }
     else
     {
+#if LE_CONFIG_IPC_LATENCY_HISTOGRAM
+        // A response finishes a transaction on the server side.
+        if (le_msg_NeedsResponse(messageRef))
+        {
+            RecordLatency(unixSessionPtr, messageRef);
+        }
+#endif
+
         // Put the message on the Transmit Queue.
         PushTransmitQueue(unixSessionPtr, messageRef);
 
@@ -1669,6 +1853,7 @@ void msgSession_RequestResponse
 
     // Create an ID for this transaction.
     CreateTxnId(msgRef);
+    msgMessage_SetStartTime(msgRef);
 
     // Put the message on the Transmit Queue.
     PushTransmitQueue(unixSessionPtr, msgRef);
@@ -1705,8 +1890,13 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
     // Put the socket into blocking mode.
     fd_SetBlocking(unixSessionPtr->socketFd);
 
+    msgMessage_SetStartTime(msgRef);
+
     // Send the Request Message.
-    msgMessage_Send(unixSessionPtr->socketFd, msgRef);
+    if (msgMessage_Send(unixSessionPtr->socketFd, msgRef) == LE_OK)
+    {
+        STATSPAGE_INC(unixSessionPtr->statsSlotPtr, msgsSent);
+    }
 
     // While we have not yet received the response we are waiting for, keep
     // receiving messages.  Any that we receive that don't match the transaction ID
@@ -1727,6 +1917,8 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
             break;
         }
 
+        STATSPAGE_INC(unixSessionPtr->statsSlotPtr, msgsReceived);
+
         if (msgMessage_GetTxnId(rxMsgRef) == msgMessage_GetTxnId(msgRef))
         {
             // Got the synchronous response we were waiting for.
@@ -1747,6 +1939,11 @@ le_msg_MessageRef_t msgSession_DoSyncRequestResponse
         PushReceiveQueue(unixSessionPtr, rxMsgRef);
     }
 
+    if (rxMsgRef != NULL)
+    {
+        RecordLatency(unixSessionPtr, msgRef);
+    }
+
     // Invalidate the ID for this transaction.
     DeleteTxnId(msgRef);
 
@@ -1917,6 +2114,7 @@ le_msg_SessionRef_t msgSession_CreateServerSideSession
 
     // The session is officially open.
     sessionPtr->state = LE_MSG_SESSION_STATE_OPEN;
+    STATSPAGE_SET(sessionPtr->statsSlotPtr, isOpen, 1);
 
     return msgSession_GetSessionRef(sessionPtr);
 }
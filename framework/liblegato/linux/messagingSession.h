@@ -12,6 +12,7 @@
 
 #include "messagingCommon.h"
 #include "messagingInterface.h"
+#include "statsPage.h"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -63,6 +64,10 @@ typedef struct msg_UnixSession
     void*                           openContextPtr; ///< Open handler's context pointer.
     le_msg_SessionEventHandler_t    closeHandler;   ///< Close handler function.
     void*                           closeContextPtr;///< Close handler's context pointer.
+    size_t                          rxBatchSize;    ///< Messages to receive at once next time.
+#if LE_CONFIG_STATS_PAGE
+    statsPage_SessionSlot_t*        statsSlotPtr;   ///< Statistics page slot, or NULL.
+#endif
 }
 msgSession_UnixSession_t;
 
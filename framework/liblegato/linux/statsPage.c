@@ -0,0 +1,974 @@
+/** @file statsPage.c
+ *
+ * Implementation of the statistics page for Linux.  See statsPage.h for the layout of the page and
+ * the protocol used to read it.
+ *
+ * The page is a memfd created at start-up, mapped shared and kept open so that readers can find it
+ * in /proc/<pid>/fd.  The framework modules own the slots assigned to their objects and update
+ * the counters in them directly; this module only hands out and takes back slots, which happens
+ * when an object is created or deleted and is serialized by a mutex of its own.
+ *
+ * After a fork(), the child gets a page of its own at the same address so that the slot pointers
+ * held by the framework stay valid without its updates being seen in the parent's page.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "limit.h"
+#include "mem.h"
+#include "statsPage.h"
+
+#include <sys/mman.h>
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of attempts at reading a slot that keeps being reassigned.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MAX_READ_ATTEMPTS   8
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start of the target of a /proc/<pid>/fd link to a statistics page.
+ */
+//--------------------------------------------------------------------------------------------------
+#define MEMFD_LINK_PREFIX   "/memfd:" STATSPAGE_MEMFD_NAME
+
+
+#if LE_CONFIG_STATS_PAGE
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The page, or NULL if it could not be created.
+ */
+//--------------------------------------------------------------------------------------------------
+static statsPage_Header_t* PagePtr;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the page.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t PageSize;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * File descriptor of the memfd backing the page.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PageFd = -1;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex protecting the assignment of slots.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;   // Pthreads FAST mutex.
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Index from which to look for a free slot in each table.  Slots below it are all in use.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t FirstFreeHint[STATSPAGE_TABLE_COUNT];
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an anonymous memory file.
+ *
+ * @return
+ *      File descriptor, or -1 on failure (e.g., kernel older than 3.17).
+ */
+//--------------------------------------------------------------------------------------------------
+static int CreateMemFd
+(
+    void
+)
+{
+#ifdef SYS_memfd_create
+    return (int)syscall(SYS_memfd_create, STATSPAGE_MEMFD_NAME, 1 /* MFD_CLOEXEC */);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+#endif /* end LE_CONFIG_STATS_PAGE */
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the address of a slot of a page.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline statsPage_SlotHeader_t* GetSlot
+(
+    const statsPage_Header_t*   headerPtr,
+    statsPage_Table_t           table,
+    size_t                      index
+)
+{
+    return (statsPage_SlotHeader_t*)((uint8_t*)headerPtr +
+                                     headerPtr->table[table].offset +
+                                     index * headerPtr->table[table].slotSize);
+}
+
+
+#if LE_CONFIG_STATS_PAGE
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy a name into a slot.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CopyName
+(
+    statsPage_SlotHeader_t* slotPtr,
+    const char*             name
+)
+{
+    if (name == NULL)
+    {
+        slotPtr->name[0] = '\0';
+    }
+    else
+    {
+        // Truncation is fine.
+        le_utf8_Copy(slotPtr->name, name, sizeof(slotPtr->name), NULL);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Give the child process of a fork() a page of its own.
+ *
+ * The new page is mapped at the address of the inherited one, with the same content.  If a new
+ * memfd cannot be created, the inherited one is mapped privately so at least the child's updates
+ * do not show up in its parent's page.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AtForkChild
+(
+    void
+)
+{
+    if (PagePtr != NULL)
+    {
+        int fd = CreateMemFd();
+
+        if ((fd >= 0) &&
+            (ftruncate(fd, PageSize) == 0) &&
+            (write(fd, PagePtr, PageSize) == (ssize_t)PageSize) &&
+            (mmap(PagePtr, PageSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0)
+                != MAP_FAILED))
+        {
+            close(PageFd);
+            PageFd = fd;
+            PagePtr->pid = getpid();
+        }
+        else
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+
+            // If this fails too, there is nothing safe left to do but keep the shared mapping.
+            (void)mmap(PagePtr, PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+                       PageFd, 0);
+            close(PageFd);
+            PageFd = -1;
+        }
+    }
+
+    pthread_mutex_unlock(&Mutex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hold the mutex across fork() so that the child never inherits it locked by another thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AtForkPrepare
+(
+    void
+)
+{
+    pthread_mutex_lock(&Mutex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release the mutex in the parent after fork().
+ */
+//--------------------------------------------------------------------------------------------------
+static void AtForkParent
+(
+    void
+)
+{
+    pthread_mutex_unlock(&Mutex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the statistics page of the process and publish the memory pools created so far.
+ *
+ * Must be called right after mem_Init().  If the page cannot be created, statistics are not
+ * published and the process carries on.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_Init
+(
+    void
+)
+{
+    static const struct
+    {
+        size_t slotSize;
+        size_t count;
+    }
+    tables[STATSPAGE_TABLE_COUNT] =
+    {
+        [STATSPAGE_TABLE_POOL]    = { sizeof(statsPage_PoolSlot_t),
+                                      LE_CONFIG_STATS_PAGE_MAX_POOLS },
+        [STATSPAGE_TABLE_THREAD]  = { sizeof(statsPage_ThreadSlot_t),
+                                      LE_CONFIG_STATS_PAGE_MAX_THREADS },
+        [STATSPAGE_TABLE_SESSION] = { sizeof(statsPage_SessionSlot_t),
+                                      LE_CONFIG_STATS_PAGE_MAX_SESSIONS },
+#if LE_CONFIG_LOCK_STATS
+        [STATSPAGE_TABLE_LOCK]    = { sizeof(statsPage_LockSlot_t),
+                                      LE_CONFIG_STATS_PAGE_MAX_LOCKS },
+#else
+        [STATSPAGE_TABLE_LOCK]    = { sizeof(statsPage_LockSlot_t), 0 },
+#endif
+    };
+
+    size_t offset = sizeof(statsPage_Header_t);
+    size_t offsets[STATSPAGE_TABLE_COUNT];
+    statsPage_Table_t table;
+
+    for (table = 0; table < STATSPAGE_TABLE_COUNT; table++)
+    {
+        offset = (offset + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+        offsets[table] = offset;
+        offset += tables[table].slotSize * tables[table].count;
+    }
+
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = (offset + pageSize - 1) & ~(pageSize - 1);
+
+    int fd = CreateMemFd();
+    if (fd < 0)
+    {
+        LE_INFO("Statistics page not available (errno %d).", errno);
+        return;
+    }
+
+    if (ftruncate(fd, size) != 0)
+    {
+        LE_WARN("Could not size the statistics page (errno %d).", errno);
+        close(fd);
+        return;
+    }
+
+    void* pagePtr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (pagePtr == MAP_FAILED)
+    {
+        LE_WARN("Could not map the statistics page (errno %d).", errno);
+        close(fd);
+        return;
+    }
+
+    // The memfd is zero-filled, so all slots start free with an even sequence number.
+    statsPage_Header_t* headerPtr = pagePtr;
+    headerPtr->headerSize = sizeof(statsPage_Header_t);
+    headerPtr->pageSize = size;
+    headerPtr->pid = getpid();
+    for (table = 0; table < STATSPAGE_TABLE_COUNT; table++)
+    {
+        headerPtr->table[table].offset = offsets[table];
+        headerPtr->table[table].slotSize = tables[table].slotSize;
+        headerPtr->table[table].count = tables[table].count;
+    }
+    headerPtr->version = STATSPAGE_VERSION;
+
+    // Readers check the magic number first, so write it last.
+    __atomic_store_n(&headerPtr->magic, STATSPAGE_MAGIC, __ATOMIC_RELEASE);
+
+    PageFd = fd;
+    PageSize = size;
+    PagePtr = headerPtr;
+
+    LE_ASSERT(pthread_atfork(AtForkPrepare, AtForkParent, AtForkChild) == 0);
+
+    mem_PublishPools();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Assign a free slot of a table to a new object.  The slot's counters are zeroed.
+ *
+ * @return
+ *      Pointer to the slot, or NULL if the table is full or the page does not exist.
+ */
+//--------------------------------------------------------------------------------------------------
+void* statsPage_AllocSlot
+(
+    statsPage_Table_t   table,      ///< [IN] Table to take the slot from.
+    const char*         name        ///< [IN] Name of the object (truncated if too long).
+)
+{
+    statsPage_SlotHeader_t* slotPtr = NULL;
+
+    if (PagePtr == NULL)
+    {
+        return NULL;
+    }
+
+    LE_ASSERT(table < STATSPAGE_TABLE_COUNT);
+
+    pthread_mutex_lock(&Mutex);
+
+    size_t count = PagePtr->table[table].count;
+    size_t index;
+    for (index = FirstFreeHint[table]; index < count; index++)
+    {
+        statsPage_SlotHeader_t* candidatePtr = GetSlot(PagePtr, table, index);
+        if (!candidatePtr->inUse)
+        {
+            slotPtr = candidatePtr;
+            break;
+        }
+    }
+
+    if (slotPtr == NULL)
+    {
+        FirstFreeHint[table] = count;
+        PagePtr->droppedCount++;
+        pthread_mutex_unlock(&Mutex);
+        return NULL;
+    }
+
+    FirstFreeHint[table] = index + 1;
+
+    uint32_t seq = slotPtr->seq;
+    __atomic_store_n(&slotPtr->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    memset((uint8_t*)slotPtr + sizeof(*slotPtr),
+           0,
+           PagePtr->table[table].slotSize - sizeof(*slotPtr));
+    CopyName(slotPtr, name);
+    slotPtr->inUse = 1;
+
+    __atomic_store_n(&slotPtr->seq, seq + 2, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&Mutex);
+
+    return slotPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rename the object a slot is assigned to.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_SetSlotName
+(
+    void*               slotPtr,    ///< [IN] Slot, or NULL.
+    const char*         name        ///< [IN] New name of the object.
+)
+{
+    statsPage_SlotHeader_t* headerPtr = slotPtr;
+
+    if (headerPtr == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&Mutex);
+
+    uint32_t seq = headerPtr->seq;
+    __atomic_store_n(&headerPtr->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    CopyName(headerPtr, name);
+
+    __atomic_store_n(&headerPtr->seq, seq + 2, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&Mutex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a slot when the object it describes is deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_FreeSlot
+(
+    void*               slotPtr     ///< [IN] Slot, or NULL.
+)
+{
+    statsPage_SlotHeader_t* headerPtr = slotPtr;
+
+    if (headerPtr == NULL)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&Mutex);
+
+    uint32_t seq = headerPtr->seq;
+    __atomic_store_n(&headerPtr->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    headerPtr->inUse = 0;
+
+    __atomic_store_n(&headerPtr->seq, seq + 2, __ATOMIC_RELEASE);
+
+    // Find out which table the slot belongs to, to lower its free slot hint.
+    statsPage_Table_t table;
+    for (table = 0; table < STATSPAGE_TABLE_COUNT; table++)
+    {
+        uint8_t* firstPtr = (uint8_t*)GetSlot(PagePtr, table, 0);
+        uint8_t* endPtr = (uint8_t*)GetSlot(PagePtr, table, PagePtr->table[table].count);
+
+        if (((uint8_t*)headerPtr >= firstPtr) && ((uint8_t*)headerPtr < endPtr))
+        {
+            size_t index = ((uint8_t*)headerPtr - firstPtr) / PagePtr->table[table].slotSize;
+            if (index < FirstFreeHint[table])
+            {
+                FirstFreeHint[table] = index;
+            }
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&Mutex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the latency of a transaction in the histogram of an IPC session slot.
+ *
+ * Must only be called by the thread that owns the session.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_RecordLatency
+(
+    statsPage_SessionSlot_t*    slotPtr,    ///< [IN] Slot, or NULL.
+    uint64_t                    latencyUs   ///< [IN] Latency, in microseconds.
+)
+{
+    if (slotPtr == NULL)
+    {
+        return;
+    }
+
+    uint32_t index = statsPage_LatencyBucket(latencyUs);
+
+    __atomic_store_n(&slotPtr->latencyBuckets[index],
+                     slotPtr->latencyBuckets[index] + 1,
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&slotPtr->latencySumUs, slotPtr->latencySumUs + latencyUs, __ATOMIC_RELAXED);
+    if (latencyUs > slotPtr->latencyMaxUs)
+    {
+        __atomic_store_n(&slotPtr->latencyMaxUs,
+                         (latencyUs > UINT32_MAX ? UINT32_MAX : (uint32_t)latencyUs),
+                         __ATOMIC_RELAXED);
+    }
+
+    // Count last, so that a reader never sees more transactions than bucket entries.
+    __atomic_store_n(&slotPtr->latencyCount, slotPtr->latencyCount + 1, __ATOMIC_RELEASE);
+}
+
+#endif /* end LE_CONFIG_STATS_PAGE */
+
+
+#if LE_CONFIG_LOCK_STATS
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Zero the counters of a lock slot if a reader asked for a reset since they were last zeroed.
+ *
+ * Only one of the threads that race here zeroes the counters; updates made by the others at the
+ * same time may be lost or land before the zeroing, which is fine for statistics.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CheckLockReset
+(
+    statsPage_LockSlot_t*   slotPtr
+)
+{
+    uint32_t resetCount = __atomic_load_n(&PagePtr->lockResetCount, __ATOMIC_RELAXED);
+    uint32_t slotResetCount = __atomic_load_n(&slotPtr->resetCount, __ATOMIC_RELAXED);
+
+    if ((slotResetCount != resetCount) &&
+        __atomic_compare_exchange_n(&slotPtr->resetCount, &slotResetCount, resetCount, false,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&slotPtr->acquisitions, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&slotPtr->contended, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&slotPtr->waitTotalNs, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&slotPtr->waitMaxNs, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&slotPtr->holdTotalNs, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&slotPtr->holdMaxNs, 0, __ATOMIC_RELAXED);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Raise a high-water mark that several threads may update at once.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RaiseMax
+(
+    uint64_t*   maxPtr,
+    uint64_t    value
+)
+{
+    uint64_t max = __atomic_load_n(maxPtr, __ATOMIC_RELAXED);
+
+    while ((value > max) &&
+           !__atomic_compare_exchange_n(maxPtr, &max, value, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+        // max was reloaded by the failed exchange.
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the acquisition of a mutex or semaphore in its slot.  Safe to call from several threads
+ * at once.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_RecordLockAcquired
+(
+    statsPage_LockSlot_t*   slotPtr,    ///< [IN] Slot, or NULL.
+    bool                    isContended,///< [IN] true if the caller had to wait.
+    uint64_t                waitNs      ///< [IN] Time spent waiting, if contended.
+)
+{
+    if (slotPtr == NULL)
+    {
+        return;
+    }
+
+    CheckLockReset(slotPtr);
+
+    __atomic_fetch_add(&slotPtr->acquisitions, 1, __ATOMIC_RELAXED);
+
+    if (isContended)
+    {
+        __atomic_fetch_add(&slotPtr->contended, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&slotPtr->waitTotalNs, waitNs, __ATOMIC_RELAXED);
+        RaiseMax(&slotPtr->waitMaxNs, waitNs);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record how long a mutex was held in its slot.  Must be called with the mutex held.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_RecordLockHeld
+(
+    statsPage_LockSlot_t*   slotPtr,    ///< [IN] Slot, or NULL.
+    uint64_t                holdNs      ///< [IN] Time the mutex was held.
+)
+{
+    if (slotPtr == NULL)
+    {
+        return;
+    }
+
+    CheckLockReset(slotPtr);
+
+    // The mutex serializes the updates of its hold times.
+    __atomic_store_n(&slotPtr->holdTotalNs, slotPtr->holdTotalNs + holdNs, __ATOMIC_RELAXED);
+    if (holdNs > slotPtr->holdMaxNs)
+    {
+        __atomic_store_n(&slotPtr->holdMaxNs, holdNs, __ATOMIC_RELAXED);
+    }
+}
+
+#endif /* end LE_CONFIG_LOCK_STATS */
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check that a mapped page has a layout this module understands.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsPageValid
+(
+    const statsPage_Header_t*   headerPtr,
+    size_t                      size
+)
+{
+    if ((__atomic_load_n(&headerPtr->magic, __ATOMIC_ACQUIRE) != STATSPAGE_MAGIC) ||
+        (headerPtr->version != STATSPAGE_VERSION) ||
+        (headerPtr->headerSize < sizeof(statsPage_Header_t)) ||
+        (headerPtr->pageSize > size))
+    {
+        return false;
+    }
+
+    static const size_t minSlotSizes[STATSPAGE_TABLE_COUNT] =
+    {
+        [STATSPAGE_TABLE_POOL]    = sizeof(statsPage_PoolSlot_t),
+        [STATSPAGE_TABLE_THREAD]  = sizeof(statsPage_ThreadSlot_t),
+        [STATSPAGE_TABLE_SESSION] = sizeof(statsPage_SessionSlot_t),
+        [STATSPAGE_TABLE_LOCK]    = sizeof(statsPage_LockSlot_t),
+    };
+
+    statsPage_Table_t table;
+    for (table = 0; table < STATSPAGE_TABLE_COUNT; table++)
+    {
+        uint64_t end = (uint64_t)headerPtr->table[table].offset +
+                       (uint64_t)headerPtr->table[table].slotSize * headerPtr->table[table].count;
+
+        if ((headerPtr->table[table].slotSize < minSlotSizes[table]) ||
+            (end > headerPtr->pageSize))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find the statistics page of another process in its file descriptors and map it.
+ *
+ * @return
+ *      - LE_OK on success.
+ *      - LE_NOT_FOUND if the process does not exist or does not publish a page.
+ *      - LE_NOT_PERMITTED if the caller may not look at the process's file descriptors, or may not
+ *        open the page for writing.
+ *      - LE_FORMAT_ERROR if the page has an unknown format.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t MapPage
+(
+    pid_t                   pid,            ///< [IN] Process to look at.
+    bool                    isWritable,     ///< [IN] true to map the page writable.
+    statsPage_Header_t**    headerPtrPtr,   ///< [OUT] Mapped page.
+    size_t*                 sizePtr         ///< [OUT] Size of the mapping.
+)
+{
+    char path[LIMIT_MAX_PATH_BYTES];
+    char link[LIMIT_MAX_PATH_BYTES];
+
+    snprintf(path, sizeof(path), "/proc/%d/fd", (int)pid);
+
+    DIR* dirPtr = opendir(path);
+    if (dirPtr == NULL)
+    {
+        return ((errno == EACCES) ? LE_NOT_PERMITTED : LE_NOT_FOUND);
+    }
+
+    le_result_t result = LE_NOT_FOUND;
+    struct dirent* entryPtr;
+
+    while ((entryPtr = readdir(dirPtr)) != NULL)
+    {
+        if (entryPtr->d_name[0] == '.')
+        {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "/proc/%d/fd/%s", (int)pid, entryPtr->d_name);
+
+        ssize_t len = readlink(path, link, sizeof(link) - 1);
+        if (len < 0)
+        {
+            continue;
+        }
+        link[len] = '\0';
+
+        // The link reads "/memfd:le_stats (deleted)".
+        if ((strncmp(link, MEMFD_LINK_PREFIX, sizeof(MEMFD_LINK_PREFIX) - 1) != 0) ||
+            ((link[sizeof(MEMFD_LINK_PREFIX) - 1] != '\0') &&
+             (link[sizeof(MEMFD_LINK_PREFIX) - 1] != ' ')))
+        {
+            continue;
+        }
+
+        int fd = open(path, (isWritable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+        if (fd < 0)
+        {
+            result = ((errno == EACCES) ? LE_NOT_PERMITTED : LE_NOT_FOUND);
+            continue;
+        }
+
+        struct stat st;
+        void* mapPtr = MAP_FAILED;
+        if ((fstat(fd, &st) == 0) && (st.st_size >= (off_t)sizeof(statsPage_Header_t)))
+        {
+            mapPtr = mmap(NULL, st.st_size, PROT_READ | (isWritable ? PROT_WRITE : 0),
+                          MAP_SHARED, fd, 0);
+        }
+        close(fd);
+
+        if (mapPtr == MAP_FAILED)
+        {
+            continue;
+        }
+
+        if (!IsPageValid(mapPtr, st.st_size))
+        {
+            munmap(mapPtr, st.st_size);
+            result = LE_FORMAT_ERROR;
+            continue;
+        }
+
+        // A page inherited through a fork that could not be replaced belongs to the parent.
+        if (((const statsPage_Header_t*)mapPtr)->pid != pid)
+        {
+            munmap(mapPtr, st.st_size);
+            continue;
+        }
+
+        *headerPtrPtr = mapPtr;
+        *sizePtr = st.st_size;
+        result = LE_OK;
+        break;
+    }
+
+    closedir(dirPtr);
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map the statistics page of another process, read-only.
+ *
+ * @return
+ *      - LE_OK on success.
+ *      - LE_NOT_FOUND if the process does not exist or does not publish a page.
+ *      - LE_NOT_PERMITTED if the caller may not look at the process's file descriptors.
+ *      - LE_FORMAT_ERROR if the page has an unknown format.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t statsPage_Map
+(
+    pid_t                        pid,           ///< [IN] Process to look at.
+    const statsPage_Header_t**   headerPtrPtr,  ///< [OUT] Mapped page.
+    size_t*                      sizePtr        ///< [OUT] Size of the mapping.
+)
+{
+    statsPage_Header_t* headerPtr;
+    le_result_t result = MapPage(pid, false, &headerPtr, sizePtr);
+
+    if (result == LE_OK)
+    {
+        *headerPtrPtr = headerPtr;
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reset the mutex and semaphore counters in the statistics page of another process.  Each slot is
+ * zeroed by the publisher on its next update; until then statsPage_ReadSlot() reads it as zero.
+ *
+ * @return
+ *      - LE_OK on success.
+ *      - LE_NOT_FOUND if the process does not exist or does not publish a page.
+ *      - LE_NOT_PERMITTED if the caller may not write to the process's page.
+ *      - LE_FORMAT_ERROR if the page has an unknown format.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t statsPage_ResetLockStats
+(
+    pid_t                        pid            ///< [IN] Process to reset.
+)
+{
+    statsPage_Header_t* headerPtr;
+    size_t size;
+    le_result_t result = MapPage(pid, true, &headerPtr, &size);
+
+    if (result == LE_OK)
+    {
+        __atomic_fetch_add(&headerPtr->lockResetCount, 1, __ATOMIC_RELAXED);
+        munmap(headerPtr, size);
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmap a page mapped by statsPage_Map().
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_Unmap
+(
+    const statsPage_Header_t*    headerPtr,     ///< [IN] Mapped page.
+    size_t                       size           ///< [IN] Size of the mapping.
+)
+{
+    munmap((void*)headerPtr, size);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take a consistent copy of a slot of a mapped page.
+ *
+ * @return
+ *      true if the slot describes a live object and was copied, false if it is free or kept
+ *      changing during the copy.
+ */
+//--------------------------------------------------------------------------------------------------
+bool statsPage_ReadSlot
+(
+    const statsPage_Header_t*    headerPtr,     ///< [IN] Mapped page.
+    statsPage_Table_t            table,         ///< [IN] Table to read from.
+    size_t                       index,         ///< [IN] Index of the slot in the table.
+    void*                        bufPtr,        ///< [OUT] Copy of the slot.
+    size_t                       bufSize        ///< [IN] Size of the buffer.
+)
+{
+    if ((table >= STATSPAGE_TABLE_COUNT) || (index >= headerPtr->table[table].count))
+    {
+        return false;
+    }
+
+    const statsPage_SlotHeader_t* slotPtr = GetSlot(headerPtr, table, index);
+    size_t copySize = headerPtr->table[table].slotSize;
+
+    // Fields the publisher does not know about read as 0.
+    if (copySize > bufSize)
+    {
+        copySize = bufSize;
+    }
+    else
+    {
+        memset((uint8_t*)bufPtr + copySize, 0, bufSize - copySize);
+    }
+
+    int attempt;
+    for (attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++)
+    {
+        uint32_t seq = __atomic_load_n(&slotPtr->seq, __ATOMIC_ACQUIRE);
+
+        if (seq & 1)
+        {
+            sched_yield();
+            continue;
+        }
+
+        memcpy(bufPtr, slotPtr, copySize);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&slotPtr->seq, __ATOMIC_RELAXED) == seq)
+        {
+            statsPage_SlotHeader_t* copyPtr = bufPtr;
+            copyPtr->name[sizeof(copyPtr->name) - 1] = '\0';
+
+            // Counters reset by a reader but not yet zeroed by the publisher.
+            statsPage_LockSlot_t* lockPtr = bufPtr;
+            if ((table == STATSPAGE_TABLE_LOCK) &&
+                (bufSize >= sizeof(*lockPtr)) &&
+                (lockPtr->resetCount != __atomic_load_n(&headerPtr->lockResetCount,
+                                                        __ATOMIC_RELAXED)))
+            {
+                memset((uint8_t*)lockPtr + offsetof(statsPage_LockSlot_t, acquisitions),
+                       0,
+                       sizeof(*lockPtr) - offsetof(statsPage_LockSlot_t, acquisitions));
+            }
+
+            return (copyPtr->inUse != 0);
+        }
+    }
+
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimate a percentile of the latency histogram of a copy of an IPC session slot.
+ *
+ * @return
+ *      Upper bound of the bucket holding the percentile, in microseconds (never more than the
+ *      largest recorded latency), or 0 if no latency was recorded.
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t statsPage_GetLatencyPercentile
+(
+    const statsPage_SessionSlot_t*  slotPtr,    ///< [IN] Copy of the slot.
+    double                          percentile  ///< [IN] Percentile, between 0 and 100.
+)
+{
+    uint64_t total = 0;
+    uint32_t index;
+
+    // Use the sum of the buckets rather than latencyCount, as the copy may be one update apart.
+    for (index = 0; index < STATSPAGE_LATENCY_BUCKETS; index++)
+    {
+        total += slotPtr->latencyBuckets[index];
+    }
+
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t)((percentile / 100.0) * total + 0.5);
+    uint64_t seen = 0;
+
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+
+    for (index = 0; index < STATSPAGE_LATENCY_BUCKETS - 1; index++)
+    {
+        seen += slotPtr->latencyBuckets[index];
+        if (seen >= rank)
+        {
+            break;
+        }
+    }
+
+    if (index == STATSPAGE_LATENCY_BUCKETS - 1)
+    {
+        return slotPtr->latencyMaxUs;
+    }
+
+    uint64_t upperBound = statsPage_LatencyBucketLowerBound(index + 1) - 1;
+
+    return (upperBound < slotPtr->latencyMaxUs ? upperBound : slotPtr->latencyMaxUs);
+}
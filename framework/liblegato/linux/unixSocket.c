@@ -372,6 +372,72 @@ le_result_t unixSocket_Connect
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Converts the errno left by a failed sendmsg() or sendmmsg() into a result code.
+ *
+ * @return
+ * - LE_NO_MEMORY if the socket doesn't have enough buffer space to send right now.
+ * - LE_COMM_ERROR if the socket is not connected.
+ * - LE_FAULT for any other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetSendError
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (errno)
+    {
+        case EAGAIN:  // Same as EWOULDBLOCK
+            return LE_NO_MEMORY;
+
+        case ENOTCONN:
+        case ECONNRESET:
+        case EPIPE:
+            LE_WARN("sendmsg() failed with errno %d (%m).", errno);
+            return LE_COMM_ERROR;
+
+        default:
+            LE_ERROR("sendmsg() failed with errno %d (%m).", errno);
+            return LE_FAULT;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Converts the errno left by a failed recvmsg() or recvmmsg() into a result code.
+ *
+ * @return
+ * - LE_WOULD_BLOCK if there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT for any other error.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetReceiveError
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+    {
+        return LE_WOULD_BLOCK;
+    }
+    else if (errno == ECONNRESET)
+    {
+        return LE_CLOSED;
+    }
+    else
+    {
+        LE_ERROR("recvmsg() failed with errno %d (%m).", errno);
+        return LE_FAULT;
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Sends through a connected Unix domain socket a message containing any combination of:
@@ -501,21 +567,7 @@ le_result_t unixSocket_SendMsg
 
     if (bytesSent < 0)
     {
-        switch (errno)
-        {
-            case EAGAIN:  // Same as EWOULDBLOCK
-                return LE_NO_MEMORY;
-
-            case ENOTCONN:
-            case ECONNRESET:
-            case EPIPE:
-                LE_WARN("sendmsg() failed with errno %d (%m).", errno);
-                return LE_COMM_ERROR;
-
-            default:
-                LE_ERROR("sendmsg() failed with errno %d (%m).", errno);
-                return LE_FAULT;
-        }
+        return GetSendError();
     }
 
     if (bytesSent < dataSize)
@@ -658,19 +710,7 @@ le_result_t unixSocket_ReceiveMsg
     // If we failed, process the error and return.
     if (bytesReceived < 0)
     {
-        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
-        {
-            return LE_WOULD_BLOCK;
-        }
-        else if (errno == ECONNRESET)
-        {
-            return LE_CLOSED;
-        }
-        else
-        {
-            LE_ERROR("recvmsg() failed with errno %d (%m).", errno);
-            return LE_FAULT;
-        }
+        return GetReceiveError();
     }
 
     // Check if ancillary data was discarded.
@@ -759,6 +799,218 @@ le_result_t unixSocket_ReceiveDataMsg
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends several messages, each containing data and optionally a file descriptor, through a
+ * connected Unix domain datagram or sequenced-packet socket in a single system call.
+ *
+ * Sending stops at the first message that cannot be sent.  If some messages were sent, LE_OK is
+ * returned and the reason the next one could not be sent is returned by the next call.
+ *
+ * @return
+ * - LE_OK if at least one message was sent.
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ * - LE_NO_MEMORY if the send socket is set to non-blocking and it doesn't have enough buffer
+ *                  space to send right now. Wait for the "writeable" event on the file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_SendMsgBatch
+(
+    int localSocketFd,                  ///< [IN] fd of the local socket that will be used to send.
+    unixSocket_BatchMsg_t* msgArray,    ///< [IN] Messages to send.
+    size_t msgCount,                    ///< [IN] Number of messages (at most
+                                        ///       UNIXSOCKET_MAX_BATCH_SIZE).
+    size_t* sentCountPtr                ///< [OUT] Number of messages sent.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct mmsghdr msgHeaders[UNIXSOCKET_MAX_BATCH_SIZE];
+    struct iovec ioVectors[UNIXSOCKET_MAX_BATCH_SIZE];
+    char cmsgBuffers[UNIXSOCKET_MAX_BATCH_SIZE][CMSG_SPACE(sizeof(int))];
+    size_t i;
+
+    LE_ASSERT((msgCount > 0) && (msgCount <= UNIXSOCKET_MAX_BATCH_SIZE));
+
+    *sentCountPtr = 0;
+    memset(msgHeaders, 0, msgCount * sizeof(msgHeaders[0]));
+
+    for (i = 0; i < msgCount; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        if ((msgArray[i].dataPtr != NULL) && (msgArray[i].dataSize > 0))
+        {
+            ioVectors[i].iov_base = msgArray[i].dataPtr;
+            ioVectors[i].iov_len = msgArray[i].dataSize;
+            msgHeaderPtr->msg_iov = &ioVectors[i];
+            msgHeaderPtr->msg_iovlen = 1;
+        }
+
+        // Same control message as unixSocket_SendMsg() builds for a file descriptor.
+        if (msgArray[i].fd >= 0)
+        {
+            msgHeaderPtr->msg_control = cmsgBuffers[i];
+            msgHeaderPtr->msg_controllen = sizeof(cmsgBuffers[i]);
+
+            struct cmsghdr* cmsgHeaderPtr = CMSG_FIRSTHDR(msgHeaderPtr);
+            cmsgHeaderPtr->cmsg_level = SOL_SOCKET;
+            cmsgHeaderPtr->cmsg_type = SCM_RIGHTS;
+            cmsgHeaderPtr->cmsg_len = CMSG_LEN(sizeof(int));
+            memcpy(CMSG_DATA(cmsgHeaderPtr), &msgArray[i].fd, sizeof(int));
+
+            msgHeaderPtr->msg_controllen = cmsgHeaderPtr->cmsg_len;
+
+            LE_DEBUG("Sending fd %d.", msgArray[i].fd);
+        }
+    }
+
+    // Send the messages (retry if interrupted by a signal before anything was sent).
+    int msgsSent;
+    do
+    {
+        msgsSent = sendmmsg(localSocketFd, msgHeaders, msgCount, 0);
+    }
+    while ((msgsSent < 0) && (errno == EINTR));
+
+    if (msgsSent < 0)
+    {
+        return GetSendError();
+    }
+
+    for (i = 0; i < (size_t)msgsSent; i++)
+    {
+        if (msgHeaders[i].msg_len < msgArray[i].dataSize)
+        {
+            LE_ERROR("The last %"PRIuS" data bytes (of %"PRIuS" total) were discarded by "
+                     "sendmmsg()!",
+                     msgArray[i].dataSize - msgHeaders[i].msg_len,
+                     msgArray[i].dataSize);
+            return LE_FAULT;
+        }
+    }
+
+    *sentCountPtr = msgsSent;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receives up to a given number of messages, each containing data and optionally a file
+ * descriptor, through a connected Unix domain datagram or sequenced-packet socket in a single
+ * system call.  Credentials are not received.
+ *
+ * Waits for the first message if the socket is blocking, but never for the ones after it.  Fewer
+ * messages than asked for are returned when no more are waiting, so the caller knows that the
+ * socket has been drained.
+ *
+ * The result field of each message received tells whether it fit in its buffer and its file
+ * descriptor could be received.
+ *
+ * @return
+ * - LE_OK if at least one message was received.
+ * - LE_WOULD_BLOCK if the socket is set non-blocking and there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_ReceiveMsgBatch
+(
+    int localSocketFd,                  ///< [IN] fd of local socket that will be used to receive.
+    unixSocket_BatchMsg_t* msgArray,    ///< [IN+OUT] Buffers to receive the messages into.
+    size_t msgCount,                    ///< [IN] Number of buffers (at most
+                                        ///       UNIXSOCKET_MAX_BATCH_SIZE).
+    size_t* receivedCountPtr            ///< [OUT] Number of messages received.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct mmsghdr msgHeaders[UNIXSOCKET_MAX_BATCH_SIZE];
+    struct iovec ioVectors[UNIXSOCKET_MAX_BATCH_SIZE];
+    // Each message may carry a security label as well as a file descriptor.
+    char cmsgBuffers[UNIXSOCKET_MAX_BATCH_SIZE][CMSG_BUFF_SIZE];
+    size_t i;
+
+    LE_ASSERT((msgCount > 0) && (msgCount <= UNIXSOCKET_MAX_BATCH_SIZE));
+
+    *receivedCountPtr = 0;
+    memset(msgHeaders, 0, msgCount * sizeof(msgHeaders[0]));
+
+    for (i = 0; i < msgCount; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        msgHeaderPtr->msg_control = cmsgBuffers[i];
+        msgHeaderPtr->msg_controllen = sizeof(cmsgBuffers[i]);
+
+        if ((msgArray[i].dataPtr != NULL) && (msgArray[i].dataSize > 0))
+        {
+            ioVectors[i].iov_base = msgArray[i].dataPtr;
+            ioVectors[i].iov_len = msgArray[i].dataSize;
+            msgHeaderPtr->msg_iov = &ioVectors[i];
+            msgHeaderPtr->msg_iovlen = 1;
+        }
+
+        msgArray[i].fd = -1;
+    }
+
+    // Keep trying to receive until we don't get interrupted by a signal.  MSG_WAITFORONE stops
+    // recvmmsg() from waiting for more messages once the first one has arrived.
+    int msgsReceived;
+    do
+    {
+        msgsReceived = recvmmsg(localSocketFd, msgHeaders, msgCount, MSG_WAITFORONE, NULL);
+    }
+    while ((msgsReceived < 0) && (errno == EINTR));
+
+    if (msgsReceived < 0)
+    {
+        return GetReceiveError();
+    }
+
+    for (i = 0; i < (size_t)msgsReceived; i++)
+    {
+        struct msghdr* msgHeaderPtr = &msgHeaders[i].msg_hdr;
+
+        msgArray[i].result = LE_OK;
+
+        // Always extract the file descriptor, even if the message is bad, so it gets closed.
+        if (msgHeaderPtr->msg_controllen > 0)
+        {
+            ExtractAncillaryData(msgHeaderPtr, &msgArray[i].fd, NULL);
+        }
+        // An empty message with no ancillary data means the connection closed after the
+        // messages before it.
+        else if (msgHeaders[i].msg_len == 0)
+        {
+            break;
+        }
+
+        msgArray[i].dataSize = msgHeaders[i].msg_len;
+
+        if ((msgHeaderPtr->msg_flags & MSG_CTRUNC) != 0)
+        {
+            LE_ERROR("Unable to receive fd because control data has been truncated");
+            msgArray[i].result = LE_NOT_PERMITTED;
+        }
+        else if ((msgHeaderPtr->msg_flags & MSG_TRUNC) != 0)
+        {
+            msgArray[i].result = LE_NO_MEMORY;
+        }
+    }
+
+    if (i == 0)
+    {
+        return LE_CLOSED;
+    }
+
+    *receivedCountPtr = i;
+
+    return LE_OK;
+}
+
+
 
 //--------------------------------------------------------------------------------------------------
 /**
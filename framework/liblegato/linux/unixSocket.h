@@ -157,6 +157,10 @@
  * - unixSocket_ReceiveMsg() receives a message containing any combination of normal
  *   data, a file descriptor, and authenticated credentials.
  *
+ * - unixSocket_SendMsgBatch() and unixSocket_ReceiveMsgBatch() send or receive several messages,
+ *   each with data and optionally a file descriptor, in a single system call (sendmmsg() and
+ *   recvmmsg()).  They are meant for datagram and sequenced-packet sockets.
+ *
  * When file descriptors are sent, they are duplicated in the receiving process as if they had
  * been created using the POSIX dup() function.  This means that they remain open in the sending
  * process and must be closed by the sending process when it doesn't need them anymore.
@@ -281,6 +285,34 @@
 #ifndef LEGATO_UNIX_SOCKET_INCLUDE_GUARD
 #define LEGATO_UNIX_SOCKET_INCLUDE_GUARD
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of messages sent or received by one call to unixSocket_SendMsgBatch() or
+ * unixSocket_ReceiveMsgBatch().
+ */
+//--------------------------------------------------------------------------------------------------
+#define UNIXSOCKET_MAX_BATCH_SIZE   16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * One message of a batch sent by unixSocket_SendMsgBatch() or received by
+ * unixSocket_ReceiveMsgBatch().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    void*       dataPtr;    ///< [IN] Data payload to send, or buffer to receive it into.
+    size_t      dataSize;   ///< [IN+OUT] Number of bytes to send, or size of the buffer.  Updated
+                            ///  to the number of bytes received.
+    int         fd;         ///< [IN+OUT] File descriptor to send (-1 if none), or the one received
+                            ///  (-1 if none).
+    le_result_t result;     ///< [OUT] Receive only: LE_OK, or LE_NO_MEMORY or LE_NOT_PERMITTED as
+                            ///  for unixSocket_ReceiveMsg().
+}
+unixSocket_BatchMsg_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Creates a named datagram Unix domain socket.  This binds the socket to a file system path.
@@ -519,6 +551,62 @@ le_result_t unixSocket_ReceiveDataMsg
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Sends several messages, each containing data and optionally a file descriptor, through a
+ * connected Unix domain datagram or sequenced-packet socket in a single system call.
+ *
+ * Sending stops at the first message that cannot be sent.  If some messages were sent, LE_OK is
+ * returned and the reason the next one could not be sent is returned by the next call.
+ *
+ * @return
+ * - LE_OK if at least one message was sent.
+ * - LE_COMM_ERROR if the localSocketFd is not connected.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ * - LE_NO_MEMORY if the send socket is set to non-blocking and it doesn't have enough buffer
+ *                  space to send right now. Wait for the "writeable" event on the file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_SendMsgBatch
+(
+    int localSocketFd,                  ///< [IN] fd of the local socket that will be used to send.
+    unixSocket_BatchMsg_t* msgArray,    ///< [IN] Messages to send.
+    size_t msgCount,                    ///< [IN] Number of messages (at most
+                                        ///       UNIXSOCKET_MAX_BATCH_SIZE).
+    size_t* sentCountPtr                ///< [OUT] Number of messages sent.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Receives up to a given number of messages, each containing data and optionally a file
+ * descriptor, through a connected Unix domain datagram or sequenced-packet socket in a single
+ * system call.  Credentials are not received.
+ *
+ * Waits for the first message if the socket is blocking, but never for the ones after it.  Fewer
+ * messages than asked for are returned when no more are waiting, so the caller knows that the
+ * socket has been drained.
+ *
+ * The result field of each message received tells whether it fit in its buffer and its file
+ * descriptor could be received.
+ *
+ * @return
+ * - LE_OK if at least one message was received.
+ * - LE_WOULD_BLOCK if the socket is set non-blocking and there is nothing to be received.
+ * - LE_CLOSED if the connection closed.
+ * - LE_FAULT if failed for some other reason (check your logs).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t unixSocket_ReceiveMsgBatch
+(
+    int localSocketFd,                  ///< [IN] fd of local socket that will be used to receive.
+    unixSocket_BatchMsg_t* msgArray,    ///< [IN+OUT] Buffers to receive the messages into.
+    size_t msgCount,                    ///< [IN] Number of buffers (at most
+                                        ///       UNIXSOCKET_MAX_BATCH_SIZE).
+    size_t* receivedCountPtr            ///< [OUT] Number of messages received.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Fetches the socket error state code (SO_ERROR).
@@ -44,6 +44,7 @@
  */
 #include "legato.h"
 #include "mem.h"
+#include "statsPage.h"
 
 #define GUARD_WORD ((uint32_t)0xDEADBEEF)
 #define GUARD_BAND_SIZE (sizeof(GUARD_WORD) * LE_CONFIG_NUM_GUARD_BAND_WORDS)
@@ -257,6 +258,94 @@ void mem_Unlock
 }
 
 
+#if LE_CONFIG_STATS_PAGE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copies the counters of a pool to its slot in the statistics page.
+ *
+ * @note
+ *      Assumes that the mutex is locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PublishStats_NoLock
+(
+    le_mem_PoolRef_t    pool    ///< [IN] The pool whose counters changed.
+)
+{
+    statsPage_PoolSlot_t* slotPtr = pool->statsSlotPtr;
+
+    STATSPAGE_SET(slotPtr, totalBlocks, pool->totalBlocks);
+    STATSPAGE_SET(slotPtr, numBlocksInUse, pool->numBlocksInUse);
+#if LE_CONFIG_MEM_POOL_STATS
+    STATSPAGE_SET(slotPtr, maxNumBlocksUsed, pool->maxNumBlocksUsed);
+    STATSPAGE_SET(slotPtr, numOverflows, pool->numOverflows);
+    STATSPAGE_SET(slotPtr, numAllocations, pool->numAllocations);
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gives a pool a slot in the statistics page, if the page exists and is not full.
+ *
+ * @note
+ *      Assumes that the mutex is locked.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToStatsPage_NoLock
+(
+    le_mem_PoolRef_t    pool    ///< [IN] The pool to publish.
+)
+{
+#if LE_CONFIG_MEM_POOL_NAMES_ENABLED
+    statsPage_PoolSlot_t* slotPtr = statsPage_AllocSlot(STATSPAGE_TABLE_POOL, pool->name);
+#else
+    statsPage_PoolSlot_t* slotPtr = statsPage_AllocSlot(STATSPAGE_TABLE_POOL, NULL);
+#endif
+
+    STATSPAGE_SET(slotPtr, isSubPool, (pool->superPoolPtr != NULL));
+    STATSPAGE_SET(slotPtr, blockSize, pool->blockSize);
+
+    pool->statsSlotPtr = slotPtr;
+    PublishStats_NoLock(pool);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Publish the memory pools that do not have a slot in the statistics page yet.  Called once the
+ * page is created, for the pools created before it.
+ */
+//--------------------------------------------------------------------------------------------------
+void mem_PublishPools
+(
+    void
+)
+{
+    mem_Lock();
+
+    le_dls_Link_t* poolLinkPtr = le_dls_Peek(&PoolList);
+
+    while (poolLinkPtr)
+    {
+        le_mem_Pool_t* memPoolPtr = CONTAINER_OF(poolLinkPtr, le_mem_Pool_t, poolLink);
+
+        if (memPoolPtr->statsSlotPtr == NULL)
+        {
+            AddToStatsPage_NoLock(memPoolPtr);
+        }
+
+        poolLinkPtr = le_dls_PeekNext(&PoolList, poolLinkPtr);
+    }
+
+    mem_Unlock();
+}
+#else
+#   define PublishStats_NoLock(pool)
+#   define AddToStatsPage_NoLock(pool)
+#endif /* end LE_CONFIG_STATS_PAGE */
+
+
 #if LE_CONFIG_USE_GUARD_BAND
 
     //----------------------------------------------------------------------------------------------
@@ -711,6 +800,12 @@ void SubPoolDestructor
                 blocksFreed, subPool->superPoolPtr->numBlocksInUse);
     subPool->superPoolPtr->numBlocksInUse -= blocksFreed;
 #endif
+    PublishStats_NoLock(subPool->superPoolPtr);
+
+#if LE_CONFIG_STATS_PAGE
+    statsPage_FreeSlot(subPool->statsSlotPtr);
+    subPool->statsSlotPtr = NULL;
+#endif
 
     // Remove the sub-pool from the list of sub-pools.
     PoolListChangeCount++;
@@ -887,6 +982,7 @@ le_mem_PoolRef_t _le_mem_CreatePool
     // Add the new pool to the list of pools.
     PoolListChangeCount++;
     le_dls_Queue(&PoolList, &(newPool->poolLink));
+    AddToStatsPage_NoLock(newPool);
 
     mem_Unlock();
 
@@ -928,6 +1024,7 @@ le_mem_PoolRef_t _le_mem_InitStaticPool
     // Add the new pool to the list of pools.
     PoolListChangeCount++;
     le_dls_Queue(&PoolList, &(poolPtr->poolLink));
+    AddToStatsPage_NoLock(poolPtr);
 
     mem_Unlock();
 
@@ -943,6 +1040,7 @@ le_mem_PoolRef_t _le_mem_InitStaticPool
 
     // Update the pool.
     poolPtr->totalBlocks += numBlocks;
+    PublishStats_NoLock(poolPtr);
 #endif
 
     return poolPtr;
@@ -1005,12 +1103,15 @@ static le_mem_PoolRef_t ExpandPool_NoLock
             pool->superPoolPtr->maxNumBlocksUsed = pool->superPoolPtr->numBlocksInUse;
         }
 #   endif /* end LE_CONFIG_MEM_POOL_STATS */
+        PublishStats_NoLock(pool->superPoolPtr);
     }
     else
     {
         // This is not a sub-pool.
         AddBlocks(pool, numObjects);
     }
+
+    PublishStats_NoLock(pool);
 #endif /* end LE_CONFIG_MEM_POOLS */
 
     return pool;
@@ -1098,6 +1199,7 @@ void* le_mem_TryAlloc
         pool->maxNumBlocksUsed = pool->numBlocksInUse;
     }
 #endif
+        PublishStats_NoLock(pool);
 
         blockPtr->refCount = 1;
 
@@ -1174,6 +1276,7 @@ void* le_mem_ForceAlloc
 #    if LE_CONFIG_MEM_POOL_STATS
         pool->numOverflows++;
 #    endif
+        PublishStats_NoLock(pool);
 
             // log a warning.
 #   if !LE_CONFIG_LINUX
@@ -1417,6 +1520,7 @@ void le_mem_Release
 #endif
 
             poolPtr->numBlocksInUse--;
+            PublishStats_NoLock(poolPtr);
 
             break;
         }
@@ -1570,6 +1674,7 @@ void le_mem_ResetStats
     mem_Lock();
     pool->numAllocations = 0;
     pool->numOverflows = 0;
+    PublishStats_NoLock(pool);
     mem_Unlock();
 #endif
 }
@@ -1814,6 +1919,7 @@ le_mem_PoolRef_t _le_mem_CreateSubPool
     // Add the sub-pool to the list of pools.
     PoolListChangeCount++;
     le_dls_Queue(&PoolList, &(subPool->poolLink));
+    AddToStatsPage_NoLock(subPool);
 
     mem_Unlock();
 
@@ -1918,6 +2024,7 @@ le_mem_PoolRef_t _le_mem_CreateReducedPool
     // Add the sub-pool to the list of pools.
     PoolListChangeCount++;
     le_dls_Queue(&PoolList, &(subPool->poolLink));
+    AddToStatsPage_NoLock(subPool);
 
     mem_Unlock();
 
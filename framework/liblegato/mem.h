@@ -51,6 +51,19 @@ size_t** mem_GetPoolListChgCntRef
     void
 );
 
+#if LE_CONFIG_STATS_PAGE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Publish the memory pools that do not have a slot in the statistics page yet.  Called once the
+ * page is created, for the pools created before it.
+ */
+//--------------------------------------------------------------------------------------------------
+void mem_PublishPools
+(
+    void
+);
+#endif /* end LE_CONFIG_STATS_PAGE */
+
 #if LE_CONFIG_RTOS
 //--------------------------------------------------------------------------------------------------
 /**
@@ -11,6 +11,11 @@
 
 #include "messagingCommon.h"
 
+#if LE_CONFIG_LINUX
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#endif
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -38,6 +43,60 @@ typedef struct le_msg_LocalSession
 } msg_LocalSession_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion object of a thread, on which it waits for the response to a synchronous request.
+ *
+ * A thread has at most one synchronous request outstanding at a time, so one completion object
+ * per thread is reused for all of its requests.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct le_msg_LocalCompletion
+{
+#if LE_CONFIG_LINUX
+    int state;              ///< COMPLETION_PENDING, COMPLETION_WAITING or COMPLETION_DONE.
+                            ///  Also the futex word the thread sleeps on.
+#else
+    le_sem_Ref_t semRef;    ///< Posted when the response is ready.
+#endif
+}
+msg_LocalCompletion_t;
+
+#if LE_CONFIG_LINUX
+/// The response has not arrived and the waiting thread is not asleep.
+#define COMPLETION_PENDING  0
+/// The response has not arrived and the waiting thread is (or is about to be) asleep.
+#define COMPLETION_WAITING  1
+/// The response has arrived.
+#define COMPLETION_DONE     2
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Static pool for completion objects.  One per thread that makes synchronous requests.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(LocalCompletion, LE_CONFIG_MAX_THREAD_POOL_SIZE,
+    sizeof(msg_LocalCompletion_t));
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for completion objects.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t CompletionPool;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key used to find the calling thread's completion object.
+ */
+//--------------------------------------------------------------------------------------------------
+static pthread_key_t ThreadLocalCompletionKey;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Static pool for client sessions
@@ -122,32 +181,143 @@ static inline void SignalServiceReady
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Initialize global data required by low-level messaging API.
+ * Destructor for completion objects.
  */
 //--------------------------------------------------------------------------------------------------
-void msgLocal_Init
+static void CompletionDestructor
+(
+    void* completionVoidPtr     ///< [in] completion object
+)
+{
+#if LE_CONFIG_LINUX
+    LE_UNUSED(completionVoidPtr);
+#else
+    msg_LocalCompletion_t* completionPtr = completionVoidPtr;
+
+    le_sem_Delete(completionPtr->semRef);
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the calling thread's completion object, creating it on first use, and get it ready for a
+ * new request.
+ *
+ * @return Pointer to the completion object.
+ */
+//--------------------------------------------------------------------------------------------------
+static msg_LocalCompletion_t* StartCompletion
 (
     void
 )
 {
-    SessionPool = le_mem_InitStaticPool(ClientSession,
-                                        LE_CONFIG_MAX_MSG_LOCAL_CLIENT_SESSION_POOL_SIZE,
-                                        sizeof(msg_LocalSession_t));
+    msg_LocalCompletion_t* completionPtr = pthread_getspecific(ThreadLocalCompletionKey);
+
+    if (completionPtr == NULL)
+    {
+        completionPtr = le_mem_Alloc(CompletionPool);
+#if !LE_CONFIG_LINUX
+        completionPtr->semRef = le_sem_Create("msgResponseReady", 0);
+#endif
+        LE_ASSERT(pthread_setspecific(ThreadLocalCompletionKey, completionPtr) == 0);
+    }
+
+#if LE_CONFIG_LINUX
+    __atomic_store_n(&completionPtr->state, COMPLETION_PENDING, __ATOMIC_RELAXED);
+#endif
+
+    return completionPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Block the calling thread until its completion object is signalled.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WaitCompletion
+(
+    msg_LocalCompletion_t* completionPtr    ///< [in] The calling thread's completion object.
+)
+{
+#if LE_CONFIG_LINUX
+    int state = COMPLETION_PENDING;
+
+    // Announce that we are going to sleep, unless the response has already arrived.
+    if (__atomic_compare_exchange_n(&completionPtr->state, &state, COMPLETION_WAITING, false,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+    {
+        // The futex returns straight away if the state has changed since, and may also return
+        // early because of a signal, so check the state again every time.
+        while (__atomic_load_n(&completionPtr->state, __ATOMIC_ACQUIRE) == COMPLETION_WAITING)
+        {
+            if ((syscall(SYS_futex, &completionPtr->state, FUTEX_WAIT_PRIVATE,
+                         COMPLETION_WAITING, NULL, NULL, 0) != 0) &&
+                (errno != EAGAIN) && (errno != EINTR))
+            {
+                LE_FATAL("futex wait failed. errno = %d (%m).", errno);
+            }
+        }
+    }
+#else
+    le_sem_Wait(completionPtr->semRef);
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Signal a thread's completion object, waking the thread up if it is waiting on it.
+ *
+ * @note The woken thread may carry on and even exit before this returns.  Completion objects come
+ *       from a pool whose memory is never freed, so waking a released one is harmless.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SignalCompletion
+(
+    msg_LocalCompletion_t* completionPtr    ///< [in] Completion object of the waiting thread.
+)
+{
+#if LE_CONFIG_LINUX
+    // Only make the system call if the thread is actually asleep.
+    if (__atomic_exchange_n(&completionPtr->state, COMPLETION_DONE, __ATOMIC_RELEASE) ==
+        COMPLETION_WAITING)
+    {
+        syscall(SYS_futex, &completionPtr->state, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+#else
+    le_sem_Post(completionPtr->semRef);
+#endif
 }
 
+
 //--------------------------------------------------------------------------------------------------
 /**
- * Destructor for messages.
+ * Initialize global data required by low-level messaging API.
  */
 //--------------------------------------------------------------------------------------------------
-static void MessageDestructor
+void msgLocal_Init
 (
-    void* msgVoidPtr               ///< [in] message
+    void
 )
 {
-    le_msg_LocalMessage_t* msgPtr = msgVoidPtr;
+    SessionPool = le_mem_InitStaticPool(ClientSession,
+                                        LE_CONFIG_MAX_MSG_LOCAL_CLIENT_SESSION_POOL_SIZE,
+                                        sizeof(msg_LocalSession_t));
+
+    CompletionPool = le_mem_InitStaticPool(LocalCompletion,
+                                           LE_CONFIG_MAX_THREAD_POOL_SIZE,
+                                           sizeof(msg_LocalCompletion_t));
+    le_mem_SetDestructor(CompletionPool, CompletionDestructor);
 
-    le_sem_Delete(msgPtr->responseReady);
+    // Completion objects are released when their thread exits.
+    int result = pthread_key_create(&ThreadLocalCompletionKey, le_mem_Release);
+    if (result != 0)
+    {
+        LE_FATAL("Failed to create thread local key: result = %d (%s).",
+                 result, LE_ERRNO_TXT(result));
+    }
 }
 
 
@@ -177,7 +347,6 @@ le_msg_ServiceRef_t le_msg_InitLocalService
         servicePtr->receiver.handler = NULL;
         servicePtr->receiver.contextPtr = NULL;
         servicePtr->messagePool = messagePoolRef;
-        le_mem_SetDestructor(servicePtr->messagePool, MessageDestructor);
 
         return &servicePtr->service;
     }
@@ -470,7 +639,7 @@ le_msg_MessageRef_t msgLocal_CreateMsg
     le_msg_LocalService_t* servicePtr = sessionRef->servicePtr;
     le_msg_LocalMessage_t* msgPtr = le_mem_Alloc(servicePtr->messagePool);
     msgPtr->message.sessionRef = &sessionRef->session;
-    msgPtr->responseReady = le_sem_Create("msgResponseReady", 0);
+    msgPtr->responseReadyPtr = NULL;
     msgPtr->fd = -1;
     msgPtr->completionCallback = NULL;
     msgPtr->contextPtr = NULL;
@@ -811,11 +980,13 @@ le_msg_MessageRef_t msgLocal_RequestSyncResponse
     le_msg_LocalMessage_t* localMsgPtr = CONTAINER_OF(msgRef, le_msg_LocalMessage_t, message);
 
     localMsgPtr->needsResponse = true;
+    localMsgPtr->responseReadyPtr = StartCompletion();
 
     msgLocal_SendRaw(localMsgPtr);
 
     // Wait for handover of message back to client
-    le_sem_Wait(localMsgPtr->responseReady);
+    WaitCompletion(localMsgPtr->responseReadyPtr);
+    localMsgPtr->responseReadyPtr = NULL;
 
     // One message is shared for both send & receive, so return same message that came in.
     return msgRef;
@@ -853,9 +1024,9 @@ void msgLocal_Respond
                                        msgRef,
                                        localMsgPtr->contextPtr);
     }
-    else
+    else if (localMsgPtr->responseReadyPtr != NULL)
     {
-        le_sem_Post(localMsgPtr->responseReady);
+        SignalCompletion(localMsgPtr->responseReadyPtr);
     }
 }
 
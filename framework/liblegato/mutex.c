@@ -28,6 +28,11 @@
  *  -# What type of mutex is a given mutex? (recursive?)
  *    - Stored in each Mutex object as a boolean flag.
  *
+ * When @ref LE_CONFIG_LOCK_STATS is enabled, each Mutex object also has a slot in the statistics
+ * page where it counts its acquisitions and contended acquisitions, and times how long it is
+ * waited for and held.  A lock is first attempted without blocking, and the wait is only timed
+ * if that fails.  The counters are updated while the mutex is held.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
@@ -184,6 +189,11 @@ le_mutex_Ref_t CreateMutex
     }
 #endif /* end LE_CONFIG_MUTEX_NAMES_ENABLED */
 
+#if LE_CONFIG_LOCK_STATS
+    mutexPtr->statsSlotPtr = statsPage_AllocSlot(STATSPAGE_TABLE_LOCK, MUTEX_NAME(mutexPtr->name));
+    mutexPtr->lockedAtNs = 0;
+#endif
+
     // Initialize the underlying POSIX mutex according to whether the mutex is recursive or not.
     pthread_mutexattr_t mutexAttrs;
     pthread_mutexattr_init(&mutexAttrs);
@@ -265,6 +275,44 @@ static void RemoveFromWaitingList
 }
 #endif
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Block until a mutex can be locked, keeping track of the waiting threads for the inspect tool.
+ *
+ * @return Result of pthread_mutex_lock().
+ */
+//--------------------------------------------------------------------------------------------------
+static int WaitForLock
+(
+    Mutex_t*            mutexPtr,
+    mutex_ThreadRec_t*  perThreadRecPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    int result;
+
+#if LE_CONFIG_LINUX_TARGET_TOOLS
+    if (perThreadRecPtr)
+    {
+        AddToWaitingList(mutexPtr, perThreadRecPtr);
+    }
+#else
+    LE_UNUSED(perThreadRecPtr);
+#endif
+
+    result = pthread_mutex_lock(&mutexPtr->mutex);
+
+#if LE_CONFIG_LINUX_TARGET_TOOLS
+    if (perThreadRecPtr)
+    {
+        RemoveFromWaitingList(mutexPtr, perThreadRecPtr);
+    }
+#endif
+
+    return result;
+}
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Mark a mutex "locked".
@@ -284,6 +332,13 @@ static void MarkLocked
 )
 //--------------------------------------------------------------------------------------------------
 {
+#if LE_CONFIG_LOCK_STATS
+    if (mutexPtr->statsSlotPtr != NULL)
+    {
+        mutexPtr->lockedAtNs = statsPage_GetLockTimeNs();
+    }
+#endif
+
 #if LE_CONFIG_LINUX_TARGET_TOOLS
     if (perThreadRecPtr)
     {
@@ -323,6 +378,14 @@ static void MarkUnlocked
 )
 //--------------------------------------------------------------------------------------------------
 {
+#if LE_CONFIG_LOCK_STATS
+    if (mutexPtr->statsSlotPtr != NULL)
+    {
+        statsPage_RecordLockHeld(mutexPtr->statsSlotPtr,
+                                 statsPage_GetLockTimeNs() - mutexPtr->lockedAtNs);
+    }
+#endif
+
 #if LE_CONFIG_LINUX_TARGET_TOOLS
     mutex_ThreadRec_t* perThreadRecPtr = thread_TryGetMutexRecPtr();
 
@@ -532,6 +595,10 @@ void le_mutex_Delete
         }
     }
 
+#if LE_CONFIG_LOCK_STATS
+    statsPage_FreeSlot(mutexRef->statsSlotPtr);
+#endif
+
     // Release the Mutex object back to the Mutex Pool.
     le_mem_Release(mutexRef);
 }
@@ -552,20 +619,22 @@ void le_mutex_Lock
 
     mutex_ThreadRec_t* perThreadRecPtr = thread_TryGetMutexRecPtr();
 
-#if LE_CONFIG_LINUX_TARGET_TOOLS
-    if (perThreadRecPtr)
+#if LE_CONFIG_LOCK_STATS
+    uint64_t waitNs = 0;
+
+    // Only time the wait if the mutex is taken, to keep the uncontended path cheap.
+    result = pthread_mutex_trylock(&mutexRef->mutex);
+    bool isContended = (result == EBUSY);
+    if (isContended)
     {
-        AddToWaitingList(mutexRef, perThreadRecPtr);
-    }
-#endif
+        uint64_t waitStartNs = statsPage_GetLockTimeNs();
 
-    result = pthread_mutex_lock(&mutexRef->mutex);
+        result = WaitForLock(mutexRef, perThreadRecPtr);
 
-#if LE_CONFIG_LINUX_TARGET_TOOLS
-    if (perThreadRecPtr)
-    {
-        RemoveFromWaitingList(mutexRef, perThreadRecPtr);
+        waitNs = statsPage_GetLockTimeNs() - waitStartNs;
     }
+#else
+    result = WaitForLock(mutexRef, perThreadRecPtr);
 #endif
 
     if (result == 0)
@@ -584,6 +653,10 @@ void le_mutex_Lock
 
         // Update the lock count.
         mutexRef->lockCount++;
+
+#if LE_CONFIG_LOCK_STATS
+        statsPage_RecordLockAcquired(mutexRef->statsSlotPtr, isContended, waitNs);
+#endif
     }
     else
     {
@@ -641,6 +714,10 @@ le_result_t le_mutex_TryLock
 
         // Update the lock count.
         mutexRef->lockCount++;
+
+#if LE_CONFIG_LOCK_STATS
+        statsPage_RecordLockAcquired(mutexRef->statsSlotPtr, false, 0);
+#endif
     }
     else if (result == EBUSY)
     {
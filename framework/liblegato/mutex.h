@@ -9,6 +9,8 @@
 #ifndef LEGATO_SRC_MUTEX_H_INCLUDE_GUARD
 #define LEGATO_SRC_MUTEX_H_INCLUDE_GUARD
 
+#include "statsPage.h"
+
 /// Maximum number of bytes in a mutex name (including null terminator).
 #define MAX_NAME_BYTES 24
 
@@ -32,6 +34,10 @@ typedef struct le_mutex
 #if LE_CONFIG_MUTEX_NAMES_ENABLED
     char                name[MAX_NAME_BYTES]; ///< The name of the mutex (UTF8 string).
 #endif
+#if LE_CONFIG_LOCK_STATS
+    statsPage_LockSlot_t* statsSlotPtr; ///< Statistics page slot, or NULL.
+    uint64_t            lockedAtNs;     ///< When the lock was taken, to measure the hold time.
+#endif
 }
 Mutex_t;
 
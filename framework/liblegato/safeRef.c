@@ -2,6 +2,13 @@
  *
  * Legato @ref c_safeRef implementation.
  *
+ * Each map keeps its entries in an initial block of maxRefs entries, followed by an overflow block
+ * which is grown if more references are needed.  Deleted entries are queued in a free list and
+ * reused oldest first, once all the entries have been used at least once, so creating, looking up
+ * and deleting a reference take constant time.  Every entry has a generation counter which is
+ * incremented when its reference is deleted and which is part of the reference, so that a stale
+ * reference is rejected even after its entry is reused.
+ *
  * @note We use only odd numbers for Safe References.  This ensures that it will not be a
  *       word-aligned memory address modern systems (which are always even).
  *       This prevents Safe References from getting confused with pointers.
@@ -18,7 +25,7 @@
 //  PRIVATE DATA
 // =============================================
 
-// Number of pointers in each overflow block
+// Minimum number of entries in the overflow block
 #define OVERFLOW_BLOCK_SIZE 32
 
 // Offset for safety bit in a safe ref
@@ -31,10 +38,21 @@
 // Bitmask for map base value in a safe ref
 #define REF_BASE_MASK       UINT32_C(0xFF)
 
+// Offset of generation in a safe ref
+#define REF_GEN_OFFSET      (REF_BASE_OFFSET + UINT32_C(8))
+// Bitmask for generation in a safe ref
+#define REF_GEN_MASK        UINT32_C(0x3F)
+
 // Offset of index in a safe ref
-#define REF_INDEX_OFFSET    (REF_BASE_OFFSET + UINT32_C(8))
-// Offset of index in a safe ref
-#define REF_INDEX_MASK      UINT32_C(0x7FFFFF)
+#define REF_INDEX_OFFSET    (REF_GEN_OFFSET + UINT32_C(6))
+// Bitmask for index in a safe ref
+#define REF_INDEX_MASK      UINT32_C(0x1FFFF)
+
+// Index marking the end of the free list.  It is never used by an entry.
+#define NO_INDEX            ((size_t) REF_INDEX_MASK)
+
+// Offset of the next free entry index in the information of a free entry
+#define SLOT_NEXT_OFFSET    UINT32_C(6)
 
 // Buffer length for dumping a safe reference
 #define REF_DBG_BUFFER_LENGTH   64
@@ -92,6 +110,21 @@ LE_DEFINE_INLINE void *le_ref_CreateFastRef
 #   define SAFE_REF_TRACE(mapRef, ...)   (void) (mapRef)
 #endif /* end LE_CONFIG_SAFE_REF_NAMES_ENABLED */
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference slot, which stores a pointer and the generation of its entry.
+ *
+ * The information word holds the generation in its low bits and, while the slot is free, the index
+ * of the next free slot above them.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    void        *ptr;       ///< Stored pointer, NULL if the slot is free.
+    uintptr_t    info;      ///< Generation and next free slot index.
+}
+Slot_t;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Reference Block object, which stores pointer slots and their status.
@@ -99,8 +132,8 @@ LE_DEFINE_INLINE void *le_ref_CreateFastRef
 //--------------------------------------------------------------------------------------------------
 struct le_ref_Block
 {
-    struct le_ref_Block *nextPtr;   ///< Next (overflow) block in the linked list.
-    void                *slots[];   ///< Pointer slots.
+    size_t       slotCount; ///< Number of slots in the block.
+    Slot_t       slots[];   ///< Pointer slots.
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -124,10 +157,10 @@ static size_t   *RefMapListChangeCountRef = &RefMapListChangeCount;
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Determine the block number from a reference index.
+ *  Get the slot of a reference index.  The index must be lower than the map size.
  */
 //--------------------------------------------------------------------------------------------------
-static inline size_t IndexToBlockNum
+static inline Slot_t *GetSlot
 (
     le_ref_MapRef_t mapRef, ///< Reference map instance.
     size_t          index   ///< Reference index.
@@ -135,64 +168,50 @@ static inline size_t IndexToBlockNum
 {
     if (index < mapRef->maxRefs)
     {
-        return 0;
+        return &mapRef->blocksPtr->slots[index];
     }
-    return (index - mapRef->maxRefs) / OVERFLOW_BLOCK_SIZE + 1;
+    return &mapRef->overflowPtr->slots[index - mapRef->maxRefs];
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Determine the slot within a block from a reference index.
+ *  Get the generation of a slot.
  */
 //--------------------------------------------------------------------------------------------------
-static inline size_t IndexToSlot
+static inline uint32_t SlotGen
 (
-    le_ref_MapRef_t mapRef, ///< Reference map instance.
-    size_t          index   ///< Reference index.
+    const Slot_t *slotPtr   ///< Slot.
 )
 {
-    if (index < mapRef->maxRefs)
-    {
-        return index;
-    }
-    return (index - mapRef->maxRefs) % OVERFLOW_BLOCK_SIZE;
+    return slotPtr->info & REF_GEN_MASK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Determine the number of slots in a given block.
+ *  Get the index of the free slot following a free slot.
  */
 //--------------------------------------------------------------------------------------------------
-static inline size_t SlotsInBlock
+static inline size_t SlotNext
 (
-    le_ref_MapRef_t mapRef,     ///< Reference map instance.
-    size_t          blockNum    ///< Block number.
+    const Slot_t *slotPtr   ///< Slot.
 )
 {
-    if (blockNum == 0)
-    {
-        return mapRef->maxRefs;
-    }
-    return OVERFLOW_BLOCK_SIZE;
+    return (slotPtr->info >> SLOT_NEXT_OFFSET) & REF_INDEX_MASK;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Compose a reference index from a block number and a slot number.
+ *  Set the generation of a slot and the index of the free slot following it.
  */
 //--------------------------------------------------------------------------------------------------
-static inline size_t BlockAndSlotToIndex
+static inline void SetSlotInfo
 (
-    le_ref_MapRef_t mapRef,     ///< Reference map instance.
-    size_t          blockNum,   ///< Block number.
-    size_t          slotNum     ///< Slot number.
+    Slot_t     *slotPtr,    ///< Slot.
+    uint32_t    gen,        ///< Generation.
+    size_t      next        ///< Next free slot index, NO_INDEX if none or if the slot is used.
 )
 {
-    if (blockNum == 0)
-    {
-        return slotNum;
-    }
-    return mapRef->maxRefs + (blockNum - 1) * OVERFLOW_BLOCK_SIZE + slotNum;
+    slotPtr->info = (gen & REF_GEN_MASK) | ((uintptr_t) (next & REF_INDEX_MASK) << SLOT_NEXT_OFFSET);
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -211,6 +230,9 @@ static void InitMap
     struct le_ref_Block *initialBlock   ///< Allocated initial block.
 )
 {
+    LE_FATAL_IF(maxRefs >= NO_INDEX, "Too many references (%" PRIuS ") for a reference map",
+                maxRefs);
+
 #if LE_CONFIG_SAFE_REF_NAMES_ENABLED
     size_t strLen;
 
@@ -233,10 +255,15 @@ static void InitMap
 
     // Do not zero members as these are pre-zeroed entering this function.
     // Not zeroing also helps debug double-initialization bugs.
+    // The slots are used in order the first time, so they do not need to be linked in the free
+    // list now.
     mapPtr->size = maxRefs;
     mapPtr->index = maxRefs;
     mapPtr->maxRefs = maxRefs;
+    mapPtr->freeHead = NO_INDEX;
+    mapPtr->freeTail = NO_INDEX;
     mapPtr->blocksPtr = initialBlock;
+    mapPtr->blocksPtr->slotCount = maxRefs;
 
     ++RefMapListChangeCount;
     le_dls_Stack(&RefMapList, &mapPtr->entry);
@@ -253,6 +280,7 @@ static void InitMap
 static inline void *MakeRef
 (
     uint32_t    mapBase,    ///< Map's base value.
+    uint32_t    gen,        ///< Entry's generation.
     size_t      index       ///< Pointer index.
 )
 {
@@ -260,6 +288,7 @@ static inline void *MakeRef
 
     ref |= REF_SAFETY_MASK << REF_SAFETY_OFFSET;
     ref |= (mapBase & REF_BASE_MASK) << REF_BASE_OFFSET;
+    ref |= (gen & REF_GEN_MASK) << REF_GEN_OFFSET;
     ref |= (index & REF_INDEX_MASK) << REF_INDEX_OFFSET;
 
     return (void *) ref;
@@ -267,68 +296,60 @@ static inline void *MakeRef
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Decompose a safe reference into the corresponding block index and slot.
+ *  Decompose a safe reference into the corresponding index and generation.
  *
- *  @return Validity of the safe reference.
+ *  @return Validity of the safe reference's map and index.
  */
 //--------------------------------------------------------------------------------------------------
 static bool ReadRef
 (
     const le_ref_MapRef_t    mapRef,    ///< [IN]   Reference map instance.
     const void              *safeRef,   ///< [IN]   Safe reference to decompose.
-    size_t                  *blockNum,  ///< [OUT]  Block index.
-    size_t                  *slot       ///< [OUT]  Slot number within block.
+    size_t                  *index,     ///< [OUT]  Entry index.
+    uint32_t                *gen        ///< [OUT]  Entry generation.
 )
 {
-    size_t      index;
     uint32_t    base;
     uintptr_t   ref = (uintptr_t) safeRef;
     uintptr_t   safety;
 
     safety = (ref >> REF_SAFETY_OFFSET) & REF_SAFETY_MASK;
     base = (ref >> REF_BASE_OFFSET) & REF_BASE_MASK;
-    index = (ref >> REF_INDEX_OFFSET) & REF_INDEX_MASK;
-
-    *blockNum = IndexToBlockNum(mapRef, index);
-    *slot = IndexToSlot(mapRef, index);
+    *gen = (ref >> REF_GEN_OFFSET) & REF_GEN_MASK;
+    *index = (ref >> REF_INDEX_OFFSET) & REF_INDEX_MASK;
 
-    return (safety == REF_SAFETY_MASK && base == mapRef->mapBase && index < mapRef->size);
+    return (safety == REF_SAFETY_MASK && base == mapRef->mapBase && *index < mapRef->usedCount);
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Retrieve the stored pointer corresponding to a safe reference.
+ *  Retrieve the slot corresponding to a safe reference.
  *
- *  @return A pointer to the slot, or NULL if the reference was invalid.
+ *  @return A pointer to the slot, or NULL if the reference was invalid or has been deleted.
  */
 //--------------------------------------------------------------------------------------------------
-static void **FindSlot
+static Slot_t *FindSlot
 (
     const le_ref_MapRef_t    mapRef,    ///< [IN]   Reference map instance.
     const void              *safeRef    ///< [IN]   Safe reference.
 )
 {
-    size_t               blockNum;
-    size_t               i;
-    size_t               slot;
-    struct le_ref_Block *block;
+    size_t       index;
+    uint32_t     gen;
+    Slot_t      *slotPtr;
 
-    if (!ReadRef(mapRef, safeRef, &blockNum, &slot))
+    if (!ReadRef(mapRef, safeRef, &index, &gen))
     {
         return NULL;
     }
 
-    block = mapRef->blocksPtr;
-    for (i = 1; i <= blockNum; ++i)
+    slotPtr = GetSlot(mapRef, index);
+    if (slotPtr->ptr == NULL || SlotGen(slotPtr) != gen)
     {
-        if (block->nextPtr == NULL)
-        {
-            return NULL;
-        }
-        block = block->nextPtr;
+        return NULL;
     }
 
-    return &block->slots[slot];
+    return slotPtr;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -347,36 +368,48 @@ const char *DebugSafeRef
 )
 {
     bool        valid;
-    size_t      blockNum;
-    size_t      slot;
+    size_t      index;
+    uint32_t    gen;
     uint32_t    base;
 
-    valid = ReadRef(mapRef, ref, &blockNum, &slot);
+    valid = ReadRef(mapRef, ref, &index, &gen);
     base = (uint32_t) ((uintptr_t) ref >> REF_BASE_OFFSET) & REF_BASE_MASK;
     snprintf(buffer, REF_DBG_BUFFER_LENGTH,
-        "<%p>(Bm:%" PRIX32 " Br:%" PRIX32 " N:%" PRIuS " S:%" PRIuS " V:%c)",
-        ref, mapRef->mapBase, base, blockNum, slot, (valid ? 'T' : 'F'));
+        "<%p>(Bm:%" PRIX32 " Br:%" PRIX32 " I:%" PRIuS " G:%" PRIu32 " V:%c)",
+        ref, mapRef->mapBase, base, index, gen, (valid ? 'T' : 'F'));
 
     return buffer;
 }
 
 //--------------------------------------------------------------------------------------------------
 /**
- *  Allocate a new overflow block.  This occurs if the maxRefs limit is exceeded.
- *
- *  @return The new overflow block.
+ *  Grow the overflow block.  This occurs if the maxRefs limit is exceeded.  The overflow block
+ *  size is doubled every time, so that the cost of the growth remains constant per reference.
  */
 //--------------------------------------------------------------------------------------------------
-static struct le_ref_Block *NewOverflowBlock
+static void GrowOverflowBlock
 (
-    void
+    le_ref_MapRef_t mapRef  ///< Reference map instance.
 )
 {
-    struct le_ref_Block *block = malloc(LE_REF_BLOCK_SIZE(OVERFLOW_BLOCK_SIZE) * sizeof(void *));
+    size_t               oldCount = (mapRef->overflowPtr ? mapRef->overflowPtr->slotCount : 0);
+    size_t               newCount = (oldCount ? 2 * oldCount : OVERFLOW_BLOCK_SIZE);
+    struct le_ref_Block *block;
+
+    if (mapRef->maxRefs + newCount > NO_INDEX)
+    {
+        newCount = NO_INDEX - mapRef->maxRefs;
+    }
+    LE_FATAL_IF(newCount <= oldCount, "Safe reference map %s is full (%" PRIuS " references)",
+        SAFEREF_NAME(mapRef->name), mapRef->size);
+
+    block = realloc(mapRef->overflowPtr, sizeof(*block) + newCount * sizeof(Slot_t));
     LE_ASSERT(block != NULL);
 
-    memset(block, 0, LE_REF_BLOCK_SIZE(OVERFLOW_BLOCK_SIZE) * sizeof(void *));
-    return block;
+    memset(&block->slots[oldCount], 0, (newCount - oldCount) * sizeof(Slot_t));
+    block->slotCount = newCount;
+    mapRef->overflowPtr = block;
+    mapRef->size = mapRef->maxRefs + newCount;
 }
 
 
@@ -398,7 +431,7 @@ static void *Lookup
 #if LE_CONFIG_SAFE_REF_NAMES_ENABLED
     char      buffer[REF_DBG_BUFFER_LENGTH];
 #endif
-    void    **result;
+    Slot_t   *result;
 
     SAFE_REF_TRACE(mapRef, "Looking up safe reference %s in %s",
         DebugSafeRef(mapRef, safeRef, buffer), SAFEREF_NAME(mapRef->name));
@@ -410,8 +443,8 @@ static void *Lookup
         return NULL;
     }
 
-    SAFE_REF_TRACE(mapRef, "    Found entry %p at %p", *result, result);
-    return *result;
+    SAFE_REF_TRACE(mapRef, "    Found entry %p at %p", result->ptr, result);
+    return result->ptr;
 }
 
 // =============================================
@@ -501,12 +534,8 @@ void *le_ref_CreateRef
 #if LE_CONFIG_SAFE_REF_NAMES_ENABLED
     char                 buffer[REF_DBG_BUFFER_LENGTH];
 #endif
-    size_t               blockCount = IndexToBlockNum(mapRef, mapRef->size - 1) + 1;
-    size_t               i;
     size_t               index;
-    size_t               j;
-    size_t               slotCount;
-    struct le_ref_Block *block;
+    Slot_t              *slotPtr;
     void                *result = NULL;
 
     SAFE_REF_TRACE(mapRef, "Creating safe reference for %p in %s", ptr, SAFEREF_NAME(mapRef->name));
@@ -515,42 +544,37 @@ void *le_ref_CreateRef
         goto end;
     }
 
-    block = mapRef->blocksPtr;
-    for (i = 0; i < blockCount; ++i)
+    // Use the slots which have never been used first, then the oldest deleted one, so that a slot
+    // is reused as late as possible.
+    if (mapRef->usedCount == mapRef->size && mapRef->freeHead == NO_INDEX)
     {
-        slotCount = SlotsInBlock(mapRef, i);
-        for (j = 0; j < slotCount; ++j)
-        {
-            if (block->slots[j] == NULL)
-            {
-                index = BlockAndSlotToIndex(mapRef, i, j);
-                block->slots[j] = ptr;
-                SAFE_REF_TRACE(mapRef, "    Inserted %p at %" PRIuS " (%p)", ptr, index,
-                    &block->slots[j]);
-                result = MakeRef(mapRef->mapBase, index);
-                goto end;
-            }
-        }
+        GrowOverflowBlock(mapRef);
+        SAFE_REF_TRACE(mapRef, "    Grown overflow block %p", mapRef->overflowPtr);
+        LE_WARN("Safe reference map maximum exceeded for %s, new size %" PRIuS,
+                SAFEREF_NAME(mapRef->name), mapRef->size);
+        mapRef->index = mapRef->size;
+    }
 
-        if (block->nextPtr == NULL)
+    if (mapRef->usedCount < mapRef->size)
+    {
+        index = mapRef->usedCount++;
+        slotPtr = GetSlot(mapRef, index);
+    }
+    else
+    {
+        index = mapRef->freeHead;
+        slotPtr = GetSlot(mapRef, index);
+        mapRef->freeHead = SlotNext(slotPtr);
+        if (mapRef->freeHead == NO_INDEX)
         {
-            break;
+            mapRef->freeTail = NO_INDEX;
         }
-        block = block->nextPtr;
     }
 
-    index = BlockAndSlotToIndex(mapRef, blockCount, 0);
-    block->nextPtr = NewOverflowBlock();
-    block = block->nextPtr;
-    SAFE_REF_TRACE(mapRef, "    Created new overflow block %p", block);
-
-    block->slots[0] = ptr;
-    SAFE_REF_TRACE(mapRef, "    Inserted %p at %" PRIuS " (%p)", ptr, index, &block->slots[0]);
-    result = MakeRef(mapRef->mapBase, index);
-    mapRef->size += OVERFLOW_BLOCK_SIZE;
-    LE_WARN("Safe reference map maximum exceeded for %s, new size %" PRIuS,
-            SAFEREF_NAME(mapRef->name), mapRef->size);
-    mapRef->index = mapRef->size;
+    slotPtr->ptr = ptr;
+    SetSlotInfo(slotPtr, SlotGen(slotPtr), NO_INDEX);
+    SAFE_REF_TRACE(mapRef, "    Inserted %p at %" PRIuS " (%p)", ptr, index, slotPtr);
+    result = MakeRef(mapRef->mapBase, SlotGen(slotPtr), index);
 
 end:
     SAFE_REF_TRACE(mapRef, "    Resulting safe reference is %s",
@@ -594,21 +618,37 @@ void le_ref_DeleteRef
 #if LE_CONFIG_SAFE_REF_NAMES_ENABLED
     char      buffer[REF_DBG_BUFFER_LENGTH];
 #endif
-    void    **slot;
+    size_t    index;
+    uint32_t  gen;
+    Slot_t   *slotPtr;
 
     SAFE_REF_TRACE(mapRef, "Deleting safe reference %s in %s",
         DebugSafeRef(mapRef, safeRef, buffer), SAFEREF_NAME(mapRef->name));
 
-    slot = FindSlot(mapRef, safeRef);
-    if (slot == NULL || *slot == NULL)
+    slotPtr = FindSlot(mapRef, safeRef);
+    if (slotPtr == NULL)
     {
         LE_ERROR("Deleting non-existent Safe Reference %p from Map '%s'.", safeRef,
             SAFEREF_NAME(mapRef->name));
+        return;
+    }
+
+    // Bump the generation to invalidate the reference, and queue the slot for reuse
+    ReadRef(mapRef, safeRef, &index, &gen);
+    slotPtr->ptr = NULL;
+    SetSlotInfo(slotPtr, gen + 1, NO_INDEX);
+
+    if (mapRef->freeTail == NO_INDEX)
+    {
+        mapRef->freeHead = index;
     }
     else
     {
-        *slot = NULL;
+        Slot_t *tailPtr = GetSlot(mapRef, mapRef->freeTail);
+
+        SetSlotInfo(tailPtr, SlotGen(tailPtr), index);
     }
+    mapRef->freeTail = index;
 }
 
 
@@ -650,7 +690,6 @@ le_result_t le_ref_NextNode
 )
 {
     le_ref_MapRef_t   mapRef = (le_ref_MapRef_t) iteratorRef;
-    void            **slot;
 
     SAFE_REF_TRACE(mapRef, "Continuing iteration in %s", SAFEREF_NAME(mapRef->name));
 
@@ -665,10 +704,9 @@ le_result_t le_ref_NextNode
     }
     mapRef->advance = false;
 
-    while (mapRef->index < mapRef->size)
+    while (mapRef->index < mapRef->usedCount)
     {
-        slot = FindSlot(mapRef, MakeRef(mapRef->mapBase, mapRef->index));
-        if (slot != NULL && *slot != NULL)
+        if (GetSlot(mapRef, mapRef->index)->ptr != NULL)
         {
             SAFE_REF_TRACE(mapRef, "    Found next item at index %" PRIuS, mapRef->index);
             mapRef->advance = true;
@@ -705,7 +743,7 @@ const void* le_ref_GetSafeRef
 
     if (mapRef->index < mapRef->size)
     {
-        return MakeRef(mapRef->mapBase, mapRef->index);
+        return MakeRef(mapRef->mapBase, SlotGen(GetSlot(mapRef, mapRef->index)), mapRef->index);
     }
 
     return NULL;
@@ -22,6 +22,10 @@
  *  -# What threads, if any, are currently waiting on a given semaphore?
  *    - Each Semaphore object has a list of Per-Thread Semaphore Records for this.
  *
+ * When @ref LE_CONFIG_LOCK_STATS is enabled, each Semaphore object also has a slot in the
+ * statistics page where it counts its successful waits, and how many of them had to block and for
+ * how long.  A wait is first attempted without blocking, and only timed if that fails.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
@@ -282,6 +286,12 @@ le_sem_Ref_t _le_sem_Create
     }
 #endif /* end LE_CONFIG_SEM_NAMES_ENABLED */
 
+#if LE_CONFIG_LOCK_STATS
+    semaphorePtr->statsSlotPtr = statsPage_AllocSlot(STATSPAGE_TABLE_LOCK,
+                                                     SEM_NAME(semaphorePtr->nameStr));
+    STATSPAGE_SET(semaphorePtr->statsSlotPtr, isSemaphore, 1);
+#endif
+
     // Initialize the underlying POSIX semaphore shared between thread.
     int result = sem_init(&semaphorePtr->semaphore,0, initialCount);
     if (result != 0)
@@ -337,6 +347,10 @@ void le_sem_Delete
         LE_FATAL("Semaphore '%s' is not a valid semaphore!", SEM_NAME(semaphorePtr->nameStr));
     }
 
+#if LE_CONFIG_LOCK_STATS
+    statsPage_FreeSlot(semaphorePtr->statsSlotPtr);
+#endif
+
     // Release the semaphore object back to the Semaphore Pool.
     le_mem_Release(semaphorePtr);
 }
@@ -401,6 +415,17 @@ void le_sem_Wait
 {
     int result;
 
+#if LE_CONFIG_LOCK_STATS
+    // Only time the wait if the semaphore is not available, to keep the uncontended path cheap.
+    if (sem_trywait(&semaphorePtr->semaphore) == 0)
+    {
+        statsPage_RecordLockAcquired(semaphorePtr->statsSlotPtr, false, 0);
+        return;
+    }
+
+    uint64_t waitStartNs = statsPage_GetLockTimeNs();
+#endif
+
 #if LE_CONFIG_LINUX_TARGET_TOOLS
     sem_ThreadRec_t* perThreadRecPtr = thread_TryGetSemaphoreRecPtr();
 
@@ -427,6 +452,11 @@ void le_sem_Wait
                 le_thread_GetMyName(),
                 SEM_NAME(semaphorePtr->nameStr),
                 result);
+
+#if LE_CONFIG_LOCK_STATS
+    statsPage_RecordLockAcquired(semaphorePtr->statsSlotPtr, true,
+                                 statsPage_GetLockTimeNs() - waitStartNs);
+#endif
 }
 
 
@@ -462,6 +492,10 @@ le_result_t le_sem_TryWait
         }
     }
 
+#if LE_CONFIG_LOCK_STATS
+    statsPage_RecordLockAcquired(semaphorePtr->statsSlotPtr, false, 0);
+#endif
+
     return LE_OK;
 }
 
@@ -485,6 +519,16 @@ le_result_t le_sem_WaitWithTimeOut
     struct timespec timeOut;
     int result;
 
+#if LE_CONFIG_LOCK_STATS
+    if (sem_trywait(&semaphorePtr->semaphore) == 0)
+    {
+        statsPage_RecordLockAcquired(semaphorePtr->statsSlotPtr, false, 0);
+        return LE_OK;
+    }
+
+    uint64_t waitStartNs = statsPage_GetLockTimeNs();
+#endif
+
     // Prepare the timer
     le_clk_Time_t currentUtcTime = le_clk_GetAbsoluteTime();
     le_clk_Time_t wakeUpTime = le_clk_Add(currentUtcTime,timeToWait);
@@ -527,6 +571,11 @@ le_result_t le_sem_WaitWithTimeOut
         }
     }
 
+#if LE_CONFIG_LOCK_STATS
+    statsPage_RecordLockAcquired(semaphorePtr->statsSlotPtr, true,
+                                 statsPage_GetLockTimeNs() - waitStartNs);
+#endif
+
     return LE_OK;
 }
 
@@ -11,6 +11,7 @@
 #define LEGATO_SRC_SEMAPHORE_H_INCLUDE_GUARD
 
 #include "limit.h"
+#include "statsPage.h"
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -28,6 +29,9 @@ typedef struct le_sem_t
 #if LE_CONFIG_SEM_NAMES_ENABLED
     char                nameStr[LIMIT_MAX_SEMAPHORE_NAME_BYTES]; ///< The name of the semaphore (UTF8 string).
 #endif
+#if LE_CONFIG_LOCK_STATS
+    statsPage_LockSlot_t* statsSlotPtr;      ///< Statistics page slot, or NULL.
+#endif
 }
 Semaphore_t;
 
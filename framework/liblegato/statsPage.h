@@ -0,0 +1,550 @@
+//--------------------------------------------------------------------------------------------------
+/** @file statsPage.h
+ *
+ * Legato statistics page inter-module include file.
+ *
+ * When @ref LE_CONFIG_STATS_PAGE is enabled, every process using the Legato framework publishes
+ * live statistics about its memory pools, threads (active timers, Event Queue backlog), IPC
+ * sessions (message counters, queue depths) and, if @ref LE_CONFIG_LOCK_STATS is enabled, mutex
+ * and semaphore contention in a page of shared memory.  The page is a memfd named
+ * "le_stats" that stays open in the process, so another process with the right to look at
+ * /proc/<pid>/fd can map it read-only and poll it without stopping or tracing the publisher.
+ *
+ * Layout of the page (all offsets and sizes in bytes, host byte order):
+ *
+ * @verbatim
+   statsPage_Header_t
+   statsPage_PoolSlot_t     [poolCount]      at poolOffset
+   statsPage_ThreadSlot_t   [threadCount]    at threadOffset
+   statsPage_SessionSlot_t  [sessionCount]   at sessionOffset
+   statsPage_LockSlot_t     [lockCount]      at lockOffset
+   @endverbatim
+ *
+ * Readers must check magic and version, and use the slot sizes from the header to step through the
+ * tables so that fields can be appended to slots without breaking them.
+ *
+ * Every slot starts with a sequence number that the publisher makes odd while it (re)assigns the
+ * slot to an object, and even again when done.  A reader copies the slot, then checks that the
+ * sequence number is even and did not change during the copy (see statsPage_ReadSlot()).
+ * Individual counters are updated in place with atomic stores and are not covered by the sequence
+ * number, so two counters of a same slot may be one update apart.
+ *
+ * The lock counters are the only part of the page that readers write to: to reset them, a reader
+ * maps the page writable and increments lockResetCount in the header (see
+ * statsPage_ResetLockStats()).  The publisher zeroes the counters of a lock slot the next time it
+ * updates them and finds that the slot's resetCount is behind, and readers treat the counters of
+ * such a slot as zero in the meantime.
+ *
+ * This file exposes interfaces that are for use by other modules inside the framework
+ * implementation, but must not be used outside of the framework implementation.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+#ifndef LEGATO_STATS_PAGE_INCLUDE_GUARD
+#define LEGATO_STATS_PAGE_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Magic number at the start of a statistics page ("LEST").
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATSPAGE_MAGIC             0x5453454cU
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Version of the statistics page layout.  Bumped when the meaning of an existing field changes;
+ * appending fields to a slot only changes the slot size.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATSPAGE_VERSION           2
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Name of the memfd holding the statistics page, as shown in /proc/<pid>/fd.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATSPAGE_MEMFD_NAME        "le_stats"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the name field of the slots, including the null terminator.  Longer names are truncated.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATSPAGE_NAME_BYTES        48
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Shape of the IPC session latency histograms: number of buckets per power of two, and total
+ * number of buckets.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATSPAGE_LATENCY_SUB_BUCKETS   4
+#define STATSPAGE_LATENCY_BUCKETS       88
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Tables of the statistics page.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    STATSPAGE_TABLE_POOL,       ///< Memory pools.
+    STATSPAGE_TABLE_THREAD,     ///< Threads.
+    STATSPAGE_TABLE_SESSION,    ///< IPC sessions.
+    STATSPAGE_TABLE_LOCK,       ///< Mutexes and semaphores.
+    STATSPAGE_TABLE_COUNT
+}
+statsPage_Table_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Header at the start of the statistics page.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t magic;             ///< STATSPAGE_MAGIC.
+    uint16_t version;           ///< STATSPAGE_VERSION.
+    uint16_t headerSize;        ///< sizeof(statsPage_Header_t).
+    uint32_t pageSize;          ///< Size of the whole page.
+    int32_t  pid;               ///< Process publishing the page.
+    uint32_t droppedCount;      ///< Objects not published because their table was full.
+    uint32_t lockResetCount;    ///< Incremented by readers to reset the lock counters.
+    struct
+    {
+        uint32_t offset;        ///< Offset of the first slot from the start of the page.
+        uint32_t slotSize;      ///< Size of a slot.
+        uint32_t count;         ///< Number of slots.
+        uint32_t reserved;
+    }
+    table[STATSPAGE_TABLE_COUNT];
+}
+statsPage_Header_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fields common to all slots.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t seq;               ///< Odd while the slot is being (re)assigned.
+    uint32_t inUse;             ///< 1 if the slot describes a live object, 0 if it is free.
+    char     name[STATSPAGE_NAME_BYTES]; ///< Name of the object.
+}
+statsPage_SlotHeader_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Memory pool slot.  Maximum used, overflows and allocations stay 0 unless
+ * @ref LE_CONFIG_MEM_POOL_STATS is enabled.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    statsPage_SlotHeader_t hdr;
+    uint32_t isSubPool;         ///< 1 if the pool is a sub-pool.
+    uint32_t blockSize;         ///< Size of a block, including overhead.
+    uint32_t totalBlocks;       ///< Free and allocated blocks.
+    uint32_t numBlocksInUse;    ///< Allocated blocks.
+    uint32_t maxNumBlocksUsed;  ///< High-water mark of the allocated blocks.
+    uint32_t numOverflows;      ///< Times the pool had to be expanded by a forced allocation.
+    uint64_t numAllocations;    ///< Allocations since the pool was created.
+}
+statsPage_PoolSlot_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Thread slot.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    statsPage_SlotHeader_t hdr;
+    int32_t  tid;               ///< Kernel thread ID, or 0 if the thread was not started yet.
+    uint32_t activeTimers;      ///< Timers running on this thread.
+    uint32_t eventBacklog;      ///< Event Reports queued and not yet processed.
+    uint32_t maxEventBacklog;   ///< High-water mark of the Event Queue backlog.
+    uint64_t eventsProcessed;   ///< Event Reports processed by this thread.
+    uint64_t timerExpiries;     ///< Timer expiries handled by this thread.
+}
+statsPage_ThreadSlot_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * IPC session slot.  The name is the name of the session's interface.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    statsPage_SlotHeader_t hdr;
+    uint32_t isServer;          ///< 1 on the server side of the session, 0 on the client side.
+    uint32_t isOpen;            ///< 1 if the session is open.
+    uint32_t txQueueDepth;      ///< Messages waiting to be sent.
+    uint32_t maxTxQueueDepth;   ///< High-water mark of the transmit queue.
+    uint32_t rxQueueDepth;      ///< Messages received and not yet processed.
+    uint32_t pendingTxns;       ///< Requests sent and waiting for their response.
+    uint64_t msgsSent;          ///< Messages written to the socket.
+    uint64_t msgsReceived;      ///< Messages read from the socket.
+    uint64_t latencyCount;      ///< Transactions recorded in the latency histogram.
+    uint64_t latencySumUs;      ///< Sum of the recorded latencies, in microseconds.
+    uint32_t latencyMaxUs;      ///< Largest recorded latency, in microseconds.
+    uint32_t latencyBuckets[STATSPAGE_LATENCY_BUCKETS]; ///< See statsPage_LatencyBucket().
+}
+statsPage_SessionSlot_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Mutex or semaphore slot.  For a semaphore, an acquisition is a successful wait, and the hold
+ * times stay 0.  Waits that time out are not counted.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    statsPage_SlotHeader_t hdr;
+    uint32_t isSemaphore;       ///< 1 for a semaphore, 0 for a mutex.
+    uint32_t resetCount;        ///< Header's lockResetCount when the counters were last zeroed.
+    uint64_t acquisitions;      ///< Locks or successful waits, including recursive locks.
+    uint64_t contended;         ///< Acquisitions that found the lock taken and had to wait.
+    uint64_t waitTotalNs;       ///< Time spent waiting by contended acquisitions.
+    uint64_t waitMaxNs;         ///< Longest wait.
+    uint64_t holdTotalNs;       ///< Time the mutex was held, from first lock to last unlock.
+    uint64_t holdMaxNs;         ///< Longest hold.
+}
+statsPage_LockSlot_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the latency histogram bucket of a latency.
+ *
+ * Buckets are log-linear: latencies below 4 us each have their own bucket, and every power of two
+ * above that is split in 4 buckets, so a bucket is never wider than a quarter of its lower bound.
+ * The last bucket holds latencies of 7.3 s and more.
+ *
+ * @return Index of the bucket.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t statsPage_LatencyBucket
+(
+    uint64_t latencyUs      ///< [IN] Latency, in microseconds.
+)
+{
+    if (latencyUs < STATSPAGE_LATENCY_SUB_BUCKETS)
+    {
+        return (uint32_t)latencyUs;
+    }
+
+    uint32_t msb = 63 - __builtin_clzll(latencyUs);
+    uint32_t index = STATSPAGE_LATENCY_SUB_BUCKETS * (msb - 1) +
+                     ((latencyUs >> (msb - 2)) & (STATSPAGE_LATENCY_SUB_BUCKETS - 1));
+
+    return (index < STATSPAGE_LATENCY_BUCKETS ? index : STATSPAGE_LATENCY_BUCKETS - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the smallest latency that falls in a latency histogram bucket.
+ *
+ * @return Lower bound of the bucket, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t statsPage_LatencyBucketLowerBound
+(
+    uint32_t index          ///< [IN] Index of the bucket.
+)
+{
+    if (index < STATSPAGE_LATENCY_SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    uint32_t msb = index / STATSPAGE_LATENCY_SUB_BUCKETS + 1;
+
+    return (uint64_t)(STATSPAGE_LATENCY_SUB_BUCKETS + index % STATSPAGE_LATENCY_SUB_BUCKETS)
+           << (msb - 2);
+}
+
+
+#if LE_CONFIG_STATS_PAGE
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update helpers used by the publishing modules.  They do nothing if the object has no slot
+ * (table full, or page not created yet), and compile to nothing when the statistics page is
+ * disabled, in which case their arguments are not evaluated.
+ *
+ * STATSPAGE_INC, STATSPAGE_ADD and STATSPAGE_ADD_MAX are safe to use from several threads at
+ * once.  STATSPAGE_SET must be called by a single writer at a time for a given field, which the
+ * object's own lock or thread already ensures.
+ */
+//--------------------------------------------------------------------------------------------------
+#define STATSPAGE_SET(slotPtr, field, value)                                            \
+    do {                                                                                \
+        if ((slotPtr) != NULL)                                                          \
+        {                                                                               \
+            __atomic_store_n(&(slotPtr)->field, (value), __ATOMIC_RELAXED);             \
+        }                                                                               \
+    } while (0)
+
+#define STATSPAGE_INC(slotPtr, field)                                                   \
+    do {                                                                                \
+        if ((slotPtr) != NULL)                                                          \
+        {                                                                               \
+            __atomic_fetch_add(&(slotPtr)->field, 1, __ATOMIC_RELAXED);                 \
+        }                                                                               \
+    } while (0)
+
+#define STATSPAGE_ADD(slotPtr, field, delta)                                            \
+    do {                                                                                \
+        if ((slotPtr) != NULL)                                                          \
+        {                                                                               \
+            __atomic_fetch_add(&(slotPtr)->field, (delta), __ATOMIC_RELAXED);           \
+        }                                                                               \
+    } while (0)
+
+/// Add to a depth counter and raise its high-water mark if needed.
+#define STATSPAGE_ADD_MAX(slotPtr, field, maxField, delta)                              \
+    do {                                                                                \
+        if ((slotPtr) != NULL)                                                          \
+        {                                                                               \
+            uint32_t _depth = __atomic_add_fetch(&(slotPtr)->field, (delta),            \
+                                                 __ATOMIC_RELAXED);                     \
+            uint32_t _max = __atomic_load_n(&(slotPtr)->maxField, __ATOMIC_RELAXED);    \
+            while ((_depth > _max) &&                                                   \
+                   !__atomic_compare_exchange_n(&(slotPtr)->maxField, &_max, _depth,    \
+                                                true, __ATOMIC_RELAXED,                 \
+                                                __ATOMIC_RELAXED))                      \
+            {                                                                           \
+            }                                                                           \
+        }                                                                               \
+    } while (0)
+
+#else /* !LE_CONFIG_STATS_PAGE */
+
+#define STATSPAGE_SET(slotPtr, field, value)                    do { } while (0)
+#define STATSPAGE_INC(slotPtr, field)                           do { } while (0)
+#define STATSPAGE_ADD(slotPtr, field, delta)                    do { } while (0)
+#define STATSPAGE_ADD_MAX(slotPtr, field, maxField, delta)      do { } while (0)
+
+#endif /* end LE_CONFIG_STATS_PAGE */
+
+
+#if LE_CONFIG_STATS_PAGE
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create the statistics page of the process and publish the memory pools created so far.
+ *
+ * Must be called right after mem_Init().  If the page cannot be created, statistics are not
+ * published and the process carries on.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_Init
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Assign a free slot of a table to a new object.  The slot's counters are zeroed.
+ *
+ * @return
+ *      Pointer to the slot, or NULL if the table is full or the page does not exist.
+ */
+//--------------------------------------------------------------------------------------------------
+void* statsPage_AllocSlot
+(
+    statsPage_Table_t   table,      ///< [IN] Table to take the slot from.
+    const char*         name        ///< [IN] Name of the object (truncated if too long).
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Rename the object a slot is assigned to.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_SetSlotName
+(
+    void*               slotPtr,    ///< [IN] Slot, or NULL.
+    const char*         name        ///< [IN] New name of the object.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a slot when the object it describes is deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_FreeSlot
+(
+    void*               slotPtr     ///< [IN] Slot, or NULL.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the latency of a transaction in the histogram of an IPC session slot.
+ *
+ * Must only be called by the thread that owns the session.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_RecordLatency
+(
+    statsPage_SessionSlot_t*    slotPtr,    ///< [IN] Slot, or NULL.
+    uint64_t                    latencyUs   ///< [IN] Latency, in microseconds.
+);
+
+#endif /* end LE_CONFIG_STATS_PAGE */
+
+
+#if LE_CONFIG_LOCK_STATS
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the monotonic clock used to time lock waits and holds.
+ *
+ * @return Time, in nanoseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint64_t statsPage_GetLockTimeNs
+(
+    void
+)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record the acquisition of a mutex or semaphore in its slot.  Safe to call from several threads
+ * at once.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_RecordLockAcquired
+(
+    statsPage_LockSlot_t*   slotPtr,    ///< [IN] Slot, or NULL.
+    bool                    isContended,///< [IN] true if the caller had to wait.
+    uint64_t                waitNs      ///< [IN] Time spent waiting, if contended.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record how long a mutex was held in its slot.  Must be called with the mutex held.
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_RecordLockHeld
+(
+    statsPage_LockSlot_t*   slotPtr,    ///< [IN] Slot, or NULL.
+    uint64_t                holdNs      ///< [IN] Time the mutex was held.
+);
+
+#endif /* end LE_CONFIG_LOCK_STATS */
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Map the statistics page of another process, read-only.
+ *
+ * @return
+ *      - LE_OK on success.
+ *      - LE_NOT_FOUND if the process does not exist or does not publish a page.
+ *      - LE_NOT_PERMITTED if the caller may not look at the process's file descriptors.
+ *      - LE_FORMAT_ERROR if the page has an unknown format.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t statsPage_Map
+(
+    pid_t                        pid,           ///< [IN] Process to look at.
+    const statsPage_Header_t**   headerPtrPtr,  ///< [OUT] Mapped page.
+    size_t*                      sizePtr        ///< [OUT] Size of the mapping.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Unmap a page mapped by statsPage_Map().
+ */
+//--------------------------------------------------------------------------------------------------
+void statsPage_Unmap
+(
+    const statsPage_Header_t*    headerPtr,     ///< [IN] Mapped page.
+    size_t                       size           ///< [IN] Size of the mapping.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reset the mutex and semaphore counters in the statistics page of another process.  Each slot is
+ * zeroed by the publisher on its next update; until then statsPage_ReadSlot() reads it as zero.
+ *
+ * @return
+ *      - LE_OK on success.
+ *      - LE_NOT_FOUND if the process does not exist or does not publish a page.
+ *      - LE_NOT_PERMITTED if the caller may not write to the process's page.
+ *      - LE_FORMAT_ERROR if the page has an unknown format.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t statsPage_ResetLockStats
+(
+    pid_t                        pid            ///< [IN] Process to reset.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take a consistent copy of a slot of a mapped page.
+ *
+ * @return
+ *      true if the slot describes a live object and was copied, false if it is free or kept
+ *      changing during the copy.
+ */
+//--------------------------------------------------------------------------------------------------
+bool statsPage_ReadSlot
+(
+    const statsPage_Header_t*    headerPtr,     ///< [IN] Mapped page.
+    statsPage_Table_t            table,         ///< [IN] Table to read from.
+    size_t                       index,         ///< [IN] Index of the slot in the table.
+    void*                        bufPtr,        ///< [OUT] Copy of the slot.
+    size_t                       bufSize        ///< [IN] Size of the buffer.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Estimate a percentile of the latency histogram of a copy of an IPC session slot.
+ *
+ * @return
+ *      Upper bound of the bucket holding the percentile, in microseconds (never more than the
+ *      largest recorded latency), or 0 if no latency was recorded.
+ */
+//--------------------------------------------------------------------------------------------------
+uint64_t statsPage_GetLatencyPercentile
+(
+    const statsPage_SessionSlot_t*  slotPtr,    ///< [IN] Copy of the slot.
+    double                          percentile  ///< [IN] Percentile, between 0 and 100.
+);
+
+#endif /* end LEGATO_STATS_PAGE_INCLUDE_GUARD */
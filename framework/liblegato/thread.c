@@ -296,6 +296,10 @@ static void DestroyThread
 
     // Destruct the thread attributes structure.
     pthread_attr_destroy(&(threadPtr->attr));
+
+#if LE_CONFIG_STATS_PAGE
+    statsPage_FreeSlot(threadPtr->statsSlotPtr);
+#endif
 }
 
 
@@ -371,6 +375,12 @@ void thread_InitThread
 
     // Init the thread's eventLoop structures
     event_ThreadInit();
+
+#if LE_CONFIG_STATS_PAGE
+    // Now that the thread runs, publish its kernel thread ID.
+    thread_Obj_t* threadPtr = pthread_getspecific(ThreadLocalDataKey);
+    STATSPAGE_SET(threadPtr->statsSlotPtr, tid, (int32_t)syscall(SYS_gettid));
+#endif
 }
 
 
@@ -585,7 +595,16 @@ static thread_Obj_t* CreateThread
         threadPtr->cdataRecPtr = currentThreadPtr->cdataRecPtr;
     }
 
+#if LE_CONFIG_STATS_PAGE
+    // The Event Loop and timer records share the thread's statistics page slot.
+    threadPtr->statsSlotPtr = statsPage_AllocSlot(STATSPAGE_TABLE_THREAD,
+                                                  THREAD_NAME(threadPtr->name));
+#endif
+
     threadPtr->eventRecPtr = event_CreatePerThreadInfo();
+#if LE_CONFIG_STATS_PAGE
+    threadPtr->eventRecPtr->statsSlotPtr = threadPtr->statsSlotPtr;
+#endif
     timer_Type_t i;
     for (i = TIMER_NON_WAKEUP; i < TIMER_TYPE_COUNT; i++)
     {
@@ -66,6 +66,9 @@ typedef struct thread_Obj
     timer_ThreadRec_t           *timerRecPtr[TIMER_TYPE_COUNT]; ///< The thread's timer records.
     bool                         setPidOnStart;     ///< Set PID on start flag
     pid_t                        procId;            ///< The main process ID for this thread
+#if LE_CONFIG_STATS_PAGE
+    statsPage_ThreadSlot_t      *statsSlotPtr;      ///< Statistics page slot, or NULL.
+#endif
 }
 thread_Obj_t;
 
@@ -183,6 +183,8 @@ static void AddToTimerList
 
     // The new timer is now on the active list
     newTimerPtr->isActive = true;
+    STATSPAGE_ADD(CONTAINER_OF(listPtr, timer_ThreadRec_t, activeTimerList)->statsSlotPtr,
+                  activeTimers, 1);
 }
 
 
@@ -236,6 +238,8 @@ static Timer_t* PopFromTimerList
 
         // The timer is no longer on the active list
         timerPtr->isActive = false;
+        STATSPAGE_ADD(CONTAINER_OF(listPtr, timer_ThreadRec_t, activeTimerList)->statsSlotPtr,
+                      activeTimers, -1);
 
         return timerPtr;
     }
@@ -264,6 +268,8 @@ static void RemoveFromTimerList
     timerPtr->isActive = false;
     TimerListChangeCount++;
     le_dls_Remove(listPtr, &timerPtr->link);
+    STATSPAGE_ADD(CONTAINER_OF(listPtr, timer_ThreadRec_t, activeTimerList)->statsSlotPtr,
+                  activeTimers, -1);
 }
 
 
@@ -397,6 +403,7 @@ static void ProcessExpiredTimer
 
     // Keep track of the number of times the timer has expired, regardless of whether it repeats.
     expiredTimer->expiryCount++;
+    STATSPAGE_INC(threadRecPtr->statsSlotPtr, timerExpiries);
 
     // Handle repeating timers by adding it back to the list; do this before calling the expiry
     // handler to reduce jitter.
@@ -576,6 +583,9 @@ timer_ThreadRec_t *timer_InitThread
 
     threadRecPtr->activeTimerList = LE_DLS_LIST_INIT;
     threadRecPtr->firstTimerPtr = NULL;
+#if LE_CONFIG_STATS_PAGE
+    threadRecPtr->statsSlotPtr = threadPtr->statsSlotPtr;
+#endif
 
     return threadRecPtr;
 }
@@ -1,11 +1,148 @@
 /**
  * Simple test of Legato CRC API.
  *
+ * The CRC is also checked against a byte-at-a-time reference implementation over buffers of
+ * various sizes and alignments, and the throughput of both is compared on a large buffer.
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 
 #include "legato.h"
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Size of the buffer used to compare the CRC implementations.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LARGE_BUFFER_SIZE   (8 * 1024 * 1024)
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of random buffers checked against the reference implementation.
+ */
+//--------------------------------------------------------------------------------------------------
+#define RANDOM_CHECK_COUNT  2000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference CRC table.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t RefTable[256];
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute a CRC-32 one byte at a time, as reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t RefCrc32
+(
+    const uint8_t*  addressPtr,     ///< [IN] Input buffer
+    size_t          size,           ///< [IN] Number of bytes to read
+    uint32_t        crc             ///< [IN] Starting CRC seed
+)
+{
+    for (; size > 0; size--)
+    {
+        crc = (crc >> 8) ^ RefTable[(crc ^ *addressPtr++) & 0xFF];
+    }
+    return crc;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the elapsed time since a start time, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t ElapsedUs
+(
+    le_clk_Time_t startTime     ///< [IN] Start time
+)
+{
+    le_clk_Time_t duration = le_clk_Sub(le_clk_GetRelativeTime(), startTime);
+
+    return (uint64_t)duration.sec * 1000000 + duration.usec;
+}
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compare the CRC with the reference implementation, then compare their throughput.
+ */
+//--------------------------------------------------------------------------------------------------
+static void TestLargeBuffers
+(
+    void
+)
+{
+    uint8_t* bufferPtr = malloc(LARGE_BUFFER_SIZE);
+    le_clk_Time_t startTime;
+    uint64_t refUs;
+    uint64_t crcUs;
+    uint32_t refCrc;
+    uint32_t crc;
+    bool isOk = true;
+    size_t i;
+
+    LE_ASSERT(bufferPtr != NULL);
+
+    for (i = 0; i < NUM_ARRAY_MEMBERS(RefTable); i++)
+    {
+        uint32_t value = i;
+        int bit;
+
+        for (bit = 0; bit < 8; bit++)
+        {
+            value = (value >> 1) ^ ((value & 1) ? 0xEDB88320 : 0);
+        }
+        RefTable[i] = value;
+    }
+
+    le_rand_GetBuffer(bufferPtr, LARGE_BUFFER_SIZE);
+
+    // Various sizes and alignments, so that every code path and every tail length is covered
+    for (i = 0; i < RANDOM_CHECK_COUNT; i++)
+    {
+        size_t offset = le_rand_GetNumBetween(0, 63);
+        size_t size = le_rand_GetNumBetween(0, (i % 10) ? 1024 : 65536);
+        uint32_t seed;
+
+        le_rand_GetBuffer((uint8_t*)&seed, sizeof(seed));
+
+        isOk = isOk &&
+               (le_crc_Crc32(bufferPtr + offset, size, seed) ==
+                RefCrc32(bufferPtr + offset, size, seed));
+    }
+    LE_TEST_OK(isOk, "CRC of %d random buffers matches the reference", RANDOM_CHECK_COUNT);
+
+    startTime = le_clk_GetRelativeTime();
+    refCrc = RefCrc32(bufferPtr, LARGE_BUFFER_SIZE, LE_CRC_START_CRC32);
+    refUs = ElapsedUs(startTime);
+
+    startTime = le_clk_GetRelativeTime();
+    crc = le_crc_Crc32(bufferPtr, LARGE_BUFFER_SIZE, LE_CRC_START_CRC32);
+    crcUs = ElapsedUs(startTime);
+
+    LE_TEST_OK(crc == refCrc, "CRC of %d bytes (0x%08" PRIX32 ") matches the reference "
+               "(0x%08" PRIX32 ")", LARGE_BUFFER_SIZE, crc, refCrc);
+
+    // Computing the CRC by blocks gives the same result
+    crc = LE_CRC_START_CRC32;
+    for (i = 0; i < LARGE_BUFFER_SIZE; i += 4093)
+    {
+        size_t size = LARGE_BUFFER_SIZE - i;
+
+        crc = le_crc_Crc32(bufferPtr + i, (size > 4093) ? 4093 : size, crc);
+    }
+    LE_TEST_OK(crc == refCrc, "CRC computed by blocks matches the reference");
+
+    LE_TEST_INFO("Reference: %" PRIu64 " us, %.0f MB/s", refUs,
+                 refUs ? (double)LARGE_BUFFER_SIZE / refUs : 0.0);
+    LE_TEST_INFO("le_crc_Crc32: %" PRIu64 " us, %.0f MB/s", crcUs,
+                 crcUs ? (double)LARGE_BUFFER_SIZE / crcUs : 0.0);
+
+    free(bufferPtr);
+}
+
 COMPONENT_INIT
 {
     uint32_t    crc;
@@ -20,9 +157,9 @@ COMPONENT_INIT
                 };
     uint8_t     data3[2] = { 0x00, 0x00 };
 
-    LE_TEST_PLAN(3); // Indicate that there are 3 test cases in this app.
+    LE_TEST_PLAN(6); // Indicate that there are 6 test cases in this app.
 
-    // Execute the 3 test cases.
+    // Execute the 3 test cases on small buffers.
     crc = le_crc_Crc32(data1, sizeof(data1), LE_CRC_START_CRC32);
     expected = ~0x7F34014E;
     LE_TEST_OK(crc == expected, "Verified initial CRC (0x%08" PRIX32 ") is valid (0x%08" PRIX32 ")",
@@ -38,6 +175,8 @@ COMPONENT_INIT
     LE_TEST_OK(crc == expected, "Verified final CRC (0x%08" PRIX32 ") is valid (0x%08" PRIX32 ")",
         crc, expected);
 
+    TestLargeBuffers();
+
     // End the test sequence.
     LE_TEST_EXIT;
 }
@@ -0,0 +1,139 @@
+/**
+ * Implement the IPC benchmark API in C, using the asynchronous server API.  Responses are sent
+ * from a queued function, like a server that defers its work would do.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+/**
+ * Event reported by ipcBench_Fire(), carrying the sequence number.
+ */
+static le_event_Id_t TickEventId;
+
+static void PingRespond
+(
+    void* serverCmdPtr,
+    void* contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+    ipcBench_PingRespond(serverCmdPtr);
+}
+
+void ipcBench_Ping
+(
+    ipcBench_ServerCmdRef_t serverCmdPtr
+)
+{
+    le_event_QueueFunction(PingRespond, serverCmdPtr, NULL);
+}
+
+static void AddOneRespond
+(
+    void* serverCmdPtr,
+    void* valuePtr
+)
+{
+    ipcBench_AddOneRespond(serverCmdPtr, (int32_t)(intptr_t)valuePtr + 1);
+}
+
+void ipcBench_AddOne
+(
+    ipcBench_ServerCmdRef_t serverCmdPtr,
+    int32_t InValue
+)
+{
+    le_event_QueueFunction(AddOneRespond, serverCmdPtr, (void*)(intptr_t)InValue);
+}
+
+// The payload is only valid during the call, so echoes are responded to right away.
+void ipcBench_Echo64
+(
+    ipcBench_ServerCmdRef_t serverCmdPtr,
+    const uint8_t* InDataPtr,
+    size_t InDataSize,
+    size_t OutDataSize
+)
+{
+    ipcBench_Echo64Respond(serverCmdPtr, InDataPtr,
+                           (InDataSize < OutDataSize ? InDataSize : OutDataSize));
+}
+
+void ipcBench_Echo1K
+(
+    ipcBench_ServerCmdRef_t serverCmdPtr,
+    const uint8_t* InDataPtr,
+    size_t InDataSize,
+    size_t OutDataSize
+)
+{
+    ipcBench_Echo1KRespond(serverCmdPtr, InDataPtr,
+                           (InDataSize < OutDataSize ? InDataSize : OutDataSize));
+}
+
+void ipcBench_Echo4K
+(
+    ipcBench_ServerCmdRef_t serverCmdPtr,
+    const uint8_t* InDataPtr,
+    size_t InDataSize,
+    size_t OutDataSize
+)
+{
+    ipcBench_Echo4KRespond(serverCmdPtr, InDataPtr,
+                           (InDataSize < OutDataSize ? InDataSize : OutDataSize));
+}
+
+static void FirstLayerTickHandler
+(
+    void* reportPtr,
+    void* secondLayerHandlerFunc
+)
+{
+    uint32_t* seqPtr = reportPtr;
+    ipcBench_TickHandlerFunc_t clientHandlerFunc = secondLayerHandlerFunc;
+
+    clientHandlerFunc(*seqPtr, le_event_GetContextPtr());
+}
+
+ipcBench_TickHandlerRef_t ipcBench_AddTickHandler
+(
+    ipcBench_TickHandlerFunc_t handlerPtr,
+    void* contextPtr
+)
+{
+    le_event_HandlerRef_t handlerRef;
+
+    handlerRef = le_event_AddLayeredHandler("Tick",
+                                            TickEventId,
+                                            FirstLayerTickHandler,
+                                            (le_event_HandlerFunc_t)handlerPtr);
+    le_event_SetContextPtr(handlerRef, contextPtr);
+
+    return (ipcBench_TickHandlerRef_t)handlerRef;
+}
+
+void ipcBench_RemoveTickHandler
+(
+    ipcBench_TickHandlerRef_t handlerRef
+)
+{
+    le_event_RemoveHandler((le_event_HandlerRef_t)handlerRef);
+}
+
+void ipcBench_Fire
+(
+    ipcBench_ServerCmdRef_t serverCmdPtr,
+    uint32_t seq
+)
+{
+    le_event_Report(TickEventId, &seq, sizeof(seq));
+    ipcBench_FireRespond(serverCmdPtr);
+}
+
+COMPONENT_INIT
+{
+    TickEventId = le_event_CreateId("Tick", sizeof(uint32_t));
+}
@@ -0,0 +1,393 @@
+/**
+ * IPC benchmark client.
+ *
+ * Measures the latency (percentiles) and throughput of request/response calls with payloads of
+ * various sizes, and of events delivered to a growing number of handlers (fan-out).  Results are
+ * reported as test information lines, and each benchmark checks that the data came back intact.
+ *
+ * Also measures how long it takes to open sessions through the Service Directory, by opening
+ * many extra sessions to the server, a batch at a time.
+ *
+ * Options:
+ *    --iterations=N    Number of calls per benchmark (default 2000).
+ *    --sessions=N      Number of sessions opened by the session benchmark (default 2000).
+ *
+ * With LE_CONFIG_IPC_LATENCY_HISTOGRAM enabled, "inspect stats <pid>" shows the per-session
+ * latency histograms recorded by the framework for both processes while this runs.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+#include <string.h>
+
+#define DEFAULT_ITERATIONS      2000
+#define MAX_ITERATIONS          20000
+#define EVENT_TIMEOUT_MS        5000
+#define MAX_ECHO_SIZE           4096
+
+/*
+ * Number of sessions held open at the same time by the session benchmark.  This is kept well below
+ * the default file descriptor limit of an app.
+ */
+#define SESSION_BATCH_SIZE      64
+
+/*
+ * Number of Tick handlers registered for each round of the event benchmark.
+ */
+static const size_t FanOuts[] = { 1, 4, 16 };
+#define MAX_FAN_OUT             16
+
+static int Iterations = DEFAULT_ITERATIONS;
+static int Sessions = DEFAULT_ITERATIONS;
+
+/*
+ * Latency of each call of the current benchmark, in microseconds.
+ */
+static uint32_t Samples[MAX_ITERATIONS];
+
+/*
+ * Payload buffers for the echo benchmarks.
+ */
+static uint8_t InData[MAX_ECHO_SIZE];
+static uint8_t OutData[MAX_ECHO_SIZE];
+
+/*
+ * Event benchmark state.
+ */
+static le_timer_Ref_t EventTimeoutTimerRef;
+static ipcBench_TickHandlerRef_t TickHandlerRefs[MAX_FAN_OUT];
+static size_t FanOutIndex;
+static size_t TicksReceived;
+static uint32_t EventIteration;
+static uint64_t EventBenchStartUs;
+static uint64_t FireTimeUs;
+static bool EventsInOrder;
+
+typedef void (*EchoFunc_t)
+(
+    const uint8_t* InDataPtr,
+    size_t InDataSize,
+    uint8_t* OutDataPtr,
+    size_t* OutDataSizePtr
+);
+
+static void StartEventBench(size_t fanOutIndex);
+
+static inline uint64_t GetNowUs
+(
+    void
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    return (uint64_t)now.sec * 1000000 + now.usec;
+}
+
+static int CompareSamples
+(
+    const void* aPtr,
+    const void* bPtr
+)
+{
+    uint32_t a = *(const uint32_t*)aPtr;
+    uint32_t b = *(const uint32_t*)bPtr;
+
+    return (a > b) - (a < b);
+}
+
+static uint32_t GetPercentile
+(
+    size_t count,
+    double percentile
+)
+{
+    size_t index = (size_t)(percentile / 100.0 * count);
+
+    return Samples[index < count ? index : count - 1];
+}
+
+/*
+ * Print the throughput and latency percentiles of the samples of a benchmark.
+ */
+static void Report
+(
+    const char* name,
+    size_t count,
+    uint64_t elapsedUs
+)
+{
+    qsort(Samples, count, sizeof(Samples[0]), CompareSamples);
+
+    LE_TEST_INFO("%-16s %6"PRIuS" calls %9.0f/s  p50 %5"PRIu32"  p90 %5"PRIu32"  p99 %5"PRIu32
+                 "  p99.9 %5"PRIu32"  max %6"PRIu32" us",
+                 name, count, (elapsedUs ? count * 1000000.0 / elapsedUs : 0.0),
+                 GetPercentile(count, 50.0), GetPercentile(count, 90.0),
+                 GetPercentile(count, 99.0), GetPercentile(count, 99.9), Samples[count - 1]);
+}
+
+static void BenchPing
+(
+    void
+)
+{
+    uint64_t startUs = GetNowUs();
+    int i;
+
+    for (i = 0; i < Iterations; i++)
+    {
+        uint64_t callUs = GetNowUs();
+        ipcBench_Ping();
+        Samples[i] = GetNowUs() - callUs;
+    }
+
+    Report("ping", Iterations, GetNowUs() - startUs);
+    LE_TEST_OK(true, "ping benchmark");
+}
+
+static void BenchAddOne
+(
+    void
+)
+{
+    uint64_t startUs = GetNowUs();
+    int errors = 0;
+    int i;
+
+    for (i = 0; i < Iterations; i++)
+    {
+        int32_t outValue = 0;
+        uint64_t callUs = GetNowUs();
+        ipcBench_AddOne(i, &outValue);
+        Samples[i] = GetNowUs() - callUs;
+
+        if (outValue != i + 1)
+        {
+            errors++;
+        }
+    }
+
+    Report("add one", Iterations, GetNowUs() - startUs);
+    LE_TEST_OK(errors == 0, "add one benchmark (%d errors)", errors);
+}
+
+static void BenchEcho
+(
+    const char* name,
+    EchoFunc_t echoFunc,
+    size_t size
+)
+{
+    uint64_t startUs = GetNowUs();
+    int errors = 0;
+    int i;
+
+    for (i = 0; i < Iterations; i++)
+    {
+        size_t outSize = size;
+
+        // Change the payload on every call so a stale response is caught.
+        memset(InData, i, size);
+        InData[0] = ~i;
+
+        uint64_t callUs = GetNowUs();
+        echoFunc(InData, size, OutData, &outSize);
+        Samples[i] = GetNowUs() - callUs;
+
+        if ((outSize != size) || (memcmp(InData, OutData, size) != 0))
+        {
+            errors++;
+        }
+    }
+
+    Report(name, Iterations, GetNowUs() - startUs);
+    LE_TEST_OK(errors == 0, "%s benchmark (%d errors)", name, errors);
+}
+
+/*
+ * Open sessions to the server (without using them), SESSION_BATCH_SIZE at a time.  Each session
+ * open is a round trip through the Service Directory, which looks up the client's binding and the
+ * server's service.
+ */
+static void BenchSessions
+(
+    void
+)
+{
+    le_msg_ProtocolRef_t protocolRef = le_msg_GetProtocolRef(IFGEN_IPCBENCH_PROTOCOL_ID,
+                                                             sizeof(uint32_t) +
+                                                                IFGEN_IPCBENCH_MSG_SIZE);
+    le_msg_SessionRef_t sessionRefs[SESSION_BATCH_SIZE];
+    uint64_t startUs = GetNowUs();
+    int errors = 0;
+    int i = 0;
+
+    while (i < Sessions)
+    {
+        size_t opened = 0;
+
+        while ((opened < SESSION_BATCH_SIZE) && (i < Sessions))
+        {
+            le_msg_SessionRef_t sessionRef = le_msg_CreateSession(protocolRef, "ipcBench");
+
+            uint64_t openUs = GetNowUs();
+            le_result_t result = le_msg_TryOpenSessionSync(sessionRef);
+            Samples[i++] = GetNowUs() - openUs;
+
+            if (result != LE_OK)
+            {
+                errors++;
+                le_msg_DeleteSession(sessionRef);
+                continue;
+            }
+
+            sessionRefs[opened++] = sessionRef;
+        }
+
+        // Deleting a session also closes it.
+        while (opened > 0)
+        {
+            le_msg_DeleteSession(sessionRefs[--opened]);
+        }
+    }
+
+    Report("session open", Sessions, GetNowUs() - startUs);
+    LE_TEST_OK(errors == 0, "session open benchmark (%d errors)", errors);
+}
+
+static void FireNextTick
+(
+    void
+)
+{
+    TicksReceived = 0;
+    le_timer_Restart(EventTimeoutTimerRef);
+
+    FireTimeUs = GetNowUs();
+    ipcBench_Fire(EventIteration);
+}
+
+static void EventTimeout
+(
+    le_timer_Ref_t timerRef
+)
+{
+    LE_UNUSED(timerRef);
+
+    LE_TEST_OK(false, "event benchmark timed out (fan-out %"PRIuS", tick %"PRIu32", got %"PRIuS")",
+               FanOuts[FanOutIndex], EventIteration, TicksReceived);
+    LE_TEST_EXIT;
+}
+
+/*
+ * Receives the Tick events.  The latency of a tick is the time from firing it to its delivery to
+ * the last handler.
+ */
+static void TickHandler
+(
+    uint32_t seq,
+    void* contextPtr
+)
+{
+    LE_UNUSED(contextPtr);
+
+    if (seq != EventIteration)
+    {
+        EventsInOrder = false;
+        return;
+    }
+
+    if (++TicksReceived < FanOuts[FanOutIndex])
+    {
+        return;
+    }
+
+    Samples[EventIteration] = GetNowUs() - FireTimeUs;
+    EventIteration++;
+
+    if (EventIteration < (uint32_t)Iterations)
+    {
+        FireNextTick();
+        return;
+    }
+
+    le_timer_Stop(EventTimeoutTimerRef);
+
+    char name[32];
+    snprintf(name, sizeof(name), "event x%"PRIuS, FanOuts[FanOutIndex]);
+    Report(name, Iterations, GetNowUs() - EventBenchStartUs);
+    LE_TEST_OK(EventsInOrder, "%s benchmark", name);
+
+    size_t i;
+    for (i = 0; i < FanOuts[FanOutIndex]; i++)
+    {
+        ipcBench_RemoveTickHandler(TickHandlerRefs[i]);
+    }
+
+    StartEventBench(FanOutIndex + 1);
+}
+
+static void StartEventBench
+(
+    size_t fanOutIndex
+)
+{
+    if (fanOutIndex >= NUM_ARRAY_MEMBERS(FanOuts))
+    {
+        LE_TEST_EXIT;
+    }
+
+    FanOutIndex = fanOutIndex;
+
+    size_t i;
+    for (i = 0; i < FanOuts[FanOutIndex]; i++)
+    {
+        TickHandlerRefs[i] = ipcBench_AddTickHandler(TickHandler, NULL);
+    }
+
+    EventIteration = 0;
+    EventsInOrder = true;
+    EventBenchStartUs = GetNowUs();
+    FireNextTick();
+}
+
+COMPONENT_INIT
+{
+    le_arg_SetIntVar(&Iterations, NULL, "iterations");
+    le_arg_SetIntVar(&Sessions, NULL, "sessions");
+    le_arg_Scan();
+
+    if ((Iterations <= 0) || (Iterations > MAX_ITERATIONS))
+    {
+        LE_WARN("Iterations must be between 1 and %d; using %d.",
+                MAX_ITERATIONS, DEFAULT_ITERATIONS);
+        Iterations = DEFAULT_ITERATIONS;
+    }
+
+    if ((Sessions <= 0) || (Sessions > MAX_ITERATIONS))
+    {
+        LE_WARN("Sessions must be between 1 and %d; using %d.",
+                MAX_ITERATIONS, DEFAULT_ITERATIONS);
+        Sessions = DEFAULT_ITERATIONS;
+    }
+
+    LE_TEST_PLAN(LE_TEST_NO_PLAN);
+    ipcBench_ConnectService();
+    LE_TEST_INFO("Connected to server, %d iterations per benchmark", Iterations);
+
+    BenchPing();
+    BenchAddOne();
+    BenchEcho("echo 64", ipcBench_Echo64, 64);
+    BenchEcho("echo 1K", ipcBench_Echo1K, 1024);
+    BenchEcho("echo 4K", ipcBench_Echo4K, 4096);
+    BenchSessions();
+
+    EventTimeoutTimerRef = le_timer_Create("EventTimeout");
+    le_timer_SetHandler(EventTimeoutTimerRef, EventTimeout);
+    le_timer_SetMsInterval(EventTimeoutTimerRef, EVENT_TIMEOUT_MS);
+
+    // The event benchmarks are driven by the event loop; they finish the test when done.
+    StartEventBench(0);
+}
@@ -0,0 +1,136 @@
+/**
+ * Implement the IPC benchmark API in C, responding synchronously.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "interfaces.h"
+
+#include <string.h>
+
+/**
+ * Event reported by ipcBench_Fire(), carrying the sequence number.
+ */
+static le_event_Id_t TickEventId;
+
+void ipcBench_Ping
+(
+    void
+)
+{
+}
+
+void ipcBench_AddOne
+(
+    int32_t InValue,
+    int32_t *OutValuePtr
+)
+{
+    if (OutValuePtr)
+    {
+        *OutValuePtr = InValue + 1;
+    }
+}
+
+static void Echo
+(
+    const uint8_t* InDataPtr,
+    size_t InDataSize,
+    uint8_t* OutDataPtr,
+    size_t* OutDataSizePtr
+)
+{
+    if (OutDataPtr)
+    {
+        if (InDataSize > *OutDataSizePtr)
+        {
+            InDataSize = *OutDataSizePtr;
+        }
+        memcpy(OutDataPtr, InDataPtr, InDataSize);
+        *OutDataSizePtr = InDataSize;
+    }
+}
+
+void ipcBench_Echo64
+(
+    const uint8_t* InDataPtr,
+    size_t InDataSize,
+    uint8_t* OutDataPtr,
+    size_t* OutDataSizePtr
+)
+{
+    Echo(InDataPtr, InDataSize, OutDataPtr, OutDataSizePtr);
+}
+
+void ipcBench_Echo1K
+(
+    const uint8_t* InDataPtr,
+    size_t InDataSize,
+    uint8_t* OutDataPtr,
+    size_t* OutDataSizePtr
+)
+{
+    Echo(InDataPtr, InDataSize, OutDataPtr, OutDataSizePtr);
+}
+
+void ipcBench_Echo4K
+(
+    const uint8_t* InDataPtr,
+    size_t InDataSize,
+    uint8_t* OutDataPtr,
+    size_t* OutDataSizePtr
+)
+{
+    Echo(InDataPtr, InDataSize, OutDataPtr, OutDataSizePtr);
+}
+
+static void FirstLayerTickHandler
+(
+    void* reportPtr,
+    void* secondLayerHandlerFunc
+)
+{
+    uint32_t* seqPtr = reportPtr;
+    ipcBench_TickHandlerFunc_t clientHandlerFunc = secondLayerHandlerFunc;
+
+    clientHandlerFunc(*seqPtr, le_event_GetContextPtr());
+}
+
+ipcBench_TickHandlerRef_t ipcBench_AddTickHandler
+(
+    ipcBench_TickHandlerFunc_t handlerPtr,
+    void* contextPtr
+)
+{
+    le_event_HandlerRef_t handlerRef;
+
+    handlerRef = le_event_AddLayeredHandler("Tick",
+                                            TickEventId,
+                                            FirstLayerTickHandler,
+                                            (le_event_HandlerFunc_t)handlerPtr);
+    le_event_SetContextPtr(handlerRef, contextPtr);
+
+    return (ipcBench_TickHandlerRef_t)handlerRef;
+}
+
+void ipcBench_RemoveTickHandler
+(
+    ipcBench_TickHandlerRef_t handlerRef
+)
+{
+    le_event_RemoveHandler((le_event_HandlerRef_t)handlerRef);
+}
+
+void ipcBench_Fire
+(
+    uint32_t seq
+)
+{
+    le_event_Report(TickEventId, &seq, sizeof(seq));
+}
+
+COMPONENT_INIT
+{
+    TickEventId = le_event_CreateId("Tick", sizeof(uint32_t));
+}
@@ -0,0 +1,213 @@
+/**
+ * Unit test of the Supervisor's kernel module loader, using a fake module load function.
+ *
+ * The fake load function records when each module starts and finishes loading, and how many
+ * modules are loading at the same time, so the test can check that levels are loaded in order,
+ * that the modules of a level are loaded in parallel, and how failures are handled.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "kmodLoader.h"
+
+#define LOAD_TIME_MS    50
+#define MAX_MODULES     8
+
+typedef struct
+{
+    kmodLoader_Job_t job;
+    bool shouldFail;
+    uint32_t startSeq;
+    uint32_t endSeq;
+}
+FakeModule_t;
+
+static FakeModule_t Modules[MAX_MODULES];
+static size_t ModuleCount;
+
+static le_mutex_Ref_t MutexRef;
+static uint32_t Seq;
+static size_t Loading;
+static size_t MaxLoading;
+
+/*
+ * Fake load function: takes a while and fails if asked to.
+ */
+static le_result_t FakeLoad
+(
+    void* contextPtr
+)
+{
+    FakeModule_t* modPtr = contextPtr;
+
+    le_mutex_Lock(MutexRef);
+    modPtr->startSeq = ++Seq;
+    if (++Loading > MaxLoading)
+    {
+        MaxLoading = Loading;
+    }
+    le_mutex_Unlock(MutexRef);
+
+    usleep(LOAD_TIME_MS * 1000);
+
+    le_mutex_Lock(MutexRef);
+    modPtr->endSeq = ++Seq;
+    Loading--;
+    le_mutex_Unlock(MutexRef);
+
+    return modPtr->shouldFail ? LE_FAULT : LE_OK;
+}
+
+/*
+ * Build a job list of modules at the given levels.
+ */
+static void SetUp
+(
+    le_dls_List_t* listPtr,
+    const size_t* levels,
+    size_t count
+)
+{
+    size_t i;
+
+    LE_ASSERT(count <= MAX_MODULES);
+
+    *listPtr = LE_DLS_LIST_INIT;
+    memset(Modules, 0, sizeof(Modules));
+    ModuleCount = count;
+    Seq = 0;
+    Loading = 0;
+    MaxLoading = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        Modules[i].job.link = LE_DLS_LINK_INIT;
+        Modules[i].job.name = "fake";
+        Modules[i].job.level = levels[i];
+        Modules[i].job.contextPtr = &Modules[i];
+        le_dls_Queue(listPtr, &Modules[i].job.link);
+    }
+}
+
+/*
+ * Check that every module that was loaded started after all the modules of lower levels ended.
+ */
+static bool LevelsInOrder
+(
+    void
+)
+{
+    size_t i, j;
+
+    for (i = 0; i < ModuleCount; i++)
+    {
+        for (j = 0; j < ModuleCount; j++)
+        {
+            if ((Modules[j].job.level < Modules[i].job.level) &&
+                (Modules[i].startSeq != 0) &&
+                (Modules[i].startSeq < Modules[j].endSeq))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static void TestLevels
+(
+    void
+)
+{
+    // Listed out of order on purpose; the loader groups them by level.
+    static const size_t levels[] = { 2, 0, 1, 0, 0, 1, 0 };
+    le_dls_List_t list;
+    size_t i;
+
+    LE_TEST_INFO("-------- Levels loaded in order, in parallel --------");
+
+    SetUp(&list, levels, NUM_ARRAY_MEMBERS(levels));
+    LE_TEST_OK(kmodLoader_Run(&list, FakeLoad, 4) == LE_OK, "all modules loaded");
+
+    bool allOk = true;
+    for (i = 0; i < ModuleCount; i++)
+    {
+        allOk = allOk && (Modules[i].job.result == LE_OK);
+    }
+    LE_TEST_OK(allOk, "every job reports LE_OK");
+    LE_TEST_OK(LevelsInOrder(), "lower levels finish before higher levels start");
+    // How many loads overlap depends on the scheduling of the threads
+    LE_TEST_OK((MaxLoading > 1) && (MaxLoading <= 4),
+               "level 0 loaded in parallel, up to 4 at a time (max %" PRIuS ")", MaxLoading);
+}
+
+static void TestSerial
+(
+    void
+)
+{
+    static const size_t levels[] = { 0, 0, 0, 1 };
+    le_dls_List_t list;
+
+    LE_TEST_INFO("-------- One thread --------");
+
+    SetUp(&list, levels, NUM_ARRAY_MEMBERS(levels));
+    LE_TEST_OK(kmodLoader_Run(&list, FakeLoad, 1) == LE_OK, "all modules loaded");
+    LE_TEST_OK(MaxLoading == 1, "one module at a time (max %" PRIuS ")", MaxLoading);
+    LE_TEST_OK(LevelsInOrder(), "lower levels finish before higher levels start");
+}
+
+static void TestFailure
+(
+    void
+)
+{
+    static const size_t levels[] = { 0, 1, 1, 2 };
+    le_dls_List_t list;
+
+    LE_TEST_INFO("-------- Required module fails --------");
+
+    SetUp(&list, levels, NUM_ARRAY_MEMBERS(levels));
+    Modules[1].shouldFail = true;
+
+    LE_TEST_OK(kmodLoader_Run(&list, FakeLoad, 4) == LE_FAULT, "run fails");
+    LE_TEST_OK(Modules[1].job.result == LE_FAULT, "failed module reports LE_FAULT");
+    LE_TEST_OK(Modules[2].job.result == LE_OK, "rest of the level still loaded");
+    LE_TEST_OK(Modules[3].job.result == LE_UNAVAILABLE, "higher level not loaded");
+    LE_TEST_OK(Modules[3].startSeq == 0, "higher level load function not called");
+}
+
+static void TestOptionalFailure
+(
+    void
+)
+{
+    static const size_t levels[] = { 0, 1, 2 };
+    le_dls_List_t list;
+
+    LE_TEST_INFO("-------- Optional module fails --------");
+
+    SetUp(&list, levels, NUM_ARRAY_MEMBERS(levels));
+    Modules[1].shouldFail = true;
+    Modules[1].job.isOptional = true;
+
+    LE_TEST_OK(kmodLoader_Run(&list, FakeLoad, 4) == LE_OK, "run succeeds");
+    LE_TEST_OK(Modules[1].job.result == LE_FAULT, "failed module reports LE_FAULT");
+    LE_TEST_OK(Modules[2].job.result == LE_OK, "higher level still loaded");
+}
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(15);
+
+    MutexRef = le_mutex_CreateNonRecursive("FakeLoad");
+
+    TestLevels();
+    TestSerial();
+    TestFailure();
+    TestOptionalFailure();
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,266 @@
+/**
+ * Unit test of the Log Control Daemon's log store.
+ *
+ * Uses a small store in /tmp to check that queries filter by level, time and name, that the block
+ * index lets queries skip blocks, that the oldest messages are dropped once the store is full, and
+ * that messages survive closing and reopening the store.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "logStore.h"
+
+#define STORE_PATH      "/tmp/testLogStore"
+#define STORE_SIZE      (64 * 1024)
+#define MSG_FILL        "0123456789012345678901234567890123456789012345678901234567890123456789"
+
+typedef struct
+{
+    size_t count;
+    uint64_t firstTimeUs;
+    uint64_t lastTimeUs;
+    bool isOrdered;
+}
+QueryResult_t;
+
+static uint64_t NextTimeUs = 1000000;
+
+/*
+ * Append a message with the next time stamp.
+ */
+static void Append
+(
+    logStore_Ref_t storeRef,
+    le_log_Level_t level,
+    const char* procNamePtr,
+    const char* compNamePtr
+)
+{
+    logStore_Record_t record =
+    {
+        .timeUs = NextTimeUs,
+        .level = level,
+        .pid = 42,
+        .procNamePtr = procNamePtr,
+        .compNamePtr = compNamePtr,
+        .msgPtr = MSG_FILL,
+    };
+
+    NextTimeUs += 1000;
+    LE_ASSERT_OK(logStore_Append(storeRef, &record));
+}
+
+static bool CountRecord
+(
+    const logStore_Record_t* recordPtr,
+    void* contextPtr
+)
+{
+    QueryResult_t* resultPtr = contextPtr;
+
+    if (resultPtr->count == 0)
+    {
+        resultPtr->firstTimeUs = recordPtr->timeUs;
+    }
+    else if (recordPtr->timeUs <= resultPtr->lastTimeUs)
+    {
+        resultPtr->isOrdered = false;
+    }
+    resultPtr->lastTimeUs = recordPtr->timeUs;
+    resultPtr->count++;
+
+    return (strcmp(recordPtr->msgPtr, MSG_FILL) == 0);
+}
+
+/*
+ * Run a query and report what it returned.
+ */
+static QueryResult_t Query
+(
+    logStore_Ref_t storeRef,
+    const logStore_Filter_t* filterPtr,
+    size_t* blocksReadPtr
+)
+{
+    QueryResult_t result = { .isOrdered = true };
+
+    LE_ASSERT_OK(logStore_Query(storeRef, filterPtr, CountRecord, &result, blocksReadPtr));
+
+    return result;
+}
+
+static logStore_Ref_t OpenEmpty
+(
+    void
+)
+{
+    unlink(STORE_PATH);
+
+    logStore_Ref_t storeRef = logStore_Open(STORE_PATH, STORE_SIZE);
+    LE_ASSERT(storeRef != NULL);
+
+    return storeRef;
+}
+
+static void TestFilters
+(
+    void
+)
+{
+    logStore_Ref_t storeRef = OpenEmpty();
+    logStore_Filter_t filter = { .minLevel = LE_LOG_DEBUG };
+    uint64_t startUs = NextTimeUs;
+    QueryResult_t result;
+    int i;
+
+    LE_TEST_INFO("-------- Filters --------");
+
+    for (i = 0; i < 12; i++)
+    {
+        Append(storeRef, (i % 2) ? LE_LOG_ERR : LE_LOG_INFO,
+               (i < 4) ? "procA" : "procB", (i % 3) ? "compX" : "compY");
+    }
+
+    result = Query(storeRef, &filter, NULL);
+    LE_TEST_OK((result.count == 12) && result.isOrdered, "all messages, in order");
+
+    filter.minLevel = LE_LOG_ERR;
+    result = Query(storeRef, &filter, NULL);
+    LE_TEST_OK(result.count == 6, "level filter (%" PRIuS ")", result.count);
+
+    filter.minLevel = LE_LOG_DEBUG;
+    filter.startUs = startUs + 2000;
+    filter.endUs = startUs + 5000;
+    result = Query(storeRef, &filter, NULL);
+    LE_TEST_OK(result.count == 4, "time filter (%" PRIuS ")", result.count);
+
+    filter.startUs = 0;
+    filter.endUs = 0;
+    filter.procNamePtr = "procA";
+    result = Query(storeRef, &filter, NULL);
+    LE_TEST_OK(result.count == 4, "process filter (%" PRIuS ")", result.count);
+
+    filter.procNamePtr = NULL;
+    filter.compNamePtr = "compY";
+    result = Query(storeRef, &filter, NULL);
+    LE_TEST_OK(result.count == 4, "component filter (%" PRIuS ")", result.count);
+
+    filter.compNamePtr = NULL;
+    filter.pid = 43;
+    result = Query(storeRef, &filter, NULL);
+    LE_TEST_OK(result.count == 0, "PID filter");
+
+    logStore_Close(storeRef);
+}
+
+static void TestIndex
+(
+    void
+)
+{
+    logStore_Ref_t storeRef = OpenEmpty();
+    logStore_Filter_t filter = { .minLevel = LE_LOG_DEBUG };
+    uint64_t procBStartUs;
+    size_t blocksRead;
+    QueryResult_t result;
+    int i;
+
+    LE_TEST_INFO("-------- Block index --------");
+
+    // Enough INFO messages from procA to fill the first block, then ERROR messages from procB.
+    for (i = 0; i < 200; i++)
+    {
+        Append(storeRef, LE_LOG_INFO, "procA", "comp");
+    }
+    procBStartUs = NextTimeUs;
+    for (i = 0; i < 20; i++)
+    {
+        Append(storeRef, LE_LOG_ERR, "procB", "comp");
+    }
+
+    result = Query(storeRef, &filter, &blocksRead);
+    LE_TEST_OK((result.count == 220) && (blocksRead == 2), "messages span 2 blocks");
+
+    filter.procNamePtr = "procB";
+    result = Query(storeRef, &filter, &blocksRead);
+    LE_TEST_OK((result.count == 20) && (blocksRead == 1),
+               "process query reads 1 block (%" PRIuS ")", blocksRead);
+
+    filter.procNamePtr = NULL;
+    filter.minLevel = LE_LOG_ERR;
+    result = Query(storeRef, &filter, &blocksRead);
+    LE_TEST_OK((result.count == 20) && (blocksRead == 1),
+               "level query reads 1 block (%" PRIuS ")", blocksRead);
+
+    filter.minLevel = LE_LOG_DEBUG;
+    filter.startUs = procBStartUs;
+    result = Query(storeRef, &filter, &blocksRead);
+    LE_TEST_OK((result.count == 20) && (blocksRead == 1),
+               "time query reads 1 block (%" PRIuS ")", blocksRead);
+
+    logStore_Close(storeRef);
+}
+
+static void TestWrapAndReopen
+(
+    void
+)
+{
+    logStore_Ref_t storeRef = OpenEmpty();
+    logStore_Filter_t filter = { .minLevel = LE_LOG_DEBUG };
+    uint64_t firstUs = NextTimeUs;
+    uint64_t lastUs;
+    QueryResult_t result;
+    QueryResult_t reopened;
+    int i;
+
+    LE_TEST_INFO("-------- Wraparound and reopen --------");
+
+    // About 2.5 times the size of the store.
+    for (i = 0; i < 1500; i++)
+    {
+        Append(storeRef, LE_LOG_INFO, "procA", "comp");
+    }
+    lastUs = NextTimeUs - 1000;
+
+    result = Query(storeRef, &filter, NULL);
+    LE_TEST_OK((result.count > 0) && (result.count < 1500) && result.isOrdered,
+               "oldest messages dropped (%" PRIuS " left)", result.count);
+    LE_TEST_OK((result.firstTimeUs > firstUs) && (result.lastTimeUs == lastUs),
+               "newest messages kept");
+
+    logStore_Close(storeRef);
+
+    storeRef = logStore_Open(STORE_PATH, STORE_SIZE);
+    LE_TEST_OK(storeRef != NULL, "store reopened");
+
+    reopened = Query(storeRef, &filter, NULL);
+    LE_TEST_OK((reopened.count == result.count) &&
+               (reopened.firstTimeUs == result.firstTimeUs) &&
+               (reopened.lastTimeUs == result.lastTimeUs), "messages kept after reopen");
+
+    Append(storeRef, LE_LOG_WARN, "procC", "");
+    reopened = Query(storeRef, &filter, NULL);
+    LE_TEST_OK(reopened.lastTimeUs == NextTimeUs - 1000, "append after reopen");
+
+    logStore_Close(storeRef);
+
+    storeRef = logStore_Open(STORE_PATH, 2 * STORE_SIZE);
+    LE_TEST_OK((storeRef != NULL) && (Query(storeRef, &filter, NULL).count == 0),
+               "resized store is emptied");
+
+    logStore_Close(storeRef);
+    unlink(STORE_PATH);
+}
+
+COMPONENT_INIT
+{
+    LE_TEST_PLAN(16);
+
+    TestFilters();
+    TestIndex();
+    TestWrapAndReopen();
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,214 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark of local (in-process) messaging.
+ *
+ * A server thread offers a local service that adds one to the number in each request.  The client
+ * (main) thread makes synchronous request-response calls to it in a loop, and reports the call
+ * rate and latency percentiles as test information lines.  Each response is checked, so a lost
+ * or stale response fails the test.
+ *
+ * Options:
+ *    --iterations=N    Number of calls (default 20000).
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "burgerProtocol.h"
+
+
+#define SERVICE_INSTANCE_NAME   "LocalBench"
+#define DEFAULT_ITERATIONS      20000
+#define MAX_ITERATIONS          200000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool for the service's messages.  The client has one request outstanding at a time.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_MEM_DEFINE_STATIC_POOL(BenchMessage, 2, LE_MSG_LOCAL_HEADER_SIZE + sizeof(burger_Message_t));
+
+static le_msg_LocalService_t BenchService;
+static le_msg_ServiceRef_t BenchServiceRef;
+
+static int Iterations = DEFAULT_ITERATIONS;
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Latency of each call, in microseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t Samples[MAX_ITERATIONS];
+
+
+// ==================================
+//  SERVER
+// ==================================
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Respond to a request with the number in it plus one.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void MsgRecvHandler
+(
+    le_msg_MessageRef_t msgRef,     ///< Reference to the received message.
+    void*               contextPtr  ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(contextPtr);
+
+    burger_Message_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+
+    msgPtr->payload++;
+    le_msg_Respond(msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function for the server thread.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void* ServerThreadMain
+(
+    void* contextPtr  ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_UNUSED(contextPtr);
+
+    le_msg_SetServiceRecvHandler(BenchServiceRef, MsgRecvHandler, NULL);
+    le_msg_AdvertiseService(BenchServiceRef);
+
+    le_event_RunLoop();
+}
+
+
+// ==================================
+//  CLIENT
+// ==================================
+
+
+static inline uint64_t GetNowUs
+(
+    void
+)
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    return (uint64_t)now.sec * 1000000 + now.usec;
+}
+
+
+static int CompareSamples
+(
+    const void* aPtr,
+    const void* bPtr
+)
+{
+    uint32_t a = *(const uint32_t*)aPtr;
+    uint32_t b = *(const uint32_t*)bPtr;
+
+    return (a > b) - (a < b);
+}
+
+
+static uint32_t GetPercentile
+(
+    size_t count,
+    double percentile
+)
+{
+    size_t index = (size_t)(percentile / 100.0 * count);
+
+    return Samples[index < count ? index : count - 1];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Make synchronous calls to the server and report the call rate.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void BenchSyncCalls
+(
+    le_msg_SessionRef_t sessionRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint64_t startUs = GetNowUs();
+    uint64_t elapsedUs;
+    int errors = 0;
+    int i;
+
+    for (i = 0; i < Iterations; i++)
+    {
+        uint64_t callUs = GetNowUs();
+
+        le_msg_MessageRef_t msgRef = le_msg_CreateMsg(sessionRef);
+        burger_Message_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+        msgPtr->payload = i;
+
+        msgRef = le_msg_RequestSyncResponse(msgRef);
+        if ((msgRef == NULL) || (((burger_Message_t*)le_msg_GetPayloadPtr(msgRef))->payload !=
+                                 (uint32_t)i + 1))
+        {
+            errors++;
+        }
+        if (msgRef != NULL)
+        {
+            le_msg_ReleaseMsg(msgRef);
+        }
+
+        Samples[i] = GetNowUs() - callUs;
+    }
+
+    elapsedUs = GetNowUs() - startUs;
+
+    qsort(Samples, Iterations, sizeof(Samples[0]), CompareSamples);
+
+    LE_TEST_INFO("sync call %6d calls %9.0f/s  p50 %4"PRIu32"  p99 %5"PRIu32"  max %6"PRIu32" us",
+                 Iterations, (elapsedUs ? Iterations * 1000000.0 / elapsedUs : 0.0),
+                 GetPercentile(Iterations, 50.0), GetPercentile(Iterations, 99.0),
+                 Samples[Iterations - 1]);
+    LE_TEST_OK(errors == 0, "sync call benchmark (%d errors)", errors);
+}
+
+
+COMPONENT_INIT
+{
+    le_arg_SetIntVar(&Iterations, NULL, "iterations");
+    le_arg_Scan();
+
+    if ((Iterations <= 0) || (Iterations > MAX_ITERATIONS))
+    {
+        LE_WARN("Iterations must be between 1 and %d; using %d.",
+                MAX_ITERATIONS, DEFAULT_ITERATIONS);
+        Iterations = DEFAULT_ITERATIONS;
+    }
+
+    LE_TEST_PLAN(1);
+
+    BenchServiceRef = le_msg_InitLocalService(&BenchService,
+                                              SERVICE_INSTANCE_NAME,
+                                              le_mem_InitStaticPool(BenchMessage,
+                                                                    2,
+                                                                    LE_MSG_LOCAL_HEADER_SIZE +
+                                                                    sizeof(burger_Message_t)));
+
+    le_thread_Start(le_thread_Create("LocalBenchServer", ServerThreadMain, NULL));
+
+    le_msg_SessionRef_t sessionRef = le_msg_CreateLocalSession(&BenchService);
+    le_msg_OpenSessionSync(sessionRef);
+
+    BenchSyncCalls(sessionRef);
+
+    le_msg_CloseSession(sessionRef);
+
+    LE_TEST_EXIT;
+}
@@ -0,0 +1,278 @@
+/**
+ * Unit test of the statistics page.
+ *
+ * Reads the page of the test process the way inspect does, while other threads update and rename
+ * its slots, to check that the counters are never lost or seen going backwards and that a slot is
+ * never copied half renamed.  Also checks that a child process gets a page of its own after
+ * fork(), which its parent's page doesn't see the updates of.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+
+#include "legato.h"
+#include "statsPage.h"
+
+#include <sys/wait.h>
+
+#define WRITER_COUNT    4
+#define INC_COUNT       100000
+#define RENAME_COUNT    100000
+#define LONG_NAME       "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+#define SHORT_NAME      "b"
+#define CHILD_DELTA     100
+
+static statsPage_ThreadSlot_t* SlotPtr;
+static volatile bool IsWriting;
+
+/*
+ * Find a slot of the thread table by name, and copy it.
+ *
+ * Returns the index of the slot, or -1 if there is none.
+ */
+static ssize_t FindSlot
+(
+    const statsPage_Header_t* headerPtr,
+    const char* name,
+    statsPage_ThreadSlot_t* copyPtr
+)
+{
+    size_t i;
+
+    for (i = 0; i < headerPtr->table[STATSPAGE_TABLE_THREAD].count; i++)
+    {
+        if (statsPage_ReadSlot(headerPtr, STATSPAGE_TABLE_THREAD, i, copyPtr, sizeof(*copyPtr)) &&
+            (strcmp(copyPtr->hdr.name, name) == 0))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void* IncThread
+(
+    void* contextPtr
+)
+{
+    int i;
+
+    for (i = 0; i < INC_COUNT; i++)
+    {
+        STATSPAGE_INC(SlotPtr, eventsProcessed);
+        STATSPAGE_ADD_MAX(SlotPtr, eventBacklog, maxEventBacklog, 1);
+        STATSPAGE_ADD(SlotPtr, eventBacklog, -1);
+    }
+
+    return NULL;
+}
+
+static void* RenameThread
+(
+    void* contextPtr
+)
+{
+    int i;
+
+    for (i = 0; i < RENAME_COUNT; i++)
+    {
+        statsPage_SetSlotName(SlotPtr, (i % 2) ? LONG_NAME : SHORT_NAME);
+    }
+    statsPage_SetSlotName(SlotPtr, LONG_NAME);
+
+    __atomic_store_n(&IsWriting, false, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+/*
+ * Increment the counters of a slot from several threads while it is read.
+ */
+static void TestConcurrentUpdates
+(
+    const statsPage_Header_t* headerPtr
+)
+{
+    le_thread_Ref_t threads[WRITER_COUNT];
+    statsPage_ThreadSlot_t copy;
+    uint64_t lastCount = 0;
+    bool isMonotonic = true;
+    int i;
+
+    LE_TEST_INFO("-------- Concurrent updates --------");
+
+    SlotPtr = statsPage_AllocSlot(STATSPAGE_TABLE_THREAD, "statsPageTest.inc");
+    LE_TEST_ASSERT(SlotPtr != NULL, "slot allocated");
+
+    ssize_t index = FindSlot(headerPtr, "statsPageTest.inc", &copy);
+    LE_TEST_ASSERT(index >= 0, "slot published");
+
+    for (i = 0; i < WRITER_COUNT; i++)
+    {
+        threads[i] = le_thread_Create("inc", IncThread, NULL);
+        le_thread_SetJoinable(threads[i]);
+        le_thread_Start(threads[i]);
+    }
+
+    // Sample the counter while it is being incremented
+    for (i = 0; i < INC_COUNT; i++)
+    {
+        if (statsPage_ReadSlot(headerPtr, STATSPAGE_TABLE_THREAD, index, &copy, sizeof(copy)))
+        {
+            isMonotonic = isMonotonic && (copy.eventsProcessed >= lastCount);
+            lastCount = copy.eventsProcessed;
+        }
+    }
+
+    for (i = 0; i < WRITER_COUNT; i++)
+    {
+        le_thread_Join(threads[i], NULL);
+    }
+
+    LE_TEST_OK(isMonotonic, "counter never read going backwards");
+
+    LE_TEST_ASSERT(statsPage_ReadSlot(headerPtr, STATSPAGE_TABLE_THREAD, index, &copy,
+                                      sizeof(copy)), "slot read");
+    LE_TEST_OK(copy.eventsProcessed == (uint64_t)WRITER_COUNT * INC_COUNT,
+               "no increment lost (%" PRIu64 ")", copy.eventsProcessed);
+    LE_TEST_OK(copy.eventBacklog == 0, "depth back to 0 (%" PRIu32 ")", copy.eventBacklog);
+    LE_TEST_OK((copy.maxEventBacklog >= 1) && (copy.maxEventBacklog <= WRITER_COUNT),
+               "high-water mark in range (%" PRIu32 ")", copy.maxEventBacklog);
+
+    statsPage_FreeSlot(SlotPtr);
+    LE_TEST_OK(!statsPage_ReadSlot(headerPtr, STATSPAGE_TABLE_THREAD, index, &copy, sizeof(copy)),
+               "freed slot not read");
+}
+
+/*
+ * Rename a slot from another thread while it is read.
+ */
+static void TestConcurrentRename
+(
+    const statsPage_Header_t* headerPtr
+)
+{
+    le_thread_Ref_t thread;
+    statsPage_ThreadSlot_t copy;
+    size_t readCount = 0;
+    size_t tornCount = 0;
+
+    LE_TEST_INFO("-------- Concurrent rename --------");
+
+    SlotPtr = statsPage_AllocSlot(STATSPAGE_TABLE_THREAD, LONG_NAME);
+    LE_TEST_ASSERT(SlotPtr != NULL, "slot allocated");
+
+    ssize_t index = FindSlot(headerPtr, LONG_NAME, &copy);
+    LE_TEST_ASSERT(index >= 0, "slot published");
+
+    IsWriting = true;
+    thread = le_thread_Create("rename", RenameThread, NULL);
+    le_thread_SetJoinable(thread);
+    le_thread_Start(thread);
+
+    while (__atomic_load_n(&IsWriting, __ATOMIC_ACQUIRE))
+    {
+        if (statsPage_ReadSlot(headerPtr, STATSPAGE_TABLE_THREAD, index, &copy, sizeof(copy)))
+        {
+            readCount++;
+            if ((strcmp(copy.hdr.name, LONG_NAME) != 0) &&
+                (strcmp(copy.hdr.name, SHORT_NAME) != 0))
+            {
+                tornCount++;
+            }
+        }
+    }
+
+    le_thread_Join(thread, NULL);
+
+    LE_TEST_OK(readCount > 0, "slot read while renamed (%" PRIuS " copies)", readCount);
+    LE_TEST_OK(tornCount == 0, "no half renamed copy (%" PRIuS ")", tornCount);
+
+    statsPage_FreeSlot(SlotPtr);
+}
+
+/*
+ * Check the page of the child process, in the child.  Returns the exit code of the child.
+ */
+static int CheckChildPage
+(
+    void
+)
+{
+    const statsPage_Header_t* headerPtr;
+    statsPage_ThreadSlot_t copy;
+    size_t size;
+
+    STATSPAGE_ADD(SlotPtr, eventsProcessed, CHILD_DELTA);
+
+    if (statsPage_Map(getpid(), &headerPtr, &size) != LE_OK)
+    {
+        return 1;
+    }
+    if (headerPtr->pid != getpid())
+    {
+        return 2;
+    }
+    if ((FindSlot(headerPtr, "statsPageTest.fork", &copy) < 0) ||
+        (copy.eventsProcessed != 1 + CHILD_DELTA))
+    {
+        return 3;
+    }
+
+    statsPage_Unmap(headerPtr, size);
+    return 0;
+}
+
+/*
+ * Fork, and check that the parent and the child publish separate pages.
+ */
+static void TestFork
+(
+    const statsPage_Header_t* headerPtr
+)
+{
+    statsPage_ThreadSlot_t copy;
+    int status;
+
+    LE_TEST_INFO("-------- Fork --------");
+
+    SlotPtr = statsPage_AllocSlot(STATSPAGE_TABLE_THREAD, "statsPageTest.fork");
+    LE_TEST_ASSERT(SlotPtr != NULL, "slot allocated");
+    STATSPAGE_INC(SlotPtr, eventsProcessed);
+
+    // The child only reports through its exit code
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        _exit(CheckChildPage());
+    }
+    LE_TEST_ASSERT(pid > 0, "fork");
+
+    LE_TEST_ASSERT(waitpid(pid, &status, 0) == pid, "child waited for");
+    LE_TEST_OK(WIFEXITED(status) && (WEXITSTATUS(status) == 0),
+               "child publishes its own page (status %d)", status);
+
+    LE_TEST_OK(headerPtr->pid == getpid(), "parent page kept");
+    LE_TEST_OK((FindSlot(headerPtr, "statsPageTest.fork", &copy) >= 0) &&
+               (copy.eventsProcessed == 1), "child updates not in the parent page");
+
+    statsPage_FreeSlot(SlotPtr);
+}
+
+COMPONENT_INIT
+{
+    const statsPage_Header_t* headerPtr;
+    size_t size;
+
+    LE_TEST_PLAN(19);
+
+    LE_TEST_ASSERT(statsPage_Map(getpid(), &headerPtr, &size) == LE_OK, "page mapped");
+
+    TestConcurrentUpdates(headerPtr);
+    TestConcurrentRename(headerPtr);
+    TestFork(headerPtr);
+
+    statsPage_Unmap(headerPtr, size);
+
+    LE_TEST_EXIT;
+}
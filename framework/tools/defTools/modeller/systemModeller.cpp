@@ -1511,6 +1511,9 @@ model::System_t* GetSystem
     // these will modify the build parameters.
     buildParams.FinishConfig();
 
+    // Now that all build variables are set, parse the changed definition files in parallel.
+    parser::cache::Prefetch(buildParams.jobCount);
+
     // Process all the "apps:" sections.  This must be done after all interface search directories
     // have been parsed.
     ModelApps(systemPtr, appsSections, buildParams);
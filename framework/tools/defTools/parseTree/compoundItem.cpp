@@ -201,6 +201,40 @@ TokenList_t* CreateTokenList
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a new CompoundItemList_t object of a given type.
+ *
+ * @return a pointer to the new object.
+ */
+//--------------------------------------------------------------------------------------------------
+CompoundItemList_t* CreateCompoundItemList
+(
+    Content_t::Type_t contentType, ///< The type of object to create.
+    Token_t* firstTokenPtr  ///< Pointer to the first token in this part of the parse tree.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (contentType)
+    {
+        case Content_t::COMPLEX_SECTION:
+            return new ComplexSection_t(firstTokenPtr);
+
+        case Content_t::APP:
+            return new App_t(firstTokenPtr);
+
+        case Content_t::MODULE:
+            return new Module_t(firstTokenPtr);
+
+        default:
+            throw mk::Exception_t(
+                mk::format(LE_I18N("Internal error: %s is not a CompoundItemList_t type."),
+                           Content_t::TypeName(contentType))
+            );
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Converts from a pointer to a Content_t into a pointer to a SimpleSection_t.
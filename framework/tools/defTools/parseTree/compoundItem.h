@@ -379,6 +379,20 @@ TokenList_t* CreateTokenList
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Creates a new CompoundItemList_t object of a given type.
+ *
+ * @return a pointer to the new object.
+ */
+//--------------------------------------------------------------------------------------------------
+CompoundItemList_t* CreateCompoundItemList
+(
+    Content_t::Type_t contentType, ///< The type of object to create.
+    Token_t* firstTokenPtr  ///< Pointer to the first token in this part of the parse tree.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Converts from a pointer to a Content_t into a pointer to a SimpleSection_t.
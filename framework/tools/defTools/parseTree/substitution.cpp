@@ -126,6 +126,9 @@ static std::string ExtractVarName
  * Given an environment variable name.  Read it from the environment, make a note of the name, and
  * append that var's value into the output string.
  *
+ * If the string came from a def file, CURDIR is the directory containing that file.  It is not
+ * taken from the environment, so that files can be parsed from several threads.
+ *
  * Throw an exception if the name is empty.
  **/
 //--------------------------------------------------------------------------------------------------
@@ -134,6 +137,7 @@ static void EvalVar
     std::string& processed,             ///< The string we will dump the var value into.
     const std::string& original,        ///< The original string we pulled the name from.
     const std::string& varName,         ///< The name of the variable we extracted.
+    const Content_t* contentPtr,        ///< The content the string came from, or NULL.
     std::set<std::string>* usedVarsPtr  ///< Record the found name in this set, if not null.
 )
 //--------------------------------------------------------------------------------------------------
@@ -149,7 +153,14 @@ static void EvalVar
         usedVarsPtr->insert(varName);
     }
 
-    processed.append(envVars::Get(varName));
+    if ((contentPtr != NULL) && (varName == "CURDIR"))
+    {
+        processed.append(path::MakeAbsolute(path::GetContainingDir(contentPtr->filePtr->path)));
+    }
+    else
+    {
+        processed.append(envVars::Get(varName));
+    }
 }
 
 
@@ -169,6 +180,7 @@ static size_t HandleBracketVar
     const std::string& original,        ///< The string to extract a var name from.
     std::string& processed,             ///< The string we will dump the var value into.
     size_t begin,                       ///< Start name extraction from here.
+    const Content_t* contentPtr,        ///< The content the string came from, or NULL.
     std::set<std::string>* usedVarsPtr  ///< Record the found name in this set, if not null.
 )
 //--------------------------------------------------------------------------------------------------
@@ -182,7 +194,7 @@ static size_t HandleBracketVar
 
     auto varName = ExtractVarName(original, begin, end - begin);
 
-    EvalVar(processed, original, varName, usedVarsPtr);
+    EvalVar(processed, original, varName, contentPtr, usedVarsPtr);
 
     return end + 1;
 }
@@ -204,6 +216,7 @@ static size_t HandleVar
     const std::string& original,        ///< The string to extract a var name from.
     std::string& processed,             ///< The string we will dump the var value into.
     size_t begin,                       ///< Start name extraction from here.
+    const Content_t* contentPtr,        ///< The content the string came from, or NULL.
     std::set<std::string>* usedVarsPtr  ///< Record the found name in this set, if not null.
 )
 //--------------------------------------------------------------------------------------------------
@@ -211,7 +224,7 @@ static size_t HandleVar
     size_t end = FindFirstNotNameChar(original, begin);
     auto varName = original.substr(begin, end - begin);
 
-    EvalVar(processed, original, varName, usedVarsPtr);
+    EvalVar(processed, original, varName, contentPtr, usedVarsPtr);
 
     return end;
 }
@@ -225,9 +238,10 @@ static size_t HandleVar
  * @return The converted string.
  **/
 //--------------------------------------------------------------------------------------------------
-static std::string DoSubstitution
+static std::string SubstituteVars
 (
     const std::string& original,        ///< Original string to subsitute variables in.
+    const Content_t* contentPtr,        ///< The content the string came from, or NULL.
     std::set<std::string>* usedVarsPtr  ///< If not null, record any variables found in original.
 )
 //--------------------------------------------------------------------------------------------------
@@ -255,11 +269,11 @@ static std::string DoSubstitution
         }
         else if (next == '{')
         {
-            begin = HandleBracketVar(original, processed, found + 2, usedVarsPtr);
+            begin = HandleBracketVar(original, processed, found + 2, contentPtr, usedVarsPtr);
         }
         else if (IsValidFirstChar(next))
         {
-            begin = HandleVar(original, processed, found + 1, usedVarsPtr);
+            begin = HandleVar(original, processed, found + 1, contentPtr, usedVarsPtr);
         }
         else
         {
@@ -280,8 +294,7 @@ static std::string DoSubstitution
  * Look for environment variables (specified as "$VAR_NAME" or "${VAR_NAME}") in a given string
  * and replace with environment variable contents.
  *
- * This version of the function differs from DoSubstitution in that variables like CURDIR are
- * handled relative to the content the string came from.
+ * Variables like CURDIR are handled relative to the content the string came from, if any.
  *
  * @return The converted string.
  **/
@@ -294,28 +307,9 @@ std::string DoSubstitution
 )
 //--------------------------------------------------------------------------------------------------
 {
-    std::string oldDir;
-
-    // Check to see if we were given a context to work with...
-    if (contentPtr != NULL)
-    {
-        // Currently we only populate CURDIR.  However in the future we may add other variables based on
-        // where the fragment where the text came from.
-        oldDir = envVars::Get("CURDIR");
-        envVars::Set("CURDIR",
-                     path::MakeAbsolute(path::GetContainingDir(contentPtr->filePtr->path)));
-    }
-
-    // Actually subsitute any variables in the string now.
-    auto result = DoSubstitution(originalString, usedVarsPtr);
-
-    // Restore the old value of CURDIR if we had changed it before.
-    if (contentPtr != NULL)
-    {
-        envVars::Set("CURDIR", oldDir);
-    }
-
-    return result;
+    // Currently we only populate CURDIR from the context.  However in the future we may add other
+    // variables based on the fragment where the text came from.
+    return SubstituteVars(originalString, contentPtr, usedVarsPtr);
 }
 
 
@@ -15,6 +15,22 @@ namespace parseTree
 {
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * true if the calling thread must not print warnings and parse errors.
+ */
+//--------------------------------------------------------------------------------------------------
+static thread_local bool IsQuietThread = false;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of warnings reported by the calling thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static thread_local size_t WarningCount = 0;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Constructor
@@ -222,9 +238,64 @@ void Token_t::PrintWarning
 const
 //--------------------------------------------------------------------------------------------------
 {
-    std::cerr << LE_I18N("** WARNING: ") << std::endl
-              << mk::format(LE_I18N("%s: warning: %s"), GetLocation(), message)
-              << std::endl;
+    WarningCount++;
+
+    if (!IsQuietThread)
+    {
+        std::cerr << LE_I18N("** WARNING: ") << std::endl
+                  << mk::format(LE_I18N("%s: warning: %s"), GetLocation(), message)
+                  << std::endl;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable quiet mode for the calling thread.  In quiet mode, warnings and parse errors
+ * are not printed.
+ */
+//--------------------------------------------------------------------------------------------------
+void SetQuiet
+(
+    bool isQuiet
+)
+//--------------------------------------------------------------------------------------------------
+{
+    IsQuietThread = isQuiet;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if quiet mode is enabled for the calling thread.
+ *
+ * @return true if warnings and parse errors must not be printed.
+ */
+//--------------------------------------------------------------------------------------------------
+bool IsQuiet
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return IsQuietThread;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of warnings reported by the calling thread so far, printed or not.
+ *
+ * @return The number of warnings.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t GetWarningCount
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return WarningCount;
 }
 
 
@@ -84,4 +84,33 @@ struct Token_t: public Content_t
 };
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable or disable quiet mode for the calling thread.  In quiet mode, warnings and parse errors
+ * are not printed.  Used to parse files in the background.
+ */
+//--------------------------------------------------------------------------------------------------
+void SetQuiet(bool isQuiet);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if quiet mode is enabled for the calling thread.
+ *
+ * @return true if warnings and parse errors must not be printed.
+ */
+//--------------------------------------------------------------------------------------------------
+bool IsQuiet(void);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of warnings reported by the calling thread so far, printed or not.
+ *
+ * @return The number of warnings.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t GetWarningCount(void);
+
+
 #endif // LEGATO_DEFTOOLS_TOKEN_H_INCLUDE_GUARD
@@ -92,6 +92,7 @@ Lexer_t::Lexer_t
 )
 //--------------------------------------------------------------------------------------------------
 :   tokensSinceError(100),
+    usedFileSystem(false),
     beVerbose(false)
 //--------------------------------------------------------------------------------------------------
 {
@@ -710,9 +711,14 @@ void Lexer_t::BailUntil
                                                                context.top().column,
                                                                context.top().curPos);
 
-    std::cout << mk::format(LE_I18N("Skipping from %d:%d "),
-                            context.top().line,
-                            context.top().column);
+    bool isQuiet = parseTree::IsQuiet();
+
+    if (!isQuiet)
+    {
+        std::cout << mk::format(LE_I18N("Skipping from %d:%d "),
+                                context.top().line,
+                                context.top().column);
+    }
     bool done = false;
 
     do
@@ -724,14 +730,22 @@ void Lexer_t::BailUntil
             && (context.top().nextChars[0] == '\n'))
         {
 
-            std::cerr << mk::format(LE_I18N("to %d:%d"), context.top().line, context.top().column)
-                      << std::endl;
+            if (!isQuiet)
+            {
+                std::cerr << mk::format(LE_I18N("to %d:%d"),
+                                        context.top().line, context.top().column)
+                          << std::endl;
+            }
             done = true;
         }
         else if (IsMatch(untilType))
         {
-            std::cerr << mk::format(LE_I18N("to %d:%d"), context.top().line, context.top().column)
-                      << std::endl;
+            if (!isQuiet)
+            {
+                std::cerr << mk::format(LE_I18N("to %d:%d"),
+                                        context.top().line, context.top().column)
+                          << std::endl;
+            }
             done = true;
         }
         else if (IsMatch(parseTree::Token_t::END_OF_FILE))
@@ -1199,6 +1213,7 @@ bool Lexer_t::PullAndEvalBoolExpression
                 auto curDir = path::GetContainingDir(context.top().filePtr->path);
 
                 result = (file::FindFile(fileName, { curDir }) != "");
+                usedFileSystem = true;
 
                 MarkVarsUsed(substitutedVars, fileNamePtr);
             }
@@ -1212,6 +1227,7 @@ bool Lexer_t::PullAndEvalBoolExpression
                 auto curDir = path::GetContainingDir(context.top().filePtr->path);
 
                 result = (file::FindDirectory(fileName, { curDir }) != "");
+                usedFileSystem = true;
 
                 MarkVarsUsed(substitutedVars, fileNamePtr);
             }
@@ -2550,6 +2566,31 @@ parseTree::Token_t *Lexer_t::FindVarUse
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the names of all the variables used by the lexer in processing directives.
+ *
+ * @return The set of variable names.
+ */
+//--------------------------------------------------------------------------------------------------
+std::set<std::string> Lexer_t::UsedVarNames
+(
+    void
+)
+const
+//--------------------------------------------------------------------------------------------------
+{
+    std::set<std::string> names;
+
+    for (auto const &usedVar: usedVars)
+    {
+        names.insert(usedVar.first);
+    }
+
+    return names;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Advance the current file position by one character, appending the character into a given string
@@ -2638,7 +2679,10 @@ void Lexer_t::ContinueAfterError
     bool stopAtNewline
 )
 {
-    std::cerr << "[ERROR] " << e.what() << std::endl;
+    if (!parseTree::IsQuiet())
+    {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
 
     if (tokensSinceError < 2)
     {
@@ -55,6 +55,12 @@ class Lexer_t
         // Find if a build variable has been used by the lexer in a processing directive
         parseTree::Token_t *FindVarUse(const std::string &name);
 
+        // Get the names of all the variables used by the lexer in processing directives.
+        std::set<std::string> UsedVarNames() const;
+
+        // true if a processing directive has checked for the existence of a file or directory.
+        bool usedFileSystem;
+
         // true = print progress messages to the standard output stream.
         bool beVerbose;
 
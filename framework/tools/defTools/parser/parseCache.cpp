@@ -0,0 +1,1151 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file parseCache.cpp  Implementation of the cache of parsed definition files.
+ *
+ * Each cache entry is a file named after the MD5 hash of the type and path of the definition
+ * file.  It contains, in a simple text format made of integers and length-prefixed strings:
+ *
+ *  - a header identifying the format,
+ *  - the type and path of the definition file,
+ *  - the variables used by the processing directives, and their values,
+ *  - the path and contents hash of all the file fragments (the file and the files it includes),
+ *  - the tokens of each fragment, and the tokens including other fragments,
+ *  - the tree of sections, referring to the tokens by fragment and position.
+ *
+ * Entries are kept in memory as well, so that files used several times during a run are only
+ * read once.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include <unistd.h>
+
+#include "defTools.h"
+
+
+namespace parser
+{
+
+namespace cache
+{
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * First line of all cache entries.  Must be changed whenever the format or the parse trees
+ * change.
+ */
+//--------------------------------------------------------------------------------------------------
+static const std::string FormatTag = "legato-parse-cache 1";
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Path to the cache directory, or empty if the cache is disabled.
+ */
+//--------------------------------------------------------------------------------------------------
+static std::string CacheDir;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Serialized entries, by key.  Protected by Mutex.
+ */
+//--------------------------------------------------------------------------------------------------
+static std::map<std::string, std::string> Entries;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * MD5 hash of the contents of the files, by path (empty if the file cannot be read).  Files are
+ * not expected to change while the tools are running.  Protected by Mutex.
+ */
+//--------------------------------------------------------------------------------------------------
+static std::map<std::string, std::string> FileHashes;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Protects the cache when files are parsed by several threads.
+ */
+//--------------------------------------------------------------------------------------------------
+static std::mutex Mutex;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reference to a token: index of the fragment, and index of the token in the fragment.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef std::pair<size_t, size_t> TokenRef_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cached token.
+ */
+//--------------------------------------------------------------------------------------------------
+struct TokenRecord_t
+{
+    parseTree::Token_t::Type_t type;
+    size_t line;
+    size_t column;
+    int curPos;
+    std::string text;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cached file fragment.
+ */
+//--------------------------------------------------------------------------------------------------
+struct FragmentRecord_t
+{
+    std::string path;
+    std::string md5;
+    size_t version;
+    std::vector<TokenRecord_t> tokens;
+    std::vector<std::pair<TokenRef_t, size_t>> includes;   ///< Include token and fragment index.
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cached compound item, with either tokens or items as content.
+ */
+//--------------------------------------------------------------------------------------------------
+struct ItemRecord_t
+{
+    parseTree::Content_t::Type_t type;
+    TokenRef_t first;
+    TokenRef_t last;
+    bool isItemList;
+    std::vector<TokenRef_t> tokens;
+    std::vector<ItemRecord_t> items;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cached definition file.
+ */
+//--------------------------------------------------------------------------------------------------
+struct EntryRecord_t
+{
+    parseTree::DefFile_t::Type_t type;
+    std::string path;
+    std::map<std::string, std::string> vars;
+    std::vector<FragmentRecord_t> fragments;
+    std::vector<ItemRecord_t> sections;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads the fields of a serialized entry.
+ */
+//--------------------------------------------------------------------------------------------------
+class EntryReader_t
+{
+    public:
+
+        EntryReader_t(const std::string& text): input(text), size(text.size()) {}
+
+        /// Read an unsigned integer, checking it is not above a given maximum.
+        size_t Int(size_t max = std::numeric_limits<size_t>::max())
+        {
+            unsigned long long value;
+
+            if (!(input >> value) || (value > max))
+            {
+                Fail();
+            }
+
+            return value;
+        }
+
+        /// Read a signed integer.
+        int SignedInt(void)
+        {
+            int value;
+
+            if (!(input >> value))
+            {
+                Fail();
+            }
+
+            return value;
+        }
+
+        /// Read a number of elements, checking the rest of the entry can hold them, as each one
+        /// takes at least two characters.  A corrupted count then cannot exhaust the memory.
+        size_t Count(void)
+        {
+            return Int(Remaining() / 2);
+        }
+
+        /// Read a length-prefixed string.
+        std::string String(void)
+        {
+            size_t length = Int(Remaining());
+            std::string value;
+
+            if (input.get() != ':')
+            {
+                Fail();
+            }
+
+            value.resize(length);
+            if (!input.read(&value[0], length))
+            {
+                Fail();
+            }
+
+            return value;
+        }
+
+        /// Read a reference to a token, checking it is valid.
+        TokenRef_t Ref(const std::vector<FragmentRecord_t>& fragments)
+        {
+            size_t fragmentIndex = Int(fragments.size() - 1);
+            size_t tokenIndex = Int();
+
+            if (tokenIndex >= fragments[fragmentIndex].tokens.size())
+            {
+                Fail();
+            }
+
+            return TokenRef_t(fragmentIndex, tokenIndex);
+        }
+
+        /// Check the entry starts with the format tag.
+        void Header(void)
+        {
+            std::string line;
+
+            if (!std::getline(input, line) || (line != FormatTag))
+            {
+                Fail();
+            }
+        }
+
+        [[noreturn]]
+        void Fail(void) __attribute__ ((noreturn))
+        {
+            throw mk::Exception_t(LE_I18N("Invalid parse cache entry."));
+        }
+
+    private:
+
+        /// Number of characters left to read.
+        size_t Remaining(void)
+        {
+            std::streamoff pos = input.tellg();
+
+            if (pos < 0)
+            {
+                Fail();
+            }
+
+            return size - static_cast<size_t>(pos);
+        }
+
+        std::istringstream input;
+        size_t size;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a length-prefixed string.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteString
+(
+    std::ostream& output,
+    const std::string& value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    output << ' ' << value.size() << ':' << value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute the key of the cache entry of a definition file.
+ *
+ * @return The key, also used as file name.
+ */
+//--------------------------------------------------------------------------------------------------
+static std::string GetKey
+(
+    parseTree::DefFile_t::Type_t type,
+    const std::string& path
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return md5(std::to_string(type) + ":" + path);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if a file name is the name of a cache entry (and not of a temporary file).
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsKey
+(
+    const std::string& name
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return (name.size() == 32) &&
+           (name.find_first_not_of("0123456789abcdef") == std::string::npos);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a whole file.
+ *
+ * @return true if the file could be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReadFile
+(
+    const std::string& path,
+    std::string& contents   ///< [OUT]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    std::ifstream input(path, std::ios::binary);
+    std::stringstream buffer;
+
+    if (!input.is_open())
+    {
+        return false;
+    }
+
+    buffer << input.rdbuf();
+    contents = buffer.str();
+
+    return !input.bad();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the MD5 hash of the contents of a file, reading it only the first time.
+ *
+ * @return The hash, or an empty string if the file cannot be read.
+ */
+//--------------------------------------------------------------------------------------------------
+static std::string HashFile
+(
+    const std::string& path
+)
+//--------------------------------------------------------------------------------------------------
+{
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+
+        auto iter = FileHashes.find(path);
+        if (iter != FileHashes.end())
+        {
+            return iter->second;
+        }
+    }
+
+    std::string contents;
+    std::string hash;
+
+    if (ReadFile(path, contents))
+    {
+        hash = md5(contents);
+    }
+
+    std::lock_guard<std::mutex> lock(Mutex);
+    FileHashes[path] = hash;
+
+    return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the header of an entry: the file it is about, the variables and the fragments.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadHeader
+(
+    EntryReader_t& reader,
+    EntryRecord_t& entry    ///< [OUT]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    reader.Header();
+
+    entry.type = static_cast<parseTree::DefFile_t::Type_t>(reader.Int(parseTree::DefFile_t::SDEF));
+    entry.path = reader.String();
+
+    size_t varCount = reader.Count();
+    for (size_t i = 0; i < varCount; i++)
+    {
+        auto name = reader.String();
+        entry.vars[name] = reader.String();
+    }
+
+    entry.fragments.resize(reader.Count());
+    if (entry.fragments.empty())
+    {
+        reader.Fail();
+    }
+
+    for (auto& fragment : entry.fragments)
+    {
+        fragment.path = reader.String();
+        fragment.md5 = reader.String();
+        fragment.version = reader.Int();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check if the files and variables an entry depends on have not changed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool IsUpToDate
+(
+    const EntryRecord_t& entry
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (auto& var : entry.vars)
+    {
+        if (envVars::Get(var.first) != var.second)
+        {
+            return false;
+        }
+    }
+
+    for (auto& fragment : entry.fragments)
+    {
+        if (HashFile(fragment.path) != fragment.md5)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a compound item and its contents, recursively.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadItem
+(
+    EntryReader_t& reader,
+    const std::vector<FragmentRecord_t>& fragments,
+    ItemRecord_t& item  ///< [OUT]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    item.type = static_cast<parseTree::Content_t::Type_t>(
+                                                    reader.Int(parseTree::Content_t::NET_LINK));
+    item.first = reader.Ref(fragments);
+    item.last = reader.Ref(fragments);
+    item.isItemList = (reader.Int(1) == 1);
+
+    bool isItemListType = (item.type == parseTree::Content_t::COMPLEX_SECTION) ||
+                          (item.type == parseTree::Content_t::APP) ||
+                          (item.type == parseTree::Content_t::MODULE);
+    if ((item.type == parseTree::Content_t::TOKEN) || (item.isItemList != isItemListType))
+    {
+        reader.Fail();
+    }
+
+    size_t count = reader.Count();
+    if (item.isItemList)
+    {
+        item.items.resize(count);
+        for (auto& subItem : item.items)
+        {
+            ReadItem(reader, fragments, subItem);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            item.tokens.push_back(reader.Ref(fragments));
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read the body of an entry: the tokens, the included fragments and the sections.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReadBody
+(
+    EntryReader_t& reader,
+    EntryRecord_t& entry    ///< [in,out]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    for (auto& fragment : entry.fragments)
+    {
+        fragment.tokens.resize(reader.Count());
+
+        for (auto& token : fragment.tokens)
+        {
+            token.type = static_cast<parseTree::Token_t::Type_t>(
+                                        reader.Int(parseTree::Token_t::PROVIDE_HEADER_OPTION));
+            token.line = reader.Int();
+            token.column = reader.Int();
+            token.curPos = reader.SignedInt();
+            token.text = reader.String();
+        }
+    }
+
+    for (auto& fragment : entry.fragments)
+    {
+        size_t includeCount = reader.Count();
+
+        for (size_t i = 0; i < includeCount; i++)
+        {
+            auto tokenRef = reader.Ref(entry.fragments);
+            size_t fragmentIndex = reader.Int(entry.fragments.size() - 1);
+
+            // Fragment 0 is the definition file itself, which cannot be included.
+            if (fragmentIndex == 0)
+            {
+                reader.Fail();
+            }
+
+            fragment.includes.push_back(std::make_pair(tokenRef, fragmentIndex));
+        }
+    }
+
+    entry.sections.resize(reader.Count());
+    for (auto& section : entry.sections)
+    {
+        ReadItem(reader, entry.fragments, section);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a compound item of the parse tree, and its contents, recursively.
+ *
+ * @return Pointer to the item.
+ */
+//--------------------------------------------------------------------------------------------------
+static parseTree::CompoundItem_t* CreateItem
+(
+    const ItemRecord_t& item,
+    const std::vector<std::vector<parseTree::Token_t*>>& tokens
+)
+//--------------------------------------------------------------------------------------------------
+{
+    auto firstTokenPtr = tokens[item.first.first][item.first.second];
+    parseTree::CompoundItem_t* itemPtr;
+
+    if (item.isItemList)
+    {
+        auto listPtr = parseTree::CreateCompoundItemList(item.type, firstTokenPtr);
+
+        for (auto& subItem : item.items)
+        {
+            listPtr->AddContent(CreateItem(subItem, tokens));
+        }
+
+        itemPtr = listPtr;
+    }
+    else
+    {
+        auto listPtr = parseTree::CreateTokenList(item.type, firstTokenPtr);
+
+        // Some items add their first token to their contents on construction.
+        for (size_t i = listPtr->Contents().size(); i < item.tokens.size(); i++)
+        {
+            listPtr->AddContent(tokens[item.tokens[i].first][item.tokens[i].second]);
+        }
+
+        itemPtr = listPtr;
+    }
+
+    // The parsers often extend items up to their closing brace.
+    itemPtr->lastTokenPtr = tokens[item.last.first][item.last.second];
+
+    return itemPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Populate a definition file object from a cache entry.
+ */
+//--------------------------------------------------------------------------------------------------
+static void CreateParseTree
+(
+    const EntryRecord_t& entry,
+    parseTree::DefFile_t* defFilePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    std::vector<parseTree::DefFileFragment_t*> fragmentPtrs;
+    std::vector<std::vector<parseTree::Token_t*>> tokens(entry.fragments.size());
+
+    for (size_t i = 0; i < entry.fragments.size(); i++)
+    {
+        auto& fragment = entry.fragments[i];
+        auto fragmentPtr = (i == 0) ? defFilePtr : new parseTree::DefFileFragment_t(fragment.path);
+
+        fragmentPtr->version = fragment.version;
+
+        for (auto& token : fragment.tokens)
+        {
+            auto tokenPtr = new parseTree::Token_t(token.type,
+                                                   fragmentPtr,
+                                                   token.line,
+                                                   token.column,
+                                                   token.curPos);
+            tokenPtr->text = token.text;
+            tokens[i].push_back(tokenPtr);
+        }
+
+        fragmentPtrs.push_back(fragmentPtr);
+    }
+
+    for (size_t i = 0; i < entry.fragments.size(); i++)
+    {
+        for (auto& include : entry.fragments[i].includes)
+        {
+            fragmentPtrs[i]->includedFiles.insert(
+                std::make_pair(tokens[include.first.first][include.first.second],
+                               fragmentPtrs[include.second]));
+        }
+    }
+
+    for (auto& section : entry.sections)
+    {
+        defFilePtr->sections.push_back(CreateItem(section, tokens));
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write a compound item and its contents, recursively.
+ *
+ * @return false if the item refers to a token which is not part of the file.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool WriteItem
+(
+    std::ostream& output,
+    const parseTree::CompoundItem_t* itemPtr,
+    const std::map<const parseTree::Token_t*, TokenRef_t>& tokenRefs
+)
+//--------------------------------------------------------------------------------------------------
+{
+    auto writeRef = [&output, &tokenRefs](const parseTree::Token_t* tokenPtr)
+        {
+            auto iter = tokenRefs.find(tokenPtr);
+
+            if (iter == tokenRefs.end())
+            {
+                return false;
+            }
+
+            output << ' ' << iter->second.first << ' ' << iter->second.second;
+            return true;
+        };
+
+    output << '\n' << itemPtr->type;
+    if (!writeRef(itemPtr->firstTokenPtr) || !writeRef(itemPtr->lastTokenPtr))
+    {
+        return false;
+    }
+
+    auto tokenListPtr = dynamic_cast<const parseTree::TokenList_t*>(itemPtr);
+    if (tokenListPtr != NULL)
+    {
+        output << " 0 " << tokenListPtr->Contents().size();
+
+        for (auto tokenPtr : tokenListPtr->Contents())
+        {
+            if (!writeRef(tokenPtr))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    auto itemListPtr = dynamic_cast<const parseTree::CompoundItemList_t*>(itemPtr);
+    if (itemListPtr != NULL)
+    {
+        output << " 1 " << itemListPtr->Contents().size();
+
+        for (auto subItemPtr : itemListPtr->Contents())
+        {
+            if (!WriteItem(output, subItemPtr, tokenRefs))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Serialize a parse tree.
+ *
+ * @return false if the parse tree cannot be cached.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool Serialize
+(
+    const parseTree::DefFile_t* defFilePtr,
+    const std::set<std::string>& usedVars,
+    std::string& text   ///< [OUT]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    std::ostringstream output;
+
+    // List the fragments, the file first and then the included files.
+    std::vector<const parseTree::DefFileFragment_t*> fragmentPtrs = { defFilePtr };
+    std::map<const parseTree::DefFileFragment_t*, size_t> fragmentIndexes = { { defFilePtr, 0 } };
+
+    for (size_t i = 0; i < fragmentPtrs.size(); i++)
+    {
+        for (auto& include : fragmentPtrs[i]->includedFiles)
+        {
+            if (fragmentIndexes.insert(std::make_pair(include.second,
+                                                      fragmentPtrs.size())).second)
+            {
+                fragmentPtrs.push_back(include.second);
+            }
+        }
+    }
+
+    output << FormatTag << '\n' << defFilePtr->type;
+    WriteString(output, defFilePtr->path);
+
+    // CURDIR is relative to the fragments, so it only depends on their paths.
+    output << '\n' << usedVars.size() - usedVars.count("CURDIR");
+    for (auto& name : usedVars)
+    {
+        if (name != "CURDIR")
+        {
+            WriteString(output, name);
+            WriteString(output, envVars::Get(name));
+        }
+    }
+
+    output << '\n' << fragmentPtrs.size();
+    for (auto fragmentPtr : fragmentPtrs)
+    {
+        auto hash = HashFile(fragmentPtr->path);
+        if (hash.empty())
+        {
+            return false;
+        }
+
+        output << '\n';
+        WriteString(output, fragmentPtr->path);
+        WriteString(output, hash);
+        output << ' ' << fragmentPtr->version;
+    }
+
+    // Tokens are linked from the last one of each fragment.
+    std::map<const parseTree::Token_t*, TokenRef_t> tokenRefs;
+
+    for (size_t i = 0; i < fragmentPtrs.size(); i++)
+    {
+        std::vector<const parseTree::Token_t*> tokenPtrs;
+
+        for (auto tokenPtr = fragmentPtrs[i]->lastTokenPtr; tokenPtr != NULL;
+             tokenPtr = tokenPtr->prevPtr)
+        {
+            tokenPtrs.push_back(tokenPtr);
+        }
+        std::reverse(tokenPtrs.begin(), tokenPtrs.end());
+
+        output << '\n' << tokenPtrs.size();
+        for (size_t j = 0; j < tokenPtrs.size(); j++)
+        {
+            auto tokenPtr = tokenPtrs[j];
+
+            tokenRefs[tokenPtr] = TokenRef_t(i, j);
+            output << '\n' << tokenPtr->type << ' ' << tokenPtr->line << ' ' << tokenPtr->column
+                   << ' ' << tokenPtr->curPos;
+            WriteString(output, tokenPtr->text);
+        }
+    }
+
+    for (auto fragmentPtr : fragmentPtrs)
+    {
+        output << '\n' << fragmentPtr->includedFiles.size();
+
+        for (auto& include : fragmentPtr->includedFiles)
+        {
+            auto iter = tokenRefs.find(include.first);
+            if (iter == tokenRefs.end())
+            {
+                return false;
+            }
+
+            output << ' ' << iter->second.first << ' ' << iter->second.second << ' '
+                   << fragmentIndexes[include.second];
+        }
+    }
+
+    output << '\n' << defFilePtr->sections.size();
+    for (auto sectionPtr : defFilePtr->sections)
+    {
+        if (!WriteItem(output, sectionPtr, tokenRefs))
+        {
+            return false;
+        }
+    }
+    output << '\n';
+
+    text = output.str();
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Write an entry to the cache directory.  Errors are ignored, the entry will just not be found
+ * next time.
+ */
+//--------------------------------------------------------------------------------------------------
+static void WriteEntry
+(
+    const std::string& key,
+    const std::string& text
+)
+//--------------------------------------------------------------------------------------------------
+{
+    auto entryPath = path::Combine(CacheDir, key);
+
+    // Write a temporary file first, so that an entry is never read while being written.
+    auto tempPath = entryPath + "." + std::to_string(getpid());
+
+    {
+        std::ofstream output(tempPath, std::ios::binary | std::ios::trunc);
+
+        if (!output.is_open())
+        {
+            return;
+        }
+
+        output << text;
+        output.close();
+
+        if (output.fail())
+        {
+            unlink(tempPath.c_str());
+            return;
+        }
+    }
+
+    if (rename(tempPath.c_str(), entryPath.c_str()) != 0)
+    {
+        unlink(tempPath.c_str());
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable the cache, keeping the cached parse trees in a given directory.
+ */
+//--------------------------------------------------------------------------------------------------
+void Enable
+(
+    const std::string& dirPath      ///< Path to the cache directory.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    file::MakeDir(dirPath);
+
+    CacheDir = dirPath;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Populate a definition file object from the cache.
+ *
+ * @return true if the parse tree was found in the cache and is up to date, false otherwise (the
+ *         object is left untouched).
+ */
+//--------------------------------------------------------------------------------------------------
+bool Load
+(
+    parseTree::DefFile_t* defFilePtr    ///< Definition file object to populate.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (CacheDir.empty() || (defFilePtr->type == parseTree::DefFile_t::SDEF))
+    {
+        return false;
+    }
+
+    auto key = GetKey(defFilePtr->type, defFilePtr->path);
+    std::string text;
+
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+
+        auto iter = Entries.find(key);
+        if (iter != Entries.end())
+        {
+            text = iter->second;
+        }
+    }
+
+    if (text.empty() && !ReadFile(path::Combine(CacheDir, key), text))
+    {
+        return false;
+    }
+
+    try
+    {
+        EntryReader_t reader(text);
+        EntryRecord_t entry;
+
+        ReadHeader(reader, entry);
+
+        if ((entry.type != defFilePtr->type) ||
+            (entry.path != defFilePtr->path) ||
+            (entry.fragments[0].path != defFilePtr->path) ||
+            !IsUpToDate(entry))
+        {
+            return false;
+        }
+
+        ReadBody(reader, entry);
+        CreateParseTree(entry, defFilePtr);
+    }
+    catch (std::exception& e)
+    {
+        // Invalid entry, or one too large to be loaded (std::bad_alloc, std::length_error...)
+        return false;
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store the parse tree of a definition file in the cache.
+ */
+//--------------------------------------------------------------------------------------------------
+void Store
+(
+    const parseTree::DefFile_t* defFilePtr,     ///< Parsed definition file.
+    const Lexer_t& lexer                        ///< Lexer which parsed the file.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // The existence of files is not tracked, so parse trees depending on it are not cached.
+    if (CacheDir.empty() ||
+        (defFilePtr->type == parseTree::DefFile_t::SDEF) ||
+        lexer.usedFileSystem)
+    {
+        return;
+    }
+
+    // Included files are searched for in LEGATO_ROOT.
+    auto usedVars = lexer.UsedVarNames();
+    usedVars.insert("LEGATO_ROOT");
+
+    std::string text;
+    if (!Serialize(defFilePtr, usedVars, text))
+    {
+        return;
+    }
+
+    auto key = GetKey(defFilePtr->type, defFilePtr->path);
+
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Entries[key] = text;
+    }
+
+    WriteEntry(key, text);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check a cache entry from a previous run.  If it is up to date, keep it in memory, otherwise
+ * parse the file again to update it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrefetchEntry
+(
+    const std::string& key
+)
+//--------------------------------------------------------------------------------------------------
+{
+    auto entryPath = path::Combine(CacheDir, key);
+    std::string text;
+    EntryRecord_t entry;
+
+    if (!ReadFile(entryPath, text))
+    {
+        return;
+    }
+
+    try
+    {
+        EntryReader_t reader(text);
+
+        ReadHeader(reader, entry);
+    }
+    catch (std::exception& e)
+    {
+        unlink(entryPath.c_str());
+        return;
+    }
+
+    if (IsUpToDate(entry))
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Entries[key] = text;
+
+        return;
+    }
+
+    if (!file::FileExists(entry.path))
+    {
+        unlink(entryPath.c_str());
+        return;
+    }
+
+    // Parsing stores the new parse tree.  Errors will be reported when the file is parsed again
+    // by the modellers.
+    try
+    {
+        switch (entry.type)
+        {
+            case parseTree::DefFile_t::ADEF:
+                adef::Parse(entry.path, false);
+                break;
+
+            case parseTree::DefFile_t::CDEF:
+                cdef::Parse(entry.path, false);
+                break;
+
+            case parseTree::DefFile_t::MDEF:
+                mdef::Parse(entry.path, false);
+                break;
+
+            case parseTree::DefFile_t::SDEF:
+                break;
+        }
+    }
+    catch (std::exception& e)
+    {
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bring the cache up to date before the files are parsed: check all the entries of the previous
+ * runs, and parse again the files which have changed since.  This is done in parallel, by up to
+ * a given number of threads.
+ */
+//--------------------------------------------------------------------------------------------------
+void Prefetch
+(
+    int jobCount    ///< Maximum number of threads (number of CPUs if 0).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (CacheDir.empty())
+    {
+        return;
+    }
+
+    std::vector<std::string> keys;
+    for (auto& name : file::ListFiles(CacheDir))
+    {
+        if (IsKey(name))
+        {
+            keys.push_back(name);
+        }
+    }
+
+    size_t threadCount = (jobCount > 0) ? jobCount : std::thread::hardware_concurrency();
+    threadCount = std::max<size_t>(1, std::min(threadCount, keys.size()));
+
+    size_t nextKey = 0;
+    std::mutex keyMutex;
+
+    auto worker = [&keys, &nextKey, &keyMutex]()
+        {
+            // The parse trees are not used here, so nothing must be printed.
+            parseTree::SetQuiet(true);
+
+            for (;;)
+            {
+                size_t i;
+                {
+                    std::lock_guard<std::mutex> lock(keyMutex);
+                    i = nextKey++;
+                }
+
+                if (i >= keys.size())
+                {
+                    break;
+                }
+
+                PrefetchEntry(keys[i]);
+            }
+        };
+
+    // The calling thread only waits, so that the memory it allocates (and hence the order of the
+    // objects sorted by address in the models) does not depend on the work done here.
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        threads.emplace_back(worker);
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+
+} // namespace cache
+
+} // namespace parser
@@ -0,0 +1,83 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file parseCache.h  Cache of parsed definition files.
+ *
+ * Parse trees of .adef, .cdef and .mdef files are kept in a cache directory, so that the files
+ * which have not changed since the last run of the tools do not have to be lexed and parsed again.
+ *
+ * A cache entry records the contents hash of the parsed file and of every file it includes, as
+ * well as the values of the variables used by the processing directives.  It is only used if all
+ * of them still match.  Parses which printed warnings or tested the existence of files
+ * (file_exists() and dir_exists()) are not cached.
+ *
+ * .sdef files are never cached, as parsing them sets the build variables.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LEGATO_DEFTOOLS_PARSE_CACHE_H_INCLUDE_GUARD
+#define LEGATO_DEFTOOLS_PARSE_CACHE_H_INCLUDE_GUARD
+
+
+namespace cache
+{
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Enable the cache, keeping the cached parse trees in a given directory.  The cache is disabled
+ * until this is called.
+ */
+//--------------------------------------------------------------------------------------------------
+void Enable
+(
+    const std::string& dirPath      ///< Path to the cache directory.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Populate a definition file object from the cache.
+ *
+ * @return true if the parse tree was found in the cache and is up to date, false otherwise (the
+ *         object is left untouched).
+ */
+//--------------------------------------------------------------------------------------------------
+bool Load
+(
+    parseTree::DefFile_t* defFilePtr    ///< Definition file object to populate.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Store the parse tree of a definition file in the cache.
+ */
+//--------------------------------------------------------------------------------------------------
+void Store
+(
+    const parseTree::DefFile_t* defFilePtr,     ///< Parsed definition file.
+    const Lexer_t& lexer                        ///< Lexer which parsed the file.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Bring the cache up to date before the files are parsed: check all the entries of the previous
+ * runs, and parse again the files which have changed since.  This is done in parallel, by up to
+ * a given number of threads.
+ *
+ * Must be called when the variables used by the definition files are set, and the calling
+ * thread is blocked until done.
+ */
+//--------------------------------------------------------------------------------------------------
+void Prefetch
+(
+    int jobCount    ///< Maximum number of threads (number of CPUs if 0).
+);
+
+
+} // namespace cache
+
+#endif // LEGATO_DEFTOOLS_PARSE_CACHE_H_INCLUDE_GUARD
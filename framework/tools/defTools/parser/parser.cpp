@@ -423,6 +423,14 @@ void ParseFile
                   << std::endl;
     }
 
+    // Files which have not changed since they were last parsed are loaded from the cache.
+    if (cache::Load(defFilePtr))
+    {
+        return;
+    }
+
+    size_t warningCount = parseTree::GetWarningCount();
+
     // Create a Lexer for this file.
     Lexer_t lexer(defFilePtr);
     lexer.beVerbose = beVerbose;
@@ -463,6 +471,12 @@ void ParseFile
                                              errorCount));
         }
     }
+
+    // Files with warnings are not cached, so that the warnings are printed every time.
+    if (parseTree::GetWarningCount() == warningCount)
+    {
+        cache::Store(defFilePtr, lexer);
+    }
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -0,0 +1,273 @@
+#
+# ifgen server
+#
+# Starting ifgen (importing jinja2, the parser and a language package, and compiling the templates)
+# costs much more than generating the files of a single interface, and a build runs ifgen once per
+# set of generated files.  With the --server option, ifgen therefore hands its job over to a
+# server process which has already done all of this, and which is shared by all the ifgen runs
+# using the same cache directory.  The build still runs one ifgen per set of generated files, so
+# only the out of date files are generated again.
+#
+# The server is started by the first job which finds none, and exits once it has been idle for
+# IdleTimeout seconds, or when ifgen itself is modified.  Each job is run in a child process forked
+# from the server, so that jobs run in parallel and are isolated from each other.  The job is run
+# locally whenever the server can't be used.
+#
+# This module is imported before the generators, so that a job handed over to the server doesn't
+# pay for loading them: it must only import standard modules.
+#
+# Copyright (C) Sierra Wireless Inc.
+#
+
+import argparse
+import errno
+import fcntl
+import hashlib
+import json
+import logging
+import os
+import socket
+import StringIO
+import subprocess
+import sys
+import tempfile
+import time
+import traceback
+
+
+# Seconds after which an idle server exits
+IdleTimeout = 60
+
+# Seconds given to a new server to accept connections
+StartTimeout = 5
+
+# Seconds given to the server to run a job
+JobTimeout = 300
+
+
+def _GetToolStamp():
+    """Get the time of the last modification of ifgen, so that a server doesn't run jobs for
+       another version of ifgen"""
+    toolDir = os.path.dirname(os.path.abspath(__file__))
+    stamp = 0
+    for dirPath, dirNames, fileNames in os.walk(toolDir):
+        for fileName in fileNames:
+            if not fileName.endswith('.pyc'):
+                stamp = max(stamp, os.path.getmtime(os.path.join(dirPath, fileName)))
+    return stamp
+
+
+def _GetSocketPath(cacheDir):
+    """Get the path of the socket of the server of a cache directory.  Socket paths are short, so
+       the socket is in a private directory of the temporary directory, named after the cache
+       directory.  Returns None if that directory can't be used."""
+    serverDir = os.path.join(tempfile.gettempdir(), 'ifgen-%d' % os.getuid())
+    try:
+        os.mkdir(serverDir, 0o700)
+    except OSError as e:
+        if e.errno != errno.EEXIST:
+            return None
+
+    # Don't hand jobs over to a process of another user
+    info = os.lstat(serverDir)
+    if info.st_uid != os.getuid() or (info.st_mode & 0o077):
+        return None
+
+    name = hashlib.md5(os.path.abspath(cacheDir)).hexdigest()
+    return os.path.join(serverDir, name)
+
+
+def _Receive(sock):
+    """Receive a message, until the peer shuts down its side of the connection"""
+    chunks = []
+    while True:
+        chunk = sock.recv(65536)
+        if not chunk:
+            break
+        chunks.append(chunk)
+    return json.loads(''.join(chunks))
+
+
+def _Send(sock, message):
+    sock.sendall(json.dumps(message))
+    sock.shutdown(socket.SHUT_WR)
+
+
+def _Connect(socketPath):
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    try:
+        sock.connect(socketPath)
+    except socket.error:
+        sock.close()
+        return None
+    return sock
+
+
+def _StartServer(cacheDir):
+    """Start a server for a cache directory, detached from the build.  Returns the server process."""
+    ifgenPath = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'ifgen')
+    with open(os.devnull, 'r+') as devNull:
+        return subprocess.Popen([sys.executable, '-E', ifgenPath, '--run-server',
+                                 '--cache-dir', os.path.abspath(cacheDir)],
+                                stdin=devNull, stdout=devNull, stderr=devNull, close_fds=True,
+                                cwd='/', preexec_fn=os.setsid)
+
+
+def RunClient(argList):
+    """Hand an ifgen job over to the server of its cache directory, if the --server option is
+       given.  Returns the exit status of the job, or None if the job must be run locally."""
+    parser = argparse.ArgumentParser(add_help=False)
+    parser.add_argument('--server', dest="server", action='store_true', default=False)
+    parser.add_argument('--run-server', dest="runServer", action='store_true', default=False)
+    parser.add_argument('--cache-dir', dest="cacheDir", action="store", default='')
+    args, leftOver = parser.parse_known_args(argList)
+
+    if not args.server or args.runServer or not args.cacheDir:
+        return None
+
+    socketPath = _GetSocketPath(args.cacheDir)
+    if socketPath is None:
+        return None
+
+    sock = _Connect(socketPath)
+    if sock is None:
+        server = _StartServer(args.cacheDir)
+        deadline = time.time() + StartTimeout
+        while sock is None and time.time() < deadline:
+            # A server which exits successfully found another one starting
+            if server.poll():
+                return None
+            time.sleep(0.05)
+            sock = _Connect(socketPath)
+        if sock is None:
+            return None
+
+    try:
+        sock.settimeout(JobTimeout)
+        _Send(sock, { 'args':  argList,
+                      'cwd':   os.getcwd(),
+                      'env':   dict(os.environ),
+                      'stamp': _GetToolStamp() })
+        reply = _Receive(sock)
+    except (socket.error, ValueError):
+        # The server stopped, run the job locally
+        return None
+    finally:
+        sock.close()
+
+    if reply.get('status') is None:
+        return None
+
+    sys.stdout.write(reply['stdout'].encode('utf-8'))
+    sys.stderr.write(reply['stderr'].encode('utf-8'))
+    return reply['status']
+
+
+def _RunJob(conn, runJob, stamp):
+    """Run a job received by the server, in a child process.  The job's output is sent back along
+       with its exit status."""
+    request = _Receive(conn)
+    if request['stamp'] != stamp:
+        # ifgen was modified since the server started: let the client run the job
+        _Send(conn, { 'status': None })
+        return False
+
+    # The job is run as if by the client
+    os.environ.clear()
+    for name, value in request['env'].iteritems():
+        os.environ[name.encode('utf-8')] = value.encode('utf-8')
+    os.chdir(request['cwd'].encode('utf-8'))
+
+    stdout = StringIO.StringIO()
+    stderr = StringIO.StringIO()
+    sys.stdout = stdout
+    sys.stderr = stderr
+    for handler in logging.getLogger().handlers:
+        handler.stream = stderr
+
+    try:
+        status = runJob([arg.encode('utf-8') for arg in request['args']])
+    except SystemExit as e:
+        # Invalid arguments
+        status = e.code
+    except Exception:
+        traceback.print_exc()
+        status = 1
+
+    _Send(conn, { 'status': status or 0,
+                  'stdout': stdout.getvalue(),
+                  'stderr': stderr.getvalue() })
+    return True
+
+
+def Serve(cacheDir, runJob, warmUp):
+    """Run the server of a cache directory, unless it is already running.  Each job is run by
+       runJob(argList), which returns the exit status of the job.  warmUp() is called once the
+       server accepts connections, to prepare for the jobs."""
+    socketPath = _GetSocketPath(cacheDir)
+    if socketPath is None:
+        return 1
+
+    # Only one server runs for a cache directory
+    lockFile = open(socketPath + '.lock', 'w')
+    try:
+        fcntl.flock(lockFile, fcntl.LOCK_EX | fcntl.LOCK_NB)
+    except IOError:
+        return 0
+
+    stamp = _GetToolStamp()
+
+    if os.path.exists(socketPath):
+        os.remove(socketPath)
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    server.bind(socketPath)
+    server.listen(128)
+
+    # The clients wait in the backlog until the server is ready
+    warmUp()
+
+    children = set()
+    isOutdated = False
+    server.settimeout(1)
+    idleSince = time.time()
+
+    while not isOutdated:
+        # Reap the jobs which are done
+        for pid in list(children):
+            donePid, status = os.waitpid(pid, os.WNOHANG)
+            if donePid:
+                children.discard(pid)
+                # A job declined by an outdated server is not an error
+                isOutdated = isOutdated or (os.WEXITSTATUS(status) == 2)
+        if children:
+            idleSince = time.time()
+        elif time.time() - idleSince > IdleTimeout:
+            break
+
+        try:
+            conn, address = server.accept()
+        except socket.timeout:
+            continue
+
+        pid = os.fork()
+        if pid == 0:
+            server.close()
+            try:
+                isRun = _RunJob(conn, runJob, stamp)
+            except Exception:
+                os._exit(1)
+            os._exit(0 if isRun else 2)
+
+        conn.close()
+        children.add(pid)
+        idleSince = time.time()
+
+    # New clients start a new server from now on
+    os.remove(socketPath)
+    server.close()
+    lockFile.close()
+
+    for pid in children:
+        os.waitpid(pid, 0)
+
+    return 0
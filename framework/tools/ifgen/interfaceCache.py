@@ -0,0 +1,204 @@
+#
+# Cache of parsed interfaces
+#
+# Parsing an .api file is by far the most expensive step of ifgen, and the same files (especially
+# the imported ones) are parsed again and again during a build.  The cache keeps the parsed
+# interfaces, keyed by the hash of the contents of their .api file, in memory and optionally in a
+# directory shared by all ifgen invocations.
+#
+# The interfaces are stored pickled, and a fresh copy is returned on each lookup, as code
+# generators are free to modify the interface they are given.
+#
+# An edited .api file gets a new entry, and its previous entries are no longer used.  The least
+# recently used entries are therefore removed from the cache directory once it holds more than
+# MaxDirEntries entries.
+#
+# Copyright (C) Sierra Wireless Inc.
+#
+
+import hashlib
+import logging
+import os
+import tempfile
+
+try:
+    import cPickle as pickle
+except ImportError:
+    import pickle
+
+import interfaceParser
+
+
+# Maximum number of entries kept in a cache directory
+MaxDirEntries = 1024
+
+
+#
+# Hash of the parser and of the interface representation, so that cached interfaces are not used
+# by another version of ifgen.
+#
+def _GetParserHash():
+    h = hashlib.md5()
+    for module in [ interfaceParser, interfaceParser.interfaceIR ]:
+        path = os.path.splitext(module.__file__)[0] + '.py'
+        with open(path, 'rb') as moduleFile:
+            h.update(moduleFile.read())
+    return h.hexdigest()
+
+
+class InterfaceCache(object):
+    """Cache of parsed interfaces"""
+
+    def __init__(self, cacheDir=None):
+        self.cacheDir = cacheDir
+        self.parserHash = _GetParserHash()
+        # Pickled interfaces, and the files they depend on, by key
+        self.entries = {}
+        # Hash of the contents of the files, by path.  Files are not expected to change during
+        # a run of ifgen.
+        self.fileHashes = {}
+        self.hits = 0
+        self.misses = 0
+
+        if self.cacheDir and not os.path.isdir(self.cacheDir):
+            try:
+                os.makedirs(self.cacheDir)
+            except OSError:
+                # May have been created by another ifgen in the meantime
+                if not os.path.isdir(self.cacheDir):
+                    logging.warning("Cannot create cache directory '%s'" % self.cacheDir)
+                    self.cacheDir = None
+
+    def Parse(self, apiFile, searchPath=[], ifaceName=None):
+        """Get the parsed interface of an .api file, parsing it only if it is not in the cache.
+           Same arguments and result as interfaceParser.ParseCode()."""
+        apiPath = interfaceParser.FindApiFile(apiFile, searchPath)
+        fileHash = self._HashFile(apiPath)
+        if fileHash is None:
+            # Let the parser report the error
+            return self._ParseFile(apiFile, searchPath, ifaceName)
+
+        # Paths may be relative, and are kept as they are in the parsed interface
+        h = hashlib.md5()
+        h.update(repr((self.parserHash, os.getcwd(), apiPath, fileHash,
+                       ifaceName, list(searchPath))).encode('utf-8'))
+        key = h.hexdigest()
+
+        entry = self.entries.get(key)
+        if entry is None:
+            entry = self._Load(key)
+
+        if entry is not None:
+            self.hits += 1
+            return pickle.loads(entry[1])
+
+        self.misses += 1
+        iface = self._ParseFile(apiFile, searchPath, ifaceName)
+        if iface is None:
+            return None
+
+        entry = (self._GetDependencies(iface), pickle.dumps(iface, pickle.HIGHEST_PROTOCOL))
+        self.entries[key] = entry
+        self._Store(key, entry)
+
+        return iface
+
+    def _ParseFile(self, apiFile, searchPath, ifaceName):
+        # Look up the imported files in the cache as well
+        importParser = interfaceParser.ImportParser
+        interfaceParser.ImportParser = self.Parse
+        try:
+            return interfaceParser.ParseCode(apiFile, searchPath, ifaceName)
+        finally:
+            interfaceParser.ImportParser = importParser
+
+    def _HashFile(self, path):
+        if path not in self.fileHashes:
+            try:
+                with open(path, 'rb') as apiFile:
+                    self.fileHashes[path] = hashlib.md5(apiFile.read()).hexdigest()
+            except IOError:
+                return None
+        return self.fileHashes[path]
+
+    def _GetDependencies(self, iface):
+        """Get the path and hash of all the files imported by an interface, directly or not"""
+        dependencies = {}
+        pending = list(iface.imports.values())
+        while pending:
+            importedIface = pending.pop()
+            if importedIface.path not in dependencies:
+                dependencies[importedIface.path] = self._HashFile(importedIface.path)
+                pending.extend(importedIface.imports.values())
+        return dependencies
+
+    def _IsUpToDate(self, dependencies):
+        for path, fileHash in dependencies.items():
+            if self._HashFile(path) != fileHash:
+                return False
+        return True
+
+    def _Load(self, key):
+        if not self.cacheDir:
+            return None
+
+        try:
+            with open(os.path.join(self.cacheDir, key), 'rb') as cacheFile:
+                entry = pickle.load(cacheFile)
+        except Exception:
+            # Not cached, or an unreadable entry which will be replaced
+            return None
+
+        if not self._IsUpToDate(entry[0]):
+            return None
+
+        # The modification time of an entry is the time it was last used, for pruning
+        try:
+            os.utime(os.path.join(self.cacheDir, key), None)
+        except OSError:
+            pass
+
+        self.entries[key] = entry
+        return entry
+
+    def _Store(self, key, entry):
+        if not self.cacheDir:
+            return
+
+        # Write a temporary file first, as other ifgen processes may be reading the cache
+        try:
+            fd, tempPath = tempfile.mkstemp(dir=self.cacheDir)
+            with os.fdopen(fd, 'wb') as cacheFile:
+                pickle.dump(entry, cacheFile, pickle.HIGHEST_PROTOCOL)
+            os.rename(tempPath, os.path.join(self.cacheDir, key))
+        except (IOError, OSError) as e:
+            logging.warning("Cannot write to cache directory '%s': %s" % (self.cacheDir, e))
+            return
+
+        self._Prune()
+
+    def _Prune(self):
+        """Remove the least recently used entries of the cache directory, if it holds too many"""
+        try:
+            names = os.listdir(self.cacheDir)
+        except OSError:
+            return
+
+        if len(names) <= MaxDirEntries:
+            return
+
+        entries = []
+        for name in names:
+            try:
+                entries.append((os.path.getmtime(os.path.join(self.cacheDir, name)), name))
+            except OSError:
+                # Already removed by another ifgen
+                pass
+        entries.sort()
+
+        # Remove a quarter of the entries at once, so that pruning is not needed on each store
+        for mtime, name in entries[:len(entries) - (MaxDirEntries * 3 // 4)]:
+            try:
+                os.remove(os.path.join(self.cacheDir, name))
+            except OSError:
+                pass
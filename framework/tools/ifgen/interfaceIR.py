@@ -49,6 +49,12 @@ class Type(object):
     def __repr__(self):
         return "Type({},{})".format(repr(self.name), self.size)
 
+    def __reduce_ex__(self, protocol):
+        # Built-in types are compared by identity, so unpickle them as the module instances
+        if BUILTIN_TYPES.get(self.name) is self:
+            return (GetBuiltinType, (self.name,))
+        return super(Type, self).__reduce_ex__(protocol)
+
 class BasicType(Type):
     """Basic type represents a built-in type"""
     def __init__(self, name, size, location=None):
@@ -303,6 +309,17 @@ ERROR_TYPE  = BasicType('**ERROR**', 0)
 # Magic old-handler type
 OLD_HANDLER_TYPE = OldHandlerType()
 
+# Built-in types by name
+BUILTIN_TYPES = dict((builtinType.name, builtinType)
+                     for builtinType in [ UINT8_TYPE, UINT16_TYPE, UINT32_TYPE, UINT64_TYPE,
+                                          INT8_TYPE, INT16_TYPE, INT32_TYPE, INT64_TYPE,
+                                          BOOL_TYPE, CHAR_TYPE, DOUBLE_TYPE, SIZE_TYPE,
+                                          STRING_TYPE, FILE_TYPE, RESULT_TYPE, ONOFF_TYPE,
+                                          ERROR_TYPE, OLD_HANDLER_TYPE ])
+
+def GetBuiltinType(name):
+    return BUILTIN_TYPES[name]
+
 #---------------------------------------------------------------------------------------------------
 # Formal parameters
 #---------------------------------------------------------------------------------------------------
@@ -2489,7 +2489,7 @@ class interfaceParser(Parser):
                     basename=filename68
                     fullFilename=filename68 + ".api"
 
-                self.iface.imports[basename] = ParseCode(fullFilename, self.searchPath)
+                self.iface.imports[basename] = ParseImport(fullFilename, self.searchPath)
 
                 #action end
 
@@ -3019,19 +3019,31 @@ def main(argv, stdin=sys.stdin, stdout=sys.stdout, stderr=sys.stderr):
 
 
 
-def ParseCode(apiFile, searchPath=[], ifaceName=None):
+# Function used to parse imported files instead of ParseCode(), if set; e.g. to look them up
+# in a cache of parsed interfaces.
+ImportParser = None
+
+def ParseImport(apiFile, searchPath):
+    if ImportParser:
+        return ImportParser(apiFile, searchPath)
+    return ParseCode(apiFile, searchPath)
+
+def FindApiFile(apiFile, searchPath=[]):
     if os.path.isabs(apiFile) or os.path.isfile(apiFile):
-        apiPath = apiFile
-    else:
-        for path in searchPath:
-            apiPath = os.path.join(path, apiFile)
-            if os.path.isfile(apiPath):
-                break
-        else:
-            # File not found in search path.  Try as a relative path.
-            # This will usually fail since the current directory should be in the search
-            # path but at least will raise a reasonable exception
-            apiPath = apiFile
+        return apiFile
+
+    for path in searchPath:
+        apiPath = os.path.join(path, apiFile)
+        if os.path.isfile(apiPath):
+            return apiPath
+
+    # File not found in search path.  Try as a relative path.
+    # This will usually fail since the current directory should be in the search
+    # path but at least will raise a reasonable exception
+    return apiFile
+
+def ParseCode(apiFile, searchPath=[], ifaceName=None):
+    apiPath = FindApiFile(apiFile, searchPath)
 
     fileStream = ANTLRFileStream(apiPath, 'utf-8')
     lexer = interfaceLexer(fileStream)
@@ -313,10 +313,14 @@ void BuildScriptGenerator_t::GenerateBuildRules
               "            $externalCommand\n"
               "\n";
 
-    // Generate a rule for running ifgen.
+    // Generate a rule for running ifgen.  The interfaces parsed by ifgen are cached in the build
+    // directory, as the same .api files are parsed by many ifgen runs (once per language and side
+    // of each interface, and again for each file that imports them).  Each run hands its job over
+    // to an ifgen server shared by the build, which has already loaded the code generators.
     script << "rule GenInterfaceCode\n"
               "  description = Generating IPC interface code\n"
-              "  command = ifgen --output-dir $outputDir $ifgenFlags $in\n"
+              "  command = ifgen --server --output-dir $outputDir"
+              " --cache-dir $builddir/ifgen-cache $ifgenFlags $in\n"
               "\n";
 
     // Generate a rule for copying a file.
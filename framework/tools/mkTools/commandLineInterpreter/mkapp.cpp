@@ -399,6 +399,11 @@ void MakeApp
         envVars::Save(BuildParams);
     }
 
+    // Keep the parse trees of the definition files, to only parse the files which have changed
+    // next time, and parse the changed ones in parallel.
+    parser::cache::Enable(path::Combine(BuildParams.workingDir, "parseCache"));
+    parser::cache::Prefetch(BuildParams.jobCount);
+
     // Construct a model of the application.
     model::App_t* appPtr = modeller::GetApp(AdefFilePath, BuildParams);
 
@@ -384,6 +384,10 @@ void MakeSystem
         envVars::Save(BuildParams);
     }
 
+    // Keep the parse trees of the definition files, to only parse the files which have changed
+    // next time.
+    parser::cache::Enable(path::Combine(BuildParams.workingDir, "parseCache"));
+
     // Construct a model of the system.
     model::System_t* systemPtr = modeller::GetSystem(SdefFilePath, BuildParams);
 
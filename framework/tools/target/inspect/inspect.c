@@ -19,6 +19,7 @@
 #  include "messagingInterface.h"
 #  include "messagingProtocol.h"
 #  include "messagingSession.h"
+#  include "statsPage.h"
 #endif
 #include "limit.h"
 #include "fileDescriptor.h"
@@ -113,7 +114,13 @@ typedef enum
     INSPECT_INSP_TYPE_IPC_SERVERS,
     INSPECT_INSP_TYPE_IPC_CLIENTS,
     INSPECT_INSP_TYPE_IPC_SERVERS_SESSIONS,
-    INSPECT_INSP_TYPE_IPC_CLIENTS_SESSIONS
+    INSPECT_INSP_TYPE_IPC_CLIENTS_SESSIONS,
+#endif
+#if LE_CONFIG_STATS_PAGE
+    INSPECT_INSP_TYPE_STATS,
+#endif
+#if LE_CONFIG_LOCK_STATS
+    INSPECT_INSP_TYPE_LOCKS,
 #endif
 }
 InspType_t;
@@ -424,6 +431,16 @@ static bool IsFollowing = false;
 static bool IsVerbose = false;
 
 
+#if LE_CONFIG_LOCK_STATS
+//--------------------------------------------------------------------------------------------------
+/**
+ * true = reset the lock counters of the process before printing them ("inspect locks --reset").
+ **/
+//--------------------------------------------------------------------------------------------------
+static bool IsLockReset = false;
+#endif
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Type of Timer under inspection: TIMER_NON_WAKEUP / TIMER_WAKEUP
@@ -1913,6 +1930,12 @@ static void PrintHelp
                                                                                       "\n"
 #if LE_CONFIG_LINUX
         "    inspect ipc <servers|clients [sessions]> [OPTIONS] PID\n"
+#endif
+#if LE_CONFIG_STATS_PAGE
+        "    inspect stats [OPTIONS] [PID]\n"
+#endif
+#if LE_CONFIG_LOCK_STATS
+        "    inspect locks [OPTIONS] [--reset] PID\n"
 #endif
         "\n"
         "DESCRIPTION:\n"
@@ -1930,6 +1953,23 @@ static void PrintHelp
 #if LE_CONFIG_LINUX
         "    inspect ipc                Prints the info of ipc in all threads for the"
                                         " specified process.\n"
+#endif
+#if LE_CONFIG_STATS_PAGE
+        "    inspect stats              Prints the live statistics (pools, threads and ipc"
+                                        " sessions) published by\n"
+        "                               the specified process, or a summary line for every"
+                                        " process if no PID\n"
+        "                               is given.  The processes are not stopped.\n"
+#endif
+#if LE_CONFIG_LOCK_STATS
+        "    inspect locks              Prints the acquisitions, contention, wait times and"
+                                        " hold times of the\n"
+        "                               mutexes and semaphores of the specified process."
+                                        "  Locks that were\n"
+        "                               never acquired are only printed in verbose mode."
+                                        "  With --reset,\n"
+        "                               the counters are reset first.  The process is not"
+                                        " stopped.\n"
 #endif
         "\n"
         "OPTIONS:\n"
@@ -4520,6 +4560,585 @@ static void RefreshTimerHandler
     target_Start(PidToInspect);
 }
 
+#if LE_CONFIG_STATS_PAGE
+//--------------------------------------------------------------------------------------------------
+/**
+ * Statistics page of the process being inspected by "inspect stats PID", mapped on the first
+ * round and kept mapped while following.
+ */
+//--------------------------------------------------------------------------------------------------
+static const statsPage_Header_t* StatsPagePtr = NULL;
+static size_t StatsPageSize = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of lines printed by the previous round of "inspect stats", to clear them when following.
+ */
+//--------------------------------------------------------------------------------------------------
+static int StatsLineCount = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints the summary of the latency histogram of an IPC session, as a JSON object or as table
+ * columns.
+ */
+//--------------------------------------------------------------------------------------------------
+static void PrintSessionLatency
+(
+    const statsPage_SessionSlot_t* sessionPtr  ///< [IN] Copy of the session's slot.
+)
+{
+    uint64_t mean = sessionPtr->latencySumUs / sessionPtr->latencyCount;
+    uint64_t p50 = statsPage_GetLatencyPercentile(sessionPtr, 50.0);
+    uint64_t p90 = statsPage_GetLatencyPercentile(sessionPtr, 90.0);
+    uint64_t p99 = statsPage_GetLatencyPercentile(sessionPtr, 99.0);
+    uint64_t p999 = statsPage_GetLatencyPercentile(sessionPtr, 99.9);
+
+    if (IsOutputJson)
+    {
+        printf("{\"Count\":%" PRIu64 ",\"MeanUs\":%" PRIu64 ",\"P50Us\":%" PRIu64 ","
+               "\"P90Us\":%" PRIu64 ",\"P99Us\":%" PRIu64 ",\"P999Us\":%" PRIu64 ","
+               "\"MaxUs\":%" PRIu32 ",\"Buckets\":[",
+               sessionPtr->latencyCount, mean, p50, p90, p99, p999, sessionPtr->latencyMaxUs);
+
+        // Only non-empty buckets, as [lower bound in us, count] pairs.
+        const char* separatorPtr = "";
+        uint32_t index;
+        for (index = 0; index < STATSPAGE_LATENCY_BUCKETS; index++)
+        {
+            if (sessionPtr->latencyBuckets[index] != 0)
+            {
+                printf("%s[%" PRIu64 ",%" PRIu32 "]", separatorPtr,
+                       statsPage_LatencyBucketLowerBound(index), sessionPtr->latencyBuckets[index]);
+                separatorPtr = ",";
+            }
+        }
+        printf("]}");
+    }
+    else
+    {
+        printf("%10" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64
+               " %8" PRIu32,
+               sessionPtr->latencyCount, mean, p50, p90, p99, p999, sessionPtr->latencyMaxUs);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints the memory pools, threads and IPC sessions published in a statistics page.
+ *
+ * @return Number of lines printed.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PrintStatsPage
+(
+    const statsPage_Header_t* hdrPtr    ///< [IN] Mapped statistics page.
+)
+{
+    statsPage_PoolSlot_t pool;
+    statsPage_ThreadSlot_t thread;
+    statsPage_SessionSlot_t session;
+    const char* separatorPtr = "";
+    int lineCount = 0;
+    size_t i;
+
+    if (IsOutputJson)
+    {
+        printf("{\"Pid\":%d,\"Dropped\":%" PRIu32 ",\"Pools\":[", hdrPtr->pid,
+               hdrPtr->droppedCount);
+    }
+    else
+    {
+        printf("PROCESS %d", hdrPtr->pid);
+        if (hdrPtr->droppedCount > 0)
+        {
+            printf(" (%" PRIu32 " objects not published, tables full)", hdrPtr->droppedCount);
+        }
+        printf("\n\n%-40s %10s %8s %8s %8s %9s %12s\n", "POOL", "BLOCK SIZE", "TOTAL", "IN USE",
+               "MAX USED", "OVERFLOWS", "ALLOCS");
+        lineCount += 3;
+    }
+
+    for (i = 0; i < hdrPtr->table[STATSPAGE_TABLE_POOL].count; i++)
+    {
+        if (!statsPage_ReadSlot(hdrPtr, STATSPAGE_TABLE_POOL, i, &pool, sizeof(pool)))
+        {
+            continue;
+        }
+
+        if (IsOutputJson)
+        {
+            printf("%s{\"Name\":\"%s\",\"SubPool\":%s,\"BlockSize\":%" PRIu32 ","
+                   "\"TotalBlocks\":%" PRIu32 ",\"BlocksInUse\":%" PRIu32 ","
+                   "\"MaxBlocksUsed\":%" PRIu32 ",\"Overflows\":%" PRIu32 ","
+                   "\"Allocations\":%" PRIu64 "}",
+                   separatorPtr, pool.hdr.name, pool.isSubPool ? "true" : "false",
+                   pool.blockSize, pool.totalBlocks, pool.numBlocksInUse, pool.maxNumBlocksUsed,
+                   pool.numOverflows, pool.numAllocations);
+            separatorPtr = ",";
+        }
+        else
+        {
+            printf("%-40s %10" PRIu32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32 " %9" PRIu32
+                   " %12" PRIu64 "\n",
+                   pool.hdr.name, pool.blockSize, pool.totalBlocks, pool.numBlocksInUse,
+                   pool.maxNumBlocksUsed, pool.numOverflows, pool.numAllocations);
+            lineCount++;
+        }
+    }
+
+    if (IsOutputJson)
+    {
+        printf("],\"Threads\":[");
+        separatorPtr = "";
+    }
+    else
+    {
+        printf("\n%-24s %8s %7s %8s %12s %12s %14s\n", "THREAD", "TID", "TIMERS", "BACKLOG",
+               "MAX BACKLOG", "EVENTS", "TIMER EXPIRIES");
+        lineCount += 2;
+    }
+
+    for (i = 0; i < hdrPtr->table[STATSPAGE_TABLE_THREAD].count; i++)
+    {
+        if (!statsPage_ReadSlot(hdrPtr, STATSPAGE_TABLE_THREAD, i, &thread, sizeof(thread)))
+        {
+            continue;
+        }
+
+        if (IsOutputJson)
+        {
+            printf("%s{\"Name\":\"%s\",\"Tid\":%" PRId32 ",\"ActiveTimers\":%" PRIu32 ","
+                   "\"EventBacklog\":%" PRIu32 ",\"MaxEventBacklog\":%" PRIu32 ","
+                   "\"EventsProcessed\":%" PRIu64 ",\"TimerExpiries\":%" PRIu64 "}",
+                   separatorPtr, thread.hdr.name, thread.tid, thread.activeTimers,
+                   thread.eventBacklog, thread.maxEventBacklog, thread.eventsProcessed,
+                   thread.timerExpiries);
+            separatorPtr = ",";
+        }
+        else
+        {
+            printf("%-24s %8" PRId32 " %7" PRIu32 " %8" PRIu32 " %12" PRIu32 " %12" PRIu64
+                   " %14" PRIu64 "\n",
+                   thread.hdr.name, thread.tid, thread.activeTimers, thread.eventBacklog,
+                   thread.maxEventBacklog, thread.eventsProcessed, thread.timerExpiries);
+            lineCount++;
+        }
+    }
+
+    if (IsOutputJson)
+    {
+        printf("],\"Sessions\":[");
+        separatorPtr = "";
+    }
+    else
+    {
+        printf("\n%-32s %6s %6s %6s %8s %6s %7s %12s %12s\n", "INTERFACE", "SIDE", "STATE",
+               "TX Q", "MAX TX Q", "RX Q", "PENDING", "SENT", "RECEIVED");
+        lineCount += 2;
+    }
+
+    for (i = 0; i < hdrPtr->table[STATSPAGE_TABLE_SESSION].count; i++)
+    {
+        if (!statsPage_ReadSlot(hdrPtr, STATSPAGE_TABLE_SESSION, i, &session, sizeof(session)))
+        {
+            continue;
+        }
+
+        if (IsOutputJson)
+        {
+            printf("%s{\"Interface\":\"%s\",\"Server\":%s,\"Open\":%s,"
+                   "\"TxQueueDepth\":%" PRIu32 ",\"MaxTxQueueDepth\":%" PRIu32 ","
+                   "\"RxQueueDepth\":%" PRIu32 ",\"PendingTxns\":%" PRIu32 ","
+                   "\"MsgsSent\":%" PRIu64 ",\"MsgsReceived\":%" PRIu64,
+                   separatorPtr, session.hdr.name, session.isServer ? "true" : "false",
+                   session.isOpen ? "true" : "false", session.txQueueDepth,
+                   session.maxTxQueueDepth, session.rxQueueDepth, session.pendingTxns,
+                   session.msgsSent, session.msgsReceived);
+            if (session.latencyCount > 0)
+            {
+                printf(",\"Latency\":");
+                PrintSessionLatency(&session);
+            }
+            printf("}");
+            separatorPtr = ",";
+        }
+        else
+        {
+            printf("%-32s %6s %6s %6" PRIu32 " %8" PRIu32 " %6" PRIu32 " %7" PRIu32 " %12" PRIu64
+                   " %12" PRIu64 "\n",
+                   session.hdr.name, session.isServer ? "server" : "client",
+                   session.isOpen ? "open" : "closed", session.txQueueDepth,
+                   session.maxTxQueueDepth, session.rxQueueDepth, session.pendingTxns,
+                   session.msgsSent, session.msgsReceived);
+            lineCount++;
+        }
+    }
+
+    if (IsOutputJson)
+    {
+        printf("]}\n");
+        return lineCount;
+    }
+
+    // Latency histograms are only recorded when enabled in the publishing process.
+    bool isLatencyHeaderPrinted = false;
+
+    for (i = 0; i < hdrPtr->table[STATSPAGE_TABLE_SESSION].count; i++)
+    {
+        if ((!statsPage_ReadSlot(hdrPtr, STATSPAGE_TABLE_SESSION, i, &session, sizeof(session))) ||
+            (session.latencyCount == 0))
+        {
+            continue;
+        }
+
+        if (!isLatencyHeaderPrinted)
+        {
+            printf("\n%-32s %6s %10s %8s %8s %8s %8s %8s %8s\n", "INTERFACE (LATENCY IN US)",
+                   "SIDE", "COUNT", "MEAN", "P50", "P90", "P99", "P99.9", "MAX");
+            lineCount += 2;
+            isLatencyHeaderPrinted = true;
+        }
+
+        printf("%-32s %6s ", session.hdr.name, session.isServer ? "server" : "client");
+        PrintSessionLatency(&session);
+        printf("\n");
+        lineCount++;
+    }
+
+    return lineCount;
+}
+
+
+#if LE_CONFIG_LOCK_STATS
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints the mutex and semaphore counters published in a statistics page.  Times are printed in
+ * microseconds, or nanoseconds in JSON.
+ *
+ * @return Number of lines printed.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PrintLockStats
+(
+    const statsPage_Header_t* hdrPtr    ///< [IN] Mapped statistics page.
+)
+{
+    statsPage_LockSlot_t lock;
+    const char* separatorPtr = "";
+    int lineCount = 0;
+    size_t i;
+
+    if (IsOutputJson)
+    {
+        printf("{\"Pid\":%d,\"Locks\":[", hdrPtr->pid);
+    }
+    else
+    {
+        printf("PROCESS %d\n\n%-32s %5s %12s %10s %12s %10s %12s %10s\n", hdrPtr->pid,
+               "LOCK", "TYPE", "ACQUIRED", "CONTENDED", "WAIT US", "MAX WAIT", "HOLD US",
+               "MAX HOLD");
+        lineCount += 3;
+    }
+
+    for (i = 0; i < hdrPtr->table[STATSPAGE_TABLE_LOCK].count; i++)
+    {
+        if ((!statsPage_ReadSlot(hdrPtr, STATSPAGE_TABLE_LOCK, i, &lock, sizeof(lock))) ||
+            ((lock.acquisitions == 0) && !IsVerbose))
+        {
+            continue;
+        }
+
+        if (IsOutputJson)
+        {
+            printf("%s{\"Name\":\"%s\",\"Semaphore\":%s,\"Acquisitions\":%" PRIu64 ","
+                   "\"Contended\":%" PRIu64 ",\"WaitTotalNs\":%" PRIu64 ","
+                   "\"WaitMaxNs\":%" PRIu64 ",\"HoldTotalNs\":%" PRIu64 ","
+                   "\"HoldMaxNs\":%" PRIu64 "}",
+                   separatorPtr, lock.hdr.name, lock.isSemaphore ? "true" : "false",
+                   lock.acquisitions, lock.contended, lock.waitTotalNs, lock.waitMaxNs,
+                   lock.holdTotalNs, lock.holdMaxNs);
+            separatorPtr = ",";
+        }
+        else
+        {
+            printf("%-32s %5s %12" PRIu64 " %10" PRIu64 " %12" PRIu64 " %10" PRIu64
+                   " %12" PRIu64 " %10" PRIu64 "\n",
+                   lock.hdr.name, lock.isSemaphore ? "sem" : "mutex", lock.acquisitions,
+                   lock.contended, lock.waitTotalNs / 1000, lock.waitMaxNs / 1000,
+                   lock.holdTotalNs / 1000, lock.holdMaxNs / 1000);
+            lineCount++;
+        }
+    }
+
+    if (IsOutputJson)
+    {
+        printf("]}\n");
+    }
+
+    return lineCount;
+}
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Prints one summary line for every process that publishes a statistics page.  Processes whose
+ * page cannot be mapped (no page, or not allowed to look at it) are skipped.
+ *
+ * @return Number of lines printed.
+ */
+//--------------------------------------------------------------------------------------------------
+static int PrintStatsSummaries
+(
+    void
+)
+{
+    DIR* dirPtr = opendir("/proc");
+    struct dirent* entryPtr;
+    const char* separatorPtr = "";
+    int lineCount = 0;
+
+    if (dirPtr == NULL)
+    {
+        fprintf(stderr, "Could not open /proc (%m).\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (IsOutputJson)
+    {
+        printf("{\"Processes\":[");
+    }
+    else
+    {
+        printf("%8s %-16s %6s %10s %8s %7s %8s %9s %12s %12s\n", "PID", "NAME", "POOLS",
+               "BLOCKS", "THREADS", "TIMERS", "BACKLOG", "SESSIONS", "SENT", "RECEIVED");
+        lineCount++;
+    }
+
+    while ((entryPtr = readdir(dirPtr)) != NULL)
+    {
+        const statsPage_Header_t* hdrPtr;
+        size_t size;
+        int pid;
+
+        if ((le_utf8_ParseInt(&pid, entryPtr->d_name) != LE_OK) ||
+            (statsPage_Map(pid, &hdrPtr, &size) != LE_OK))
+        {
+            continue;
+        }
+
+        uint32_t poolCount = 0, blocksInUse = 0;
+        uint32_t threadCount = 0, timerCount = 0, backlog = 0;
+        uint32_t sessionCount = 0;
+        uint64_t msgsSent = 0, msgsReceived = 0;
+        statsPage_PoolSlot_t pool;
+        statsPage_ThreadSlot_t thread;
+        statsPage_SessionSlot_t session;
+        size_t i;
+
+        for (i = 0; i < hdrPtr->table[STATSPAGE_TABLE_POOL].count; i++)
+        {
+            if (statsPage_ReadSlot(hdrPtr, STATSPAGE_TABLE_POOL, i, &pool, sizeof(pool)))
+            {
+                poolCount++;
+                blocksInUse += pool.numBlocksInUse;
+            }
+        }
+        for (i = 0; i < hdrPtr->table[STATSPAGE_TABLE_THREAD].count; i++)
+        {
+            if (statsPage_ReadSlot(hdrPtr, STATSPAGE_TABLE_THREAD, i, &thread, sizeof(thread)))
+            {
+                threadCount++;
+                timerCount += thread.activeTimers;
+                backlog += thread.eventBacklog;
+            }
+        }
+        for (i = 0; i < hdrPtr->table[STATSPAGE_TABLE_SESSION].count; i++)
+        {
+            if (statsPage_ReadSlot(hdrPtr, STATSPAGE_TABLE_SESSION, i, &session,
+                                   sizeof(session)))
+            {
+                sessionCount++;
+                msgsSent += session.msgsSent;
+                msgsReceived += session.msgsReceived;
+            }
+        }
+
+        statsPage_Unmap(hdrPtr, size);
+
+        // The command name is only for display, so ignore errors reading it.
+        char name[17] = "";
+        char path[LIMIT_MAX_PATH_BYTES];
+        snprintf(path, sizeof(path), "/proc/%d/comm", pid);
+        FILE* filePtr = fopen(path, "r");
+        if (filePtr != NULL)
+        {
+            if (fgets(name, sizeof(name), filePtr) != NULL)
+            {
+                name[strcspn(name, "\n")] = '\0';
+            }
+            fclose(filePtr);
+        }
+
+        if (IsOutputJson)
+        {
+            printf("%s{\"Pid\":%d,\"Name\":\"%s\",\"Pools\":%" PRIu32 ","
+                   "\"BlocksInUse\":%" PRIu32 ",\"Threads\":%" PRIu32 ","
+                   "\"ActiveTimers\":%" PRIu32 ",\"EventBacklog\":%" PRIu32 ","
+                   "\"Sessions\":%" PRIu32 ",\"MsgsSent\":%" PRIu64 ",\"MsgsReceived\":%" PRIu64
+                   "}",
+                   separatorPtr, pid, name, poolCount, blocksInUse, threadCount, timerCount,
+                   backlog, sessionCount, msgsSent, msgsReceived);
+            separatorPtr = ",";
+        }
+        else
+        {
+            printf("%8d %-16s %6" PRIu32 " %10" PRIu32 " %8" PRIu32 " %7" PRIu32 " %8" PRIu32
+                   " %9" PRIu32 " %12" PRIu64 " %12" PRIu64 "\n",
+                   pid, name, poolCount, blocksInUse, threadCount, timerCount, backlog,
+                   sessionCount, msgsSent, msgsReceived);
+            lineCount++;
+        }
+    }
+
+    closedir(dirPtr);
+
+    if (IsOutputJson)
+    {
+        printf("]}\n");
+    }
+
+    return lineCount;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Performs one round of "inspect stats".  Unlike the other inspections, this reads the
+ * statistics pages published by the processes and never stops or traces them.
+ */
+//--------------------------------------------------------------------------------------------------
+static void InspectStats
+(
+    void
+)
+{
+    if (!IsOutputJson)
+    {
+        printf("%c[1G", ESCAPE_CHAR);                   // Move cursor to the column 1.
+        printf("%c[%dA", ESCAPE_CHAR, StatsLineCount);  // Move cursor up to the top of the table.
+        printf("%c[0J", ESCAPE_CHAR);                   // Clear Screen.
+    }
+
+    if (PidToInspect <= 0)
+    {
+        StatsLineCount = PrintStatsSummaries();
+    }
+    else
+    {
+        if (StatsPagePtr == NULL)
+        {
+            le_result_t result = statsPage_Map(PidToInspect, &StatsPagePtr, &StatsPageSize);
+
+            if (result != LE_OK)
+            {
+                fprintf(stderr, "Cannot read the statistics page of process %d (%s).\n",
+                        PidToInspect, LE_RESULT_TXT(result));
+                exit(EXIT_FAILURE);
+            }
+        }
+        // The mapping outlives the process, so check that it is still there.
+        else if ((kill(PidToInspect, 0) == -1) && (errno == ESRCH))
+        {
+            printf("Process %d has exited.\n", PidToInspect);
+            exit(EXIT_SUCCESS);
+        }
+
+#if LE_CONFIG_LOCK_STATS
+        if (InspectType == INSPECT_INSP_TYPE_LOCKS)
+        {
+            StatsLineCount = PrintLockStats(StatsPagePtr);
+        }
+        else
+#endif
+        {
+            StatsLineCount = PrintStatsPage(StatsPagePtr);
+        }
+    }
+
+    fflush(stdout);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Refresh timer handler for "inspect stats".
+ */
+//--------------------------------------------------------------------------------------------------
+static void StatsRefreshTimerHandler
+(
+    le_timer_Ref_t timerRef
+)
+{
+    LE_UNUSED(timerRef);
+
+    InspectStats();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Runs "inspect stats", once or periodically.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StartInspectStats
+(
+    void
+)
+{
+#if LE_CONFIG_LOCK_STATS
+    if (IsLockReset)
+    {
+        le_result_t result = statsPage_ResetLockStats(PidToInspect);
+
+        if (result != LE_OK)
+        {
+            fprintf(stderr, "Cannot reset the lock statistics of process %d (%s).\n",
+                    PidToInspect, LE_RESULT_TXT(result));
+            exit(EXIT_FAILURE);
+        }
+    }
+#endif
+
+    InspectStats();
+
+    if (!IsFollowing)
+    {
+        if (StatsPagePtr != NULL)
+        {
+            statsPage_Unmap(StatsPagePtr, StatsPageSize);
+        }
+        exit(EXIT_SUCCESS);
+    }
+
+    le_clk_Time_t refreshInterval = { .sec = RefreshInterval, .usec = 0 };
+
+    refreshTimer = le_timer_Create("StatsRefreshTimer");
+    INTERNAL_ERR_IF(le_timer_SetHandler(refreshTimer, StatsRefreshTimerHandler) != LE_OK,
+                    "Could not set timer handler.\n");
+    INTERNAL_ERR_IF(le_timer_SetInterval(refreshTimer, refreshInterval) != LE_OK,
+                    "Could not set refresh time.\n");
+    INTERNAL_ERR_IF(le_timer_SetRepeat(refreshTimer, 0) != LE_OK,
+                    "Could not set timer to repeat.\n");
+    INTERNAL_ERR_IF(le_timer_Start(refreshTimer) != LE_OK,
+                    "Could not start refresh timer.\n");
+}
+#endif
+
 #if LE_CONFIG_LINUX
 //--------------------------------------------------------------------------------------------------
 /**
@@ -4668,6 +5287,21 @@ static void CommandArgHandler
     {
         le_arg_AddPositionalCallback(IpcInterfaceTypeHandler);
     }
+#endif
+#if LE_CONFIG_STATS_PAGE
+    else if (strcmp(command, "stats") == 0)
+    {
+        InspectType = INSPECT_INSP_TYPE_STATS;
+
+        // The PID is optional.
+        le_arg_AllowLessPositionalArgsThanCallbacks();
+    }
+#endif
+#if LE_CONFIG_LOCK_STATS
+    else if (strcmp(command, "locks") == 0)
+    {
+        InspectType = INSPECT_INSP_TYPE_LOCKS;
+    }
 #endif
     else
     {
@@ -4747,6 +5381,9 @@ COMPONENT_INIT
     IsFollowing = false;
     IsVerbose = false;
     TimerTypeIndex = TIMER_NON_WAKEUP;
+#if LE_CONFIG_LOCK_STATS
+    IsLockReset = false;
+#endif
 
     // The command-line has a command string followed by a PID.
     le_arg_AddPositionalCallback(CommandArgHandler);
@@ -4766,8 +5403,35 @@ COMPONENT_INIT
     // --format=json option outputs data to the specified file in JSON format.
     le_arg_SetStringCallback(FormatOptionCallback, NULL, "format");
 
+#if LE_CONFIG_LOCK_STATS
+    // --reset option resets the lock counters before "inspect locks" prints them.
+    le_arg_SetFlagVar(&IsLockReset, NULL, "reset");
+#endif
+
     le_arg_Scan();
 
+#if LE_CONFIG_LOCK_STATS
+    if (InspectType == INSPECT_INSP_TYPE_LOCKS)
+    {
+        StartInspectStats();
+        return;
+    }
+
+    if (IsLockReset)
+    {
+        fprintf(stderr, "The --reset option only applies to 'inspect locks'.\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+
+#if LE_CONFIG_STATS_PAGE
+    if (InspectType == INSPECT_INSP_TYPE_STATS)
+    {
+        StartInspectStats();
+        return;
+    }
+#endif
+
     // Create a memory pool for iterators.
     if (!IteratorPool)
     {
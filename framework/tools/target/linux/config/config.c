@@ -130,8 +130,9 @@ static void PrintHelpAndExit
            "\t<tree name>: Is the name of a tree in the system, but without a path.\n"
            "\t<file path>: Path to the file to import from or export to.\n"
            "\t<new value>: Is a string value to write to the config tree.\n"
-           "\t<type>:      Is optional and must be one of bool, int, float, or string.\n"
+           "\t<type>:      Is optional and must be one of bool, int, float, string, or binary.\n"
            "\t             If type is bool, then value must be either true or false.\n"
+           "\t             If type is binary, then value must be base64 encoded.\n"
            "\t             If unspecified, the default type will be string.\n"
            "\n"
            "\tIf --format=json is specified, for imports, then properly formatted JSON will be\n"
@@ -208,6 +209,9 @@ static const char* NodeTypeStr
         case LE_CFG_TYPE_STEM:
             return "stem";
 
+        case LE_CFG_TYPE_BINARY:
+            return "binary";
+
         case LE_CFG_TYPE_DOESNT_EXIST:
             return "** DOESN'T EXIST **";
     }
@@ -218,6 +222,98 @@ static const char* NodeTypeStr
 
 
 
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Get the type of a node, telling binary nodes apart from string nodes.
+ *
+ *  @return The type of the node.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_cfg_nodeType_t GetNodeType
+(
+    le_cfg_IteratorRef_t iterRef,  ///< The iterator to read from.
+    const char* pathPtr            ///< Path to the node, relative to the iterator.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    le_cfg_nodeType_t type = le_cfg_GetNodeType(iterRef, pathPtr);
+
+    if ((type == LE_CFG_TYPE_STRING) && le_cfg_IsBinary(iterRef, pathPtr))
+    {
+        return LE_CFG_TYPE_BINARY;
+    }
+
+    return type;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Read the binary value of the iterator's current node and base64 encode it for display.
+ *
+ *  @return A pointer to the encoded value.  The buffer is static, so it's only valid until the next
+ *          call.
+ */
+// -------------------------------------------------------------------------------------------------
+static const char* GetBinaryAsBase64
+(
+    le_cfg_IteratorRef_t iterRef  ///< The iterator to read from.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    static uint8_t binBuffer[LE_CFG_BINARY_LEN];
+    static char encodedBuffer[LE_BASE64_ENCODED_SIZE(LE_CFG_BINARY_LEN) + 1];
+
+    size_t binSize = sizeof(binBuffer);
+    size_t encodedSize = sizeof(encodedBuffer);
+
+    encodedBuffer[0] = '\0';
+
+    if (   (le_cfg_GetBinary(iterRef, "", binBuffer, &binSize, NULL, 0) != LE_OK)
+        || (le_base64_Encode(binBuffer, binSize, encodedBuffer, &encodedSize) != LE_OK))
+    {
+        fprintf(stderr, "Failed to read binary value.\n");
+    }
+
+    return encodedBuffer;
+}
+
+
+
+
+// -------------------------------------------------------------------------------------------------
+/**
+ *  Decode a base64 string and write it to the iterator's current node as a binary value.
+ *
+ *  @return LE_OK if the value was written, LE_FORMAT_ERROR if it couldn't be decoded.
+ */
+// -------------------------------------------------------------------------------------------------
+static le_result_t SetBinaryFromBase64
+(
+    le_cfg_IteratorRef_t iterRef,  ///< The iterator to write to.
+    const char* encodedPtr         ///< The base64 encoded value.
+)
+// -------------------------------------------------------------------------------------------------
+{
+    static uint8_t binBuffer[LE_CFG_BINARY_LEN];
+    size_t binSize = sizeof(binBuffer);
+
+    if (   (encodedPtr == NULL)
+        || (le_base64_Decode(encodedPtr, strlen(encodedPtr), binBuffer, &binSize) != LE_OK))
+    {
+        fprintf(stderr, "Bad base64 binary value '%s'.\n", encodedPtr ? encodedPtr : "");
+        return LE_FORMAT_ERROR;
+    }
+
+    le_cfg_SetBinary(iterRef, "", binBuffer, binSize);
+    return LE_OK;
+}
+
+
+
+
 // -------------------------------------------------------------------------------------------------
 /**
  *  Create a JSON node reference, with name and type.
@@ -256,7 +352,7 @@ static json_t* CreateJsonNodeFromIterator
 {
     char nodeName[LE_CFG_NAME_LEN_BYTES] = "";
 
-    le_cfg_nodeType_t type = le_cfg_GetNodeType(iterRef, "");
+    le_cfg_nodeType_t type = GetNodeType(iterRef, "");
     le_cfg_GetNodeName(iterRef, "", nodeName, sizeof(nodeName));
 
     json_t* nodePtr = CreateJsonNode(nodeName, NodeTypeStr(type));
@@ -296,6 +392,12 @@ static json_t* CreateJsonNodeFromIterator
                                 json_real(le_cfg_GetFloat(iterRef, "", false)));
             break;
 
+        case LE_CFG_TYPE_BINARY:
+            json_object_set_new(nodePtr,
+                                JSON_FIELD_VALUE,
+                                json_string(GetBinaryAsBase64(iterRef)));
+            break;
+
         case LE_CFG_TYPE_STEM:
         default:
             // Unknown type, nothing to do
@@ -336,7 +438,7 @@ static void DumpTreeJSON
     {
         // Simply grab the name and the type of the current node.
         le_cfg_GetNodeName(iterRef, "", strBuffer, sizeof(strBuffer));
-        le_cfg_nodeType_t type = le_cfg_GetNodeType(iterRef, "");
+        le_cfg_nodeType_t type = GetNodeType(iterRef, "");
 
         switch (type)
         {
@@ -404,7 +506,7 @@ static void DumpTree
 
         // Simply grab the name and the type of the current node.
         le_cfg_GetNodeName(iterRef, "", strBuffer, LE_CFG_STR_LEN_BYTES);
-        le_cfg_nodeType_t type = le_cfg_GetNodeType(iterRef, "");
+        le_cfg_nodeType_t type = GetNodeType(iterRef, "");
 
         switch (type)
         {
@@ -447,10 +549,14 @@ static void DumpTree
                 }
                 break;
 
+            case LE_CFG_TYPE_BINARY:
+                printf("%s<binary> == %s\n", strBuffer, GetBinaryAsBase64(iterRef));
+                break;
+
             // The node has a different type.  So write out the name and the type.  Then print the
             // value.
             default:
-                printf("%s<%s> == ", strBuffer, NodeTypeStr(le_cfg_GetNodeType(iterRef, "")));
+                printf("%s<%s> == ", strBuffer, NodeTypeStr(GetNodeType(iterRef, "")));
                 le_cfg_GetString(iterRef, "", strBuffer, LE_CFG_STR_LEN_BYTES, "");
                 printf("%s\n", strBuffer);
                 break;
@@ -496,6 +602,10 @@ static le_cfg_nodeType_t GetNodeTypeFromString
     {
         return LE_CFG_TYPE_STEM;
     }
+    else if (strncmp(typeNamePtr, "binary", COMMAND_MAX) == 0)
+    {
+        return LE_CFG_TYPE_BINARY;
+    }
 
     // Looks like we didn't get something useful, so return in error.
     fprintf(stderr, "Unrecognized node type specified, '%s'\n", typeNamePtr);
@@ -549,7 +659,7 @@ static int HandleGetUserFriendly
     // Start a read transaction at the specified node path.  Then dump the value, (if any.)
     le_cfg_IteratorRef_t iterRef = le_cfg_CreateReadTxn(nodePathPtr);
 
-    switch (le_cfg_GetNodeType(iterRef, ""))
+    switch (GetNodeType(iterRef, ""))
     {
         case LE_CFG_TYPE_EMPTY:
             // Nothing to do here.
@@ -570,6 +680,10 @@ static int HandleGetUserFriendly
             }
             break;
 
+        case LE_CFG_TYPE_BINARY:
+            printf("%s\n", GetBinaryAsBase64(iterRef));
+            break;
+
         default:
             {
                 char nodeValue[LE_CFG_STR_LEN_BYTES] = "";
@@ -657,7 +771,7 @@ static int HandleGetJSON
         // Start a read transaction at the specified node path.  Then dump the value, (if any.)
         le_cfg_IteratorRef_t iterRef = le_cfg_CreateReadTxn(nodePathPtr);
 
-        le_cfg_nodeType_t type = le_cfg_GetNodeType(iterRef, "");
+        le_cfg_nodeType_t type = GetNodeType(iterRef, "");
         switch (type)
         {
             case LE_CFG_TYPE_STEM:
@@ -767,6 +881,9 @@ static le_result_t HandleImportJSONIteration
             le_cfg_SetFloat(iterRef, "", json_real_value(value));
             break;
 
+        case LE_CFG_TYPE_BINARY:
+            return SetBinaryFromBase64(iterRef, json_string_value(value));
+
         case LE_CFG_TYPE_STEM:
             {
                 // Iterate on children
@@ -781,7 +898,7 @@ static le_result_t HandleImportJSONIteration
                                                                          JSON_FIELD_NAME));
 
                     // Is node exist with this name?
-                    le_cfg_nodeType_t existingType = le_cfg_GetNodeType(iterRef, name);
+                    le_cfg_nodeType_t existingType = GetNodeType(iterRef, name);
                     switch (existingType)
                     {
                         case LE_CFG_TYPE_DOESNT_EXIST:
@@ -791,6 +908,7 @@ static le_result_t HandleImportJSONIteration
                         case LE_CFG_TYPE_BOOL:
                         case LE_CFG_TYPE_INT:
                         case LE_CFG_TYPE_FLOAT:
+                        case LE_CFG_TYPE_BINARY:
                             // If not existing, already a stem, empty node,
                             // or any expected type, do nothing
                         break;
@@ -916,7 +1034,7 @@ static int HandleSet
     // write the requested value to that node.
     le_cfg_IteratorRef_t iterRef = le_cfg_CreateWriteTxn(NodePath);
 
-    le_cfg_nodeType_t originalType = le_cfg_GetNodeType(iterRef, "");
+    le_cfg_nodeType_t originalType = GetNodeType(iterRef, "");
     le_cfg_nodeType_t newType = DataType;
 
     if (   (newType != originalType)
@@ -999,6 +1117,13 @@ static int HandleSet
                 break;
             }
 
+        case LE_CFG_TYPE_BINARY:
+            if (SetBinaryFromBase64(iterRef, NodeValue) != LE_OK)
+            {
+                result = EXIT_FAILURE;
+            }
+            break;
+
         case LE_CFG_TYPE_DOESNT_EXIST:
             result = EXIT_FAILURE;
             break;
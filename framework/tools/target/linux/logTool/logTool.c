@@ -26,6 +26,11 @@ $ log trace keyword processName/componentName
  * To disable a trace:
  * @verbatim
 $ log stoptrace keyword processName/componentName
+@endverbatim
+ *
+ * To show the stored messages of the last hour that are at least warnings:
+ * @verbatim
+$ log show WARNING processName/componentName --since=-3600
 @endverbatim
  *
  *
@@ -99,6 +104,16 @@ static const char* SessionIdPtr = DEFAULT_SESSION_ID;
 static bool ErrorOccurred = false;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Start and end of the time range of the "show" command, as given on the command line, or NULL if
+ * not given.
+ **/
+//--------------------------------------------------------------------------------------------------
+static const char* SinceStr = NULL;
+static const char* UntilStr = NULL;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Prints help to stdout.
@@ -119,6 +134,7 @@ static void PrintHelpAndExit
         "    log trace KEYWORD_STR [DESTINATION]\n"
         "    log stoptrace KEYWORD_STR [DESTINATION]\n"
         "    log forget PROCESS_NAME\n"
+        "    log show [FILTER_STR] [DESTINATION] [--since=TIME] [--until=TIME]\n"
         "\n"
         "DESCRIPTION:\n"
         "    log list            Lists all processes/components registered with the\n"
@@ -146,6 +162,13 @@ static void PrintHelpAndExit
         "                        Future processes with that name will have default\n"
         "                        settings.\n"
         "\n"
+        "    log show            Shows the messages kept in the log store, oldest\n"
+        "                        first.  Only the messages at least as severe as\n"
+        "                        FILTER_STR are shown, if given.  TIME is in seconds\n"
+        "                        since the Epoch, or in seconds before now if\n"
+        "                        negative (e.g. --since=-600 for the last 10\n"
+        "                        minutes).\n"
+        "\n"
         "The [DESTINATION] is optional and specifies the process and component to\n"
         "send the command to.  The [DESTINATION] must be in this format:\n"
         "\n"
@@ -464,6 +487,79 @@ static void TraceKeywordArgHandler
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Function that gets called by le_arg_Scan() when an argument of a "show" command is seen on the
+ * command line.  This is either a log level, optionally followed by a log session identifier, or a
+ * log session identifier.
+ **/
+//--------------------------------------------------------------------------------------------------
+static void ShowArgHandler
+(
+    const char* arg
+)
+{
+    if (strchr(arg, '/') != NULL)
+    {
+        SessionIdPtr = arg;
+        return;
+    }
+
+    le_log_Level_t level = ParseSeverityLevel(arg);
+    if (level == (le_log_Level_t)(-1))
+    {
+        ExitWithErrorMsg("Invalid log level.");
+    }
+
+    CommandParamPtr = log_SeverityLevelToStr(level);
+    LE_ASSERT(CommandParamPtr != NULL);
+
+    // Wait for an optional log session identifier next.
+    le_arg_AddPositionalCallback(SessionIdArgHandler);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Converts a time of the "show" command to seconds since the Epoch.
+ *
+ * @return The time, or 0 if not given.
+ **/
+//--------------------------------------------------------------------------------------------------
+static unsigned long long ParseShowTime
+(
+    const char* timeStr     ///< [IN] Time as given on the command line, or NULL.
+)
+{
+    char* endPtr;
+    long long seconds;
+
+    if (timeStr == NULL)
+    {
+        return 0;
+    }
+
+    errno = 0;
+    seconds = strtoll(timeStr, &endPtr, 10);
+    if ((errno != 0) || (*timeStr == '\0') || (*endPtr != '\0'))
+    {
+        ExitWithErrorMsg("Invalid time.");
+    }
+
+    // A negative time is relative to now.
+    if (seconds < 0)
+    {
+        seconds += le_clk_GetAbsoluteTime().sec;
+        if (seconds <= 0)
+        {
+            seconds = 1;
+        }
+    }
+
+    return seconds;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Function that gets called by le_arg_Scan() when the process identifier argument (either a process
@@ -529,6 +625,14 @@ static void CommandArgHandler
         // This command has only a process name (or pid) as a parameter.
         le_arg_AddPositionalCallback(ProcessIdArgHandler);
     }
+    else if (strcmp(command, "show") == 0)
+    {
+        Command = LOG_CMD_QUERY_STORE;
+
+        // Expect an optional log level and an optional log session identifier next.
+        le_arg_AddPositionalCallback(ShowArgHandler);
+        le_arg_AllowLessPositionalArgsThanCallbacks();
+    }
     else
     {
         char errorMsg[100];
@@ -551,6 +655,10 @@ COMPONENT_INIT
     // Print help and exit if the "-h" or "--help" options are given.
     le_arg_SetFlagCallback(PrintHelpAndExit, "h", "help");
 
+    // Time range of the "show" command.
+    le_arg_SetStringVar(&SinceStr, NULL, "since");
+    le_arg_SetStringVar(&UntilStr, NULL, "until");
+
     le_arg_Scan();
 
     // Connect to the Log Control Daemon and allocate a message buffer to hold the command.
@@ -584,6 +692,22 @@ COMPONENT_INIT
             AppendToCommand(msgRef, CommandParamPtr);
 
             break;
+
+        case LOG_CMD_QUERY_STORE:
+        {
+            char queryStr[64];
+
+            snprintf(queryStr, sizeof(queryStr), "%s%c%llu%c%llu",
+                     (CommandParamPtr != NULL) ? CommandParamPtr : "",
+                     LOG_STORE_QUERY_SEPARATOR, ParseShowTime(SinceStr),
+                     LOG_STORE_QUERY_SEPARATOR, ParseShowTime(UntilStr));
+
+            AppendToCommand(msgRef, SessionIdPtr);
+            AppendToCommand(msgRef, "/");
+            AppendToCommand(msgRef, queryStr);
+
+            break;
+        }
     }
 
     // Send the command and wait for messages from the Log Control Daemon.  When the Log Control
@@ -50,6 +50,13 @@ static const char* ClientIfPtr = NULL;
 static const char* ServerIfPtr = NULL;
 
 
+//--------------------------------------------------------------------------------------------------
+/// "Bind" request that is being filled with bindings from the configuration (used by Load()).
+/// NULL if there are no pending bindings.
+//--------------------------------------------------------------------------------------------------
+static le_msg_MessageRef_t BindMsgRef = NULL;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Temporary file, created in our local tmpfs, used to help with printing sdir list.
@@ -439,10 +446,39 @@ static le_result_t GetServerUid
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Send a binding from a configuration tree iterator's current node to the Service Directory.
+ * Send the pending "Bind" request, if any, to the Service Directory.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FlushBindRequest
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (BindMsgRef == NULL)
+    {
+        return;
+    }
+
+    le_msg_MessageRef_t msgRef = le_msg_RequestSyncResponse(BindMsgRef);
+    BindMsgRef = NULL;
+
+    if (msgRef == NULL)
+    {
+        ExitWithErrorMsg("Communication with Service Directory failed.");
+    }
+
+    le_msg_ReleaseMsg(msgRef);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Add a binding from a configuration tree iterator's current node to the pending "Bind" request.
+ * The request is sent to the Service Directory when it is full (see FlushBindRequest()).
  */
 //--------------------------------------------------------------------------------------------------
-static void SendCfgBindRequest
+static void AddCfgBinding
 (
     uid_t uid,                  ///< [in] Unix user ID of the client whose binding is being created.
     le_cfg_IteratorRef_t i      ///< [in] Configuration read iterator.
@@ -451,17 +487,25 @@ static void SendCfgBindRequest
 {
     le_result_t result;
 
-    le_msg_MessageRef_t msgRef = le_msg_CreateMsg(SessionRef);
-    le_sdtp_Msg_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
+    if (BindMsgRef == NULL)
+    {
+        BindMsgRef = le_msg_CreateMsg(SessionRef);
+        le_sdtp_Msg_t* msgPtr = le_msg_GetPayloadPtr(BindMsgRef);
 
-    msgPtr->msgType = LE_SDTP_MSGID_BIND;
-    msgPtr->client = uid;
+        msgPtr->msgType = LE_SDTP_MSGID_BIND;
+        msgPtr->bindingCount = 0;
+    }
+
+    le_sdtp_Msg_t* msgPtr = le_msg_GetPayloadPtr(BindMsgRef);
+    le_sdtp_Binding_t* bindingPtr = &msgPtr->bindings[msgPtr->bindingCount];
+
+    bindingPtr->client = uid;
 
     // Fetch the client's service name.
     result = le_cfg_GetNodeName(i,
                                 "",
-                                msgPtr->clientInterfaceName,
-                                sizeof(msgPtr->clientInterfaceName));
+                                bindingPtr->clientInterfaceName,
+                                sizeof(bindingPtr->clientInterfaceName));
     if (result != LE_OK)
     {
         char path[LIMIT_MAX_PATH_BYTES];
@@ -471,7 +515,7 @@ static void SendCfgBindRequest
     }
 
     // Fetch the server's user ID.
-    result = GetServerUid(i, &msgPtr->server);
+    result = GetServerUid(i, &bindingPtr->server);
     if (result != LE_OK)
     {
         return;
@@ -480,8 +524,8 @@ static void SendCfgBindRequest
     // Fetch the server's service name.
     result = le_cfg_GetString(i,
                               "interface",
-                              msgPtr->serverInterfaceName,
-                              sizeof(msgPtr->serverInterfaceName),
+                              bindingPtr->serverInterfaceName,
+                              sizeof(bindingPtr->serverInterfaceName),
                               "");
     if (result != LE_OK)
     {
@@ -490,7 +534,7 @@ static void SendCfgBindRequest
         LE_CRIT("Server interface name too big (@ %s)", path);
         return;
     }
-    if (msgPtr->serverInterfaceName[0] == '\0')
+    if (bindingPtr->serverInterfaceName[0] == '\0')
     {
         char path[LIMIT_MAX_PATH_BYTES];
         le_cfg_GetPath(i, "interface", path, sizeof(path));
@@ -498,14 +542,13 @@ static void SendCfgBindRequest
         return;
     }
 
-    msgRef = le_msg_RequestSyncResponse(msgRef);
+    // The binding is complete.  Send the request if it can't hold any more.
+    msgPtr->bindingCount++;
 
-    if (msgRef == NULL)
+    if (msgPtr->bindingCount == LE_SDTP_MAX_BINDINGS_PER_MSG)
     {
-        ExitWithErrorMsg("Communication with Service Directory failed.");
+        FlushBindRequest();
     }
-
-    le_msg_ReleaseMsg(msgRef);
 }
 
 
@@ -643,7 +686,7 @@ static void Load
             result = le_cfg_GoToFirstChild(i);
             while (result == LE_OK)
             {
-                SendCfgBindRequest(uid, i);
+                AddCfgBinding(uid, i);
 
                 result = le_cfg_GoToNextSibling(i);
             }
@@ -671,7 +714,7 @@ static void Load
             result = le_cfg_GoToFirstChild(i);
             while (result == LE_OK)
             {
-                SendCfgBindRequest(uid, i);
+                AddCfgBinding(uid, i);
 
                 result = le_cfg_GoToNextSibling(i);
             }
@@ -684,6 +727,8 @@ static void Load
         result = le_cfg_GoToNextSibling(i);
     }
 
+    // Send the last, partially filled, batch of bindings.
+    FlushBindRequest();
 
     exit(EXIT_SUCCESS);
 }
@@ -803,18 +848,21 @@ static void Bind
     le_sdtp_Msg_t* msgPtr = le_msg_GetPayloadPtr(msgRef);
 
     msgPtr->msgType = LE_SDTP_MSGID_BIND;
+    msgPtr->bindingCount = 1;
+
+    le_sdtp_Binding_t* bindingPtr = &msgPtr->bindings[0];
 
     // Parse the client interface specifier.
     ParseInterfaceSpec(ClientIfPtr,
-                       &msgPtr->client,
-                       msgPtr->clientInterfaceName,
-                       sizeof(msgPtr->clientInterfaceName));
+                       &bindingPtr->client,
+                       bindingPtr->clientInterfaceName,
+                       sizeof(bindingPtr->clientInterfaceName));
 
     // Parse the server interface specifier.
     ParseInterfaceSpec(ServerIfPtr,
-                       &msgPtr->server,
-                       msgPtr->serverInterfaceName,
-                       sizeof(msgPtr->serverInterfaceName));
+                       &bindingPtr->server,
+                       bindingPtr->serverInterfaceName,
+                       sizeof(bindingPtr->serverInterfaceName));
 
     // Send the message and wait for a response.
     msgRef = le_msg_RequestSyncResponse(msgRef);